@@ -0,0 +1,175 @@
+/**
+ * \file include/vctool/agent.h
+ *
+ * \brief Authenticated connections to a blockchain agent.
+ *
+ * Agent connections speak the vcblockchain protocol. A client connection
+ * starts with the vcblockchain handshake, which authenticates the client and
+ * the agent to each other with their encryption keys and establishes a shared
+ * secret. After the handshake, each request is sent with one of the
+ * vcblockchain_protocol_sendreq_* functions, and each response is read with
+ * \ref agent_connection_receive and decoded with the matching
+ * vcblockchain_protocol_decode_resp_* function. Every request carries a client
+ * chosen offset that the agent echoes back in its response, so many requests
+ * can be in flight on one connection.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#ifndef  VCTOOL_AGENT_HEADER_GUARD
+# define VCTOOL_AGENT_HEADER_GUARD
+
+#include <rcpr/allocator.h>
+#include <rcpr/psock.h>
+#include <rcpr/uuid.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vcblockchain/protocol.h>
+#include <vcblockchain/protocol/data.h>
+#include <vcblockchain/protocol/serialization.h>
+#include <vccrypt/suite.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief The first client initialization vector, used for the handshake
+ * acknowledgement.
+ */
+#define AGENT_CLIENT_IV_INITIAL 0x0000000000000001ULL
+
+/**
+ * \brief The first agent initialization vector, used for the answer to the
+ * handshake acknowledgement.
+ */
+#define AGENT_SERVER_IV_INITIAL 0x8000000000000001ULL
+
+/** \brief The status of a successful agent response. */
+#define AGENT_STATUS_SUCCESS 0x00000000U
+
+/**
+ * \brief The keys used to authenticate one side of an agent connection.
+ *
+ * The local id and private key come from the local keypair certificate. The
+ * peer id and public key come from the public certificate of the other side:
+ * the agent for a client, or the client for an agent.
+ */
+typedef struct agent_keys
+{
+    RCPR_SYM(rcpr_uuid) local_id;
+    vccrypt_buffer_t local_private_key;
+    RCPR_SYM(rcpr_uuid) peer_id;
+    vccrypt_buffer_t peer_public_key;
+} agent_keys;
+
+/**
+ * \brief An authenticated connection between a client and an agent.
+ *
+ * The same connection is used by both sides. Each side sends with its own
+ * initialization vector and receives with the other's, incrementing each one
+ * per message.
+ */
+typedef struct agent_connection
+{
+    RCPR_SYM(psock)* sock;
+    RCPR_SYM(allocator)* alloc;
+    vccrypt_suite_options_t* suite;
+    RCPR_SYM(rcpr_uuid) peer_id;
+    vccrypt_buffer_t shared_secret;
+    bool authenticated;
+    uint64_t client_iv;
+    uint64_t server_iv;
+} agent_connection;
+
+/**
+ * \brief Dispose of a set of agent keys.
+ *
+ * \param keys              The keys to dispose.
+ */
+void agent_keys_dispose(agent_keys* keys);
+
+/**
+ * \brief Initialize an unauthenticated connection over the given socket.
+ *
+ * \param conn              The connection to initialize.
+ * \param alloc             The allocator to use for this connection.
+ * \param suite             The crypto suite to use for this connection.
+ * \param fd                The connected socket; the connection owns this
+ *                          socket on success.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int agent_connection_init(
+    agent_connection* conn, RCPR_SYM(allocator)* alloc,
+    vccrypt_suite_options_t* suite, int fd);
+
+/**
+ * \brief Connect to an agent listening on the given Unix socket, and perform
+ * the vcblockchain handshake with it.
+ *
+ * The agent must prove that it holds the private key matching the peer public
+ * key, and must identify itself with the peer id.
+ *
+ * \param conn              The connection to initialize.
+ * \param alloc             The allocator to use for this connection.
+ * \param suite             The crypto suite to use for this connection.
+ * \param path              The path of the agent socket.
+ * \param keys              The client keys and the agent public key.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_CONNECT_FAILED if the agent can't be reached.
+ *      - VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED if the handshake fails.
+ *      - a non-zero error code on failure.
+ */
+int agent_connection_connect(
+    agent_connection* conn, RCPR_SYM(allocator)* alloc,
+    vccrypt_suite_options_t* suite, const char* path, const agent_keys* keys);
+
+/**
+ * \brief Dispose of a connection, closing its socket.
+ *
+ * \param conn              The connection to dispose.
+ */
+void agent_connection_dispose(agent_connection* conn);
+
+/**
+ * \brief Receive the next response from the agent.
+ *
+ * \param conn              The authenticated client connection.
+ * \param response          Buffer to be initialized with the response. On
+ *                          success, the caller owns this buffer and must
+ *                          dispose it.
+ * \param request_id        Pointer to receive the request id.
+ * \param offset            Pointer to receive the request offset.
+ * \param status            Pointer to receive the response status.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_PROTOCOL if the response is malformed.
+ *      - VCTOOL_ERROR_AGENT_IO if the connection fails.
+ */
+int agent_connection_receive(
+    agent_connection* conn, vccrypt_buffer_t* response, uint32_t* request_id,
+    uint32_t* offset, uint32_t* status);
+
+/**
+ * \brief Map an agent response status to a status code.
+ *
+ * \param status            The agent response status.
+ *
+ * \returns the matching status code.
+ */
+int agent_status_to_error(uint32_t status);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*VCTOOL_AGENT_HEADER_GUARD*/
@@ -91,6 +91,12 @@ struct backup_file_enc_header
 
 /**
  * \brief Backup file record header.
+ *
+ * The record header is stored in the clear; the rest of the record is
+ * encrypted with the file key in CBC mode starting from the record IV, after
+ * padding to a whole number of cipher blocks with each pad byte holding the
+ * pad size. The record MAC is a short MAC, keyed with the file key, of the
+ * record header up to the MAC followed by the encrypted record body.
  */
 struct backup_record_header
 {
@@ -279,6 +285,11 @@ int backup_file_encryption_header_write(
  *
  * \returns a status code indicating success or failure.
  *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BACKUP_TRUNCATED_RECORD if the header is truncated.
+ *      - VCTOOL_ERROR_BACKUP_BAD_HEADER if this is not a backup file of a
+ *        supported version.
+ *      - VCTOOL_ERROR_BACKUP_BAD_MAC if the passphrase is wrong or the header
+ *        is damaged.
  *      - a non-zero error code on failure.
  */
 int backup_file_encryption_header_read(
@@ -286,6 +297,68 @@ int backup_file_encryption_header_read(
     vccrypt_buffer_t* passphrase, backup_file_enc_header* header,
     vccrypt_buffer_t* key);
 
+/**
+ * \brief Decode the clear header of a backup record.
+ *
+ * \param header            The header to populate.
+ * \param buf               The record, starting at its header.
+ * \param size              The number of bytes available at \p buf.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BACKUP_TRUNCATED_RECORD if the record does not fit in
+ *        the available bytes.
+ *      - VCTOOL_ERROR_BACKUP_BAD_RECORD if the header is malformed.
+ */
+int backup_record_header_read(
+    backup_record_header* header, const void* buf, size_t size);
+
+/**
+ * \brief Authenticate a backup record whose clear header has been decoded.
+ *
+ * The record MAC covers the record header up to the MAC and the encrypted
+ * record body, so the type and size in an authentic header can be trusted.
+ *
+ * \param suite             The crypto suite to use for this operation.
+ * \param key               The file key.
+ * \param header            The header decoded from this record by
+ *                          \ref backup_record_header_read.
+ * \param record            The record, starting at its header, which holds
+ *                          at least the record size in the header.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS if the record is authentic.
+ *      - VCTOOL_ERROR_BACKUP_BAD_MAC if the record fails authentication.
+ *      - a non-zero error code on failure.
+ */
+int backup_record_authenticate(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* key,
+    const backup_record_header* header, const void* record);
+
+/**
+ * \brief Authenticate and decrypt a backup block record.
+ *
+ * The record MAC is checked before anything is decrypted.
+ *
+ * \param block             The block record to populate. On success, this
+ *                          record is owned by the caller and must be disposed
+ *                          when no longer needed.
+ * \param suite             The crypto suite to use for this operation.
+ * \param key               The file key.
+ * \param record            The record, starting at its header.
+ * \param record_size       The size of the record.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BACKUP_BAD_MAC if the record fails authentication.
+ *      - VCTOOL_ERROR_BACKUP_BAD_RECORD if the record is not a well formed
+ *        block record.
+ *      - a non-zero error code on failure.
+ */
+int backup_record_block_decrypt(
+    backup_record_block* block, vccrypt_suite_options_t* suite,
+    vccrypt_buffer_t* key, const void* record, size_t record_size);
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
@@ -0,0 +1,80 @@
+/**
+ * \file include/vctool/block.h
+ *
+ * \brief Block utility functions.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#ifndef  VCTOOL_BLOCK_HEADER_GUARD
+# define VCTOOL_BLOCK_HEADER_GUARD
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief The size of a block, previous block, or signer id. */
+#define BLOCK_ID_SIZE 16
+
+/**
+ * \brief The fields of a block needed to verify its place in the chain.
+ */
+typedef struct block_info
+{
+    uint8_t block_id[BLOCK_ID_SIZE];
+    uint8_t previous_block_id[BLOCK_ID_SIZE];
+    uint8_t signer_id[BLOCK_ID_SIZE];
+    uint64_t height;
+} block_info;
+
+/**
+ * \brief Read the block id, previous block id, signer id, and height of a
+ * block certificate.
+ *
+ * The certificate fields are scanned once. The signature is not verified.
+ *
+ * \param info              The block info to populate.
+ * \param block             The block certificate.
+ * \param block_size        The size of the block certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BLOCK_MISSING_FIELD if a field is missing.
+ *      - VCTOOL_ERROR_BLOCK_INVALID_FIELD_SIZE if a field has the wrong size.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED if the block is malformed.
+ */
+int block_info_read(block_info* info, const void* block, size_t block_size);
+
+/**
+ * \brief Verify that the given blocks form a single chain.
+ *
+ * The blocks are sorted by height. The heights must be consecutive, and the
+ * previous block id of each block must be the block id of the block before it.
+ * The previous block id of the lowest block is not checked, so that a range of
+ * the chain can be verified.
+ *
+ * \param blocks            The blocks to verify; these are sorted in place.
+ * \param count             The number of blocks.
+ * \param index             Pointer to receive the index of the offending block
+ *                          in the sorted array on failure.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT if two blocks share a height.
+ *      - VCTOOL_ERROR_BLOCK_HEIGHT_GAP if a height is missing.
+ *      - VCTOOL_ERROR_BLOCK_PREVIOUS_MISMATCH if a block does not link to the
+ *        block before it.
+ */
+int block_chain_verify_linkage(
+    block_info* blocks, size_t count, size_t* index);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*VCTOOL_BLOCK_HEADER_GUARD*/
@@ -0,0 +1,214 @@
+/**
+ * \file include/vctool/block_store.h
+ *
+ * \brief Local block store.
+ *
+ * A block store is a directory holding blocks appended to a few large segment
+ * files, and an index file with one fixed size record per block giving its
+ * height, block id, segment, offset, and size. Blocks are read in place from
+ * memory mapped segments, so that millions of blocks need neither millions of
+ * files nor a copy per read.
+ *
+ * Each block is written to its segment before its index record is appended,
+ * so that an interrupted append leaves at most a partial record at the end of
+ * the index, which is discarded when the store is next opened.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#ifndef  VCTOOL_BLOCK_STORE_HEADER_GUARD
+# define VCTOOL_BLOCK_STORE_HEADER_GUARD
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vctool/block.h>
+#include <vctool/file.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief The name of the index file in a block store directory. */
+#define BLOCK_STORE_INDEX_FILENAME "index"
+
+/** \brief The magic number and version at the start of the index file. */
+#define BLOCK_STORE_INDEX_MAGIC "VCBSIDX1"
+
+/** \brief The size of the index file header. */
+#define BLOCK_STORE_INDEX_HEADER_SIZE 8
+
+/**
+ * \brief The size of an index record: the big-endian height, the block id,
+ * the big-endian segment number and block size, and the big-endian offset.
+ */
+#define BLOCK_STORE_INDEX_RECORD_SIZE 40
+
+/** \brief The size at which a new segment is started. */
+#define BLOCK_STORE_SEGMENT_MAX_SIZE (256 * 1024 * 1024)
+
+/**
+ * \brief The location of a block in a block store.
+ */
+typedef struct block_store_entry
+{
+    uint64_t height;
+    uint8_t block_id[BLOCK_ID_SIZE];
+    uint32_t segment;
+    uint32_t size;
+    uint64_t offset;
+} block_store_entry;
+
+/**
+ * \brief A memory mapped segment.
+ */
+typedef struct block_store_segment
+{
+    const uint8_t* map;
+    size_t map_size;
+    uint64_t file_size;
+} block_store_segment;
+
+/**
+ * \brief An open block store.
+ *
+ * The entries are sorted by height. The id index is rebuilt when it is next
+ * needed after an append. The segments of a writable store are mapped at
+ * their largest size, so that appended blocks can be read without remapping.
+ * Reads from a store that is not being appended to are safe from many threads
+ * at once. The segment size limit can be lowered, but not raised, after the
+ * store is opened.
+ */
+typedef struct block_store
+{
+    file* f;
+    char* dirname;
+    bool writable;
+    int index_fd;
+    int segment_fd;
+    uint64_t segment_size;
+    uint64_t segment_max_size;
+    block_store_entry* entries;
+    size_t count;
+    size_t capacity;
+    block_store_entry** by_id;
+    bool by_id_valid;
+    block_store_segment* segments;
+    uint32_t segment_count;
+} block_store;
+
+/**
+ * \brief Check whether a directory is a block store.
+ *
+ * \param f                 The file interface to use.
+ * \param dirname           The directory to check.
+ *
+ * \returns true if the directory holds a block store index.
+ */
+bool block_store_exists(file* f, const char* dirname);
+
+/**
+ * \brief Open a block store.
+ *
+ * Every segment is mapped, and the index is read and sorted by height. A
+ * writable store is created if it does not exist, and a partial index record
+ * or block left by an interrupted append is removed.
+ *
+ * \param store             The store to initialize.
+ * \param f                 The file interface to use for every file in the
+ *                          store, until it is closed.
+ * \param dirname           The store directory, which must exist.
+ * \param writable          True if blocks will be appended to the store.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BLOCK_STORE_BAD_INDEX if the index is not valid.
+ *      - VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT if two blocks share a height.
+ *      - VCTOOL_ERROR_FILE_NO_ENTRY if a read-only store has no index.
+ *      - a non-zero error code from the file interface if a file can't be
+ *        read or mapped.
+ */
+int block_store_open(
+    block_store* store, file* f, const char* dirname, bool writable);
+
+/**
+ * \brief Close a block store, syncing a writable store to disk.
+ *
+ * Blocks read from the store are not valid after it is closed.
+ *
+ * \param store             The store to close.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_IO if a writable store can't be synced.
+ */
+int block_store_close(block_store* store);
+
+/**
+ * \brief Append a block to a writable block store.
+ *
+ * The block height and id are read from the block.
+ *
+ * \param store             The store.
+ * \param block             The block certificate.
+ * \param block_size        The size of the block certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT if the store already holds a
+ *        block at this height.
+ *      - VCTOOL_ERROR_BLOCK_STORE_BLOCK_TOO_LARGE if the block does not fit in
+ *        a segment.
+ *      - VCTOOL_ERROR_FILE_IO, or an error code from the file interface, if
+ *        the block can't be written.
+ *      - a non-zero error code from \ref block_info_read on failure.
+ */
+int block_store_append(
+    block_store* store, const void* block, size_t block_size);
+
+/**
+ * \brief Find a block by height.
+ *
+ * \param store             The store.
+ * \param height            The block height.
+ *
+ * \returns the entry, or NULL if there is no block at this height.
+ */
+const block_store_entry* block_store_find_by_height(
+    const block_store* store, uint64_t height);
+
+/**
+ * \brief Find a block by id.
+ *
+ * \param store             The store.
+ * \param id                The block id.
+ *
+ * \returns the entry, or NULL if there is no block with this id.
+ */
+const block_store_entry* block_store_find_by_id(
+    block_store* store, const uint8_t* id);
+
+/**
+ * \brief Get a block in place.
+ *
+ * \param block             Pointer to receive the block, which is valid until
+ *                          the store is closed.
+ * \param store             The store.
+ * \param entry             The entry of the block.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BLOCK_STORE_BAD_INDEX if the entry is not in a mapped
+ *        segment.
+ */
+int block_store_read(
+    const uint8_t** block, const block_store* store,
+    const block_store_entry* entry);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*VCTOOL_BLOCK_STORE_HEADER_GUARD*/
@@ -3,14 +3,16 @@
  *
  * \brief Certificate utility functions.
  *
- * \copyright 2020 Velo Payments.  See License.txt for license terms.
+ * \copyright 2020-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #ifndef  VCTOOL_CERTIFICATE_HEADER_GUARD
 # define VCTOOL_CERTIFICATE_HEADER_GUARD
 
+#include <stdint.h>
 #include <vccrypt/buffer.h>
 #include <vctool/commandline.h>
+#include <vctool/transaction.h>
 
 /* make this header C++ friendly. */
 #ifdef __cplusplus
@@ -54,6 +56,55 @@ int pubkey_certificate_create(
     const vccrypt_buffer_t* uuid, const vccrypt_buffer_t* encryption_pubkey,
     const vccrypt_buffer_t* signing_pubkey);
 
+/**
+ * \brief Create a signed root block certificate.
+ *
+ * The certificate is built in a single builder pass, sized up front for every
+ * field, the signer id, and the signature. Given the same block id, timestamp,
+ * and signing key, the output is byte-identical.
+ *
+ * \param opts              The command-line options to use.
+ * \param root_block        Pointer to a vccrypt buffer to be initialized and
+ *                          that will hold the signed root block.
+ * \param block_id          The 16 byte id of the root block.
+ * \param valid_from        The timestamp of the root block, in seconds since
+ *                          the epoch.
+ * \param signer_id         The 16 byte id of the signer.
+ * \param signing_privkey   The private signing key of the signer.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int root_block_certificate_create(
+    commandline_opts* opts, vccrypt_buffer_t* root_block,
+    const uint8_t* block_id, uint64_t valid_from, const uint8_t* signer_id,
+    const vccrypt_buffer_t* signing_privkey);
+
+/**
+ * \brief Create a signed transaction certificate.
+ *
+ * The certificate is built in a single builder pass, sized up front for every
+ * field, the signer id, and the signature. This is safe to call from a worker
+ * thread.
+ *
+ * \param opts              The command-line options to use.
+ * \param txn               Pointer to a vccrypt buffer to be initialized and
+ *                          that will hold the signed transaction.
+ * \param spec              The transaction, with its transaction id and
+ *                          timestamp set.
+ * \param signer_id         The 16 byte id of the signer.
+ * \param signing_privkey   The private signing key of the signer.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int transaction_certificate_create(
+    commandline_opts* opts, vccrypt_buffer_t* txn,
+    const transaction_spec* spec, const uint8_t* signer_id,
+    const vccrypt_buffer_t* signing_privkey);
+
 /**
  * \brief Encrypt a certificate using the given password.
  *
@@ -93,6 +144,207 @@ int certificate_decrypt(
     vccrypt_suite_options_t* suite, vccrypt_buffer_t** cert,
     const vccrypt_buffer_t* encrypted_cert, const vccrypt_buffer_t* password);
 
+/**
+ * \brief Read the salt and number of key derivation rounds from an encrypted
+ * certificate.
+ *
+ * \param suite             The crypto suite used to encrypt the certificate.
+ * \param salt              Pointer to a vccrypt buffer to be initialized with
+ *                          the salt. On success, the caller owns this buffer
+ *                          and must dispose it.
+ * \param rounds            Pointer to receive the number of key derivation
+ *                          rounds.
+ * \param encrypted_cert    The encrypted certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int certificate_read_key_derivation_parameters(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* salt,
+    unsigned int* rounds, const vccrypt_buffer_t* encrypted_cert);
+
+/**
+ * \brief Decrypt a certificate using a previously derived key.
+ *
+ * This allows callers decrypting many certificates with the same passphrase to
+ * derive the key once per salt, instead of once per certificate.
+ *
+ * \param suite             The crypto suite to use to decrypt the certificate.
+ * \param cert              Pointer to the pointer to receive an allocated
+ *                          vccrypt_buffer_t instance holding the decrypted
+ *                          certificate on function success.
+ * \param encrypted_cert    The encrypted certificate.
+ * \param derived_key       The key derived from the password, salt, and rounds
+ *                          of this encrypted certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int certificate_decrypt_with_key(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t** cert,
+    const vccrypt_buffer_t* encrypted_cert, const vccrypt_buffer_t* derived_key);
+
+/**
+ * \brief Find the first field of the given type in a certificate without
+ * creating a parser.
+ *
+ * Each certificate field is a two byte type and a two byte size, both in
+ * network byte order, followed by the field value. This scan only walks the
+ * field headers; it does not verify the certificate signature, so it is only
+ * suitable for reading fields from trusted or otherwise verified certificates.
+ *
+ * \param value             Pointer to receive a pointer to the field value,
+ *                          which points into \p cert.
+ * \param value_size        Pointer to receive the size of the field value.
+ * \param cert              The certificate to scan.
+ * \param cert_size         The size of the certificate.
+ * \param field_type        The field type to find.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_NOT_FOUND if there is no such field.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED if the certificate is
+ *        malformed.
+ */
+int certificate_find_short_field(
+    const uint8_t** value, size_t* value_size, const void* cert,
+    size_t cert_size, uint16_t field_type);
+
+/**
+ * \brief Find the signature of a signed certificate.
+ *
+ * The signature must be the last field of the certificate. Everything before
+ * its field header is covered by the signature.
+ *
+ * \param signed_size       Pointer to receive the size of the signed data.
+ * \param signature         Pointer to receive a pointer to the signature,
+ *                          which points into \p cert.
+ * \param signature_size    Pointer to receive the size of the signature.
+ * \param cert              The certificate to scan.
+ * \param cert_size         The size of the certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_NOT_FOUND if the last field is not a
+ *        signature.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED if the certificate is
+ *        malformed.
+ */
+int certificate_find_signature(
+    size_t* signed_size, const uint8_t** signature, size_t* signature_size,
+    const void* cert, size_t cert_size);
+
+/**
+ * \brief Verify the signature of a signed certificate with the given public
+ * signing key.
+ *
+ * This creates its own signature algorithm instance, so it is safe to call from
+ * a worker thread.
+ *
+ * \param suite             The crypto suite to use for this operation.
+ * \param cert              The certificate to verify.
+ * \param cert_size         The size of the certificate.
+ * \param public_key        The public signing key of the signer.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_CERTIFICATE_BAD_SIGNATURE if the signature is invalid.
+ *      - a non-zero error code on failure.
+ */
+int certificate_verify_signature(
+    vccrypt_suite_options_t* suite, const void* cert, size_t cert_size,
+    const vccrypt_buffer_t* public_key);
+
+/**
+ * \brief The way a certificate field value is displayed.
+ */
+typedef enum certificate_field_format
+{
+    /** \brief Raw bytes, displayed as hex. */
+    CERTIFICATE_FIELD_FORMAT_HEX,
+
+    /** \brief One or more UUIDs. */
+    CERTIFICATE_FIELD_FORMAT_UUID,
+
+    /** \brief A big-endian unsigned integer. */
+    CERTIFICATE_FIELD_FORMAT_UINT,
+
+    /** \brief A UTF-8 string. */
+    CERTIFICATE_FIELD_FORMAT_STRING,
+} certificate_field_format;
+
+/**
+ * \brief The name and display format of a known certificate field type.
+ */
+typedef struct certificate_field_info
+{
+    const char* name;
+    certificate_field_format format;
+} certificate_field_info;
+
+/**
+ * \brief Get the name and display format of a certificate field type.
+ *
+ * \param field_type        The field type.
+ *
+ * \returns the field info, or NULL if this field type is not known.
+ */
+const certificate_field_info* certificate_field_info_get(uint16_t field_type);
+
+/**
+ * \brief Read the certificate field at the given offset, and advance the
+ * offset to the next field.
+ *
+ * This allows the fields of a certificate to be streamed without creating a
+ * parser. The last field has been read when \p offset reaches \p cert_size.
+ *
+ * \param field_type        Pointer to receive the field type.
+ * \param value             Pointer to receive a pointer to the field value,
+ *                          which points into \p cert.
+ * \param value_size        Pointer to receive the size of the field value.
+ * \param offset            The offset of the field to read, which is updated
+ *                          to the offset of the next field on success.
+ * \param cert              The certificate to scan.
+ * \param cert_size         The size of the certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED if the certificate is
+ *        malformed.
+ */
+int certificate_next_field(
+    uint16_t* field_type, const uint8_t** value, size_t* value_size,
+    size_t* offset, const void* cert, size_t cert_size);
+
+/**
+ * \brief Find the next signed certificate in a stream of concatenated signed
+ * certificates.
+ *
+ * Each certificate ends with its signature field. The last certificate has
+ * been read when \p offset reaches \p stream_size.
+ *
+ * \param cert              Pointer to receive a pointer to the certificate,
+ *                          which points into \p stream.
+ * \param cert_size         Pointer to receive the size of the certificate.
+ * \param offset            The offset of the certificate to read, which is
+ *                          updated to the offset of the next certificate on
+ *                          success.
+ * \param stream            The concatenated certificates.
+ * \param stream_size       The size of the stream.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_NOT_FOUND if the stream ends before a
+ *        signature field.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED if a certificate is
+ *        malformed.
+ */
+int certificate_stream_next(
+    const uint8_t** cert, size_t* cert_size, size_t* offset,
+    const void* stream, size_t stream_size);
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
@@ -20,6 +20,9 @@ extern "C" {
 typedef struct endorse_command
 {
     command hdr;
+    /* additional input certificates given as arguments to the command. */
+    char** input_filenames;
+    size_t input_filename_count;
 } endorse_command;
 
 /**
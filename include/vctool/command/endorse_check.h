@@ -0,0 +1,67 @@
+/**
+ * \file include/vctool/command/endorse_check.h
+ *
+ * \brief Endorse-check command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <vctool/commandline.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct endorse_check_command
+{
+    command hdr;
+} endorse_check_command;
+
+/**
+ * \brief Initialize an endorse-check command structure.
+ *
+ * \param check         The endorse-check command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int endorse_check_command_init(endorse_check_command* check);
+
+/**
+ * \brief Process the endorse-check command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_endorse_check_command(
+    commandline_opts* opts, int argc, char* argv[]);
+
+/**
+ * \brief Execute the endorse-check command.
+ *
+ * Each endorse config file is parsed and analyzed on its own, in parallel, and
+ * every error is reported. No keys, certificates, or output files are used.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int endorse_check_command_func(commandline_opts* opts);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,68 @@
+/**
+ * \file include/vctool/command/endorse_watch.h
+ *
+ * \brief Endorse-watch command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <vctool/commandline.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct endorse_watch_command
+{
+    command hdr;
+} endorse_watch_command;
+
+/**
+ * \brief Initialize an endorse-watch command structure.
+ *
+ * \param watch         The endorse-watch command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int endorse_watch_command_init(endorse_watch_command* watch);
+
+/**
+ * \brief Process the endorse-watch command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_endorse_watch_command(
+    commandline_opts* opts, int argc, char* argv[]);
+
+/**
+ * \brief Execute the endorse-watch command.
+ *
+ * The endorse config files are watched for changes until the command is
+ * interrupted. Each change is validated incrementally, and each valid config is
+ * compiled to the cache used by the endorse command.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int endorse_watch_command_func(commandline_opts* opts);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,74 @@
+/**
+ * \file include/vctool/command/history.h
+ *
+ * \brief History command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <vctool/commandline.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct history_command
+{
+    command hdr;
+} history_command;
+
+/**
+ * \brief Initialize a history command structure.
+ *
+ * \param history       The history command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int history_command_init(history_command* history);
+
+/**
+ * \brief Process the history command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_history_command(
+    commandline_opts* opts, int argc, char* argv[]);
+
+/**
+ * \brief Execute the history command.
+ *
+ * The transactions of the artifact given with -D artifact=UUID are queried
+ * from the agent listening on the socket given with -i, walking back from the
+ * latest transaction of the artifact to its first. The client authenticates
+ * with the keypair given with -k and the agent public certificate given with
+ * -D agent-pubkey=FILE. Each transaction is kept in
+ * the cache directory given with -D cache=DIR, named for its transaction id,
+ * so that a repeated query fetches only the transactions added since. The
+ * transaction ids are printed oldest first, and with -o, the transactions are
+ * also written to the given file, oldest first.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int history_command_func(commandline_opts* opts);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,77 @@
+/**
+ * \file include/vctool/command/mock_agent.h
+ *
+ * \brief Mock-agent command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <vctool/commandline.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mock_agent_command
+{
+    command hdr;
+} mock_agent_command;
+
+/**
+ * \brief Initialize a mock-agent command structure.
+ *
+ * \param mock_agent    The mock-agent command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int mock_agent_command_init(mock_agent_command* mock_agent);
+
+/**
+ * \brief Process the mock-agent command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_mock_agent_command(
+    commandline_opts* opts, int argc, char* argv[]);
+
+/**
+ * \brief Execute the mock-agent command.
+ *
+ * The blocks in the optional block directory given with -i are served on the
+ * Unix socket given with -o over the vcblockchain protocol, so that the client
+ * commands can be tested and benchmarked without a running agent. The mock
+ * agent authenticates with the keypair given with -k, and only serves the
+ * client whose public certificate is given with -D client-pubkey=FILE. With
+ * -D transactions=FILE, the concatenated transactions in FILE are also served,
+ * and the last transaction of each artifact in FILE is its latest. Submitted
+ * transactions are checked and counted, and a transaction already accepted is
+ * rejected. With -D drop-every=N, every Nth submission is accepted, but its
+ * answer is lost by closing the connection. Connections are served one at a
+ * time. With -D connections=N, the mock agent exits after serving N
+ * connections.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int mock_agent_command_func(commandline_opts* opts);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
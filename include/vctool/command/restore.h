@@ -0,0 +1,74 @@
+/**
+ * \file include/vctool/command/restore.h
+ *
+ * \brief Restore command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <vctool/commandline.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct restore_command
+{
+    command hdr;
+} restore_command;
+
+/**
+ * \brief Initialize a restore command structure.
+ *
+ * \param restore       The restore command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int restore_command_init(restore_command* restore);
+
+/**
+ * \brief Process the restore command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_restore_command(
+    commandline_opts* opts, int argc, char* argv[]);
+
+/**
+ * \brief Execute the restore command.
+ *
+ * The blocks in the backup file given with -i are restored into the block
+ * directory given with -o, one file per block, or into a block store with
+ * -D layout=store. A block store that already exists under -o is appended to.
+ * The passphrase of the backup file is read from the terminal. By default
+ * every block in the backup is restored; the range can be narrowed with
+ * -D from-height=N and -D to-height=N. Block records are authenticated and
+ * decrypted one chunk at a time on a worker pool, and each chunk is written in
+ * height order. Other records are authenticated and skipped, and a record of
+ * an unknown type is an error.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int restore_command_func(commandline_opts* opts);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
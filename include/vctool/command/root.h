@@ -3,7 +3,7 @@
  *
  * \brief Root command structure.
  *
- * \copyright 2020-2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2020-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #ifndef  VCTOOL_COMMAND_ROOT_HEADER_GUARD
@@ -14,6 +14,7 @@
 #include <rcpr/resource/protected.h>
 #include <rcpr/slist.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <vctool/commandline.h>
 
@@ -34,8 +35,10 @@ typedef struct root_command
     bool verbose;
     char* input_filename;
     char* output_filename;
-    char* endorse_config_filename;
+    char** endorse_config_filenames;
+    size_t endorse_config_filename_count;
     char* key_filename;
+    char* output_format;
     unsigned int key_derivation_rounds;
     RCPR_SYM(rbtree)* dict;
     RCPR_SYM(slist)* permissions;
@@ -95,6 +98,46 @@ int dispatch_root_commands(commandline_opts* opts, int argc, char* argv[]);
  */
 int root_dict_add(root_command* root, const char* kvp);
 
+/**
+ * \brief Find a value in the root dictionary.
+ *
+ * \param value         Pointer to receive the value, or NULL if the key is not
+ *                      set.
+ * \param root          The command-line root command.
+ * \param key           The key to find.
+ */
+void root_dict_find(
+    const char** value, const root_command* root, const char* key);
+
+/**
+ * \brief Get a decimal number from the root dictionary.
+ *
+ * \param value         Pointer to receive the value.
+ * \param found         Set to true if the key is set, and false otherwise, in
+ *                      which case \p value is not changed.
+ * \param root          The command-line root command.
+ * \param key           The key to find.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER if the value is not a decimal
+ *        number.
+ */
+int root_dict_get_uint64(
+    uint64_t* value, bool* found, const root_command* root, const char* key);
+
+/**
+ * \brief Add an endorse config filename to the list of endorse config files.
+ *
+ * \param root          The command-line root command.
+ * \param filename      The endorse config filename to add.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int root_endorse_config_add(root_command* root, const char* filename);
+
 /**
  * \brief Add a permission in the form of "entity:moiety" to the permission
  * list.
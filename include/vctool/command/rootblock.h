@@ -0,0 +1,69 @@
+/**
+ * \file include/vctool/command/rootblock.h
+ *
+ * \brief Rootblock command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <vctool/commandline.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct rootblock_command
+{
+    command hdr;
+} rootblock_command;
+
+/**
+ * \brief Initialize a rootblock command structure.
+ *
+ * \param rootblock     The rootblock command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int rootblock_command_init(rootblock_command* rootblock);
+
+/**
+ * \brief Process the rootblock command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_rootblock_command(
+    commandline_opts* opts, int argc, char* argv[]);
+
+/**
+ * \brief Execute the rootblock command.
+ *
+ * A root block is built and signed with the keypair certificate given with -k,
+ * and written to the file given with -o. The block id and timestamp can be
+ * fixed with -D block-id=UUID and -D valid-from=SECONDS, in which case the
+ * output is byte-identical from run to run.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int rootblock_command_func(commandline_opts* opts);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
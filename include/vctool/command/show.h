@@ -0,0 +1,72 @@
+/**
+ * \file include/vctool/command/show.h
+ *
+ * \brief Endorse-check command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <vctool/commandline.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct show_command
+{
+    command hdr;
+    /* additional input certificates given as arguments to the command. */
+    char** input_filenames;
+    size_t input_filename_count;
+} show_command;
+
+/**
+ * \brief Initialize a show command structure.
+ *
+ * \param show          The show command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int show_command_init(show_command* show);
+
+/**
+ * \brief Process the show command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_show_command(
+    commandline_opts* opts, int argc, char* argv[]);
+
+/**
+ * \brief Execute the show command.
+ *
+ * The fields of the certificate given with -i and of every certificate given
+ * as an argument are streamed to standard output in the format selected with
+ * -F: human (the default), jsonl, or csv. A block store directory given in
+ * place of a certificate shows every block in the store, in height order.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int show_command_func(commandline_opts* opts);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,74 @@
+/**
+ * \file include/vctool/command/submit.h
+ *
+ * \brief Submit command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <vctool/commandline.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct submit_command
+{
+    command hdr;
+} submit_command;
+
+/**
+ * \brief Initialize a submit command structure.
+ *
+ * \param submit        The submit command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int submit_command_init(submit_command* submit);
+
+/**
+ * \brief Process the submit command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_submit_command(
+    commandline_opts* opts, int argc, char* argv[]);
+
+/**
+ * \brief Execute the submit command.
+ *
+ * The signed transactions in the file given with -i, as written by the txn
+ * command, are submitted to the agent listening on the socket given with -o,
+ * one vcblockchain transaction submit request per transaction. The client
+ * authenticates with the keypair given with -k and the agent public
+ * certificate given with -D agent-pubkey=FILE. Up to -D window=N requests are
+ * kept in flight; the number in flight adapts to the agent. A lost connection
+ * is reopened up to -D retries=N times with an increasing delay, and the
+ * requests that were in flight are sent again. The throughput and request
+ * latency percentiles are printed at the end.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int submit_command_func(commandline_opts* opts);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
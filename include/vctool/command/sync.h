@@ -0,0 +1,75 @@
+/**
+ * \file include/vctool/command/sync.h
+ *
+ * \brief Sync command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <vctool/commandline.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct sync_command
+{
+    command hdr;
+} sync_command;
+
+/**
+ * \brief Initialize a sync command structure.
+ *
+ * \param sync          The sync command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int sync_command_init(sync_command* sync);
+
+/**
+ * \brief Process the sync command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_sync_command(
+    commandline_opts* opts, int argc, char* argv[]);
+
+/**
+ * \brief Execute the sync command.
+ *
+ * Blocks are downloaded from the agent listening on the socket given with -i
+ * over the vcblockchain protocol, authenticating with the keypair given with
+ * -k and the agent public certificate given with -D agent-pubkey=FILE. They
+ * are written into the block directory given with -o, one file per block, or
+ * into a block store with -D layout=store. A block store that already exists
+ * under -o is appended to. By default every block up to the latest block is
+ * downloaded; the range can be narrowed with -D from-height=N and
+ * -D to-height=N. Up to -D window=N requests are kept in flight, so that the
+ * round trip time to the agent is paid once per window rather than once per
+ * block.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int sync_command_func(commandline_opts* opts);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,70 @@
+/**
+ * \file include/vctool/command/txn.h
+ *
+ * \brief Txn command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <vctool/commandline.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct txn_command
+{
+    command hdr;
+} txn_command;
+
+/**
+ * \brief Initialize a txn command structure.
+ *
+ * \param txn           The txn command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int txn_command_init(txn_command* txn);
+
+/**
+ * \brief Process the txn command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_txn_command(
+    commandline_opts* opts, int argc, char* argv[]);
+
+/**
+ * \brief Execute the txn command.
+ *
+ * Each entry of the JSON Lines or CSV manifest given with -i is built into a
+ * transaction certificate and signed on a pool of worker threads, using the
+ * keypair certificate given with -k. If -o names a directory, each transaction
+ * is written to its own file there; otherwise, the transactions are
+ * concatenated into the file given with -o, in manifest order.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int txn_command_func(commandline_opts* opts);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
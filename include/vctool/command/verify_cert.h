@@ -0,0 +1,71 @@
+/**
+ * \file include/vctool/command/verify_cert.h
+ *
+ * \brief Endorse-check command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <vctool/commandline.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct verify_cert_command
+{
+    command hdr;
+    /* additional input certificates given as arguments to the command. */
+    char** input_filenames;
+    size_t input_filename_count;
+} verify_cert_command;
+
+/**
+ * \brief Initialize a verify-cert command structure.
+ *
+ * \param verify        The verify-cert command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int verify_cert_command_init(verify_cert_command* verify);
+
+/**
+ * \brief Process the verify-cert command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_verify_cert_command(
+    commandline_opts* opts, int argc, char* argv[]);
+
+/**
+ * \brief Execute the verify-cert command.
+ *
+ * The certificate given with -i and every certificate given as an argument
+ * are verified on a pool of worker threads, using the signer public key
+ * certificates given with -D.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int verify_cert_command_func(commandline_opts* opts);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,69 @@
+/**
+ * \file include/vctool/command/verify_chain.h
+ *
+ * \brief Endorse-check command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <vctool/commandline.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct verify_chain_command
+{
+    command hdr;
+} verify_chain_command;
+
+/**
+ * \brief Initialize a verify-chain command structure.
+ *
+ * \param verify        The verify-chain command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int verify_chain_command_init(verify_chain_command* verify);
+
+/**
+ * \brief Process the verify-chain command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_verify_chain_command(
+    commandline_opts* opts, int argc, char* argv[]);
+
+/**
+ * \brief Execute the verify-chain command.
+ *
+ * Every block in the input block directory or block store is read and its
+ * signature is verified on a pool of worker threads, using the signer public
+ * key certificates given with -D. The previous block linkage is then verified
+ * in a single pass in height order.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int verify_chain_command_func(commandline_opts* opts);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
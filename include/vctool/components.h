@@ -3,7 +3,7 @@
  *
  * \brief Components enumeration.
  *
- * \copyright 2020 Velo Payments.  See License.txt for license terms.
+ * \copyright 2020-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #ifndef VCTOOL_COMPONENTS_HEADER_GUARD
@@ -63,6 +63,21 @@ enum vctool_components
      * \brief pubkey Component.
      */
     VCTOOL_COMPONENT_PUBKEY = 0x08U,
+
+    /**
+     * \brief block Component.
+     */
+    VCTOOL_COMPONENT_BLOCK = 0x09U,
+
+    /**
+     * \brief transaction Component.
+     */
+    VCTOOL_COMPONENT_TRANSACTION = 0x0AU,
+
+    /**
+     * \brief agent Component.
+     */
+    VCTOOL_COMPONENT_AGENT = 0x0BU,
 };
 
 /* make this header C++ friendly. */
@@ -38,6 +38,46 @@ int crypt_cipher_mac_init_from_password(
     vccrypt_suite_options_t* suite, const vccrypt_buffer_t* password,
     const vccrypt_buffer_t* salt, unsigned int rounds);
 
+/**
+ * \brief Derive a symmetric key from a password, salt, and number of key
+ * derivation rounds.
+ *
+ * \param derived_key       The buffer to be initialized with the derived key.
+ *                          On success, the caller owns this buffer and must
+ *                          dispose it.
+ * \param suite             The crypto suite to use to derive this key.
+ * \param password          The password to use for deriving the private key.
+ * \param salt              The salt to use for deriving the private key.
+ * \param rounds            The number of rounds to use to derive the private
+ *                          key.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int crypt_derive_key_from_password(
+    vccrypt_buffer_t* derived_key, vccrypt_suite_options_t* suite,
+    const vccrypt_buffer_t* password, const vccrypt_buffer_t* salt,
+    unsigned int rounds);
+
+/**
+ * \brief Initialize a cipher and mac instance from a suite and a previously
+ * derived key.
+ *
+ * \param cipher            The stream cipher instance to initialize.
+ * \param mac               The mac instance to initialize.
+ * \param suite             The crypto suite to use to initialize these
+ *                          instances.
+ * \param derived_key       The derived key to use for these instances.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int crypt_cipher_mac_init_from_key(
+    vccrypt_stream_context_t* cipher, vccrypt_mac_context_t* mac,
+    vccrypt_suite_options_t* suite, const vccrypt_buffer_t* derived_key);
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
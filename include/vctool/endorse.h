@@ -3,7 +3,7 @@
  *
  * \brief Endorse config related header.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #pragma once
@@ -11,8 +11,10 @@
 #include <rcpr/allocator.h>
 #include <rcpr/rbtree.h>
 #include <rcpr/resource/protected.h>
+#include <rcpr/uuid.h>
 #include <stdint.h>
 #include <vccrypt/buffer.h>
+#include <vctool/file.h>
 #include <vpr/uuid.h>
 
 /* make this header C++ friendly. */
@@ -34,6 +36,8 @@ struct endorse_entity
     bool id_declared;
     RCPR_SYM(rbtree)* verbs;
     RCPR_SYM(rbtree)* roles;
+    struct endorse_verb** verb_table;
+    size_t verb_table_size;
 };
 
 /**
@@ -48,6 +52,7 @@ struct endorse_verb
     int reference_count;
     const char* verb;
     vpr_uuid verb_id;
+    size_t index;
 };
 
 /**
@@ -64,8 +69,28 @@ struct endorse_role_verb
     endorse_verb* verb;
 };
 
+/**
+ * \brief An immutable set of verbs, indexed by the dense verb index assigned to
+ * each verb of an entity during semantic analysis. A verb set is shared by
+ * reference between a role and any extending roles that add no verbs.
+ */
+typedef struct endorse_verb_set endorse_verb_set;
+
+struct endorse_verb_set
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    int reference_count;
+    size_t verb_count;
+    size_t word_count;
+    uint64_t* words;
+};
+
 /**
  * \brief An endorse role.
+ *
+ * The verbs tree holds only the verbs declared for this role. After semantic
+ * analysis, the verb set holds these verbs and all verbs of extended roles.
  */
 typedef struct endorse_role endorse_role;
 
@@ -74,11 +99,13 @@ struct endorse_role
     RCPR_SYM(resource) hdr;
     RCPR_SYM(allocator)* alloc;
     bool type_complete;
+    bool type_pending;
     int reference_count;
     const char* name;
     const char* extends_role_name;
     endorse_role* extends_role;
     RCPR_SYM(rbtree)* verbs;
+    endorse_verb_set* verb_set;
 };
 
 /**
@@ -94,6 +121,30 @@ struct endorse_config
     RCPR_SYM(rbtree)* entities;
 };
 
+/**
+ * \brief The table of interned identifiers for an endorse config context.
+ */
+typedef struct endorse_symbol_table endorse_symbol_table;
+
+/**
+ * \brief An endorse config that is kept analyzed across edits, reparsing only
+ * the blocks that change.
+ */
+typedef struct endorse_incremental endorse_incremental;
+
+/**
+ * \brief Statistics for a single incremental endorse config update.
+ */
+typedef struct endorse_incremental_stats endorse_incremental_stats;
+
+struct endorse_incremental_stats
+{
+    size_t block_count;
+    size_t blocks_changed;
+    size_t entity_count;
+    size_t entities_analyzed;
+};
+
 /**
  * \brief Union for the endorse config parser.
  */
@@ -102,7 +153,7 @@ typedef union endorse_config_val endorse_config_val;
 union endorse_config_val
 {
     int64_t number;
-    char* string;
+    const char* string;
     vpr_uuid* id;
     endorse_config* config;
     RCPR_SYM(rbtree)* entities;
@@ -116,6 +167,9 @@ union endorse_config_val
 /**
  * \brief The endorse config context structure is used to provide user overrides
  * for methods and a user context pointer to the parser.
+ *
+ * Every identifier in the AST is interned in the context symbol table, so the
+ * AST must be released before the context.
  */
 typedef struct endorse_config_context endorse_config_context;
 
@@ -140,6 +194,102 @@ struct endorse_config_context
     endorse_config_set_error_fn set_error;
     endorse_config_val_callback_fn val_callback;
     void* user_context;
+    endorse_symbol_table* symbols;
+    bool out_of_memory;
+};
+
+/** \brief Magic number at the start of a compiled endorse config ("VCEC"). */
+#define ENDORSE_COMPILED_MAGIC 0x43454356U
+
+/** \brief The current compiled endorse config format version. */
+#define ENDORSE_COMPILED_VERSION 3U
+
+/** \brief The size of the SHA-512 source digest in a compiled image. */
+#define ENDORSE_COMPILED_DIGEST_SIZE 64
+
+/**
+ * \brief The header of a compiled endorse config image.
+ *
+ * The image consists of this header, followed by the role verb bitset table,
+ * the entity table, the verb table, the role table, and finally the interned
+ * string table. All tables are sorted by name,
+ * and all names are offsets into the string table. The bitset table directly
+ * follows the header, so that its words are aligned. The source digest is the
+ * SHA-512 digest of the sources from which the image was compiled.
+ */
+typedef struct endorse_compiled_header endorse_compiled_header;
+
+struct endorse_compiled_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint8_t source_digest[ENDORSE_COMPILED_DIGEST_SIZE];
+    uint32_t entity_count;
+    uint32_t verb_count;
+    uint32_t role_count;
+    uint32_t string_table_size;
+    uint32_t bits_word_count;
+};
+
+/**
+ * \brief A compiled endorse entity. The verbs and roles for this entity are
+ * contiguous ranges in the verb and role tables.
+ */
+typedef struct endorse_compiled_entity endorse_compiled_entity;
+
+struct endorse_compiled_entity
+{
+    uint32_t name;
+    uint32_t verb_offset;
+    uint32_t verb_count;
+    uint32_t role_offset;
+    uint32_t role_count;
+};
+
+/**
+ * \brief A compiled endorse verb.
+ */
+typedef struct endorse_compiled_verb endorse_compiled_verb;
+
+struct endorse_compiled_verb
+{
+    uint32_t name;
+    RCPR_SYM(rcpr_uuid) verb_id;
+};
+
+/**
+ * \brief A compiled endorse role. The fully resolved verbs for this role,
+ * including those of any extended roles, are a bitset in the bitset table,
+ * where bit i is the i-th verb of the entity.
+ */
+typedef struct endorse_compiled_role endorse_compiled_role;
+
+struct endorse_compiled_role
+{
+    uint32_t name;
+    uint32_t bits_offset;
+};
+
+/**
+ * \brief A compiled endorse config, either built from an analyzed AST or
+ * mapped from a cache file.
+ */
+typedef struct endorse_compiled endorse_compiled;
+
+struct endorse_compiled
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    void* image;
+    size_t image_size;
+    bool mapped;
+    file* f;
+    const endorse_compiled_header* header;
+    const endorse_compiled_entity* entities;
+    const endorse_compiled_verb* verbs;
+    const endorse_compiled_role* roles;
+    const uint64_t* bits;
+    const char* strings;
 };
 
 /* helper to link our value to Bison. */
@@ -221,6 +371,45 @@ const endorse_config* endorse_config_default_context_get_endorse_config_root(
 status endorse_config_default_context_get_error_message(
     const char** msg, const endorse_config_context* context, int index);
 
+/** \brief Initial arena bytes reserved per byte of endorse config source. */
+#define ENDORSE_ARENA_INITIAL_BYTES_PER_SOURCE_BYTE 8
+
+/** \brief Maximum arena bytes reserved per byte of endorse config source. */
+#define ENDORSE_ARENA_MAX_BYTES_PER_SOURCE_BYTE 64
+
+/** \brief The minimum size of an endorse arena. */
+#define ENDORSE_ARENA_MIN_SIZE (64 * 1024)
+
+/**
+ * \brief Create an arena allocator for parsing and analyzing an endorse config.
+ *
+ * This is an RCPR bump allocator sized for a config source of the given size.
+ * Every allocation made by the endorse parser and analyzer, including strings,
+ * comes from the context allocator. If a context is created with this arena,
+ * then releasing the arena frees the context and its whole AST at once,
+ * without releasing the context or walking the AST. Reclaiming memory from the
+ * arena does nothing.
+ *
+ * The arena is fixed in size, so a config with an unusually dense role
+ * hierarchy can exhaust it, which sets out_of_memory in the context. Callers
+ * should start at \ref ENDORSE_ARENA_INITIAL_BYTES_PER_SOURCE_BYTE, and retry
+ * in a larger arena only when the arena is exhausted.
+ *
+ * \param arena                 Pointer to receive the arena allocator on
+ *                              success.
+ * \param parent                The allocator from which the arena is
+ *                              allocated.
+ * \param source_size           The size of the endorse config source.
+ * \param bytes_per_source_byte The arena bytes to reserve per byte of source.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_arena_create(
+    RCPR_SYM(allocator)** arena, RCPR_SYM(allocator)* parent,
+    size_t source_size, size_t bytes_per_source_byte);
+
 /**
  * \brief Parse a config file read into memory as a buffer.
  *
@@ -234,6 +423,48 @@ status endorse_config_default_context_get_error_message(
 status endorse_parse(
     endorse_config_context* context, const vccrypt_buffer_t* input);
 
+/**
+ * \brief Parse endorse config source directly from memory, such as a memory
+ * mapped config file.
+ *
+ * Tokens are read as slices of the source, which is neither copied nor
+ * modified; identifiers are copied only when they are interned.
+ *
+ * \param context       The endorse config context for this parse.
+ * \param source        The source to parse. It need not be ASCIIZ.
+ * \param size          The size of the source.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_parse_mapped(
+    endorse_config_context* context, const void* source, size_t size);
+
+/**
+ * \brief Merge a separately parsed config into the root config.
+ *
+ * Every entity of \p other is moved into \p root, using the same rules as
+ * the parser uses for a single file. Duplicate entity declarations, verbs, and
+ * roles are reported through \p context. An entity declaration may appear in
+ * any config, before or after the verbs and roles that refer to it.
+ *
+ * Entities keep their identifiers, which are interned in the context that
+ * parsed them, so that context must outlive \p root.
+ *
+ * \param context       The endorse config context that owns \p root.
+ * \param root          The root config into which \p other is merged.
+ * \param other         The config to merge. It is empty on return.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_MERGE_FAILED if the configs conflict.
+ *      - a non-zero error code on failure.
+ */
+status endorse_merge(
+    endorse_config_context* context, endorse_config* root,
+    endorse_config* other);
+
 /**
  * \brief Analyze the AST produced by the endorse file parser and finish
  * populating the AST with relevant data.
@@ -247,6 +478,264 @@ status endorse_parse(
  */
 status endorse_analyze(endorse_config_context* context, endorse_config* root);
 
+/**
+ * \brief Create an empty verb set.
+ *
+ * \param set           Pointer to receive the verb set on success.
+ * \param alloc         The allocator to use for this operation.
+ * \param verb_count    The number of verbs that this set can hold.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_verb_set_create(
+    endorse_verb_set** set, RCPR_SYM(allocator)* alloc, size_t verb_count);
+
+/**
+ * \brief Return true if the given verb index is in the verb set.
+ *
+ * \param set           The verb set.
+ * \param index         The dense verb index.
+ *
+ * \returns true if this verb is in the set and false otherwise.
+ */
+bool endorse_verb_set_contains(const endorse_verb_set* set, size_t index);
+
+/**
+ * \brief Return the number of verbs in the verb set.
+ *
+ * \param set           The verb set.
+ *
+ * \returns the number of verbs in this set.
+ */
+size_t endorse_verb_set_count(const endorse_verb_set* set);
+
+/**
+ * \brief Compute the 64-bit FNV-1a hash of a buffer.
+ *
+ * This is the one hash used by the endorse hash tables.
+ *
+ * \param data          The data to hash.
+ * \param size          The size of the data.
+ *
+ * \returns the 64-bit FNV-1a hash of the data.
+ */
+uint64_t endorse_hash(const void* data, size_t size);
+
+/**
+ * \brief Compile an analyzed endorse config AST into a flat image.
+ *
+ * \param compiled      Pointer to receive the compiled config on success.
+ * \param alloc         The allocator to use for this operation.
+ * \param root          The analyzed AST root to compile.
+ * \param source_digest The SHA-512 digest of the sources from which this AST
+ *                      was parsed, which is recorded in the image.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_compile(
+    endorse_compiled** compiled, RCPR_SYM(allocator)* alloc,
+    const endorse_config* root, const uint8_t* source_digest);
+
+/**
+ * \brief Write a compiled endorse config image to the given cache file.
+ *
+ * The image is written to a temporary file which is then renamed over the
+ * cache file, so concurrent readers never see a partial image. The cache file
+ * is only writable by its owner.
+ *
+ * \param f             The file interface to use.
+ * \param compiled      The compiled config to write.
+ * \param filename      The cache filename.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_compiled_write(
+    file* f, const endorse_compiled* compiled, const char* filename);
+
+/**
+ * \brief Map a compiled endorse config image from the given cache file.
+ *
+ * The cache file must be owned by the effective user, and must not be writable
+ * by its group or by others. The image is validated, and is rejected if it was
+ * not compiled from sources with the given digest.
+ *
+ * \param compiled      Pointer to receive the compiled config on success.
+ * \param alloc         The allocator to use for this operation.
+ * \param f             The file interface to use.
+ * \param filename      The cache filename.
+ * \param source_digest The SHA-512 digest of the current endorse config
+ *                      sources.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_COMPILED_UNTRUSTED if the cache file could have
+ *        been written by another user.
+ *      - VCTOOL_ERROR_ENDORSE_COMPILED_STALE if the cache was compiled from
+ *        different sources.
+ *      - a non-zero error code on failure.
+ */
+status endorse_compiled_load(
+    endorse_compiled** compiled, RCPR_SYM(allocator)* alloc, file* f,
+    const char* filename, const uint8_t* source_digest);
+
+/**
+ * \brief Find an entity in a compiled endorse config.
+ *
+ * \param compiled      The compiled config to search.
+ * \param name          The entity name.
+ *
+ * \returns the entity, or NULL if it is not found.
+ */
+const endorse_compiled_entity* endorse_compiled_find_entity(
+    const endorse_compiled* compiled, const char* name);
+
+/**
+ * \brief Return the number of bitset words needed to hold the verbs of an
+ * entity.
+ *
+ * \param entity        The compiled entity.
+ *
+ * \returns the number of 64-bit words in a verb bitset for this entity.
+ */
+size_t endorse_compiled_entity_word_count(
+    const endorse_compiled_entity* entity);
+
+/**
+ * \brief Grant the verbs of a role or verb of an entity by setting them in a
+ * verb bitset.
+ *
+ * Bit i of the bitset is the i-th verb of the entity. A role is granted with a
+ * bitwise OR of its resolved verbs, so granting several roles that share verbs
+ * sets each verb only once.
+ *
+ * \param grants        The verb bitset for this entity, which must hold
+ *                      endorse_compiled_entity_word_count() words.
+ * \param compiled      The compiled config to search.
+ * \param entity        The entity to search.
+ * \param moiety        The role or verb name.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_UNKNOWN_ROLE_OR_VERB if the moiety is not found.
+ */
+status endorse_compiled_grant_moiety(
+    uint64_t* grants, const endorse_compiled* compiled,
+    const endorse_compiled_entity* entity, const char* moiety);
+
+/**
+ * \brief Create an incremental endorse config.
+ *
+ * An incremental config splits its sources into top-level `entities`,
+ * `verbs for X`, and `roles for X` blocks. Each entity is parsed and analyzed
+ * on its own, from its declaration and its own blocks, so an update only
+ * reparses and reanalyzes the entities whose blocks changed. The analyzed
+ * config from the last successful update is kept until it is replaced.
+ *
+ * \param inc           Pointer to receive the incremental config on success.
+ * \param alloc         The allocator to use for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_incremental_create(
+    endorse_incremental** inc, RCPR_SYM(allocator)* alloc);
+
+/**
+ * \brief Get the resource handle of an incremental endorse config.
+ *
+ * \param inc           The incremental config.
+ *
+ * \returns the resource handle, which releases the incremental config.
+ */
+RCPR_SYM(resource)* endorse_incremental_resource_handle(
+    endorse_incremental* inc);
+
+/**
+ * \brief Add a source to the next update of an incremental endorse config.
+ *
+ * The source is split into blocks, which are sliced from the source without
+ * being copied, so the source must remain valid until the next call to
+ * \ref endorse_incremental_commit.
+ *
+ * \param inc           The incremental config.
+ * \param source        The source to add. It need not be ASCIIZ.
+ * \param size          The size of the source.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_incremental_add_source(
+    endorse_incremental* inc, const void* source, size_t size);
+
+/**
+ * \brief Update an incremental endorse config from the sources added since
+ * the last commit.
+ *
+ * Only the entities whose declaration or blocks changed since the last
+ * successful commit are parsed and analyzed again. If any block has errors,
+ * the analyzed config from the last successful commit is kept, and the errors
+ * can be read with \ref endorse_incremental_get_error_message.
+ *
+ * \param inc           The incremental config.
+ * \param stats         Pointer to receive the statistics for this update.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_INVALID_CONFIG if the sources have errors.
+ *      - a non-zero error code on failure.
+ */
+status endorse_incremental_commit(
+    endorse_incremental* inc, endorse_incremental_stats* stats);
+
+/**
+ * \brief Get the number of error messages from the last incremental commit.
+ *
+ * \param inc           The incremental config.
+ *
+ * \returns The number of error messages.
+ */
+size_t endorse_incremental_get_error_message_count(
+    const endorse_incremental* inc);
+
+/**
+ * \brief Get the Nth error message from the last incremental commit.
+ *
+ * \param inc           The incremental config.
+ * \param index         The error message index.
+ *
+ * \returns the error message, which is owned by the incremental config, or
+ * NULL if \p index is out of bounds.
+ */
+const char* endorse_incremental_get_error_message(
+    const endorse_incremental* inc, size_t index);
+
+/**
+ * \brief Compile the analyzed config from the last successful incremental
+ * commit into a flat image.
+ *
+ * \param compiled      Pointer to receive the compiled config on success.
+ * \param alloc         The allocator to use for this operation.
+ * \param inc           The incremental config.
+ * \param source_digest The SHA-512 digest of the sources from which this
+ *                      config was parsed, which is recorded in the image.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_INVALID_CONFIG if no commit has succeeded.
+ *      - a non-zero error code on failure.
+ */
+status endorse_incremental_compile(
+    endorse_compiled** compiled, RCPR_SYM(allocator)* alloc,
+    const endorse_incremental* inc, const uint8_t* source_digest);
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
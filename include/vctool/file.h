@@ -3,7 +3,7 @@
  *
  * \brief File interrogation and I/O wrappers.
  *
- * \copyright 2020 Velo Payments.  See License.txt for license terms.
+ * \copyright 2020-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #ifndef  VCTOOL_FILE_HEADER_GUARD
@@ -11,6 +11,7 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <vctool/status_codes.h>
 #include <vpr/disposable.h>
@@ -89,12 +90,45 @@ struct file
     /** \brief write method. */
     int (*file_write_method)(file*, int, const void*, size_t, size_t*);
 
+    /** \brief writev method. */
+    int (*file_writev_method)(file*, int, const struct iovec*, int, size_t*);
+
     /** \brief lseek method. */
     int (*file_lseek_method)(file*, int, off_t, file_lseek_whence, off_t*);
 
     /** \brief fsync method. */
     int (*file_fsync_method)(file*, int);
 
+    /** \brief fstat method. */
+    int (*file_fstat_method)(file*, int, file_stat_st*);
+
+    /** \brief mmap method. */
+    int (*file_mmap_method)(file*, int, size_t, const void**);
+
+    /** \brief munmap method. */
+    int (*file_munmap_method)(file*, const void*, size_t);
+
+    /** \brief ftruncate method. */
+    int (*file_ftruncate_method)(file*, int, off_t);
+
+    /** \brief mkdir method. */
+    int (*file_mkdir_method)(file*, const char*, mode_t);
+
+    /** \brief rename method. */
+    int (*file_rename_method)(file*, const char*, const char*);
+
+    /** \brief unlink method. */
+    int (*file_unlink_method)(file*, const char*);
+
+    /** \brief opendir method. */
+    int (*file_opendir_method)(file*, void**, const char*);
+
+    /** \brief readdir method. */
+    int (*file_readdir_method)(file*, void*, const char**);
+
+    /** \brief closedir method. */
+    int (*file_closedir_method)(file*, void*);
+
     /** \brief context structure. */
     void* context;
 };
@@ -132,6 +166,22 @@ int file_init(file* f);
  */
 int file_stat(file* f, const char* path, file_stat_st* filestat);
  
+/**
+ * \brief Get file stats for an open file descriptor.
+ *
+ * \param f         The file interface to use to gather stats.
+ * \param d         The descriptor of the file to stat.
+ * \param filestat  Structure to populate with stat information.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the file descriptor is invalid.
+ *      - VCTOOL_ERROR_FILE_KERNEL_MEMORY if the kernel ran out of memory.
+ *      - VCTOOL_ERROR_FILE_OVERFLOW if some value caused overflow.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN some unknown error occurred.
+ */
+int file_fstat(file* f, int d, file_stat_st* filestat);
+ 
 /**
  * \brief Open a file for I/O.
  *
@@ -257,6 +307,40 @@ int file_read(file* f, int d, void* buf, size_t max, size_t* rbytes);
  */
 int file_write(file* f, int d, const void* buf, size_t max, size_t* wbytes);
 
+/**
+ * \brief Write a vector of buffers to a file descriptor in a single call.
+ *
+ * \param f         The file interface.
+ * \param d         The descriptor to which data is written.
+ * \param iov       The buffers to write, in order.
+ * \param iovcnt    The number of buffers.
+ * \param wbytes    Pointer to the size_t variable to hold the number of bytes
+ *                  written.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_WOULD_BLOCK if the operation would cause the process
+ *        to block and no blocking has been set.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the file descriptor is bad.
+ *      - VCTOOL_ERROR_FILE_QUOTA if this operation violates a user quota on
+ *        disk space.
+ *      - VCTOOL_ERROR_FILE_FAULT if this operation causes a memory fault.
+ *      - VCTOOL_ERROR_FILE_OVERFLOW if an attempt is made to write to a file
+ *        that exceeds disk or user limits.
+ *      - VCTOOL_ERROR_FILE_INTERRUPT if this operation is interrupted by a
+ *        signal handler.
+ *      - VCTOOL_ERROR_FILE_INVALID_FLAGS if this operation violates flags set
+ *        for this descriptor.
+ *      - VCTOOL_ERROR_FILE_IO if a low-level I/O error occurs.
+ *      - VCTOOL_ERROR_FILE_NO_SPACE if there is no space left on this device.
+ *      - VCTOOL_ERROR_FILE_ACCESS if an access / permission issue occurs.
+ *      - VCTOOL_ERROR_FILE_BROKEN_PIPE if the remote end of this descriptor is
+ *        disconnected.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurs.
+ */
+int file_writev(
+    file* f, int d, const struct iovec* iov, int iovcnt, size_t* wbytes);
+
 /**
  * \brief Reposition the read/write offset for a file descriptor.
  *
@@ -310,6 +394,206 @@ int file_lseek(
  */
 int file_fsync(file* f, int d);
 
+/**
+ * \brief Map the start of a file read-only into memory.
+ *
+ * The mapping is shared, so data written to the file through its descriptor
+ * after it is mapped can be read through the mapping. Bytes of the mapping past
+ * the end of the file must not be read until the file has grown to cover them.
+ * The mapping outlives the descriptor, and must be released with
+ * \ref file_munmap.
+ *
+ * \param f         The file interface.
+ * \param d         The descriptor of the file to map, open for reading.
+ * \param size      The number of bytes to map; must be greater than zero.
+ * \param data      Pointer to receive the mapping.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if the descriptor is not open for reading.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the file descriptor is invalid.
+ *      - VCTOOL_ERROR_FILE_INVALID if the size is zero or too large.
+ *      - VCTOOL_ERROR_FILE_KERNEL_MEMORY if the mapping could not be created.
+ *      - VCTOOL_ERROR_FILE_NOT_SUPPORTED if the file can't be mapped.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_mmap(file* f, int d, size_t size, const void** data);
+
+/**
+ * \brief Release a mapping created with \ref file_mmap.
+ *
+ * \param f         The file interface.
+ * \param data      The mapping to release.
+ * \param size      The size of the mapping.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_INVALID if this is not a mapping of this size.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_munmap(file* f, const void* data, size_t size);
+
+/**
+ * \brief Truncate or extend a file to the given size.
+ *
+ * \param f         The file interface.
+ * \param d         The descriptor of the file, open for writing.
+ * \param length    The new size of the file; an extended file reads as zeroes.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if the file can't be written.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the file descriptor is invalid.
+ *      - VCTOOL_ERROR_FILE_INTERRUPT if this operation was interrupted by a
+ *        signal handler.
+ *      - VCTOOL_ERROR_FILE_INVALID if the length is negative, or the
+ *        descriptor is not open for writing.
+ *      - VCTOOL_ERROR_FILE_IO if an I/O error occurred.
+ *      - VCTOOL_ERROR_FILE_OVERFLOW if the length is larger than the maximum
+ *        file size.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_ftruncate(file* f, int d, off_t length);
+
+/**
+ * \brief Create a directory.
+ *
+ * \param f         The file interface.
+ * \param path      Path to the directory to create.
+ * \param mode      Mode of the new directory.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if the parent directory can't be written.
+ *      - VCTOOL_ERROR_FILE_EXISTS if the path already exists.
+ *      - VCTOOL_ERROR_FILE_LOOP if too many symlinks were encountered.
+ *      - VCTOOL_ERROR_FILE_NAME_TOO_LONG if the path name is too long.
+ *      - VCTOOL_ERROR_FILE_NO_ENTRY if a component of the path does not exist.
+ *      - VCTOOL_ERROR_FILE_NO_SPACE if there is no space left on this device.
+ *      - VCTOOL_ERROR_FILE_NOT_DIRECTORY if a component of the path is not a
+ *        directory.
+ *      - VCTOOL_ERROR_FILE_QUOTA if a quota issue occurred.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_mkdir(file* f, const char* path, mode_t mode);
+
+/**
+ * \brief Rename a file, replacing any file at the new path.
+ *
+ * \param f         The file interface.
+ * \param oldpath   The current path of the file.
+ * \param newpath   The new path of the file.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if either directory can't be written.
+ *      - VCTOOL_ERROR_FILE_EXISTS if the new path is a non-empty directory.
+ *      - VCTOOL_ERROR_FILE_IS_DIRECTORY if the new path is a directory and the
+ *        old path is not.
+ *      - VCTOOL_ERROR_FILE_LOOP if too many symlinks were encountered.
+ *      - VCTOOL_ERROR_FILE_NAME_TOO_LONG if a path name is too long.
+ *      - VCTOOL_ERROR_FILE_NO_ENTRY if the old path does not exist.
+ *      - VCTOOL_ERROR_FILE_NO_SPACE if there is no space left on this device.
+ *      - VCTOOL_ERROR_FILE_NOT_DIRECTORY if a component of a path is not a
+ *        directory.
+ *      - VCTOOL_ERROR_FILE_NOT_SUPPORTED if the paths are on different
+ *        filesystems, or the filesystem is read-only.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_rename(file* f, const char* oldpath, const char* newpath);
+
+/**
+ * \brief Remove a file.
+ *
+ * \param f         The file interface.
+ * \param path      Path to the file to remove.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if the directory can't be written.
+ *      - VCTOOL_ERROR_FILE_IO if an I/O error occurred.
+ *      - VCTOOL_ERROR_FILE_IS_DIRECTORY if the path is a directory.
+ *      - VCTOOL_ERROR_FILE_LOOP if too many symlinks were encountered.
+ *      - VCTOOL_ERROR_FILE_NAME_TOO_LONG if the path name is too long.
+ *      - VCTOOL_ERROR_FILE_NO_ENTRY if the file does not exist.
+ *      - VCTOOL_ERROR_FILE_NOT_DIRECTORY if a component of the path is not a
+ *        directory.
+ *      - VCTOOL_ERROR_FILE_NOT_SUPPORTED if the filesystem is read-only.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_unlink(file* f, const char* path);
+
+/**
+ * \brief Open a directory to read its entries.
+ *
+ * \param f         The file interface.
+ * \param dir       Pointer to receive the directory handle, which must be
+ *                  closed with \ref file_closedir.
+ * \param path      Path to the directory.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if the directory can't be read.
+ *      - VCTOOL_ERROR_FILE_KERNEL_MEMORY if the kernel ran out of memory.
+ *      - VCTOOL_ERROR_FILE_NO_ENTRY if the directory does not exist.
+ *      - VCTOOL_ERROR_FILE_NOT_DIRECTORY if the path is not a directory.
+ *      - VCTOOL_ERROR_FILE_TOO_MANY_FILES if too many files are open for this
+ *        process or the whole system.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_opendir(file* f, void** dir, const char* path);
+
+/**
+ * \brief Read the next entry of a directory.
+ *
+ * Entries are returned in no particular order, and include . and ..
+ *
+ * \param f         The file interface.
+ * \param dir       The directory handle.
+ * \param name      Pointer to receive the name of the next entry, which is
+ *                  valid until the next read or close of this handle, or NULL
+ *                  after the last entry.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the directory handle is invalid.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_readdir(file* f, void* dir, const char** name);
+
+/**
+ * \brief Close a directory handle.
+ *
+ * \param f         The file interface.
+ * \param dir       The directory handle to close.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the directory handle is invalid.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_closedir(file* f, void* dir);
+
+/**
+ * \brief Map the contents of a file read-only into memory.
+ *
+ * The file is opened, mapped at its current size, and closed again. An empty
+ * file is not mapped; \p data is set to NULL and \p size to zero. Otherwise,
+ * the mapping must be released with \ref file_munmap.
+ *
+ * \param f         The file interface.
+ * \param path      Path to the file to map.
+ * \param data      Pointer to receive the mapping.
+ * \param size      Pointer to receive the size of the mapping.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code from \ref file_open, \ref file_fstat, or
+ *        \ref file_mmap on failure.
+ */
+int file_map_contents(
+    file* f, const char* path, const void** data, size_t* size);
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
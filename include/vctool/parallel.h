@@ -0,0 +1,65 @@
+/**
+ * \file include/vctool/parallel.h
+ *
+ * \brief Helpers for running independent jobs on a pool of worker threads.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief The maximum number of worker threads used by \ref parallel_for. */
+#define PARALLEL_MAX_WORKERS                64
+
+/**
+ * \brief A job function, run once for each job index.
+ *
+ * \param context       The user context passed to \ref parallel_for.
+ * \param index         The index of the job to run.
+ */
+typedef void (*parallel_job_fn)(void* context, size_t index);
+
+/**
+ * \brief Return the number of workers to use for the given number of jobs.
+ *
+ * This is one worker per online processor, but never more than the number of
+ * jobs, never more than \ref PARALLEL_MAX_WORKERS, and at least one if there is
+ * at least one job.
+ *
+ * \param job_count     The number of jobs to run.
+ *
+ * \returns the number of workers to use.
+ */
+size_t parallel_worker_count(size_t job_count);
+
+/**
+ * \brief Run the given job function once for each index in [0, job_count) on a
+ * pool of worker threads, and wait for all jobs to complete.
+ *
+ * Jobs are claimed dynamically, so slow jobs don't hold up the rest of the
+ * pool. The calling thread acts as one of the workers, so a single job runs
+ * without creating any threads. If a worker thread can't be created, the
+ * remaining workers pick up its jobs. Job functions record their own results
+ * in the user context.
+ *
+ * \param job_count     The number of jobs to run.
+ * \param func          The job function.
+ * \param context       The user context for the job function.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int parallel_for(size_t job_count, parallel_job_fn func, void* context);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
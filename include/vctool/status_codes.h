@@ -10,7 +10,9 @@
 #define VCTOOL_STATUS_CODES_HEADER_GUARD
 
 #include <vctool/components.h>
+#include <vctool/status_codes/agent.h>
 #include <vctool/status_codes/backup.h>
+#include <vctool/status_codes/block.h>
 #include <vctool/status_codes/certificate.h>
 #include <vctool/status_codes/commandline.h>
 #include <vctool/status_codes/endorse.h>
@@ -19,6 +21,7 @@
 #include <vctool/status_codes/keygen.h>
 #include <vctool/status_codes/pubkey.h>
 #include <vctool/status_codes/readpassword.h>
+#include <vctool/status_codes/transaction.h>
 
 /* make this header C++ friendly. */
 #ifdef __cplusplus
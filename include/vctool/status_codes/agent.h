@@ -0,0 +1,66 @@
+/**
+ * \file include/vctool/status_codes/agent.h
+ *
+ * \brief Status codes for the agent component.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#ifndef VCTOOL_STATUS_CODES_AGENT_HEADER_GUARD
+#define VCTOOL_STATUS_CODES_AGENT_HEADER_GUARD
+
+#include <vctool/status_codes.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Could not connect to the agent.
+ */
+#define VCTOOL_ERROR_AGENT_CONNECT_FAILED \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_AGENT, 0x0001U)
+
+/**
+ * \brief The agent connection was closed.
+ */
+#define VCTOOL_ERROR_AGENT_CONNECTION_CLOSED \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_AGENT, 0x0002U)
+
+/**
+ * \brief An error occurred reading from or writing to the agent connection.
+ */
+#define VCTOOL_ERROR_AGENT_IO \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_AGENT, 0x0003U)
+
+/**
+ * \brief A message is malformed or too large.
+ */
+#define VCTOOL_ERROR_AGENT_PROTOCOL \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_AGENT, 0x0004U)
+
+/**
+ * \brief The agent could not find the requested item.
+ */
+#define VCTOOL_ERROR_AGENT_NOT_FOUND \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_AGENT, 0x0005U)
+
+/**
+ * \brief The agent rejected the request.
+ */
+#define VCTOOL_ERROR_AGENT_REQUEST_FAILED \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_AGENT, 0x0006U)
+
+/**
+ * \brief The handshake with the agent failed.
+ */
+#define VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_AGENT, 0x0007U)
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*VCTOOL_STATUS_CODES_AGENT_HEADER_GUARD*/
@@ -28,6 +28,24 @@ extern "C" {
 #define VCTOOL_ERROR_BACKUP_TRUNCATED_RECORD \
     VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_BACKUP, 0x0002U)
 
+/**
+ * \brief The backup file encryption header is not valid.
+ */
+#define VCTOOL_ERROR_BACKUP_BAD_HEADER \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_BACKUP, 0x0003U)
+
+/**
+ * \brief A backup header or record failed authentication.
+ */
+#define VCTOOL_ERROR_BACKUP_BAD_MAC \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_BACKUP, 0x0004U)
+
+/**
+ * \brief A backup record is malformed.
+ */
+#define VCTOOL_ERROR_BACKUP_BAD_RECORD \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_BACKUP, 0x0005U)
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
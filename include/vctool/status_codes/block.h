@@ -0,0 +1,67 @@
+/**
+ * \file include/vctool/status_codes/block.h
+ *
+ * \brief Status codes for the block component.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#ifndef VCTOOL_STATUS_CODES_BLOCK_HEADER_GUARD
+#define VCTOOL_STATUS_CODES_BLOCK_HEADER_GUARD
+
+#include <vctool/status_codes.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief A field required to verify a block is missing.
+ */
+#define VCTOOL_ERROR_BLOCK_MISSING_FIELD \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_BLOCK, 0x0001U)
+
+/**
+ * \brief A block field has the wrong size.
+ */
+#define VCTOOL_ERROR_BLOCK_INVALID_FIELD_SIZE \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_BLOCK, 0x0002U)
+
+/**
+ * \brief Two blocks have the same height.
+ */
+#define VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_BLOCK, 0x0003U)
+
+/**
+ * \brief A block height is missing from the chain.
+ */
+#define VCTOOL_ERROR_BLOCK_HEIGHT_GAP \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_BLOCK, 0x0004U)
+
+/**
+ * \brief The previous block id of a block does not match the block before it.
+ */
+#define VCTOOL_ERROR_BLOCK_PREVIOUS_MISMATCH \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_BLOCK, 0x0005U)
+
+/**
+ * \brief A block store index is not valid, or names a block outside of its
+ * segments.
+ */
+#define VCTOOL_ERROR_BLOCK_STORE_BAD_INDEX \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_BLOCK, 0x0006U)
+
+/**
+ * \brief A block is too large to be appended to a block store segment.
+ */
+#define VCTOOL_ERROR_BLOCK_STORE_BLOCK_TOO_LARGE \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_BLOCK, 0x0007U)
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*VCTOOL_STATUS_CODES_BLOCK_HEADER_GUARD*/
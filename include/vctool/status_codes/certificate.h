@@ -3,7 +3,7 @@
  *
  * \brief Status codes for the certificate component.
  *
- * \copyright 2020 Velo Payments.  See License.txt for license terms.
+ * \copyright 2020-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #ifndef VCTOOL_STATUS_CODES_CERTIFICATE_HEADER_GUARD
@@ -28,6 +28,31 @@ extern "C" {
 #define VCTOOL_ERROR_CERTIFICATE_VERIFICATION \
     VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_CERTIFICATE, 0x0002U)
 
+/**
+ * \brief The requested certificate field was not found.
+ */
+#define VCTOOL_ERROR_CERTIFICATE_FIELD_NOT_FOUND \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_CERTIFICATE, 0x0003U)
+
+/**
+ * \brief A certificate field header or value runs past the end of the
+ * certificate.
+ */
+#define VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_CERTIFICATE, 0x0004U)
+
+/**
+ * \brief The certificate signature is not valid.
+ */
+#define VCTOOL_ERROR_CERTIFICATE_BAD_SIGNATURE \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_CERTIFICATE, 0x0005U)
+
+/**
+ * \brief The certificate was signed by an unknown signer.
+ */
+#define VCTOOL_ERROR_CERTIFICATE_UNKNOWN_SIGNER \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_CERTIFICATE, 0x0006U)
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
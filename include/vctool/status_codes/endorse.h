@@ -3,7 +3,7 @@
  *
  * \brief Status codes for the endorse component.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #ifndef VCTOOL_STATUS_CODES_ENDORSE_HEADER_GUARD
@@ -34,6 +34,55 @@ extern "C" {
 #define VCTOOL_ERROR_ENDORSE_UNKNOWN_ROLE_OR_VERB \
     VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_ENDORSE, 0x0003U)
 
+/**
+ * \brief One or more certificates in a batch endorsement failed.
+ */
+#define VCTOOL_ERROR_ENDORSE_BATCH_FAILED \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_ENDORSE, 0x0004U)
+
+/**
+ * \brief The compiled endorse config was built from a different source.
+ */
+#define VCTOOL_ERROR_ENDORSE_COMPILED_STALE \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_ENDORSE, 0x0005U)
+
+/**
+ * \brief The compiled endorse config image is invalid.
+ */
+#define VCTOOL_ERROR_ENDORSE_COMPILED_INVALID \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_ENDORSE, 0x0006U)
+
+/**
+ * \brief The compiled endorse config cache could have been written by another
+ * user.
+ */
+#define VCTOOL_ERROR_ENDORSE_COMPILED_UNTRUSTED \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_ENDORSE, 0x0007U)
+
+/**
+ * \brief A permission refers to an entity with no UUID.
+ */
+#define VCTOOL_ERROR_ENDORSE_MISSING_UUID \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_ENDORSE, 0x0008U)
+
+/**
+ * \brief An endorse arena was too small for the endorse config.
+ */
+#define VCTOOL_ERROR_ENDORSE_ARENA_EXHAUSTED \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_ENDORSE, 0x0009U)
+
+/**
+ * \brief Separately parsed endorse configs could not be merged.
+ */
+#define VCTOOL_ERROR_ENDORSE_MERGE_FAILED \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_ENDORSE, 0x000AU)
+
+/**
+ * \brief The endorse config has errors.
+ */
+#define VCTOOL_ERROR_ENDORSE_INVALID_CONFIG \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_ENDORSE, 0x000BU)
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
@@ -22,6 +22,18 @@ extern "C" {
 #define VCTOOL_ERROR_PUBKEY_WOULD_CLOBBER_FILE \
     VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_PUBKEY, 0x0001U)
 
+/**
+ * \brief The pubkey input is neither a directory nor a manifest of keypairs.
+ */
+#define VCTOOL_ERROR_PUBKEY_BAD_INPUT \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_PUBKEY, 0x0002U)
+
+/**
+ * \brief One or more keypairs in a batch pubkey operation failed.
+ */
+#define VCTOOL_ERROR_PUBKEY_BATCH_FAILED \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_PUBKEY, 0x0003U)
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
@@ -0,0 +1,54 @@
+/**
+ * \file include/vctool/status_codes/transaction.h
+ *
+ * \brief Status codes for the transaction component.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#ifndef VCTOOL_STATUS_CODES_TRANSACTION_HEADER_GUARD
+#define VCTOOL_STATUS_CODES_TRANSACTION_HEADER_GUARD
+
+#include <vctool/status_codes.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief A transaction manifest line is malformed.
+ */
+#define VCTOOL_ERROR_TRANSACTION_SYNTAX \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_TRANSACTION, 0x0001U)
+
+/**
+ * \brief A transaction manifest names an unknown field.
+ */
+#define VCTOOL_ERROR_TRANSACTION_UNKNOWN_FIELD \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_TRANSACTION, 0x0002U)
+
+/**
+ * \brief A transaction manifest sets a field more than once.
+ */
+#define VCTOOL_ERROR_TRANSACTION_DUPLICATE_FIELD \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_TRANSACTION, 0x0003U)
+
+/**
+ * \brief A field required to build a transaction is missing.
+ */
+#define VCTOOL_ERROR_TRANSACTION_MISSING_FIELD \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_TRANSACTION, 0x0004U)
+
+/**
+ * \brief A transaction field value is not a valid UUID or number.
+ */
+#define VCTOOL_ERROR_TRANSACTION_BAD_VALUE \
+    VCTOOL_STATUS_ERROR_MACRO(VCTOOL_COMPONENT_TRANSACTION, 0x0005U)
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*VCTOOL_STATUS_CODES_TRANSACTION_HEADER_GUARD*/
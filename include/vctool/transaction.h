@@ -0,0 +1,230 @@
+/**
+ * \file include/vctool/transaction.h
+ *
+ * \brief Transaction manifest parsing and transaction certificate fields.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#ifndef  VCTOOL_TRANSACTION_HEADER_GUARD
+# define VCTOOL_TRANSACTION_HEADER_GUARD
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief The size of a transaction, artifact, or transaction type id. */
+#define TRANSACTION_ID_SIZE 16
+
+/**
+ * \brief The fields of a transaction that can be set in a manifest.
+ */
+typedef enum transaction_field
+{
+    TRANSACTION_FIELD_TRANSACTION_ID,
+    TRANSACTION_FIELD_PREVIOUS_TRANSACTION_ID,
+    TRANSACTION_FIELD_TRANSACTION_TYPE,
+    TRANSACTION_FIELD_ARTIFACT_ID,
+    TRANSACTION_FIELD_PREVIOUS_STATE,
+    TRANSACTION_FIELD_NEW_STATE,
+    TRANSACTION_FIELD_VALID_FROM,
+
+    /** \brief The number of transaction fields. */
+    TRANSACTION_FIELD_COUNT,
+} transaction_field;
+
+/** \brief The bit for the given field in \ref transaction_spec::fields. */
+#define TRANSACTION_FIELD_BIT(field) (1U << (field))
+
+/** \brief The fields that every manifest entry must set. */
+#define TRANSACTION_REQUIRED_FIELDS \
+    (   TRANSACTION_FIELD_BIT(TRANSACTION_FIELD_TRANSACTION_TYPE) \
+      | TRANSACTION_FIELD_BIT(TRANSACTION_FIELD_ARTIFACT_ID) \
+      | TRANSACTION_FIELD_BIT(TRANSACTION_FIELD_PREVIOUS_STATE) \
+      | TRANSACTION_FIELD_BIT(TRANSACTION_FIELD_NEW_STATE))
+
+/**
+ * \brief A single transaction, as described by a manifest entry.
+ *
+ * Fields that are not set are zero; \ref fields records which were set.
+ */
+typedef struct transaction_spec
+{
+    uint8_t transaction_id[TRANSACTION_ID_SIZE];
+    uint8_t previous_transaction_id[TRANSACTION_ID_SIZE];
+    uint8_t transaction_type[TRANSACTION_ID_SIZE];
+    uint8_t artifact_id[TRANSACTION_ID_SIZE];
+    uint32_t previous_state;
+    uint32_t new_state;
+    uint64_t valid_from;
+    unsigned int fields;
+} transaction_spec;
+
+/**
+ * \brief The column layout of a CSV manifest, read from its header row.
+ */
+typedef struct transaction_csv_header
+{
+    transaction_field columns[TRANSACTION_FIELD_COUNT];
+    size_t column_count;
+} transaction_csv_header;
+
+/**
+ * \brief The ids of a transaction certificate: its own, the previous
+ * transaction of its artifact, and its artifact.
+ */
+typedef struct transaction_info
+{
+    uint8_t transaction_id[TRANSACTION_ID_SIZE];
+    uint8_t previous_transaction_id[TRANSACTION_ID_SIZE];
+    uint8_t artifact_id[TRANSACTION_ID_SIZE];
+} transaction_info;
+
+/**
+ * \brief Look up a transaction field by its manifest name.
+ *
+ * \param field             Pointer to receive the field.
+ * \param name              The field name; this need not be ASCIIZ.
+ * \param size              The size of the field name.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_UNKNOWN_FIELD if the name is not known.
+ */
+int transaction_field_lookup(
+    transaction_field* field, const char* name, size_t size);
+
+/**
+ * \brief Set a field of a transaction spec from its manifest value.
+ *
+ * Id fields are UUID strings, and every other field is a decimal number.
+ *
+ * \param spec              The transaction spec to update.
+ * \param field             The field to set.
+ * \param value             The field value; this need not be ASCIIZ.
+ * \param size              The size of the field value.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_DUPLICATE_FIELD if the field is already set.
+ *      - VCTOOL_ERROR_TRANSACTION_BAD_VALUE if the value is invalid.
+ */
+int transaction_spec_set_field(
+    transaction_spec* spec, transaction_field field, const char* value,
+    size_t size);
+
+/**
+ * \brief Parse a JSON Lines manifest entry.
+ *
+ * The entry is a single flat JSON object whose values are strings or
+ * non-negative integers, such as
+ * {"artifact_id": "...", "transaction_type": "...", "previous_state": 0,
+ * "new_state": 1}.
+ *
+ * \param spec              The transaction spec to populate.
+ * \param line              The manifest line, without its line ending.
+ * \param size              The size of the manifest line.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_SYNTAX if the line is malformed.
+ *      - VCTOOL_ERROR_TRANSACTION_MISSING_FIELD if a required field is missing.
+ *      - a non-zero error code from \ref transaction_field_lookup or
+ *        \ref transaction_spec_set_field on failure.
+ */
+int transaction_spec_parse_json(
+    transaction_spec* spec, const char* line, size_t size);
+
+/**
+ * \brief Parse the header row of a CSV manifest.
+ *
+ * Each column is named for the transaction field it holds.
+ *
+ * \param header            The CSV header to populate.
+ * \param line              The header row, without its line ending.
+ * \param size              The size of the header row.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_UNKNOWN_FIELD if a column is not known.
+ *      - VCTOOL_ERROR_TRANSACTION_DUPLICATE_FIELD if a column is repeated.
+ *      - VCTOOL_ERROR_TRANSACTION_SYNTAX if the row is malformed.
+ */
+int transaction_csv_header_parse(
+    transaction_csv_header* header, const char* line, size_t size);
+
+/**
+ * \brief Parse a CSV manifest row.
+ *
+ * An empty column leaves its field unset.
+ *
+ * \param spec              The transaction spec to populate.
+ * \param header            The CSV header of this manifest.
+ * \param line              The manifest row, without its line ending.
+ * \param size              The size of the manifest row.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_SYNTAX if the row is malformed or does not
+ *        match the header.
+ *      - VCTOOL_ERROR_TRANSACTION_MISSING_FIELD if a required field is missing.
+ *      - VCTOOL_ERROR_TRANSACTION_BAD_VALUE if a value is invalid.
+ */
+int transaction_spec_parse_csv(
+    transaction_spec* spec, const transaction_csv_header* header,
+    const char* line, size_t size);
+
+/**
+ * \brief Split the next column from a CSV row.
+ *
+ * Surrounding whitespace is trimmed, and a quoted column has its quotes
+ * removed. Quoted columns can't hold quotes or commas.
+ *
+ * \param column            Pointer to receive the start of the column.
+ * \param column_size       Pointer to receive the size of the column.
+ * \param offset            The offset of the column in the row; on success,
+ *                          this is updated to the offset of the next column,
+ *                          or to one past the end of the row after the last
+ *                          column.
+ * \param line              The row.
+ * \param size              The size of the row.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_SYNTAX if a quoted column is malformed.
+ */
+int transaction_csv_next_column(
+    const char** column, size_t* column_size, size_t* offset,
+    const char* line, size_t size);
+
+/**
+ * \brief Read the transaction id, previous transaction id, and artifact id of
+ * a transaction certificate.
+ *
+ * The certificate fields are scanned once. The signature is not verified. The
+ * previous transaction id of the first transaction of an artifact is zero.
+ *
+ * \param info              The transaction info to populate.
+ * \param cert              The transaction certificate.
+ * \param cert_size         The size of the transaction certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_MISSING_FIELD if a field is missing.
+ *      - VCTOOL_ERROR_TRANSACTION_BAD_VALUE if a field has the wrong size.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED if the certificate is
+ *        malformed.
+ */
+int transaction_info_read(
+    transaction_info* info, const void* cert, size_t cert_size);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*VCTOOL_TRANSACTION_HEADER_GUARD*/
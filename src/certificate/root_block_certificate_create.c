@@ -0,0 +1,171 @@
+/**
+ * \file certificate/root_block_certificate_create.c
+ *
+ * \brief Create a signed root block certificate.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vccert/certificate_types.h>
+#include <vccert/fields.h>
+#include <vctool/certificate.h>
+
+/* the root block is the first block, so it has no previous block. */
+static const uint8_t root_block_previous_block_id[16] = { 0 };
+
+/**
+ * \brief Create a signed root block certificate.
+ *
+ * The certificate is built in a single builder pass, sized up front for every
+ * field, the signer id, and the signature. Given the same block id, timestamp,
+ * and signing key, the output is byte-identical.
+ *
+ * \param opts              The command-line options to use.
+ * \param root_block        Pointer to a vccrypt buffer to be initialized and
+ *                          that will hold the signed root block.
+ * \param block_id          The 16 byte id of the root block.
+ * \param valid_from        The timestamp of the root block, in seconds since
+ *                          the epoch.
+ * \param signer_id         The 16 byte id of the signer.
+ * \param signing_privkey   The private signing key of the signer.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int root_block_certificate_create(
+    commandline_opts* opts, vccrypt_buffer_t* root_block,
+    const uint8_t* block_id, uint64_t valid_from, const uint8_t* signer_id,
+    const vccrypt_buffer_t* signing_privkey)
+{
+    int retval;
+    vccert_builder_context_t builder;
+    const uint8_t* cert;
+    size_t cert_size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+    MODEL_ASSERT(NULL != root_block);
+    MODEL_ASSERT(NULL != block_id);
+    MODEL_ASSERT(NULL != signer_id);
+    MODEL_ASSERT(NULL != signing_privkey);
+
+    /* size the builder for exactly the fields of a signed root block. */
+    size_t builder_size =
+        vccert_builder_field_size(sizeof(uint32_t)) /* version */
+      + vccert_builder_field_size(sizeof(uint64_t)) /* valid from */
+      + vccert_builder_field_size(sizeof(uint16_t)) /* crypto suite */
+      + vccert_builder_field_size(16)               /* certificate type */
+      + vccert_builder_field_size(16)               /* block id */
+      + vccert_builder_field_size(16)               /* previous block id */
+      + vccert_builder_field_size(sizeof(uint64_t)) /* block height */
+      + vccert_builder_field_size(16)               /* signer id */
+      + vccert_builder_field_size(opts->suite->sign_opts.signature_size);
+
+    /* create a builder instance. */
+    retval = vccert_builder_init(opts->builder_opts, &builder, builder_size);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* Add the certificate version. */
+    retval =
+        vccert_builder_add_short_uint32(
+            &builder, VCCERT_FIELD_TYPE_CERTIFICATE_VERSION, 0x00010000UL);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* Add the timestamp. */
+    retval =
+        vccert_builder_add_short_uint64(
+            &builder, VCCERT_FIELD_TYPE_CERTIFICATE_VALID_FROM, valid_from);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* Add the crypto suite. */
+    retval =
+        vccert_builder_add_short_uint16(
+            &builder, VCCERT_FIELD_TYPE_CERTIFICATE_CRYPTO_SUITE,
+            (uint16_t)VCCRYPT_SUITE_VELO_V1);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* Add the certificate type. */
+    retval =
+        vccert_builder_add_short_UUID(
+            &builder, VCCERT_FIELD_TYPE_CERTIFICATE_TYPE,
+            vccert_certificate_type_uuid_root_block);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* Add the block id. */
+    retval =
+        vccert_builder_add_short_UUID(
+            &builder, VCCERT_FIELD_TYPE_BLOCK_UUID, block_id);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* Add the previous block id. */
+    retval =
+        vccert_builder_add_short_UUID(
+            &builder, VCCERT_FIELD_TYPE_PREVIOUS_BLOCK_UUID,
+            root_block_previous_block_id);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* Add the block height; the root block is at height zero. */
+    retval =
+        vccert_builder_add_short_uint64(
+            &builder, VCCERT_FIELD_TYPE_BLOCK_HEIGHT, 0);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* Add the signer id and sign the block. */
+    retval = vccert_builder_sign(&builder, signer_id, signing_privkey);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* emit the certificate. */
+    cert = vccert_builder_emit(&builder, &cert_size);
+
+    /* initialize the root block buffer. */
+    retval =
+        vccrypt_buffer_init(root_block, opts->suite->alloc_opts, cert_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* copy the builder data into the root block. */
+    memcpy(root_block->data, cert, root_block->size);
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+
+    /* fall-through */
+
+cleanup_builder:
+    dispose((disposable_t*)&builder);
+
+done:
+    return retval;
+}
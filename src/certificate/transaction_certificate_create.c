@@ -0,0 +1,187 @@
+/**
+ * \file certificate/transaction_certificate_create.c
+ *
+ * \brief Create a signed transaction certificate.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vccert/fields.h>
+#include <vctool/certificate.h>
+
+/**
+ * \brief Create a signed transaction certificate.
+ *
+ * The certificate is built in a single builder pass, sized up front for every
+ * field, the signer id, and the signature. This is safe to call from a worker
+ * thread.
+ *
+ * \param opts              The command-line options to use.
+ * \param txn               Pointer to a vccrypt buffer to be initialized and
+ *                          that will hold the signed transaction.
+ * \param spec              The transaction, with its transaction id and
+ *                          timestamp set.
+ * \param signer_id         The 16 byte id of the signer.
+ * \param signing_privkey   The private signing key of the signer.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int transaction_certificate_create(
+    commandline_opts* opts, vccrypt_buffer_t* txn,
+    const transaction_spec* spec, const uint8_t* signer_id,
+    const vccrypt_buffer_t* signing_privkey)
+{
+    int retval;
+    vccert_builder_context_t builder;
+    const uint8_t* cert;
+    size_t cert_size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+    MODEL_ASSERT(NULL != txn);
+    MODEL_ASSERT(NULL != spec);
+    MODEL_ASSERT(NULL != signer_id);
+    MODEL_ASSERT(NULL != signing_privkey);
+
+    /* size the builder for exactly the fields of a signed transaction. */
+    size_t builder_size =
+        vccert_builder_field_size(sizeof(uint32_t)) /* version */
+      + vccert_builder_field_size(sizeof(uint64_t)) /* valid from */
+      + vccert_builder_field_size(sizeof(uint16_t)) /* crypto suite */
+      + vccert_builder_field_size(16)               /* transaction type */
+      + vccert_builder_field_size(16)               /* transaction id */
+      + vccert_builder_field_size(16)               /* previous txn id */
+      + vccert_builder_field_size(16)               /* artifact id */
+      + vccert_builder_field_size(sizeof(uint32_t)) /* previous state */
+      + vccert_builder_field_size(sizeof(uint32_t)) /* new state */
+      + vccert_builder_field_size(16)               /* signer id */
+      + vccert_builder_field_size(opts->suite->sign_opts.signature_size);
+
+    /* create a builder instance. */
+    retval = vccert_builder_init(opts->builder_opts, &builder, builder_size);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* Add the certificate version. */
+    retval =
+        vccert_builder_add_short_uint32(
+            &builder, VCCERT_FIELD_TYPE_CERTIFICATE_VERSION, 0x00010000UL);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* Add the timestamp. */
+    retval =
+        vccert_builder_add_short_uint64(
+            &builder, VCCERT_FIELD_TYPE_CERTIFICATE_VALID_FROM,
+            spec->valid_from);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* Add the crypto suite. */
+    retval =
+        vccert_builder_add_short_uint16(
+            &builder, VCCERT_FIELD_TYPE_CERTIFICATE_CRYPTO_SUITE,
+            (uint16_t)VCCRYPT_SUITE_VELO_V1);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* the certificate type of a transaction is its transaction type. */
+    retval =
+        vccert_builder_add_short_UUID(
+            &builder, VCCERT_FIELD_TYPE_CERTIFICATE_TYPE,
+            spec->transaction_type);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* Add the transaction id. */
+    retval =
+        vccert_builder_add_short_UUID(
+            &builder, VCCERT_FIELD_TYPE_CERTIFICATE_ID, spec->transaction_id);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* Add the previous transaction id. */
+    retval =
+        vccert_builder_add_short_UUID(
+            &builder, VCCERT_FIELD_TYPE_PREVIOUS_CERTIFICATE_ID,
+            spec->previous_transaction_id);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* Add the artifact id. */
+    retval =
+        vccert_builder_add_short_UUID(
+            &builder, VCCERT_FIELD_TYPE_ARTIFACT_ID, spec->artifact_id);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* Add the previous artifact state. */
+    retval =
+        vccert_builder_add_short_uint32(
+            &builder, VCCERT_FIELD_TYPE_PREVIOUS_ARTIFACT_STATE,
+            spec->previous_state);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* Add the new artifact state. */
+    retval =
+        vccert_builder_add_short_uint32(
+            &builder, VCCERT_FIELD_TYPE_NEW_ARTIFACT_STATE, spec->new_state);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* Add the signer id and sign the transaction. */
+    retval = vccert_builder_sign(&builder, signer_id, signing_privkey);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* emit the certificate. */
+    cert = vccert_builder_emit(&builder, &cert_size);
+
+    /* initialize the transaction buffer. */
+    retval = vccrypt_buffer_init(txn, opts->suite->alloc_opts, cert_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* copy the builder data into the transaction. */
+    memcpy(txn->data, cert, txn->size);
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+
+    /* fall-through */
+
+cleanup_builder:
+    dispose((disposable_t*)&builder);
+
+done:
+    return retval;
+}
@@ -0,0 +1,63 @@
+/**
+ * \file command/endorse/endorse_batch_run.c
+ *
+ * \brief Endorse every input certificate in a batch.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Run every job in the batch on the worker pool and report the result.
+ *
+ * \param batch         The batch to run.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS if every job succeeded.
+ *      - a non-zero error code on failure.
+ */
+status endorse_batch_run(endorse_batch* batch)
+{
+    status retval;
+    size_t failed = 0;
+
+    /* endorse each input certificate on the worker pool. */
+    TRY_OR_FAIL(
+        parallel_for(batch->job_count, &endorse_batch_worker, batch), done);
+
+    /* a single job reports its own status. */
+    if (1 == batch->job_count)
+    {
+        retval = batch->jobs[0].result;
+        goto done;
+    }
+
+    /* count failures. */
+    for (size_t i = 0; i < batch->job_count; ++i)
+    {
+        if (STATUS_SUCCESS != batch->jobs[i].result)
+        {
+            fprintf(
+                stderr, "Error endorsing %s.\n",
+                batch->jobs[i].input_file->filename);
+            ++failed;
+        }
+    }
+
+    /* report failures. */
+    if (failed > 0)
+    {
+        fprintf(
+            stderr, "%zu of %zu certificates failed.\n", failed,
+            batch->job_count);
+        retval = VCTOOL_ERROR_ENDORSE_BATCH_FAILED;
+        goto done;
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+
+done:
+    return retval;
+}
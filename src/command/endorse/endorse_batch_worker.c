@@ -0,0 +1,48 @@
+/**
+ * \file command/endorse/endorse_batch_worker.c
+ *
+ * \brief Endorse a single input certificate from a batch.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Endorse a single input certificate from the batch.
+ *
+ * This is a \ref parallel_job_fn; the result is recorded in the job.
+ *
+ * \param context       The endorse batch.
+ * \param index         The index of the job to run.
+ */
+void endorse_batch_worker(void* context, size_t index)
+{
+    status retval;
+    vccrypt_buffer_t input_cert;
+    endorse_batch* batch = (endorse_batch*)context;
+    endorse_job* job = &batch->jobs[index];
+
+    /* Verify that the input public key file is valid and read it. */
+    TRY_OR_FAIL(
+        endorse_read_input_certificate(
+            &input_cert, batch->opts, job->input_file),
+        done);
+
+    /* Create the output file. */
+    TRY_OR_FAIL(
+        endorse_build_output_file(
+            job->output_filename, batch->opts, batch->endorser_id,
+            batch->endorser_private_key, batch->set, &input_cert),
+        cleanup_input_cert);
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_input_cert;
+
+cleanup_input_cert:
+    dispose(vccrypt_buffer_disposable_handle(&input_cert));
+
+done:
+    job->result = retval;
+}
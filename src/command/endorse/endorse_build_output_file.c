@@ -4,18 +4,19 @@
  * \brief Build the endorsed output file, given a working set, an input file,
  * and the endorser private certificate.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
+#include <vccert/fields.h>
+
 #include "endorse_internal.h"
 
-RCPR_IMPORT_rbtree;
 RCPR_IMPORT_uuid;
 
 static inline size_t field_size(size_t value_size)
 {
     /* a field has a type and size and a value. */
-    return 2 * sizeof(uint16_t) + value_size;
+    return ENDORSE_FIELD_HEADER_SIZE + value_size;
 }
 
 static inline size_t uuid_field_size()
@@ -23,11 +24,6 @@ static inline size_t uuid_field_size()
     return field_size(sizeof(rcpr_uuid));
 }
 
-static inline size_t signature_field_size(vccrypt_suite_options_t* suite)
-{
-    return field_size(suite->sign_opts.signature_size);
-}
-
 static inline size_t endorse_field_size()
 {
     /* an endorse field has three UUIDs in it. */
@@ -35,14 +31,19 @@ static inline size_t endorse_field_size()
 }
 
 /**
- * \brief Build the output file given the output filename, the key certificate,
+ * \brief Build the output file given the output filename, the endorser details,
  * the working set, and the input file certificate.
  *
- * \param output_filename   The name of the output file.
- * \param opts              The commandline options for this operation.
- * \param key_cert          The endorser's key certificate.
- * \param set               The working set.
- * \param input_cert        The public key input certificate.
+ * The whole certificate is encoded directly into one buffer, sized up front,
+ * and signed in place. The signature is written from its own buffer, so the
+ * certificate is written with a single vectored write.
+ *
+ * \param output_filename       The name of the output file.
+ * \param opts                  The commandline options for this operation.
+ * \param endorser_id           The endorser's id.
+ * \param endorser_private_key  The endorser's private signing key.
+ * \param set                   The working set.
+ * \param input_cert            The public key input certificate.
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
@@ -50,83 +51,96 @@ static inline size_t endorse_field_size()
  */
 status endorse_build_output_file(
     const char* output_filename, commandline_opts* opts,
-    const vccrypt_buffer_t* key_cert, RCPR_SYM(rbtree)* set,
-    const vccrypt_buffer_t* input_cert)
+    const RCPR_SYM(rcpr_uuid)* endorser_id,
+    const vccrypt_buffer_t* endorser_private_key,
+    const endorse_working_set* set, const vccrypt_buffer_t* input_cert)
 {
     status retval;
-    rcpr_uuid endorser_id;
     rcpr_uuid pub_id;
-    vccrypt_buffer_t endorser_private_key;
-    vccert_builder_options_t builder_opts;
-    vccert_builder_context_t builder;
+    vccrypt_buffer_t cert;
+    vccrypt_buffer_t signature;
+    vccrypt_digital_signature_context_t sign;
+    uint8_t* out;
+    size_t signed_size;
+    struct iovec iov[2];
+    size_t wrote_size;
     int fd;
 
-    /* get the endorser id and private signing key. */
-    retval =
-        endorse_get_endorser_details(
-            &endorser_id, &endorser_private_key, opts, key_cert);
-    if (STATUS_SUCCESS != retval)
-    {
-        goto done;
-    }
-
     /* get the number of entries in the working set. */
-    size_t set_entries = rbtree_count(set);
+    size_t set_entries = set->count;
 
     /* get the size of the input certificate. */
     size_t input_cert_size = input_cert->size;
 
-    /* compute the size of the output certificate. */
+    /* compute the size of the output certificate, less the signature value. */
     size_t output_cert_size =
         input_cert_size
       + (set_entries * endorse_field_size())
       + uuid_field_size()
-      + signature_field_size(opts->suite);
+      + field_size(0);
 
-    /* create a builder options instance. */
+    /* create the certificate buffer. */
     retval =
-        vccert_builder_options_init(
-            &builder_opts, opts->suite->alloc_opts, opts->suite);
+        vccrypt_buffer_init(&cert, opts->suite->alloc_opts, output_cert_size);
     if (STATUS_SUCCESS != retval)
     {
-        goto cleanup_private_key;
+        goto done;
     }
 
-    /* create a builder for the output certificate. */
-    retval = vccert_builder_init(&builder_opts, &builder, output_cert_size);
+    /* write the public certificate fields. */
+    out = (uint8_t*)cert.data;
+    retval =
+        endorse_emit_public_certificate_fields(
+            &out, opts, &pub_id, input_cert);
     if (STATUS_SUCCESS != retval)
     {
-        goto cleanup_builder_opts;
+        goto cleanup_cert;
     }
 
-    /* write the public certificate fields to the builder. */
-    retval =
-        endorse_emit_public_certificate_fields(
-            &builder, opts, &pub_id, input_cert);
+    /* write the working set. */
+    endorse_emit_working_set(&out, &pub_id, set);
+
+    /* the signer id is covered by the signature. */
+    out =
+        endorse_emit_field_header(
+            out, VCCERT_FIELD_TYPE_SIGNER_ID, sizeof(*endorser_id));
+    memcpy(out, endorser_id, sizeof(*endorser_id));
+    out += sizeof(*endorser_id);
+    signed_size = out - (uint8_t*)cert.data;
+
+    /* create the signature buffer. */
+    retval = vccrypt_suite_buffer_init_for_signature(opts->suite, &signature);
     if (STATUS_SUCCESS != retval)
     {
-        goto cleanup_builder;
+        goto cleanup_cert;
     }
 
-    /* write the working set to the builder. */
-    retval = endorse_emit_working_set(&builder, &pub_id, set);
+    /* create the signing algorithm instance. */
+    retval = vccrypt_suite_digital_signature_init(opts->suite, &sign);
     if (STATUS_SUCCESS != retval)
     {
-        goto cleanup_builder;
+        goto cleanup_signature;
     }
 
-    /* sign the certificate with the endorser id and private key. */
+    /* sign the certificate in place. */
     retval =
-        vccert_builder_sign(&builder, endorser_id.data, &endorser_private_key);
+        vccrypt_digital_signature_sign(
+            &sign, &signature, endorser_private_key, cert.data, signed_size);
     if (STATUS_SUCCESS != retval)
     {
-        goto cleanup_builder;
+        goto cleanup_sign;
     }
 
-    /* emit the certificate from the builder. */
-    const uint8_t* cert_data;
-    size_t cert_size;
-    cert_data = vccert_builder_emit(&builder, &cert_size);
+    /* the signature field header follows the signed data. */
+    out =
+        endorse_emit_field_header(
+            out, VCCERT_FIELD_TYPE_SIGNATURE, (uint16_t)signature.size);
+
+    /* the certificate is the signed data and header, then the signature. */
+    iov[0].iov_base = cert.data;
+    iov[0].iov_len = out - (uint8_t*)cert.data;
+    iov[1].iov_base = signature.data;
+    iov[1].iov_len = signature.size;
 
     /* open the output file. */
     retval =
@@ -136,20 +150,20 @@ status endorse_build_output_file(
     if (STATUS_SUCCESS != retval)
     {
         fprintf(stderr, "Error opening output file %s.\n", output_filename);
-        goto cleanup_builder;
+        goto cleanup_sign;
     }
 
     /* write this cert to the output file. */
-    size_t wrote_size;
-    retval = file_write(opts->file, fd, cert_data, cert_size, &wrote_size);
+    retval = file_writev(opts->file, fd, iov, 2, &wrote_size);
     if (STATUS_SUCCESS != retval)
     {
         fprintf(stderr, "Error writing to output file.\n");
         goto cleanup_fd;
     }
-    else if (wrote_size != cert_size)
+    else if (wrote_size != iov[0].iov_len + iov[1].iov_len)
     {
         fprintf(stderr, "Error: file truncated.\n");
+        retval = VCTOOL_ERROR_FILE_IO;
         goto cleanup_fd;
     }
 
@@ -160,14 +174,14 @@ status endorse_build_output_file(
 cleanup_fd:
     file_close(opts->file, fd);
 
-cleanup_builder:
-    dispose((disposable_t*)&builder);
+cleanup_sign:
+    dispose((disposable_t*)&sign);
 
-cleanup_builder_opts:
-    dispose((disposable_t*)&builder_opts);
+cleanup_signature:
+    dispose((disposable_t*)&signature);
 
-cleanup_private_key:
-    dispose((disposable_t*)&endorser_private_key);
+cleanup_cert:
+    dispose((disposable_t*)&cert);
 
 done:
     return retval;
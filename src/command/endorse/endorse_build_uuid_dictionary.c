@@ -3,11 +3,14 @@
  *
  * \brief Build a map of key to UUID using the command-line options.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
+#include <stdlib.h>
+
 #include "endorse_internal.h"
 
+RCPR_IMPORT_allocator_as(rcpr);
 RCPR_IMPORT_rbtree;
 RCPR_IMPORT_resource;
 RCPR_IMPORT_uuid;
@@ -15,6 +18,8 @@ RCPR_IMPORT_uuid;
 /**
  * \brief Build a map of key to UUID using the command-line options.
  *
+ * Each distinct pubkey file is read once, and the files are read concurrently.
+ *
  * \param dict              Receive a pointer to the dictionary on success.
  * \param alloc             The allocator to use for this operation.
  * \param opts              The command-line options to use.
@@ -25,91 +30,159 @@ RCPR_IMPORT_uuid;
  *      - a non-zero error code on failure.
  */
 status endorse_build_uuid_dictionary(
-    RCPR_SYM(rbtree)** dict, RCPR_SYM(allocator)* alloc, commandline_opts* opts,
-    const root_command* root)
+    endorse_uuid_dictionary** dict, RCPR_SYM(allocator)* alloc,
+    commandline_opts* opts, const root_command* root)
 {
     status retval, release_retval;
-    rbtree* tmp;
+    endorse_uuid_dictionary* tmp;
     rbtree_node* kvp_nil;
     rbtree_node* kvp_x;
-    root_dict_kvp* kvp_val;
-    rcpr_uuid entity_id;
-    certfile* pubkey_file;
+    size_t kvp_count;
+    size_t i;
+    endorse_pubkey_lookup* lookups = NULL;
+    endorse_pubkey_batch batch;
 
-    /* attempt to create an rbtree instance. */
-    retval =
-        rbtree_create(
-            &tmp, alloc, &endorse_uuid_dictionary_compare,
-            &endorse_uuid_dictionary_key, NULL);
+    /* get the number of keys. */
+    kvp_count = rbtree_count((rbtree*)root->dict);
+
+    /* attempt to create a dictionary sized for these keys. */
+    retval = endorse_uuid_dictionary_create(&tmp, alloc, kvp_count);
     if (STATUS_SUCCESS != retval)
     {
         goto done;
     }
 
+    /* clear the batch. */
+    memset(&batch, 0, sizeof(batch));
+    batch.opts = opts;
+
+    /* there is nothing to read if no keys were specified. */
+    if (0 == kvp_count)
+    {
+        goto success;
+    }
+
+    /* allocate one lookup per key. */
+    retval =
+        rcpr_allocator_allocate(
+            alloc, (void**)&lookups, kvp_count * sizeof(*lookups));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_tmp;
+    }
+
+    /* allocate at most one job per key. */
+    retval =
+        rcpr_allocator_allocate(
+            alloc, (void**)&batch.jobs, kvp_count * sizeof(*batch.jobs));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_lookups;
+    }
+
     /* get the nil node for the root kvp dictionary. */
     kvp_nil = rbtree_nil_node((rbtree*)root->dict);
 
     /* get the root node for the root kvp dictionary. */
     kvp_x = rbtree_root_node((rbtree*)root->dict);
 
-    /* starting at the minimum node, iterate through this dictionary. */
+    /* starting at the minimum node, collect every key. */
     kvp_x = rbtree_minimum_node((rbtree*)root->dict, kvp_x);
     for (
-        ;
-        kvp_nil != kvp_x;
-        kvp_x = rbtree_successor_node((rbtree*)root->dict, kvp_x))
+        i = 0;
+        kvp_nil != kvp_x && i < kvp_count;
+        kvp_x = rbtree_successor_node((rbtree*)root->dict, kvp_x), ++i)
     {
-        /* get the node value. */
-        kvp_val = (root_dict_kvp*)rbtree_node_value((rbtree*)root->dict, kvp_x);
+        lookups[i].kvp =
+            (const root_dict_kvp*)rbtree_node_value(
+                (rbtree*)root->dict, kvp_x);
+    }
 
-        /* get the public key file. */
-        retval =
-            endorse_get_pubkey_file(&pubkey_file, opts, root->alloc,
-            kvp_val->value);
-        if (STATUS_SUCCESS != retval)
+    /* group the keys by pubkey filename. */
+    qsort(
+        lookups, kvp_count, sizeof(*lookups), &endorse_pubkey_lookup_compare);
+
+    /* create one job for each distinct pubkey filename. */
+    for (i = 0; i < kvp_count; ++i)
+    {
+        if (0 == i || 0 != endorse_pubkey_lookup_compare(
+                                &lookups[i - 1], &lookups[i]))
         {
-            goto cleanup_tmp;
+            memset(&batch.jobs[batch.job_count], 0, sizeof(*batch.jobs));
+            batch.jobs[batch.job_count].filename = lookups[i].kvp->value;
+            ++batch.job_count;
         }
 
-        /* get the entity id from this file. */
-        retval =
-            endorse_get_pubkey_id(
-                &entity_id, pubkey_file, opts, root->alloc, root);
-        if (STATUS_SUCCESS != retval)
+        lookups[i].job = batch.job_count - 1;
+    }
+
+    /* read the entity id from each pubkey file on the worker pool. */
+    retval =
+        parallel_for(batch.job_count, &endorse_pubkey_batch_worker, &batch);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_jobs;
+    }
+
+    /* fail if any pubkey file could not be read. */
+    for (i = 0; i < batch.job_count; ++i)
+    {
+        if (STATUS_SUCCESS != batch.jobs[i].result)
         {
-            goto cleanup_pubkey_file;
+            retval = batch.jobs[i].result;
+            goto cleanup_jobs;
         }
+    }
 
-        /* add a dict entry to our dictionary. */
+    /* add a dict entry for each key. */
+    for (i = 0; i < kvp_count; ++i)
+    {
         retval =
-            endorse_uuid_dictionary_add(tmp, alloc, kvp_val->key, &entity_id);
+            endorse_uuid_dictionary_add(
+                tmp, lookups[i].kvp->key,
+                &batch.jobs[lookups[i].job].entity_id);
         if (STATUS_SUCCESS != retval)
         {
-            goto cleanup_pubkey_file;
+            goto cleanup_jobs;
         }
+    }
 
-        /* clean up pubkey file. */
-        retval = resource_release(&pubkey_file->hdr);
-        if (STATUS_SUCCESS != retval)
-        {
-            goto cleanup_tmp;
-        }
+    /* clean up jobs. */
+    retval = rcpr_allocator_reclaim(alloc, batch.jobs);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_lookups;
+    }
+
+    /* clean up lookups. */
+    retval = rcpr_allocator_reclaim(alloc, lookups);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_tmp;
     }
 
+success:
     /* success. The caller now owns the dict. */
     *dict = tmp;
     retval = STATUS_SUCCESS;
     goto done;
 
-cleanup_pubkey_file:
-    release_retval = resource_release(&pubkey_file->hdr);
+cleanup_jobs:
+    release_retval = rcpr_allocator_reclaim(alloc, batch.jobs);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_lookups:
+    release_retval = rcpr_allocator_reclaim(alloc, lookups);
     if (STATUS_SUCCESS != release_retval)
     {
         retval = release_retval;
     }
 
 cleanup_tmp:
-    release_retval = resource_release(rbtree_resource_handle(tmp));
+    release_retval = resource_release(&tmp->hdr);
     if (STATUS_SUCCESS != release_retval)
     {
         retval = release_retval;
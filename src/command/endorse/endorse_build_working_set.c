@@ -1,25 +1,26 @@
 /**
  * \file command/endorse/endorse_build_working_set.c
  *
- * \brief Build a working set of capabilities from the uuid dictionary, ast, and
- * command-line.
+ * \brief Build a working set of capabilities from the uuid dictionary, compiled
+ * config, and command-line.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include "endorse_internal.h"
 
-RCPR_IMPORT_rbtree;
+RCPR_IMPORT_uuid;
 RCPR_IMPORT_resource;
 RCPR_IMPORT_slist;
 
 /**
- * \brief Build a working set of capabilities using the AST and uuid dictionary.
+ * \brief Build a working set of capabilities using the compiled config and
+ * uuid dictionary.
  *
  * \param set               Receive a pointer to the working set on success.
  * \param alloc             The allocator to use for this operation.
  * \param root              The root command config.
- * \param ast               The ast to use for this operation.
+ * \param compiled          The compiled config to use for this operation.
  * \param dict              The uuid dictionary to use for this operation.
  *
  * \returns a status code indicating success or failure.
@@ -27,32 +28,37 @@ RCPR_IMPORT_slist;
  *      - a non-zero error code on failure.
  */
 status endorse_build_working_set(
-    RCPR_SYM(rbtree)** set, RCPR_SYM(allocator)* alloc,
-    const root_command* root, const endorse_config* ast,
-    RCPR_SYM(rbtree)* dict)
+    endorse_working_set** set, RCPR_SYM(allocator)* alloc,
+    const root_command* root, const endorse_compiled* compiled,
+    const endorse_uuid_dictionary* dict)
 {
     status retval, release_retval;
-    rbtree* tmp;
+    endorse_working_set* tmp;
+    endorse_grant_table* grants;
     slist_node* x;
     root_permission* perm;
-    endorse_uuid_dictionary_entry* uuid_entry;
-    endorse_entity* entity;
-
-    /* attempt to create an rbtree instance. */
-    retval =
-        rbtree_create(
-            &tmp, alloc, &endorse_working_set_compare,
-            &endorse_working_set_get_key, NULL);
+    const rcpr_uuid* entity_id;
+    const endorse_compiled_entity* entity;
+
+    /* attempt to create an empty working set. */
+    retval = endorse_working_set_create(&tmp, alloc);
     if (STATUS_SUCCESS != retval)
     {
         goto done;
     }
 
+    /* attempt to create an empty grant table. */
+    retval = endorse_grant_table_create(&grants, alloc, compiled);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_working_set;
+    }
+
     /* get the first node for the permission list. */
     retval = slist_head(&x, root->permissions);
     if (STATUS_SUCCESS != retval)
     {
-        goto cleanup_working_set;
+        goto cleanup_grants;
     }
 
     /* are there any entries? */
@@ -68,52 +74,80 @@ status endorse_build_working_set(
         retval = slist_node_child((resource**)&perm, x);
         if (STATUS_SUCCESS != retval)
         {
-            goto cleanup_working_set;
+            goto cleanup_grants;
         }
 
         /* attempt to look up the entity in the uuid dictionary. */
-        retval = rbtree_find((resource**)&uuid_entry, dict, perm->entity);
-        if (STATUS_SUCCESS != retval)
+        entity_id = endorse_uuid_dictionary_find(dict, perm->entity);
+        if (NULL == entity_id)
         {
             fprintf(stderr, "UUID for %s was not specified.\n", perm->entity);
-            goto cleanup_working_set;
+            retval = VCTOOL_ERROR_ENDORSE_MISSING_UUID;
+            goto cleanup_grants;
         }
 
-        /* attempt to look up the entity in the ast. */
-        retval = rbtree_find((resource**)&entity, ast->entities, perm->entity);
-        if (STATUS_SUCCESS != retval)
+        /* attempt to look up the entity in the compiled config. */
+        entity = endorse_compiled_find_entity(compiled, perm->entity);
+        if (NULL == entity)
         {
             fprintf(
                 stderr, "Entity %s is not defined in endorse config.\n",
                 perm->entity);
-            goto cleanup_working_set;
+            retval = VCTOOL_ERROR_ENDORSE_UNKNOWN_ROLE_OR_VERB;
+            goto cleanup_grants;
         }
 
         /* Given the entity, entity UUID, and moiety: */
-        /* populate the working set with all capability UUIDs. */
+        /* grant the verbs of this moiety to the entity. */
         retval =
-            endorse_working_set_add_capabilities(
-                tmp, alloc, entity, &uuid_entry->value, perm->moiety);
+            endorse_grant_table_add(grants, entity, entity_id, perm->moiety);
         if (STATUS_SUCCESS != retval)
         {
-            goto cleanup_working_set;
+            goto cleanup_grants;
         }
 
         /* get the next node. */
         retval = slist_node_next(&x, x);
         if (STATUS_SUCCESS != retval)
         {
-            goto cleanup_working_set;
+            goto cleanup_grants;
         }
     }
 
-    /* success. The caller now owns the working set. */
-    *set = tmp;
+    /* populate the working set with each granted capability exactly once. */
+    retval = endorse_working_set_add_capabilities(tmp, grants);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_grants;
+    }
+
+    /* sort the working set and remove duplicates. */
+    retval = endorse_working_set_finalize(tmp);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_grants;
+    }
+
+    /* success. */
     retval = STATUS_SUCCESS;
-    goto done;
+    goto cleanup_grants;
+
+cleanup_grants:
+    release_retval = resource_release(&grants->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
 
 cleanup_working_set:
-    release_retval = resource_release(rbtree_resource_handle(tmp));
+    /* on success, the caller owns the working set. */
+    if (STATUS_SUCCESS == retval)
+    {
+        *set = tmp;
+        goto done;
+    }
+
+    release_retval = resource_release(&tmp->hdr);
     if (STATUS_SUCCESS != release_retval)
     {
         retval = release_retval;
@@ -0,0 +1,189 @@
+/**
+ * \file command/endorse/endorse_check_command_func.c
+ *
+ * \brief Entry point for the endorse-check command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <time.h>
+#include <vctool/command/endorse_check.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_resource;
+
+/* forward decls. */
+static size_t endorse_check_print_errors(const endorse_check_job* job);
+
+/**
+ * \brief Execute the endorse-check command.
+ *
+ * Each endorse config file is parsed and analyzed on its own, in parallel, and
+ * every error is reported. No keys, certificates, or output files are used.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_INVALID_CONFIG if any config has errors.
+ *      - a non-zero error code on failure.
+ */
+int endorse_check_command_func(commandline_opts* opts)
+{
+    status retval, release_retval;
+    endorse_config_source* sources;
+    size_t source_count;
+    endorse_check_job* jobs;
+    struct timespec start, end;
+    size_t invalid_count = 0;
+    size_t error_count;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* get endorse-check and root command. */
+    endorse_check_command* check = (endorse_check_command*)opts->cmd;
+    MODEL_ASSERT(NULL != check);
+    root_command* root = (root_command*)check->hdr.next;
+    MODEL_ASSERT(NULL != root);
+
+    /* map every endorse config file. */
+    TRY_OR_FAIL(
+        endorse_map_endorse_config_files(
+            &sources, &source_count, opts->file, root),
+        done);
+
+    /* allocate a check job for each file. */
+    jobs = (endorse_check_job*)calloc(source_count, sizeof(endorse_check_job));
+    if (NULL == jobs)
+    {
+        fprintf(stderr, "Out of memory.\n");
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_sources;
+    }
+
+    for (size_t i = 0; i < source_count; ++i)
+    {
+        jobs[i].source = &sources[i];
+        jobs[i].alloc = root->alloc;
+    }
+
+    /* check every file. */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    TRY_OR_FAIL(
+        parallel_for(source_count, &endorse_check_worker, jobs),
+        cleanup_contexts);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    /* report each file in command line order. */
+    for (size_t i = 0; i < source_count; ++i)
+    {
+        error_count = endorse_check_print_errors(&jobs[i]);
+        if (STATUS_SUCCESS == jobs[i].result && 0 == error_count)
+        {
+            printf(
+                "%s: OK (parse %.3f ms, analyze %.3f ms).\n",
+                sources[i].filename, jobs[i].parse_ns / 1000000.0,
+                jobs[i].analyze_ns / 1000000.0);
+        }
+        else
+        {
+            printf(
+                "%s: %zu error(s) (parse %.3f ms, analyze %.3f ms).\n",
+                sources[i].filename, error_count,
+                jobs[i].parse_ns / 1000000.0,
+                jobs[i].analyze_ns / 1000000.0);
+            ++invalid_count;
+        }
+    }
+
+    printf(
+        "Checked %zu endorse config(s) in %.3f ms; %zu with errors.\n",
+        source_count,
+        (end.tv_sec - start.tv_sec) * 1000.0
+      + (end.tv_nsec - start.tv_nsec) / 1000000.0,
+        invalid_count);
+
+    /* fail if any config has errors. */
+    if (invalid_count > 0)
+    {
+        retval = VCTOOL_ERROR_ENDORSE_INVALID_CONFIG;
+        goto cleanup_contexts;
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_contexts;
+
+cleanup_contexts:
+    for (size_t i = 0; i < source_count; ++i)
+    {
+        if (NULL != jobs[i].context)
+        {
+            CLEANUP_OR_CASCADE(&jobs[i].context->hdr);
+        }
+    }
+
+    free(jobs);
+
+cleanup_sources:
+    endorse_unmap_endorse_config_files(opts->file, sources, source_count);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Print every error recorded while checking an endorse config file.
+ *
+ * \param job               The check job.
+ *
+ * \returns the number of errors found.
+ */
+static size_t endorse_check_print_errors(const endorse_check_job* job)
+{
+    const char* msg;
+    size_t count, length;
+
+    /* the context could not be created. */
+    if (NULL == job->context)
+    {
+        fprintf(
+            stderr, "%s: Error creating endorse config context.\n",
+            job->source->filename);
+        return 1;
+    }
+
+    count = endorse_config_default_context_get_error_message_count(
+        job->context);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (STATUS_SUCCESS !=
+                endorse_config_default_context_get_error_message(
+                    &msg, job->context, (int)i))
+        {
+            break;
+        }
+
+        /* analysis errors end in a newline; parse errors do not. */
+        length = strlen(msg);
+        if (length > 0 && '\n' == msg[length - 1])
+        {
+            --length;
+        }
+
+        fprintf(stderr, "%s: %.*s\n", job->source->filename, (int)length, msg);
+    }
+
+    /* a failure without a message still counts as an error. */
+    if (0 == count && STATUS_SUCCESS != job->result)
+    {
+        fprintf(
+            stderr, "%s: Error checking endorse config.\n",
+            job->source->filename);
+        return 1;
+    }
+
+    return count;
+}
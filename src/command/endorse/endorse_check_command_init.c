@@ -0,0 +1,52 @@
+/**
+ * \file command/endorse/endorse_check_command_init.c
+ *
+ * \brief Initialize an endorse-check command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/endorse_check.h>
+#include <vctool/command/root.h>
+#include <vctool/status_codes.h>
+#include <vpr/parameters.h>
+
+/* forward decls. */
+static void endorse_check_command_dispose(void* disp);
+
+/**
+ * \brief Initialize an endorse-check command structure.
+ *
+ * \param check         The endorse-check command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int endorse_check_command_init(endorse_check_command* check)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != check);
+
+    /* clear endorse-check command structure. */
+    memset(check, 0, sizeof(endorse_check_command));
+
+    /* set disposer, func, etc. */
+    check->hdr.hdr.dispose = &endorse_check_command_dispose;
+    check->hdr.func = &endorse_check_command_func;
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Dispose of an endorse_check_command structure.
+ *
+ * \param disp          The endorse_check_command structure to dispose.
+ */
+static void endorse_check_command_dispose(void* UNUSED(disp))
+{
+    /* do nothing. */
+}
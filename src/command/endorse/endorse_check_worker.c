@@ -0,0 +1,82 @@
+/**
+ * \file command/endorse/endorse_check_worker.c
+ *
+ * \brief Worker function to check a single endorse config file.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <time.h>
+
+#include "endorse_internal.h"
+
+/* forward decls. */
+static uint64_t endorse_check_elapsed_ns(
+    const struct timespec* start, const struct timespec* end);
+
+/**
+ * \brief Worker function; parses and analyzes a single endorse config file.
+ *
+ * Each job gets its own parser context, so the check of one file shares no
+ * mutable state with any other. Errors are left in the context, so that they
+ * can all be reported.
+ *
+ * \param context           The array of check jobs.
+ * \param index             The index of the job to process.
+ */
+void endorse_check_worker(void* context, size_t index)
+{
+    endorse_check_job* job = ((endorse_check_job*)context) + index;
+    struct timespec start, parsed, analyzed;
+    endorse_config* root;
+
+    /* create the endorse config context. */
+    job->result = endorse_config_create_default(&job->context, job->alloc);
+    if (STATUS_SUCCESS != job->result)
+    {
+        job->context = NULL;
+        return;
+    }
+
+    /* parse the endorse config directly from its source. */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    job->result =
+        endorse_parse_mapped(
+            job->context, job->source->data, job->source->size);
+    clock_gettime(CLOCK_MONOTONIC, &parsed);
+    job->parse_ns = endorse_check_elapsed_ns(&start, &parsed);
+    if (STATUS_SUCCESS != job->result)
+    {
+        return;
+    }
+
+    /* a config with syntax errors has no AST to analyze. */
+    root =
+        (endorse_config*)
+        endorse_config_default_context_get_endorse_config_root(job->context);
+    if (NULL == root)
+    {
+        return;
+    }
+
+    /* perform semantic analysis on the config. */
+    job->result = endorse_analyze(job->context, root);
+    clock_gettime(CLOCK_MONOTONIC, &analyzed);
+    job->analyze_ns = endorse_check_elapsed_ns(&parsed, &analyzed);
+}
+
+/**
+ * \brief Get the time between two monotonic clock readings.
+ *
+ * \param start             The earlier reading.
+ * \param end               The later reading.
+ *
+ * \returns the elapsed time in nanoseconds.
+ */
+static uint64_t endorse_check_elapsed_ns(
+    const struct timespec* start, const struct timespec* end)
+{
+    return
+        (uint64_t)(end->tv_sec - start->tv_sec) * 1000000000U
+      + (uint64_t)end->tv_nsec - (uint64_t)start->tv_nsec;
+}
@@ -3,7 +3,7 @@
  *
  * \brief Entry point for the endorse command.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include <vctool/endorse.h>
@@ -11,12 +11,17 @@
 #include "endorse_internal.h"
 
 RCPR_IMPORT_allocator_as(rcpr);
-RCPR_IMPORT_rbtree;
 RCPR_IMPORT_resource;
+RCPR_IMPORT_uuid;
 
 /**
  * \brief Execute the endorse command.
  *
+ * The endorse config is loaded from its compiled cache or compiled, the
+ * endorser key is decrypted, and the working set is built exactly once. Every
+ * input certificate is then endorsed in parallel using this shared, read-only
+ * state.
+ *
  * \param opts          The commandline opts for this operation.
  *
  * \returns a status code indicating success or failure.
@@ -27,16 +32,17 @@ int endorse_command_func(commandline_opts* opts)
 {
     status retval, release_retval;
     certfile* key_file;
-    certfile* input_file;
-    certfile* endorse_config_file;
-    char* output_filename;
+    endorse_job* jobs;
+    size_t job_count;
     vccrypt_buffer_t key_cert;
-    vccrypt_buffer_t input_cert;
-    vccrypt_buffer_t endorse_cfg;
-    endorse_config_context* endorse_ctx;
-    const endorse_config* ast;
-    rbtree* dict;
-    rbtree* set;
+    rcpr_uuid endorser_id;
+    vccrypt_buffer_t endorser_private_key;
+    endorse_config_source* sources;
+    size_t source_count;
+    endorse_compiled* compiled;
+    endorse_uuid_dictionary* dict;
+    endorse_working_set* set;
+    endorse_batch batch;
 
     /* parameter sanity checks. */
     MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
@@ -50,104 +56,82 @@ int endorse_command_func(commandline_opts* opts)
     /* get the key filename. */
     TRY_OR_FAIL(endorse_get_key_file(&key_file, opts, root->alloc, root), done);
 
-    /* get the input filename. */
+    /* get the input files and their output filenames. */
     TRY_OR_FAIL(
-        endorse_get_input_file(
-            &input_file, opts, root->alloc, root),
+        endorse_get_jobs(
+            &jobs, &job_count, opts, root->alloc, root, endorse),
         cleanup_key_file);
 
-    /* get the endorse config filename. */
-    TRY_OR_FAIL(
-        endorse_get_endorse_config_file(
-            &endorse_config_file, opts, root->alloc, root),
-        cleanup_input_file);
-
-    /* get the output filename. */
+    /* map every endorse config file. */
     TRY_OR_FAIL(
-        endorse_get_output_filename(
-            &output_filename, opts, input_file->filename, root),
-        cleanup_endorse_config_file);
+        endorse_map_endorse_config_files(
+            &sources, &source_count, opts->file, root),
+        cleanup_jobs);
 
     /* Verify that the endorser private key is valid and read it. */
     TRY_OR_FAIL(
         endorse_read_key_certificate(&key_cert, opts, key_file),
-        cleanup_output_filename);
+        cleanup_sources);
 
-    /* Verify that the input public key file is valid and read it. */
+    /* get the endorser id and private signing key. */
     TRY_OR_FAIL(
-        endorse_read_input_certificate(&input_cert, opts, input_file),
+        endorse_get_endorser_details(
+            &endorser_id, &endorser_private_key, opts, &key_cert),
         cleanup_key_cert);
 
-    /* create the endorse config context. */
-    TRY_OR_FAIL(
-        endorse_config_create_default(&endorse_ctx, root->alloc),
-        cleanup_input_cert);
-
-    /* Read the endorse config file. */
-    TRY_OR_FAIL(
-        endorse_read_endorse_config_file(
-            &endorse_cfg, opts, endorse_config_file),
-        cleanup_endorse_ctx);
-
-    /* parse the endorse config file. */
+    /* get the compiled endorse config. */
     TRY_OR_FAIL(
-        endorse_parse(endorse_ctx, &endorse_cfg),
-        cleanup_endorse_cfg);
-
-    /* get the root config. */
-    ast = endorse_config_default_context_get_endorse_config_root(endorse_ctx);
-
-    /* perform semantic analysis on the endorse config. */
-    TRY_OR_FAIL(
-        endorse_analyze(endorse_ctx, (endorse_config*)ast),
-        cleanup_endorse_cfg);
+        endorse_get_compiled_config(
+            &compiled, root->alloc, opts, root, sources, source_count),
+        cleanup_endorser_private_key);
 
     /* build a dictionary of dictionary key to entity UUID data. */
     TRY_OR_FAIL(
         endorse_build_uuid_dictionary(&dict, root->alloc, opts, root),
-        cleanup_endorse_cfg);
+        cleanup_compiled);
 
     /* build the working set. */
     TRY_OR_FAIL(
-        endorse_build_working_set(&set, root->alloc, root, ast, dict),
+        endorse_build_working_set(&set, root->alloc, root, compiled, dict),
         cleanup_dict);
 
-    /* Create the output file. */
-    TRY_OR_FAIL(
-        endorse_build_output_file(
-            output_filename, opts, &key_cert, set, &input_cert),
-        cleanup_set);
+    /* endorse every input certificate using this shared state. */
+    batch.opts = opts;
+    batch.endorser_id = &endorser_id;
+    batch.endorser_private_key = &endorser_private_key;
+    batch.set = set;
+    batch.jobs = jobs;
+    batch.job_count = job_count;
+    TRY_OR_FAIL(endorse_batch_run(&batch), cleanup_set);
 
     /* success. */
     retval = STATUS_SUCCESS;
     goto cleanup_set;
 
 cleanup_set:
-    CLEANUP_OR_CASCADE(rbtree_resource_handle(set));
+    CLEANUP_OR_CASCADE(&set->hdr);
 
 cleanup_dict:
-    CLEANUP_OR_CASCADE(rbtree_resource_handle(dict));
-
-cleanup_endorse_cfg:
-    dispose(vccrypt_buffer_disposable_handle(&endorse_cfg));
+    CLEANUP_OR_CASCADE(&dict->hdr);
 
-cleanup_endorse_ctx:
-    CLEANUP_OR_CASCADE(&endorse_ctx->hdr);
+cleanup_compiled:
+    CLEANUP_OR_CASCADE(&compiled->hdr);
 
-cleanup_input_cert:
-    dispose(vccrypt_buffer_disposable_handle(&input_cert));
+cleanup_endorser_private_key:
+    dispose(vccrypt_buffer_disposable_handle(&endorser_private_key));
 
 cleanup_key_cert:
     dispose(vccrypt_buffer_disposable_handle(&key_cert));
 
-cleanup_output_filename:
-    free(output_filename);
-
-cleanup_endorse_config_file:
-    CLEANUP_OR_CASCADE(&endorse_config_file->hdr);
+cleanup_sources:
+    endorse_unmap_endorse_config_files(opts->file, sources, source_count);
 
-cleanup_input_file:
-    CLEANUP_OR_CASCADE(&input_file->hdr);
+cleanup_jobs:
+    release_retval = endorse_jobs_release(jobs, job_count);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
 
 cleanup_key_file:
     CLEANUP_OR_CASCADE(&key_file->hdr);
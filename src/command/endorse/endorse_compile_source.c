@@ -0,0 +1,208 @@
+/**
+ * \file command/endorse/endorse_compile_source.c
+ *
+ * \brief Parse, merge, analyze, and compile the endorse config sources.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Parse, merge, analyze, and compile the endorse config sources.
+ *
+ * Each source is parsed into its own context in parallel. Every other config
+ * is then merged into the config of the first source, which is analyzed and
+ * compiled.
+ *
+ * \param compiled              Receive a pointer to the compiled config on
+ *                              success.
+ * \param alloc                 The allocator for the compiled config.
+ * \param bytes_per_source_byte If non-zero, each source is parsed in its own
+ *                              endorse arena of this many bytes per byte of
+ *                              source, which frees the parser context and AST
+ *                              at once. Otherwise, \p alloc is used.
+ * \param sources               The endorse config sources.
+ * \param count                 The number of sources.
+ * \param digest                The SHA-512 digest of the sources, recorded in
+ *                              the compiled config.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_ARENA_EXHAUSTED if an arena was too small.
+ *      - a non-zero error code on failure.
+ */
+status endorse_compile_source(
+    endorse_compiled** compiled, RCPR_SYM(allocator)* alloc,
+    size_t bytes_per_source_byte, const endorse_config_source* sources,
+    size_t count,
+    const uint8_t* digest)
+{
+    status retval, release_retval;
+    endorse_parse_job* jobs;
+    size_t total_size = 0;
+    size_t arena_count = 0;
+    bool in_arena = (0 != bytes_per_source_byte);
+    bool have_compiled = false;
+    endorse_config* ast;
+
+    /* allocate a parse job for each source. */
+    jobs = (endorse_parse_job*)calloc(count, sizeof(endorse_parse_job));
+    if (NULL == jobs)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* the first arena also holds everything merged into its config. */
+    for (size_t i = 0; i < count; ++i)
+    {
+        total_size += sources[i].size;
+    }
+
+    /* the arena is not thread safe, so each parse gets its own. */
+    for (size_t i = 0; i < count; ++i)
+    {
+        jobs[i].source = &sources[i];
+
+        if (in_arena)
+        {
+            TRY_OR_FAIL(
+                endorse_arena_create(
+                    &jobs[i].alloc, alloc,
+                    (0 == i) ? total_size : sources[i].size,
+                    bytes_per_source_byte),
+                cleanup_arenas);
+            ++arena_count;
+        }
+        else
+        {
+            jobs[i].alloc = alloc;
+        }
+    }
+
+    /* parse every source. */
+    TRY_OR_FAIL(
+        parallel_for(count, &endorse_parse_worker, jobs), cleanup_contexts);
+
+    /* check each parse. An exhausted arena is retried, so stay quiet. */
+    retval = STATUS_SUCCESS;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (in_arena
+         && endorse_parse_job_out_of_memory(&jobs[i], jobs[i].result))
+        {
+            retval = VCTOOL_ERROR_ENDORSE_ARENA_EXHAUSTED;
+        }
+        else if (NULL == jobs[i].context || jobs[i].context->out_of_memory)
+        {
+            fprintf(stderr, "Out of memory.\n");
+            retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        }
+        else if (STATUS_SUCCESS != jobs[i].result)
+        {
+            fprintf(
+                stderr, "Error parsing endorse config %s.\n",
+                sources[i].filename);
+            retval = jobs[i].result;
+        }
+    }
+
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_contexts;
+    }
+
+    /* get the root config. */
+    ast =
+        (endorse_config*)
+        endorse_config_default_context_get_endorse_config_root(
+            jobs[0].context);
+
+    /* merge every other config into the root config. */
+    for (size_t i = 1; i < count; ++i)
+    {
+        retval =
+            endorse_merge(
+                jobs[0].context, ast,
+                (endorse_config*)
+                endorse_config_default_context_get_endorse_config_root(
+                    jobs[i].context));
+        if (STATUS_SUCCESS != retval)
+        {
+            if (in_arena && endorse_parse_job_out_of_memory(&jobs[0], retval))
+            {
+                retval = VCTOOL_ERROR_ENDORSE_ARENA_EXHAUSTED;
+            }
+            else
+            {
+                fprintf(
+                    stderr, "Error merging endorse config %s.\n",
+                    sources[i].filename);
+            }
+
+            goto cleanup_contexts;
+        }
+    }
+
+    /* perform semantic analysis on the merged config. */
+    retval = endorse_analyze(jobs[0].context, ast);
+    if (STATUS_SUCCESS != retval)
+    {
+        if (in_arena && endorse_parse_job_out_of_memory(&jobs[0], retval))
+        {
+            retval = VCTOOL_ERROR_ENDORSE_ARENA_EXHAUSTED;
+        }
+
+        goto cleanup_contexts;
+    }
+
+    /* compile the analyzed config. */
+    TRY_OR_FAIL(
+        endorse_compile(compiled, alloc, ast, digest),
+        cleanup_contexts);
+    have_compiled = true;
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_contexts;
+
+cleanup_contexts:
+    /* an arena frees the context and AST all at once. */
+    if (!in_arena)
+    {
+        /* the root context goes first; it holds entities from the others. */
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (NULL != jobs[i].context)
+            {
+                CLEANUP_OR_CASCADE(&jobs[i].context->hdr);
+            }
+        }
+    }
+
+cleanup_arenas:
+    for (size_t i = 0; i < arena_count; ++i)
+    {
+        release_retval =
+            resource_release(rcpr_allocator_resource_handle(jobs[i].alloc));
+        if (STATUS_SUCCESS != release_retval)
+        {
+            retval = release_retval;
+        }
+    }
+
+    /* don't return a compiled config if cleanup failed. */
+    if (have_compiled && STATUS_SUCCESS != retval)
+    {
+        resource_release(&(*compiled)->hdr);
+    }
+
+    free(jobs);
+
+done:
+    return retval;
+}
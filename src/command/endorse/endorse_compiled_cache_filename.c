@@ -0,0 +1,43 @@
+/**
+ * \file command/endorse/endorse_compiled_cache_filename.c
+ *
+ * \brief Build the compiled cache filename for an endorse config file.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Build the compiled cache filename for an endorse config file.
+ *
+ * \param cache_filename    Pointer to receive the cache filename, which the
+ *                          caller must free.
+ * \param filename          The endorse config filename.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_compiled_cache_filename(
+    char** cache_filename, const char* filename)
+{
+    /* compute the cache filename length. */
+    size_t cache_filename_length =
+        strlen(filename)
+      + 9 /* .compiled */
+      + 1;/* asciiz */
+
+    /* allocate memory for the cache filename. */
+    *cache_filename = (char*)malloc(cache_filename_length);
+    if (NULL == *cache_filename)
+    {
+        fprintf(stderr, "Out of memory.\n");
+        return VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* create the cache filename. */
+    snprintf(*cache_filename, cache_filename_length, "%s.compiled", filename);
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,104 @@
+/**
+ * \file command/endorse/endorse_config_digest.c
+ *
+ * \brief Compute the digest of a set of endorse config sources.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <vcblockchain/byteswap.h>
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Compute the digest of a set of endorse config sources.
+ *
+ * The digest is the SHA-512 digest of the size and contents of each source, in
+ * order. It is recorded in the compiled config in place of the sources
+ * themselves.
+ *
+ * \param digest            The digest, which must hold
+ *                          \ref ENDORSE_COMPILED_DIGEST_SIZE bytes.
+ * \param suite             The crypto suite to use for this operation.
+ * \param sources           The array of sources.
+ * \param count             The number of sources.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_COMPILED_INVALID if the suite digest is not
+ *        SHA-512.
+ *      - a non-zero error code on failure.
+ */
+status endorse_config_digest(
+    uint8_t* digest, vccrypt_suite_options_t* suite,
+    const endorse_config_source* sources, size_t count)
+{
+    status retval;
+    vccrypt_hash_context_t hash;
+    vccrypt_buffer_t hash_buffer;
+    uint64_t net_size;
+
+    /* create the hash buffer. */
+    retval = vccrypt_suite_buffer_init_for_hash(suite, &hash_buffer);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* create the hash instance. */
+    retval = vccrypt_suite_hash_init(suite, &hash);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_hash_buffer;
+    }
+
+    /* the size of each source keeps the boundaries between them. */
+    for (size_t i = 0; i < count; ++i)
+    {
+        net_size = htonll((uint64_t)sources[i].size);
+        retval =
+            vccrypt_hash_digest(
+                &hash, (const uint8_t*)&net_size, sizeof(net_size));
+        if (VCCRYPT_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_hash;
+        }
+
+        retval =
+            vccrypt_hash_digest(
+                &hash, (const uint8_t*)sources[i].data, sources[i].size);
+        if (VCCRYPT_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_hash;
+        }
+    }
+
+    /* finalize the hash. */
+    retval = vccrypt_hash_finalize(&hash, &hash_buffer);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_hash;
+    }
+
+    /* the compiled config records a SHA-512 digest. */
+    if (ENDORSE_COMPILED_DIGEST_SIZE != hash_buffer.size)
+    {
+        retval = VCTOOL_ERROR_ENDORSE_COMPILED_INVALID;
+        goto cleanup_hash;
+    }
+
+    memcpy(digest, hash_buffer.data, ENDORSE_COMPILED_DIGEST_SIZE);
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_hash;
+
+cleanup_hash:
+    dispose((disposable_t*)&hash);
+
+cleanup_hash_buffer:
+    dispose(vccrypt_buffer_disposable_handle(&hash_buffer));
+
+done:
+    return retval;
+}
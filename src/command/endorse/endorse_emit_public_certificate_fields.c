@@ -1,9 +1,9 @@
 /**
- * \file command/endorse/endorse_get_endorser_details.c
+ * \file command/endorse/endorse_emit_public_certificate_fields.c
  *
- * \brief Get the endorser id and private signing key.
+ * \brief Write the public certificate fields to the output buffer.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include <vccert/fields.h>
@@ -12,9 +12,14 @@
 #include "endorse_internal.h"
 
 /**
- * \brief Write the public certificate fields to the builder.
+ * \brief Write the public certificate fields to the output buffer.
  *
- * \param builder           The builder to which the fields are written.
+ * Each field is encoded exactly as it appears in the public certificate, so
+ * the fields take at most public_cert->size bytes.
+ *
+ * \param out               Pointer to the output position, which is advanced
+ *                          past the fields. At least public_cert->size bytes
+ *                          must be available.
  * \param opts              The command-line options for this operation.
  * \param pub_id            Pointer to UUID buffer to receive the public entity
  *                          id of this entity.
@@ -25,8 +30,8 @@
  *      - a non-zero error code on failure.
  */
 status endorse_emit_public_certificate_fields(
-    vccert_builder_context_t* builder, commandline_opts* opts,
-    RCPR_SYM(rcpr_uuid)* pub_id, const vccrypt_buffer_t* public_cert)
+    uint8_t** out, commandline_opts* opts, RCPR_SYM(rcpr_uuid)* pub_id,
+    const vccrypt_buffer_t* public_cert)
 {
     status retval;
     vccert_parser_options_t parser_options;
@@ -63,13 +68,10 @@ status endorse_emit_public_certificate_fields(
     /* loop through all fields. */
     while (STATUS_SUCCESS == retval)
     {
-        /* write the field to the builder. */
-        retval =
-            vccert_builder_add_short_buffer(builder, field_id, value, size);
-        if (STATUS_SUCCESS != retval)
-        {
-            goto cleanup_parser;
-        }
+        /* write the field to the output buffer. */
+        *out = endorse_emit_field_header(*out, field_id, (uint16_t)size);
+        memcpy(*out, value, size);
+        *out += size;
 
         /* if this field is the entity id, copy it to the pub id. */
         if (VCCERT_FIELD_TYPE_ARTIFACT_ID == field_id)
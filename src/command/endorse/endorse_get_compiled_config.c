@@ -0,0 +1,122 @@
+/**
+ * \file command/endorse/endorse_get_compiled_config.c
+ *
+ * \brief Get the compiled endorse config from the cache or the config sources.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Get the compiled endorse config, either by mapping a valid cache file
+ * or by parsing, analyzing, and compiling the config sources.
+ *
+ * The cache file is named after the first config source, and is only valid
+ * for the exact same sequence of sources. When the config sources are
+ * compiled, the compiled image is written to the cache file for later runs.
+ * Failure to write the cache is not an error. The sources are first compiled
+ * in small arenas, which are doubled in size each time one is exhausted. Only
+ * if the largest arenas are exhausted are they compiled again with \p alloc.
+ *
+ * \param compiled              Receive a pointer to the compiled config on
+ *                              success.
+ * \param alloc                 The allocator to use for this operation.
+ * \param opts                  The command-line options to use.
+ * \param root                  The root command config.
+ * \param sources               The endorse config sources.
+ * \param count                 The number of sources.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_get_compiled_config(
+    endorse_compiled** compiled, RCPR_SYM(allocator)* alloc,
+    commandline_opts* opts, const root_command* root,
+    const endorse_config_source* sources, size_t count)
+{
+    status retval, release_retval;
+    char* cache_filename;
+    uint8_t digest[ENDORSE_COMPILED_DIGEST_SIZE];
+    size_t scale;
+
+    /* the cache is named after the first config file. */
+    TRY_OR_FAIL(
+        endorse_compiled_cache_filename(&cache_filename, sources[0].filename),
+        done);
+
+    /* the cache records the digest in place of the sources. */
+    TRY_OR_FAIL(
+        endorse_config_digest(digest, opts->suite, sources, count),
+        cleanup_cache_filename);
+
+    /* use the cache if it was compiled from these exact sources. */
+    retval =
+        endorse_compiled_load(
+            compiled, alloc, opts->file, cache_filename, digest);
+    if (STATUS_SUCCESS == retval)
+    {
+        if (root->verbose)
+        {
+            printf("Using compiled endorse config %s.\n", cache_filename);
+        }
+
+        goto cleanup_cache_filename;
+    }
+    else if (VCTOOL_ERROR_ENDORSE_COMPILED_UNTRUSTED == retval)
+    {
+        fprintf(
+            stderr,
+            "Ignoring compiled endorse config %s; another user could have "
+            "written it.\n", cache_filename);
+    }
+
+    /* compile in arenas, so that each whole AST is freed at once. */
+    for (scale = ENDORSE_ARENA_INITIAL_BYTES_PER_SOURCE_BYTE; ; scale *= 2)
+    {
+        retval =
+            endorse_compile_source(
+                compiled, alloc, scale, sources, count, digest);
+        if (VCTOOL_ERROR_ENDORSE_ARENA_EXHAUSTED != retval
+         || scale >= ENDORSE_ARENA_MAX_BYTES_PER_SOURCE_BYTE)
+        {
+            break;
+        }
+    }
+
+    /* only if the largest arenas are exhausted, compile without them. */
+    if (VCTOOL_ERROR_ENDORSE_ARENA_EXHAUSTED == retval)
+    {
+        retval =
+            endorse_compile_source(
+                compiled, alloc, 0, sources, count, digest);
+    }
+
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_cache_filename;
+    }
+
+    /* save the compiled config; an unwritable directory just means no cache. */
+    release_retval =
+        endorse_compiled_write(opts->file, *compiled, cache_filename);
+    if (STATUS_SUCCESS != release_retval && root->verbose)
+    {
+        fprintf(
+            stderr, "Could not write compiled endorse config %s.\n",
+            cache_filename);
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_cache_filename;
+
+cleanup_cache_filename:
+    free(cache_filename);
+
+done:
+    return retval;
+}
@@ -0,0 +1,126 @@
+/**
+ * \file command/endorse/endorse_get_jobs.c
+ *
+ * \brief Create a job for each input certificate to endorse.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a job for each input certificate, verifying that each input
+ * exists and that its output file would not clobber an existing file.
+ *
+ * Inputs are the -i input file, if given, followed by any arguments to the
+ * endorse command.
+ *
+ * \param jobs          Pointer to receive the array of jobs.
+ * \param job_count     Pointer to receive the number of jobs.
+ * \param opts          The command-line options to use.
+ * \param alloc         The allocator to use.
+ * \param root          The root command instance.
+ * \param endorse       The endorse command instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_get_jobs(
+    endorse_job** jobs, size_t* job_count, commandline_opts* opts,
+    RCPR_SYM(allocator)* alloc, const root_command* root,
+    const endorse_command* endorse)
+{
+    status retval, release_retval;
+    endorse_job* tmp;
+    size_t count = 0;
+
+    /* compute the number of inputs. */
+    size_t inputs =
+        (NULL != root->input_filename ? 1 : 0) + endorse->input_filename_count;
+
+    /* with no inputs, report the missing -i option. */
+    if (0 == inputs)
+    {
+        fprintf(stderr, "Expecting an input filename (-i user.pub).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+
+    /* an explicit output filename only makes sense for a single input. */
+    if (inputs > 1 && NULL != root->output_filename)
+    {
+        fprintf(
+            stderr, "An output filename (-o) can only be used when endorsing "
+                    "a single certificate.\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+        goto done;
+    }
+
+    /* allocate the jobs. */
+    tmp = (endorse_job*)malloc(inputs * sizeof(endorse_job));
+    if (NULL == tmp)
+    {
+        fprintf(stderr, "Out of memory.\n");
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    memset(tmp, 0, inputs * sizeof(endorse_job));
+
+    /* create each job. */
+    for (count = 0; count < inputs; ++count)
+    {
+        /* the -i input comes first. */
+        if (0 == count && NULL != root->input_filename)
+        {
+            retval =
+                endorse_get_input_file(
+                    &tmp[count].input_file, opts, alloc, root);
+        }
+        else
+        {
+            size_t arg =
+                count - (NULL != root->input_filename ? 1 : 0);
+            retval =
+                endorse_get_pubkey_file(
+                    &tmp[count].input_file, opts, alloc,
+                    endorse->input_filenames[arg]);
+        }
+
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_jobs;
+        }
+
+        /* get the output filename for this input. */
+        retval =
+            endorse_get_output_filename(
+                &tmp[count].output_filename, opts,
+                tmp[count].input_file->filename, root);
+        if (STATUS_SUCCESS != retval)
+        {
+            /* release the input file for this partially created job. */
+            CLEANUP_OR_CASCADE(&tmp[count].input_file->hdr);
+            goto cleanup_jobs;
+        }
+    }
+
+    /* success. */
+    *jobs = tmp;
+    *job_count = count;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_jobs:
+    release_retval = endorse_jobs_release(tmp, count);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,53 @@
+/**
+ * \file command/endorse/endorse_grant_table_add.c
+ *
+ * \brief Decode a moiety and grant its verbs to an entity.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Decode the given moiety and grant its verbs to the given entity.
+ *
+ * \param table             The grant table.
+ * \param entity            The compiled entity to use for this operation.
+ * \param entity_id         The ID of this entity.
+ * \param moiety            The moiety to decode.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_grant_table_add(
+    endorse_grant_table* table, const endorse_compiled_entity* entity,
+    const RCPR_SYM(rcpr_uuid)* entity_id, const char* moiety)
+{
+    status retval;
+    const endorse_compiled* compiled = table->compiled;
+    size_t index = (size_t)(entity - compiled->entities);
+
+    /* OR the verbs of this role or verb into the bitset for this entity. */
+    retval =
+        endorse_compiled_grant_moiety(
+            table->words + table->word_offsets[index], compiled, entity,
+            moiety);
+    if (STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr, "Unknown role or verb %s:%s.\n",
+            compiled->strings + entity->name, moiety);
+        goto done;
+    }
+
+    /* record the ID of this entity. */
+    table->entity_ids[index] = entity_id;
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto done;
+
+done:
+    return retval;
+}
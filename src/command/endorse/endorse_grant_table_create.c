@@ -0,0 +1,88 @@
+/**
+ * \file command/endorse/endorse_grant_table_create.c
+ *
+ * \brief Create an empty grant table for a compiled config.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+RCPR_IMPORT_uuid;
+
+/**
+ * \brief Create an empty grant table for a compiled config.
+ *
+ * The table, its bitsets, and its per-entity arrays are allocated in a single
+ * block.
+ *
+ * \param table             Pointer to receive the grant table on success.
+ * \param alloc             The allocator to use for this operation.
+ * \param compiled          The compiled config, which must outlive the table.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_grant_table_create(
+    endorse_grant_table** table, RCPR_SYM(allocator)* alloc,
+    const endorse_compiled* compiled)
+{
+    status retval;
+    endorse_grant_table* tmp;
+    size_t entity_count = compiled->header->entity_count;
+    size_t word_count = 0;
+
+    /* count the bitset words needed for every entity. */
+    for (size_t i = 0; i < entity_count; ++i)
+    {
+        word_count +=
+            endorse_compiled_entity_word_count(&compiled->entities[i]);
+    }
+
+    /* the words come first, so that they are aligned. */
+    size_t size =
+        sizeof(*tmp)
+      + word_count * sizeof(uint64_t)
+      + entity_count * sizeof(size_t)
+      + entity_count * sizeof(const rcpr_uuid*);
+
+    /* allocate memory for the grant table. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, size);
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &endorse_grant_table_resource_release);
+
+    /* set values. */
+    tmp->alloc = alloc;
+    tmp->compiled = compiled;
+    tmp->words = (uint64_t*)(tmp + 1);
+    tmp->word_offsets = (size_t*)(tmp->words + word_count);
+    tmp->entity_ids = (const rcpr_uuid**)(tmp->word_offsets + entity_count);
+
+    /* assign each entity its range of bitset words. */
+    word_count = 0;
+    for (size_t i = 0; i < entity_count; ++i)
+    {
+        tmp->word_offsets[i] = word_count;
+        word_count +=
+            endorse_compiled_entity_word_count(&compiled->entities[i]);
+    }
+
+    /* success. */
+    *table = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+done:
+    return retval;
+}
@@ -0,0 +1,35 @@
+/**
+ * \file command/endorse/endorse_grant_table_resource_release.c
+ *
+ * \brief Release a grant table.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Release a grant table.
+ *
+ * \param r                 The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_grant_table_resource_release(RCPR_SYM(resource)* r)
+{
+    endorse_grant_table* table = (endorse_grant_table*)r;
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = table->alloc;
+
+    /* clear the header; the bitsets and arrays are part of this block. */
+    memset(table, 0, sizeof(*table));
+
+    /* reclaim the grant table. */
+    return rcpr_allocator_reclaim(alloc, table);
+}
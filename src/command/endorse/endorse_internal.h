@@ -3,7 +3,7 @@
  *
  * \brief Internal header for the endorse command.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #pragma once
@@ -20,6 +20,7 @@
 #include <vctool/command/root.h>
 #include <vctool/control.h>
 #include <vctool/endorse.h>
+#include <vctool/parallel.h>
 #include <vctool/readpassword.h>
 
 #include "certfile.h"
@@ -29,15 +30,35 @@
 extern "C" {
 #endif
 
-/** \brief An entry in the endorse uuid dictionary. */
+/**
+ * \brief A slot in the endorse uuid dictionary. The key is borrowed from the
+ * root command dictionary, which outlives the endorse command. A slot with a
+ * NULL key is empty.
+ */
 typedef struct endorse_uuid_dictionary_entry endorse_uuid_dictionary_entry;
 
 struct endorse_uuid_dictionary_entry
+{
+    const char* key;
+    uint64_t hash;
+    RCPR_SYM(rcpr_uuid) value;
+};
+
+/**
+ * \brief An open addressing hash map of entity name to UUID.
+ *
+ * All slots are held in a single power of two sized array, which is kept at
+ * most half full so that linear probes stay short.
+ */
+typedef struct endorse_uuid_dictionary endorse_uuid_dictionary;
+
+struct endorse_uuid_dictionary
 {
     RCPR_SYM(resource) hdr;
     RCPR_SYM(allocator)* alloc;
-    char* key;
-    RCPR_SYM(rcpr_uuid) value;
+    endorse_uuid_dictionary_entry* slots;
+    size_t capacity;
+    size_t count;
 };
 
 typedef struct endorse_working_set_key endorse_working_set_key;
@@ -49,13 +70,157 @@ struct endorse_working_set_key
     RCPR_SYM(rcpr_uuid) restriction;
 };
 
-typedef struct endorse_working_set_entry endorse_working_set_entry;
+/**
+ * \brief The working set of capabilities to endorse.
+ *
+ * Keys are appended without checking for duplicates. Once the set is complete,
+ * it is finalized by sorting the keys and removing duplicates in a single pass.
+ */
+typedef struct endorse_working_set endorse_working_set;
+
+struct endorse_working_set
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    endorse_working_set_key* keys;
+    size_t count;
+    size_t capacity;
+};
+
+/**
+ * \brief Working sets with at least this many keys are radix sorted.
+ */
+#define ENDORSE_WORKING_SET_RADIX_THRESHOLD 256
 
-struct endorse_working_set_entry
+/**
+ * \brief The verbs granted to each entity of a compiled config, as one verb
+ * bitset per entity.
+ *
+ * Every permission ORs the verbs of its moiety into the bitset of its entity.
+ * Each granted verb is then emitted to the working set exactly once.
+ */
+typedef struct endorse_grant_table endorse_grant_table;
+
+struct endorse_grant_table
 {
     RCPR_SYM(resource) hdr;
     RCPR_SYM(allocator)* alloc;
-    endorse_working_set_key key;
+    const endorse_compiled* compiled;
+    uint64_t* words;
+    size_t* word_offsets;
+    const RCPR_SYM(rcpr_uuid)** entity_ids;
+};
+
+/** \brief An endorse config file, mapped read-only into memory. */
+typedef struct endorse_config_source endorse_config_source;
+
+struct endorse_config_source
+{
+    const char* filename;
+    const void* data;
+    size_t size;
+};
+
+/**
+ * \brief A single endorse config file to parse into its own context. Each job
+ * has its own allocator, so jobs can run concurrently even in arenas.
+ */
+typedef struct endorse_parse_job endorse_parse_job;
+
+struct endorse_parse_job
+{
+    const endorse_config_source* source;
+    RCPR_SYM(allocator)* alloc;
+    endorse_config_context* context;
+    status result;
+};
+
+/**
+ * \brief A single endorse config file to check on its own. The parse and
+ * analysis times are recorded separately, in nanoseconds.
+ */
+typedef struct endorse_check_job endorse_check_job;
+
+struct endorse_check_job
+{
+    const endorse_config_source* source;
+    RCPR_SYM(allocator)* alloc;
+    endorse_config_context* context;
+    uint64_t parse_ns;
+    uint64_t analyze_ns;
+    status result;
+};
+
+/**
+ * \brief The state of the endorse-watch command.
+ *
+ * The directory of each config file is watched, since editors often replace a
+ * file instead of writing it in place.
+ */
+typedef struct endorse_watch endorse_watch;
+
+struct endorse_watch
+{
+    commandline_opts* opts;
+    const root_command* root;
+    endorse_incremental* inc;
+    int inotify_fd;
+    int* watch_descriptors;
+};
+
+/** \brief A single public certificate to endorse. */
+typedef struct endorse_job endorse_job;
+
+struct endorse_job
+{
+    certfile* input_file;
+    char* output_filename;
+    status result;
+};
+
+/**
+ * \brief The state shared by all endorse jobs. Everything but the jobs array is
+ * read-only while the jobs are running.
+ */
+typedef struct endorse_batch endorse_batch;
+
+struct endorse_batch
+{
+    commandline_opts* opts;
+    const RCPR_SYM(rcpr_uuid)* endorser_id;
+    const vccrypt_buffer_t* endorser_private_key;
+    const endorse_working_set* set;
+    endorse_job* jobs;
+    size_t job_count;
+};
+
+/** \brief A single distinct pubkey file referenced by the uuid dictionary. */
+typedef struct endorse_pubkey_job endorse_pubkey_job;
+
+struct endorse_pubkey_job
+{
+    const char* filename;
+    RCPR_SYM(rcpr_uuid) entity_id;
+    status result;
+};
+
+/** \brief A uuid dictionary key and the pubkey job that resolves it. */
+typedef struct endorse_pubkey_lookup endorse_pubkey_lookup;
+
+struct endorse_pubkey_lookup
+{
+    const root_dict_kvp* kvp;
+    size_t job;
+};
+
+/** \brief The state shared by all pubkey jobs. */
+typedef struct endorse_pubkey_batch endorse_pubkey_batch;
+
+struct endorse_pubkey_batch
+{
+    commandline_opts* opts;
+    endorse_pubkey_job* jobs;
+    size_t job_count;
 };
 
 /**
@@ -92,24 +257,6 @@ status endorse_get_input_file(
     certfile** input_file, commandline_opts* opts, RCPR_SYM(allocator)* alloc,
     const root_command* root);
 
-/**
- * \brief Get the endorse config file and output an error message if the endorse
- * config file option is not set on the command line.
- *
- * \param endorse_config_file   Pointer to receive the input file certfile
- *                              instance.
- * \param opts                  The command-line options to use.
- * \param alloc                 The allocator to use.
- * \param root                  The root command instance.
- *
- * \returns a status code indicating success or failure.
- *      - STATUS_SUCCESS on success.
- *      - a non-zero error code on failure.
- */
-status endorse_get_endorse_config_file(
-    certfile** endorse_config_file, commandline_opts* opts,
-    RCPR_SYM(allocator)* alloc, const root_command* root);
-
 /**
  * \brief Get a pubkey certfile by name and output an error message if the file
  * could not be stat'ed.
@@ -128,23 +275,23 @@ status endorse_get_pubkey_file(
     const char* filename);
 
 /**
- * \brief Given a pubkey certfile, open it and parse it to obtain the entity
- * id.
+ * \brief Read a pubkey certificate file and obtain its entity id.
+ *
+ * Only the artifact id field is read from the certificate. This is safe to
+ * call from a worker thread.
  *
  * \param entity_id     \ref rcpr_uuid pointer to be populated with the entity
  *                      id.
- * \param pubkey_file   The pubkey certfile instance.
  * \param opts          The command-line options to use.
- * \param alloc         The allocator to use.
- * \param root          The root command instance.
+ * \param filename      The name of the pubkey certificate file.
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
  *      - a non-zero error code on failure.
  */
-status endorse_get_pubkey_id(
-    RCPR_SYM(rcpr_uuid)* entity_id, certfile* key_file, commandline_opts* opts,
-    RCPR_SYM(allocator)* alloc, const root_command* root);
+status endorse_read_pubkey_id(
+    RCPR_SYM(rcpr_uuid)* entity_id, commandline_opts* opts,
+    const char* filename);
 
 /**
  * \brief Get the output filename and output an error message if the output file
@@ -215,25 +362,98 @@ status endorse_read_input_certificate(
     vccrypt_buffer_t* cert, commandline_opts* opts, const certfile* input_file);
 
 /**
- * \brief Read the endorse config file.
+ * \brief Map every endorse config file given on the command line, and output
+ * an error message if no endorse config file is given.
  *
- * \param cert                  Pointer to buffer that will be initialized with
- *                              the endorse config data.
- * \param opts                  The command-line options to use.
- * \param endorse_config_file   The certfile from which the endorse config is
- *                              read.
+ * \param sources           Pointer to receive the array of mapped sources. The
+ *                          caller must release it with
+ *                          endorse_unmap_endorse_config_files.
+ * \param count             Pointer to receive the number of sources.
+ * \param f                 The file interface to use.
+ * \param root              The root command instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_map_endorse_config_files(
+    endorse_config_source** sources, size_t* count, file* f,
+    const root_command* root);
+
+/**
+ * \brief Map an endorse config file read-only into memory.
+ *
+ * The config is parsed directly from this mapping, so it is never copied into
+ * a buffer. An empty file is not mapped, and receives a NULL source.
+ *
+ * \param source            The source to initialize on success.
+ * \param f                 The file interface to use.
+ * \param filename          The endorse config filename.
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
  *      - a non-zero error code on failure.
  */
-status endorse_read_endorse_config_file(
-    vccrypt_buffer_t* cert, commandline_opts* opts,
-    const certfile* endorse_config_file);
+status endorse_map_endorse_config_file(
+    endorse_config_source* source, file* f, const char* filename);
+
+/**
+ * \brief Unmap and free an array of endorse config sources.
+ *
+ * \param f                 The file interface the sources were mapped with.
+ * \param sources           The array of sources.
+ * \param count             The number of sources.
+ */
+void endorse_unmap_endorse_config_files(
+    file* f, endorse_config_source* sources, size_t count);
+
+/**
+ * \brief Compute the digest of a set of endorse config sources.
+ *
+ * The digest is the SHA-512 digest of the size and contents of each source, in
+ * order. It is recorded in the compiled config in place of the sources
+ * themselves.
+ *
+ * \param digest            The digest, which must hold
+ *                          \ref ENDORSE_COMPILED_DIGEST_SIZE bytes.
+ * \param suite             The crypto suite to use for this operation.
+ * \param sources           The array of sources.
+ * \param count             The number of sources.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_COMPILED_INVALID if the suite digest is not
+ *        SHA-512.
+ *      - a non-zero error code on failure.
+ */
+status endorse_config_digest(
+    uint8_t* digest, vccrypt_suite_options_t* suite,
+    const endorse_config_source* sources, size_t count);
+
+/**
+ * \brief Worker function; parses a single endorse config file.
+ *
+ * \param context           The array of parse jobs.
+ * \param index             The index of the job to process.
+ */
+void endorse_parse_worker(void* context, size_t index);
+
+/**
+ * \brief Determine whether a parse job ran out of memory.
+ *
+ * \param job               The parse job to check.
+ * \param retval            The status of the failed step, or STATUS_SUCCESS.
+ *
+ * \returns true if the job ran out of memory, and false otherwise.
+ */
+bool endorse_parse_job_out_of_memory(
+    const endorse_parse_job* job, status retval);
 
 /**
  * \brief Build a map of key to UUID using the command-line options.
  *
+ * Each distinct pubkey file is read once, and the files are read concurrently.
+ *
  * \param dict              Receive a pointer to the dictionary on success.
  * \param alloc             The allocator to use for this operation.
  * \param opts              The command-line options to use.
@@ -244,16 +464,159 @@ status endorse_read_endorse_config_file(
  *      - a non-zero error code on failure.
  */
 status endorse_build_uuid_dictionary(
-    RCPR_SYM(rbtree)** dict, RCPR_SYM(allocator)* alloc, commandline_opts* opts,
-    const root_command* root);
+    endorse_uuid_dictionary** dict, RCPR_SYM(allocator)* alloc,
+    commandline_opts* opts, const root_command* root);
+
+/**
+ * \brief Compare two pubkey lookups by pubkey filename, for use with qsort.
+ *
+ * \param lhs           The left-hand side of the comparison.
+ * \param rhs           The right-hand side of the comparison.
+ *
+ * \returns less than, equal to, or greater than zero if \p lhs is less than,
+ * equal to, or greater than \p rhs.
+ */
+int endorse_pubkey_lookup_compare(const void* lhs, const void* rhs);
+
+/**
+ * \brief Worker function; reads the entity id for a single pubkey job.
+ *
+ * \param context       The pubkey batch.
+ * \param index         The index of the job to process.
+ */
+void endorse_pubkey_batch_worker(void* context, size_t index);
+
+/**
+ * \brief Parse, merge, analyze, and compile the endorse config sources.
+ *
+ * Each source is parsed into its own context in parallel. Every other config
+ * is then merged into the config of the first source, which is analyzed and
+ * compiled.
+ *
+ * \param compiled              Receive a pointer to the compiled config on
+ *                              success.
+ * \param alloc                 The allocator for the compiled config.
+ * \param bytes_per_source_byte If non-zero, each source is parsed in its own
+ *                              endorse arena of this many bytes per byte of
+ *                              source, which frees the parser context and AST
+ *                              at once. Otherwise, \p alloc is used.
+ * \param sources               The endorse config sources.
+ * \param count                 The number of sources.
+ * \param digest                The SHA-512 digest of the sources, recorded in
+ *                              the compiled config.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_ARENA_EXHAUSTED if an arena was too small.
+ *      - a non-zero error code on failure.
+ */
+status endorse_compile_source(
+    endorse_compiled** compiled, RCPR_SYM(allocator)* alloc,
+    size_t bytes_per_source_byte,
+    const endorse_config_source* sources, size_t count,
+    const uint8_t* digest);
+
+/**
+ * \brief Get the compiled endorse config, either by mapping a valid cache file
+ * or by parsing, analyzing, and compiling the config sources.
+ *
+ * The cache file is named after the first config source, and is only valid
+ * for the exact same sequence of sources. When the config sources are
+ * compiled, the compiled image is written to the cache file for later runs.
+ * Failure to write the cache is not an error. The sources are first compiled
+ * in small arenas, which are doubled in size each time one is exhausted. Only
+ * if the largest arenas are exhausted are they compiled again with \p alloc.
+ *
+ * \param compiled              Receive a pointer to the compiled config on
+ *                              success.
+ * \param alloc                 The allocator to use for this operation.
+ * \param opts                  The command-line options to use.
+ * \param root                  The root command config.
+ * \param sources               The endorse config sources.
+ * \param count                 The number of sources.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_get_compiled_config(
+    endorse_compiled** compiled, RCPR_SYM(allocator)* alloc,
+    commandline_opts* opts, const root_command* root,
+    const endorse_config_source* sources, size_t count);
+
+/**
+ * \brief Worker function; parses and analyzes a single endorse config file.
+ *
+ * \param context           The array of check jobs.
+ * \param index             The index of the job to process.
+ */
+void endorse_check_worker(void* context, size_t index);
+
+/**
+ * \brief Build the compiled cache filename for an endorse config file.
+ *
+ * \param cache_filename    Pointer to receive the cache filename, which the
+ *                          caller must free.
+ * \param filename          The endorse config filename.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_compiled_cache_filename(
+    char** cache_filename, const char* filename);
+
+/**
+ * \brief Watch the directory of each endorse config file for changes.
+ *
+ * \param watch             The watch state, which receives the inotify file
+ *                          descriptor and one watch descriptor per file.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_watch_add_watches(endorse_watch* watch);
+
+/**
+ * \brief Return true if a buffer of inotify events names any config file.
+ *
+ * If the inotify queue overflowed, events may have been lost, so this is also
+ * true.
+ *
+ * \param watch             The watch state.
+ * \param events            The events read from the inotify file descriptor.
+ * \param size              The size of the events.
+ *
+ * \returns true if a config file changed and false otherwise.
+ */
+bool endorse_watch_is_relevant(
+    const endorse_watch* watch, const void* events, size_t size);
+
+/**
+ * \brief Validate the endorse config files incrementally, and compile a valid
+ * config to the cache used by the endorse command.
+ *
+ * Errors and timing are reported for each update. If the config has errors,
+ * the last good config is kept.
+ *
+ * \param watch             The watch state.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_INVALID_CONFIG if the config has errors.
+ *      - a non-zero error code on failure.
+ */
+status endorse_watch_update(endorse_watch* watch);
 
 /**
- * \brief Build a working set of capabilities using the AST and uuid dictionary.
+ * \brief Build a working set of capabilities using the compiled config and
+ * uuid dictionary.
  *
  * \param set               Receive a pointer to the working set on success.
  * \param alloc             The allocator to use for this operation.
  * \param root              The root command config.
- * \param ast               The ast to use for this operation.
+ * \param compiled          The compiled config to use for this operation.
  * \param dict              The uuid dictionary to use for this operation.
  *
  * \returns a status code indicating success or failure.
@@ -261,19 +624,20 @@ status endorse_build_uuid_dictionary(
  *      - a non-zero error code on failure.
  */
 status endorse_build_working_set(
-    RCPR_SYM(rbtree)** set, RCPR_SYM(allocator)* alloc,
-    const root_command* root, const endorse_config* ast,
-    RCPR_SYM(rbtree)* dict);
+    endorse_working_set** set, RCPR_SYM(allocator)* alloc,
+    const root_command* root, const endorse_compiled* compiled,
+    const endorse_uuid_dictionary* dict);
 
 /**
- * \brief Build the output file given the output filename, the key certificate,
+ * \brief Build the output file given the output filename, the endorser details,
  * the working set, and the input file certificate.
  *
- * \param output_filename   The name of the output file.
- * \param opts              The commandline options for this operation.
- * \param key_cert          The endorser's key certificate.
- * \param set               The working set.
- * \param input_cert        The public key input certificate.
+ * \param output_filename       The name of the output file.
+ * \param opts                  The commandline options for this operation.
+ * \param endorser_id           The endorser's id.
+ * \param endorser_private_key  The endorser's private signing key.
+ * \param set                   The working set.
+ * \param input_cert            The public key input certificate.
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
@@ -281,15 +645,41 @@ status endorse_build_working_set(
  */
 status endorse_build_output_file(
     const char* output_filename, commandline_opts* opts,
-    const vccrypt_buffer_t* key_cert, RCPR_SYM(rbtree)* set,
-    const vccrypt_buffer_t* input_cert);
+    const RCPR_SYM(rcpr_uuid)* endorser_id,
+    const vccrypt_buffer_t* endorser_private_key,
+    const endorse_working_set* set, const vccrypt_buffer_t* input_cert);
 
 /**
- * \brief Decode and add the capabilities represented by the given moiety.
+ * \brief Create an empty grant table for a compiled config.
  *
- * \param set               The current working set.
+ * \param table             Pointer to receive the grant table on success.
  * \param alloc             The allocator to use for this operation.
- * \param entity            The entity to use for this operation.
+ * \param compiled          The compiled config, which must outlive the table.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_grant_table_create(
+    endorse_grant_table** table, RCPR_SYM(allocator)* alloc,
+    const endorse_compiled* compiled);
+
+/**
+ * \brief Release a grant table.
+ *
+ * \param r                 The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_grant_table_resource_release(RCPR_SYM(resource)* r);
+
+/**
+ * \brief Decode the given moiety and grant its verbs to the given entity.
+ *
+ * \param table             The grant table.
+ * \param entity            The compiled entity to use for this operation.
  * \param entity_id         The ID of this entity.
  * \param moiety            The moiety to decode.
  *
@@ -297,102 +687,153 @@ status endorse_build_output_file(
  *      - STATUS_SUCCESS on success.
  *      - a non-zero error code on failure.
  */
-status endorse_working_set_add_capabilities(
-    RCPR_SYM(rbtree)* set, RCPR_SYM(allocator)* alloc, endorse_entity* entity,
+status endorse_grant_table_add(
+    endorse_grant_table* table, const endorse_compiled_entity* entity,
     const RCPR_SYM(rcpr_uuid)* entity_id, const char* moiety);
 
 /**
- * \brief Add all of the capabilities for the given role to the working set.
+ * \brief Add a capability to the working set for every verb granted in the
+ * grant table.
  *
  * \param set               The current working set.
- * \param alloc             The allocator to use for this operation.
- * \param entity_id         The ID of this entity.
- * \param role              The role to add to this working set.
+ * \param table             The grant table.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_working_set_add_capabilities(
+    endorse_working_set* set, const endorse_grant_table* table);
+
+/**
+ * \brief Reserve space for at least the given number of keys in the working
+ * set, so that adding this many keys does not reallocate the keys array.
+ *
+ * \param set               The working set.
+ * \param capacity          The number of keys to reserve.
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
  *      - a non-zero error code on failure.
  */
-status endorse_working_set_add_role_capabilities(
-    RCPR_SYM(rbtree)* set, RCPR_SYM(allocator)* alloc,
-    const RCPR_SYM(rcpr_uuid)* entity_id, endorse_role* role);
+status endorse_working_set_reserve(endorse_working_set* set, size_t capacity);
 
 /**
  * \brief Add the capability associated with the given verb to the working set.
  *
  * \param set               The current working set.
- * \param alloc             The allocator to use for this operation.
  * \param entity_id         The ID of this entity.
- * \param verb              The verb to use for this operation.
+ * \param verb_id           The ID of the verb to add.
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
  *      - a non-zero error code on failure.
  */
 status endorse_working_set_add_verb_capability(
-    RCPR_SYM(rbtree)* set, RCPR_SYM(allocator)* alloc,
-    const RCPR_SYM(rcpr_uuid)* entity_id, endorse_verb* verb);
+    endorse_working_set* set, const RCPR_SYM(rcpr_uuid)* entity_id,
+    const RCPR_SYM(rcpr_uuid)* verb_id);
 
 /**
- * \brief Compare two opaque uuid values.
+ * \brief Compare two working set keys, for use with qsort.
  *
- * \param context       Unused.
  * \param lhs           The left-hand side of the comparison.
  * \param rhs           The right-hand side of the comparison.
  *
- * \returns an integer value representing the comparison result.
- *      - RCPR_COMPARE_LT if \p lhs &lt; \p rhs.
- *      - RCPR_COMPARE_EQ if \p lhs == \p rhs.
- *      - RCPR_COMPARE_GT if \p lhs &gt; \p rhs.
+ * \returns less than, equal to, or greater than zero if \p lhs is less than,
+ * equal to, or greater than \p rhs.
  */
-RCPR_SYM(rcpr_comparison_result) endorse_uuid_dictionary_compare(
-    void* /*context*/, const void* lhs, const void* rhs);
+int endorse_working_set_compare(const void* lhs, const void* rhs);
 
 /**
- * \brief Given an endorse_uuid_dictionary_entry, return the key.
+ * \brief Create an empty working set.
  *
- * \param context       Unused.
- * \param r             The resource handle of the
- *                      endorse_uuid_dictionary_entry.
+ * \param set               Pointer to receive the working set on success.
+ * \param alloc             The allocator to use for this operation.
  *
- * \returns the key for the entry.
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
  */
-const void* endorse_uuid_dictionary_key(
-    void* /*context*/, const RCPR_SYM(resource)* r);
+status endorse_working_set_create(
+    endorse_working_set** set, RCPR_SYM(allocator)* alloc);
 
 /**
- * \brief Compare two opaque working set values.
+ * \brief Sort the working set and remove duplicate keys.
  *
- * \param context       Unused.
- * \param lhs           The left-hand side of the comparison.
- * \param rhs           The right-hand side of the comparison.
+ * \param set               The working set to finalize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_working_set_finalize(endorse_working_set* set);
+
+/**
+ * \brief Sort an array of working set keys using an LSD radix sort on the key
+ * bytes. Byte positions that are the same for every key are skipped.
  *
- * \returns an integer value representing the comparison result.
- *      - RCPR_COMPARE_LT if \p lhs &lt; \p rhs.
- *      - RCPR_COMPARE_EQ if \p lhs == \p rhs.
- *      - RCPR_COMPARE_GT if \p lhs &gt; \p rhs.
+ * \param keys              The keys to sort.
+ * \param scratch           Scratch space for at least \p count keys.
+ * \param count             The number of keys.
  */
-RCPR_SYM(rcpr_comparison_result) endorse_working_set_compare(
-    void* /*context*/, const void* lhs, const void* rhs);
+void endorse_working_set_radix_sort(
+    endorse_working_set_key* keys, endorse_working_set_key* scratch,
+    size_t count);
 
 /**
- * \brief Given an endorse_working_set_entry, return the key.
+ * \brief Release a working set.
  *
- * \param context       Unused.
- * \param r             The resource handle of the
- *                      endorse_working_set_entry.
+ * \param r             The resource to release.
  *
- * \returns the key for the entry.
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
  */
-const void* endorse_working_set_get_key(
-    void* /*context*/, const RCPR_SYM(resource)* r);
+status endorse_working_set_resource_release(RCPR_SYM(resource)* r);
 
 /**
- * \brief Add an entry to the uuid dictionary.
+ * \brief Create an empty uuid dictionary.
  *
- * \param dict              The dictionary to which this entry is added.
+ * \param dict              Pointer to receive the dictionary on success.
  * \param alloc             The allocator to use for this operation.
- * \param key               The key for this entry.
+ * \param expected_count    The number of entries expected, used to size the
+ *                          table so that it doesn't need to grow.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_uuid_dictionary_create(
+    endorse_uuid_dictionary** dict, RCPR_SYM(allocator)* alloc,
+    size_t expected_count);
+
+/**
+ * \brief Release a uuid dictionary.
+ *
+ * \param r                 The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_uuid_dictionary_resource_release(RCPR_SYM(resource)* r);
+
+/**
+ * \brief Hash a uuid dictionary key.
+ *
+ * \param key               The key to hash.
+ *
+ * \returns the 64-bit FNV-1a hash of the key.
+ */
+uint64_t endorse_uuid_dictionary_hash(const char* key);
+
+/**
+ * \brief Add an entry to the uuid dictionary, replacing the value of any
+ * existing entry with the same key.
+ *
+ * \param dict              The dictionary to which this entry is added.
+ * \param key               The key for this entry. This string must outlive
+ *                          the dictionary.
  * \param value             The UUID value for this entry.
  *
  * \returns a status code indicating success or failure.
@@ -400,9 +841,20 @@ const void* endorse_working_set_get_key(
  *      - a non-zero error code on failure.
  */
 status endorse_uuid_dictionary_add(
-    RCPR_SYM(rbtree)* dict, RCPR_SYM(allocator)* alloc, const char* key,
+    endorse_uuid_dictionary* dict, const char* key,
     const RCPR_SYM(rcpr_uuid)* value);
 
+/**
+ * \brief Look up a key in the uuid dictionary.
+ *
+ * \param dict              The dictionary to search.
+ * \param key               The key to find.
+ *
+ * \returns the UUID for this key, or NULL if the key is not found.
+ */
+const RCPR_SYM(rcpr_uuid)* endorse_uuid_dictionary_find(
+    const endorse_uuid_dictionary* dict, const char* key);
+
 /**
  * \brief Get the endorser id and private signing key.
  *
@@ -421,9 +873,36 @@ status endorse_get_endorser_details(
     commandline_opts* opts, const vccrypt_buffer_t* key_cert);
 
 /**
- * \brief Write the public certificate fields to the builder.
+ * \brief The size of a short certificate field header: a type and a size.
+ */
+#define ENDORSE_FIELD_HEADER_SIZE (2 * sizeof(uint16_t))
+
+/**
+ * \brief Encode a short certificate field header in network byte order.
+ *
+ * \param out               The output position.
+ * \param type              The field type.
+ * \param size              The size of the field value.
  *
- * \param builder           The builder to which the fields are written.
+ * \returns the output position just past the header.
+ */
+static inline uint8_t* endorse_emit_field_header(
+    uint8_t* out, uint16_t type, uint16_t size)
+{
+    out[0] = (uint8_t)(type >> 8);
+    out[1] = (uint8_t)type;
+    out[2] = (uint8_t)(size >> 8);
+    out[3] = (uint8_t)size;
+
+    return out + ENDORSE_FIELD_HEADER_SIZE;
+}
+
+/**
+ * \brief Write the public certificate fields to the output buffer.
+ *
+ * \param out               Pointer to the output position, which is advanced
+ *                          past the fields. At least public_cert->size bytes
+ *                          must be available.
  * \param opts              The command-line options for this operation.
  * \param pub_id            Pointer to UUID buffer to receive the public entity
  *                          id of this entity.
@@ -434,45 +913,77 @@ status endorse_get_endorser_details(
  *      - a non-zero error code on failure.
  */
 status endorse_emit_public_certificate_fields(
-    vccert_builder_context_t* builder, commandline_opts* opts,
-    RCPR_SYM(rcpr_uuid)* pub_id, const vccrypt_buffer_t* public_cert);
+    uint8_t** out, commandline_opts* opts, RCPR_SYM(rcpr_uuid)* pub_id,
+    const vccrypt_buffer_t* public_cert);
 
 /**
- * \brief Write the working set to the builder.
+ * \brief Write the working set to the output buffer.
  *
- * \param builder           The builder to which the fields are written.
+ * \param out               Pointer to the output position, which is advanced
+ *                          past the endorsement fields. There must be room for
+ *                          one endorsement field per key.
  * \param pub_id            The uuid of the entity being granted endorsements.
- * \param set               The working set to write to the builder.
+ * \param set               The working set to write.
+ */
+void endorse_emit_working_set(
+    uint8_t** out, const RCPR_SYM(rcpr_uuid)* pub_id,
+    const endorse_working_set* set);
+
+/**
+ * \brief Create a job for each input certificate, verifying that each input
+ * exists and that its output file would not clobber an existing file.
+ *
+ * Inputs are the -i input file, if given, followed by any arguments to the
+ * endorse command.
+ *
+ * \param jobs          Pointer to receive the array of jobs.
+ * \param job_count     Pointer to receive the number of jobs.
+ * \param opts          The command-line options to use.
+ * \param alloc         The allocator to use.
+ * \param root          The root command instance.
+ * \param endorse       The endorse command instance.
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
  *      - a non-zero error code on failure.
  */
-status endorse_emit_working_set(
-    vccert_builder_context_t* builder, const RCPR_SYM(rcpr_uuid)* pub_id,
-    RCPR_SYM(rbtree)* set);
+status endorse_get_jobs(
+    endorse_job** jobs, size_t* job_count, commandline_opts* opts,
+    RCPR_SYM(allocator)* alloc, const root_command* root,
+    const endorse_command* endorse);
 
 /**
- * \brief Release an endorse uuid dictionary entry resource.
+ * \brief Release an array of jobs created by \ref endorse_get_jobs.
  *
- * \param r             The resource to release.
+ * \param jobs          The array of jobs.
+ * \param job_count     The number of jobs.
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
  *      - a non-zero error code on failure.
  */
-status endorse_uuid_dictionary_entry_resource_release(RCPR_SYM(resource)* r);
+status endorse_jobs_release(endorse_job* jobs, size_t job_count);
 
 /**
- * \brief Release an endorse working set entry resource.
+ * \brief Endorse a single input certificate from the batch.
  *
- * \param r             The resource to release.
+ * This is a \ref parallel_job_fn; the result is recorded in the job.
+ *
+ * \param context       The endorse batch.
+ * \param index         The index of the job to run.
+ */
+void endorse_batch_worker(void* context, size_t index);
+
+/**
+ * \brief Run every job in the batch on the worker pool and report the result.
+ *
+ * \param batch         The batch to run.
  *
  * \returns a status code indicating success or failure.
- *      - STATUS_SUCCESS on success.
+ *      - STATUS_SUCCESS if every job succeeded.
  *      - a non-zero error code on failure.
  */
-status endorse_working_set_entry_resource_release(RCPR_SYM(resource)* r);
+status endorse_batch_run(endorse_batch* batch);
 
 /* make this header C++ friendly. */
 #ifdef __cplusplus
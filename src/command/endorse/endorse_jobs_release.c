@@ -0,0 +1,39 @@
+/**
+ * \file command/endorse/endorse_jobs_release.c
+ *
+ * \brief Release an array of endorse jobs.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Release an array of jobs created by \ref endorse_get_jobs.
+ *
+ * \param jobs          The array of jobs.
+ * \param job_count     The number of jobs.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_jobs_release(endorse_job* jobs, size_t job_count)
+{
+    status retval = STATUS_SUCCESS;
+    status release_retval;
+
+    /* release each job. */
+    for (size_t i = 0; i < job_count; ++i)
+    {
+        free(jobs[i].output_filename);
+        CLEANUP_OR_CASCADE(&jobs[i].input_file->hdr);
+    }
+
+    /* free the array. */
+    free(jobs);
+
+    return retval;
+}
@@ -0,0 +1,53 @@
+/**
+ * \file command/endorse/endorse_map_endorse_config_file.c
+ *
+ * \brief Map an endorse config file into memory.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Map an endorse config file read-only into memory.
+ *
+ * The config is parsed directly from this mapping, so it is never copied into
+ * a buffer. An empty file is not mapped, and receives a NULL source.
+ *
+ * \param source            The source to initialize on success.
+ * \param f                 The file interface to use.
+ * \param filename          The endorse config filename.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_map_endorse_config_file(
+    endorse_config_source* source, file* f, const char* filename)
+{
+    status retval;
+    const void* data;
+    size_t size;
+
+    /* map the file; an empty file is not mapped. */
+    retval = file_map_contents(f, filename, &data, &size);
+    if (VCTOOL_ERROR_FILE_NO_ENTRY == retval)
+    {
+        fprintf(stderr, "Error opening file %s for read.\n", filename);
+        goto done;
+    }
+    else if (STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error reading from %s.\n", filename);
+        goto done;
+    }
+
+    /* success. The mapping outlives the file descriptor. */
+    source->filename = filename;
+    source->data = data;
+    source->size = size;
+    retval = STATUS_SUCCESS;
+
+done:
+    return retval;
+}
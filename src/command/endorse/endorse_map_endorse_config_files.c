@@ -0,0 +1,77 @@
+/**
+ * \file command/endorse/endorse_map_endorse_config_files.c
+ *
+ * \brief Map every endorse config file given on the command line.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Map every endorse config file given on the command line, and output
+ * an error message if no endorse config file is given.
+ *
+ * \param sources           Pointer to receive the array of mapped sources. The
+ *                          caller must release it with
+ *                          endorse_unmap_endorse_config_files.
+ * \param count             Pointer to receive the number of sources.
+ * \param f                 The file interface to use.
+ * \param root              The root command instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_map_endorse_config_files(
+    endorse_config_source** sources, size_t* count, file* f,
+    const root_command* root)
+{
+    status retval;
+    endorse_config_source* tmp;
+    size_t mapped;
+
+    /* check the endorse config filenames. */
+    if (0 == root->endorse_config_filename_count)
+    {
+        fprintf(
+            stderr, "Expecting an endorse config filename (-E endorse.cfg).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+
+    /* allocate the source array. */
+    tmp =
+        (endorse_config_source*)calloc(
+            root->endorse_config_filename_count, sizeof(endorse_config_source));
+    if (NULL == tmp)
+    {
+        fprintf(stderr, "Out of memory.\n");
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* map each config file. */
+    for (mapped = 0; mapped < root->endorse_config_filename_count; ++mapped)
+    {
+        retval =
+            endorse_map_endorse_config_file(
+                &tmp[mapped], f, root->endorse_config_filenames[mapped]);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_tmp;
+        }
+    }
+
+    /* success. */
+    *sources = tmp;
+    *count = mapped;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_tmp:
+    endorse_unmap_endorse_config_files(f, tmp, mapped);
+
+done:
+    return retval;
+}
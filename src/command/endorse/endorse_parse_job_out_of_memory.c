@@ -0,0 +1,33 @@
+/**
+ * \file command/endorse/endorse_parse_job_out_of_memory.c
+ *
+ * \brief Determine whether a parse job ran out of memory.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Determine whether a parse job ran out of memory.
+ *
+ * The job ran out of memory if its context could not be created, if its
+ * context recorded an allocation failure, or if the given status reports one.
+ *
+ * \param job               The parse job to check.
+ * \param retval            The status of the failed step, or STATUS_SUCCESS.
+ *
+ * \returns true if the job ran out of memory, and false otherwise.
+ */
+bool endorse_parse_job_out_of_memory(
+    const endorse_parse_job* job, status retval)
+{
+    if (NULL == job->context || job->context->out_of_memory)
+    {
+        return true;
+    }
+
+    return
+        ERROR_GENERAL_OUT_OF_MEMORY == retval
+     || VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY == retval;
+}
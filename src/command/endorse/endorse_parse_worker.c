@@ -0,0 +1,35 @@
+/**
+ * \file command/endorse/endorse_parse_worker.c
+ *
+ * \brief Worker function to parse a single endorse config file.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Worker function; parses a single endorse config file.
+ *
+ * Each job gets its own parser context, created with the job allocator, so the
+ * parse of one file shares no mutable state with any other.
+ *
+ * \param context           The array of parse jobs.
+ * \param index             The index of the job to process.
+ */
+void endorse_parse_worker(void* context, size_t index)
+{
+    endorse_parse_job* job = ((endorse_parse_job*)context) + index;
+
+    /* create the endorse config context. */
+    job->result = endorse_config_create_default(&job->context, job->alloc);
+    if (STATUS_SUCCESS != job->result)
+    {
+        job->context = NULL;
+        return;
+    }
+
+    /* parse the endorse config directly from its source. */
+    job->result =
+        endorse_parse_mapped(job->context, job->source->data, job->source->size);
+}
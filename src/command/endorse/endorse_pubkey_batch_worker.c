@@ -0,0 +1,24 @@
+/**
+ * \file command/endorse/endorse_pubkey_batch_worker.c
+ *
+ * \brief Read the entity id for a single pubkey job.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Worker function; reads the entity id for a single pubkey job.
+ *
+ * \param context       The pubkey batch.
+ * \param index         The index of the job to process.
+ */
+void endorse_pubkey_batch_worker(void* context, size_t index)
+{
+    endorse_pubkey_batch* batch = (endorse_pubkey_batch*)context;
+    endorse_pubkey_job* job = &batch->jobs[index];
+
+    job->result =
+        endorse_read_pubkey_id(&job->entity_id, batch->opts, job->filename);
+}
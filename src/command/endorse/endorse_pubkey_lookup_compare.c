@@ -0,0 +1,26 @@
+/**
+ * \file command/endorse/endorse_pubkey_lookup_compare.c
+ *
+ * \brief Compare two pubkey lookups by pubkey filename.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Compare two pubkey lookups by pubkey filename, for use with qsort.
+ *
+ * \param lhs           The left-hand side of the comparison.
+ * \param rhs           The right-hand side of the comparison.
+ *
+ * \returns less than, equal to, or greater than zero if \p lhs is less than,
+ * equal to, or greater than \p rhs.
+ */
+int endorse_pubkey_lookup_compare(const void* lhs, const void* rhs)
+{
+    const endorse_pubkey_lookup* l = (const endorse_pubkey_lookup*)lhs;
+    const endorse_pubkey_lookup* r = (const endorse_pubkey_lookup*)rhs;
+
+    return strcmp(l->kvp->value, r->kvp->value);
+}
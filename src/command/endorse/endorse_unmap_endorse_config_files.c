@@ -0,0 +1,31 @@
+/**
+ * \file command/endorse/endorse_unmap_endorse_config_files.c
+ *
+ * \brief Unmap and free an array of endorse config sources.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Unmap and free an array of endorse config sources.
+ *
+ * \param f                 The file interface the sources were mapped with.
+ * \param sources           The array of sources.
+ * \param count             The number of sources.
+ */
+void endorse_unmap_endorse_config_files(
+    file* f, endorse_config_source* sources, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        /* an empty file was never mapped. */
+        if (NULL != sources[i].data)
+        {
+            file_munmap(f, sources[i].data, sources[i].size);
+        }
+    }
+
+    free(sources);
+}
@@ -1,23 +1,22 @@
 /**
  * \file command/endorse/endorse_uuid_dictionary_add.c
  *
- * \brief Add an entry to the endorse uuid dictionary.
+ * \brief Add an entry to the uuid dictionary.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include "endorse_internal.h"
 
 RCPR_IMPORT_allocator_as(rcpr);
-RCPR_IMPORT_rbtree;
-RCPR_IMPORT_resource;
 
 /**
- * \brief Add an entry to the uuid dictionary.
+ * \brief Add an entry to the uuid dictionary, replacing the value of any
+ * existing entry with the same key.
  *
  * \param dict              The dictionary to which this entry is added.
- * \param alloc             The allocator to use for this operation.
- * \param key               The key for this entry.
+ * \param key               The key for this entry. This string must outlive
+ *                          the dictionary.
  * \param value             The UUID value for this entry.
  *
  * \returns a status code indicating success or failure.
@@ -25,48 +24,95 @@ RCPR_IMPORT_resource;
  *      - a non-zero error code on failure.
  */
 status endorse_uuid_dictionary_add(
-    RCPR_SYM(rbtree)* dict, RCPR_SYM(allocator)* alloc, const char* key,
+    endorse_uuid_dictionary* dict, const char* key,
     const RCPR_SYM(rcpr_uuid)* value)
 {
-    status retval, release_retval;
-    endorse_uuid_dictionary_entry* tmp;
+    status retval;
+    uint64_t hash = endorse_uuid_dictionary_hash(key);
+    endorse_uuid_dictionary_entry* slot;
+    size_t mask;
 
-    /* allocate memory for this entry. */
-    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
-    if (STATUS_SUCCESS != retval)
+    /* an existing entry only needs its value replaced. */
+    mask = dict->capacity - 1;
+    for (size_t i = hash & mask; NULL != dict->slots[i].key; i = (i + 1) & mask)
     {
-        goto done;
+        slot = &dict->slots[i];
+        if (slot->hash == hash && !strcmp(slot->key, key))
+        {
+            goto set_value;
+        }
     }
 
-    /* clear memory. */
-    memset(tmp, 0, sizeof(*tmp));
+    /* grow the table if adding this entry would make it more than half full. */
+    if (2 * (dict->count + 1) > dict->capacity)
+    {
+        endorse_uuid_dictionary_entry* old_slots = dict->slots;
+        size_t old_capacity = dict->capacity;
+        endorse_uuid_dictionary_entry* new_slots;
+        size_t new_capacity = 2 * old_capacity;
+
+        /* allocate the new slots. */
+        retval =
+            rcpr_allocator_allocate(
+                dict->alloc, (void**)&new_slots,
+                new_capacity * sizeof(*new_slots));
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+
+        /* rehash every occupied slot into the new table. */
+        memset(new_slots, 0, new_capacity * sizeof(*new_slots));
+        mask = new_capacity - 1;
+        for (size_t i = 0; i < old_capacity; ++i)
+        {
+            if (NULL != old_slots[i].key)
+            {
+                size_t j = old_slots[i].hash & mask;
+                while (NULL != new_slots[j].key)
+                {
+                    j = (j + 1) & mask;
+                }
+
+                new_slots[j] = old_slots[i];
+            }
+        }
 
-    /* initialize resource. */
-    resource_init(&tmp->hdr, &endorse_uuid_dictionary_entry_resource_release);
+        /* swap in the new table. */
+        dict->slots = new_slots;
+        dict->capacity = new_capacity;
 
-    /* set values. */
-    tmp->alloc = alloc;
-    tmp->key = strdup(key);
-    memcpy(&tmp->value, value, sizeof(tmp->value));
+        /* reclaim the old slots. */
+        retval = rcpr_allocator_reclaim(dict->alloc, old_slots);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+    }
 
-    /* attempt to insert this entry into the dictionary. */
-    retval = rbtree_insert(dict, &tmp->hdr);
-    if (STATUS_SUCCESS != retval)
+    /* the key is not in the table, so probe for an empty slot. */
+    mask = dict->capacity - 1;
+    for (size_t i = hash & mask; ; i = (i + 1) & mask)
     {
-        goto cleanup_entry;
+        slot = &dict->slots[i];
+
+        if (NULL == slot->key)
+        {
+            slot->key = key;
+            slot->hash = hash;
+            ++dict->count;
+            break;
+        }
     }
 
+set_value:
+    /* set the value. */
+    memcpy(&slot->value, value, sizeof(slot->value));
+
     /* success. */
     retval = STATUS_SUCCESS;
     goto done;
 
-cleanup_entry:
-    release_retval = resource_release(&tmp->hdr);
-    if (STATUS_SUCCESS != release_retval)
-    {
-        retval = release_retval;
-    }
-
 done:
     return retval;
 }
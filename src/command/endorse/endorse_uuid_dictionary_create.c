@@ -0,0 +1,83 @@
+/**
+ * \file command/endorse/endorse_uuid_dictionary_create.c
+ *
+ * \brief Create an empty uuid dictionary.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create an empty uuid dictionary.
+ *
+ * \param dict              Pointer to receive the dictionary on success.
+ * \param alloc             The allocator to use for this operation.
+ * \param expected_count    The number of entries expected, used to size the
+ *                          table so that it doesn't need to grow.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_uuid_dictionary_create(
+    endorse_uuid_dictionary** dict, RCPR_SYM(allocator)* alloc,
+    size_t expected_count)
+{
+    status retval, release_retval;
+    endorse_uuid_dictionary* tmp;
+    size_t capacity = 16;
+
+    /* keep the table at most half full. */
+    while (capacity < 2 * expected_count)
+    {
+        capacity *= 2;
+    }
+
+    /* allocate memory for the dictionary. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &endorse_uuid_dictionary_resource_release);
+
+    /* set values. */
+    tmp->alloc = alloc;
+    tmp->capacity = capacity;
+
+    /* allocate the slots. */
+    retval =
+        rcpr_allocator_allocate(
+            alloc, (void**)&tmp->slots, capacity * sizeof(*tmp->slots));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_dict;
+    }
+
+    /* all slots start empty. */
+    memset(tmp->slots, 0, capacity * sizeof(*tmp->slots));
+
+    /* success. */
+    *dict = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_dict:
+    release_retval = resource_release(&tmp->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
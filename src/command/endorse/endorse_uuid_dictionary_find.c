@@ -0,0 +1,42 @@
+/**
+ * \file command/endorse/endorse_uuid_dictionary_find.c
+ *
+ * \brief Look up a key in the uuid dictionary.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_uuid;
+
+/**
+ * \brief Look up a key in the uuid dictionary.
+ *
+ * \param dict              The dictionary to search.
+ * \param key               The key to find.
+ *
+ * \returns the UUID for this key, or NULL if the key is not found.
+ */
+const RCPR_SYM(rcpr_uuid)* endorse_uuid_dictionary_find(
+    const endorse_uuid_dictionary* dict, const char* key)
+{
+    uint64_t hash = endorse_uuid_dictionary_hash(key);
+    size_t mask = dict->capacity - 1;
+
+    /* probe until the key or an empty slot is found. */
+    for (size_t i = hash & mask; ; i = (i + 1) & mask)
+    {
+        const endorse_uuid_dictionary_entry* slot = &dict->slots[i];
+
+        if (NULL == slot->key)
+        {
+            return NULL;
+        }
+
+        if (slot->hash == hash && !strcmp(slot->key, key))
+        {
+            return &slot->value;
+        }
+    }
+}
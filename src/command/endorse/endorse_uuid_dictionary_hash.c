@@ -0,0 +1,21 @@
+/**
+ * \file command/endorse/endorse_uuid_dictionary_hash.c
+ *
+ * \brief Hash a uuid dictionary key.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Hash a uuid dictionary key.
+ *
+ * \param key               The key to hash.
+ *
+ * \returns the 64-bit FNV-1a hash of the key.
+ */
+uint64_t endorse_uuid_dictionary_hash(const char* key)
+{
+    return endorse_hash(key, strlen(key));
+}
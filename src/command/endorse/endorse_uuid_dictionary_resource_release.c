@@ -0,0 +1,53 @@
+/**
+ * \file command/endorse/endorse_uuid_dictionary_resource_release.c
+ *
+ * \brief Release a uuid dictionary.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Release a uuid dictionary.
+ *
+ * \param r                 The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_uuid_dictionary_resource_release(RCPR_SYM(resource)* r)
+{
+    status slots_retval = STATUS_SUCCESS;
+    status reclaim_retval;
+    endorse_uuid_dictionary* dict = (endorse_uuid_dictionary*)r;
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = dict->alloc;
+
+    /* reclaim the slots if set. */
+    if (NULL != dict->slots)
+    {
+        slots_retval = rcpr_allocator_reclaim(alloc, dict->slots);
+    }
+
+    /* clear memory. */
+    memset(dict, 0, sizeof(*dict));
+
+    /* reclaim the dictionary. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, dict);
+
+    /* decode return status. */
+    if (STATUS_SUCCESS != slots_retval)
+    {
+        return slots_retval;
+    }
+    else
+    {
+        return reclaim_retval;
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * \file command/endorse/endorse_watch_add_watches.c
+ *
+ * \brief Watch the directory of each endorse config file for changes.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#ifdef __linux__
+
+#include <sys/inotify.h>
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Watch the directory of each endorse config file for changes.
+ *
+ * \param watch             The watch state, which receives the inotify file
+ *                          descriptor and one watch descriptor per file.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_watch_add_watches(endorse_watch* watch)
+{
+    status retval;
+    const root_command* root = watch->root;
+    char* dirname;
+    const char* slash;
+
+    /* create the inotify instance. */
+    watch->inotify_fd = inotify_init1(IN_CLOEXEC);
+    if (watch->inotify_fd < 0)
+    {
+        fprintf(stderr, "Could not create an inotify instance.\n");
+        retval = VCTOOL_ERROR_FILE_IO;
+        goto done;
+    }
+
+    /* allocate a watch descriptor for each config file. */
+    watch->watch_descriptors =
+        (int*)calloc(root->endorse_config_filename_count, sizeof(int));
+    if (NULL == watch->watch_descriptors)
+    {
+        fprintf(stderr, "Out of memory.\n");
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_inotify_fd;
+    }
+
+    for (size_t i = 0; i < root->endorse_config_filename_count; ++i)
+    {
+        const char* filename = root->endorse_config_filenames[i];
+
+        /* watch the directory holding this file. */
+        slash = strrchr(filename, '/');
+        if (NULL == slash)
+        {
+            dirname = strdup(".");
+        }
+        else
+        {
+            dirname =
+                strndup(filename, (slash == filename) ? 1 : slash - filename);
+        }
+
+        if (NULL == dirname)
+        {
+            fprintf(stderr, "Out of memory.\n");
+            retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+            goto cleanup_watch_descriptors;
+        }
+
+        /* a save either closes a written file or moves a new one in place. */
+        watch->watch_descriptors[i] =
+            inotify_add_watch(
+                watch->inotify_fd, dirname,
+                IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        free(dirname);
+        if (watch->watch_descriptors[i] < 0)
+        {
+            fprintf(stderr, "Could not watch %s.\n", filename);
+            retval = VCTOOL_ERROR_FILE_IO;
+            goto cleanup_watch_descriptors;
+        }
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_watch_descriptors:
+    free(watch->watch_descriptors);
+    watch->watch_descriptors = NULL;
+
+cleanup_inotify_fd:
+    file_close(watch->opts->file, watch->inotify_fd);
+    watch->inotify_fd = -1;
+
+done:
+    return retval;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,172 @@
+/**
+ * \file command/endorse/endorse_watch_command_func.c
+ *
+ * \brief Entry point for the endorse-watch command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <signal.h>
+#include <vctool/command/endorse_watch.h>
+
+#include "endorse_internal.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+RCPR_IMPORT_resource;
+
+#ifdef __linux__
+/* forward decls. */
+static void endorse_watch_signal_handler(int sig);
+
+/** \brief Set by the signal handler when the command is asked to stop. */
+static volatile sig_atomic_t endorse_watch_stop = 0;
+#endif
+
+/**
+ * \brief Execute the endorse-watch command.
+ *
+ * The endorse config files are watched for changes until the command is
+ * interrupted. Each change is validated incrementally, and each valid config is
+ * compiled to the cache used by the endorse command.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int endorse_watch_command_func(commandline_opts* opts)
+{
+#ifdef __linux__
+    status retval, release_retval;
+    endorse_watch watch;
+    struct sigaction action;
+    char events[4096]
+        __attribute__((aligned(__alignof__(struct inotify_event))));
+    size_t size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* get endorse-watch and root command. */
+    endorse_watch_command* cmd = (endorse_watch_command*)opts->cmd;
+    MODEL_ASSERT(NULL != cmd);
+    root_command* root = (root_command*)cmd->hdr.next;
+    MODEL_ASSERT(NULL != root);
+
+    /* there must be at least one endorse config file. */
+    if (0 == root->endorse_config_filename_count)
+    {
+        fprintf(
+            stderr,
+            "Expecting an endorse config filename (-E endorse.cfg).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+
+    memset(&watch, 0, sizeof(watch));
+    watch.opts = opts;
+    watch.root = root;
+
+    /* create the incremental config. */
+    TRY_OR_FAIL(endorse_incremental_create(&watch.inc, root->alloc), done);
+
+    /* watch the config files. */
+    TRY_OR_FAIL(endorse_watch_add_watches(&watch), cleanup_inc);
+
+    /* stop on SIGINT or SIGTERM, so cleanup runs. The handler is installed
+     * without SA_RESTART, so it also interrupts the read below. */
+    endorse_watch_stop = 0;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = &endorse_watch_signal_handler;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    /* validate the current config; errors are reported and not fatal. */
+    retval = endorse_watch_update(&watch);
+    if (
+        STATUS_SUCCESS != retval
+     && VCTOOL_ERROR_ENDORSE_INVALID_CONFIG != retval)
+    {
+        goto cleanup_watches;
+    }
+
+    if (root->verbose)
+    {
+        printf("Watching endorse config for changes.\n");
+    }
+
+    while (!endorse_watch_stop)
+    {
+        retval =
+            file_read(
+                opts->file, watch.inotify_fd, events, sizeof(events), &size);
+        if (VCTOOL_ERROR_FILE_INTERRUPT == retval)
+        {
+            /* the loop condition checks whether we were asked to stop. */
+            continue;
+        }
+        else if (STATUS_SUCCESS != retval)
+        {
+            fprintf(stderr, "Error reading inotify events.\n");
+            goto cleanup_watches;
+        }
+
+        if (!endorse_watch_is_relevant(&watch, events, size))
+        {
+            continue;
+        }
+
+        /* a config being edited may be briefly invalid or missing. */
+        retval = endorse_watch_update(&watch);
+        if (
+            STATUS_SUCCESS != retval
+         && VCTOOL_ERROR_ENDORSE_INVALID_CONFIG != retval
+         && VCTOOL_ERROR_FILE_NO_ENTRY != retval
+         && VCTOOL_ERROR_FILE_IO != retval)
+        {
+            goto cleanup_watches;
+        }
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_watches;
+
+cleanup_watches:
+    release_retval = file_close(opts->file, watch.inotify_fd);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    free(watch.watch_descriptors);
+
+cleanup_inc:
+    CLEANUP_OR_CASCADE(endorse_incremental_resource_handle(watch.inc));
+
+done:
+    return retval;
+#else
+    (void)opts;
+
+    fprintf(stderr, "endorse-watch is only supported on Linux.\n");
+    return VCTOOL_ERROR_FILE_NOT_SUPPORTED;
+#endif
+}
+
+#ifdef __linux__
+/**
+ * \brief Ask the watch loop to stop.
+ *
+ * \param sig           The signal.
+ */
+static void endorse_watch_signal_handler(int UNUSED(sig))
+{
+    endorse_watch_stop = 1;
+}
+#endif
@@ -0,0 +1,52 @@
+/**
+ * \file command/endorse/endorse_watch_command_init.c
+ *
+ * \brief Initialize an endorse-watch command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/endorse_watch.h>
+#include <vctool/command/root.h>
+#include <vctool/status_codes.h>
+#include <vpr/parameters.h>
+
+/* forward decls. */
+static void endorse_watch_command_dispose(void* disp);
+
+/**
+ * \brief Initialize an endorse-watch command structure.
+ *
+ * \param watch         The endorse-watch command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int endorse_watch_command_init(endorse_watch_command* watch)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != watch);
+
+    /* clear endorse-watch command structure. */
+    memset(watch, 0, sizeof(endorse_watch_command));
+
+    /* set disposer, func, etc. */
+    watch->hdr.hdr.dispose = &endorse_watch_command_dispose;
+    watch->hdr.func = &endorse_watch_command_func;
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Dispose of an endorse_watch_command structure.
+ *
+ * \param disp          The endorse_watch_command structure to dispose.
+ */
+static void endorse_watch_command_dispose(void* UNUSED(disp))
+{
+    /* do nothing. */
+}
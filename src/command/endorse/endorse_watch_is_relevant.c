@@ -0,0 +1,71 @@
+/**
+ * \file command/endorse/endorse_watch_is_relevant.c
+ *
+ * \brief Check whether a buffer of inotify events names any config file.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#ifdef __linux__
+
+#include <sys/inotify.h>
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Return true if a buffer of inotify events names any config file.
+ *
+ * If the inotify queue overflowed, events may have been lost, so this is also
+ * true.
+ *
+ * \param watch             The watch state.
+ * \param events            The events read from the inotify file descriptor.
+ * \param size              The size of the events.
+ *
+ * \returns true if a config file changed and false otherwise.
+ */
+bool endorse_watch_is_relevant(
+    const endorse_watch* watch, const void* events, size_t size)
+{
+    const root_command* root = watch->root;
+    const uint8_t* ptr = (const uint8_t*)events;
+    const uint8_t* end = ptr + size;
+    const struct inotify_event* event;
+    const char* basename;
+
+    while (ptr + sizeof(struct inotify_event) <= end)
+    {
+        event = (const struct inotify_event*)ptr;
+        ptr += sizeof(struct inotify_event) + event->len;
+
+        /* after an overflow, any config file may have changed. */
+        if (event->mask & IN_Q_OVERFLOW)
+        {
+            return true;
+        }
+
+        /* events on the directory itself have no name. */
+        if (0 == event->len)
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < root->endorse_config_filename_count; ++i)
+        {
+            basename = strrchr(root->endorse_config_filenames[i], '/');
+            basename =
+                (NULL == basename)
+                    ? root->endorse_config_filenames[i] : basename + 1;
+
+            if (event->wd == watch->watch_descriptors[i]
+             && !strcmp(event->name, basename))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,140 @@
+/**
+ * \file command/endorse/endorse_watch_update.c
+ *
+ * \brief Validate the endorse config files incrementally.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <time.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Validate the endorse config files incrementally, and compile a valid
+ * config to the cache used by the endorse command.
+ *
+ * Errors and timing are reported for each update. If the config has errors,
+ * the last good config is kept.
+ *
+ * \param watch             The watch state.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_INVALID_CONFIG if the config has errors.
+ *      - a non-zero error code on failure.
+ */
+status endorse_watch_update(endorse_watch* watch)
+{
+    status retval, release_retval;
+    const root_command* root = watch->root;
+    endorse_config_source* sources;
+    size_t source_count;
+    endorse_incremental_stats stats;
+    struct timespec start, end;
+    double elapsed_ms;
+    uint8_t digest[ENDORSE_COMPILED_DIGEST_SIZE];
+    endorse_compiled* compiled;
+    char* cache_filename;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    /* map every endorse config file. */
+    TRY_OR_FAIL(
+        endorse_map_endorse_config_files(
+            &sources, &source_count, watch->opts->file, root),
+        done);
+
+    /* the sources stay mapped until the commit has read them. */
+    for (size_t i = 0; i < source_count; ++i)
+    {
+        TRY_OR_FAIL(
+            endorse_incremental_add_source(
+                watch->inc, sources[i].data, sources[i].size),
+            cleanup_sources);
+    }
+
+    /* only the changed entities are parsed and analyzed again. */
+    retval = endorse_incremental_commit(watch->inc, &stats);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    elapsed_ms =
+        (end.tv_sec - start.tv_sec) * 1000.0
+      + (end.tv_nsec - start.tv_nsec) / 1000000.0;
+    if (VCTOOL_ERROR_ENDORSE_INVALID_CONFIG == retval)
+    {
+        for (size_t i = 0;
+             i < endorse_incremental_get_error_message_count(watch->inc); ++i)
+        {
+            fprintf(
+                stderr, "%s\n",
+                endorse_incremental_get_error_message(watch->inc, i));
+        }
+
+        fprintf(
+            stderr,
+            "Endorse config has errors (%.3f ms); keeping the last good "
+            "config.\n", elapsed_ms);
+        goto cleanup_sources;
+    }
+    else if (STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error updating endorse config.\n");
+        goto cleanup_sources;
+    }
+
+    printf(
+        "Endorse config OK in %.3f ms: %zu of %zu blocks changed, "
+        "%zu of %zu entities analyzed.\n",
+        elapsed_ms, stats.blocks_changed, stats.block_count,
+        stats.entities_analyzed, stats.entity_count);
+
+    /* use the same digest as the endorse command, so it can use this cache. */
+    TRY_OR_FAIL(
+        endorse_config_digest(
+            digest, watch->opts->suite, sources, source_count),
+        cleanup_sources);
+
+    /* compile the last good config. */
+    TRY_OR_FAIL(
+        endorse_incremental_compile(
+            &compiled, root->alloc, watch->inc, digest),
+        cleanup_sources);
+
+    /* the cache is named after the first config file. */
+    TRY_OR_FAIL(
+        endorse_compiled_cache_filename(&cache_filename, sources[0].filename),
+        cleanup_compiled);
+
+    /* an unwritable directory just means no cache. */
+    release_retval =
+        endorse_compiled_write(watch->opts->file, compiled, cache_filename);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        fprintf(
+            stderr, "Could not write compiled endorse config %s.\n",
+            cache_filename);
+    }
+    else if (root->verbose)
+    {
+        printf("Wrote compiled endorse config %s.\n", cache_filename);
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_cache_filename;
+
+cleanup_cache_filename:
+    free(cache_filename);
+
+cleanup_compiled:
+    CLEANUP_OR_CASCADE(&compiled->hdr);
+
+cleanup_sources:
+    endorse_unmap_endorse_config_files(
+        watch->opts->file, sources, source_count);
+
+done:
+    return retval;
+}
@@ -1,62 +1,87 @@
 /**
  * \file command/endorse/endorse_working_set_add_capabilities.c
  *
- * \brief Decode and add the capabilities represented by the given moiety.
+ * \brief Add the capabilities granted in a grant table to the working set.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include "endorse_internal.h"
 
-RCPR_IMPORT_rbtree;
-RCPR_IMPORT_resource;
+RCPR_IMPORT_uuid;
 
 /**
- * \brief Decode and add the capabilities represented by the given moiety.
+ * \brief Add a capability to the working set for every verb granted in the
+ * grant table.
+ *
+ * The working set is first grown by the population count of the grant table,
+ * and then each set bit is emitted in a single linear pass.
  *
  * \param set               The current working set.
- * \param alloc             The allocator to use for this operation.
- * \param entity            The entity to use for this operation.
- * \param entity_id         The ID of this entity.
- * \param moiety            The moiety to decode.
+ * \param table             The grant table.
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
  *      - a non-zero error code on failure.
  */
 status endorse_working_set_add_capabilities(
-    RCPR_SYM(rbtree)* set, RCPR_SYM(allocator)* alloc, endorse_entity* entity,
-    const RCPR_SYM(rcpr_uuid)* entity_id, const char* moiety)
+    endorse_working_set* set, const endorse_grant_table* table)
 {
     status retval;
-    endorse_role* role;
-    endorse_verb* verb;
+    const endorse_compiled* compiled = table->compiled;
+    size_t entity_count = compiled->header->entity_count;
+    size_t grant_count = 0;
 
-    /* check the roles tree for the moiety. */
-    retval = rbtree_find((resource**)&role, entity->roles, moiety);
-    if (STATUS_SUCCESS == retval)
+    /* count the granted verbs. */
+    for (size_t i = 0; i < entity_count; ++i)
     {
-        /* add all roles associated with this verb to the working set. */
-        retval =
-            endorse_working_set_add_role_capabilities(
-                set, alloc, entity_id, role);
-        goto done;
+        const uint64_t* words = table->words + table->word_offsets[i];
+        size_t word_count =
+            endorse_compiled_entity_word_count(&compiled->entities[i]);
+
+        for (size_t word = 0; word < word_count; ++word)
+        {
+            grant_count += (size_t)__builtin_popcountll(words[word]);
+        }
     }
 
-    /* check the verbs tree for the moiety. */
-    retval = rbtree_find((resource**)&verb, entity->verbs, moiety);
-    if (STATUS_SUCCESS == retval)
+    /* reserve space for every granted verb at once. */
+    retval = endorse_working_set_reserve(set, set->count + grant_count);
+    if (STATUS_SUCCESS != retval)
     {
-        /* add this verb to the working set. */
-        retval =
-            endorse_working_set_add_verb_capability(
-                set, alloc, entity_id, verb);
         goto done;
     }
 
-    /* if we've made it here, then the moiety is unknown. */
-    fprintf(stderr, "Unknown role or verb %s:%s.\n", entity->id, moiety);
-    retval = VCTOOL_ERROR_ENDORSE_UNKNOWN_ROLE_OR_VERB;
+    /* add each granted verb. */
+    for (size_t i = 0; i < entity_count; ++i)
+    {
+        const endorse_compiled_entity* entity = &compiled->entities[i];
+        const endorse_compiled_verb* verbs =
+            compiled->verbs + entity->verb_offset;
+        const uint64_t* words = table->words + table->word_offsets[i];
+        size_t word_count = endorse_compiled_entity_word_count(entity);
+
+        for (size_t word = 0; word < word_count; ++word)
+        {
+            uint64_t bits = words[word];
+            while (0 != bits)
+            {
+                size_t index = word * 64 + (size_t)__builtin_ctzll(bits);
+                bits &= bits - 1;
+
+                retval =
+                    endorse_working_set_add_verb_capability(
+                        set, table->entity_ids[i], &verbs[index].verb_id);
+                if (STATUS_SUCCESS != retval)
+                {
+                    goto done;
+                }
+            }
+        }
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
     goto done;
 
 done:
@@ -0,0 +1,53 @@
+/**
+ * \file command/endorse/endorse_working_set_create.c
+ *
+ * \brief Create an empty working set.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create an empty working set.
+ *
+ * \param set               Pointer to receive the working set on success.
+ * \param alloc             The allocator to use for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_working_set_create(
+    endorse_working_set** set, RCPR_SYM(allocator)* alloc)
+{
+    status retval;
+    endorse_working_set* tmp;
+
+    /* allocate memory for the working set. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &endorse_working_set_resource_release);
+
+    /* set values. */
+    tmp->alloc = alloc;
+
+    /* success. */
+    *set = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+done:
+    return retval;
+}
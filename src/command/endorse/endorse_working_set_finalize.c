@@ -0,0 +1,85 @@
+/**
+ * \file command/endorse/endorse_working_set_finalize.c
+ *
+ * \brief Sort the working set and remove duplicate keys.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <stdlib.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Sort the working set and remove duplicate keys.
+ *
+ * Small sets are sorted with qsort. Sets with at least
+ * \ref ENDORSE_WORKING_SET_RADIX_THRESHOLD keys are radix sorted, which avoids
+ * a full key comparison per step.
+ *
+ * \param set               The working set to finalize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_working_set_finalize(endorse_working_set* set)
+{
+    status retval;
+    endorse_working_set_key* scratch;
+    size_t out;
+
+    /* sort the keys. */
+    if (set->count >= ENDORSE_WORKING_SET_RADIX_THRESHOLD)
+    {
+        retval =
+            rcpr_allocator_allocate(
+                set->alloc, (void**)&scratch,
+                set->count * sizeof(endorse_working_set_key));
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+
+        endorse_working_set_radix_sort(set->keys, scratch, set->count);
+
+        retval = rcpr_allocator_reclaim(set->alloc, scratch);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+    }
+    else if (set->count > 1)
+    {
+        qsort(
+            set->keys, set->count, sizeof(endorse_working_set_key),
+            &endorse_working_set_compare);
+    }
+
+    /* remove adjacent duplicates. */
+    out = 0;
+    for (size_t i = 0; i < set->count; ++i)
+    {
+        if (0 == out
+         || 0 != endorse_working_set_compare(&set->keys[out - 1], &set->keys[i]))
+        {
+            if (out != i)
+            {
+                set->keys[out] = set->keys[i];
+            }
+
+            ++out;
+        }
+    }
+
+    set->count = out;
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto done;
+
+done:
+    return retval;
+}
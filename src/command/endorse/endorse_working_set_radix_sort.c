@@ -0,0 +1,91 @@
+/**
+ * \file command/endorse/endorse_working_set_radix_sort.c
+ *
+ * \brief Radix sort an array of working set keys.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Sort an array of working set keys using an LSD radix sort on the key
+ * bytes. Byte positions that are the same for every key are skipped.
+ *
+ * The resulting order matches \ref endorse_working_set_compare.
+ *
+ * \param keys              The keys to sort.
+ * \param scratch           Scratch space for at least \p count keys.
+ * \param count             The number of keys.
+ */
+void endorse_working_set_radix_sort(
+    endorse_working_set_key* keys, endorse_working_set_key* scratch,
+    size_t count)
+{
+    uint8_t varies[sizeof(endorse_working_set_key)];
+    size_t offsets[256];
+    endorse_working_set_key* src = keys;
+    endorse_working_set_key* dst = scratch;
+    endorse_working_set_key* tmp;
+
+    if (count < 2)
+    {
+        return;
+    }
+
+    /* find the byte positions that differ from the first key. */
+    memset(varies, 0, sizeof(varies));
+    for (size_t i = 1; i < count; ++i)
+    {
+        const uint8_t* first = (const uint8_t*)&keys[0];
+        const uint8_t* key = (const uint8_t*)&keys[i];
+
+        for (size_t b = 0; b < sizeof(varies); ++b)
+        {
+            varies[b] |= first[b] ^ key[b];
+        }
+    }
+
+    /* sort from the least significant byte to the most significant byte. */
+    for (size_t b = sizeof(varies); b-- > 0; )
+    {
+        /* skip byte positions that are the same for every key. */
+        if (0 == varies[b])
+        {
+            continue;
+        }
+
+        /* count the keys in each bucket. */
+        memset(offsets, 0, sizeof(offsets));
+        for (size_t i = 0; i < count; ++i)
+        {
+            offsets[((const uint8_t*)&src[i])[b]] += 1;
+        }
+
+        /* convert the counts to starting offsets. */
+        size_t total = 0;
+        for (size_t j = 0; j < 256; ++j)
+        {
+            size_t bucket = offsets[j];
+            offsets[j] = total;
+            total += bucket;
+        }
+
+        /* stable scatter into the destination. */
+        for (size_t i = 0; i < count; ++i)
+        {
+            dst[offsets[((const uint8_t*)&src[i])[b]]++] = src[i];
+        }
+
+        /* the destination becomes the source for the next pass. */
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    /* copy the sorted keys back if they ended up in the scratch space. */
+    if (src != keys)
+    {
+        memcpy(keys, src, count * sizeof(endorse_working_set_key));
+    }
+}
@@ -0,0 +1,63 @@
+/**
+ * \file command/endorse/endorse_working_set_reserve.c
+ *
+ * \brief Reserve space for keys in the working set.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Reserve space for at least the given number of keys in the working
+ * set, so that adding this many keys does not reallocate the keys array.
+ *
+ * \param set               The working set.
+ * \param capacity          The number of keys to reserve.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_working_set_reserve(endorse_working_set* set, size_t capacity)
+{
+    status retval;
+    void* keys = set->keys;
+
+    /* there is nothing to do if the set is already large enough. */
+    if (capacity <= set->capacity)
+    {
+        retval = STATUS_SUCCESS;
+        goto done;
+    }
+
+    /* allocate or grow the keys array. */
+    if (NULL == keys)
+    {
+        retval =
+            rcpr_allocator_allocate(
+                set->alloc, &keys, capacity * sizeof(endorse_working_set_key));
+    }
+    else
+    {
+        retval =
+            rcpr_allocator_reallocate(
+                set->alloc, &keys, capacity * sizeof(endorse_working_set_key));
+    }
+
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* success. */
+    set->keys = (endorse_working_set_key*)keys;
+    set->capacity = capacity;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+done:
+    return retval;
+}
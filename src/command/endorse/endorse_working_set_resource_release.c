@@ -0,0 +1,53 @@
+/**
+ * \file command/endorse/endorse_working_set_resource_release.c
+ *
+ * \brief Release a working set.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Release a working set.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_working_set_resource_release(RCPR_SYM(resource)* r)
+{
+    status keys_retval = STATUS_SUCCESS;
+    status reclaim_retval;
+    endorse_working_set* set = (endorse_working_set*)r;
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = set->alloc;
+
+    /* reclaim the keys array if set. */
+    if (NULL != set->keys)
+    {
+        keys_retval = rcpr_allocator_reclaim(alloc, set->keys);
+    }
+
+    /* clear memory. */
+    memset(set, 0, sizeof(*set));
+
+    /* reclaim the working set. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, set);
+
+    /* decode return status. */
+    if (STATUS_SUCCESS != keys_retval)
+    {
+        return keys_retval;
+    }
+    else
+    {
+        return reclaim_retval;
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ * \file command/endorse/process_endorse_check_command.c
+ *
+ * \brief Process command-line options to build an endorse-check command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/endorse_check.h>
+#include <vctool/command/root.h>
+#include <vctool/commandline.h>
+#include <vctool/status_codes.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Process the endorse-check command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_endorse_check_command(
+    commandline_opts* opts, int UNUSED(argc), char* UNUSED(argv[]))
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* allocate memory for an endorse_check_command structure. */
+    endorse_check_command* check =
+        (endorse_check_command*)malloc(sizeof(endorse_check_command));
+    if (NULL == check)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* initialize the structure. */
+    retval = endorse_check_command_init(check);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto free_check;
+    }
+
+    /* set endorse-check command as the head of opts command. */
+    check->hdr.next = opts->cmd;
+    opts->cmd = &check->hdr;
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto done;
+
+free_check:
+    free(check);
+
+done:
+    return retval;
+}
@@ -27,7 +27,7 @@
  *      - a non-zero error code on failure.
  */
 int process_endorse_command(
-    commandline_opts* opts, int UNUSED(argc), char* UNUSED(argv[]))
+    commandline_opts* opts, int argc, char* argv[])
 {
     int retval;
 
@@ -50,6 +50,10 @@ int process_endorse_command(
         goto free_endorse;
     }
 
+    /* any remaining arguments are additional input certificates. */
+    endorse->input_filenames = argv;
+    endorse->input_filename_count = argc > 0 ? (size_t)argc : 0U;
+
     /* set keygen command as the head of opts command. */
     endorse->hdr.next = opts->cmd;
     opts->cmd = &endorse->hdr;
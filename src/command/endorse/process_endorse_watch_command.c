@@ -0,0 +1,66 @@
+/**
+ * \file command/endorse/process_endorse_watch_command.c
+ *
+ * \brief Process command-line options to build an endorse-watch command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/endorse_watch.h>
+#include <vctool/command/root.h>
+#include <vctool/commandline.h>
+#include <vctool/status_codes.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Process the endorse-watch command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_endorse_watch_command(
+    commandline_opts* opts, int UNUSED(argc), char* UNUSED(argv[]))
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* allocate memory for an endorse_watch_command structure. */
+    endorse_watch_command* watch =
+        (endorse_watch_command*)malloc(sizeof(endorse_watch_command));
+    if (NULL == watch)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* initialize the structure. */
+    retval = endorse_watch_command_init(watch);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto free_watch;
+    }
+
+    /* set endorse-watch command as the head of opts command. */
+    watch->hdr.next = opts->cmd;
+    opts->cmd = &watch->hdr;
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto done;
+
+free_watch:
+    free(watch);
+
+done:
+    return retval;
+}
@@ -3,7 +3,7 @@
  *
  * \brief Print the help menu.
  *
- * \copyright 2020 Velo Payments.  See License.txt for license terms.
+ * \copyright 2020-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include <vctool/command/help.h>
@@ -18,15 +18,43 @@ void help_print(FILE* out)
     fprintf(out, "Usage: vctool [options] command [command-options]\n\n");
 
     fprintf(out, "Options:\n");
-    fprintf(out, "   %-12s Print this help menu.\n", "-h / -?");
-    fprintf(out, "   %-12s Set output filename.\n", "-o file");
-    fprintf(out, "   %-12s Number of key derivation rounds.\n", "-R num");
-    fprintf(out, "   %-12s The private keypair file.\n", "-k file");
-    fprintf(out, "   %-12s Non-Interative mode.\n", "-N");
+    fprintf(out, "   %-14s Print this help menu.\n", "-h / -?");
+    fprintf(out, "   %-14s Set output filename.\n", "-o file");
+    fprintf(out, "   %-14s Number of key derivation rounds.\n", "-R num");
+    fprintf(out, "   %-14s The private keypair file.\n", "-k file");
+    fprintf(out, "   %-14s Set input file, directory, or manifest.\n",
+           "-i path");
+    fprintf(out, "   %-14s Add an endorse config file.\n", "-E file");
+    fprintf(out, "   %-14s Output or manifest format: human, jsonl, or csv.\n",
+           "-F format");
+    fprintf(out, "   %-14s Non-Interative mode.\n", "-N");
     fprintf(out, "\n");
     fprintf(out, "Commands:\n");
-    fprintf(out, "   %-12s Print this help menu.\n", "help");
-    fprintf(out, "   %-12s Generate a keypair certificate file.\n", "keygen");
-    fprintf(out, "   %-12s Create a pubkey certificate from a keypair.\n",
+    fprintf(out, "   %-14s Print this help menu.\n", "help");
+    fprintf(out, "   %-14s Generate a keypair certificate file.\n", "keygen");
+    fprintf(out, "   %-14s Create pubkey certificates from keypairs.\n",
            "pubkey");
+    fprintf(out, "   %-14s Endorse one or more pubkey certificates.\n",
+           "endorse");
+    fprintf(out, "   %-14s Check endorse configs without endorsing.\n",
+           "endorse-check");
+    fprintf(out, "   %-14s Validate endorse config edits incrementally.\n",
+           "endorse-watch");
+    fprintf(out, "   %-14s Query an artifact history from an agent.\n",
+           "history");
+    fprintf(out, "   %-14s Serve a block directory to agent clients.\n",
+           "mock-agent");
+    fprintf(out, "   %-14s Restore blocks from a backup file.\n",
+           "restore");
+    fprintf(out, "   %-14s Create a signed root block.\n", "rootblock");
+    fprintf(out, "   %-14s Show certificate fields.\n", "show");
+    fprintf(out, "   %-14s Submit signed transactions to an agent.\n",
+           "submit");
+    fprintf(out, "   %-14s Download blocks from an agent.\n", "sync");
+    fprintf(out, "   %-14s Build and sign transactions from a manifest.\n",
+           "txn");
+    fprintf(out, "   %-14s Verify certificate signatures.\n",
+           "verify-cert");
+    fprintf(out, "   %-14s Verify block signatures and chain linkage.\n",
+           "verify-chain");
 }
@@ -0,0 +1,60 @@
+/**
+ * \file command/history/history_cache_path.c
+ *
+ * \brief Build the cache path of a transaction.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "history_internal.h"
+
+/**
+ * \brief Build the cache path of a transaction.
+ *
+ * Transactions are sharded by the first byte of their id, as
+ * <cache>/<xx>/<transaction uuid>.txn, so that no directory grows too large.
+ *
+ * \param path              The buffer to receive the path.
+ * \param path_size         The size of the buffer.
+ * \param cache_dir         The cache directory.
+ * \param id                The transaction id.
+ * \param shard_only        If true, only the shard directory is built.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER if the path is too long.
+ */
+int history_cache_path(
+    char* path, size_t path_size, const char* cache_dir, const uint8_t* id,
+    bool shard_only)
+{
+    int length;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != path);
+    MODEL_ASSERT(NULL != cache_dir);
+    MODEL_ASSERT(NULL != id);
+
+    if (shard_only)
+    {
+        length = snprintf(path, path_size, "%s/%02x", cache_dir, id[0]);
+    }
+    else
+    {
+        length =
+            snprintf(
+                path, path_size,
+                "%s/%02x/%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-"
+                "%02x%02x%02x%02x%02x%02x.txn",
+                cache_dir, id[0], id[0], id[1], id[2], id[3], id[4], id[5],
+                id[6], id[7], id[8], id[9], id[10], id[11], id[12], id[13],
+                id[14], id[15]);
+    }
+
+    if (length < 0 || (size_t)length >= path_size)
+    {
+        return VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
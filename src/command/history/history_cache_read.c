@@ -0,0 +1,83 @@
+/**
+ * \file command/history/history_cache_read.c
+ *
+ * \brief Read a transaction from the history cache.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <limits.h>
+
+#include "history_internal.h"
+
+/**
+ * \brief Read a transaction from the cache.
+ *
+ * A cached transaction is only used if its id matches and it belongs to the
+ * queried artifact; otherwise it is treated as missing and fetched again.
+ *
+ * \param cert              Buffer to be initialized with the transaction if it
+ *                          is cached. Caller owns this buffer on success and
+ *                          must dispose it.
+ * \param info              The transaction info to populate.
+ * \param found             Set to true if the transaction is cached.
+ * \param state             The query state.
+ * \param id                The transaction id.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success, whether or not the transaction is
+ *        cached.
+ *      - a non-zero error code on failure.
+ */
+int history_cache_read(
+    vccrypt_buffer_t* cert, transaction_info* info, bool* found,
+    history_state* state, const uint8_t* id)
+{
+    int retval;
+    char path[PATH_MAX];
+    file_stat_st fst;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != cert);
+    MODEL_ASSERT(NULL != info);
+    MODEL_ASSERT(NULL != found);
+    MODEL_ASSERT(NULL != state);
+    MODEL_ASSERT(NULL != id);
+
+    *found = false;
+
+    retval =
+        history_cache_path(path, sizeof(path), state->cache_dir, id, false);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* a missing file is a cache miss. */
+    if (VCTOOL_STATUS_SUCCESS != file_stat(state->opts->file, path, &fst))
+    {
+        return VCTOOL_STATUS_SUCCESS;
+    }
+
+    retval = verify_read_file(cert, state->opts, path);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error reading cached transaction %s.\n", path);
+        return retval;
+    }
+
+    /* a damaged or misplaced file is also a cache miss. */
+    if (VCTOOL_STATUS_SUCCESS !=
+            transaction_info_read(info, cert->data, cert->size)
+     || 0 != memcmp(info->transaction_id, id, TRANSACTION_ID_SIZE)
+     || 0 != memcmp(
+                info->artifact_id, state->artifact_id, TRANSACTION_ID_SIZE))
+    {
+        dispose((disposable_t*)cert);
+        return VCTOOL_STATUS_SUCCESS;
+    }
+
+    *found = true;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
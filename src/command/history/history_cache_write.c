@@ -0,0 +1,141 @@
+/**
+ * \file command/history/history_cache_write.c
+ *
+ * \brief Write a transaction to the history cache.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <limits.h>
+#include <unistd.h>
+
+#include "history_internal.h"
+
+/**
+ * \brief Write a transaction to the cache.
+ *
+ * The transaction is written to a temporary file which is then renamed into
+ * place, so that a concurrent or interrupted query never sees a partial
+ * transaction.
+ *
+ * \param state             The query state.
+ * \param id                The transaction id.
+ * \param cert              The transaction certificate.
+ * \param cert_size         The size of the transaction certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int history_cache_write(
+    history_state* state, const uint8_t* id, const uint8_t* cert,
+    size_t cert_size)
+{
+    int retval, release_retval, fd;
+    file* f = state->opts->file;
+    char path[PATH_MAX];
+    char tmpname[PATH_MAX];
+    size_t offset, wrote_size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != state);
+    MODEL_ASSERT(NULL != id);
+    MODEL_ASSERT(NULL != cert);
+
+    /* create the shard directory if it does not exist. */
+    retval =
+        history_cache_path(path, sizeof(path), state->cache_dir, id, true);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    retval =
+        file_mkdir(f, path, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+    if (VCTOOL_STATUS_SUCCESS != retval && VCTOOL_ERROR_FILE_EXISTS != retval)
+    {
+        fprintf(stderr, "Error creating cache directory %s.\n", path);
+        goto done;
+    }
+
+    /* create the temporary file alongside the cache file. */
+    retval =
+        history_cache_path(path, sizeof(path), state->cache_dir, id, false);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    if ((size_t)snprintf(
+            tmpname, sizeof(tmpname), "%s.%ld.tmp", path, (long)getpid())
+        >= sizeof(tmpname))
+    {
+        retval = VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+        goto done;
+    }
+
+    /* a temporary file left by an interrupted query is replaced. */
+    (void)file_unlink(f, tmpname);
+
+    /* transactions are public, so they are readable by everyone. */
+    retval =
+        file_open(
+            f, &fd, tmpname, O_CREAT | O_EXCL | O_WRONLY,
+            S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error creating cache file %s.\n", tmpname);
+        goto done;
+    }
+
+    /* write the transaction. */
+    for (offset = 0; offset < cert_size; offset += wrote_size)
+    {
+        retval =
+            file_write(f, fd, cert + offset, cert_size - offset, &wrote_size);
+        if (VCTOOL_ERROR_FILE_INTERRUPT == retval)
+        {
+            wrote_size = 0;
+        }
+        else if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_fd;
+        }
+        else if (0 == wrote_size)
+        {
+            retval = VCTOOL_ERROR_FILE_IO;
+            goto cleanup_fd;
+        }
+    }
+
+    /* close the file. */
+    retval = file_close(f, fd);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_tmpfile;
+    }
+
+    /* move the transaction into place. */
+    retval = file_rename(f, tmpname, path);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_tmpfile;
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto done;
+
+cleanup_fd:
+    release_retval = file_close(f, fd);
+    if (VCTOOL_STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_tmpfile:
+    (void)file_unlink(f, tmpname);
+
+done:
+    return retval;
+}
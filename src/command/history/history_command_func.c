@@ -0,0 +1,169 @@
+/**
+ * \file command/history/history_command_func.c
+ *
+ * \brief Entry point for the history command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <vpr/uuid.h>
+
+#include "history_internal.h"
+
+/**
+ * \brief Execute the history command.
+ *
+ * The transactions of the artifact given with -D artifact=UUID are queried
+ * from the agent listening on the socket given with -i, walking back from the
+ * latest transaction of the artifact to its first. The client authenticates
+ * with the keypair given with -k and the agent public certificate given with
+ * -D agent-pubkey=FILE. Each transaction is kept in
+ * the cache directory given with -D cache=DIR, named for its transaction id,
+ * so that a repeated query fetches only the transactions added since. The
+ * transaction ids are printed oldest first, and with -o, the transactions are
+ * also written to the given file, oldest first; an existing file is not
+ * overwritten.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int history_command_func(commandline_opts* opts)
+{
+    int retval;
+    agent_connection conn;
+    history_state state;
+    const char* artifact;
+    vpr_uuid artifact_id;
+    const uint8_t* id;
+    file_stat_st fst;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* get history and root command. */
+    history_command* history = (history_command*)opts->cmd;
+    MODEL_ASSERT(NULL != history);
+    root_command* root = (root_command*)history->hdr.next;
+    MODEL_ASSERT(NULL != root);
+
+    memset(&state, 0, sizeof(state));
+    state.opts = opts;
+    state.conn = &conn;
+
+    /* we need an agent, an artifact, and a cache directory. */
+    root_dict_find(&artifact, root, HISTORY_DICT_KEY_ARTIFACT);
+    root_dict_find(&state.cache_dir, root, HISTORY_DICT_KEY_CACHE);
+    if (NULL == root->input_filename)
+    {
+        fprintf(stderr, "Expecting an agent socket (-i agent.sock).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+    else if (NULL == artifact)
+    {
+        fprintf(stderr, "Expecting an artifact (-D artifact=UUID).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+    else if (NULL == state.cache_dir)
+    {
+        fprintf(stderr, "Expecting a cache directory (-D cache=DIR).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+
+    if (VCTOOL_STATUS_SUCCESS != vpr_uuid_from_string(&artifact_id, artifact))
+    {
+        fprintf(stderr, "Invalid artifact id %s.\n", artifact);
+        retval = VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+        goto done;
+    }
+
+    memcpy(state.artifact_id, artifact_id.data, TRANSACTION_ID_SIZE);
+
+    /* don't query the agent for a file that would not be written. */
+    if (NULL != root->output_filename
+     && VCTOOL_STATUS_SUCCESS ==
+            file_stat(opts->file, root->output_filename, &fst))
+    {
+        fprintf(
+            stderr, "Output file %s already exists.\n",
+            root->output_filename);
+        retval = VCTOOL_ERROR_FILE_EXISTS;
+        goto done;
+    }
+
+    /* create the cache directory if it does not exist. */
+    retval =
+        file_mkdir(
+            opts->file, state.cache_dir,
+            S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+    if (VCTOOL_STATUS_SUCCESS != retval && VCTOOL_ERROR_FILE_EXISTS != retval)
+    {
+        fprintf(
+            stderr, "Error creating cache directory %s.\n", state.cache_dir);
+        goto done;
+    }
+
+    /* connect and authenticate to the agent. */
+    retval = sync_connect(&conn, opts, root, root->input_filename);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* walk the history, fetching what is not cached. */
+    retval = history_walk(&state);
+    if (VCTOOL_ERROR_AGENT_NOT_FOUND == retval && 0 == state.count)
+    {
+        fprintf(stderr, "Artifact %s not found.\n", artifact);
+        goto cleanup_state;
+    }
+    else if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr,
+            "Error querying the artifact history; %zu transactions read.\n",
+            state.count);
+        goto cleanup_state;
+    }
+
+    /* write the transactions, if requested. */
+    if (NULL != root->output_filename)
+    {
+        retval = history_write_output(&state, root->output_filename);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_state;
+        }
+    }
+
+    /* print the transaction ids, oldest first. */
+    for (size_t i = state.count; i-- > 0;)
+    {
+        id = state.ids + i * TRANSACTION_ID_SIZE;
+        printf(
+            "%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-"
+            "%02x%02x%02x%02x%02x%02x\n",
+            id[0], id[1], id[2], id[3], id[4], id[5], id[6], id[7], id[8],
+            id[9], id[10], id[11], id[12], id[13], id[14], id[15]);
+    }
+
+    printf(
+        "%zu transactions (%zu fetched, %zu cached).\n", state.count,
+        state.fetched, state.cached);
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_state;
+
+cleanup_state:
+    free(state.ids);
+    agent_connection_dispose(&conn);
+
+done:
+    return retval;
+}
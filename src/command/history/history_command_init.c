@@ -0,0 +1,52 @@
+/**
+ * \file command/history/history_command_init.c
+ *
+ * \brief Initialize a history command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/root.h>
+#include <vctool/command/history.h>
+#include <vctool/status_codes.h>
+#include <vpr/parameters.h>
+
+/* forward decls. */
+static void history_command_dispose(void* disp);
+
+/**
+ * \brief Initialize a history command structure.
+ *
+ * \param history       The history command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int history_command_init(history_command* history)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != history);
+
+    /* clear history command structure. */
+    memset(history, 0, sizeof(history_command));
+
+    /* set disposer, func, etc. */
+    history->hdr.hdr.dispose = &history_command_dispose;
+    history->hdr.func = &history_command_func;
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Dispose of a history_command structure.
+ *
+ * \param disp          The history_command structure to dispose.
+ */
+static void history_command_dispose(void* UNUSED(disp))
+{
+    /* do nothing. */
+}
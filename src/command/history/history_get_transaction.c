@@ -0,0 +1,119 @@
+/**
+ * \file command/history/history_get_transaction.c
+ *
+ * \brief Get a transaction from the history cache or the agent.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "history_internal.h"
+
+/**
+ * \brief Get a transaction of the queried artifact, from the cache if it is
+ * cached and from the agent otherwise.
+ *
+ * A transaction fetched from the agent is added to the cache.
+ *
+ * \param info              The transaction info to populate.
+ * \param state             The query state.
+ * \param id                The transaction id.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_PROTOCOL if the agent answers with a transaction
+ *        of another id or another artifact.
+ *      - a non-zero error code on failure.
+ */
+int history_get_transaction(
+    transaction_info* info, history_state* state, const uint8_t* id)
+{
+    int retval;
+    vccrypt_buffer_t cert;
+    bool found;
+    vccrypt_buffer_t response;
+    protocol_resp_transaction_get txn;
+    RCPR_SYM(rcpr_uuid) txn_id;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != info);
+    MODEL_ASSERT(NULL != state);
+    MODEL_ASSERT(NULL != id);
+
+    /* use the cached transaction if there is one. */
+    retval = history_cache_read(&cert, info, &found, state, id);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+    else if (found)
+    {
+        dispose((disposable_t*)&cert);
+        ++state->cached;
+        return VCTOOL_STATUS_SUCCESS;
+    }
+
+    /* otherwise, fetch it from the agent. */
+    memcpy(&txn_id, id, sizeof(txn_id));
+    retval =
+        vcblockchain_protocol_sendreq_transaction_get(
+            state->conn->sock, state->conn->suite, &state->conn->client_iv,
+            &state->conn->shared_secret, 0, &txn_id);
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_AGENT_IO;
+        goto done;
+    }
+
+    retval =
+        sync_receive_response(
+            &response, state->conn, PROTOCOL_REQ_ID_TRANSACTION_BY_ID_GET);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    retval =
+        vcblockchain_protocol_decode_resp_transaction_get(
+            &txn, state->conn->suite->alloc_opts, response.data,
+            response.size);
+    dispose((disposable_t*)&response);
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_AGENT_PROTOCOL;
+        goto done;
+    }
+
+    /* the agent must answer with the transaction we asked for. */
+    retval = transaction_info_read(info, txn.txn_cert.data, txn.txn_cert.size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_txn;
+    }
+    else if (
+        0 != memcmp(info->transaction_id, id, TRANSACTION_ID_SIZE)
+     || 0 != memcmp(
+                info->artifact_id, state->artifact_id, TRANSACTION_ID_SIZE))
+    {
+        retval = VCTOOL_ERROR_AGENT_PROTOCOL;
+        goto cleanup_txn;
+    }
+
+    retval =
+        history_cache_write(
+            state, id, (const uint8_t*)txn.txn_cert.data, txn.txn_cert.size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_txn;
+    }
+
+    /* success. */
+    ++state->fetched;
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_txn;
+
+cleanup_txn:
+    dispose((disposable_t*)&txn);
+
+done:
+    return retval;
+}
@@ -0,0 +1,171 @@
+/**
+ * \file command/history/history_internal.h
+ *
+ * \brief Internal header for the history command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <vctool/command/history.h>
+#include <vctool/transaction.h>
+
+#include "../sync/sync_internal.h"
+#include "../verify/verify_internal.h"
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief The root dictionary key for the artifact to query. */
+#define HISTORY_DICT_KEY_ARTIFACT "artifact"
+
+/** \brief The root dictionary key for the transaction cache directory. */
+#define HISTORY_DICT_KEY_CACHE "cache"
+
+/**
+ * \brief The longest artifact history that is followed, so that a cycle in the
+ * previous transaction ids can't loop forever.
+ */
+#define HISTORY_MAX_TRANSACTIONS (1U << 24)
+
+/**
+ * \brief The state of an artifact history query.
+ *
+ * The transaction ids of the history are kept newest first, in the order in
+ * which the history is walked.
+ */
+typedef struct history_state history_state;
+
+struct history_state
+{
+    commandline_opts* opts;
+    agent_connection* conn;
+    const char* cache_dir;
+    uint8_t artifact_id[TRANSACTION_ID_SIZE];
+    uint8_t* ids;
+    size_t count;
+    size_t capacity;
+    size_t fetched;
+    size_t cached;
+};
+
+/**
+ * \brief Build the cache path of a transaction.
+ *
+ * Transactions are sharded by the first byte of their id, as
+ * <cache>/<xx>/<transaction uuid>.txn, so that no directory grows too large.
+ *
+ * \param path              The buffer to receive the path.
+ * \param path_size         The size of the buffer.
+ * \param cache_dir         The cache directory.
+ * \param id                The transaction id.
+ * \param shard_only        If true, only the shard directory is built.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER if the path is too long.
+ */
+int history_cache_path(
+    char* path, size_t path_size, const char* cache_dir, const uint8_t* id,
+    bool shard_only);
+
+/**
+ * \brief Read a transaction from the cache.
+ *
+ * A cached transaction is only used if its id matches and it belongs to the
+ * queried artifact; otherwise it is treated as missing and fetched again.
+ *
+ * \param cert              Buffer to be initialized with the transaction if it
+ *                          is cached. Caller owns this buffer on success and
+ *                          must dispose it.
+ * \param info              The transaction info to populate.
+ * \param found             Set to true if the transaction is cached.
+ * \param state             The query state.
+ * \param id                The transaction id.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success, whether or not the transaction is
+ *        cached.
+ *      - a non-zero error code on failure.
+ */
+int history_cache_read(
+    vccrypt_buffer_t* cert, transaction_info* info, bool* found,
+    history_state* state, const uint8_t* id);
+
+/**
+ * \brief Write a transaction to the cache.
+ *
+ * The transaction is written to a temporary file which is then renamed into
+ * place, so that a concurrent or interrupted query never sees a partial
+ * transaction.
+ *
+ * \param state             The query state.
+ * \param id                The transaction id.
+ * \param cert              The transaction certificate.
+ * \param cert_size         The size of the transaction certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int history_cache_write(
+    history_state* state, const uint8_t* id, const uint8_t* cert,
+    size_t cert_size);
+
+/**
+ * \brief Get a transaction of the queried artifact, from the cache if it is
+ * cached and from the agent otherwise.
+ *
+ * A transaction fetched from the agent is added to the cache.
+ *
+ * \param info              The transaction info to populate.
+ * \param state             The query state.
+ * \param id                The transaction id.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_PROTOCOL if the agent answers with a transaction
+ *        of another id or another artifact.
+ *      - a non-zero error code on failure.
+ */
+int history_get_transaction(
+    transaction_info* info, history_state* state, const uint8_t* id);
+
+/**
+ * \brief Walk the history of the queried artifact back from its latest
+ * transaction to its first.
+ *
+ * Only the transactions that are not cached are fetched from the agent, so a
+ * repeated query fetches only the transactions added since the last query.
+ *
+ * \param state             The query state.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_NOT_FOUND if the artifact is not known.
+ *      - a non-zero error code on failure.
+ */
+int history_walk(history_state* state);
+
+/**
+ * \brief Write the transactions of the history to a file, oldest first.
+ *
+ * An existing file is never overwritten.
+ *
+ * \param state             The query state, after a successful walk.
+ * \param filename          The output file.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_EXISTS if the output file already exists.
+ *      - a non-zero error code on failure.
+ */
+int history_write_output(history_state* state, const char* filename);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,136 @@
+/**
+ * \file command/history/history_walk.c
+ *
+ * \brief Walk the history of an artifact.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "history_internal.h"
+
+/* forward decls. */
+static bool history_id_is_zero(const uint8_t* id);
+
+/**
+ * \brief Walk the history of the queried artifact back from its latest
+ * transaction to its first.
+ *
+ * Only the transactions that are not cached are fetched from the agent, so a
+ * repeated query fetches only the transactions added since the last query.
+ *
+ * \param state             The query state.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_NOT_FOUND if the artifact is not known.
+ *      - a non-zero error code on failure.
+ */
+int history_walk(history_state* state)
+{
+    int retval;
+    vccrypt_buffer_t response;
+    protocol_resp_artifact_get artifact;
+    RCPR_SYM(rcpr_uuid) artifact_id;
+    transaction_info info;
+    uint8_t id[TRANSACTION_ID_SIZE];
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != state);
+
+    /* the latest transaction always comes from the agent. */
+    memcpy(&artifact_id, state->artifact_id, sizeof(artifact_id));
+    retval =
+        vcblockchain_protocol_sendreq_artifact_get(
+            state->conn->sock, state->conn->suite, &state->conn->client_iv,
+            &state->conn->shared_secret, 0, &artifact_id);
+    if (STATUS_SUCCESS != retval)
+    {
+        return VCTOOL_ERROR_AGENT_IO;
+    }
+
+    /* the agent fails the request for an artifact it does not know. */
+    retval =
+        sync_receive_response(
+            &response, state->conn, PROTOCOL_REQ_ID_ARTIFACT_GET);
+    if (VCTOOL_ERROR_AGENT_REQUEST_FAILED == retval)
+    {
+        return VCTOOL_ERROR_AGENT_NOT_FOUND;
+    }
+    else if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval =
+        vcblockchain_protocol_decode_resp_artifact_get(
+            &artifact, state->conn->suite->alloc_opts, response.data,
+            response.size);
+    dispose((disposable_t*)&response);
+    if (STATUS_SUCCESS != retval)
+    {
+        return VCTOOL_ERROR_AGENT_PROTOCOL;
+    }
+
+    memcpy(id, artifact.txn_latest.data, TRANSACTION_ID_SIZE);
+    dispose((disposable_t*)&artifact);
+
+    /* follow the previous transaction ids back to the first transaction. */
+    while (!history_id_is_zero(id))
+    {
+        if (state->count == HISTORY_MAX_TRANSACTIONS)
+        {
+            fprintf(stderr, "The artifact history is too long.\n");
+            return VCTOOL_ERROR_AGENT_PROTOCOL;
+        }
+
+        /* grow the id array if needed. */
+        if (state->count == state->capacity)
+        {
+            size_t capacity = state->capacity ? 2 * state->capacity : 256;
+            uint8_t* grown =
+                (uint8_t*)realloc(state->ids, capacity * TRANSACTION_ID_SIZE);
+            if (NULL == grown)
+            {
+                return VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+            }
+
+            state->ids = grown;
+            state->capacity = capacity;
+        }
+
+        memcpy(
+            state->ids + state->count * TRANSACTION_ID_SIZE, id,
+            TRANSACTION_ID_SIZE);
+        ++state->count;
+
+        retval = history_get_transaction(&info, state, id);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        memcpy(id, info.previous_transaction_id, TRANSACTION_ID_SIZE);
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Check whether a transaction id is zero.
+ *
+ * \param id                The transaction id.
+ *
+ * \returns true if every byte of the id is zero.
+ */
+static bool history_id_is_zero(const uint8_t* id)
+{
+    for (size_t i = 0; i < TRANSACTION_ID_SIZE; ++i)
+    {
+        if (0 != id[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,99 @@
+/**
+ * \file command/history/history_write_output.c
+ *
+ * \brief Write the transactions of an artifact history to a file.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "history_internal.h"
+
+/**
+ * \brief Write the transactions of the history to a file, oldest first.
+ *
+ * An existing file is never overwritten.
+ *
+ * \param state             The query state, after a successful walk.
+ * \param filename          The output file.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_EXISTS if the output file already exists.
+ *      - a non-zero error code on failure.
+ */
+int history_write_output(history_state* state, const char* filename)
+{
+    int retval, release_retval, fd;
+    vccrypt_buffer_t cert;
+    transaction_info info;
+    bool found;
+    size_t wrote_size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != state);
+    MODEL_ASSERT(NULL != filename);
+
+    /* transactions are public, so they are readable by everyone. */
+    retval =
+        file_open(
+            state->opts->file, &fd, filename, O_CREAT | O_EXCL | O_WRONLY,
+            S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (VCTOOL_ERROR_FILE_EXISTS == retval)
+    {
+        fprintf(stderr, "Output file %s already exists.\n", filename);
+        goto done;
+    }
+    else if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error opening output file %s.\n", filename);
+        goto done;
+    }
+
+    /* every transaction of the history is now cached. */
+    for (size_t i = state->count; i-- > 0;)
+    {
+        retval =
+            history_cache_read(
+                &cert, &info, &found, state,
+                state->ids + i * TRANSACTION_ID_SIZE);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_fd;
+        }
+        else if (!found)
+        {
+            fprintf(stderr, "A cached transaction was removed.\n");
+            retval = VCTOOL_ERROR_FILE_IO;
+            goto cleanup_fd;
+        }
+
+        retval =
+            file_write(
+                state->opts->file, fd, cert.data, cert.size, &wrote_size);
+        if (VCTOOL_STATUS_SUCCESS == retval && wrote_size != cert.size)
+        {
+            retval = VCTOOL_ERROR_FILE_IO;
+        }
+
+        dispose((disposable_t*)&cert);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(stderr, "Error writing to output file %s.\n", filename);
+            goto cleanup_fd;
+        }
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_fd;
+
+cleanup_fd:
+    release_retval = file_close(state->opts->file, fd);
+    if (VCTOOL_STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,66 @@
+/**
+ * \file command/history/process_history_command.c
+ *
+ * \brief Process command-line options to build a history command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/root.h>
+#include <vctool/command/history.h>
+#include <vctool/commandline.h>
+#include <vctool/status_codes.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Process the history command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_history_command(
+    commandline_opts* opts, int UNUSED(argc), char* UNUSED(argv[]))
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* allocate memory for a history_command structure. */
+    history_command* history =
+        (history_command*)malloc(sizeof(history_command));
+    if (NULL == history)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* initialize the structure. */
+    retval = history_command_init(history);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto free_verify;
+    }
+
+    /* set history command as the head of opts command. */
+    history->hdr.next = opts->cmd;
+    opts->cmd = &history->hdr;
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto done;
+
+free_verify:
+    free(history);
+
+done:
+    return retval;
+}
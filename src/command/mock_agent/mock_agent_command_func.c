@@ -0,0 +1,220 @@
+/**
+ * \file command/mock_agent/mock_agent_command_func.c
+ *
+ * \brief Entry point for the mock-agent command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "mock_agent_internal.h"
+
+/**
+ * \brief Execute the mock-agent command.
+ *
+ * The blocks in the optional block directory given with -i are served on the
+ * Unix socket given with -o over the vcblockchain protocol, so that the client
+ * commands can be tested and benchmarked without a running agent. The mock
+ * agent authenticates with the keypair given with -k, and only serves the
+ * client whose public certificate is given with -D client-pubkey=FILE. With
+ * -D transactions=FILE, the concatenated transactions in FILE are also served,
+ * and the last transaction of each artifact in FILE is its latest. Submitted
+ * transactions are checked and counted, and a transaction already accepted is
+ * rejected. With -D drop-every=N, every Nth submission is accepted, but its
+ * answer is lost by closing the connection. Connections are served one at a
+ * time. With -D connections=N, the mock agent exits after serving N
+ * connections.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int mock_agent_command_func(commandline_opts* opts)
+{
+    int retval, listen_fd, client_fd;
+    mock_agent agent;
+    agent_keys keys;
+    agent_connection conn;
+    struct sockaddr_un addr;
+    uint64_t connections = 0;
+    const char* transactions;
+    bool found;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* get mock-agent and root command. */
+    mock_agent_command* mock = (mock_agent_command*)opts->cmd;
+    MODEL_ASSERT(NULL != mock);
+    root_command* root = (root_command*)mock->hdr.next;
+    MODEL_ASSERT(NULL != root);
+
+    /* we need a socket path. */
+    if (NULL == root->output_filename)
+    {
+        fprintf(stderr, "Expecting a socket path (-o agent.sock).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(root->output_filename) >= sizeof(addr.sun_path))
+    {
+        fprintf(stderr, "Socket path %s is too long.\n", root->output_filename);
+        retval = VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+        goto done;
+    }
+
+    strcpy(addr.sun_path, root->output_filename);
+
+    /* get the number of connections to serve; zero means no limit. */
+    retval =
+        root_dict_get_uint64(
+            &connections, &found, root, MOCK_AGENT_DICT_KEY_CONNECTIONS);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* load the blocks, if any. */
+    memset(&agent, 0, sizeof(agent));
+    if (NULL != root->input_filename)
+    {
+        retval = mock_agent_load(&agent, opts, root->input_filename);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+    }
+
+    /* load the transactions, if any. */
+    root_dict_find(&transactions, root, MOCK_AGENT_DICT_KEY_TRANSACTIONS);
+    if (NULL != transactions)
+    {
+        retval = mock_agent_load_transactions(&agent, opts, transactions);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_agent;
+        }
+    }
+
+    /* get the submission drop interval; zero means never drop. */
+    retval =
+        root_dict_get_uint64(
+            &agent.drop_every, &found, root, MOCK_AGENT_DICT_KEY_DROP_EVERY);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_agent;
+    }
+
+    /* read the agent keys and the client public key. */
+    retval =
+        sync_read_keys(&keys, opts, root, MOCK_AGENT_DICT_KEY_CLIENT_PUBKEY);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_agent;
+    }
+
+    /* listen on the socket. */
+    listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0)
+    {
+        retval = VCTOOL_ERROR_AGENT_IO;
+        goto cleanup_keys;
+    }
+
+    if (0 != bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)))
+    {
+        fprintf(stderr, "Error binding socket %s.\n", root->output_filename);
+        retval = VCTOOL_ERROR_AGENT_IO;
+        goto cleanup_listen_fd;
+    }
+
+    if (0 != listen(listen_fd, 16))
+    {
+        retval = VCTOOL_ERROR_AGENT_IO;
+        goto cleanup_socket_file;
+    }
+
+    if (root->verbose)
+    {
+        printf(
+            "Serving %zu blocks and %zu transactions on %s.\n", agent.count,
+            agent.history_count, root->output_filename);
+        fflush(stdout);
+    }
+
+    /* serve one connection at a time. */
+    for (uint64_t served = 0; 0 == connections || served < connections;)
+    {
+        client_fd = accept(listen_fd, NULL, NULL);
+        if (client_fd < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            retval = VCTOOL_ERROR_AGENT_IO;
+            goto cleanup_socket_file;
+        }
+
+        retval =
+            agent_connection_init(&conn, root->alloc, opts->suite, client_fd);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            close(client_fd);
+            goto cleanup_socket_file;
+        }
+
+        /* a client that misbehaves does not stop the mock agent. */
+        retval = mock_agent_handshake(&conn, &keys);
+        if (VCTOOL_STATUS_SUCCESS == retval)
+        {
+            retval = mock_agent_serve(&agent, &conn);
+        }
+
+        if (VCTOOL_STATUS_SUCCESS != retval && root->verbose)
+        {
+            fprintf(stderr, "Connection closed with error %x.\n", retval);
+        }
+
+        agent_connection_dispose(&conn);
+        ++served;
+
+        if (root->verbose && agent.submit_count > 0)
+        {
+            printf(
+                "Accepted %" PRIu64 " transactions; %" PRIu64 " answers"
+                " dropped.\n", agent.transaction_count, agent.drop_count);
+            fflush(stdout);
+        }
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_socket_file;
+
+cleanup_socket_file:
+    unlink(root->output_filename);
+
+cleanup_listen_fd:
+    close(listen_fd);
+
+cleanup_keys:
+    agent_keys_dispose(&keys);
+
+cleanup_agent:
+    mock_agent_dispose(&agent);
+
+done:
+    return retval;
+}
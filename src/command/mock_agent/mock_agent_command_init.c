@@ -0,0 +1,52 @@
+/**
+ * \file command/mock_agent/mock_agent_command_init.c
+ *
+ * \brief Initialize a mock-agent command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/root.h>
+#include <vctool/command/mock_agent.h>
+#include <vctool/status_codes.h>
+#include <vpr/parameters.h>
+
+/* forward decls. */
+static void mock_agent_command_dispose(void* disp);
+
+/**
+ * \brief Initialize a mock-agent command structure.
+ *
+ * \param mock_agent    The mock-agent command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int mock_agent_command_init(mock_agent_command* mock_agent)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != mock_agent);
+
+    /* clear mock-agent command structure. */
+    memset(mock_agent, 0, sizeof(mock_agent_command));
+
+    /* set disposer, func, etc. */
+    mock_agent->hdr.hdr.dispose = &mock_agent_command_dispose;
+    mock_agent->hdr.func = &mock_agent_command_func;
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Dispose of a mock_agent_command structure.
+ *
+ * \param disp          The mock_agent_command structure to dispose.
+ */
+static void mock_agent_command_dispose(void* UNUSED(disp))
+{
+    /* do nothing. */
+}
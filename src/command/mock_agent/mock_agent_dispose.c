@@ -0,0 +1,38 @@
+/**
+ * \file command/mock_agent/mock_agent_dispose.c
+ *
+ * \brief Dispose of the blocks and transactions served by the mock agent.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "mock_agent_internal.h"
+
+/**
+ * \brief Dispose of a mock agent, freeing its blocks and transactions.
+ *
+ * \param agent             The mock agent to dispose.
+ */
+void mock_agent_dispose(mock_agent* agent)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != agent);
+
+    for (size_t i = 0; i < agent->count; ++i)
+    {
+        dispose((disposable_t*)&agent->blocks[i].cert);
+    }
+
+    free(agent->blocks);
+    free(agent->blocks_by_id);
+
+    if (agent->history_loaded)
+    {
+        dispose((disposable_t*)&agent->history_data);
+    }
+
+    free(agent->history);
+    free(agent->latest);
+    free(agent->submitted);
+    memset(agent, 0, sizeof(*agent));
+}
@@ -0,0 +1,53 @@
+/**
+ * \file command/mock_agent/mock_agent_find_artifact.c
+ *
+ * \brief Find the latest mock agent transaction of an artifact.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "mock_agent_internal.h"
+
+/**
+ * \brief Find the latest transaction of an artifact.
+ *
+ * \param agent             The mock agent.
+ * \param artifact_id       The artifact id.
+ *
+ * \returns the transaction, or NULL if the artifact is not known.
+ */
+const mock_agent_transaction* mock_agent_find_artifact(
+    const mock_agent* agent, const uint8_t* artifact_id)
+{
+    size_t low = 0, high;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != agent);
+    MODEL_ASSERT(NULL != artifact_id);
+
+    /* binary search the latest transactions. */
+    high = agent->artifact_count;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        int cmp =
+            memcmp(
+                agent->latest[mid]->info.artifact_id, artifact_id,
+                TRANSACTION_ID_SIZE);
+
+        if (0 == cmp)
+        {
+            return agent->latest[mid];
+        }
+        else if (cmp < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return NULL;
+}
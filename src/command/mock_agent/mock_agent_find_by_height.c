@@ -0,0 +1,49 @@
+/**
+ * \file command/mock_agent/mock_agent_find_by_height.c
+ *
+ * \brief Find a mock agent block by height.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "mock_agent_internal.h"
+
+/**
+ * \brief Find a block by height.
+ *
+ * \param agent             The mock agent.
+ * \param height            The block height.
+ *
+ * \returns the block, or NULL if there is no block at this height.
+ */
+const mock_agent_block* mock_agent_find_by_height(
+    const mock_agent* agent, uint64_t height)
+{
+    size_t low = 0, high;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != agent);
+
+    /* binary search the blocks, which are sorted by height. */
+    high = agent->count;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        uint64_t mid_height = agent->blocks[mid].info.height;
+
+        if (mid_height == height)
+        {
+            return &agent->blocks[mid];
+        }
+        else if (mid_height < height)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,51 @@
+/**
+ * \file command/mock_agent/mock_agent_find_by_id.c
+ *
+ * \brief Find a mock agent block by id.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "mock_agent_internal.h"
+
+/**
+ * \brief Find a block by id.
+ *
+ * \param agent             The mock agent.
+ * \param id                The block id.
+ *
+ * \returns the block, or NULL if there is no block with this id.
+ */
+const mock_agent_block* mock_agent_find_by_id(
+    const mock_agent* agent, const uint8_t* id)
+{
+    size_t low = 0, high;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != agent);
+    MODEL_ASSERT(NULL != id);
+
+    /* binary search the id index. */
+    high = agent->count;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        int cmp =
+            memcmp(agent->blocks_by_id[mid]->info.block_id, id, BLOCK_ID_SIZE);
+
+        if (0 == cmp)
+        {
+            return agent->blocks_by_id[mid];
+        }
+        else if (cmp < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,53 @@
+/**
+ * \file command/mock_agent/mock_agent_find_transaction.c
+ *
+ * \brief Find a mock agent transaction by id.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "mock_agent_internal.h"
+
+/**
+ * \brief Find a transaction by id.
+ *
+ * \param agent             The mock agent.
+ * \param id                The transaction id.
+ *
+ * \returns the transaction, or NULL if there is no transaction with this id.
+ */
+const mock_agent_transaction* mock_agent_find_transaction(
+    const mock_agent* agent, const uint8_t* id)
+{
+    size_t low = 0, high;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != agent);
+    MODEL_ASSERT(NULL != id);
+
+    /* binary search the transactions. */
+    high = agent->history_count;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        int cmp =
+            memcmp(
+                agent->history[mid].info.transaction_id, id,
+                TRANSACTION_ID_SIZE);
+
+        if (0 == cmp)
+        {
+            return &agent->history[mid];
+        }
+        else if (cmp < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,315 @@
+/**
+ * \file command/mock_agent/mock_agent_handshake.c
+ *
+ * \brief Perform the agent side of the vcblockchain handshake.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <vccrypt/compare.h>
+
+#include "mock_agent_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_psock;
+
+/* forward decls. */
+static int mock_agent_handshake_ack(
+    agent_connection* conn, const vccrypt_buffer_t* server_challenge_nonce);
+
+/**
+ * \brief Perform the agent side of the vcblockchain handshake.
+ *
+ * The client must identify itself with the peer id, and must prove that it
+ * holds the private key matching the peer public key by answering the agent's
+ * challenge.
+ *
+ * \param conn              The unauthenticated connection.
+ * \param keys              The agent keys and the client public key.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED if the client is not the
+ *        expected client or fails the challenge.
+ *      - a non-zero error code on failure.
+ */
+int mock_agent_handshake(agent_connection* conn, const agent_keys* keys)
+{
+    int retval;
+    void* data;
+    size_t size;
+    protocol_req_handshake_request req;
+    vccrypt_prng_context_t prng;
+    vccrypt_key_agreement_context_t agreement;
+    vccrypt_buffer_t server_key_nonce;
+    vccrypt_buffer_t server_challenge_nonce;
+    vccrypt_buffer_t response;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(NULL != conn->sock);
+    MODEL_ASSERT(!conn->authenticated);
+    MODEL_ASSERT(NULL != keys);
+
+    /* read and decode the handshake request. */
+    retval = psock_read_boxed_data(conn->sock, conn->alloc, &data, &size);
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_AGENT_IO;
+        goto done;
+    }
+
+    retval =
+        vcblockchain_protocol_decode_req_handshake_request(
+            &req, conn->suite->alloc_opts, data, size);
+    rcpr_allocator_reclaim(conn->alloc, data);
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_AGENT_PROTOCOL;
+        goto done;
+    }
+
+    /* only the expected client is served. */
+    if (crypto_memcmp(&req.client_id, &keys->peer_id, sizeof(keys->peer_id)))
+    {
+        retval = VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED;
+        goto cleanup_req;
+    }
+
+    memcpy(&conn->peer_id, &req.client_id, sizeof(conn->peer_id));
+
+    /* create the agent nonces. */
+    retval =
+        vccrypt_suite_buffer_init_for_cipher_key_agreement_nonce(
+            conn->suite, &server_key_nonce);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_req;
+    }
+
+    retval =
+        vccrypt_suite_buffer_init_for_cipher_key_agreement_nonce(
+            conn->suite, &server_challenge_nonce);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_server_key_nonce;
+    }
+
+    retval = vccrypt_suite_prng_init(conn->suite, &prng);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_server_challenge_nonce;
+    }
+
+    retval = vccrypt_prng_read(&prng, &server_key_nonce, server_key_nonce.size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_prng;
+    }
+
+    retval =
+        vccrypt_prng_read(
+            &prng, &server_challenge_nonce, server_challenge_nonce.size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_prng;
+    }
+
+    /* compute the shared secret. */
+    retval =
+        vccrypt_suite_cipher_key_agreement_init(conn->suite, &agreement);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_prng;
+    }
+
+    retval =
+        vccrypt_suite_buffer_init_for_cipher_key_agreement_shared_secret(
+            conn->suite, &conn->shared_secret);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_agreement;
+    }
+
+    retval =
+        vccrypt_key_agreement_short_term_secret_create(
+            &agreement, &keys->local_private_key, &keys->peer_public_key,
+            &server_key_nonce, &req.client_key_nonce, &conn->shared_secret);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_shared_secret;
+    }
+
+    /* answer with the agent nonces, proving that we hold the agent key. */
+    retval =
+        vcblockchain_protocol_encode_resp_handshake_request(
+            &response, conn->suite, req.offset, AGENT_STATUS_SUCCESS,
+            &keys->local_id, &server_key_nonce, &server_challenge_nonce,
+            &req.client_challenge_nonce, &conn->shared_secret);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_shared_secret;
+    }
+
+    retval = psock_write_boxed_data(conn->sock, response.data, response.size);
+    dispose((disposable_t*)&response);
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_AGENT_IO;
+        goto cleanup_shared_secret;
+    }
+
+    /* the client must answer our challenge. */
+    retval = mock_agent_handshake_ack(conn, &server_challenge_nonce);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_shared_secret;
+    }
+
+    /* success. The connection owns the shared secret. */
+    conn->authenticated = true;
+    goto cleanup_agreement;
+
+cleanup_shared_secret:
+    dispose((disposable_t*)&conn->shared_secret);
+
+cleanup_agreement:
+    dispose((disposable_t*)&agreement);
+
+cleanup_prng:
+    dispose((disposable_t*)&prng);
+
+cleanup_server_challenge_nonce:
+    dispose((disposable_t*)&server_challenge_nonce);
+
+cleanup_server_key_nonce:
+    dispose((disposable_t*)&server_key_nonce);
+
+cleanup_req:
+    dispose((disposable_t*)&req);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Read the handshake acknowledgement, check the client's answer to the
+ * challenge, and accept it.
+ *
+ * \param conn              The connection, which holds the shared secret.
+ * \param server_challenge_nonce    The challenge sent to the client.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int mock_agent_handshake_ack(
+    agent_connection* conn, const vccrypt_buffer_t* server_challenge_nonce)
+{
+    int retval;
+    void* data;
+    uint32_t size;
+    protocol_req_handshake_ack ack;
+    vccrypt_mac_context_t mac;
+    vccrypt_buffer_t expected;
+    vccrypt_buffer_t response;
+
+    conn->client_iv = AGENT_CLIENT_IV_INITIAL;
+    conn->server_iv = AGENT_SERVER_IV_INITIAL;
+
+    /* read and decode the acknowledgement. */
+    retval =
+        vcblockchain_psock_read_authed_data(
+            conn->sock, conn->alloc, conn->client_iv, &data, &size,
+            conn->suite, &conn->shared_secret);
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED;
+        goto done;
+    }
+
+    ++conn->client_iv;
+
+    retval =
+        vcblockchain_protocol_decode_req_handshake_ack(
+            &ack, conn->suite->alloc_opts, data, size);
+    rcpr_allocator_reclaim(conn->alloc, data);
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_AGENT_PROTOCOL;
+        goto done;
+    }
+
+    /* the answer is a MAC of the challenge keyed with the shared secret. */
+    retval =
+        vccrypt_suite_mac_short_init(conn->suite, &mac, &conn->shared_secret);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_ack;
+    }
+
+    retval =
+        vccrypt_suite_buffer_init_for_mac_authentication_code(
+            conn->suite, &expected, true);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mac;
+    }
+
+    retval =
+        vccrypt_mac_digest(
+            &mac, server_challenge_nonce->data, server_challenge_nonce->size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_expected;
+    }
+
+    retval = vccrypt_mac_finalize(&mac, &expected);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_expected;
+    }
+
+    if (expected.size != ack.digest.size
+     || crypto_memcmp(expected.data, ack.digest.data, expected.size))
+    {
+        retval = VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED;
+        goto cleanup_expected;
+    }
+
+    /* accept the answer. */
+    retval =
+        vcblockchain_protocol_encode_resp_handshake_ack(
+            &response, conn->suite->alloc_opts, ack.offset,
+            AGENT_STATUS_SUCCESS);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_expected;
+    }
+
+    retval =
+        vcblockchain_psock_write_authed_data(
+            conn->sock, conn->server_iv, response.data, response.size,
+            conn->suite, &conn->shared_secret);
+    dispose((disposable_t*)&response);
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_AGENT_IO;
+        goto cleanup_expected;
+    }
+
+    /* success. */
+    ++conn->server_iv;
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_expected;
+
+cleanup_expected:
+    dispose((disposable_t*)&expected);
+
+cleanup_mac:
+    dispose((disposable_t*)&mac);
+
+cleanup_ack:
+    dispose((disposable_t*)&ack);
+
+done:
+    return retval;
+}
@@ -0,0 +1,262 @@
+/**
+ * \file command/mock_agent/mock_agent_internal.h
+ *
+ * \brief Internal header for the mock-agent command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <vcblockchain/psock.h>
+#include <vctool/agent.h>
+#include <vctool/command/mock_agent.h>
+#include <vctool/transaction.h>
+
+#include "../sync/sync_internal.h"
+#include "../verify/verify_internal.h"
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief The root dictionary key for the number of connections to serve
+ * before exiting.
+ */
+#define MOCK_AGENT_DICT_KEY_CONNECTIONS "connections"
+
+/**
+ * \brief The root dictionary key for how often a transaction submission closes
+ * the connection without an answer, to exercise client reconnects.
+ */
+#define MOCK_AGENT_DICT_KEY_DROP_EVERY "drop-every"
+
+/**
+ * \brief The root dictionary key for a file of concatenated transactions to
+ * serve.
+ */
+#define MOCK_AGENT_DICT_KEY_TRANSACTIONS "transactions"
+
+/** \brief The root dictionary key for the client public certificate. */
+#define MOCK_AGENT_DICT_KEY_CLIENT_PUBKEY "client-pubkey"
+
+/**
+ * \brief The status of a response to a request for a record the mock agent
+ * does not have. Clients only distinguish success from failure.
+ */
+#define MOCK_AGENT_STATUS_NOT_FOUND 0x00000001U
+
+/** \brief The status of a response to a malformed or unknown request. */
+#define MOCK_AGENT_STATUS_BAD_REQUEST 0x00000002U
+
+/** \brief The status of a submission of a transaction already accepted. */
+#define MOCK_AGENT_STATUS_DUPLICATE 0x00000003U
+
+/**
+ * \brief The status of a submission that is dropped by closing the
+ * connection. This status is never sent.
+ */
+#define MOCK_AGENT_STATUS_DROPPED 0xFFFFFFFFU
+
+/** \brief A block served by the mock agent. */
+typedef struct mock_agent_block mock_agent_block;
+
+struct mock_agent_block
+{
+    block_info info;
+    vccrypt_buffer_t cert;
+};
+
+/** \brief A transaction served by the mock agent. */
+typedef struct mock_agent_transaction mock_agent_transaction;
+
+struct mock_agent_transaction
+{
+    transaction_info info;
+    const uint8_t* cert;
+    size_t cert_size;
+    size_t index;
+};
+
+/** \brief An entry in the open addressed set of accepted transaction ids. */
+typedef struct mock_agent_submitted mock_agent_submitted;
+
+struct mock_agent_submitted
+{
+    bool used;
+    uint8_t id[16];
+};
+
+/**
+ * \brief The blocks served by the mock agent, sorted by height, with an index
+ * sorted by id; the transactions it serves, sorted by id, with the latest
+ * transaction of each artifact sorted by artifact id; and the count of
+ * transactions submitted to it.
+ *
+ * Only the ids of submitted transactions are kept, so that a transaction is
+ * accepted once. If \ref drop_every is not zero, every drop_every-th
+ * submission is accepted, but closes the connection unanswered, as if the
+ * answer were lost.
+ */
+typedef struct mock_agent mock_agent;
+
+struct mock_agent
+{
+    mock_agent_block* blocks;
+    mock_agent_block** blocks_by_id;
+    size_t count;
+    vccrypt_buffer_t history_data;
+    bool history_loaded;
+    mock_agent_transaction* history;
+    size_t history_count;
+    mock_agent_transaction** latest;
+    size_t artifact_count;
+    uint64_t drop_every;
+    uint64_t submit_count;
+    uint64_t drop_count;
+    uint64_t transaction_count;
+    mock_agent_submitted* submitted;
+    size_t submitted_capacity;
+};
+
+/**
+ * \brief Load every block in a block directory.
+ *
+ * \param agent             The mock agent to initialize, which must be
+ *                          cleared.
+ * \param opts              The command-line options to use.
+ * \param dirname           The block directory.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT if two blocks share a height.
+ *      - a non-zero error code on failure.
+ */
+int mock_agent_load(
+    mock_agent* agent, commandline_opts* opts, const char* dirname);
+
+/**
+ * \brief Load the transactions in a file of concatenated transactions.
+ *
+ * The latest transaction of each artifact is the last one in the file.
+ *
+ * \param agent             The mock agent to update.
+ * \param opts              The command-line options to use.
+ * \param filename          The transaction file.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int mock_agent_load_transactions(
+    mock_agent* agent, commandline_opts* opts, const char* filename);
+
+/**
+ * \brief Dispose of a mock agent, freeing its blocks and transactions.
+ *
+ * \param agent             The mock agent to dispose.
+ */
+void mock_agent_dispose(mock_agent* agent);
+
+/**
+ * \brief Find a block by height.
+ *
+ * \param agent             The mock agent.
+ * \param height            The block height.
+ *
+ * \returns the block, or NULL if there is no block at this height.
+ */
+const mock_agent_block* mock_agent_find_by_height(
+    const mock_agent* agent, uint64_t height);
+
+/**
+ * \brief Find a block by id.
+ *
+ * \param agent             The mock agent.
+ * \param id                The block id.
+ *
+ * \returns the block, or NULL if there is no block with this id.
+ */
+const mock_agent_block* mock_agent_find_by_id(
+    const mock_agent* agent, const uint8_t* id);
+
+/**
+ * \brief Find a transaction by id.
+ *
+ * \param agent             The mock agent.
+ * \param id                The transaction id.
+ *
+ * \returns the transaction, or NULL if there is no transaction with this id.
+ */
+const mock_agent_transaction* mock_agent_find_transaction(
+    const mock_agent* agent, const uint8_t* id);
+
+/**
+ * \brief Find the latest transaction of an artifact.
+ *
+ * \param agent             The mock agent.
+ * \param artifact_id       The artifact id.
+ *
+ * \returns the transaction, or NULL if the artifact is not known.
+ */
+const mock_agent_transaction* mock_agent_find_artifact(
+    const mock_agent* agent, const uint8_t* artifact_id);
+
+/**
+ * \brief Perform the agent side of the vcblockchain handshake.
+ *
+ * The client must identify itself with the peer id, and must prove that it
+ * holds the private key matching the peer public key by answering the agent's
+ * challenge.
+ *
+ * \param conn              The unauthenticated connection.
+ * \param keys              The agent keys and the client public key.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED if the client is not the
+ *        expected client or fails the challenge.
+ *      - a non-zero error code on failure.
+ */
+int mock_agent_handshake(agent_connection* conn, const agent_keys* keys);
+
+/**
+ * \brief Answer every request on an authenticated connection until the client
+ * closes it.
+ *
+ * Requests are answered in the order they arrive, each with the offset of its
+ * request, so a window of pipelined requests is answered in turn.
+ *
+ * \param agent             The mock agent.
+ * \param conn              The authenticated client connection.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS when the client closes the connection, or when
+ *        a submission is dropped.
+ *      - a non-zero error code on failure.
+ */
+int mock_agent_serve(mock_agent* agent, agent_connection* conn);
+
+/**
+ * \brief Accept a submitted transaction.
+ *
+ * \param agent             The mock agent.
+ * \param req               The decoded transaction submit request.
+ *
+ * \returns the agent response status.
+ *      - AGENT_STATUS_SUCCESS if the transaction is accepted.
+ *      - MOCK_AGENT_STATUS_DROPPED if the transaction is accepted, but the
+ *        connection is to be closed without an answer.
+ *      - MOCK_AGENT_STATUS_BAD_REQUEST if the transaction is malformed, does
+ *        not match the ids in the request, or its id can't be recorded.
+ *      - MOCK_AGENT_STATUS_DUPLICATE if the transaction was already accepted.
+ */
+uint32_t mock_agent_submit(
+    mock_agent* agent, const protocol_req_transaction_submit* req);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,145 @@
+/**
+ * \file command/mock_agent/mock_agent_load.c
+ *
+ * \brief Load the blocks served by the mock agent.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "mock_agent_internal.h"
+
+/* forward decls. */
+static int mock_agent_compare_height(const void* lhs, const void* rhs);
+static int mock_agent_compare_id(const void* lhs, const void* rhs);
+
+/**
+ * \brief Load every block in a block directory.
+ *
+ * \param agent             The mock agent to initialize, which must be
+ *                          cleared.
+ * \param opts              The command-line options to use.
+ * \param dirname           The block directory.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT if two blocks share a height.
+ *      - a non-zero error code on failure.
+ */
+int mock_agent_load(
+    mock_agent* agent, commandline_opts* opts, const char* dirname)
+{
+    int retval;
+    verify_chain_batch batch;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != agent);
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+    MODEL_ASSERT(NULL != dirname);
+
+    /* find every block file. */
+    memset(&batch, 0, sizeof(batch));
+    batch.opts = opts;
+    retval = verify_chain_batch_read_directory(&batch, dirname);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_batch;
+    }
+
+    agent->blocks =
+        (mock_agent_block*)calloc(batch.job_count, sizeof(mock_agent_block));
+    agent->blocks_by_id =
+        (mock_agent_block**)calloc(batch.job_count, sizeof(mock_agent_block*));
+    if (NULL == agent->blocks || NULL == agent->blocks_by_id)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_agent;
+    }
+
+    /* read each block. */
+    for (size_t i = 0; i < batch.job_count; ++i)
+    {
+        mock_agent_block* block = &agent->blocks[i];
+
+        retval = verify_read_file(&block->cert, opts, batch.jobs[i].filename);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(stderr, "Error reading %s.\n", batch.jobs[i].filename);
+            goto cleanup_agent;
+        }
+
+        ++agent->count;
+
+        retval =
+            block_info_read(&block->info, block->cert.data, block->cert.size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(
+                stderr, "%s: %s.\n", batch.jobs[i].filename,
+                verify_error_message(retval));
+            goto cleanup_agent;
+        }
+    }
+
+    /* sort the blocks by height. */
+    qsort(
+        agent->blocks, agent->count, sizeof(mock_agent_block),
+        &mock_agent_compare_height);
+    for (size_t i = 1; i < agent->count; ++i)
+    {
+        if (agent->blocks[i - 1].info.height == agent->blocks[i].info.height)
+        {
+            fprintf(stderr, "Two blocks share a height.\n");
+            retval = VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT;
+            goto cleanup_agent;
+        }
+    }
+
+    /* index the blocks by id. */
+    for (size_t i = 0; i < agent->count; ++i)
+    {
+        agent->blocks_by_id[i] = &agent->blocks[i];
+    }
+
+    qsort(
+        agent->blocks_by_id, agent->count, sizeof(mock_agent_block*),
+        &mock_agent_compare_id);
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_batch;
+
+cleanup_agent:
+    mock_agent_dispose(agent);
+
+cleanup_batch:
+    verify_chain_batch_dispose(&batch);
+
+    return retval;
+}
+
+/**
+ * \brief Compare two blocks by height.
+ */
+static int mock_agent_compare_height(const void* lhs, const void* rhs)
+{
+    const mock_agent_block* l = (const mock_agent_block*)lhs;
+    const mock_agent_block* r = (const mock_agent_block*)rhs;
+
+    if (l->info.height < r->info.height)
+    {
+        return -1;
+    }
+
+    return (l->info.height > r->info.height) ? 1 : 0;
+}
+
+/**
+ * \brief Compare two block pointers by block id.
+ */
+static int mock_agent_compare_id(const void* lhs, const void* rhs)
+{
+    const mock_agent_block* l = *(const mock_agent_block* const*)lhs;
+    const mock_agent_block* r = *(const mock_agent_block* const*)rhs;
+
+    return memcmp(l->info.block_id, r->info.block_id, BLOCK_ID_SIZE);
+}
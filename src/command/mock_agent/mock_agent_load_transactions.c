@@ -0,0 +1,189 @@
+/**
+ * \file command/mock_agent/mock_agent_load_transactions.c
+ *
+ * \brief Load the transactions served by the mock agent.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "mock_agent_internal.h"
+
+/* forward decls. */
+static int mock_agent_compare_transaction_id(const void* lhs, const void* rhs);
+static int mock_agent_compare_artifact(const void* lhs, const void* rhs);
+
+/**
+ * \brief Load the transactions in a file of concatenated transactions.
+ *
+ * The latest transaction of each artifact is the last one in the file.
+ *
+ * \param agent             The mock agent to update.
+ * \param opts              The command-line options to use.
+ * \param filename          The transaction file.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int mock_agent_load_transactions(
+    mock_agent* agent, commandline_opts* opts, const char* filename)
+{
+    int retval;
+    size_t offset = 0;
+    size_t capacity = 0;
+    const uint8_t* cert;
+    size_t cert_size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != agent);
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+    MODEL_ASSERT(NULL != filename);
+    MODEL_ASSERT(!agent->history_loaded);
+
+    /* the transactions point into this buffer. */
+    retval = verify_read_file(&agent->history_data, opts, filename);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error reading %s.\n", filename);
+        return retval;
+    }
+
+    agent->history_loaded = true;
+
+    /* split the transactions. */
+    while (offset < agent->history_data.size)
+    {
+        retval =
+            certificate_stream_next(
+                &cert, &cert_size, &offset, agent->history_data.data,
+                agent->history_data.size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(
+                stderr, "%s: %s.\n", filename, verify_error_message(retval));
+            return retval;
+        }
+
+        /* grow the array if needed. */
+        if (agent->history_count == capacity)
+        {
+            capacity = capacity ? 2 * capacity : 1024;
+            mock_agent_transaction* grown =
+                (mock_agent_transaction*)realloc(
+                    agent->history, capacity * sizeof(mock_agent_transaction));
+            if (NULL == grown)
+            {
+                return VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+            }
+
+            agent->history = grown;
+        }
+
+        mock_agent_transaction* txn = &agent->history[agent->history_count];
+        retval = transaction_info_read(&txn->info, cert, cert_size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(
+                stderr, "%s: transaction %zu is malformed.\n", filename,
+                agent->history_count);
+            return retval;
+        }
+
+        txn->cert = cert;
+        txn->cert_size = cert_size;
+        txn->index = agent->history_count;
+        ++agent->history_count;
+    }
+
+    if (0 == agent->history_count)
+    {
+        return VCTOOL_STATUS_SUCCESS;
+    }
+
+    /* sort the transactions by id. */
+    qsort(
+        agent->history, agent->history_count, sizeof(mock_agent_transaction),
+        &mock_agent_compare_transaction_id);
+    for (size_t i = 1; i < agent->history_count; ++i)
+    {
+        if (
+            0 == memcmp(
+                    agent->history[i - 1].info.transaction_id,
+                    agent->history[i].info.transaction_id,
+                    TRANSACTION_ID_SIZE))
+        {
+            fprintf(stderr, "%s: two transactions share an id.\n", filename);
+            return VCTOOL_ERROR_TRANSACTION_BAD_VALUE;
+        }
+    }
+
+    /* find the latest transaction of each artifact. */
+    agent->latest =
+        (mock_agent_transaction**)malloc(
+            agent->history_count * sizeof(mock_agent_transaction*));
+    if (NULL == agent->latest)
+    {
+        return VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    for (size_t i = 0; i < agent->history_count; ++i)
+    {
+        agent->latest[i] = &agent->history[i];
+    }
+
+    qsort(
+        agent->latest, agent->history_count, sizeof(mock_agent_transaction*),
+        &mock_agent_compare_artifact);
+
+    /* keep the last transaction of each run of the same artifact. */
+    for (size_t i = 0; i < agent->history_count; ++i)
+    {
+        if (
+            i + 1 < agent->history_count
+         && 0 == memcmp(
+                    agent->latest[i]->info.artifact_id,
+                    agent->latest[i + 1]->info.artifact_id,
+                    TRANSACTION_ID_SIZE))
+        {
+            continue;
+        }
+
+        agent->latest[agent->artifact_count++] = agent->latest[i];
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Compare two transactions by id.
+ */
+static int mock_agent_compare_transaction_id(const void* lhs, const void* rhs)
+{
+    const mock_agent_transaction* l = (const mock_agent_transaction*)lhs;
+    const mock_agent_transaction* r = (const mock_agent_transaction*)rhs;
+
+    return
+        memcmp(
+            l->info.transaction_id, r->info.transaction_id,
+            TRANSACTION_ID_SIZE);
+}
+
+/**
+ * \brief Compare two transaction pointers by artifact id, then file order.
+ */
+static int mock_agent_compare_artifact(const void* lhs, const void* rhs)
+{
+    const mock_agent_transaction* l =
+        *(const mock_agent_transaction* const*)lhs;
+    const mock_agent_transaction* r =
+        *(const mock_agent_transaction* const*)rhs;
+
+    int cmp =
+        memcmp(l->info.artifact_id, r->info.artifact_id, TRANSACTION_ID_SIZE);
+    if (0 != cmp)
+    {
+        return cmp;
+    }
+
+    return (l->index > r->index) - (l->index < r->index);
+}
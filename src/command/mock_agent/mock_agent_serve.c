@@ -0,0 +1,526 @@
+/**
+ * \file command/mock_agent/mock_agent_serve.c
+ *
+ * \brief Answer the requests on a mock agent connection.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <arpa/inet.h>
+
+#include "mock_agent_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/* forward decls. */
+static int mock_agent_answer(
+    mock_agent* agent, agent_connection* conn, const void* data,
+    uint32_t size, bool* dropped);
+static int mock_agent_answer_block_id_get(
+    const mock_agent* agent, vccrypt_buffer_t* response,
+    allocator_options_t* alloc_opts, uint32_t offset, const void* data,
+    uint32_t size);
+static int mock_agent_answer_block_get(
+    const mock_agent* agent, vccrypt_buffer_t* response,
+    allocator_options_t* alloc_opts, uint32_t offset, const void* data,
+    uint32_t size);
+static int mock_agent_answer_transaction_get(
+    const mock_agent* agent, vccrypt_buffer_t* response,
+    allocator_options_t* alloc_opts, uint32_t offset, const void* data,
+    uint32_t size);
+static int mock_agent_answer_artifact_get(
+    const mock_agent* agent, vccrypt_buffer_t* response,
+    allocator_options_t* alloc_opts, uint32_t offset, const void* data,
+    uint32_t size);
+static int mock_agent_answer_submit(
+    mock_agent* agent, vccrypt_buffer_t* response,
+    allocator_options_t* alloc_opts, uint32_t offset, const void* data,
+    uint32_t size, bool* dropped);
+static int mock_agent_respond(
+    agent_connection* conn, vccrypt_buffer_t* response);
+
+/**
+ * \brief Answer every request on an authenticated connection until the client
+ * closes it.
+ *
+ * Requests are answered in the order they arrive, each with the offset of its
+ * request, so a window of pipelined requests is answered in turn.
+ *
+ * \param agent             The mock agent.
+ * \param conn              The authenticated client connection.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS when the client closes the connection, or when
+ *        a submission is dropped.
+ *      - a non-zero error code on failure.
+ */
+int mock_agent_serve(mock_agent* agent, agent_connection* conn)
+{
+    int retval;
+    void* data;
+    uint32_t size;
+    bool dropped = false;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != agent);
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(conn->authenticated);
+
+    for (;;)
+    {
+        /* a client that closes the connection ends the session. */
+        retval =
+            vcblockchain_psock_read_authed_data(
+                conn->sock, conn->alloc, conn->client_iv, &data, &size,
+                conn->suite, &conn->shared_secret);
+        if (STATUS_SUCCESS != retval)
+        {
+            return VCTOOL_STATUS_SUCCESS;
+        }
+
+        ++conn->client_iv;
+
+        retval = mock_agent_answer(agent, conn, data, size, &dropped);
+        rcpr_allocator_reclaim(conn->alloc, data);
+        if (VCTOOL_STATUS_SUCCESS != retval || dropped)
+        {
+            return retval;
+        }
+    }
+}
+
+/**
+ * \brief Answer a single request.
+ *
+ * \param agent             The mock agent.
+ * \param conn              The client connection.
+ * \param data              The request.
+ * \param size              The size of the request.
+ * \param dropped           Set to true if the request is dropped unanswered.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int mock_agent_answer(
+    mock_agent* agent, agent_connection* conn, const void* data,
+    uint32_t size, bool* dropped)
+{
+    int retval;
+    uint32_t request_id, offset;
+    vccrypt_buffer_t response;
+    allocator_options_t* alloc_opts = conn->suite->alloc_opts;
+    const mock_agent_block* block;
+    RCPR_SYM(rcpr_uuid) id;
+
+    /* every request starts with its id and offset. */
+    if (size < 2 * sizeof(uint32_t))
+    {
+        return VCTOOL_ERROR_AGENT_PROTOCOL;
+    }
+
+    memcpy(&request_id, data, sizeof(request_id));
+    memcpy(&offset, (const uint8_t*)data + sizeof(request_id), sizeof(offset));
+    request_id = ntohl(request_id);
+    offset = ntohl(offset);
+
+    switch (request_id)
+    {
+        case PROTOCOL_REQ_ID_LATEST_BLOCK_ID_GET:
+            if (0 == agent->count)
+            {
+                retval =
+                    vcblockchain_protocol_encode_error_resp(
+                        &response, alloc_opts, request_id,
+                        MOCK_AGENT_STATUS_NOT_FOUND, offset);
+                break;
+            }
+
+            block = &agent->blocks[agent->count - 1];
+            memcpy(&id, block->info.block_id, sizeof(id));
+            retval =
+                vcblockchain_protocol_encode_resp_latest_block_id_get(
+                    &response, alloc_opts, offset, AGENT_STATUS_SUCCESS, &id);
+            break;
+
+        case PROTOCOL_REQ_ID_BLOCK_ID_BY_HEIGHT_GET:
+            retval =
+                mock_agent_answer_block_id_get(
+                    agent, &response, alloc_opts, offset, data, size);
+            break;
+
+        case PROTOCOL_REQ_ID_BLOCK_BY_ID_GET:
+            retval =
+                mock_agent_answer_block_get(
+                    agent, &response, alloc_opts, offset, data, size);
+            break;
+
+        case PROTOCOL_REQ_ID_TRANSACTION_BY_ID_GET:
+            retval =
+                mock_agent_answer_transaction_get(
+                    agent, &response, alloc_opts, offset, data, size);
+            break;
+
+        case PROTOCOL_REQ_ID_ARTIFACT_GET:
+            retval =
+                mock_agent_answer_artifact_get(
+                    agent, &response, alloc_opts, offset, data, size);
+            break;
+
+        case PROTOCOL_REQ_ID_TRANSACTION_SUBMIT:
+            retval =
+                mock_agent_answer_submit(
+                    agent, &response, alloc_opts, offset, data, size,
+                    dropped);
+            break;
+
+        default:
+            retval =
+                vcblockchain_protocol_encode_error_resp(
+                    &response, alloc_opts, request_id,
+                    MOCK_AGENT_STATUS_BAD_REQUEST, offset);
+            break;
+    }
+
+    if (STATUS_SUCCESS != retval)
+    {
+        return VCTOOL_ERROR_AGENT_PROTOCOL;
+    }
+    else if (*dropped)
+    {
+        return VCTOOL_STATUS_SUCCESS;
+    }
+
+    return mock_agent_respond(conn, &response);
+}
+
+/**
+ * \brief Encode the answer to a block id by height request.
+ *
+ * \param agent             The mock agent.
+ * \param response          Buffer to be initialized with the response.
+ * \param alloc_opts        The allocator options for the response.
+ * \param offset            The request offset.
+ * \param data              The request.
+ * \param size              The size of the request.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int mock_agent_answer_block_id_get(
+    const mock_agent* agent, vccrypt_buffer_t* response,
+    allocator_options_t* alloc_opts, uint32_t offset, const void* data,
+    uint32_t size)
+{
+    int retval;
+    protocol_req_block_id_by_height_get req;
+    const mock_agent_block* block;
+    RCPR_SYM(rcpr_uuid) block_id;
+
+    retval =
+        vcblockchain_protocol_decode_req_block_id_by_height_get(
+            &req, alloc_opts, data, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return
+            vcblockchain_protocol_encode_error_resp(
+                response, alloc_opts, PROTOCOL_REQ_ID_BLOCK_ID_BY_HEIGHT_GET,
+                MOCK_AGENT_STATUS_BAD_REQUEST, offset);
+    }
+
+    block = mock_agent_find_by_height(agent, req.block_height);
+    dispose((disposable_t*)&req);
+    if (NULL == block)
+    {
+        return
+            vcblockchain_protocol_encode_error_resp(
+                response, alloc_opts, PROTOCOL_REQ_ID_BLOCK_ID_BY_HEIGHT_GET,
+                MOCK_AGENT_STATUS_NOT_FOUND, offset);
+    }
+
+    memcpy(&block_id, block->info.block_id, sizeof(block_id));
+
+    return
+        vcblockchain_protocol_encode_resp_block_id_by_height_get(
+            response, alloc_opts, offset, AGENT_STATUS_SUCCESS, &block_id);
+}
+
+/**
+ * \brief Encode the answer to a block get request.
+ *
+ * The mock agent does not index the transactions in its blocks, so the first
+ * transaction id of each block is answered as the zero id.
+ *
+ * \param agent             The mock agent.
+ * \param response          Buffer to be initialized with the response.
+ * \param alloc_opts        The allocator options for the response.
+ * \param offset            The request offset.
+ * \param data              The request.
+ * \param size              The size of the request.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int mock_agent_answer_block_get(
+    const mock_agent* agent, vccrypt_buffer_t* response,
+    allocator_options_t* alloc_opts, uint32_t offset, const void* data,
+    uint32_t size)
+{
+    int retval;
+    protocol_req_block_get req;
+    const mock_agent_block* block;
+    const mock_agent_block* next;
+    RCPR_SYM(rcpr_uuid) block_id, prev_id, next_id, first_txn_id;
+
+    retval =
+        vcblockchain_protocol_decode_req_block_get(
+            &req, alloc_opts, data, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return
+            vcblockchain_protocol_encode_error_resp(
+                response, alloc_opts, PROTOCOL_REQ_ID_BLOCK_BY_ID_GET,
+                MOCK_AGENT_STATUS_BAD_REQUEST, offset);
+    }
+
+    block = mock_agent_find_by_id(agent, req.block_id.data);
+    dispose((disposable_t*)&req);
+    if (NULL == block)
+    {
+        return
+            vcblockchain_protocol_encode_error_resp(
+                response, alloc_opts, PROTOCOL_REQ_ID_BLOCK_BY_ID_GET,
+                MOCK_AGENT_STATUS_NOT_FOUND, offset);
+    }
+
+    /* the latest block has no next block. */
+    memset(&next_id, 0, sizeof(next_id));
+    next = mock_agent_find_by_height(agent, block->info.height + 1);
+    if (NULL != next)
+    {
+        memcpy(&next_id, next->info.block_id, sizeof(next_id));
+    }
+
+    memcpy(&block_id, block->info.block_id, sizeof(block_id));
+    memcpy(&prev_id, block->info.previous_block_id, sizeof(prev_id));
+    memset(&first_txn_id, 0, sizeof(first_txn_id));
+
+    return
+        vcblockchain_protocol_encode_resp_block_get(
+            response, alloc_opts, offset, AGENT_STATUS_SUCCESS, &block_id,
+            &prev_id, &next_id, &first_txn_id, block->info.height,
+            &block->cert);
+}
+
+/**
+ * \brief Encode the answer to a transaction get request.
+ *
+ * The mock agent does not index the blocks of its transactions or the
+ * transactions that follow them, so the next transaction id and the block id
+ * are answered as the zero id.
+ *
+ * \param agent             The mock agent.
+ * \param response          Buffer to be initialized with the response.
+ * \param alloc_opts        The allocator options for the response.
+ * \param offset            The request offset.
+ * \param data              The request.
+ * \param size              The size of the request.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int mock_agent_answer_transaction_get(
+    const mock_agent* agent, vccrypt_buffer_t* response,
+    allocator_options_t* alloc_opts, uint32_t offset, const void* data,
+    uint32_t size)
+{
+    int retval;
+    protocol_req_transaction_get req;
+    const mock_agent_transaction* txn;
+    RCPR_SYM(rcpr_uuid) txn_id, prev_id, next_id, artifact_id, block_id;
+
+    retval =
+        vcblockchain_protocol_decode_req_transaction_get(
+            &req, alloc_opts, data, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return
+            vcblockchain_protocol_encode_error_resp(
+                response, alloc_opts, PROTOCOL_REQ_ID_TRANSACTION_BY_ID_GET,
+                MOCK_AGENT_STATUS_BAD_REQUEST, offset);
+    }
+
+    txn = mock_agent_find_transaction(agent, req.txn_id.data);
+    dispose((disposable_t*)&req);
+    if (NULL == txn)
+    {
+        return
+            vcblockchain_protocol_encode_error_resp(
+                response, alloc_opts, PROTOCOL_REQ_ID_TRANSACTION_BY_ID_GET,
+                MOCK_AGENT_STATUS_NOT_FOUND, offset);
+    }
+
+    memcpy(&txn_id, txn->info.transaction_id, sizeof(txn_id));
+    memcpy(&prev_id, txn->info.previous_transaction_id, sizeof(prev_id));
+    memcpy(&artifact_id, txn->info.artifact_id, sizeof(artifact_id));
+    memset(&next_id, 0, sizeof(next_id));
+    memset(&block_id, 0, sizeof(block_id));
+
+    return
+        vcblockchain_protocol_encode_resp_transaction_get(
+            response, alloc_opts, offset, AGENT_STATUS_SUCCESS, &txn_id,
+            &prev_id, &next_id, &artifact_id, &block_id, txn->cert,
+            txn->cert_size);
+}
+
+/**
+ * \brief Encode the answer to an artifact get request.
+ *
+ * The first transaction is found by following the previous transaction ids
+ * back from the latest. The mock agent does not index blocks, so the heights
+ * and the state are answered as zero.
+ *
+ * \param agent             The mock agent.
+ * \param response          Buffer to be initialized with the response.
+ * \param alloc_opts        The allocator options for the response.
+ * \param offset            The request offset.
+ * \param data              The request.
+ * \param size              The size of the request.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int mock_agent_answer_artifact_get(
+    const mock_agent* agent, vccrypt_buffer_t* response,
+    allocator_options_t* alloc_opts, uint32_t offset, const void* data,
+    uint32_t size)
+{
+    int retval;
+    protocol_req_artifact_get req;
+    const mock_agent_transaction* latest;
+    const mock_agent_transaction* first;
+    const mock_agent_transaction* prev;
+    RCPR_SYM(rcpr_uuid) artifact_id, first_id, latest_id;
+
+    retval =
+        vcblockchain_protocol_decode_req_artifact_get(
+            &req, alloc_opts, data, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return
+            vcblockchain_protocol_encode_error_resp(
+                response, alloc_opts, PROTOCOL_REQ_ID_ARTIFACT_GET,
+                MOCK_AGENT_STATUS_BAD_REQUEST, offset);
+    }
+
+    latest = mock_agent_find_artifact(agent, req.artifact_id.data);
+    dispose((disposable_t*)&req);
+    if (NULL == latest)
+    {
+        return
+            vcblockchain_protocol_encode_error_resp(
+                response, alloc_opts, PROTOCOL_REQ_ID_ARTIFACT_GET,
+                MOCK_AGENT_STATUS_NOT_FOUND, offset);
+    }
+
+    /* a cycle in the previous ids can't be longer than the transactions. */
+    first = latest;
+    for (size_t i = 0; i < agent->history_count; ++i)
+    {
+        prev =
+            mock_agent_find_transaction(
+                agent, first->info.previous_transaction_id);
+        if (NULL == prev)
+        {
+            break;
+        }
+
+        first = prev;
+    }
+
+    memcpy(&artifact_id, latest->info.artifact_id, sizeof(artifact_id));
+    memcpy(&first_id, first->info.transaction_id, sizeof(first_id));
+    memcpy(&latest_id, latest->info.transaction_id, sizeof(latest_id));
+
+    return
+        vcblockchain_protocol_encode_resp_artifact_get(
+            response, alloc_opts, offset, AGENT_STATUS_SUCCESS, &artifact_id,
+            &first_id, &latest_id, 0, 0, 0);
+}
+
+/**
+ * \brief Encode the answer to a transaction submit request.
+ *
+ * A dropped submission is not answered, and no response is encoded.
+ *
+ * \param agent             The mock agent.
+ * \param response          Buffer to be initialized with the response.
+ * \param alloc_opts        The allocator options for the response.
+ * \param offset            The request offset.
+ * \param data              The request.
+ * \param size              The size of the request.
+ * \param dropped           Set to true if the submission is dropped.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int mock_agent_answer_submit(
+    mock_agent* agent, vccrypt_buffer_t* response,
+    allocator_options_t* alloc_opts, uint32_t offset, const void* data,
+    uint32_t size, bool* dropped)
+{
+    int retval;
+    protocol_req_transaction_submit req;
+    uint32_t status;
+
+    retval =
+        vcblockchain_protocol_decode_req_transaction_submit(
+            &req, alloc_opts, data, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return
+            vcblockchain_protocol_encode_error_resp(
+                response, alloc_opts, PROTOCOL_REQ_ID_TRANSACTION_SUBMIT,
+                MOCK_AGENT_STATUS_BAD_REQUEST, offset);
+    }
+
+    status = mock_agent_submit(agent, &req);
+    dispose((disposable_t*)&req);
+    if (MOCK_AGENT_STATUS_DROPPED == status)
+    {
+        *dropped = true;
+        return STATUS_SUCCESS;
+    }
+    else if (AGENT_STATUS_SUCCESS != status)
+    {
+        return
+            vcblockchain_protocol_encode_error_resp(
+                response, alloc_opts, PROTOCOL_REQ_ID_TRANSACTION_SUBMIT,
+                status, offset);
+    }
+
+    return
+        vcblockchain_protocol_encode_resp_transaction_submit(
+            response, alloc_opts, offset, AGENT_STATUS_SUCCESS);
+}
+
+/**
+ * \brief Send a response, and dispose it.
+ *
+ * \param conn              The client connection.
+ * \param response          The encoded response.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int mock_agent_respond(
+    agent_connection* conn, vccrypt_buffer_t* response)
+{
+    int retval;
+
+    retval =
+        vcblockchain_psock_write_authed_data(
+            conn->sock, conn->server_iv, response->data, response->size,
+            conn->suite, &conn->shared_secret);
+    dispose((disposable_t*)response);
+    if (STATUS_SUCCESS != retval)
+    {
+        return VCTOOL_ERROR_AGENT_IO;
+    }
+
+    ++conn->server_iv;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
@@ -0,0 +1,163 @@
+/**
+ * \file command/mock_agent/mock_agent_submit.c
+ *
+ * \brief Accept a transaction submitted to the mock agent.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <vccrypt/compare.h>
+
+#include "mock_agent_internal.h"
+
+/* forward decls. */
+static mock_agent_submitted* mock_agent_submitted_find(
+    mock_agent_submitted* table, size_t capacity, const uint8_t* id);
+static bool mock_agent_submitted_reserve(mock_agent* agent);
+
+/**
+ * \brief Accept a submitted transaction.
+ *
+ * \param agent             The mock agent.
+ * \param req               The decoded transaction submit request.
+ *
+ * \returns the agent response status.
+ *      - AGENT_STATUS_SUCCESS if the transaction is accepted.
+ *      - MOCK_AGENT_STATUS_DROPPED if the transaction is accepted, but the
+ *        connection is to be closed without an answer.
+ *      - MOCK_AGENT_STATUS_BAD_REQUEST if the transaction is malformed, does
+ *        not match the ids in the request, or its id can't be recorded.
+ *      - MOCK_AGENT_STATUS_DUPLICATE if the transaction was already accepted.
+ */
+uint32_t mock_agent_submit(
+    mock_agent* agent, const protocol_req_transaction_submit* req)
+{
+    size_t signed_size, signature_size;
+    const uint8_t* signature;
+    transaction_info info;
+    mock_agent_submitted* entry;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != agent);
+    MODEL_ASSERT(NULL != req);
+
+    /* the transaction must be signed, and must be the one named. */
+    if (VCTOOL_STATUS_SUCCESS !=
+            certificate_find_signature(
+                &signed_size, &signature, &signature_size,
+                req->certificate.data, req->certificate.size)
+     || VCTOOL_STATUS_SUCCESS !=
+            transaction_info_read(
+                &info, req->certificate.data, req->certificate.size)
+     || crypto_memcmp(
+            info.transaction_id, req->txn_id.data, sizeof(req->txn_id))
+     || crypto_memcmp(
+            info.artifact_id, req->artifact_id.data,
+            sizeof(req->artifact_id)))
+    {
+        return MOCK_AGENT_STATUS_BAD_REQUEST;
+    }
+
+    /* a transaction is only accepted once. */
+    if (!mock_agent_submitted_reserve(agent))
+    {
+        return MOCK_AGENT_STATUS_BAD_REQUEST;
+    }
+
+    entry =
+        mock_agent_submitted_find(
+            agent->submitted, agent->submitted_capacity,
+            info.transaction_id);
+    if (entry->used)
+    {
+        return MOCK_AGENT_STATUS_DUPLICATE;
+    }
+
+    entry->used = true;
+    memcpy(entry->id, info.transaction_id, sizeof(entry->id));
+    ++agent->transaction_count;
+
+    /* periodically lose the answer by dropping the connection, so that
+     * client reconnects and resubmissions can be tested. */
+    ++agent->submit_count;
+    if (0 != agent->drop_every && 0 == agent->submit_count % agent->drop_every)
+    {
+        ++agent->drop_count;
+        return MOCK_AGENT_STATUS_DROPPED;
+    }
+
+    return AGENT_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Find the entry for an id, or the free entry where it belongs.
+ *
+ * \param table             The open addressed table, which must have a free
+ *                          entry.
+ * \param capacity          The size of the table, a power of two.
+ * \param id                The transaction id.
+ *
+ * \returns the entry holding this id, or the free entry for it.
+ */
+static mock_agent_submitted* mock_agent_submitted_find(
+    mock_agent_submitted* table, size_t capacity, const uint8_t* id)
+{
+    uint64_t hash;
+
+    /* transaction ids are random, so their leading bytes are a fine hash. */
+    memcpy(&hash, id, sizeof(hash));
+
+    for (size_t i = (size_t)hash & (capacity - 1); ;
+         i = (i + 1) & (capacity - 1))
+    {
+        if (!table[i].used || !memcmp(table[i].id, id, sizeof(table[i].id)))
+        {
+            return &table[i];
+        }
+    }
+}
+
+/**
+ * \brief Make room for one more accepted id, keeping the table at most half
+ * full.
+ *
+ * \param agent             The mock agent.
+ *
+ * \returns true if there is room, or false if the table can't be grown.
+ */
+static bool mock_agent_submitted_reserve(mock_agent* agent)
+{
+    mock_agent_submitted* table;
+    size_t capacity;
+
+    if (2 * (agent->transaction_count + 1) <= agent->submitted_capacity)
+    {
+        return true;
+    }
+
+    capacity =
+        agent->submitted_capacity ? 2 * agent->submitted_capacity : 1024;
+    table =
+        (mock_agent_submitted*)calloc(capacity, sizeof(mock_agent_submitted));
+    if (NULL == table)
+    {
+        return false;
+    }
+
+    /* move every accepted id to the new table. */
+    for (size_t i = 0; i < agent->submitted_capacity; ++i)
+    {
+        if (agent->submitted[i].used)
+        {
+            *mock_agent_submitted_find(
+                table, capacity, agent->submitted[i].id) =
+                    agent->submitted[i];
+        }
+    }
+
+    free(agent->submitted);
+    agent->submitted = table;
+    agent->submitted_capacity = capacity;
+
+    return true;
+}
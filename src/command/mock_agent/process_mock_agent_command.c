@@ -0,0 +1,66 @@
+/**
+ * \file command/mock_agent/process_mock_agent_command.c
+ *
+ * \brief Process command-line options to build a mock-agent command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/root.h>
+#include <vctool/command/mock_agent.h>
+#include <vctool/commandline.h>
+#include <vctool/status_codes.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Process the mock-agent command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_mock_agent_command(
+    commandline_opts* opts, int UNUSED(argc), char* UNUSED(argv[]))
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* allocate memory for a mock_agent_command structure. */
+    mock_agent_command* mock_agent =
+        (mock_agent_command*)malloc(sizeof(mock_agent_command));
+    if (NULL == mock_agent)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* initialize the structure. */
+    retval = mock_agent_command_init(mock_agent);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto free_verify;
+    }
+
+    /* set mock-agent command as the head of opts command. */
+    mock_agent->hdr.next = opts->cmd;
+    opts->cmd = &mock_agent->hdr;
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto done;
+
+free_verify:
+    free(mock_agent);
+
+done:
+    return retval;
+}
@@ -0,0 +1,77 @@
+/**
+ * \file command/pubkey/pubkey_batch_add_job.c
+ *
+ * \brief Add a job to a pubkey batch.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "pubkey_internal.h"
+
+/**
+ * \brief Add a job to the batch.
+ *
+ * \param batch             The batch to which this job is added.
+ * \param key_filename      The keypair file to read.
+ * \param output_filename   The public certificate file to write.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_add_job(
+    pubkey_batch* batch, const char* key_filename,
+    const char* output_filename)
+{
+    int retval;
+    pubkey_job* job;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(NULL != key_filename);
+    MODEL_ASSERT(NULL != output_filename);
+
+    /* grow the job array if needed. */
+    if (batch->job_count == batch->job_capacity)
+    {
+        size_t capacity = batch->job_capacity ? 2 * batch->job_capacity : 16;
+        pubkey_job* jobs =
+            (pubkey_job*)realloc(batch->jobs, capacity * sizeof(pubkey_job));
+        if (NULL == jobs)
+        {
+            retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+            goto done;
+        }
+
+        batch->jobs = jobs;
+        batch->job_capacity = capacity;
+    }
+
+    /* initialize the job. */
+    job = &batch->jobs[batch->job_count];
+    memset(job, 0, sizeof(*job));
+    job->key_filename = strdup(key_filename);
+    if (NULL == job->key_filename)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    job->output_filename = strdup(output_filename);
+    if (NULL == job->output_filename)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto free_key_filename;
+    }
+
+    /* success. */
+    ++batch->job_count;
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto done;
+
+free_key_filename:
+    free(job->key_filename);
+
+done:
+    return retval;
+}
@@ -0,0 +1,100 @@
+/**
+ * \file command/pubkey/pubkey_batch_add_keypair.c
+ *
+ * \brief Add a keypair to a pubkey batch, deriving its output filename.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <libgen.h>
+
+#include "pubkey_internal.h"
+
+/**
+ * \brief Add a job for the given keypair file, deriving the output filename.
+ *
+ * The output file is the keypair filename with ".pub" appended. If an output
+ * directory is given, then the output file is placed in this directory instead
+ * of alongside the keypair file.
+ *
+ * \param batch             The batch to which this job is added.
+ * \param key_filename      The keypair file to read.
+ * \param output_dir        The optional output directory, or NULL.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_add_keypair(
+    pubkey_batch* batch, const char* key_filename, const char* output_dir)
+{
+    int retval;
+    char* output_filename;
+    char* key_filename_copy = NULL;
+    size_t output_filename_length;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(NULL != key_filename);
+
+    /* the output file lives alongside the keypair file. */
+    if (NULL == output_dir)
+    {
+        output_filename_length =
+            strlen(key_filename)
+          + 4 /* .pub */
+          + 1;/* asciiz */
+
+        output_filename = (char*)malloc(output_filename_length);
+        if (NULL == output_filename)
+        {
+            retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+            goto done;
+        }
+
+        snprintf(
+            output_filename, output_filename_length, "%s.pub", key_filename);
+    }
+    /* the output file lives in the output directory. */
+    else
+    {
+        /* basename may modify its argument, so use a copy. */
+        key_filename_copy = strdup(key_filename);
+        if (NULL == key_filename_copy)
+        {
+            retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+            goto done;
+        }
+
+        const char* base = basename(key_filename_copy);
+        output_filename_length =
+            strlen(output_dir)
+          + 1 /* / */
+          + strlen(base)
+          + 4 /* .pub */
+          + 1;/* asciiz */
+
+        output_filename = (char*)malloc(output_filename_length);
+        if (NULL == output_filename)
+        {
+            retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+            goto free_key_filename_copy;
+        }
+
+        snprintf(
+            output_filename, output_filename_length, "%s/%s.pub", output_dir,
+            base);
+    }
+
+    /* add the job. */
+    retval = pubkey_batch_add_job(batch, key_filename, output_filename);
+    /* fall-through. */
+
+    free(output_filename);
+
+free_key_filename_copy:
+    free(key_filename_copy);
+
+done:
+    return retval;
+}
@@ -0,0 +1,49 @@
+/**
+ * \file command/pubkey/pubkey_batch_dispose.c
+ *
+ * \brief Dispose of a pubkey batch.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "pubkey_internal.h"
+
+RCPR_IMPORT_rbtree;
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Dispose of a pubkey batch, freeing jobs, the cached password, and the
+ * derived key cache.
+ *
+ * \param batch         The batch to dispose.
+ */
+void pubkey_batch_dispose(pubkey_batch* batch)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+
+    /* free the jobs. */
+    for (size_t i = 0; i < batch->job_count; ++i)
+    {
+        free(batch->jobs[i].key_filename);
+        free(batch->jobs[i].output_filename);
+    }
+    free(batch->jobs);
+
+    /* the password is only initialized if it was successfully read. */
+    if (batch->password_read && VCTOOL_STATUS_SUCCESS == batch->password_status)
+    {
+        dispose((disposable_t*)&batch->password);
+    }
+
+    /* release the derived key cache, which disposes the cached keys. */
+    resource_release(rbtree_resource_handle(batch->key_cache));
+
+    /* destroy the locks. */
+    pthread_mutex_destroy(&batch->password_lock);
+    pthread_mutex_destroy(&batch->cache_lock);
+    pthread_cond_destroy(&batch->cache_ready);
+
+    /* clear the batch. */
+    memset(batch, 0, sizeof(*batch));
+}
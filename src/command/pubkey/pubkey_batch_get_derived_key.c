@@ -0,0 +1,129 @@
+/**
+ * \file command/pubkey/pubkey_batch_get_derived_key.c
+ *
+ * \brief Get the cached derived key for an encrypted certificate.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "pubkey_internal.h"
+
+RCPR_IMPORT_rbtree;
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Get the derived key for an encrypted certificate, deriving it from the
+ * batch passphrase only if no key for this salt and rounds is cached.
+ *
+ * The first worker to look up a salt inserts a pending entry and derives the
+ * key outside of the cache lock, so workers deriving keys for different salts
+ * run in parallel. Later workers for the same salt wait for this entry to be
+ * ready instead of deriving the key again.
+ *
+ * \param derived_key       Pointer to receive the cached derived key. This key
+ *                          is owned by the batch.
+ * \param batch             The batch holding the key cache.
+ * \param encrypted_cert    The encrypted certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_get_derived_key(
+    const vccrypt_buffer_t** derived_key, pubkey_batch* batch,
+    const vccrypt_buffer_t* encrypted_cert)
+{
+    int retval;
+    unsigned int rounds;
+    vccrypt_buffer_t salt;
+    pubkey_key_cache_key key;
+    pubkey_key_cache_entry* entry;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != derived_key);
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(NULL != encrypted_cert);
+
+    /* read the salt and rounds for this certificate. */
+    retval =
+        certificate_read_key_derivation_parameters(
+            batch->opts->suite, &salt, &rounds, encrypted_cert);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* build the lookup key. */
+    key.rounds = rounds;
+    key.salt = (const uint8_t*)salt.data;
+    key.salt_size = salt.size;
+
+    /* look for a cached or pending key. */
+    pthread_mutex_lock(&batch->cache_lock);
+    retval = rbtree_find((resource**)&entry, batch->key_cache, &key);
+    if (STATUS_SUCCESS == retval)
+    {
+        /* wait for the worker deriving this key. */
+        while (!entry->ready)
+        {
+            pthread_cond_wait(&batch->cache_ready, &batch->cache_lock);
+        }
+
+        retval = entry->status;
+        pthread_mutex_unlock(&batch->cache_lock);
+        if (VCTOOL_STATUS_SUCCESS == retval)
+        {
+            *derived_key = &entry->derived_key;
+        }
+
+        goto cleanup_salt;
+    }
+
+    /* mark this salt as in progress; on success, the entry owns the salt. */
+    retval =
+        pubkey_key_cache_entry_create(
+            &entry, batch->root->alloc, &salt, rounds);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        pthread_mutex_unlock(&batch->cache_lock);
+        goto cleanup_salt;
+    }
+
+    retval = rbtree_insert(batch->key_cache, &entry->hdr);
+    pthread_mutex_unlock(&batch->cache_lock);
+    if (STATUS_SUCCESS != retval)
+    {
+        resource_release(&entry->hdr);
+        goto done;
+    }
+
+    /* derive the key from the passphrase. This is the expensive part. */
+    retval = pubkey_batch_read_password(batch);
+    if (VCTOOL_STATUS_SUCCESS == retval)
+    {
+        retval =
+            crypt_derive_key_from_password(
+                &entry->derived_key, batch->opts->suite, &batch->password,
+                &entry->salt, rounds);
+    }
+
+    /* wake any workers waiting for this key. */
+    pthread_mutex_lock(&batch->cache_lock);
+    entry->status = retval;
+    entry->ready = true;
+    pthread_cond_broadcast(&batch->cache_ready);
+    pthread_mutex_unlock(&batch->cache_lock);
+
+    if (VCTOOL_STATUS_SUCCESS == retval)
+    {
+        *derived_key = &entry->derived_key;
+    }
+
+    goto done;
+
+cleanup_salt:
+    dispose((disposable_t*)&salt);
+
+done:
+    return retval;
+}
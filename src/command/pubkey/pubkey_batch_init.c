@@ -0,0 +1,59 @@
+/**
+ * \file command/pubkey/pubkey_batch_init.c
+ *
+ * \brief Initialize a pubkey batch.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "pubkey_internal.h"
+
+RCPR_IMPORT_rbtree;
+
+/**
+ * \brief Initialize a pubkey batch.
+ *
+ * \param batch         The batch to initialize.
+ * \param opts          The command-line options to use.
+ * \param root          The root command instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_init(
+    pubkey_batch* batch, commandline_opts* opts, root_command* root)
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+    MODEL_ASSERT(NULL != root);
+
+    /* clear the batch. */
+    memset(batch, 0, sizeof(*batch));
+    batch->opts = opts;
+    batch->root = root;
+
+    /* create the derived key cache. */
+    retval =
+        rbtree_create(
+            &batch->key_cache, root->alloc, &pubkey_key_cache_compare,
+            &pubkey_key_cache_key_get, NULL);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* initialize the locks. */
+    pthread_mutex_init(&batch->password_lock, NULL);
+    pthread_mutex_init(&batch->cache_lock, NULL);
+    pthread_cond_init(&batch->cache_ready, NULL);
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+
+done:
+    return retval;
+}
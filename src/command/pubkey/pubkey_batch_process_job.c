@@ -0,0 +1,212 @@
+/**
+ * \file command/pubkey/pubkey_batch_process_job.c
+ *
+ * \brief Extract the public certificate for a single keypair.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "pubkey_internal.h"
+
+/**
+ * \brief Extract the public certificate for a single job.
+ *
+ * The permission checks for a keypair are performed immediately before it is
+ * read, so these checks overlap with the I/O and decryption performed by other
+ * workers.
+ *
+ * \param batch             The batch that owns this job.
+ * \param job               The job to process.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_process_job(pubkey_batch* batch, pubkey_job* job)
+{
+    int retval, fd, out_fd;
+    file_stat_st fst;
+    size_t read_bytes, wrote_size;
+    vccrypt_buffer_t cert, uuid, encryption_pubkey, signing_pubkey, pubcert;
+    vccrypt_buffer_t* decrypted_cert = NULL;
+    const vccrypt_buffer_t* work_cert;
+    const vccrypt_buffer_t* derived_key;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(NULL != job);
+
+    commandline_opts* opts = batch->opts;
+
+    /* make sure we don't clobber an existing file. */
+    retval = file_stat(opts->file, job->output_filename, &fst);
+    if (VCTOOL_ERROR_FILE_NO_ENTRY != retval)
+    {
+        fprintf(
+            stderr, "Won't clobber existing file %s.  Skipping.\n",
+            job->output_filename);
+        retval = VCTOOL_ERROR_PUBKEY_WOULD_CLOBBER_FILE;
+        goto done;
+    }
+
+    /* make sure the key file exists. */
+    retval = file_stat(opts->file, job->key_filename, &fst);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Missing key file %s.\n", job->key_filename);
+        goto done;
+    }
+
+    /* make sure the permission bits are set appropriately. */
+    mode_t bad_bits = S_ISUID | S_ISGID | S_ISVTX | S_IRWXG | S_IRWXO;
+    if (fst.fst_mode & bad_bits)
+    {
+        fprintf(
+            stderr, "Only user permissions allowed for %s.\n",
+            job->key_filename);
+        retval = VCTOOL_ERROR_COMMANDLINE_BAD_FILE_PERMISSIONS;
+        goto done;
+    }
+    else if (! (fst.fst_mode & S_IRUSR))
+    {
+        fprintf(stderr, "Can't read %s.\n", job->key_filename);
+        retval = VCTOOL_ERROR_COMMANDLINE_BAD_FILE_PERMISSIONS;
+        goto done;
+    }
+
+    /* create the certificate buffer. */
+    retval = vccrypt_buffer_init(&cert, opts->suite->alloc_opts, fst.fst_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* open file. */
+    retval = file_open(opts->file, &fd, job->key_filename, O_RDONLY, 0);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr, "Error opening file %s for read.\n", job->key_filename);
+        goto cleanup_cert;
+    }
+
+    /* read contents into certificate buffer. */
+    retval = file_read(opts->file, fd, cert.data, cert.size, &read_bytes);
+    file_close(opts->file, fd);
+    if (VCTOOL_STATUS_SUCCESS != retval || read_bytes != cert.size)
+    {
+        fprintf(stderr, "Error reading from %s.\n", job->key_filename);
+        retval = VCTOOL_ERROR_FILE_IO;
+        goto cleanup_cert;
+    }
+
+    /* Does it have encryption magic? */
+    if (cert.size > ENCRYPTED_CERT_MAGIC_SIZE
+     && !crypto_memcmp(
+            cert.data, ENCRYPTED_CERT_MAGIC_STRING, ENCRYPTED_CERT_MAGIC_SIZE))
+    {
+        /* Yes: get the derived key for this certificate's salt. */
+        retval = pubkey_batch_get_derived_key(&derived_key, batch, &cert);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(
+                stderr, "Error deriving key for %s.\n", job->key_filename);
+            goto cleanup_cert;
+        }
+
+        /* decrypt the certificate. */
+        retval =
+            certificate_decrypt_with_key(
+                opts->suite, &decrypted_cert, &cert, derived_key);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(stderr, "Error decrypting %s.\n", job->key_filename);
+            goto cleanup_cert;
+        }
+
+        work_cert = decrypted_cert;
+    }
+    else
+    {
+        work_cert = &cert;
+    }
+
+    /* extract uuid, public encryption key, and public signing key from cert. */
+    retval =
+        pubkey_extract_public_fields_from_private_cert(
+            opts, &uuid, &encryption_pubkey, &signing_pubkey, work_cert);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr, "Error extracting public fields from %s.\n",
+            job->key_filename);
+        goto cleanup_cert;
+    }
+
+    /* create a pubkey cert with these three items. */
+    retval =
+        pubkey_certificate_create(
+            opts, &pubcert, &uuid, &encryption_pubkey, &signing_pubkey);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr, "Error creating public cert for %s.\n", job->key_filename);
+        goto cleanup_cert_fields;
+    }
+
+    /* open output file. */
+    retval =
+        file_open(
+            opts->file, &out_fd, job->output_filename,
+            O_CREAT | O_EXCL | O_WRONLY, S_IRUSR);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr, "Error opening output file %s.\n", job->output_filename);
+        goto cleanup_pubcert;
+    }
+
+    /* write this cert to the output file. */
+    retval =
+        file_write(
+            opts->file, out_fd, pubcert.data, pubcert.size, &wrote_size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr, "Error writing to output file %s.\n",
+            job->output_filename);
+        goto cleanup_outfile;
+    }
+    else if (wrote_size != pubcert.size)
+    {
+        fprintf(stderr, "Error: %s truncated.\n", job->output_filename);
+        retval = VCTOOL_ERROR_FILE_IO;
+        goto cleanup_outfile;
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    /* fall-through. */
+
+cleanup_outfile:
+    file_close(opts->file, out_fd);
+
+cleanup_pubcert:
+    dispose((disposable_t*)&pubcert);
+
+cleanup_cert_fields:
+    dispose((disposable_t*)&uuid);
+    dispose((disposable_t*)&encryption_pubkey);
+    dispose((disposable_t*)&signing_pubkey);
+
+cleanup_cert:
+    dispose((disposable_t*)&cert);
+    if (NULL != decrypted_cert)
+    {
+        dispose((disposable_t*)decrypted_cert);
+        free(decrypted_cert);
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,149 @@
+/**
+ * \file command/pubkey/pubkey_batch_read_directory.c
+ *
+ * \brief Add a job for each keypair file in a directory.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "pubkey_internal.h"
+
+/* forward decls. */
+static bool pubkey_batch_skip_entry(const char* name);
+
+/**
+ * \brief Add a job for each keypair file in the given directory.
+ *
+ * Hidden files, non-regular files, and files ending in ".pub" are skipped.
+ *
+ * \param batch             The batch to which these jobs are added.
+ * \param dirname           The directory to scan.
+ * \param output_dir        The optional output directory, or NULL.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_read_directory(
+    pubkey_batch* batch, const char* dirname, const char* output_dir)
+{
+    int retval, release_retval;
+    void* dir;
+    const char* name;
+    file_stat_st fst;
+    char* path;
+    size_t path_length;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(NULL != dirname);
+
+    /* open the directory. */
+    retval = file_opendir(batch->opts->file, &dir, dirname);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error opening directory %s.\n", dirname);
+        retval = VCTOOL_ERROR_PUBKEY_BAD_INPUT;
+        goto done;
+    }
+
+    /* iterate through the directory entries. */
+    for (;;)
+    {
+        retval = file_readdir(batch->opts->file, dir, &name);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(stderr, "Error reading directory %s.\n", dirname);
+            goto cleanup_dir;
+        }
+        else if (NULL == name)
+        {
+            break;
+        }
+
+        /* skip hidden files and public certificates. */
+        if (pubkey_batch_skip_entry(name))
+        {
+            continue;
+        }
+
+        /* build the path for this entry. */
+        path_length =
+            strlen(dirname)
+          + 1 /* / */
+          + strlen(name)
+          + 1;/* asciiz */
+
+        path = (char*)malloc(path_length);
+        if (NULL == path)
+        {
+            retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+            goto cleanup_dir;
+        }
+
+        snprintf(path, path_length, "%s/%s", dirname, name);
+
+        /* only regular files are considered. */
+        if (VCTOOL_STATUS_SUCCESS != file_stat(batch->opts->file, path, &fst)
+         || !S_ISREG(fst.fst_mode))
+        {
+            free(path);
+            continue;
+        }
+
+        /* add this keypair. */
+        retval = pubkey_batch_add_keypair(batch, path, output_dir);
+        free(path);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_dir;
+        }
+    }
+
+    /* it's an error to run a batch over an empty directory. */
+    if (0 == batch->job_count)
+    {
+        fprintf(stderr, "No keypair files found in %s.\n", dirname);
+        retval = VCTOOL_ERROR_PUBKEY_BAD_INPUT;
+        goto cleanup_dir;
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+
+cleanup_dir:
+    release_retval = file_closedir(batch->opts->file, dir);
+    if (VCTOOL_STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Return true if the given directory entry should be skipped.
+ *
+ * \param name              The name of the directory entry.
+ *
+ * \returns true if this entry is hidden or is a public certificate.
+ */
+static bool pubkey_batch_skip_entry(const char* name)
+{
+    size_t length = strlen(name);
+
+    /* skip hidden files, including . and .. */
+    if ('.' == name[0])
+    {
+        return true;
+    }
+
+    /* skip public certificates. */
+    if (length >= 4 && !strcmp(name + length - 4, ".pub"))
+    {
+        return true;
+    }
+
+    return false;
+}
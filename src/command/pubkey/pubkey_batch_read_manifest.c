@@ -0,0 +1,129 @@
+/**
+ * \file command/pubkey/pubkey_batch_read_manifest.c
+ *
+ * \brief Add a job for each keypair file listed in a manifest.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <ctype.h>
+
+#include "pubkey_internal.h"
+
+/**
+ * \brief Add a job for each keypair file listed in the given manifest.
+ *
+ * The manifest holds one keypair filename per line. Blank lines and lines
+ * starting with '#' are ignored.
+ *
+ * \param batch             The batch to which these jobs are added.
+ * \param filename          The manifest file to read.
+ * \param output_dir        The optional output directory, or NULL.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_read_manifest(
+    pubkey_batch* batch, const char* filename, const char* output_dir)
+{
+    int retval, fd;
+    file_stat_st fst;
+    size_t read_bytes;
+    char* manifest;
+    char* line;
+    char* saveptr;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(NULL != filename);
+
+    /* get the size of the manifest. */
+    retval = file_stat(batch->opts->file, filename, &fst);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Missing manifest %s.\n", filename);
+        goto done;
+    }
+
+    /* allocate space for the manifest, plus an asciiz terminator. */
+    manifest = (char*)malloc(fst.fst_size + 1);
+    if (NULL == manifest)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+    memset(manifest, 0, fst.fst_size + 1);
+
+    /* open the manifest. */
+    retval = file_open(batch->opts->file, &fd, filename, O_RDONLY, 0);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error opening file %s for read.\n", filename);
+        goto free_manifest;
+    }
+
+    /* read the manifest. */
+    retval =
+        file_read(
+            batch->opts->file, fd, manifest, fst.fst_size, &read_bytes);
+    if (VCTOOL_STATUS_SUCCESS != retval || read_bytes != (size_t)fst.fst_size)
+    {
+        fprintf(stderr, "Error reading from %s.\n", filename);
+        retval = VCTOOL_ERROR_FILE_IO;
+        goto cleanup_file;
+    }
+
+    /* add a job for each line. */
+    for (
+        line = strtok_r(manifest, "\n", &saveptr);
+        NULL != line;
+        line = strtok_r(NULL, "\n", &saveptr))
+    {
+        /* trim trailing whitespace, including carriage returns. */
+        size_t length = strlen(line);
+        while (length > 0 && isspace((unsigned char)line[length - 1]))
+        {
+            line[--length] = 0;
+        }
+
+        /* trim leading whitespace. */
+        while (isspace((unsigned char)*line))
+        {
+            ++line;
+        }
+
+        /* skip blank lines and comments. */
+        if (0 == *line || '#' == *line)
+        {
+            continue;
+        }
+
+        /* add this keypair. */
+        retval = pubkey_batch_add_keypair(batch, line, output_dir);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_file;
+        }
+    }
+
+    /* it's an error to run a batch over an empty manifest. */
+    if (0 == batch->job_count)
+    {
+        fprintf(stderr, "No keypair files listed in %s.\n", filename);
+        retval = VCTOOL_ERROR_PUBKEY_BAD_INPUT;
+        goto cleanup_file;
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+
+cleanup_file:
+    file_close(batch->opts->file, fd);
+
+free_manifest:
+    free(manifest);
+
+done:
+    return retval;
+}
@@ -0,0 +1,65 @@
+/**
+ * \file command/pubkey/pubkey_batch_read_password.c
+ *
+ * \brief Read the passphrase for a pubkey batch once.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "pubkey_internal.h"
+
+/**
+ * \brief Read the passphrase for this batch, prompting the user at most once.
+ *
+ * The first worker to encounter an encrypted keypair prompts for the
+ * passphrase; any other worker needing it waits on the password lock, and then
+ * uses the cached result.
+ *
+ * \param batch             The batch for which the passphrase is read.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_read_password(pubkey_batch* batch)
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+
+    pthread_mutex_lock(&batch->password_lock);
+
+    /* only read the password once. */
+    if (!batch->password_read)
+    {
+        if (batch->root->non_interactive)
+        {
+            batch->password_status =
+                blankpassword(batch->opts->suite, &batch->password);
+        }
+        else
+        {
+            printf("Enter passphrase: ");
+            fflush(stdout);
+            batch->password_status =
+                readpassword(batch->opts->suite, &batch->password);
+            if (VCTOOL_STATUS_SUCCESS != batch->password_status)
+            {
+                printf("Failure.\n");
+            }
+            else
+            {
+                printf("\n");
+            }
+        }
+
+        batch->password_read = true;
+    }
+
+    retval = batch->password_status;
+
+    pthread_mutex_unlock(&batch->password_lock);
+
+    return retval;
+}
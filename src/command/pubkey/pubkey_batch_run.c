@@ -0,0 +1,72 @@
+/**
+ * \file command/pubkey/pubkey_batch_run.c
+ *
+ * \brief Run a pubkey batch on a pool of worker threads.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "pubkey_internal.h"
+
+/**
+ * \brief Run all jobs in the batch on a pool of worker threads.
+ *
+ * \param batch             The batch to run.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS if every job succeeded.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_run(pubkey_batch* batch)
+{
+    int retval;
+    size_t failed;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+
+    /* run each job on the worker pool. */
+    retval = parallel_for(batch->job_count, &pubkey_batch_worker, batch);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* a single job reports its own status. */
+    if (1 == batch->job_count)
+    {
+        retval = batch->jobs[0].status;
+        goto done;
+    }
+
+    /* count failures. */
+    failed = 0;
+    for (size_t i = 0; i < batch->job_count; ++i)
+    {
+        if (VCTOOL_STATUS_SUCCESS != batch->jobs[i].status)
+        {
+            ++failed;
+        }
+        else if (batch->root->verbose)
+        {
+            printf(
+                "%s -> %s\n", batch->jobs[i].key_filename,
+                batch->jobs[i].output_filename);
+        }
+    }
+
+    /* report failures. */
+    if (failed > 0)
+    {
+        fprintf(
+            stderr, "%zu of %zu keypairs failed.\n", failed, batch->job_count);
+        retval = VCTOOL_ERROR_PUBKEY_BATCH_FAILED;
+        goto done;
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+
+done:
+    return retval;
+}
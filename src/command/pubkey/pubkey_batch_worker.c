@@ -0,0 +1,28 @@
+/**
+ * \file command/pubkey/pubkey_batch_worker.c
+ *
+ * \brief Worker function for a pubkey batch.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "pubkey_internal.h"
+
+/**
+ * \brief Worker function; processes a single job from the batch.
+ *
+ * \param context           The pubkey batch.
+ * \param index             The index of the job to process.
+ */
+void pubkey_batch_worker(void* context, size_t index)
+{
+    pubkey_batch* batch = (pubkey_batch*)context;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(index < batch->job_count);
+
+    /* process this job. Errors are recorded in the job. */
+    batch->jobs[index].status =
+        pubkey_batch_process_job(batch, &batch->jobs[index]);
+}
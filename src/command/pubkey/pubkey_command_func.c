@@ -3,31 +3,21 @@
  *
  * \brief Entry point for the pubkey command.
  *
- * \copyright 2020 Velo Payments.  See License.txt for license terms.
+ * \copyright 2020-2023 Velo Payments.  See License.txt for license terms.
  */
 
-#include <cbmc/model_assert.h>
-#include <fcntl.h>
-#include <stdio.h>
-#include <string.h>
-#include <vccert/fields.h>
-#include <vccrypt/compare.h>
-#include <vctool/certificate.h>
-#include <vctool/commandline.h>
-#include <vctool/command/pubkey.h>
-#include <vctool/command/root.h>
-#include <vctool/readpassword.h>
-#include <vpr/parameters.h>
-
-/* forward decls. */
-static int pubkey_extract_public_fields_from_private_cert(
-    commandline_opts* opts, vccrypt_buffer_t* uuid,
-    vccrypt_buffer_t* encryption_pubkey, vccrypt_buffer_t* signing_pubkey,
-    const vccrypt_buffer_t* cert);
+#include "pubkey_internal.h"
 
 /**
  * \brief Execute the pubkey command.
  *
+ * A single keypair can be given with -k, in which case the output filename is
+ * either set with -o or defaults to the keypair filename with ".pub" appended.
+ * Alternately, a directory of keypairs or a manifest listing one keypair per
+ * line can be given with -i, in which case -o optionally names the output
+ * directory. All keypairs are extracted in parallel, and the passphrase is
+ * prompted for at most once.
+ *
  * \param opts          The commandline opts for this operation.
  *
  * \returns a status code indicating success or failure.
@@ -36,13 +26,9 @@ static int pubkey_extract_public_fields_from_private_cert(
  */
 int pubkey_command_func(commandline_opts* opts)
 {
-    int retval, fd, out_fd;
-    char* output_filename;
-    const char* key_filename;
-    vccrypt_buffer_t cert, password_buffer, uuid, encryption_pubkey,
-                     signing_pubkey, pubcert;
-    vccrypt_buffer_t* decrypted_cert = NULL;
-    vccrypt_buffer_t* work_cert = NULL;
+    int retval;
+    pubkey_batch batch;
+    file_stat_st fst;
 
     /* parameter sanity checks. */
     MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
@@ -53,377 +39,81 @@ int pubkey_command_func(commandline_opts* opts)
     root_command* root = (root_command*)pubkey->hdr.next;
     MODEL_ASSERT(NULL != root);
 
-    /* get the key filename. */
-    if (NULL != root->key_filename)
-    {
-        key_filename = root->key_filename;
-    }
-    else
+    /* we need exactly one of a key filename or an input path. */
+    if (NULL == root->key_filename && NULL == root->input_filename)
     {
         retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
-        fprintf(stderr, "Expecting a key filename (-k keypair.cert).\n");
-        goto done;
-    }
-
-    /* get the output filename. */
-    if (NULL != root->output_filename)
-    {
-        output_filename = strdup(root->output_filename);
-    }
-    else
-    {
-        size_t output_filename_length =
-            strlen(key_filename)
-          + 4 /* .pub */
-          + 1;/* asciiz */
-
-        output_filename = (char*)malloc(output_filename_length);
-        memset(output_filename, 0, output_filename_length);
-        snprintf(
-            output_filename, output_filename_length, "%s.pub", key_filename);
-    }
-
-    /* make sure we don't clobber an existing file. */
-    file_stat_st fst;
-    retval = file_stat(opts->file, output_filename, &fst);
-    if (VCTOOL_ERROR_FILE_NO_ENTRY != retval)
-    {
-        fprintf(
-            stderr, "Won't clobber existing file %s.  Stopping.\n",
-            output_filename);
-        retval = VCTOOL_ERROR_PUBKEY_WOULD_CLOBBER_FILE;
-        goto free_output_filename;
-    }
-
-    /* make sure the key file exists. */
-    retval = file_stat(opts->file, key_filename, &fst);
-    if (VCTOOL_STATUS_SUCCESS != retval)
-    {
-        fprintf(stderr, "Missing key file %s.\n", key_filename);
-        goto free_output_filename;
-    }
-
-    /* make sure the permission bits are set appropriately. */
-    mode_t bad_bits = S_ISUID | S_ISGID | S_ISVTX | S_IRWXG | S_IRWXO;
-    if (fst.fst_mode & bad_bits)
-    {
         fprintf(
-            stderr, "Only user permissions allowed for %s.\n", key_filename);
-        goto free_output_filename;
-    }
-    else if (! (fst.fst_mode & S_IRUSR))
-    {
-        fprintf(stderr, "Can't read %s.\n", key_filename);
-        goto free_output_filename;
+            stderr,
+            "Expecting a key filename (-k keypair.cert) or a keypair "
+            "directory / manifest (-i path).\n");
+        goto done;
     }
-
-    /* create the certificate buffer. */
-    size_t file_size = fst.fst_size;
-    retval = vccrypt_buffer_init(&cert, opts->suite->alloc_opts, file_size);
-    if (VCCRYPT_STATUS_SUCCESS != retval)
+    else if (NULL != root->key_filename && NULL != root->input_filename)
     {
-        goto free_output_filename;
+        retval = VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+        fprintf(stderr, "Expecting either -k or -i, but not both.\n");
+        goto done;
     }
 
-    /* open file. */
-    retval =
-        file_open(
-            opts->file, &fd, key_filename, O_RDONLY, 0);
+    /* initialize the batch. */
+    retval = pubkey_batch_init(&batch, opts, root);
     if (VCTOOL_STATUS_SUCCESS != retval)
     {
-        fprintf(stderr, "Error opening file %s for read.\n", key_filename);
-        goto cleanup_cert;
-    }
-
-    /* read contents into certificate buffer. */
-    size_t read_bytes;
-    retval = file_read(opts->file, fd, cert.data, cert.size, &read_bytes);
-    if (VCTOOL_STATUS_SUCCESS != retval || read_bytes != cert.size)
-    {
-        fprintf(stderr, "Error reading from %s.\n", key_filename);
-        goto cleanup_file;
+        goto done;
     }
 
-    /* Does it have encryption magic? */
-    if (cert.size > ENCRYPTED_CERT_MAGIC_SIZE
-     && !crypto_memcmp(
-            cert.data, ENCRYPTED_CERT_MAGIC_STRING, ENCRYPTED_CERT_MAGIC_SIZE))
+    /* single keypair mode. */
+    if (NULL != root->key_filename)
     {
-        /* Yes: read password and decrypt. */
-        printf("Enter passphrase: ");
-        fflush(stdout);
-        retval = readpassword(opts->suite, &password_buffer);
-        if (VCTOOL_STATUS_SUCCESS != retval)
+        if (NULL != root->output_filename)
         {
-            printf("Failure.\n");
-            goto cleanup_file;
+            retval =
+                pubkey_batch_add_job(
+                    &batch, root->key_filename, root->output_filename);
         }
-        printf("\n");
-
-        retval =
-            certificate_decrypt(
-                opts->suite, &decrypted_cert, &cert, &password_buffer);
-        if (VCTOOL_STATUS_SUCCESS != retval)
+        else
         {
-            fprintf(stderr, "Error decrypting %s.\n", key_filename);
-            dispose((disposable_t*)&password_buffer);
-            goto cleanup_file;
+            retval =
+                pubkey_batch_add_keypair(&batch, root->key_filename, NULL);
         }
-
-        dispose((disposable_t*)&password_buffer);
-        work_cert = decrypted_cert;
     }
+    /* batch mode: the input is either a directory or a manifest. */
     else
     {
-        work_cert = &cert;
-    }
-
-    /* extract uuid, public encryption key, and public signing key from cert. */
-    retval =
-        pubkey_extract_public_fields_from_private_cert(
-            opts, &uuid, &encryption_pubkey, &signing_pubkey, work_cert);
-    if (VCTOOL_STATUS_SUCCESS != retval)
-    {
-        fprintf(
-            stderr, "Error extracting public fields from %s.\n", key_filename);
-        goto cleanup_file;
-    }
-
-    /* create method for creating pubkey cert with these three items. */
-    retval =
-        pubkey_certificate_create(
-            opts, &pubcert, &uuid, &encryption_pubkey, &signing_pubkey);
-    if (VCTOOL_STATUS_SUCCESS != retval)
-    {
-        fprintf(stderr, "Error creating public cert.\n");
-        goto cleanup_cert_fields;
-    }
+        retval = file_stat(opts->file, root->input_filename, &fst);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(stderr, "Missing input %s.\n", root->input_filename);
+            goto cleanup_batch;
+        }
 
-    /* open output file. */
-    retval =
-        file_open(
-            opts->file, &out_fd, output_filename, O_CREAT | O_EXCL | O_WRONLY,
-            S_IRUSR);
-    if (VCTOOL_STATUS_SUCCESS != retval)
-    {
-        fprintf(stderr, "Error opening output file %s.\n", output_filename);
-        goto cleanup_pubcert;
+        if (S_ISDIR(fst.fst_mode))
+        {
+            retval =
+                pubkey_batch_read_directory(
+                    &batch, root->input_filename, root->output_filename);
+        }
+        else
+        {
+            retval =
+                pubkey_batch_read_manifest(
+                    &batch, root->input_filename, root->output_filename);
+        }
     }
 
-    /* write this cert to the output file. */
-    size_t wrote_size;
-    retval =
-        file_write(
-            opts->file, out_fd, pubcert.data, pubcert.size, &wrote_size);
+    /* verify that the jobs were added. */
     if (VCTOOL_STATUS_SUCCESS != retval)
     {
-        fprintf(stderr, "Error writing to output file.\n");
-        goto cleanup_outfile;
-    }
-    else if (wrote_size != pubcert.size)
-    {
-        fprintf(stderr, "Error: file truncated.\n");
-        goto cleanup_outfile;
+        goto cleanup_batch;
     }
 
-    /* success. */
-    retval = VCTOOL_STATUS_SUCCESS;
+    /* run the batch. */
+    retval = pubkey_batch_run(&batch);
     /* fall-through. */
 
-cleanup_outfile:
-    file_close(opts->file, out_fd);
-
-cleanup_pubcert:
-    dispose((disposable_t*)&pubcert);
-
-cleanup_cert_fields:
-    dispose((disposable_t*)&uuid);
-    dispose((disposable_t*)&encryption_pubkey);
-    dispose((disposable_t*)&signing_pubkey);
-
-cleanup_file:
-    file_close(opts->file, fd);
-
-cleanup_cert:
-    dispose((disposable_t*)&cert);
-    if (NULL != decrypted_cert)
-    {
-        dispose((disposable_t*)decrypted_cert);
-        free(decrypted_cert);
-    }
-
-free_output_filename:
-    free(output_filename);
-
-done:
-    return retval;
-}
-
-/**
- * \brief Extract the public keys from a private keypair certificate.
- *
- * \param opts                  The command-line options to use.
- * \param uuid                  Buffer to be initialized with the uuid. Caller
- *                              owns this buffer on success and must dispose it.
- * \param encryption_pubkey     Buffer to be initialized with the encryption
- *                              public key. Caller owns this buffer on success
- *                              and must dispose it.
- * \param signing_pubkey        Buffer to be initialized with the signing public
- *                              key. Caller owns this buffer on success and must
- *                              dispose it.
- *
- * \returns a status code indicating success or failure.
- *      - VCTOOL_STATUS_SUCCESS on success.
- *      - a non-zero error code on failure.
- */
-static int pubkey_extract_public_fields_from_private_cert(
-    commandline_opts* opts, vccrypt_buffer_t* uuid,
-    vccrypt_buffer_t* encryption_pubkey, vccrypt_buffer_t* signing_pubkey,
-    const vccrypt_buffer_t* cert)
-{
-    int retval;
-    vccert_parser_options_t parser_options;
-    vccert_parser_context_t parser;
-
-    /* parameter sanity checks. */
-    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
-    MODEL_ASSERT(NULL != uuid);
-    MODEL_ASSERT(NULL != encryption_pubkey);
-    MODEL_ASSERT(NULL != signing_pubkey);
-    MODEL_ASSERT(NULL != cert);
-
-    /* create simple parser options. */
-    retval =
-        vccert_parser_options_simple_init(
-            &parser_options, opts->suite->alloc_opts, opts->suite);
-    if (VCCERT_STATUS_SUCCESS != retval)
-    {
-        goto done;
-    }
-
-    /* create parser for cert. */
-    retval =
-        vccert_parser_init(
-            &parser_options, &parser, cert->data, cert->size);
-    if (VCCERT_STATUS_SUCCESS != retval)
-    {
-        goto cleanup_parser_options;
-    }
-
-    /* get the entity id. */
-    const uint8_t* entity_id_value = NULL;
-    size_t entity_id_size = 0U;
-    retval =
-        vccert_parser_find_short(
-            &parser, VCCERT_FIELD_TYPE_ARTIFACT_ID,
-            &entity_id_value, &entity_id_size);
-    if (VCCERT_STATUS_SUCCESS != retval)
-    {
-        goto cleanup_parser;
-    }
-
-    /* verify the entity id. */
-    size_t expected_uuid_size = 16;
-    if (entity_id_size != expected_uuid_size)
-    {
-        retval = VCCERT_ERROR_PARSER_FIELD_INVALID_FIELD_SIZE;
-        goto cleanup_parser;
-    }
-
-    /* create a uuid buffer. */
-    retval =
-        vccrypt_buffer_init(uuid, opts->suite->alloc_opts, expected_uuid_size);
-    if (VCCRYPT_STATUS_SUCCESS != retval)
-    {
-        goto cleanup_parser;
-    }
-
-    /* copy uuid value to buffer. */
-    memcpy(uuid->data, entity_id_value, expected_uuid_size);
-
-    /* get the public encryption key. */
-    const uint8_t* public_encryption_key_value = NULL;
-    size_t public_encryption_key_size = 0U;
-    retval =
-        vccert_parser_find_short(
-            &parser, VCCERT_FIELD_TYPE_PUBLIC_ENCRYPTION_KEY,
-            &public_encryption_key_value, &public_encryption_key_size);
-    if (VCCRYPT_STATUS_SUCCESS != retval)
-    {
-        goto cleanup_uuid;
-    }
-
-    /* verify the public encryption key size. */
-    size_t expected_pubkey_size = opts->suite->key_cipher_opts.public_key_size;
-    if (public_encryption_key_size != expected_pubkey_size)
-    {
-        retval = VCCERT_ERROR_PARSER_FIELD_INVALID_FIELD_SIZE;
-        goto cleanup_uuid;
-    }
-
-    /* create a public encryption key buffer. */
-    retval =
-        vccrypt_buffer_init(
-            encryption_pubkey, opts->suite->alloc_opts, expected_pubkey_size);
-    if (VCCRYPT_STATUS_SUCCESS != retval)
-    {
-        goto cleanup_uuid;
-    }
-
-    /* copy public key value to buffer. */
-    memcpy(
-        encryption_pubkey->data, public_encryption_key_value,
-        expected_pubkey_size);
-
-    /* get the public signing key. */
-    const uint8_t* public_signing_key_value = NULL;
-    size_t public_signing_key_size = 0U;
-    retval =
-        vccert_parser_find_short(
-            &parser, VCCERT_FIELD_TYPE_PUBLIC_SIGNING_KEY,
-            &public_signing_key_value, &public_signing_key_size);
-    if (VCCRYPT_STATUS_SUCCESS != retval)
-    {
-        goto cleanup_encryption_pubkey;
-    }
-
-    /* verify the public signing key size. */
-    size_t expected_signkey_size = opts->suite->sign_opts.public_key_size;
-    if (public_signing_key_size != expected_signkey_size)
-    {
-        retval = VCCERT_ERROR_PARSER_FIELD_INVALID_FIELD_SIZE;
-        goto cleanup_encryption_pubkey;
-    }
-
-    /* create a public signing key buffer. */
-    retval =
-        vccrypt_buffer_init(
-            signing_pubkey, opts->suite->alloc_opts, expected_signkey_size);
-    if (VCCRYPT_STATUS_SUCCESS != retval)
-    {
-        goto cleanup_encryption_pubkey;
-    }
-
-    /* copy public signing key value to buffer. */
-    memcpy(
-        signing_pubkey->data, public_signing_key_value, expected_signkey_size);
-
-    /* success. */
-    retval = VCCRYPT_STATUS_SUCCESS;
-    /* on success, caller owns the three buffers. Jump past their cleanup. */
-    goto cleanup_parser;
-
-cleanup_encryption_pubkey:
-    dispose((disposable_t*)encryption_pubkey);
-
-cleanup_uuid:
-    dispose((disposable_t*)uuid);
-
-cleanup_parser:
-    dispose((disposable_t*)&parser);
-
-cleanup_parser_options:
-    dispose((disposable_t*)&parser_options);
+cleanup_batch:
+    pubkey_batch_dispose(&batch);
 
 done:
     return retval;
@@ -0,0 +1,181 @@
+/**
+ * \file command/pubkey/pubkey_extract_public_fields_from_private_cert.c
+ *
+ * \brief Extract the public keys from a private keypair certificate.
+ *
+ * \copyright 2020 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <vccert/fields.h>
+
+#include "pubkey_internal.h"
+
+/**
+ * \brief Extract the public keys from a private keypair certificate.
+ *
+ * \param opts                  The command-line options to use.
+ * \param uuid                  Buffer to be initialized with the uuid. Caller
+ *                              owns this buffer on success and must dispose it.
+ * \param encryption_pubkey     Buffer to be initialized with the encryption
+ *                              public key. Caller owns this buffer on success
+ *                              and must dispose it.
+ * \param signing_pubkey        Buffer to be initialized with the signing public
+ *                              key. Caller owns this buffer on success and must
+ *                              dispose it.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_extract_public_fields_from_private_cert(
+    commandline_opts* opts, vccrypt_buffer_t* uuid,
+    vccrypt_buffer_t* encryption_pubkey, vccrypt_buffer_t* signing_pubkey,
+    const vccrypt_buffer_t* cert)
+{
+    int retval;
+    vccert_parser_options_t parser_options;
+    vccert_parser_context_t parser;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+    MODEL_ASSERT(NULL != uuid);
+    MODEL_ASSERT(NULL != encryption_pubkey);
+    MODEL_ASSERT(NULL != signing_pubkey);
+    MODEL_ASSERT(NULL != cert);
+
+    /* create simple parser options. */
+    retval =
+        vccert_parser_options_simple_init(
+            &parser_options, opts->suite->alloc_opts, opts->suite);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* create parser for cert. */
+    retval =
+        vccert_parser_init(
+            &parser_options, &parser, cert->data, cert->size);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_parser_options;
+    }
+
+    /* get the entity id. */
+    const uint8_t* entity_id_value = NULL;
+    size_t entity_id_size = 0U;
+    retval =
+        vccert_parser_find_short(
+            &parser, VCCERT_FIELD_TYPE_ARTIFACT_ID,
+            &entity_id_value, &entity_id_size);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_parser;
+    }
+
+    /* verify the entity id. */
+    size_t expected_uuid_size = 16;
+    if (entity_id_size != expected_uuid_size)
+    {
+        retval = VCCERT_ERROR_PARSER_FIELD_INVALID_FIELD_SIZE;
+        goto cleanup_parser;
+    }
+
+    /* create a uuid buffer. */
+    retval =
+        vccrypt_buffer_init(uuid, opts->suite->alloc_opts, expected_uuid_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_parser;
+    }
+
+    /* copy uuid value to buffer. */
+    memcpy(uuid->data, entity_id_value, expected_uuid_size);
+
+    /* get the public encryption key. */
+    const uint8_t* public_encryption_key_value = NULL;
+    size_t public_encryption_key_size = 0U;
+    retval =
+        vccert_parser_find_short(
+            &parser, VCCERT_FIELD_TYPE_PUBLIC_ENCRYPTION_KEY,
+            &public_encryption_key_value, &public_encryption_key_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_uuid;
+    }
+
+    /* verify the public encryption key size. */
+    size_t expected_pubkey_size = opts->suite->key_cipher_opts.public_key_size;
+    if (public_encryption_key_size != expected_pubkey_size)
+    {
+        retval = VCCERT_ERROR_PARSER_FIELD_INVALID_FIELD_SIZE;
+        goto cleanup_uuid;
+    }
+
+    /* create a public encryption key buffer. */
+    retval =
+        vccrypt_buffer_init(
+            encryption_pubkey, opts->suite->alloc_opts, expected_pubkey_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_uuid;
+    }
+
+    /* copy public key value to buffer. */
+    memcpy(
+        encryption_pubkey->data, public_encryption_key_value,
+        expected_pubkey_size);
+
+    /* get the public signing key. */
+    const uint8_t* public_signing_key_value = NULL;
+    size_t public_signing_key_size = 0U;
+    retval =
+        vccert_parser_find_short(
+            &parser, VCCERT_FIELD_TYPE_PUBLIC_SIGNING_KEY,
+            &public_signing_key_value, &public_signing_key_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_encryption_pubkey;
+    }
+
+    /* verify the public signing key size. */
+    size_t expected_signkey_size = opts->suite->sign_opts.public_key_size;
+    if (public_signing_key_size != expected_signkey_size)
+    {
+        retval = VCCERT_ERROR_PARSER_FIELD_INVALID_FIELD_SIZE;
+        goto cleanup_encryption_pubkey;
+    }
+
+    /* create a public signing key buffer. */
+    retval =
+        vccrypt_buffer_init(
+            signing_pubkey, opts->suite->alloc_opts, expected_signkey_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_encryption_pubkey;
+    }
+
+    /* copy public signing key value to buffer. */
+    memcpy(
+        signing_pubkey->data, public_signing_key_value, expected_signkey_size);
+
+    /* success. */
+    retval = VCCRYPT_STATUS_SUCCESS;
+    /* on success, caller owns the three buffers. Jump past their cleanup. */
+    goto cleanup_parser;
+
+cleanup_encryption_pubkey:
+    dispose((disposable_t*)encryption_pubkey);
+
+cleanup_uuid:
+    dispose((disposable_t*)uuid);
+
+cleanup_parser:
+    dispose((disposable_t*)&parser);
+
+cleanup_parser_options:
+    dispose((disposable_t*)&parser_options);
+
+done:
+    return retval;
+}
@@ -0,0 +1,314 @@
+/**
+ * \file command/pubkey/pubkey_internal.h
+ *
+ * \brief Internal header for the pubkey command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <cbmc/model_assert.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <rcpr/rbtree.h>
+#include <stdio.h>
+#include <string.h>
+#include <vccrypt/compare.h>
+#include <vctool/certificate.h>
+#include <vctool/command/pubkey.h>
+#include <vctool/command/root.h>
+#include <vctool/crypt.h>
+#include <vctool/parallel.h>
+#include <vctool/readpassword.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief The lookup key for a cached derived key. */
+typedef struct pubkey_key_cache_key pubkey_key_cache_key;
+
+struct pubkey_key_cache_key
+{
+    unsigned int rounds;
+    const uint8_t* salt;
+    size_t salt_size;
+};
+
+/**
+ * \brief A derived key, cached by salt and rounds.
+ *
+ * An entry is inserted before its key is derived. Until ready is set, the key
+ * is being derived by the worker that inserted it.
+ */
+typedef struct pubkey_key_cache_entry pubkey_key_cache_entry;
+
+struct pubkey_key_cache_entry
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    pubkey_key_cache_key key;
+    vccrypt_buffer_t salt;
+    vccrypt_buffer_t derived_key;
+    bool ready;
+    int status;
+};
+
+/** \brief A single keypair to public certificate extraction. */
+typedef struct pubkey_job pubkey_job;
+
+struct pubkey_job
+{
+    char* key_filename;
+    char* output_filename;
+    int status;
+};
+
+/** \brief The shared state for a set of pubkey extraction jobs. */
+typedef struct pubkey_batch pubkey_batch;
+
+struct pubkey_batch
+{
+    commandline_opts* opts;
+    root_command* root;
+    pubkey_job* jobs;
+    size_t job_count;
+    size_t job_capacity;
+    pthread_mutex_t password_lock;
+    bool password_read;
+    int password_status;
+    vccrypt_buffer_t password;
+    pthread_mutex_t cache_lock;
+    pthread_cond_t cache_ready;
+    RCPR_SYM(rbtree)* key_cache;
+};
+
+/**
+ * \brief Initialize a pubkey batch.
+ *
+ * \param batch         The batch to initialize.
+ * \param opts          The command-line options to use.
+ * \param root          The root command instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_init(
+    pubkey_batch* batch, commandline_opts* opts, root_command* root);
+
+/**
+ * \brief Dispose of a pubkey batch, freeing jobs, the cached password, and the
+ * derived key cache.
+ *
+ * \param batch         The batch to dispose.
+ */
+void pubkey_batch_dispose(pubkey_batch* batch);
+
+/**
+ * \brief Add a job to the batch.
+ *
+ * \param batch             The batch to which this job is added.
+ * \param key_filename      The keypair file to read.
+ * \param output_filename   The public certificate file to write.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_add_job(
+    pubkey_batch* batch, const char* key_filename,
+    const char* output_filename);
+
+/**
+ * \brief Add a job for the given keypair file, deriving the output filename.
+ *
+ * The output file is the keypair filename with ".pub" appended. If an output
+ * directory is given, then the output file is placed in this directory instead
+ * of alongside the keypair file.
+ *
+ * \param batch             The batch to which this job is added.
+ * \param key_filename      The keypair file to read.
+ * \param output_dir        The optional output directory, or NULL.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_add_keypair(
+    pubkey_batch* batch, const char* key_filename, const char* output_dir);
+
+/**
+ * \brief Add a job for each keypair file in the given directory.
+ *
+ * Hidden files, non-regular files, and files ending in ".pub" are skipped.
+ *
+ * \param batch             The batch to which these jobs are added.
+ * \param dirname           The directory to scan.
+ * \param output_dir        The optional output directory, or NULL.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_read_directory(
+    pubkey_batch* batch, const char* dirname, const char* output_dir);
+
+/**
+ * \brief Add a job for each keypair file listed in the given manifest.
+ *
+ * The manifest holds one keypair filename per line. Blank lines and lines
+ * starting with '#' are ignored.
+ *
+ * \param batch             The batch to which these jobs are added.
+ * \param filename          The manifest file to read.
+ * \param output_dir        The optional output directory, or NULL.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_read_manifest(
+    pubkey_batch* batch, const char* filename, const char* output_dir);
+
+/**
+ * \brief Run all jobs in the batch on a pool of worker threads.
+ *
+ * \param batch             The batch to run.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS if every job succeeded.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_run(pubkey_batch* batch);
+
+/**
+ * \brief Worker function; processes a single job from the batch.
+ *
+ * \param context           The pubkey batch.
+ * \param index             The index of the job to process.
+ */
+void pubkey_batch_worker(void* context, size_t index);
+
+/**
+ * \brief Extract the public certificate for a single job.
+ *
+ * \param batch             The batch that owns this job.
+ * \param job               The job to process.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_process_job(pubkey_batch* batch, pubkey_job* job);
+
+/**
+ * \brief Read the passphrase for this batch, prompting the user at most once.
+ *
+ * \param batch             The batch for which the passphrase is read.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_read_password(pubkey_batch* batch);
+
+/**
+ * \brief Get the derived key for an encrypted certificate, deriving it from the
+ * batch passphrase only if no key for this salt and rounds is cached.
+ *
+ * \param derived_key       Pointer to receive the cached derived key. This key
+ *                          is owned by the batch.
+ * \param batch             The batch holding the key cache.
+ * \param encrypted_cert    The encrypted certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_batch_get_derived_key(
+    const vccrypt_buffer_t** derived_key, pubkey_batch* batch,
+    const vccrypt_buffer_t* encrypted_cert);
+
+/**
+ * \brief Create a key cache entry whose key is not yet derived.
+ *
+ * \param entry             Pointer to receive the entry on success.
+ * \param alloc             The allocator to use.
+ * \param salt              The salt, which is moved into the entry.
+ * \param rounds            The number of key derivation rounds.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_key_cache_entry_create(
+    pubkey_key_cache_entry** entry, RCPR_SYM(allocator)* alloc,
+    vccrypt_buffer_t* salt, unsigned int rounds);
+
+/**
+ * \brief Release a key cache entry.
+ *
+ * \param r                 The entry to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status pubkey_key_cache_entry_resource_release(RCPR_SYM(resource)* r);
+
+/**
+ * \brief Compare two key cache keys.
+ *
+ * \param context           Unused.
+ * \param lhs               The left-hand side of the comparison.
+ * \param rhs               The right-hand side of the comparison.
+ *
+ * \returns an integer value representing the comparison result.
+ *      - RCPR_COMPARE_LT if \p lhs &lt; \p rhs.
+ *      - RCPR_COMPARE_EQ if \p lhs == \p rhs.
+ *      - RCPR_COMPARE_GT if \p lhs &gt; \p rhs.
+ */
+RCPR_SYM(rcpr_comparison_result) pubkey_key_cache_compare(
+    void* /*context*/, const void* lhs, const void* rhs);
+
+/**
+ * \brief Given a key cache entry, return its key.
+ *
+ * \param context           Unused.
+ * \param r                 The resource handle of the pubkey_key_cache_entry.
+ *
+ * \returns the key for the entry.
+ */
+const void* pubkey_key_cache_key_get(
+    void* /*context*/, const RCPR_SYM(resource)* r);
+
+/**
+ * \brief Extract the public keys from a private keypair certificate.
+ *
+ * \param opts                  The command-line options to use.
+ * \param uuid                  Buffer to be initialized with the uuid. Caller
+ *                              owns this buffer on success and must dispose it.
+ * \param encryption_pubkey     Buffer to be initialized with the encryption
+ *                              public key. Caller owns this buffer on success
+ *                              and must dispose it.
+ * \param signing_pubkey        Buffer to be initialized with the signing public
+ *                              key. Caller owns this buffer on success and must
+ *                              dispose it.
+ * \param cert                  The private keypair certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_extract_public_fields_from_private_cert(
+    commandline_opts* opts, vccrypt_buffer_t* uuid,
+    vccrypt_buffer_t* encryption_pubkey, vccrypt_buffer_t* signing_pubkey,
+    const vccrypt_buffer_t* cert);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,63 @@
+/**
+ * \file command/pubkey/pubkey_key_cache_compare.c
+ *
+ * \brief Compare two derived key cache keys.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "pubkey_internal.h"
+
+/**
+ * \brief Compare two key cache keys.
+ *
+ * \param context           Unused.
+ * \param lhs               The left-hand side of the comparison.
+ * \param rhs               The right-hand side of the comparison.
+ *
+ * \returns an integer value representing the comparison result.
+ *      - RCPR_COMPARE_LT if \p lhs &lt; \p rhs.
+ *      - RCPR_COMPARE_EQ if \p lhs == \p rhs.
+ *      - RCPR_COMPARE_GT if \p lhs &gt; \p rhs.
+ */
+RCPR_SYM(rcpr_comparison_result) pubkey_key_cache_compare(
+    void* /*context*/, const void* lhs, const void* rhs)
+{
+    const pubkey_key_cache_key* l = (const pubkey_key_cache_key*)lhs;
+    const pubkey_key_cache_key* r = (const pubkey_key_cache_key*)rhs;
+
+    /* compare the number of rounds. */
+    if (l->rounds < r->rounds)
+    {
+        return RCPR_COMPARE_LT;
+    }
+    else if (l->rounds > r->rounds)
+    {
+        return RCPR_COMPARE_GT;
+    }
+
+    /* compare the salt size. */
+    if (l->salt_size < r->salt_size)
+    {
+        return RCPR_COMPARE_LT;
+    }
+    else if (l->salt_size > r->salt_size)
+    {
+        return RCPR_COMPARE_GT;
+    }
+
+    /* compare the salt. */
+    int retval = memcmp(l->salt, r->salt, l->salt_size);
+    if (retval < 0)
+    {
+        return RCPR_COMPARE_LT;
+    }
+    else if (retval > 0)
+    {
+        return RCPR_COMPARE_GT;
+    }
+    else
+    {
+        return RCPR_COMPARE_EQ;
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * \file command/pubkey/pubkey_key_cache_entry_create.c
+ *
+ * \brief Create a pending derived key cache entry.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "pubkey_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a key cache entry whose key is not yet derived.
+ *
+ * \param entry             Pointer to receive the entry on success.
+ * \param alloc             The allocator to use.
+ * \param salt              The salt, which is moved into the entry.
+ * \param rounds            The number of key derivation rounds.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int pubkey_key_cache_entry_create(
+    pubkey_key_cache_entry** entry, RCPR_SYM(allocator)* alloc,
+    vccrypt_buffer_t* salt, unsigned int rounds)
+{
+    int retval;
+    pubkey_key_cache_entry* tmp;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != entry);
+    MODEL_ASSERT(NULL != alloc);
+    MODEL_ASSERT(NULL != salt);
+
+    /* allocate memory for this entry. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &pubkey_key_cache_entry_resource_release);
+
+    /* set values. The entry takes ownership of the salt. */
+    tmp->alloc = alloc;
+    vccrypt_buffer_move(&tmp->salt, salt);
+    tmp->key.rounds = rounds;
+    tmp->key.salt = (const uint8_t*)tmp->salt.data;
+    tmp->key.salt_size = tmp->salt.size;
+    tmp->ready = false;
+
+    /* success. */
+    *entry = tmp;
+    retval = VCTOOL_STATUS_SUCCESS;
+
+done:
+    return retval;
+}
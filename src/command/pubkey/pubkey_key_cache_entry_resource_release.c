@@ -0,0 +1,42 @@
+/**
+ * \file command/pubkey/pubkey_key_cache_entry_resource_release.c
+ *
+ * \brief Release a derived key cache entry.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "pubkey_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Release a key cache entry.
+ *
+ * \param r                 The entry to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status pubkey_key_cache_entry_resource_release(RCPR_SYM(resource)* r)
+{
+    pubkey_key_cache_entry* entry = (pubkey_key_cache_entry*)r;
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = entry->alloc;
+
+    /* dispose the salt. */
+    dispose((disposable_t*)&entry->salt);
+
+    /* the derived key is only initialized if it was successfully derived. */
+    if (entry->ready && VCTOOL_STATUS_SUCCESS == entry->status)
+    {
+        dispose((disposable_t*)&entry->derived_key);
+    }
+
+    /* reclaim memory for this entry. */
+    return
+        rcpr_allocator_reclaim(alloc, entry);
+}
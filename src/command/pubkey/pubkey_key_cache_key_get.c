@@ -0,0 +1,25 @@
+/**
+ * \file command/pubkey/pubkey_key_cache_key_get.c
+ *
+ * \brief Get the key for a derived key cache entry.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "pubkey_internal.h"
+
+/**
+ * \brief Given a key cache entry, return its key.
+ *
+ * \param context           Unused.
+ * \param r                 The resource handle of the pubkey_key_cache_entry.
+ *
+ * \returns the key for the entry.
+ */
+const void* pubkey_key_cache_key_get(
+    void* /*context*/, const RCPR_SYM(resource)* r)
+{
+    const pubkey_key_cache_entry* entry = (const pubkey_key_cache_entry*)r;
+
+    return &entry->key;
+}
@@ -0,0 +1,66 @@
+/**
+ * \file command/restore/process_restore_command.c
+ *
+ * \brief Process command-line options to build a restore command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/root.h>
+#include <vctool/command/restore.h>
+#include <vctool/commandline.h>
+#include <vctool/status_codes.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Process the restore command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_restore_command(
+    commandline_opts* opts, int UNUSED(argc), char* UNUSED(argv[]))
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* allocate memory for a restore_command structure. */
+    restore_command* restore =
+        (restore_command*)malloc(sizeof(restore_command));
+    if (NULL == restore)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* initialize the structure. */
+    retval = restore_command_init(restore);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto free_restore;
+    }
+
+    /* set restore command as the head of opts command. */
+    restore->hdr.next = opts->cmd;
+    opts->cmd = &restore->hdr;
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto done;
+
+free_restore:
+    free(restore);
+
+done:
+    return retval;
+}
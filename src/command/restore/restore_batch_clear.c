@@ -0,0 +1,36 @@
+/**
+ * \file command/restore/restore_batch_clear.c
+ *
+ * \brief Dispose of the decrypted blocks of a restore batch.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "restore_internal.h"
+
+/**
+ * \brief Dispose of the decrypted blocks of a batch, so that it can be reused
+ * for the next chunk.
+ *
+ * \param batch             The batch to clear.
+ */
+void restore_batch_clear(restore_batch* batch)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+
+    for (size_t i = 0; i < batch->job_count; ++i)
+    {
+        if (batch->jobs[i].decrypted)
+        {
+            dispose((disposable_t*)&batch->jobs[i].block);
+        }
+    }
+
+    if (NULL != batch->jobs)
+    {
+        memset(batch->jobs, 0, batch->job_count * sizeof(restore_job));
+    }
+
+    batch->job_count = 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * \file command/restore/restore_batch_write.c
+ *
+ * \brief Write the decrypted blocks of a restore batch in height order.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <inttypes.h>
+
+#include "restore_internal.h"
+
+/* forward decls. */
+static int restore_job_compare(const void* lhs, const void* rhs);
+
+/**
+ * \brief Write the decrypted blocks of a batch that are in range, in height
+ * order, to the output directory or block store.
+ *
+ * \param batch             The batch to write.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT if two blocks share a height.
+ *      - a non-zero error code on failure.
+ */
+int restore_batch_write(restore_batch* batch)
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+
+    /* the records need not be in height order in the backup. */
+    qsort(
+        batch->jobs, batch->job_count, sizeof(restore_job),
+        &restore_job_compare);
+
+    for (size_t i = 0; i < batch->job_count; ++i)
+    {
+        const restore_job* job = &batch->jobs[i];
+        if (!job->in_range)
+        {
+            continue;
+        }
+
+        const uint8_t* block = (const uint8_t*)job->block.block_data.data;
+        size_t block_size = job->block.block_data.size;
+        uint64_t height = job->block.block_height;
+
+        if (i > 0 && batch->jobs[i - 1].in_range
+         && batch->jobs[i - 1].block.block_height == height)
+        {
+            retval = VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT;
+        }
+        else if (NULL != batch->store)
+        {
+            retval = block_store_append(batch->store, block, block_size);
+        }
+        else
+        {
+            retval =
+                restore_write_block(
+                    batch->opts, batch->output_dir, height, block,
+                    block_size);
+        }
+
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(
+                stderr, "Error writing block %" PRIu64 ": %s.\n", height,
+                restore_error_message(retval));
+            return retval;
+        }
+
+        ++batch->block_count;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Compare two restore jobs by block height.
+ *
+ * \param lhs               The left hand job.
+ * \param rhs               The right hand job.
+ *
+ * \returns less than, equal to, or greater than zero if the left hand height is
+ * less than, equal to, or greater than the right hand height.
+ */
+static int restore_job_compare(const void* lhs, const void* rhs)
+{
+    const restore_job* l = (const restore_job*)lhs;
+    const restore_job* r = (const restore_job*)rhs;
+
+    if (l->block.block_height < r->block.block_height)
+    {
+        return -1;
+    }
+    else if (l->block.block_height > r->block.block_height)
+    {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,323 @@
+/**
+ * \file command/restore/restore_command_func.c
+ *
+ * \brief Entry point for the restore command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <inttypes.h>
+#include <time.h>
+#include <vctool/parallel.h>
+
+#include "restore_internal.h"
+
+/**
+ * \brief Execute the restore command.
+ *
+ * The blocks in the backup file given with -i are restored into the block
+ * directory given with -o, one file per block, or into a block store with
+ * -D layout=store. A block store that already exists under -o is appended to.
+ * The passphrase of the backup file is read from the terminal. By default
+ * every block in the backup is restored; the range can be narrowed with
+ * -D from-height=N and -D to-height=N. Block records are authenticated and
+ * decrypted one chunk at a time on a worker pool, and each chunk is written in
+ * height order. Other records are authenticated and skipped, and a record of
+ * an unknown type is an error.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int restore_command_func(commandline_opts* opts)
+{
+    int retval, release_retval;
+    restore_batch batch;
+    block_store store;
+    vccrypt_buffer_t key;
+    file_stat_st fst;
+    const void* data = NULL;
+    size_t size = 0;
+    uint64_t offset;
+    const char* layout;
+    bool use_store;
+    bool found;
+    struct timespec start, end;
+    double elapsed;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* get restore and root command. */
+    restore_command* restore = (restore_command*)opts->cmd;
+    MODEL_ASSERT(NULL != restore);
+    root_command* root = (root_command*)restore->hdr.next;
+    MODEL_ASSERT(NULL != root);
+
+    /* we need a backup file and a block directory. */
+    if (NULL == root->input_filename)
+    {
+        fprintf(stderr, "Expecting a backup file (-i backup).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+    else if (NULL == root->output_filename)
+    {
+        fprintf(stderr, "Expecting a block directory (-o blocks).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+
+    if (VCTOOL_STATUS_SUCCESS !=
+            file_stat(opts->file, root->output_filename, &fst)
+     || !S_ISDIR(fst.fst_mode))
+    {
+        fprintf(
+            stderr, "%s is not a directory.\n", root->output_filename);
+        retval = VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+        goto done;
+    }
+
+    memset(&batch, 0, sizeof(batch));
+    batch.opts = opts;
+    batch.key = &key;
+    batch.output_dir = root->output_filename;
+
+    /* get the height range; by default, restore every block. */
+    batch.from_height = 0;
+    retval =
+        root_dict_get_uint64(
+            &batch.from_height, &found, root, RESTORE_DICT_KEY_FROM_HEIGHT);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    batch.to_height = UINT64_MAX;
+    retval =
+        root_dict_get_uint64(
+            &batch.to_height, &found, root, RESTORE_DICT_KEY_TO_HEIGHT);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+    else if (batch.from_height > batch.to_height)
+    {
+        fprintf(stderr, "The from-height is after the to-height.\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+        goto done;
+    }
+
+    /* get the output layout; by default, keep using an existing store. */
+    root_dict_find(&layout, root, RESTORE_DICT_KEY_LAYOUT);
+    if (NULL == layout)
+    {
+        use_store = block_store_exists(opts->file, root->output_filename);
+    }
+    else if (!strcmp(layout, "store"))
+    {
+        use_store = true;
+    }
+    else if (!strcmp(layout, "files"))
+    {
+        use_store = false;
+    }
+    else
+    {
+        fprintf(
+            stderr, "Unknown layout %s; expecting files or store.\n", layout);
+        retval = VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+        goto done;
+    }
+
+    /* allocate the jobs for one chunk. */
+    batch.jobs = (restore_job*)calloc(RESTORE_CHUNK_SIZE, sizeof(restore_job));
+    if (NULL == batch.jobs)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* read the file key. */
+    retval = restore_read_key(&key, opts, root->input_filename);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_jobs;
+    }
+
+    /* map the backup file read-only; each block is decrypted into its own
+     * buffer. */
+    retval =
+        file_map_contents(opts->file, root->input_filename, &data, &size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error reading %s.\n", root->input_filename);
+        goto cleanup_key;
+    }
+    else if (size < BACKUP_FILE_SIZE_FILE_ENC_HEADER)
+    {
+        fprintf(stderr, "%s is truncated.\n", root->input_filename);
+        retval = VCTOOL_ERROR_BACKUP_TRUNCATED_RECORD;
+        goto cleanup_map;
+    }
+
+    /* open the block store. */
+    if (use_store)
+    {
+        retval =
+            block_store_open(
+                &store, opts->file, root->output_filename, true);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(
+                stderr, "Error opening block store %s.\n",
+                root->output_filename);
+            goto cleanup_map;
+        }
+
+        batch.store = &store;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    /* the records follow the encryption header. */
+    offset = BACKUP_FILE_SIZE_FILE_ENC_HEADER;
+    while (offset < size)
+    {
+        /* find the block records in the next chunk of the file. */
+        while (batch.job_count < RESTORE_CHUNK_SIZE && offset < size)
+        {
+            backup_record_header header;
+            retval =
+                backup_record_header_read(
+                    &header, (const uint8_t*)data + offset, size - offset);
+            if (VCTOOL_STATUS_SUCCESS != retval)
+            {
+                fprintf(
+                    stderr, "%s: record at offset %" PRIu64 ": %s.\n",
+                    root->input_filename, offset,
+                    restore_error_message(retval));
+                goto cleanup_batch;
+            }
+
+            /* the type is only trusted once the record is authentic: block
+             * records are authenticated on the worker pool, and every other
+             * record here, so that no block record can be skipped by
+             * changing its type. */
+            if (header.type > BACKUP_RECORD_TYPE_BLOCK)
+            {
+                retval = VCTOOL_ERROR_BACKUP_BAD_RECORD;
+            }
+            else if (BACKUP_RECORD_TYPE_BLOCK != header.type)
+            {
+                retval =
+                    backup_record_authenticate(
+                        opts->suite, &key, &header,
+                        (const uint8_t*)data + offset);
+            }
+
+            if (VCTOOL_STATUS_SUCCESS != retval)
+            {
+                fprintf(
+                    stderr, "%s: record at offset %" PRIu64 ": %s.\n",
+                    root->input_filename, offset,
+                    restore_error_message(retval));
+                dispose((disposable_t*)&header);
+                goto cleanup_batch;
+            }
+            else if (BACKUP_RECORD_TYPE_BLOCK == header.type)
+            {
+                restore_job* job = &batch.jobs[batch.job_count];
+                job->record = (const uint8_t*)data + offset;
+                job->record_size = (size_t)header.record_size;
+                job->offset = offset;
+                ++batch.job_count;
+            }
+
+            offset += header.record_size;
+            dispose((disposable_t*)&header);
+        }
+
+        /* authenticate and decrypt this chunk on the worker pool. */
+        retval = parallel_for(batch.job_count, &restore_worker, &batch);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_batch;
+        }
+
+        /* report the first failure in file order. */
+        for (size_t i = 0; i < batch.job_count; ++i)
+        {
+            if (VCTOOL_STATUS_SUCCESS != batch.jobs[i].status)
+            {
+                fprintf(
+                    stderr, "%s: record at offset %" PRIu64 ": %s.\n",
+                    root->input_filename, batch.jobs[i].offset,
+                    restore_error_message(batch.jobs[i].status));
+                retval = batch.jobs[i].status;
+                goto cleanup_batch;
+            }
+        }
+
+        /* write this chunk in height order. */
+        retval = restore_batch_write(&batch);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_batch;
+        }
+
+        restore_batch_clear(&batch);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    /* report the restore rate. */
+    elapsed =
+        (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    if (0 == batch.block_count)
+    {
+        printf("No blocks to restore.\n");
+    }
+    else
+    {
+        printf(
+            "Restored %zu blocks in %.3f s (%.0f blocks/s).\n",
+            batch.block_count, elapsed,
+            (elapsed > 0) ? batch.block_count / elapsed : 0.0);
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_batch;
+
+cleanup_batch:
+    restore_batch_clear(&batch);
+
+    if (NULL != batch.store)
+    {
+        release_retval = block_store_close(batch.store);
+        if (VCTOOL_STATUS_SUCCESS != release_retval)
+        {
+            fprintf(
+                stderr, "Error syncing block store %s.\n",
+                root->output_filename);
+            retval = release_retval;
+        }
+    }
+
+cleanup_map:
+    if (NULL != data)
+    {
+        file_munmap(opts->file, data, size);
+    }
+
+cleanup_key:
+    dispose(vccrypt_buffer_disposable_handle(&key));
+
+cleanup_jobs:
+    free(batch.jobs);
+
+done:
+    return retval;
+}
@@ -0,0 +1,52 @@
+/**
+ * \file command/restore/restore_command_init.c
+ *
+ * \brief Initialize a restore command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/root.h>
+#include <vctool/command/restore.h>
+#include <vctool/status_codes.h>
+#include <vpr/parameters.h>
+
+/* forward decls. */
+static void restore_command_dispose(void* disp);
+
+/**
+ * \brief Initialize a restore command structure.
+ *
+ * \param restore       The restore command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int restore_command_init(restore_command* restore)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != restore);
+
+    /* clear restore command structure. */
+    memset(restore, 0, sizeof(restore_command));
+
+    /* set disposer, func, etc. */
+    restore->hdr.hdr.dispose = &restore_command_dispose;
+    restore->hdr.func = &restore_command_func;
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Dispose of a restore_command structure.
+ *
+ * \param disp          The restore_command structure to dispose.
+ */
+static void restore_command_dispose(void* UNUSED(disp))
+{
+    /* do nothing. */
+}
@@ -0,0 +1,40 @@
+/**
+ * \file command/restore/restore_error_message.c
+ *
+ * \brief Describe a restore failure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "restore_internal.h"
+
+/**
+ * \brief Get a message describing a restore failure.
+ *
+ * \param status            The status code of the failure.
+ *
+ * \returns a description of the failure.
+ */
+const char* restore_error_message(int status)
+{
+    switch (status)
+    {
+        case VCTOOL_ERROR_BACKUP_BAD_MAC:
+            return "record failed authentication";
+
+        case VCTOOL_ERROR_BACKUP_BAD_RECORD:
+            return "malformed record";
+
+        case VCTOOL_ERROR_BACKUP_TRUNCATED_RECORD:
+            return "truncated record";
+
+        case VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT:
+            return "duplicate block height";
+
+        case VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY:
+            return "out of memory";
+
+        default:
+            return "error decrypting block";
+    }
+}
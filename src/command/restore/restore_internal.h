@@ -0,0 +1,159 @@
+/**
+ * \file command/restore/restore_internal.h
+ *
+ * \brief Internal header for the restore command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <cbmc/model_assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vctool/backup.h>
+#include <vctool/block.h>
+#include <vctool/block_store.h>
+#include <vctool/command/restore.h>
+#include <vctool/command/root.h>
+#include <vctool/status_codes.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief The number of block records decrypted at once.
+ *
+ * The backup is restored one chunk at a time, so that memory use does not grow
+ * with the size of the backup.
+ */
+#define RESTORE_CHUNK_SIZE 4096
+
+/** \brief The root dictionary key for the first height to restore. */
+#define RESTORE_DICT_KEY_FROM_HEIGHT "from-height"
+
+/** \brief The root dictionary key for the last height to restore. */
+#define RESTORE_DICT_KEY_TO_HEIGHT "to-height"
+
+/**
+ * \brief The root dictionary key for the output layout: "files" for one file
+ * per block, or "store" for a block store.
+ */
+#define RESTORE_DICT_KEY_LAYOUT "layout"
+
+/** \brief A single block record to decrypt. */
+typedef struct restore_job restore_job;
+
+struct restore_job
+{
+    const uint8_t* record;
+    size_t record_size;
+    uint64_t offset;
+    backup_record_block block;
+    bool decrypted;
+    bool in_range;
+    int status;
+};
+
+/** \brief The shared state for restoring a chunk of block records. */
+typedef struct restore_batch restore_batch;
+
+struct restore_batch
+{
+    commandline_opts* opts;
+    vccrypt_buffer_t* key;
+    const char* output_dir;
+    block_store* store;
+    uint64_t from_height;
+    uint64_t to_height;
+    restore_job* jobs;
+    size_t job_count;
+    size_t block_count;
+};
+
+/**
+ * \brief Read the passphrase from the terminal and use it to read the file
+ * key from the encryption header of a backup file.
+ *
+ * \param key               Pointer to an uninitialized buffer to receive the
+ *                          file key. On success, this buffer is owned by the
+ *                          caller and must be disposed when no longer needed.
+ * \param opts              The command-line options to use.
+ * \param filename          The backup file.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int restore_read_key(
+    vccrypt_buffer_t* key, commandline_opts* opts, const char* filename);
+
+/**
+ * \brief Get a message describing a restore failure.
+ *
+ * \param status            The status code of the failure.
+ *
+ * \returns a description of the failure.
+ */
+const char* restore_error_message(int status);
+
+/**
+ * \brief Worker function; authenticates and decrypts a single block record.
+ *
+ * The record must hold a block certificate with the record block id and
+ * height. A block outside the height range of the batch is dropped.
+ *
+ * \param context           The restore batch.
+ * \param index             The index of the job to process.
+ */
+void restore_worker(void* context, size_t index);
+
+/**
+ * \brief Write the decrypted blocks of a batch that are in range, in height
+ * order, to the output directory or block store.
+ *
+ * \param batch             The batch to write.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT if two blocks share a height.
+ *      - a non-zero error code on failure.
+ */
+int restore_batch_write(restore_batch* batch);
+
+/**
+ * \brief Dispose of the decrypted blocks of a batch, so that it can be reused
+ * for the next chunk.
+ *
+ * \param batch             The batch to clear.
+ */
+void restore_batch_clear(restore_batch* batch);
+
+/**
+ * \brief Write a block to a new file in the output directory.
+ *
+ * The file is named for the block height, zero padded so that the files sort
+ * in height order.
+ *
+ * \param opts              The command-line options to use.
+ * \param output_dir        The output directory.
+ * \param height            The block height.
+ * \param block             The block certificate.
+ * \param block_size        The size of the block certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int restore_write_block(
+    commandline_opts* opts, const char* output_dir, uint64_t height,
+    const uint8_t* block, size_t block_size);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,100 @@
+/**
+ * \file command/restore/restore_read_key.c
+ *
+ * \brief Read the file key of a backup file.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <fcntl.h>
+#include <vctool/readpassword.h>
+
+#include "restore_internal.h"
+
+/**
+ * \brief Read the passphrase from the terminal and use it to read the file
+ * key from the encryption header of a backup file.
+ *
+ * \param key               Pointer to an uninitialized buffer to receive the
+ *                          file key. On success, this buffer is owned by the
+ *                          caller and must be disposed when no longer needed.
+ * \param opts              The command-line options to use.
+ * \param filename          The backup file.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int restore_read_key(
+    vccrypt_buffer_t* key, commandline_opts* opts, const char* filename)
+{
+    int retval, release_retval, fd;
+    vccrypt_buffer_t passphrase;
+    backup_file_enc_header header;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != key);
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+    MODEL_ASSERT(NULL != filename);
+
+    /* open the backup file. */
+    retval = file_open(opts->file, &fd, filename, O_RDONLY, 0);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error opening backup file %s.\n", filename);
+        goto done;
+    }
+
+    /* read the passphrase. */
+    printf("Enter passphrase: ");
+    fflush(stdout);
+    retval = readpassword(opts->suite, &passphrase);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Failure.\n");
+        goto cleanup_fd;
+    }
+    printf("\n");
+
+    /* derive the passphrase key and use it to decrypt the file key. */
+    retval =
+        backup_file_encryption_header_read(
+            opts->file, fd, opts->suite, &passphrase, &header, key);
+    switch (retval)
+    {
+        case VCTOOL_STATUS_SUCCESS:
+            dispose((disposable_t*)&header);
+            break;
+
+        case VCTOOL_ERROR_BACKUP_BAD_HEADER:
+            fprintf(stderr, "%s is not a supported backup file.\n", filename);
+            break;
+
+        case VCTOOL_ERROR_BACKUP_BAD_MAC:
+            fprintf(
+                stderr, "Wrong passphrase, or backup file %s is damaged.\n",
+                filename);
+            break;
+
+        default:
+            fprintf(stderr, "Error reading backup file %s.\n", filename);
+            break;
+    }
+
+    dispose(vccrypt_buffer_disposable_handle(&passphrase));
+
+cleanup_fd:
+    release_retval = file_close(opts->file, fd);
+    if (VCTOOL_STATUS_SUCCESS != release_retval)
+    {
+        if (VCTOOL_STATUS_SUCCESS == retval)
+        {
+            dispose(vccrypt_buffer_disposable_handle(key));
+        }
+
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,66 @@
+/**
+ * \file command/restore/restore_worker.c
+ *
+ * \brief Authenticate and decrypt a single block record.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "restore_internal.h"
+
+/**
+ * \brief Worker function; authenticates and decrypts a single block record.
+ *
+ * The record must hold a block certificate with the record block id and
+ * height. A block outside the height range of the batch is dropped.
+ *
+ * \param context           The restore batch.
+ * \param index             The index of the job to process.
+ */
+void restore_worker(void* context, size_t index)
+{
+    restore_batch* batch = (restore_batch*)context;
+    restore_job* job = &batch->jobs[index];
+    block_info info;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(index < batch->job_count);
+
+    /* authenticate and decrypt the record. */
+    job->status =
+        backup_record_block_decrypt(
+            &job->block, batch->opts->suite, batch->key, job->record,
+            job->record_size);
+    if (VCTOOL_STATUS_SUCCESS != job->status)
+    {
+        return;
+    }
+
+    job->decrypted = true;
+
+    /* the record must describe the block it holds. */
+    job->status =
+        block_info_read(
+            &info, job->block.block_data.data, job->block.block_data.size);
+    if (VCTOOL_STATUS_SUCCESS != job->status)
+    {
+        return;
+    }
+    else if (info.height != job->block.block_height
+          || memcmp(info.block_id, job->block.block_id.data, BLOCK_ID_SIZE))
+    {
+        job->status = VCTOOL_ERROR_BACKUP_BAD_RECORD;
+        return;
+    }
+
+    /* drop a block outside of the range. */
+    job->in_range =
+        job->block.block_height >= batch->from_height
+     && job->block.block_height <= batch->to_height;
+    if (!job->in_range)
+    {
+        dispose((disposable_t*)&job->block);
+        job->decrypted = false;
+    }
+}
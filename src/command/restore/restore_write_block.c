@@ -0,0 +1,97 @@
+/**
+ * \file command/restore/restore_write_block.c
+ *
+ * \brief Write a restored block to the output directory.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <fcntl.h>
+#include <inttypes.h>
+
+#include "restore_internal.h"
+
+/**
+ * \brief Write a block to a new file in the output directory.
+ *
+ * The file is named for the block height, zero padded so that the files sort
+ * in height order.
+ *
+ * \param opts              The command-line options to use.
+ * \param output_dir        The output directory.
+ * \param height            The block height.
+ * \param block             The block certificate.
+ * \param block_size        The size of the block certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int restore_write_block(
+    commandline_opts* opts, const char* output_dir, uint64_t height,
+    const uint8_t* block, size_t block_size)
+{
+    int retval, release_retval, fd;
+    char* filename;
+    size_t wrote_size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+    MODEL_ASSERT(NULL != output_dir);
+    MODEL_ASSERT(NULL != block);
+
+    /* build the filename. */
+    size_t filename_size = strlen(output_dir) + 32;
+    filename = (char*)malloc(filename_size);
+    if (NULL == filename)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    snprintf(
+        filename, filename_size, "%s/%020" PRIu64 ".block", output_dir,
+        height);
+
+    /* blocks are public, so they are readable by everyone. */
+    retval =
+        file_open(
+            opts->file, &fd, filename, O_CREAT | O_EXCL | O_WRONLY,
+            S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error opening output file %s.\n", filename);
+        goto cleanup_filename;
+    }
+
+    /* write the block. */
+    retval = file_write(opts->file, fd, block, block_size, &wrote_size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error writing to output file %s.\n", filename);
+        goto cleanup_fd;
+    }
+    else if (wrote_size != block_size)
+    {
+        fprintf(stderr, "Error: file %s truncated.\n", filename);
+        retval = VCTOOL_ERROR_FILE_IO;
+        goto cleanup_fd;
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_fd;
+
+cleanup_fd:
+    release_retval = file_close(opts->file, fd);
+    if (VCTOOL_STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_filename:
+    free(filename);
+
+done:
+    return retval;
+}
@@ -3,17 +3,29 @@
  *
  * \brief Dispatch root commands.
  *
- * \copyright 2020-2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2020-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include <cbmc/model_assert.h>
 #include <stdio.h>
 #include <string.h>
 #include <vctool/command/endorse.h>
+#include <vctool/command/endorse_check.h>
+#include <vctool/command/endorse_watch.h>
 #include <vctool/command/help.h>
+#include <vctool/command/history.h>
 #include <vctool/command/keygen.h>
+#include <vctool/command/mock_agent.h>
 #include <vctool/command/pubkey.h>
+#include <vctool/command/restore.h>
 #include <vctool/command/root.h>
+#include <vctool/command/rootblock.h>
+#include <vctool/command/show.h>
+#include <vctool/command/submit.h>
+#include <vctool/command/sync.h>
+#include <vctool/command/txn.h>
+#include <vctool/command/verify_cert.h>
+#include <vctool/command/verify_chain.h>
 #include <vctool/status_codes.h>
 
 /**
@@ -65,6 +77,66 @@ int dispatch_root_commands(commandline_opts* opts, int argc, char* argv[])
     {
         return process_endorse_command(opts, argc, argv);
     }
+    /* is this the endorse-check command? */
+    else if (!strcmp(command, "endorse-check"))
+    {
+        return process_endorse_check_command(opts, argc, argv);
+    }
+    /* is this the endorse-watch command? */
+    else if (!strcmp(command, "endorse-watch"))
+    {
+        return process_endorse_watch_command(opts, argc, argv);
+    }
+    /* is this the history command? */
+    else if (!strcmp(command, "history"))
+    {
+        return process_history_command(opts, argc, argv);
+    }
+    /* is this the mock-agent command? */
+    else if (!strcmp(command, "mock-agent"))
+    {
+        return process_mock_agent_command(opts, argc, argv);
+    }
+    /* is this the restore command? */
+    else if (!strcmp(command, "restore"))
+    {
+        return process_restore_command(opts, argc, argv);
+    }
+    /* is this the rootblock command? */
+    else if (!strcmp(command, "rootblock"))
+    {
+        return process_rootblock_command(opts, argc, argv);
+    }
+    /* is this the show command? */
+    else if (!strcmp(command, "show"))
+    {
+        return process_show_command(opts, argc, argv);
+    }
+    /* is this the submit command? */
+    else if (!strcmp(command, "submit"))
+    {
+        return process_submit_command(opts, argc, argv);
+    }
+    /* is this the sync command? */
+    else if (!strcmp(command, "sync"))
+    {
+        return process_sync_command(opts, argc, argv);
+    }
+    /* is this the txn command? */
+    else if (!strcmp(command, "txn"))
+    {
+        return process_txn_command(opts, argc, argv);
+    }
+    /* is this the verify-cert command? */
+    else if (!strcmp(command, "verify-cert"))
+    {
+        return process_verify_cert_command(opts, argc, argv);
+    }
+    /* is this the verify-chain command? */
+    else if (!strcmp(command, "verify-chain"))
+    {
+        return process_verify_chain_command(opts, argc, argv);
+    }
     /* handle unknown command. */
     else
     {
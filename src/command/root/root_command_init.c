@@ -3,7 +3,7 @@
  *
  * \brief Initialize the root command.
  *
- * \copyright 2020-2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2020-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include <cbmc/model_assert.h>
@@ -102,10 +102,21 @@ static void dispose_root_command(void* disp)
         free(root->key_filename);
     }
 
-    /* if the endorse config filename is set, then free it. */
-    if (NULL != root->endorse_config_filename)
+    /* if the output format is set, then free it. */
+    if (NULL != root->output_format)
     {
-        free(root->endorse_config_filename);
+        free(root->output_format);
+    }
+
+    /* if endorse config filenames are set, then free them. */
+    if (NULL != root->endorse_config_filenames)
+    {
+        for (size_t i = 0; i < root->endorse_config_filename_count; ++i)
+        {
+            free(root->endorse_config_filenames[i]);
+        }
+
+        free(root->endorse_config_filenames);
     }
 
     /* if the dict was created, then release it. */
@@ -0,0 +1,44 @@
+/**
+ * \file command/root/root_dict_find.c
+ *
+ * \brief Find a value in the root command dictionary.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/command/root.h>
+#include <vctool/status_codes.h>
+
+RCPR_IMPORT_rbtree;
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Find a value in the root command dictionary.
+ *
+ * \param value         Pointer to receive the value, or NULL if the key is not
+ *                      set.
+ * \param root          The command-line root command.
+ * \param key           The key to find.
+ */
+void root_dict_find(
+    const char** value, const root_command* root, const char* key)
+{
+    status retval;
+    root_dict_kvp* kvp;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != value);
+    MODEL_ASSERT(NULL != root);
+    MODEL_ASSERT(NULL != key);
+
+    /* look up the key. */
+    retval = rbtree_find((resource**)&kvp, (rbtree*)root->dict, key);
+    if (STATUS_SUCCESS != retval)
+    {
+        *value = NULL;
+        return;
+    }
+
+    *value = kvp->value;
+}
@@ -0,0 +1,61 @@
+/**
+ * \file command/root/root_dict_get_uint64.c
+ *
+ * \brief Get a number from the root command dictionary.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <vctool/command/root.h>
+#include <vctool/status_codes.h>
+
+/**
+ * \brief Get a decimal number from the root command dictionary.
+ *
+ * \param value         Pointer to receive the value.
+ * \param found         Set to true if the key is set, and false otherwise, in
+ *                      which case \p value is not changed.
+ * \param root          The command-line root command.
+ * \param key           The key to find.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER if the value is not a decimal
+ *        number.
+ */
+int root_dict_get_uint64(
+    uint64_t* value, bool* found, const root_command* root, const char* key)
+{
+    const char* str;
+    char* end;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != value);
+    MODEL_ASSERT(NULL != found);
+    MODEL_ASSERT(NULL != root);
+    MODEL_ASSERT(NULL != key);
+
+    root_dict_find(&str, root, key);
+    if (NULL == str)
+    {
+        *found = false;
+        return VCTOOL_STATUS_SUCCESS;
+    }
+
+    /* the value must be a plain decimal number. */
+    errno = 0;
+    unsigned long long number = strtoull(str, &end, 10);
+    if (str[0] < '0' || str[0] > '9' || '\0' != *end || ERANGE == errno)
+    {
+        fprintf(stderr, "Invalid %s value %s.\n", key, str);
+        return VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+    }
+
+    *value = (uint64_t)number;
+    *found = true;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
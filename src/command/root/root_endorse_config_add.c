@@ -0,0 +1,57 @@
+/**
+ * \file command/root/root_endorse_config_add.c
+ *
+ * \brief Add an endorse config filename to the root command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vctool/command/root.h>
+#include <vctool/status_codes.h>
+
+/**
+ * \brief Add an endorse config filename to the list of endorse config files.
+ *
+ * \param root          The command-line root command.
+ * \param filename      The endorse config filename to add.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int root_endorse_config_add(root_command* root, const char* filename)
+{
+    char** filenames;
+    char* copy;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != root);
+    MODEL_ASSERT(NULL != filename);
+
+    /* copy the filename. */
+    copy = strdup(filename);
+    if (NULL == copy)
+    {
+        return VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* grow the filename array by one. */
+    filenames =
+        (char**)realloc(
+            root->endorse_config_filenames,
+            (root->endorse_config_filename_count + 1) * sizeof(char*));
+    if (NULL == filenames)
+    {
+        free(copy);
+        return VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* append the filename. */
+    filenames[root->endorse_config_filename_count++] = copy;
+    root->endorse_config_filenames = filenames;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
@@ -0,0 +1,66 @@
+/**
+ * \file command/rootblock/process_rootblock_command.c
+ *
+ * \brief Process command-line options to build a rootblock command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/root.h>
+#include <vctool/command/rootblock.h>
+#include <vctool/commandline.h>
+#include <vctool/status_codes.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Process the rootblock command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_rootblock_command(
+    commandline_opts* opts, int UNUSED(argc), char* UNUSED(argv[]))
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* allocate memory for a rootblock_command structure. */
+    rootblock_command* rootblock =
+        (rootblock_command*)malloc(sizeof(rootblock_command));
+    if (NULL == rootblock)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* initialize the structure. */
+    retval = rootblock_command_init(rootblock);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto free_verify;
+    }
+
+    /* set rootblock command as the head of opts command. */
+    rootblock->hdr.next = opts->cmd;
+    opts->cmd = &rootblock->hdr;
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto done;
+
+free_verify:
+    free(rootblock);
+
+done:
+    return retval;
+}
@@ -0,0 +1,116 @@
+/**
+ * \file command/rootblock/rootblock_command_func.c
+ *
+ * \brief Entry point for the rootblock command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "rootblock_internal.h"
+
+RCPR_IMPORT_resource;
+RCPR_IMPORT_uuid;
+
+/**
+ * \brief Execute the rootblock command.
+ *
+ * A root block is built and signed with the keypair certificate given with -k,
+ * and written to the file given with -o. The block id and timestamp can be
+ * fixed with -D block-id=UUID and -D valid-from=SECONDS, in which case the
+ * output is byte-identical from run to run.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int rootblock_command_func(commandline_opts* opts)
+{
+    status retval, release_retval;
+    certfile* key_file;
+    vccrypt_buffer_t key_cert;
+    rcpr_uuid signer_id;
+    vccrypt_buffer_t signer_private_key;
+    rcpr_uuid block_id;
+    uint64_t valid_from;
+    vccrypt_buffer_t block;
+    const char* output_filename;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* get rootblock and root command. */
+    rootblock_command* rootblock = (rootblock_command*)opts->cmd;
+    MODEL_ASSERT(NULL != rootblock);
+    root_command* root = (root_command*)rootblock->hdr.next;
+    MODEL_ASSERT(NULL != root);
+
+    /* get the output filename. */
+    if (NULL != root->output_filename)
+    {
+        output_filename = root->output_filename;
+    }
+    else
+    {
+        output_filename = ROOTBLOCK_DEFAULT_OUTPUT_FILENAME;
+    }
+
+    /* get the block id and timestamp before prompting for a passphrase. */
+    TRY_OR_FAIL(rootblock_get_block_id(&block_id, opts, root), done);
+    TRY_OR_FAIL(rootblock_get_valid_from(&valid_from, root), done);
+
+    /* get the key filename. */
+    TRY_OR_FAIL(endorse_get_key_file(&key_file, opts, root->alloc, root), done);
+
+    /* Verify that the signer private key is valid and read it. */
+    TRY_OR_FAIL(
+        endorse_read_key_certificate(&key_cert, opts, key_file),
+        cleanup_key_file);
+
+    /* get the signer id and private signing key. */
+    TRY_OR_FAIL(
+        endorse_get_endorser_details(
+            &signer_id, &signer_private_key, opts, &key_cert),
+        cleanup_key_cert);
+
+    /* build and sign the root block. */
+    retval =
+        root_block_certificate_create(
+            opts, &block, (const uint8_t*)&block_id, valid_from,
+            (const uint8_t*)&signer_id, &signer_private_key);
+    if (STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error creating root block.\n");
+        goto cleanup_signer_private_key;
+    }
+
+    /* write the root block. */
+    TRY_OR_FAIL(
+        rootblock_write_output_file(opts, output_filename, &block),
+        cleanup_block);
+
+    if (root->verbose)
+    {
+        printf("Wrote root block to %s.\n", output_filename);
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_block;
+
+cleanup_block:
+    dispose(vccrypt_buffer_disposable_handle(&block));
+
+cleanup_signer_private_key:
+    dispose(vccrypt_buffer_disposable_handle(&signer_private_key));
+
+cleanup_key_cert:
+    dispose(vccrypt_buffer_disposable_handle(&key_cert));
+
+cleanup_key_file:
+    CLEANUP_OR_CASCADE(&key_file->hdr);
+
+done:
+    return retval;
+}
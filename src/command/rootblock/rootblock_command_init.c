@@ -0,0 +1,52 @@
+/**
+ * \file command/rootblock/rootblock_command_init.c
+ *
+ * \brief Initialize a rootblock command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/root.h>
+#include <vctool/command/rootblock.h>
+#include <vctool/status_codes.h>
+#include <vpr/parameters.h>
+
+/* forward decls. */
+static void rootblock_command_dispose(void* disp);
+
+/**
+ * \brief Initialize a rootblock command structure.
+ *
+ * \param rootblock     The rootblock command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int rootblock_command_init(rootblock_command* rootblock)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != rootblock);
+
+    /* clear rootblock command structure. */
+    memset(rootblock, 0, sizeof(rootblock_command));
+
+    /* set disposer, func, etc. */
+    rootblock->hdr.hdr.dispose = &rootblock_command_dispose;
+    rootblock->hdr.func = &rootblock_command_func;
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Dispose of a rootblock_command structure.
+ *
+ * \param disp          The rootblock_command structure to dispose.
+ */
+static void rootblock_command_dispose(void* UNUSED(disp))
+{
+    /* do nothing. */
+}
@@ -0,0 +1,92 @@
+/**
+ * \file command/rootblock/rootblock_get_block_id.c
+ *
+ * \brief Get the root block id from the command line or generate it.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "rootblock_internal.h"
+
+RCPR_IMPORT_uuid;
+
+/**
+ * \brief Get the root block id.
+ *
+ * The id is parsed from the block-id dictionary value if it is set, and is
+ * randomly generated otherwise.
+ *
+ * \param block_id          Pointer to receive the block id.
+ * \param opts              The command-line options to use.
+ * \param root              The root command config.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER if the block id is invalid.
+ *      - a non-zero error code on failure.
+ */
+status rootblock_get_block_id(
+    RCPR_SYM(rcpr_uuid)* block_id, commandline_opts* opts,
+    const root_command* root)
+{
+    status retval;
+    const char* value;
+    vccrypt_prng_context_t prng;
+    vccrypt_buffer_t uuidbuffer;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != block_id);
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+    MODEL_ASSERT(NULL != root);
+
+    /* use the block id from the command line if it is set. */
+    root_dict_find(&value, root, ROOTBLOCK_DICT_KEY_BLOCK_ID);
+    if (NULL != value)
+    {
+        retval = rcpr_uuid_parse_string(block_id, value);
+        if (STATUS_SUCCESS != retval)
+        {
+            fprintf(stderr, "Invalid block id %s.\n", value);
+            retval = VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+        }
+
+        goto done;
+    }
+
+    /* Open prng. */
+    retval = vccrypt_suite_prng_init(opts->suite, &prng);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* allocate buffer for random uuid. */
+    retval = vccrypt_suite_buffer_init_for_uuid(opts->suite, &uuidbuffer);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_prng;
+    }
+
+    /* Generate random uuid. */
+    retval = vccrypt_prng_read(&prng, &uuidbuffer, uuidbuffer.size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_uuidbuffer;
+    }
+
+    /* copy the random uuid. */
+    memcpy(block_id, uuidbuffer.data, sizeof(*block_id));
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_uuidbuffer;
+
+cleanup_uuidbuffer:
+    dispose((disposable_t*)&uuidbuffer);
+
+cleanup_prng:
+    dispose((disposable_t*)&prng);
+
+done:
+    return retval;
+}
@@ -0,0 +1,51 @@
+/**
+ * \file command/rootblock/rootblock_get_valid_from.c
+ *
+ * \brief Get the root block timestamp from the command line or the clock.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <time.h>
+
+#include "rootblock_internal.h"
+
+/**
+ * \brief Get the root block timestamp.
+ *
+ * The timestamp is parsed from the valid-from dictionary value if it is set,
+ * and is the current time otherwise.
+ *
+ * \param valid_from        Pointer to receive the timestamp, in seconds since
+ *                          the epoch.
+ * \param root              The root command config.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER if the timestamp is invalid.
+ */
+status rootblock_get_valid_from(uint64_t* valid_from, const root_command* root)
+{
+    status retval;
+    bool found;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != valid_from);
+    MODEL_ASSERT(NULL != root);
+
+    TRY_OR_FAIL(
+        root_dict_get_uint64(
+            valid_from, &found, root, ROOTBLOCK_DICT_KEY_VALID_FROM),
+        done);
+
+    /* without a timestamp on the command line, use the current time. */
+    if (!found)
+    {
+        *valid_from = (uint64_t)time(NULL);
+    }
+
+    retval = STATUS_SUCCESS;
+
+done:
+    return retval;
+}
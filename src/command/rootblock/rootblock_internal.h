@@ -0,0 +1,84 @@
+/**
+ * \file command/rootblock/rootblock_internal.h
+ *
+ * \brief Internal header for the rootblock command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <vctool/command/rootblock.h>
+
+#include "../endorse/endorse_internal.h"
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief The default root block output filename. */
+#define ROOTBLOCK_DEFAULT_OUTPUT_FILENAME "root.block"
+
+/** \brief The root dictionary key for the root block id. */
+#define ROOTBLOCK_DICT_KEY_BLOCK_ID "block-id"
+
+/** \brief The root dictionary key for the root block timestamp. */
+#define ROOTBLOCK_DICT_KEY_VALID_FROM "valid-from"
+
+/**
+ * \brief Get the root block id.
+ *
+ * The id is parsed from the block-id dictionary value if it is set, and is
+ * randomly generated otherwise.
+ *
+ * \param block_id          Pointer to receive the block id.
+ * \param opts              The command-line options to use.
+ * \param root              The root command config.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER if the block id is invalid.
+ *      - a non-zero error code on failure.
+ */
+status rootblock_get_block_id(
+    RCPR_SYM(rcpr_uuid)* block_id, commandline_opts* opts,
+    const root_command* root);
+
+/**
+ * \brief Get the root block timestamp.
+ *
+ * The timestamp is parsed from the valid-from dictionary value if it is set,
+ * and is the current time otherwise.
+ *
+ * \param valid_from        Pointer to receive the timestamp, in seconds since
+ *                          the epoch.
+ * \param root              The root command config.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER if the timestamp is invalid.
+ */
+status rootblock_get_valid_from(uint64_t* valid_from, const root_command* root);
+
+/**
+ * \brief Write the root block to a new output file.
+ *
+ * An existing file is never overwritten.
+ *
+ * \param opts              The command-line options to use.
+ * \param output_filename   The name of the output file.
+ * \param block             The root block to write.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status rootblock_write_output_file(
+    commandline_opts* opts, const char* output_filename,
+    const vccrypt_buffer_t* block);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,76 @@
+/**
+ * \file command/rootblock/rootblock_write_output_file.c
+ *
+ * \brief Write the root block to a new output file.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "rootblock_internal.h"
+
+/**
+ * \brief Write the root block to a new output file.
+ *
+ * An existing file is never overwritten.
+ *
+ * \param opts              The command-line options to use.
+ * \param output_filename   The name of the output file.
+ * \param block             The root block to write.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status rootblock_write_output_file(
+    commandline_opts* opts, const char* output_filename,
+    const vccrypt_buffer_t* block)
+{
+    status retval, release_retval;
+    int fd;
+    size_t wrote_size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+    MODEL_ASSERT(NULL != output_filename);
+    MODEL_ASSERT(NULL != block);
+
+    /* the root block is public, so it is readable by everyone. */
+    retval =
+        file_open(
+            opts->file, &fd, output_filename, O_CREAT | O_EXCL | O_WRONLY,
+            S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error opening output file %s.\n", output_filename);
+        goto done;
+    }
+
+    /* write the root block to the file. */
+    retval =
+        file_write(opts->file, fd, block->data, block->size, &wrote_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error writing to output file.\n");
+        goto cleanup_fd;
+    }
+    else if (wrote_size != block->size)
+    {
+        fprintf(stderr, "Error: file truncated.\n");
+        retval = VCTOOL_ERROR_FILE_IO;
+        goto cleanup_fd;
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_fd;
+
+cleanup_fd:
+    release_retval = file_close(opts->file, fd);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
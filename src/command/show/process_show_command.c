@@ -0,0 +1,70 @@
+/**
+ * \file command/show/process_show_command.c
+ *
+ * \brief Process command-line options to build a show command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/show.h>
+#include <vctool/command/root.h>
+#include <vctool/commandline.h>
+#include <vctool/status_codes.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Process the show command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_show_command(
+    commandline_opts* opts, int argc, char* argv[])
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* allocate memory for a show_command structure. */
+    show_command* show =
+        (show_command*)malloc(sizeof(show_command));
+    if (NULL == show)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* initialize the structure. */
+    retval = show_command_init(show);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto free_show;
+    }
+
+    /* any remaining arguments are additional input certificates. */
+    show->input_filenames = argv;
+    show->input_filename_count = argc > 0 ? (size_t)argc : 0U;
+
+    /* set show command as the head of opts command. */
+    show->hdr.next = opts->cmd;
+    opts->cmd = &show->hdr;
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto done;
+
+free_show:
+    free(show);
+
+done:
+    return retval;
+}
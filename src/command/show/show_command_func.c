@@ -0,0 +1,155 @@
+/**
+ * \file command/show/show_command_func.c
+ *
+ * \brief Entry point for the show command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "show_internal.h"
+
+/* forward decls. */
+static int show_file(file* f, show_format format, const char* filename);
+
+/**
+ * \brief Execute the show command.
+ *
+ * The fields of the certificate given with -i and of every certificate given
+ * as an argument are streamed to standard output in the format selected with
+ * -F: human (the default), jsonl, or csv. A block store directory given in
+ * place of a certificate shows every block in the store, in height order.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int show_command_func(commandline_opts* opts)
+{
+    int retval, file_retval;
+    show_format format;
+    char* buffer;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* get show and root command. */
+    show_command* show = (show_command*)opts->cmd;
+    MODEL_ASSERT(NULL != show);
+    root_command* root = (root_command*)show->hdr.next;
+    MODEL_ASSERT(NULL != root);
+
+    /* we need at least one certificate. */
+    if (NULL == root->input_filename && 0 == show->input_filename_count)
+    {
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        fprintf(
+            stderr,
+            "Expecting an input certificate (-i cert) or certificate "
+            "arguments.\n");
+        goto done;
+    }
+
+    /* get the output format. */
+    retval = show_format_parse(&format, root->output_format);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* buffer standard output heavily; it is flushed only when full. */
+    buffer = (char*)malloc(SHOW_OUTPUT_BUFFER_SIZE);
+    if (NULL != buffer)
+    {
+        setvbuf(stdout, buffer, _IOFBF, SHOW_OUTPUT_BUFFER_SIZE);
+    }
+
+    /* the CSV header comes before every row. */
+    if (SHOW_FORMAT_CSV == format)
+    {
+        fputs("file,index,type,name,value\n", stdout);
+    }
+
+    /* the -i certificate comes first, followed by the arguments. */
+    if (NULL != root->input_filename)
+    {
+        file_retval = show_file(opts->file, format, root->input_filename);
+        if (VCTOOL_STATUS_SUCCESS != file_retval)
+        {
+            retval = file_retval;
+        }
+    }
+
+    for (size_t i = 0; i < show->input_filename_count; ++i)
+    {
+        file_retval = show_file(opts->file, format, show->input_filenames[i]);
+        if (VCTOOL_STATUS_SUCCESS != file_retval)
+        {
+            retval = file_retval;
+        }
+    }
+
+    /* flush and restore standard output before the buffer is freed. */
+    if (0 != fflush(stdout) && VCTOOL_STATUS_SUCCESS == retval)
+    {
+        retval = VCTOOL_ERROR_FILE_IO;
+    }
+
+    if (NULL != buffer)
+    {
+        setvbuf(stdout, NULL, _IOLBF, 0);
+        free(buffer);
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Map a single certificate file, or every block in a block store, and
+ * stream its fields.
+ *
+ * \param f                 The file interface to use.
+ * \param format            The output format.
+ * \param filename          The certificate file or block store.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static int show_file(file* f, show_format format, const char* filename)
+{
+    int retval;
+    const void* data;
+    size_t size;
+
+    /* a block store holds many blocks. */
+    if (block_store_exists(f, filename))
+    {
+        return show_print_store(stdout, f, format, filename);
+    }
+
+    /* map the certificate. */
+    retval = file_map_contents(f, filename, &data, &size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error reading %s.\n", filename);
+        goto done;
+    }
+
+    /* stream its fields. */
+    retval = show_print_certificate(stdout, format, filename, data, size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "%s: malformed certificate.\n", filename);
+    }
+
+    if (NULL != data)
+    {
+        file_munmap(f, data, size);
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,52 @@
+/**
+ * \file command/show/show_command_init.c
+ *
+ * \brief Initialize a show command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/show.h>
+#include <vctool/command/root.h>
+#include <vctool/status_codes.h>
+#include <vpr/parameters.h>
+
+/* forward decls. */
+static void show_command_dispose(void* disp);
+
+/**
+ * \brief Initialize a show command structure.
+ *
+ * \param show          The show command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int show_command_init(show_command* show)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != show);
+
+    /* clear show command structure. */
+    memset(show, 0, sizeof(show_command));
+
+    /* set disposer, func, etc. */
+    show->hdr.hdr.dispose = &show_command_dispose;
+    show->hdr.func = &show_command_func;
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Dispose of a show_command structure.
+ *
+ * \param disp          The show_command structure to dispose.
+ */
+static void show_command_dispose(void* UNUSED(disp))
+{
+    /* do nothing. */
+}
@@ -0,0 +1,47 @@
+/**
+ * \file command/show/show_format_parse.c
+ *
+ * \brief Get the show output format with the given name.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "show_internal.h"
+
+/**
+ * \brief Get the output format with the given name.
+ *
+ * \param format            Pointer to receive the output format.
+ * \param name              The format name, or NULL for the default format.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER if the format is not known.
+ */
+int show_format_parse(show_format* format, const char* name)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != format);
+
+    if (NULL == name || !strcmp(name, "human"))
+    {
+        *format = SHOW_FORMAT_HUMAN;
+    }
+    else if (!strcmp(name, "jsonl") || !strcmp(name, "json"))
+    {
+        *format = SHOW_FORMAT_JSONL;
+    }
+    else if (!strcmp(name, "csv"))
+    {
+        *format = SHOW_FORMAT_CSV;
+    }
+    else
+    {
+        fprintf(
+            stderr, "Unknown output format %s; expecting human, jsonl, or "
+            "csv.\n", name);
+        return VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
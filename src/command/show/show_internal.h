@@ -0,0 +1,129 @@
+/**
+ * \file command/show/show_internal.h
+ *
+ * \brief Internal header for the show command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <cbmc/model_assert.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vctool/block_store.h>
+#include <vctool/certificate.h>
+#include <vctool/command/root.h>
+#include <vctool/command/show.h>
+#include <vctool/status_codes.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief The size of the standard output buffer used by the show command. */
+#define SHOW_OUTPUT_BUFFER_SIZE (1024 * 1024)
+
+/** \brief The output formats supported by the show command. */
+typedef enum show_format
+{
+    /** \brief One indented field per line, for people. */
+    SHOW_FORMAT_HUMAN,
+
+    /** \brief One JSON object per certificate, one certificate per line. */
+    SHOW_FORMAT_JSONL,
+
+    /** \brief One CSV row per field, after a header row. */
+    SHOW_FORMAT_CSV,
+} show_format;
+
+/**
+ * \brief Get the output format with the given name.
+ *
+ * \param format            Pointer to receive the output format.
+ * \param name              The format name, or NULL for the default format.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER if the format is not known.
+ */
+int show_format_parse(show_format* format, const char* name);
+
+/**
+ * \brief Stream the fields of a certificate to the given output.
+ *
+ * Each field is written as it is read; nothing is built in memory.
+ *
+ * \param out               The output stream.
+ * \param format            The output format.
+ * \param filename          The name of the certificate file.
+ * \param cert              The certificate.
+ * \param cert_size         The size of the certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED if the certificate is
+ *        malformed. The fields before the malformed field are written.
+ */
+int show_print_certificate(
+    FILE* out, show_format format, const char* filename, const void* cert,
+    size_t cert_size);
+
+/**
+ * \brief Stream the fields of every block in a block store to the given
+ * output, in height order.
+ *
+ * Each block is read in place and named for the store and block height, such
+ * as blocks@42. A malformed block is reported and the next block is shown.
+ *
+ * \param out               The output stream.
+ * \param f                 The file interface to use.
+ * \param format            The output format.
+ * \param dirname           The block store directory.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code if the store can't be opened or a block is
+ *        malformed.
+ */
+int show_print_store(
+    FILE* out, file* f, show_format format, const char* dirname);
+
+/**
+ * \brief Write a string, escaped for the given output format.
+ *
+ * JSON strings are escaped and CSV strings have their quotes doubled. The
+ * caller writes the surrounding quotes.
+ *
+ * \param out               The output stream.
+ * \param format            The output format.
+ * \param str               The string to write.
+ * \param size              The size of the string.
+ */
+void show_write_escaped(
+    FILE* out, show_format format, const char* str, size_t size);
+
+/**
+ * \brief Write a field value in its display format.
+ *
+ * Integers are written bare. Every other value is quoted for the JSON and CSV
+ * formats.
+ *
+ * \param out               The output stream.
+ * \param format            The output format.
+ * \param info              The field info, or NULL if the field is unknown.
+ * \param value             The field value.
+ * \param size              The size of the field value.
+ */
+void show_write_value(
+    FILE* out, show_format format, const certificate_field_info* info,
+    const uint8_t* value, size_t size);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
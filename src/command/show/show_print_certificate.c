@@ -0,0 +1,171 @@
+/**
+ * \file command/show/show_print_certificate.c
+ *
+ * \brief Stream the fields of a certificate.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "show_internal.h"
+
+/* forward decls. */
+static void show_print_field(
+    FILE* out, show_format format, const char* filename, size_t index,
+    uint16_t field_type, const uint8_t* value, size_t value_size);
+
+/**
+ * \brief Stream the fields of a certificate to the given output.
+ *
+ * Each field is written as it is read; nothing is built in memory.
+ *
+ * \param out               The output stream.
+ * \param format            The output format.
+ * \param filename          The name of the certificate file.
+ * \param cert              The certificate.
+ * \param cert_size         The size of the certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED if the certificate is
+ *        malformed. The fields before the malformed field are written.
+ */
+int show_print_certificate(
+    FILE* out, show_format format, const char* filename, const void* cert,
+    size_t cert_size)
+{
+    int retval = VCTOOL_STATUS_SUCCESS;
+    size_t offset = 0;
+    size_t index = 0;
+    uint16_t field_type;
+    const uint8_t* value;
+    size_t value_size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != out);
+    MODEL_ASSERT(NULL != filename);
+    MODEL_ASSERT(NULL != cert || 0 == cert_size);
+
+    /* write the certificate header. */
+    switch (format)
+    {
+        case SHOW_FORMAT_HUMAN:
+            fprintf(out, "%s:\n", filename);
+            break;
+
+        case SHOW_FORMAT_JSONL:
+            fputs("{\"file\":\"", out);
+            show_write_escaped(out, format, filename, strlen(filename));
+            fputs("\",\"fields\":[", out);
+            break;
+
+        default:
+            break;
+    }
+
+    /* stream each field. */
+    while (offset < cert_size)
+    {
+        retval =
+            certificate_next_field(
+                &field_type, &value, &value_size, &offset, cert, cert_size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            break;
+        }
+
+        show_print_field(
+            out, format, filename, index, field_type, value, value_size);
+        ++index;
+    }
+
+    /* write the certificate trailer. */
+    switch (format)
+    {
+        case SHOW_FORMAT_HUMAN:
+            if (VCTOOL_STATUS_SUCCESS != retval)
+            {
+                fputs("  error: malformed certificate\n", out);
+            }
+            break;
+
+        case SHOW_FORMAT_JSONL:
+            fputc(']', out);
+            if (VCTOOL_STATUS_SUCCESS != retval)
+            {
+                fputs(",\"error\":\"malformed certificate\"", out);
+            }
+            fputs("}\n", out);
+            break;
+
+        default:
+            break;
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Write a single certificate field.
+ *
+ * \param out               The output stream.
+ * \param format            The output format.
+ * \param filename          The name of the certificate file.
+ * \param index             The index of this field in the certificate.
+ * \param field_type        The field type.
+ * \param value             The field value.
+ * \param value_size        The size of the field value.
+ */
+static void show_print_field(
+    FILE* out, show_format format, const char* filename, size_t index,
+    uint16_t field_type, const uint8_t* value, size_t value_size)
+{
+    const certificate_field_info* info = certificate_field_info_get(field_type);
+
+    switch (format)
+    {
+        case SHOW_FORMAT_HUMAN:
+            if (NULL != info)
+            {
+                fprintf(out, "  %s: ", info->name);
+            }
+            else
+            {
+                fprintf(out, "  0x%04x: ", field_type);
+            }
+            break;
+
+        case SHOW_FORMAT_JSONL:
+            fprintf(
+                out, "%s{\"type\":%u,\"name\":", (index > 0) ? "," : "",
+                (unsigned int)field_type);
+            if (NULL != info)
+            {
+                fprintf(out, "\"%s\"", info->name);
+            }
+            else
+            {
+                fputs("null", out);
+            }
+            fputs(",\"value\":", out);
+            break;
+
+        case SHOW_FORMAT_CSV:
+            fputc('"', out);
+            show_write_escaped(out, format, filename, strlen(filename));
+            fprintf(
+                out, "\",%zu,%u,%s,", index, (unsigned int)field_type,
+                (NULL != info) ? info->name : "");
+            break;
+    }
+
+    show_write_value(out, format, info, value, value_size);
+
+    if (SHOW_FORMAT_JSONL == format)
+    {
+        fputc('}', out);
+    }
+    else
+    {
+        fputc('\n', out);
+    }
+}
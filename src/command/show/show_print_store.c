@@ -0,0 +1,90 @@
+/**
+ * \file command/show/show_print_store.c
+ *
+ * \brief Stream the fields of every block in a block store.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <inttypes.h>
+
+#include "show_internal.h"
+
+/**
+ * \brief Stream the fields of every block in a block store to the given
+ * output, in height order.
+ *
+ * Each block is read in place and named for the store and block height, such
+ * as blocks@42. A malformed block is reported and the next block is shown.
+ *
+ * \param out               The output stream.
+ * \param f                 The file interface to use.
+ * \param format            The output format.
+ * \param dirname           The block store directory.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code if the store can't be opened or a block is
+ *        malformed.
+ */
+int show_print_store(
+    FILE* out, file* f, show_format format, const char* dirname)
+{
+    int retval, block_retval;
+    block_store store;
+    const uint8_t* block;
+    char* name;
+    size_t name_size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != out);
+    MODEL_ASSERT(NULL != dirname);
+
+    retval = block_store_open(&store, f, dirname, false);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error opening block store %s.\n", dirname);
+        goto done;
+    }
+
+    name_size =
+        strlen(dirname)
+      + 1  /* @ */
+      + 20 /* height */
+      + 1; /* asciiz */
+
+    name = (char*)malloc(name_size);
+    if (NULL == name)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_store;
+    }
+
+    for (size_t i = 0; i < store.count; ++i)
+    {
+        const block_store_entry* entry = &store.entries[i];
+
+        snprintf(name, name_size, "%s@%" PRIu64, dirname, entry->height);
+
+        block_retval = block_store_read(&block, &store, entry);
+        if (VCTOOL_STATUS_SUCCESS == block_retval)
+        {
+            block_retval =
+                show_print_certificate(out, format, name, block, entry->size);
+        }
+
+        if (VCTOOL_STATUS_SUCCESS != block_retval)
+        {
+            fprintf(stderr, "%s: malformed certificate.\n", name);
+            retval = block_retval;
+        }
+    }
+
+    free(name);
+
+cleanup_store:
+    block_store_close(&store);
+
+done:
+    return retval;
+}
@@ -0,0 +1,87 @@
+/**
+ * \file command/show/show_write_escaped.c
+ *
+ * \brief Write a string escaped for a show output format.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "show_internal.h"
+
+/**
+ * \brief Write a string, escaped for the given output format.
+ *
+ * JSON strings are escaped and CSV strings have their quotes doubled. The
+ * caller writes the surrounding quotes.
+ *
+ * \param out               The output stream.
+ * \param format            The output format.
+ * \param str               The string to write.
+ * \param size              The size of the string.
+ */
+void show_write_escaped(
+    FILE* out, show_format format, const char* str, size_t size)
+{
+    size_t start = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != out);
+    MODEL_ASSERT(NULL != str || 0 == size);
+
+    /* write runs of plain characters at once. */
+    for (size_t i = 0; i < size; ++i)
+    {
+        unsigned char ch = (unsigned char)str[i];
+        bool plain;
+
+        switch (format)
+        {
+            case SHOW_FORMAT_JSONL:
+                plain = ch >= 0x20 && '"' != ch && '\\' != ch;
+                break;
+
+            case SHOW_FORMAT_CSV:
+                plain = '"' != ch;
+                break;
+
+            default:
+                plain = ch >= 0x20 || '\t' == ch;
+                break;
+        }
+
+        if (plain)
+        {
+            continue;
+        }
+
+        /* flush the run before this character. */
+        fwrite(str + start, 1, i - start, out);
+        start = i + 1;
+
+        switch (format)
+        {
+            case SHOW_FORMAT_JSONL:
+                if ('"' == ch || '\\' == ch)
+                {
+                    fputc('\\', out);
+                    fputc(ch, out);
+                }
+                else
+                {
+                    fprintf(out, "\\u%04x", ch);
+                }
+                break;
+
+            case SHOW_FORMAT_CSV:
+                fputs("\"\"", out);
+                break;
+
+            default:
+                fputc('?', out);
+                break;
+        }
+    }
+
+    /* flush the last run. */
+    fwrite(str + start, 1, size - start, out);
+}
@@ -0,0 +1,150 @@
+/**
+ * \file command/show/show_write_value.c
+ *
+ * \brief Write a certificate field value in its display format.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <inttypes.h>
+
+#include "show_internal.h"
+
+/* forward decls. */
+static void show_write_hex(FILE* out, const uint8_t* value, size_t size);
+static void show_write_uuids(FILE* out, const uint8_t* value, size_t size);
+
+/* the size of a UUID. */
+#define SHOW_UUID_SIZE 16
+
+/**
+ * \brief Write a field value in its display format.
+ *
+ * Integers are written bare. Every other value is quoted for the JSON and CSV
+ * formats.
+ *
+ * \param out               The output stream.
+ * \param format            The output format.
+ * \param info              The field info, or NULL if the field is unknown.
+ * \param value             The field value.
+ * \param size              The size of the field value.
+ */
+void show_write_value(
+    FILE* out, show_format format, const certificate_field_info* info,
+    const uint8_t* value, size_t size)
+{
+    certificate_field_format field_format =
+        (NULL != info) ? info->format : CERTIFICATE_FIELD_FORMAT_HEX;
+    bool quoted = SHOW_FORMAT_HUMAN != format;
+    uint64_t number = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != out);
+    MODEL_ASSERT(NULL != value || 0 == size);
+
+    /* a value of an unexpected size is shown as hex. */
+    if (CERTIFICATE_FIELD_FORMAT_UUID == field_format
+     && (0 == size || 0 != size % SHOW_UUID_SIZE))
+    {
+        field_format = CERTIFICATE_FIELD_FORMAT_HEX;
+    }
+    else if (CERTIFICATE_FIELD_FORMAT_UINT == field_format
+     && (0 == size || size > sizeof(uint64_t)))
+    {
+        field_format = CERTIFICATE_FIELD_FORMAT_HEX;
+    }
+
+    /* integers are stored in network byte order, and are never quoted. */
+    if (CERTIFICATE_FIELD_FORMAT_UINT == field_format)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            number = (number << 8) | value[i];
+        }
+
+        fprintf(out, "%" PRIu64, number);
+        return;
+    }
+
+    if (quoted)
+    {
+        fputc('"', out);
+    }
+
+    switch (field_format)
+    {
+        case CERTIFICATE_FIELD_FORMAT_UUID:
+            show_write_uuids(out, value, size);
+            break;
+
+        case CERTIFICATE_FIELD_FORMAT_STRING:
+            show_write_escaped(out, format, (const char*)value, size);
+            break;
+
+        default:
+            show_write_hex(out, value, size);
+            break;
+    }
+
+    if (quoted)
+    {
+        fputc('"', out);
+    }
+}
+
+/**
+ * \brief Write a value as lowercase hex.
+ *
+ * \param out               The output stream.
+ * \param value             The value to write.
+ * \param size              The size of the value.
+ */
+static void show_write_hex(FILE* out, const uint8_t* value, size_t size)
+{
+    static const char digits[] = "0123456789abcdef";
+    char buffer[256];
+    size_t offset = 0;
+
+    /* convert in chunks, so that each chunk is a single write. */
+    for (size_t i = 0; i < size; ++i)
+    {
+        buffer[offset++] = digits[value[i] >> 4];
+        buffer[offset++] = digits[value[i] & 0x0F];
+
+        if (sizeof(buffer) == offset)
+        {
+            fwrite(buffer, 1, offset, out);
+            offset = 0;
+        }
+    }
+
+    fwrite(buffer, 1, offset, out);
+}
+
+/**
+ * \brief Write a value as a space separated list of UUIDs.
+ *
+ * \param out               The output stream.
+ * \param value             The value to write; its size is a multiple of the
+ *                          UUID size.
+ * \param size              The size of the value.
+ */
+static void show_write_uuids(FILE* out, const uint8_t* value, size_t size)
+{
+    for (size_t i = 0; i < size; i += SHOW_UUID_SIZE)
+    {
+        const uint8_t* u = value + i;
+
+        if (i > 0)
+        {
+            fputc(' ', out);
+        }
+
+        fprintf(
+            out,
+            "%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-"
+            "%02x%02x%02x%02x%02x%02x",
+            u[0], u[1], u[2], u[3], u[4], u[5], u[6], u[7], u[8], u[9],
+            u[10], u[11], u[12], u[13], u[14], u[15]);
+    }
+}
@@ -0,0 +1,219 @@
+/**
+ * \file command/submit/submit_command_func.c
+ *
+ * \brief Entry point for the submit command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <inttypes.h>
+#include <signal.h>
+
+#include "submit_internal.h"
+
+/* forward decls. */
+static int submit_get_limit(
+    uint64_t* value, const root_command* root, const char* key,
+    uint64_t default_value, uint64_t min_value, uint64_t max_value);
+
+/**
+ * \brief Execute the submit command.
+ *
+ * The signed transactions in the file given with -i, as written by the txn
+ * command, are submitted to the agent listening on the socket given with -o,
+ * one vcblockchain transaction submit request per transaction. The client
+ * authenticates with the keypair given with -k and the agent public
+ * certificate given with -D agent-pubkey=FILE. Up to -D window=N requests are
+ * kept in flight; the number in flight adapts to the agent. A lost connection
+ * is reopened up to -D retries=N times with an increasing delay, and the
+ * requests that were in flight are sent again. The throughput and request
+ * latency percentiles are printed at the end.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int submit_command_func(commandline_opts* opts)
+{
+    int retval;
+    const void* data;
+    size_t size;
+    submit_txn* txns = NULL;
+    size_t txn_count;
+    uint64_t window, max_retries;
+    agent_keys keys;
+    agent_connection conn;
+    submit_state state;
+    struct timespec start, end;
+    double elapsed;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* get submit and root command. */
+    submit_command* submit = (submit_command*)opts->cmd;
+    MODEL_ASSERT(NULL != submit);
+    root_command* root = (root_command*)submit->hdr.next;
+    MODEL_ASSERT(NULL != root);
+
+    /* we need transactions and an agent. */
+    if (NULL == root->input_filename)
+    {
+        fprintf(stderr, "Expecting a transaction file (-i txns.cert).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+    else if (NULL == root->output_filename)
+    {
+        fprintf(stderr, "Expecting an agent socket (-o agent.sock).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+
+    /* get the limits. */
+    retval =
+        submit_get_limit(
+            &window, root, SUBMIT_DICT_KEY_WINDOW, SUBMIT_DEFAULT_WINDOW, 1,
+            SUBMIT_MAX_WINDOW);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    retval =
+        submit_get_limit(
+            &max_retries, root, SUBMIT_DICT_KEY_MAX_RETRIES,
+            SUBMIT_DEFAULT_MAX_RETRIES, 0, 1000);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* map the transactions. */
+    retval =
+        file_map_contents(opts->file, root->input_filename, &data, &size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error reading %s.\n", root->input_filename);
+        goto done;
+    }
+
+    /* find where each transaction starts before sending any of them. */
+    retval = submit_split_transactions(&txns, &txn_count, data, size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr, "%s is not a sequence of signed transactions.\n",
+            root->input_filename);
+        goto cleanup_data;
+    }
+
+    /* read the keys once; they are reused for every reconnect. */
+    retval = sync_read_keys(&keys, opts, root, SYNC_DICT_KEY_AGENT_PUBKEY);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_txns;
+    }
+
+    /* a write to a lost connection must fail with EPIPE, so that the
+     * connection can be reopened, instead of ending the process. */
+    signal(SIGPIPE, SIG_IGN);
+
+    /* connect to the agent. */
+    retval =
+        agent_connection_connect(
+            &conn, root->alloc, opts->suite, root->output_filename, &keys);
+    if (VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED == retval)
+    {
+        fprintf(
+            stderr, "Agent at %s failed to authenticate.\n",
+            root->output_filename);
+        goto cleanup_keys;
+    }
+    else if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr, "Error connecting to agent at %s.\n",
+            root->output_filename);
+        goto cleanup_keys;
+    }
+
+    retval =
+        submit_state_init(
+            &state, &conn, &keys, root->output_filename, txns, txn_count,
+            (size_t)window, (unsigned int)max_retries);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_conn;
+    }
+
+    /* submit the transactions. */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    retval = submit_run(&state);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    /* report what was submitted, even on failure. */
+    elapsed =
+        (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    submit_report(
+        (VCTOOL_STATUS_SUCCESS == retval) ? stdout : stderr, &state, elapsed);
+
+    submit_state_dispose(&state);
+
+cleanup_conn:
+    agent_connection_dispose(&conn);
+
+cleanup_keys:
+    agent_keys_dispose(&keys);
+
+cleanup_txns:
+    free(txns);
+
+cleanup_data:
+    if (NULL != data)
+    {
+        file_munmap(opts->file, data, size);
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Get a limit from the root command dictionary.
+ *
+ * \param value             Pointer to receive the limit.
+ * \param root              The root command config.
+ * \param key               The dictionary key.
+ * \param default_value     The limit if the key is not set.
+ * \param min_value         The smallest allowed limit.
+ * \param max_value         The largest allowed limit.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int submit_get_limit(
+    uint64_t* value, const root_command* root, const char* key,
+    uint64_t default_value, uint64_t min_value, uint64_t max_value)
+{
+    int retval;
+    bool found;
+
+    *value = default_value;
+    retval = root_dict_get_uint64(value, &found, root, key);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    if (*value < min_value || *value > max_value)
+    {
+        fprintf(
+            stderr, "The %s value must be between %" PRIu64 " and %" PRIu64
+            ".\n", key, min_value, max_value);
+        return VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
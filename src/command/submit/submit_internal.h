@@ -0,0 +1,187 @@
+/**
+ * \file command/submit/submit_internal.h
+ *
+ * \brief Internal header for the submit command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <time.h>
+#include <vctool/agent.h>
+#include <vctool/command/submit.h>
+#include <vctool/transaction.h>
+
+#include "../show/show_internal.h"
+#include "../sync/sync_internal.h"
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief The default number of requests in flight. */
+#define SUBMIT_DEFAULT_WINDOW 32
+
+/** \brief The largest number of requests in flight. */
+#define SUBMIT_MAX_WINDOW 4096
+
+/** \brief The default number of times a lost connection is reopened. */
+#define SUBMIT_DEFAULT_MAX_RETRIES 8
+
+/** \brief The delay before the first reconnect, in ms. */
+#define SUBMIT_RETRY_BASE_DELAY_MS 1
+
+/** \brief The longest delay before a reconnect, in ms. */
+#define SUBMIT_RETRY_MAX_DELAY_MS 1000
+
+/** \brief The root dictionary key for the number of requests in flight. */
+#define SUBMIT_DICT_KEY_WINDOW "window"
+
+/** \brief The root dictionary key for the number of reconnects. */
+#define SUBMIT_DICT_KEY_MAX_RETRIES "retries"
+
+/** \brief A signed transaction to submit. */
+typedef struct submit_txn submit_txn;
+
+struct submit_txn
+{
+    const uint8_t* cert;
+    size_t size;
+    RCPR_SYM(rcpr_uuid) txn_id;
+    RCPR_SYM(rcpr_uuid) artifact_id;
+};
+
+/** \brief A transaction submit request in flight. */
+typedef struct submit_request submit_request;
+
+struct submit_request
+{
+    size_t txn;
+    bool in_use;
+    bool resent;
+    struct timespec sent;
+};
+
+/**
+ * \brief The state of a transaction submission.
+ *
+ * Each transaction is submitted with its own vcblockchain transaction submit
+ * request. Each request in flight has a slot, and carries its slot index as
+ * its offset so that its response can be matched to it. The number of
+ * requests in flight is adapted to the agent: it grows by one with each
+ * accepted transaction, up to the window, and is halved when the connection
+ * is lost. A lost connection is reopened after a delay that doubles with each
+ * attempt, and every request that was still in flight is sent again on the
+ * new connection.
+ */
+typedef struct submit_state submit_state;
+
+struct submit_state
+{
+    agent_connection* conn;
+    const agent_keys* keys;
+    RCPR_SYM(allocator)* alloc;
+    vccrypt_suite_options_t* suite;
+    const char* path;
+    const submit_txn* txns;
+    size_t txn_count;
+    size_t window;
+    unsigned int max_retries;
+    size_t limit;
+    size_t next_txn;
+    submit_request* slots;
+    size_t* free_slots;
+    size_t free_count;
+    unsigned int attempts;
+    uint64_t* latencies;
+    size_t latency_count;
+    size_t latency_capacity;
+    size_t accepted;
+    size_t request_count;
+    size_t reconnect_count;
+    size_t resent_rejected;
+};
+
+/**
+ * \brief Split a stream of concatenated transaction certificates.
+ *
+ * The transaction and artifact ids of each transaction are read here, so that
+ * a malformed transaction is found before any transaction is sent.
+ *
+ * \param txns              Pointer to receive the array of transactions, which
+ *                          point into \p data. The caller must free this
+ *                          array.
+ * \param count             Pointer to receive the number of transactions.
+ * \param data              The concatenated transactions.
+ * \param size              The size of the concatenated transactions.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int submit_split_transactions(
+    submit_txn** txns, size_t* count, const void* data, size_t size);
+
+/**
+ * \brief Initialize a submission state.
+ *
+ * \param state             The state to initialize.
+ * \param conn              The connected agent connection.
+ * \param keys              The keys used to reconnect.
+ * \param path              The path of the agent socket.
+ * \param txns              The transactions to submit.
+ * \param txn_count         The number of transactions.
+ * \param window            The largest number of requests in flight.
+ * \param max_retries       The number of times a lost connection is reopened
+ *                          without any transaction being accepted.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY if the state can't be allocated.
+ */
+int submit_state_init(
+    submit_state* state, agent_connection* conn, const agent_keys* keys,
+    const char* path, const submit_txn* txns, size_t txn_count,
+    size_t window, unsigned int max_retries);
+
+/**
+ * \brief Dispose of a submission state.
+ *
+ * \param state             The state to dispose.
+ */
+void submit_state_dispose(submit_state* state);
+
+/**
+ * \brief Submit every transaction, keeping up to the window of requests in
+ * flight.
+ *
+ * \param state             The submission state.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_CONNECT_FAILED if the connection was still lost
+ *        after every retry.
+ *      - VCTOOL_ERROR_AGENT_REQUEST_FAILED if the agent rejected a
+ *        transaction.
+ *      - a non-zero error code on failure.
+ */
+int submit_run(submit_state* state);
+
+/**
+ * \brief Print the throughput and request latency percentiles of a finished
+ * submission.
+ *
+ * The latencies are sorted in place.
+ *
+ * \param out               The output stream.
+ * \param state             The submission state.
+ * \param elapsed           The elapsed time, in seconds.
+ */
+void submit_report(FILE* out, submit_state* state, double elapsed);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
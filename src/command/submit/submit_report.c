@@ -0,0 +1,83 @@
+/**
+ * \file command/submit/submit_report.c
+ *
+ * \brief Print the results of a transaction submission.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "submit_internal.h"
+
+/* forward decls. */
+static int submit_compare_latency(const void* lhs, const void* rhs);
+static double submit_percentile_ms(
+    const uint64_t* sorted, size_t count, unsigned int percentile);
+
+/**
+ * \brief Print the throughput and request latency percentiles of a finished
+ * submission.
+ *
+ * The latencies are sorted in place.
+ *
+ * \param out               The output stream.
+ * \param state             The submission state.
+ * \param elapsed           The elapsed time, in seconds.
+ */
+void submit_report(FILE* out, submit_state* state, double elapsed)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != out);
+    MODEL_ASSERT(NULL != state);
+
+    fprintf(
+        out,
+        "Submitted %zu transactions in %zu requests in %.3f s "
+        "(%.0f transactions/s); %zu reconnects, %zu resent and rejected.\n",
+        state->accepted, state->request_count, elapsed,
+        (elapsed > 0) ? state->accepted / elapsed : 0.0,
+        state->reconnect_count, state->resent_rejected);
+
+    if (0 == state->latency_count)
+    {
+        return;
+    }
+
+    qsort(
+        state->latencies, state->latency_count, sizeof(uint64_t),
+        &submit_compare_latency);
+
+    fprintf(
+        out,
+        "Request latency: p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, "
+        "max %.3f ms.\n",
+        submit_percentile_ms(state->latencies, state->latency_count, 50),
+        submit_percentile_ms(state->latencies, state->latency_count, 90),
+        submit_percentile_ms(state->latencies, state->latency_count, 99),
+        submit_percentile_ms(state->latencies, state->latency_count, 100));
+}
+
+/**
+ * \brief Compare two latencies.
+ */
+static int submit_compare_latency(const void* lhs, const void* rhs)
+{
+    uint64_t l = *(const uint64_t*)lhs;
+    uint64_t r = *(const uint64_t*)rhs;
+
+    return (l > r) - (l < r);
+}
+
+/**
+ * \brief Get a percentile of the sorted latencies by nearest rank, in ms.
+ */
+static double submit_percentile_ms(
+    const uint64_t* sorted, size_t count, unsigned int percentile)
+{
+    size_t rank = (count * percentile + 99) / 100;
+    if (rank > 0)
+    {
+        --rank;
+    }
+
+    return sorted[rank] / 1e6;
+}
@@ -0,0 +1,330 @@
+/**
+ * \file command/submit/submit_run.c
+ *
+ * \brief Submit transactions with pipelined requests and an adaptive window.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <errno.h>
+
+#include "submit_internal.h"
+
+/* forward decls. */
+static int submit_send(submit_state* state, size_t slot);
+static int submit_handle_response(
+    submit_state* state, uint32_t request_id, uint32_t offset,
+    uint32_t status, const struct timespec* now);
+static int submit_reconnect(submit_state* state);
+static int submit_record_latency(submit_state* state, uint64_t latency);
+static uint64_t submit_time_diff_ns(
+    const struct timespec* from, const struct timespec* to);
+
+/**
+ * \brief Submit every transaction, keeping up to the window of requests in
+ * flight.
+ *
+ * \param state             The submission state.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_CONNECT_FAILED if the connection was still lost
+ *        after every retry.
+ *      - VCTOOL_ERROR_AGENT_REQUEST_FAILED if the agent rejected a
+ *        transaction.
+ *      - a non-zero error code on failure.
+ */
+int submit_run(submit_state* state)
+{
+    int retval;
+    vccrypt_buffer_t response;
+    uint32_t request_id, offset, status;
+    struct timespec now;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != state);
+
+    while (
+        state->next_txn < state->txn_count
+     || state->free_count < state->window)
+    {
+        retval = VCTOOL_STATUS_SUCCESS;
+
+        /* send new transactions until the limit is reached. */
+        while (
+            state->next_txn < state->txn_count
+         && state->window - state->free_count < state->limit)
+        {
+            /* take a free slot; its index matches the response to this
+             * request. */
+            size_t slot = state->free_slots[--state->free_count];
+            state->slots[slot].txn = state->next_txn++;
+            state->slots[slot].in_use = true;
+            state->slots[slot].resent = false;
+
+            retval = submit_send(state, slot);
+            if (VCTOOL_STATUS_SUCCESS != retval)
+            {
+                break;
+            }
+        }
+
+        /* wait for a response. */
+        if (VCTOOL_STATUS_SUCCESS == retval)
+        {
+            retval =
+                agent_connection_receive(
+                    state->conn, &response, &request_id, &offset, &status);
+            if (VCTOOL_STATUS_SUCCESS == retval)
+            {
+                clock_gettime(CLOCK_MONOTONIC, &now);
+                retval =
+                    submit_handle_response(
+                        state, request_id, offset, status, &now);
+                dispose((disposable_t*)&response);
+                if (VCTOOL_STATUS_SUCCESS != retval)
+                {
+                    return retval;
+                }
+
+                continue;
+            }
+        }
+
+        /* a lost connection is reopened, and the requests that were in
+         * flight are sent again. */
+        while (VCTOOL_ERROR_AGENT_IO == retval)
+        {
+            retval = submit_reconnect(state);
+        }
+
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Send the transaction submit request in a slot.
+ *
+ * \param state             The submission state.
+ * \param slot              The slot of the request.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_IO if the connection is lost.
+ */
+static int submit_send(submit_state* state, size_t slot)
+{
+    int retval;
+    agent_connection* conn = state->conn;
+    submit_request* request = &state->slots[slot];
+    const submit_txn* txn = &state->txns[request->txn];
+
+    clock_gettime(CLOCK_MONOTONIC, &request->sent);
+    ++state->request_count;
+
+    retval =
+        vcblockchain_protocol_sendreq_transaction_submit(
+            conn->sock, conn->suite, &conn->client_iv, &conn->shared_secret,
+            (uint32_t)slot, &txn->txn_id, &txn->artifact_id, txn->cert,
+            (uint32_t)txn->size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return VCTOOL_ERROR_AGENT_IO;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Handle the response to a request.
+ *
+ * \param state             The submission state.
+ * \param request_id        The request id of the response.
+ * \param offset            The offset of the response.
+ * \param status            The status of the response.
+ * \param now               The time the response was received.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int submit_handle_response(
+    submit_state* state, uint32_t request_id, uint32_t offset,
+    uint32_t status, const struct timespec* now)
+{
+    int retval;
+
+    /* the offset must name a slot in flight. */
+    if (
+        PROTOCOL_REQ_ID_TRANSACTION_SUBMIT != request_id
+     || offset >= state->window
+     || !state->slots[offset].in_use)
+    {
+        return VCTOOL_ERROR_AGENT_PROTOCOL;
+    }
+
+    submit_request* request = &state->slots[offset];
+
+    retval =
+        submit_record_latency(state, submit_time_diff_ns(&request->sent, now));
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval = agent_status_to_error(status);
+    if (VCTOOL_STATUS_SUCCESS == retval)
+    {
+        /* the agent keeps up; allow one more request in flight. */
+        ++state->accepted;
+        state->attempts = 0;
+        if (state->limit < state->window)
+        {
+            ++state->limit;
+        }
+    }
+    else if (request->resent)
+    {
+        /* the agent may have accepted this transaction before the
+         * connection was lost, and rejects it as a duplicate. */
+        ++state->resent_rejected;
+    }
+    else
+    {
+        fprintf(stderr, "Agent rejected transaction %zu.\n", request->txn);
+        return retval;
+    }
+
+    /* free the slot. */
+    request->in_use = false;
+    state->free_slots[state->free_count++] = offset;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Reopen a lost connection, and send every request that was in flight
+ * again.
+ *
+ * The connection is reopened after a delay that doubles with each attempt,
+ * and the number of requests in flight is halved, so that an overloaded agent
+ * sees less traffic.
+ *
+ * \param state             The submission state.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_IO if the agent can't be reached or the new
+ *        connection is lost too.
+ *      - VCTOOL_ERROR_AGENT_CONNECT_FAILED if every retry has been used.
+ *      - a non-zero error code on failure.
+ */
+static int submit_reconnect(submit_state* state)
+{
+    int retval;
+    struct timespec delay;
+
+    /* give up once every retry is used. */
+    if (state->attempts >= state->max_retries)
+    {
+        fprintf(
+            stderr, "Connection to agent lost after %u retries.\n",
+            state->max_retries);
+        return VCTOOL_ERROR_AGENT_CONNECT_FAILED;
+    }
+
+    /* wait for a delay that doubles with each attempt. */
+    uint64_t delay_ms =
+        (uint64_t)SUBMIT_RETRY_BASE_DELAY_MS << state->attempts;
+    if (state->attempts > 16 || delay_ms > SUBMIT_RETRY_MAX_DELAY_MS)
+    {
+        delay_ms = SUBMIT_RETRY_MAX_DELAY_MS;
+    }
+
+    ++state->attempts;
+    delay.tv_sec = (time_t)(delay_ms / 1000);
+    delay.tv_nsec = (long)(delay_ms % 1000) * 1000000L;
+    while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, 0, &delay, &delay))
+    {
+    }
+
+    /* reopen the connection with the same keys. */
+    agent_connection_dispose(state->conn);
+    retval =
+        agent_connection_connect(
+            state->conn, state->alloc, state->suite, state->path,
+            state->keys);
+    if (VCTOOL_ERROR_AGENT_CONNECT_FAILED == retval)
+    {
+        return VCTOOL_ERROR_AGENT_IO;
+    }
+    else if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    ++state->reconnect_count;
+    state->limit = (state->limit + 1) / 2;
+
+    /* send the requests that were in flight again, in the same slots. */
+    for (size_t slot = 0; slot < state->window; ++slot)
+    {
+        if (state->slots[slot].in_use)
+        {
+            state->slots[slot].resent = true;
+            retval = submit_send(state, slot);
+            if (VCTOOL_STATUS_SUCCESS != retval)
+            {
+                return retval;
+            }
+        }
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Record the latency of a request.
+ *
+ * \param state             The submission state.
+ * \param latency           The latency, in nanoseconds.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int submit_record_latency(submit_state* state, uint64_t latency)
+{
+    if (state->latency_count == state->latency_capacity)
+    {
+        size_t capacity =
+            state->latency_capacity ? 2 * state->latency_capacity : 4096;
+        uint64_t* grown =
+            (uint64_t*)realloc(state->latencies, capacity * sizeof(uint64_t));
+        if (NULL == grown)
+        {
+            return VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        }
+
+        state->latencies = grown;
+        state->latency_capacity = capacity;
+    }
+
+    state->latencies[state->latency_count++] = latency;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Return the time between two times, in nanoseconds.
+ */
+static uint64_t submit_time_diff_ns(
+    const struct timespec* from, const struct timespec* to)
+{
+    int64_t diff =
+        (int64_t)(to->tv_sec - from->tv_sec) * 1000000000LL
+      + (to->tv_nsec - from->tv_nsec);
+
+    return (diff > 0) ? (uint64_t)diff : 0;
+}
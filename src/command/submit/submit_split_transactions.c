@@ -0,0 +1,101 @@
+/**
+ * \file command/submit/submit_split_transactions.c
+ *
+ * \brief Split a stream of concatenated transaction certificates.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "submit_internal.h"
+
+/**
+ * \brief Split a stream of concatenated transaction certificates.
+ *
+ * The transaction and artifact ids of each transaction are read here, so that
+ * a malformed transaction is found before any transaction is sent.
+ *
+ * \param txns              Pointer to receive the array of transactions, which
+ *                          point into \p data. The caller must free this
+ *                          array.
+ * \param count             Pointer to receive the number of transactions.
+ * \param data              The concatenated transactions.
+ * \param size              The size of the concatenated transactions.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int submit_split_transactions(
+    submit_txn** txns, size_t* count, const void* data, size_t size)
+{
+    int retval;
+    size_t offset = 0;
+    size_t capacity = 0;
+    submit_txn* array = NULL;
+    transaction_info info;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != txns);
+    MODEL_ASSERT(NULL != count);
+    MODEL_ASSERT(NULL != data || 0 == size);
+
+    *count = 0;
+
+    while (offset < size)
+    {
+        /* grow the array if needed. */
+        if (*count == capacity)
+        {
+            capacity = capacity ? 2 * capacity : 1024;
+            submit_txn* grown =
+                (submit_txn*)realloc(array, capacity * sizeof(submit_txn));
+            if (NULL == grown)
+            {
+                retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+                goto cleanup_array;
+            }
+
+            array = grown;
+        }
+
+        /* each transaction ends with its signature. */
+        submit_txn* txn = &array[*count];
+        retval =
+            certificate_stream_next(
+                &txn->cert, &txn->size, &offset, data, size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_array;
+        }
+
+        /* the size must fit in a request. */
+        if (txn->size > UINT32_MAX)
+        {
+            retval = VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED;
+            goto cleanup_array;
+        }
+
+        /* each request names the transaction and its artifact. */
+        retval = transaction_info_read(&info, txn->cert, txn->size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_array;
+        }
+
+        memcpy(&txn->txn_id, info.transaction_id, sizeof(txn->txn_id));
+        memcpy(
+            &txn->artifact_id, info.artifact_id, sizeof(txn->artifact_id));
+
+        ++*count;
+    }
+
+    *txns = array;
+
+    return VCTOOL_STATUS_SUCCESS;
+
+cleanup_array:
+    free(array);
+    *count = 0;
+
+    return retval;
+}
@@ -0,0 +1,25 @@
+/**
+ * \file command/submit/submit_state_dispose.c
+ *
+ * \brief Dispose of a transaction submission state.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "submit_internal.h"
+
+/**
+ * \brief Dispose of a submission state.
+ *
+ * \param state             The state to dispose.
+ */
+void submit_state_dispose(submit_state* state)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != state);
+
+    free(state->slots);
+    free(state->free_slots);
+    free(state->latencies);
+    memset(state, 0, sizeof(*state));
+}
@@ -0,0 +1,72 @@
+/**
+ * \file command/submit/submit_state_init.c
+ *
+ * \brief Initialize a transaction submission state.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "submit_internal.h"
+
+/**
+ * \brief Initialize a submission state.
+ *
+ * \param state             The state to initialize.
+ * \param conn              The connected agent connection.
+ * \param keys              The keys used to reconnect.
+ * \param path              The path of the agent socket.
+ * \param txns              The transactions to submit.
+ * \param txn_count         The number of transactions.
+ * \param window            The largest number of requests in flight.
+ * \param max_retries       The number of times a lost connection is reopened
+ *                          without any transaction being accepted.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY if the state can't be allocated.
+ */
+int submit_state_init(
+    submit_state* state, agent_connection* conn, const agent_keys* keys,
+    const char* path, const submit_txn* txns, size_t txn_count,
+    size_t window, unsigned int max_retries)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != state);
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(NULL != keys);
+    MODEL_ASSERT(NULL != path);
+    MODEL_ASSERT(NULL != txns || 0 == txn_count);
+    MODEL_ASSERT(window > 0);
+
+    memset(state, 0, sizeof(*state));
+    state->conn = conn;
+    state->keys = keys;
+    state->alloc = conn->alloc;
+    state->suite = conn->suite;
+    state->path = path;
+    state->txns = txns;
+    state->txn_count = txn_count;
+    state->window = window;
+    state->max_retries = max_retries;
+
+    /* start small, and let the agent's answers open the window. */
+    state->limit = 1;
+
+    state->slots = (submit_request*)calloc(window, sizeof(submit_request));
+    state->free_slots = (size_t*)malloc(window * sizeof(size_t));
+    if (NULL == state->slots || NULL == state->free_slots)
+    {
+        submit_state_dispose(state);
+        return VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* every slot starts free. */
+    for (size_t i = 0; i < window; ++i)
+    {
+        state->free_slots[i] = window - 1 - i;
+    }
+
+    state->free_count = window;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
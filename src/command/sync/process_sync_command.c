@@ -0,0 +1,66 @@
+/**
+ * \file command/sync/process_sync_command.c
+ *
+ * \brief Process command-line options to build a sync command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/root.h>
+#include <vctool/command/sync.h>
+#include <vctool/commandline.h>
+#include <vctool/status_codes.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Process the sync command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_sync_command(
+    commandline_opts* opts, int UNUSED(argc), char* UNUSED(argv[]))
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* allocate memory for a sync_command structure. */
+    sync_command* sync =
+        (sync_command*)malloc(sizeof(sync_command));
+    if (NULL == sync)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* initialize the structure. */
+    retval = sync_command_init(sync);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto free_verify;
+    }
+
+    /* set sync command as the head of opts command. */
+    sync->hdr.next = opts->cmd;
+    opts->cmd = &sync->hdr;
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto done;
+
+free_verify:
+    free(sync);
+
+done:
+    return retval;
+}
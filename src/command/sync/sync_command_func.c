@@ -0,0 +1,237 @@
+/**
+ * \file command/sync/sync_command_func.c
+ *
+ * \brief Entry point for the sync command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <inttypes.h>
+#include <time.h>
+
+#include "sync_internal.h"
+
+/**
+ * \brief Execute the sync command.
+ *
+ * Blocks are downloaded from the agent listening on the socket given with -i
+ * over the vcblockchain protocol, authenticating with the keypair given with
+ * -k and the agent public certificate given with -D agent-pubkey=FILE. They
+ * are written into the block directory given with -o, one file per block, or
+ * into a block store with -D layout=store. A block store that already exists
+ * under -o is appended to. By default every block up to the latest block is
+ * downloaded; the range can be narrowed with -D from-height=N and
+ * -D to-height=N. Up to -D window=N requests are kept in flight, so that the
+ * round trip time to the agent is paid once per window rather than once per
+ * block.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int sync_command_func(commandline_opts* opts)
+{
+    int retval, release_retval;
+    agent_connection conn;
+    block_store store;
+    sync_state state;
+    file_stat_st fst;
+    uint64_t window = SYNC_DEFAULT_WINDOW;
+    const char* layout;
+    bool use_store;
+    bool found;
+    struct timespec start, end;
+    double elapsed;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* get sync and root command. */
+    sync_command* sync = (sync_command*)opts->cmd;
+    MODEL_ASSERT(NULL != sync);
+    root_command* root = (root_command*)sync->hdr.next;
+    MODEL_ASSERT(NULL != root);
+
+    /* we need an agent and a block directory. */
+    if (NULL == root->input_filename)
+    {
+        fprintf(stderr, "Expecting an agent socket (-i agent.sock).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+    else if (NULL == root->output_filename)
+    {
+        fprintf(stderr, "Expecting a block directory (-o blocks).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+
+    if (VCTOOL_STATUS_SUCCESS !=
+            file_stat(opts->file, root->output_filename, &fst)
+     || !S_ISDIR(fst.fst_mode))
+    {
+        fprintf(
+            stderr, "%s is not a directory.\n", root->output_filename);
+        retval = VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+        goto done;
+    }
+
+    memset(&state, 0, sizeof(state));
+    state.opts = opts;
+    state.conn = &conn;
+    state.output_dir = root->output_filename;
+
+    /* get the window size. */
+    retval = root_dict_get_uint64(&window, &found, root, SYNC_DICT_KEY_WINDOW);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+    else if (0 == window || window > SYNC_MAX_WINDOW)
+    {
+        fprintf(
+            stderr, "The window must be between 1 and %d.\n",
+            SYNC_MAX_WINDOW);
+        retval = VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+        goto done;
+    }
+
+    state.window = (size_t)window;
+
+    /* get the output layout; by default, keep using an existing store. */
+    root_dict_find(&layout, root, SYNC_DICT_KEY_LAYOUT);
+    if (NULL == layout)
+    {
+        use_store = block_store_exists(opts->file, root->output_filename);
+    }
+    else if (!strcmp(layout, "store"))
+    {
+        use_store = true;
+    }
+    else if (!strcmp(layout, "files"))
+    {
+        use_store = false;
+    }
+    else
+    {
+        fprintf(
+            stderr, "Unknown layout %s; expecting files or store.\n", layout);
+        retval = VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+        goto done;
+    }
+
+    /* get the first height; by default, start at the root block. */
+    state.from_height = 0;
+    retval =
+        root_dict_get_uint64(
+            &state.from_height, &found, root, SYNC_DICT_KEY_FROM_HEIGHT);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* open the block store. */
+    if (use_store)
+    {
+        retval =
+            block_store_open(
+                &store, opts->file, root->output_filename, true);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(
+                stderr, "Error opening block store %s.\n",
+                root->output_filename);
+            goto done;
+        }
+
+        state.store = &store;
+    }
+
+    /* connect and authenticate to the agent. */
+    retval = sync_connect(&conn, opts, root, root->input_filename);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_store;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    /* get the last height; by default, stop at the latest block. */
+    retval =
+        root_dict_get_uint64(
+            &state.to_height, &found, root, SYNC_DICT_KEY_TO_HEIGHT);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_conn;
+    }
+    else if (!found)
+    {
+        retval = sync_get_latest_height(&state.to_height, &conn);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(stderr, "Error getting the latest block from agent.\n");
+            goto cleanup_conn;
+        }
+    }
+
+    /* each request carries its offset from the first height. */
+    if (state.to_height >= state.from_height
+     && state.to_height - state.from_height >= UINT32_MAX)
+    {
+        fprintf(stderr, "Too many blocks requested at once.\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+        goto cleanup_conn;
+    }
+
+    /* download the blocks. */
+    retval = sync_download(&state);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr, "Error downloading blocks; %zu downloaded.\n",
+            state.block_count);
+        goto cleanup_conn;
+    }
+
+    /* report the download rate. */
+    elapsed =
+        (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    if (0 == state.block_count)
+    {
+        printf("No blocks to download.\n");
+    }
+    else
+    {
+        printf(
+            "Downloaded %zu blocks (heights %" PRIu64 "..%" PRIu64 ") in "
+            "%.3f s (%.0f blocks/s).\n",
+            state.block_count, state.from_height, state.to_height, elapsed,
+            (elapsed > 0) ? state.block_count / elapsed : 0.0);
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_conn;
+
+cleanup_conn:
+    agent_connection_dispose(&conn);
+
+cleanup_store:
+    if (NULL != state.store)
+    {
+        release_retval = block_store_close(state.store);
+        if (VCTOOL_STATUS_SUCCESS != release_retval)
+        {
+            fprintf(
+                stderr, "Error syncing block store %s.\n",
+                root->output_filename);
+            retval = release_retval;
+        }
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,52 @@
+/**
+ * \file command/sync/sync_command_init.c
+ *
+ * \brief Initialize a sync command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/root.h>
+#include <vctool/command/sync.h>
+#include <vctool/status_codes.h>
+#include <vpr/parameters.h>
+
+/* forward decls. */
+static void sync_command_dispose(void* disp);
+
+/**
+ * \brief Initialize a sync command structure.
+ *
+ * \param sync          The sync command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int sync_command_init(sync_command* sync)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sync);
+
+    /* clear sync command structure. */
+    memset(sync, 0, sizeof(sync_command));
+
+    /* set disposer, func, etc. */
+    sync->hdr.hdr.dispose = &sync_command_dispose;
+    sync->hdr.func = &sync_command_func;
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Dispose of a sync_command structure.
+ *
+ * \param disp          The sync_command structure to dispose.
+ */
+static void sync_command_dispose(void* UNUSED(disp))
+{
+    /* do nothing. */
+}
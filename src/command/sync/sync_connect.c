@@ -0,0 +1,68 @@
+/**
+ * \file command/sync/sync_connect.c
+ *
+ * \brief Connect and authenticate to the agent.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "sync_internal.h"
+
+/**
+ * \brief Connect to the agent socket at the given path, and authenticate with
+ * the keypair given with -k and the agent public certificate given with
+ * -D agent-pubkey=FILE.
+ *
+ * \param conn              The connection to initialize.
+ * \param opts              The command-line options to use.
+ * \param root              The root command.
+ * \param path              The path of the agent socket.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int sync_connect(
+    agent_connection* conn, commandline_opts* opts, root_command* root,
+    const char* path)
+{
+    int retval;
+    agent_keys keys;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+    MODEL_ASSERT(NULL != root);
+    MODEL_ASSERT(NULL != path);
+
+    /* read the client keys and the agent public key. */
+    retval = sync_read_keys(&keys, opts, root, SYNC_DICT_KEY_AGENT_PUBKEY);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* connect and authenticate. */
+    retval =
+        agent_connection_connect(conn, root->alloc, opts->suite, path, &keys);
+    if (VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED == retval)
+    {
+        fprintf(stderr, "Agent at %s failed to authenticate.\n", path);
+        goto cleanup_keys;
+    }
+    else if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error connecting to agent at %s.\n", path);
+        goto cleanup_keys;
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_keys;
+
+cleanup_keys:
+    agent_keys_dispose(&keys);
+
+done:
+    return retval;
+}
@@ -0,0 +1,273 @@
+/**
+ * \file command/sync/sync_download.c
+ *
+ * \brief Download a range of blocks with pipelined agent requests.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <inttypes.h>
+
+#include "sync_internal.h"
+
+/* forward decls. */
+static int sync_send_next_id_request(sync_state* state);
+static int sync_handle_response(
+    sync_state* state, uint32_t request_id, uint32_t offset, uint32_t status,
+    const vccrypt_buffer_t* response);
+static int sync_handle_block_id(
+    sync_state* state, uint32_t offset, const vccrypt_buffer_t* response);
+static int sync_handle_block(
+    sync_state* state, uint64_t height, const vccrypt_buffer_t* response);
+
+/**
+ * \brief Download every block in the range of the given state, keeping up to
+ * the window of requests in flight.
+ *
+ * Each block is written to the output directory or appended to the block store
+ * as soon as it arrives.
+ *
+ * \param state             The download state.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int sync_download(sync_state* state)
+{
+    int retval;
+    vccrypt_buffer_t response;
+    uint32_t request_id, offset, status;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != state);
+    MODEL_ASSERT(NULL != state->conn);
+    MODEL_ASSERT(state->window > 0);
+
+    state->next_height = state->from_height;
+    state->outstanding = 0;
+    state->block_count = 0;
+
+    /* fill the window. */
+    while (
+        state->outstanding < state->window
+     && state->next_height <= state->to_height)
+    {
+        retval = sync_send_next_id_request(state);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    /* each response makes room for the next request. */
+    while (state->outstanding > 0)
+    {
+        retval =
+            agent_connection_receive(
+                state->conn, &response, &request_id, &offset, &status);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        retval =
+            sync_handle_response(
+                state, request_id, offset, status, &response);
+        dispose((disposable_t*)&response);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Queue a request for the block id at the next height.
+ *
+ * \param state             The download state.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int sync_send_next_id_request(sync_state* state)
+{
+    int retval;
+    agent_connection* conn = state->conn;
+
+    retval =
+        vcblockchain_protocol_sendreq_block_id_by_height_get(
+            conn->sock, conn->suite, &conn->client_iv, &conn->shared_secret,
+            (uint32_t)(state->next_height - state->from_height),
+            state->next_height);
+    if (STATUS_SUCCESS != retval)
+    {
+        return VCTOOL_ERROR_AGENT_IO;
+    }
+
+    ++state->next_height;
+    ++state->outstanding;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Handle a single response.
+ *
+ * A block id response is followed by a request for that block, and a block
+ * response is written out and followed by a request for the next block id.
+ *
+ * \param state             The download state.
+ * \param request_id        The request id of the response.
+ * \param offset            The offset of the response.
+ * \param status            The status of the response.
+ * \param response          The response.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int sync_handle_response(
+    sync_state* state, uint32_t request_id, uint32_t offset, uint32_t status,
+    const vccrypt_buffer_t* response)
+{
+    int retval;
+
+    uint64_t height = state->from_height + offset;
+    if (height > state->to_height || height >= state->next_height)
+    {
+        return VCTOOL_ERROR_AGENT_PROTOCOL;
+    }
+
+    /* report a failed request with its height. */
+    retval = agent_status_to_error(status);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr, "Agent request for block %" PRIu64 " failed.\n", height);
+        return retval;
+    }
+
+    switch (request_id)
+    {
+        case PROTOCOL_REQ_ID_BLOCK_ID_BY_HEIGHT_GET:
+            return sync_handle_block_id(state, offset, response);
+
+        case PROTOCOL_REQ_ID_BLOCK_BY_ID_GET:
+            return sync_handle_block(state, height, response);
+
+        default:
+            return VCTOOL_ERROR_AGENT_PROTOCOL;
+    }
+}
+
+/**
+ * \brief Request the block named by a block id response, keeping the same
+ * offset.
+ *
+ * \param state             The download state.
+ * \param offset            The offset of the response.
+ * \param response          The block id response.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int sync_handle_block_id(
+    sync_state* state, uint32_t offset, const vccrypt_buffer_t* response)
+{
+    int retval;
+    agent_connection* conn = state->conn;
+    protocol_resp_block_id_by_height_get resp;
+
+    retval =
+        vcblockchain_protocol_decode_resp_block_id_by_height_get(
+            &resp, conn->suite->alloc_opts, response->data, response->size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return VCTOOL_ERROR_AGENT_PROTOCOL;
+    }
+
+    retval =
+        vcblockchain_protocol_sendreq_block_get(
+            conn->sock, conn->suite, &conn->client_iv, &conn->shared_secret,
+            offset, &resp.block_id);
+    dispose((disposable_t*)&resp);
+    if (STATUS_SUCCESS != retval)
+    {
+        return VCTOOL_ERROR_AGENT_IO;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write out the block in a block response, and request the next block
+ * id.
+ *
+ * \param state             The download state.
+ * \param height            The height that was requested.
+ * \param response          The block response.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int sync_handle_block(
+    sync_state* state, uint64_t height, const vccrypt_buffer_t* response)
+{
+    int retval;
+    protocol_resp_block_get resp;
+
+    retval =
+        vcblockchain_protocol_decode_resp_block_get(
+            &resp, state->conn->suite->alloc_opts, response->data,
+            response->size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return VCTOOL_ERROR_AGENT_PROTOCOL;
+    }
+
+    /* the block must be the one that was asked for. */
+    if (resp.block_height != height)
+    {
+        fprintf(
+            stderr, "Agent returned block %" PRIu64 " for block %" PRIu64
+            ".\n", resp.block_height, height);
+        retval = VCTOOL_ERROR_AGENT_PROTOCOL;
+        goto cleanup_resp;
+    }
+
+    if (NULL != state->store)
+    {
+        retval =
+            block_store_append(
+                state->store, resp.block_cert.data, resp.block_cert.size);
+    }
+    else
+    {
+        retval =
+            sync_write_block(
+                state->opts, state->output_dir, height, resp.block_cert.data,
+                resp.block_cert.size);
+    }
+
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_resp;
+    }
+
+    --state->outstanding;
+    ++state->block_count;
+
+    /* keep the window full. */
+    if (state->next_height <= state->to_height)
+    {
+        retval = sync_send_next_id_request(state);
+        goto cleanup_resp;
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_resp;
+
+cleanup_resp:
+    dispose((disposable_t*)&resp);
+
+    return retval;
+}
@@ -0,0 +1,103 @@
+/**
+ * \file command/sync/sync_get_latest_height.c
+ *
+ * \brief Get the height of the latest block known to the agent.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "sync_internal.h"
+
+/**
+ * \brief Get the height of the latest block known to the agent.
+ *
+ * \param height            Pointer to receive the height.
+ * \param conn              The agent connection.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int sync_get_latest_height(uint64_t* height, agent_connection* conn)
+{
+    int retval;
+    vccrypt_buffer_t response;
+    protocol_resp_latest_block_id_get latest;
+    protocol_resp_block_get block;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != height);
+    MODEL_ASSERT(NULL != conn);
+
+    /* get the latest block id. */
+    retval =
+        vcblockchain_protocol_sendreq_latest_block_id_get(
+            conn->sock, conn->suite, &conn->client_iv, &conn->shared_secret,
+            0);
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_AGENT_IO;
+        goto done;
+    }
+
+    retval =
+        sync_receive_response(
+            &response, conn, PROTOCOL_REQ_ID_LATEST_BLOCK_ID_GET);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    retval =
+        vcblockchain_protocol_decode_resp_latest_block_id_get(
+            &latest, conn->suite->alloc_opts, response.data, response.size);
+    dispose((disposable_t*)&response);
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_AGENT_PROTOCOL;
+        goto done;
+    }
+
+    /* the height is only recorded in the block itself. */
+    retval =
+        vcblockchain_protocol_sendreq_block_get(
+            conn->sock, conn->suite, &conn->client_iv, &conn->shared_secret,
+            0, &latest.block_id);
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_AGENT_IO;
+        goto cleanup_latest;
+    }
+
+    retval =
+        sync_receive_response(
+            &response, conn, PROTOCOL_REQ_ID_BLOCK_BY_ID_GET);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_latest;
+    }
+
+    retval =
+        vcblockchain_protocol_decode_resp_block_get(
+            &block, conn->suite->alloc_opts, response.data, response.size);
+    dispose((disposable_t*)&response);
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_AGENT_PROTOCOL;
+        goto cleanup_latest;
+    }
+
+    /* success. */
+    *height = block.block_height;
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_block;
+
+cleanup_block:
+    dispose((disposable_t*)&block);
+
+cleanup_latest:
+    dispose((disposable_t*)&latest);
+
+done:
+    return retval;
+}
@@ -0,0 +1,185 @@
+/**
+ * \file command/sync/sync_internal.h
+ *
+ * \brief Internal header for the sync command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <cbmc/model_assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vctool/agent.h>
+#include <vctool/block.h>
+#include <vctool/block_store.h>
+#include <vctool/command/root.h>
+#include <vctool/command/sync.h>
+#include <vctool/status_codes.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief The default number of requests in flight. */
+#define SYNC_DEFAULT_WINDOW 64
+
+/** \brief The largest number of requests in flight. */
+#define SYNC_MAX_WINDOW 65536
+
+/** \brief The root dictionary key for the first height to download. */
+#define SYNC_DICT_KEY_FROM_HEIGHT "from-height"
+
+/** \brief The root dictionary key for the last height to download. */
+#define SYNC_DICT_KEY_TO_HEIGHT "to-height"
+
+/**
+ * \brief The root dictionary key for the output layout: "files" for one file
+ * per block, or "store" for a block store.
+ */
+#define SYNC_DICT_KEY_LAYOUT "layout"
+
+/** \brief The root dictionary key for the number of requests in flight. */
+#define SYNC_DICT_KEY_WINDOW "window"
+
+/** \brief The root dictionary key for the agent public certificate. */
+#define SYNC_DICT_KEY_AGENT_PUBKEY "agent-pubkey"
+
+/**
+ * \brief The state of a block download.
+ *
+ * Each request carries the offset of its height from the first height, so
+ * that a response can be matched with its height whatever order the agent
+ * answers in. Blocks are appended to the block store if there is one, and
+ * written to the output directory otherwise.
+ */
+typedef struct sync_state sync_state;
+
+struct sync_state
+{
+    commandline_opts* opts;
+    agent_connection* conn;
+    const char* output_dir;
+    block_store* store;
+    uint64_t from_height;
+    uint64_t to_height;
+    uint64_t next_height;
+    size_t window;
+    size_t outstanding;
+    size_t block_count;
+};
+
+/**
+ * \brief Read the keys for an agent connection.
+ *
+ * The local id and private encryption key are read from the keypair
+ * certificate given with -k, which is decrypted if needed. The peer id and
+ * public encryption key are read from the public certificate named by the
+ * given root dictionary key.
+ *
+ * \param keys              The keys to initialize. On success, the caller owns
+ *                          these keys and must dispose them with
+ *                          \ref agent_keys_dispose.
+ * \param opts              The command-line options to use.
+ * \param root              The root command.
+ * \param peer_dict_key     The root dictionary key naming the peer public
+ *                          certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int sync_read_keys(
+    agent_keys* keys, commandline_opts* opts, root_command* root,
+    const char* peer_dict_key);
+
+/**
+ * \brief Connect to the agent socket at the given path, and authenticate with
+ * the keypair given with -k and the agent public certificate given with
+ * -D agent-pubkey=FILE.
+ *
+ * \param conn              The connection to initialize.
+ * \param opts              The command-line options to use.
+ * \param root              The root command.
+ * \param path              The path of the agent socket.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int sync_connect(
+    agent_connection* conn, commandline_opts* opts, root_command* root,
+    const char* path);
+
+/**
+ * \brief Receive the response to the only request in flight.
+ *
+ * \param response          Buffer to be initialized with the response. On
+ *                          success, the caller owns this buffer and must
+ *                          dispose it.
+ * \param conn              The agent connection.
+ * \param request_id        The request that was sent, with offset zero.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_PROTOCOL if the response does not match.
+ *      - a non-zero error code if the request fails.
+ */
+int sync_receive_response(
+    vccrypt_buffer_t* response, agent_connection* conn, uint32_t request_id);
+
+/**
+ * \brief Get the height of the latest block known to the agent.
+ *
+ * \param height            Pointer to receive the height.
+ * \param conn              The agent connection.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int sync_get_latest_height(uint64_t* height, agent_connection* conn);
+
+/**
+ * \brief Download every block in the range of the given state, keeping up to
+ * the window of requests in flight.
+ *
+ * Each block is written to the output directory or appended to the block store
+ * as soon as it arrives.
+ *
+ * \param state             The download state.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int sync_download(sync_state* state);
+
+/**
+ * \brief Write a block to a new file in the output directory.
+ *
+ * The file is named for the block height, zero padded so that the files sort
+ * in height order.
+ *
+ * \param opts              The command-line options to use.
+ * \param output_dir        The output directory.
+ * \param height            The block height.
+ * \param block             The block certificate.
+ * \param block_size        The size of the block certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int sync_write_block(
+    commandline_opts* opts, const char* output_dir, uint64_t height,
+    const uint8_t* block, size_t block_size);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
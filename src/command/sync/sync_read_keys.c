@@ -0,0 +1,230 @@
+/**
+ * \file command/sync/sync_read_keys.c
+ *
+ * \brief Read the keys for an agent connection.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <vccert/fields.h>
+#include <vpr/parameters.h>
+
+#include "../endorse/endorse_internal.h"
+#include "sync_internal.h"
+
+static int sync_read_key_field(
+    RCPR_SYM(rcpr_uuid)* id, vccrypt_buffer_t* key, commandline_opts* opts,
+    const vccrypt_buffer_t* cert, int key_type, size_t key_size);
+
+/**
+ * \brief Read the keys for an agent connection.
+ *
+ * The local id and private encryption key are read from the keypair
+ * certificate given with -k, which is decrypted if needed. The peer id and
+ * public encryption key are read from the public certificate named by the
+ * given root dictionary key.
+ *
+ * \param keys              The keys to initialize. On success, the caller owns
+ *                          these keys and must dispose them with
+ *                          \ref agent_keys_dispose.
+ * \param opts              The command-line options to use.
+ * \param root              The root command.
+ * \param peer_dict_key     The root dictionary key naming the peer public
+ *                          certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int sync_read_keys(
+    agent_keys* keys, commandline_opts* opts, root_command* root,
+    const char* peer_dict_key)
+{
+    int retval, release_retval;
+    const char* peer_filename;
+    certfile* key_file;
+    certfile* peer_file;
+    vccrypt_buffer_t key_cert;
+    vccrypt_buffer_t peer_cert;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != keys);
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+    MODEL_ASSERT(NULL != root);
+    MODEL_ASSERT(NULL != peer_dict_key);
+
+    memset(keys, 0, sizeof(*keys));
+
+    /* we need the peer public certificate. */
+    root_dict_find(&peer_filename, root, peer_dict_key);
+    if (NULL == peer_filename)
+    {
+        fprintf(
+            stderr, "Expecting a public certificate (-D %s=FILE).\n",
+            peer_dict_key);
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+
+    /* get the key filename. */
+    TRY_OR_FAIL(endorse_get_key_file(&key_file, opts, root->alloc, root), done);
+
+    /* read the keypair certificate, decrypting it if needed. */
+    TRY_OR_FAIL(
+        endorse_read_key_certificate(&key_cert, opts, key_file),
+        cleanup_key_file);
+
+    /* get the local id and private encryption key. */
+    retval =
+        sync_read_key_field(
+            &keys->local_id, &keys->local_private_key, opts, &key_cert,
+            VCCERT_FIELD_TYPE_PRIVATE_ENCRYPTION_KEY,
+            opts->suite->key_cipher_opts.private_key_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr, "%s is not an encryption keypair.\n", root->key_filename);
+        goto cleanup_key_cert;
+    }
+
+    /* get the peer public certificate. */
+    TRY_OR_FAIL(
+        endorse_get_pubkey_file(&peer_file, opts, root->alloc, peer_filename),
+        cleanup_local_private_key);
+
+    TRY_OR_FAIL(
+        endorse_read_input_certificate(&peer_cert, opts, peer_file),
+        cleanup_peer_file);
+
+    /* get the peer id and public encryption key. */
+    retval =
+        sync_read_key_field(
+            &keys->peer_id, &keys->peer_public_key, opts, &peer_cert,
+            VCCERT_FIELD_TYPE_PUBLIC_ENCRYPTION_KEY,
+            opts->suite->key_cipher_opts.public_key_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr, "%s is not a public encryption certificate.\n",
+            peer_filename);
+        goto cleanup_peer_cert;
+    }
+
+    /* success. The caller owns both keys. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_peer_cert;
+
+cleanup_peer_cert:
+    dispose(vccrypt_buffer_disposable_handle(&peer_cert));
+
+cleanup_peer_file:
+    CLEANUP_OR_CASCADE(&peer_file->hdr);
+
+cleanup_local_private_key:
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        dispose(vccrypt_buffer_disposable_handle(&keys->local_private_key));
+    }
+
+cleanup_key_cert:
+    dispose(vccrypt_buffer_disposable_handle(&key_cert));
+
+cleanup_key_file:
+    CLEANUP_OR_CASCADE(&key_file->hdr);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Read the artifact id and an encryption key from a certificate.
+ *
+ * \param id                Pointer to be populated with the artifact id.
+ * \param key               Pointer to an uninitialized vccrypt buffer to be
+ *                          initialized with the key.
+ * \param opts              The command-line options to use.
+ * \param cert              The certificate to read.
+ * \param key_type          The field type of the key.
+ * \param key_size          The expected size of the key.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static int sync_read_key_field(
+    RCPR_SYM(rcpr_uuid)* id, vccrypt_buffer_t* key, commandline_opts* opts,
+    const vccrypt_buffer_t* cert, int key_type, size_t key_size)
+{
+    int retval;
+    vccert_parser_options_t parser_options;
+    vccert_parser_context_t parser;
+    const uint8_t* value;
+    size_t size;
+
+    /* create parser options. */
+    retval =
+        vccert_parser_options_simple_init(
+            &parser_options, opts->suite->alloc_opts, opts->suite);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* create a parser for the certificate. */
+    retval =
+        vccert_parser_init(&parser_options, &parser, cert->data, cert->size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_parser_options;
+    }
+
+    /* get and verify the artifact id. */
+    retval =
+        vccert_parser_find_short(
+            &parser, VCCERT_FIELD_TYPE_ARTIFACT_ID, &value, &size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_parser;
+    }
+    else if (sizeof(*id) != size)
+    {
+        retval = VCCERT_ERROR_PARSER_FIELD_INVALID_FIELD_SIZE;
+        goto cleanup_parser;
+    }
+
+    memcpy(id, value, size);
+
+    /* get and verify the key. */
+    retval = vccert_parser_find_short(&parser, key_type, &value, &size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_parser;
+    }
+    else if (key_size != size)
+    {
+        retval = VCCERT_ERROR_PARSER_FIELD_INVALID_FIELD_SIZE;
+        goto cleanup_parser;
+    }
+
+    /* copy the key. */
+    retval = vccrypt_buffer_init(key, opts->suite->alloc_opts, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_parser;
+    }
+
+    memcpy(key->data, value, size);
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_parser;
+
+cleanup_parser:
+    dispose((disposable_t*)&parser);
+
+cleanup_parser_options:
+    dispose((disposable_t*)&parser_options);
+
+done:
+    return retval;
+}
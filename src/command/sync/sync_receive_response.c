@@ -0,0 +1,65 @@
+/**
+ * \file command/sync/sync_receive_response.c
+ *
+ * \brief Receive the response to the only request in flight.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "sync_internal.h"
+
+/**
+ * \brief Receive the response to the only request in flight.
+ *
+ * \param response          Buffer to be initialized with the response. On
+ *                          success, the caller owns this buffer and must
+ *                          dispose it.
+ * \param conn              The agent connection.
+ * \param request_id        The request that was sent, with offset zero.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_PROTOCOL if the response does not match.
+ *      - a non-zero error code if the request fails.
+ */
+int sync_receive_response(
+    vccrypt_buffer_t* response, agent_connection* conn, uint32_t request_id)
+{
+    int retval;
+    uint32_t response_id, offset, status;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != response);
+    MODEL_ASSERT(NULL != conn);
+
+    retval =
+        agent_connection_receive(
+            conn, response, &response_id, &offset, &status);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* the response must answer the request. */
+    if (response_id != request_id || 0 != offset)
+    {
+        retval = VCTOOL_ERROR_AGENT_PROTOCOL;
+        goto cleanup_response;
+    }
+
+    /* the request must succeed. */
+    retval = agent_status_to_error(status);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_response;
+    }
+
+    /* success. The caller owns the response. */
+    goto done;
+
+cleanup_response:
+    dispose((disposable_t*)response);
+
+done:
+    return retval;
+}
@@ -0,0 +1,67 @@
+/**
+ * \file command/txn/txn_batch_assign_defaults.c
+ *
+ * \brief Fill in the default transaction id and timestamp of each job.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "txn_internal.h"
+
+/**
+ * \brief Give each job without a transaction id a random id, and each job
+ * without a timestamp the given timestamp.
+ *
+ * The random ids for the whole batch are read from the PRNG at once.
+ *
+ * \param batch             The batch to update.
+ * \param prng              The PRNG to use.
+ * \param ids               A buffer of at least 16 bytes per job.
+ * \param valid_from        The default timestamp.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int txn_batch_assign_defaults(
+    txn_batch* batch, vccrypt_prng_context_t* prng, vccrypt_buffer_t* ids,
+    uint64_t valid_from)
+{
+    int retval;
+    const uint8_t* id;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(NULL != prng);
+    MODEL_ASSERT(NULL != ids);
+    MODEL_ASSERT(ids->size >= batch->job_count * TRANSACTION_ID_SIZE);
+
+    /* read an id for every job, whether or not it is used. */
+    retval =
+        vccrypt_prng_read(
+            prng, ids, batch->job_count * TRANSACTION_ID_SIZE);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    id = (const uint8_t*)ids->data;
+    for (size_t i = 0; i < batch->job_count; ++i, id += TRANSACTION_ID_SIZE)
+    {
+        transaction_spec* spec = &batch->jobs[i].spec;
+
+        if (!(spec->fields
+                & TRANSACTION_FIELD_BIT(TRANSACTION_FIELD_TRANSACTION_ID)))
+        {
+            memcpy(spec->transaction_id, id, TRANSACTION_ID_SIZE);
+        }
+
+        if (!(spec->fields
+                & TRANSACTION_FIELD_BIT(TRANSACTION_FIELD_VALID_FROM)))
+        {
+            spec->valid_from = valid_from;
+        }
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
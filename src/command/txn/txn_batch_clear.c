@@ -0,0 +1,32 @@
+/**
+ * \file command/txn/txn_batch_clear.c
+ *
+ * \brief Dispose of the signed transactions of a batch.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "txn_internal.h"
+
+/**
+ * \brief Dispose of the signed transactions of a batch, so that it can be
+ * reused for the next chunk.
+ *
+ * \param batch             The batch to clear.
+ */
+void txn_batch_clear(txn_batch* batch)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+
+    for (size_t i = 0; i < batch->job_count; ++i)
+    {
+        if (batch->jobs[i].cert_created)
+        {
+            dispose(vccrypt_buffer_disposable_handle(&batch->jobs[i].cert));
+        }
+    }
+
+    memset(batch->jobs, 0, batch->job_count * sizeof(*batch->jobs));
+    batch->job_count = 0;
+}
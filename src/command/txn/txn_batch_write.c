@@ -0,0 +1,74 @@
+/**
+ * \file command/txn/txn_batch_write.c
+ *
+ * \brief Append the signed transactions of a batch to the output file.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <limits.h>
+#include <sys/uio.h>
+
+#include "txn_internal.h"
+
+/* the most transactions written by a single vectored write. */
+#ifdef IOV_MAX
+# define TXN_WRITE_IOV_COUNT IOV_MAX
+#else
+# define TXN_WRITE_IOV_COUNT 1024
+#endif
+
+/**
+ * \brief Append the signed transactions of a batch to the output file, in
+ * manifest order.
+ *
+ * \param batch             The batch to write.
+ * \param fd                The output file descriptor.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int txn_batch_write(txn_batch* batch, int fd)
+{
+    int retval;
+    struct iovec iov[TXN_WRITE_IOV_COUNT];
+    size_t iov_count, expected_size, wrote_size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(fd >= 0);
+
+    for (size_t i = 0; i < batch->job_count; i += iov_count)
+    {
+        /* gather as many transactions as fit in one vectored write. */
+        expected_size = 0;
+        for (
+            iov_count = 0;
+            iov_count < TXN_WRITE_IOV_COUNT && i + iov_count < batch->job_count;
+            ++iov_count)
+        {
+            const txn_job* job = &batch->jobs[i + iov_count];
+            iov[iov_count].iov_base = job->cert.data;
+            iov[iov_count].iov_len = job->cert.size;
+            expected_size += job->cert.size;
+        }
+
+        /* write these transactions. */
+        retval =
+            file_writev(
+                batch->opts->file, fd, iov, (int)iov_count, &wrote_size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(stderr, "Error writing to output file.\n");
+            return retval;
+        }
+        else if (wrote_size != expected_size)
+        {
+            fprintf(stderr, "Error: file truncated.\n");
+            return VCTOOL_ERROR_FILE_IO;
+        }
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
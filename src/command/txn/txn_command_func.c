@@ -0,0 +1,253 @@
+/**
+ * \file command/txn/txn_command_func.c
+ *
+ * \brief Entry point for the txn command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <time.h>
+
+#include "txn_internal.h"
+
+RCPR_IMPORT_resource;
+RCPR_IMPORT_uuid;
+
+/**
+ * \brief Execute the txn command.
+ *
+ * Each entry of the JSON Lines or CSV manifest given with -i is built into a
+ * transaction certificate and signed on a pool of worker threads, using the
+ * keypair certificate given with -k. If -o names a directory, each transaction
+ * is written to its own file there; otherwise, the transactions are
+ * concatenated into the file given with -o, in manifest order.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int txn_command_func(commandline_opts* opts)
+{
+    status retval, release_retval;
+    certfile* key_file;
+    vccrypt_buffer_t key_cert;
+    rcpr_uuid signer_id;
+    vccrypt_buffer_t signer_private_key;
+    txn_manifest manifest;
+    vccrypt_prng_context_t prng;
+    vccrypt_buffer_t ids;
+    txn_batch batch;
+    file_stat_st fst;
+    int fd = -1;
+    bool eof = false;
+    size_t total = 0;
+    struct timespec start, end;
+    double elapsed;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* get txn and root command. */
+    txn_command* txn = (txn_command*)opts->cmd;
+    MODEL_ASSERT(NULL != txn);
+    root_command* root = (root_command*)txn->hdr.next;
+    MODEL_ASSERT(NULL != root);
+
+    /* we need a manifest and somewhere to put the transactions. */
+    if (NULL == root->input_filename)
+    {
+        fprintf(stderr, "Expecting a manifest (-i manifest.jsonl).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+    else if (NULL == root->output_filename)
+    {
+        fprintf(
+            stderr, "Expecting an output file or directory (-o output).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+
+    /* write one file per transaction if the output is a directory. */
+    memset(&batch, 0, sizeof(batch));
+    if (STATUS_SUCCESS == file_stat(opts->file, root->output_filename, &fst)
+     && S_ISDIR(fst.fst_mode))
+    {
+        batch.output_dir = root->output_filename;
+    }
+
+    /* open the manifest first, so that a bad header fails fast. */
+    TRY_OR_FAIL(
+        txn_manifest_open(
+            &manifest, root->input_filename, root->output_format),
+        done);
+
+    /* get the key filename. */
+    TRY_OR_FAIL(
+        endorse_get_key_file(&key_file, opts, root->alloc, root),
+        cleanup_manifest);
+
+    /* decrypt the signer key once for every transaction. */
+    TRY_OR_FAIL(
+        endorse_read_key_certificate(&key_cert, opts, key_file),
+        cleanup_key_file);
+
+    /* get the signer id and private signing key. */
+    TRY_OR_FAIL(
+        endorse_get_endorser_details(
+            &signer_id, &signer_private_key, opts, &key_cert),
+        cleanup_key_cert);
+
+    /* create the PRNG for transaction ids. */
+    TRY_OR_FAIL(
+        vccrypt_suite_prng_init(opts->suite, &prng),
+        cleanup_signer_private_key);
+
+    /* create the id buffer for a chunk. */
+    TRY_OR_FAIL(
+        vccrypt_buffer_init(
+            &ids, opts->suite->alloc_opts,
+            TXN_CHUNK_SIZE * TRANSACTION_ID_SIZE),
+        cleanup_prng);
+
+    /* allocate the jobs for a chunk. */
+    batch.opts = opts;
+    batch.signer_id = &signer_id;
+    batch.signer_private_key = &signer_private_key;
+    batch.jobs = (txn_job*)calloc(TXN_CHUNK_SIZE, sizeof(txn_job));
+    if (NULL == batch.jobs)
+    {
+        fprintf(stderr, "Out of memory.\n");
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_ids;
+    }
+
+    /* otherwise, open the single output file. */
+    if (NULL == batch.output_dir)
+    {
+        retval =
+            file_open(
+                opts->file, &fd, root->output_filename,
+                O_CREAT | O_EXCL | O_WRONLY,
+                S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        if (STATUS_SUCCESS != retval)
+        {
+            fprintf(
+                stderr, "Error opening output file %s.\n",
+                root->output_filename);
+            goto cleanup_jobs;
+        }
+    }
+
+    /* the default timestamp is the same for every transaction. */
+    uint64_t valid_from = (uint64_t)time(NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (!eof)
+    {
+        /* read the next chunk of the manifest. */
+        while (batch.job_count < TXN_CHUNK_SIZE)
+        {
+            txn_job* job = &batch.jobs[batch.job_count];
+            TRY_OR_FAIL(
+                txn_manifest_read(&manifest, &job->spec, &eof), cleanup_fd);
+            if (eof)
+            {
+                break;
+            }
+
+            job->line_number = manifest.line_number;
+            ++batch.job_count;
+        }
+
+        /* the manifest ended on a chunk boundary. */
+        if (0 == batch.job_count)
+        {
+            break;
+        }
+
+        /* fill in the transaction ids and timestamps. */
+        TRY_OR_FAIL(
+            txn_batch_assign_defaults(&batch, &prng, &ids, valid_from),
+            cleanup_batch);
+
+        /* build and sign this chunk on the worker pool. */
+        TRY_OR_FAIL(
+            parallel_for(batch.job_count, &txn_worker, &batch),
+            cleanup_batch);
+
+        /* report the first failure in manifest order. */
+        for (size_t i = 0; i < batch.job_count; ++i)
+        {
+            if (STATUS_SUCCESS != batch.jobs[i].status)
+            {
+                fprintf(
+                    stderr, "%s:%zu: %s.\n", root->input_filename,
+                    batch.jobs[i].line_number,
+                    txn_error_message(batch.jobs[i].status));
+                retval = batch.jobs[i].status;
+                goto cleanup_batch;
+            }
+        }
+
+        /* append this chunk to the output file. */
+        if (NULL == batch.output_dir)
+        {
+            TRY_OR_FAIL(txn_batch_write(&batch, fd), cleanup_batch);
+        }
+
+        total += batch.job_count;
+        txn_batch_clear(&batch);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    /* report the signing rate. */
+    elapsed =
+        (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    printf(
+        "Signed %zu transaction(s) in %.3f s (%.0f transactions/s).\n",
+        total, elapsed, (elapsed > 0) ? total / elapsed : 0.0);
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_batch;
+
+cleanup_batch:
+    txn_batch_clear(&batch);
+
+cleanup_fd:
+    if (fd >= 0)
+    {
+        release_retval = file_close(opts->file, fd);
+        if (STATUS_SUCCESS != release_retval)
+        {
+            retval = release_retval;
+        }
+    }
+
+cleanup_jobs:
+    free(batch.jobs);
+
+cleanup_ids:
+    dispose(vccrypt_buffer_disposable_handle(&ids));
+
+cleanup_prng:
+    dispose((disposable_t*)&prng);
+
+cleanup_signer_private_key:
+    dispose(vccrypt_buffer_disposable_handle(&signer_private_key));
+
+cleanup_key_cert:
+    dispose(vccrypt_buffer_disposable_handle(&key_cert));
+
+cleanup_key_file:
+    CLEANUP_OR_CASCADE(&key_file->hdr);
+
+cleanup_manifest:
+    txn_manifest_close(&manifest);
+
+done:
+    return retval;
+}
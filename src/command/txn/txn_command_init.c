@@ -0,0 +1,52 @@
+/**
+ * \file command/txn/txn_command_init.c
+ *
+ * \brief Initialize a txn command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/root.h>
+#include <vctool/command/txn.h>
+#include <vctool/status_codes.h>
+#include <vpr/parameters.h>
+
+/* forward decls. */
+static void txn_command_dispose(void* disp);
+
+/**
+ * \brief Initialize a txn command structure.
+ *
+ * \param txn           The txn command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int txn_command_init(txn_command* txn)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != txn);
+
+    /* clear txn command structure. */
+    memset(txn, 0, sizeof(txn_command));
+
+    /* set disposer, func, etc. */
+    txn->hdr.hdr.dispose = &txn_command_dispose;
+    txn->hdr.func = &txn_command_func;
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Dispose of a txn_command structure.
+ *
+ * \param disp          The txn_command structure to dispose.
+ */
+static void txn_command_dispose(void* UNUSED(disp))
+{
+    /* do nothing. */
+}
@@ -0,0 +1,43 @@
+/**
+ * \file command/txn/txn_error_message.c
+ *
+ * \brief Describe a transaction failure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "txn_internal.h"
+
+/**
+ * \brief Get a message describing a transaction failure.
+ *
+ * \param status            The status code of the failure.
+ *
+ * \returns a description of the failure.
+ */
+const char* txn_error_message(int status)
+{
+    switch (status)
+    {
+        case VCTOOL_ERROR_TRANSACTION_SYNTAX:
+            return "malformed manifest entry";
+
+        case VCTOOL_ERROR_TRANSACTION_UNKNOWN_FIELD:
+            return "unknown field";
+
+        case VCTOOL_ERROR_TRANSACTION_DUPLICATE_FIELD:
+            return "duplicate field";
+
+        case VCTOOL_ERROR_TRANSACTION_MISSING_FIELD:
+            return "missing required field";
+
+        case VCTOOL_ERROR_TRANSACTION_BAD_VALUE:
+            return "invalid field value";
+
+        case VCTOOL_ERROR_FILE_IO:
+            return "error writing transaction";
+
+        default:
+            return "error building transaction";
+    }
+}
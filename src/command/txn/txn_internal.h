@@ -0,0 +1,202 @@
+/**
+ * \file command/txn/txn_internal.h
+ *
+ * \brief Internal header for the txn command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <vctool/command/txn.h>
+#include <vctool/transaction.h>
+
+#include "../endorse/endorse_internal.h"
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief The number of manifest entries signed at once.
+ *
+ * The manifest is read one chunk at a time, so that memory use does not grow
+ * with the size of the manifest.
+ */
+#define TXN_CHUNK_SIZE 8192
+
+/** \brief The manifest formats supported by the txn command. */
+typedef enum txn_manifest_format
+{
+    /** \brief One JSON object per line. */
+    TXN_MANIFEST_FORMAT_JSONL,
+
+    /** \brief A header row naming the fields, then one row per transaction. */
+    TXN_MANIFEST_FORMAT_CSV,
+} txn_manifest_format;
+
+/** \brief A transaction manifest, read one entry at a time. */
+typedef struct txn_manifest txn_manifest;
+
+struct txn_manifest
+{
+    FILE* in;
+    const char* filename;
+    txn_manifest_format format;
+    transaction_csv_header header;
+    char* line;
+    size_t line_capacity;
+    size_t line_number;
+};
+
+/** \brief A single transaction to build and sign. */
+typedef struct txn_job txn_job;
+
+struct txn_job
+{
+    transaction_spec spec;
+    size_t line_number;
+    vccrypt_buffer_t cert;
+    bool cert_created;
+    int status;
+};
+
+/** \brief The shared state for signing a chunk of transactions. */
+typedef struct txn_batch txn_batch;
+
+struct txn_batch
+{
+    commandline_opts* opts;
+    const RCPR_SYM(rcpr_uuid)* signer_id;
+    const vccrypt_buffer_t* signer_private_key;
+    const char* output_dir;
+    txn_job* jobs;
+    size_t job_count;
+};
+
+/**
+ * \brief Open a transaction manifest.
+ *
+ * The format is given by name, or by the manifest filename extension if no
+ * name is given: ".csv" for CSV, and JSON Lines otherwise. The manifest "-" is
+ * standard input. The header row of a CSV manifest is read here.
+ *
+ * \param manifest          The manifest to open.
+ * \param filename          The manifest filename.
+ * \param format_name       The manifest format name, or NULL.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int txn_manifest_open(
+    txn_manifest* manifest, const char* filename, const char* format_name);
+
+/**
+ * \brief Close a transaction manifest.
+ *
+ * \param manifest          The manifest to close.
+ */
+void txn_manifest_close(txn_manifest* manifest);
+
+/**
+ * \brief Read the next line from a transaction manifest that is not blank and
+ * is not a comment.
+ *
+ * The line ending is removed. The line is valid until the next read.
+ *
+ * \param manifest          The manifest to read.
+ * \param line              Pointer to receive the line.
+ * \param size              Pointer to receive the size of the line.
+ * \param eof               Set to true if there are no more lines.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_IO if the manifest could not be read.
+ */
+int txn_manifest_next_line(
+    txn_manifest* manifest, const char** line, size_t* size, bool* eof);
+
+/**
+ * \brief Read the next entry from a transaction manifest.
+ *
+ * Blank lines and lines starting with '#' are skipped. An invalid entry is
+ * reported with its line number.
+ *
+ * \param manifest          The manifest to read.
+ * \param spec              The transaction spec to populate.
+ * \param eof               Set to true if there are no more entries.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int txn_manifest_read(
+    txn_manifest* manifest, transaction_spec* spec, bool* eof);
+
+/**
+ * \brief Get a message describing a transaction failure.
+ *
+ * \param status            The status code of the failure.
+ *
+ * \returns a description of the failure.
+ */
+const char* txn_error_message(int status);
+
+/**
+ * \brief Give each job without a transaction id a random id, and each job
+ * without a timestamp the given timestamp.
+ *
+ * The random ids for the whole batch are read from the PRNG at once.
+ *
+ * \param batch             The batch to update.
+ * \param prng              The PRNG to use.
+ * \param ids               A buffer of at least 16 bytes per job.
+ * \param valid_from        The default timestamp.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int txn_batch_assign_defaults(
+    txn_batch* batch, vccrypt_prng_context_t* prng, vccrypt_buffer_t* ids,
+    uint64_t valid_from);
+
+/**
+ * \brief Worker function; builds and signs a single transaction.
+ *
+ * If the batch has an output directory, the transaction is also written to its
+ * own file there.
+ *
+ * \param context           The txn batch.
+ * \param index             The index of the job to process.
+ */
+void txn_worker(void* context, size_t index);
+
+/**
+ * \brief Append the signed transactions of a batch to the output file, in
+ * manifest order.
+ *
+ * \param batch             The batch to write.
+ * \param fd                The output file descriptor.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int txn_batch_write(txn_batch* batch, int fd);
+
+/**
+ * \brief Dispose of the signed transactions of a batch, so that it can be
+ * reused for the next chunk.
+ *
+ * \param batch             The batch to clear.
+ */
+void txn_batch_clear(txn_batch* batch);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
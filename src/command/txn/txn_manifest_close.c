@@ -0,0 +1,29 @@
+/**
+ * \file command/txn/txn_manifest_close.c
+ *
+ * \brief Close a transaction manifest.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "txn_internal.h"
+
+/**
+ * \brief Close a transaction manifest.
+ *
+ * \param manifest          The manifest to close.
+ */
+void txn_manifest_close(txn_manifest* manifest)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != manifest);
+
+    /* standard input is left open. */
+    if (NULL != manifest->in && stdin != manifest->in)
+    {
+        fclose(manifest->in);
+    }
+
+    free(manifest->line);
+    memset(manifest, 0, sizeof(*manifest));
+}
@@ -0,0 +1,84 @@
+/**
+ * \file command/txn/txn_manifest_next_line.c
+ *
+ * \brief Read the next line of a transaction manifest.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <ctype.h>
+
+#include "txn_internal.h"
+
+/**
+ * \brief Read the next line from a transaction manifest that is not blank and
+ * is not a comment.
+ *
+ * The line ending is removed. The line is valid until the next read.
+ *
+ * \param manifest          The manifest to read.
+ * \param line              Pointer to receive the line.
+ * \param size              Pointer to receive the size of the line.
+ * \param eof               Set to true if there are no more lines.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_IO if the manifest could not be read.
+ */
+int txn_manifest_next_line(
+    txn_manifest* manifest, const char** line, size_t* size, bool* eof)
+{
+    ssize_t length;
+    char* start;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != manifest);
+    MODEL_ASSERT(NULL != line);
+    MODEL_ASSERT(NULL != size);
+    MODEL_ASSERT(NULL != eof);
+
+    for (;;)
+    {
+        /* read the next line, growing the line buffer as needed. */
+        length =
+            getline(&manifest->line, &manifest->line_capacity, manifest->in);
+        if (length < 0)
+        {
+            if (ferror(manifest->in))
+            {
+                fprintf(stderr, "Error reading from %s.\n", manifest->filename);
+                return VCTOOL_ERROR_FILE_IO;
+            }
+
+            *eof = true;
+            return VCTOOL_STATUS_SUCCESS;
+        }
+
+        ++manifest->line_number;
+
+        /* trim trailing whitespace, including the line ending. */
+        while (length > 0 && isspace((unsigned char)manifest->line[length - 1]))
+        {
+            --length;
+        }
+
+        /* trim leading whitespace. */
+        start = manifest->line;
+        while (length > 0 && isspace((unsigned char)*start))
+        {
+            ++start;
+            --length;
+        }
+
+        /* skip blank lines and comments. */
+        if (0 == length || '#' == *start)
+        {
+            continue;
+        }
+
+        *line = start;
+        *size = (size_t)length;
+        *eof = false;
+        return VCTOOL_STATUS_SUCCESS;
+    }
+}
@@ -0,0 +1,157 @@
+/**
+ * \file command/txn/txn_manifest_open.c
+ *
+ * \brief Open a transaction manifest.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "txn_internal.h"
+
+/* forward decls. */
+static int txn_manifest_format_get(
+    txn_manifest_format* format, const char* filename,
+    const char* format_name);
+
+/**
+ * \brief Open a transaction manifest.
+ *
+ * The format is given by name, or by the manifest filename extension if no
+ * name is given: ".csv" for CSV, and JSON Lines otherwise. The manifest "-" is
+ * standard input. The header row of a CSV manifest is read here.
+ *
+ * \param manifest          The manifest to open.
+ * \param filename          The manifest filename.
+ * \param format_name       The manifest format name, or NULL.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int txn_manifest_open(
+    txn_manifest* manifest, const char* filename, const char* format_name)
+{
+    int retval;
+    const char* line;
+    size_t size;
+    bool eof;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != manifest);
+    MODEL_ASSERT(NULL != filename);
+
+    memset(manifest, 0, sizeof(*manifest));
+    manifest->filename = filename;
+
+    /* get the manifest format. */
+    retval = txn_manifest_format_get(&manifest->format, filename, format_name);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* open the manifest. */
+    if (!strcmp(filename, "-"))
+    {
+        manifest->in = stdin;
+    }
+    else
+    {
+        manifest->in = fopen(filename, "r");
+        if (NULL == manifest->in)
+        {
+            fprintf(stderr, "Error opening file %s for read.\n", filename);
+            retval = VCTOOL_ERROR_FILE_NO_ENTRY;
+            goto done;
+        }
+    }
+
+    /* a JSON Lines manifest has no header. */
+    if (TXN_MANIFEST_FORMAT_CSV != manifest->format)
+    {
+        retval = VCTOOL_STATUS_SUCCESS;
+        goto done;
+    }
+
+    /* read the CSV header row. */
+    retval = txn_manifest_next_line(manifest, &line, &size, &eof);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_manifest;
+    }
+    else if (eof)
+    {
+        fprintf(stderr, "%s: missing CSV header row.\n", filename);
+        retval = VCTOOL_ERROR_TRANSACTION_SYNTAX;
+        goto cleanup_manifest;
+    }
+
+    retval = transaction_csv_header_parse(&manifest->header, line, size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr, "%s:%zu: bad CSV header row: %s.\n", filename,
+            manifest->line_number, txn_error_message(retval));
+        goto cleanup_manifest;
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto done;
+
+cleanup_manifest:
+    txn_manifest_close(manifest);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Get the format of a manifest.
+ *
+ * \param format            Pointer to receive the manifest format.
+ * \param filename          The manifest filename.
+ * \param format_name       The manifest format name, or NULL.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER if the format is not known.
+ */
+static int txn_manifest_format_get(
+    txn_manifest_format* format, const char* filename,
+    const char* format_name)
+{
+    /* without a format name, go by the filename extension. */
+    if (NULL == format_name)
+    {
+        size_t length = strlen(filename);
+        if (length >= 4 && !strcmp(filename + length - 4, ".csv"))
+        {
+            *format = TXN_MANIFEST_FORMAT_CSV;
+        }
+        else
+        {
+            *format = TXN_MANIFEST_FORMAT_JSONL;
+        }
+
+        return VCTOOL_STATUS_SUCCESS;
+    }
+
+    if (!strcmp(format_name, "jsonl") || !strcmp(format_name, "json"))
+    {
+        *format = TXN_MANIFEST_FORMAT_JSONL;
+    }
+    else if (!strcmp(format_name, "csv"))
+    {
+        *format = TXN_MANIFEST_FORMAT_CSV;
+    }
+    else
+    {
+        fprintf(
+            stderr, "Unknown manifest format %s (expecting jsonl or csv).\n",
+            format_name);
+        return VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
@@ -0,0 +1,63 @@
+/**
+ * \file command/txn/txn_manifest_read.c
+ *
+ * \brief Read the next entry from a transaction manifest.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "txn_internal.h"
+
+/**
+ * \brief Read the next entry from a transaction manifest.
+ *
+ * Blank lines and lines starting with '#' are skipped. An invalid entry is
+ * reported with its line number.
+ *
+ * \param manifest          The manifest to read.
+ * \param spec              The transaction spec to populate.
+ * \param eof               Set to true if there are no more entries.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int txn_manifest_read(
+    txn_manifest* manifest, transaction_spec* spec, bool* eof)
+{
+    int retval;
+    const char* line;
+    size_t size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != manifest);
+    MODEL_ASSERT(NULL != spec);
+    MODEL_ASSERT(NULL != eof);
+
+    /* read the next entry. */
+    retval = txn_manifest_next_line(manifest, &line, &size, eof);
+    if (VCTOOL_STATUS_SUCCESS != retval || *eof)
+    {
+        return retval;
+    }
+
+    /* parse the entry. */
+    if (TXN_MANIFEST_FORMAT_CSV == manifest->format)
+    {
+        retval =
+            transaction_spec_parse_csv(spec, &manifest->header, line, size);
+    }
+    else
+    {
+        retval = transaction_spec_parse_json(spec, line, size);
+    }
+
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr, "%s:%zu: %s.\n", manifest->filename,
+            manifest->line_number, txn_error_message(retval));
+    }
+
+    return retval;
+}
@@ -0,0 +1,105 @@
+/**
+ * \file command/txn/txn_worker.c
+ *
+ * \brief Build and sign a single transaction.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <limits.h>
+
+#include "txn_internal.h"
+
+/* forward decls. */
+static int txn_write_file(txn_batch* batch, txn_job* job);
+
+/**
+ * \brief Worker function; builds and signs a single transaction.
+ *
+ * If the batch has an output directory, the transaction is also written to its
+ * own file there.
+ *
+ * \param context           The txn batch.
+ * \param index             The index of the job to process.
+ */
+void txn_worker(void* context, size_t index)
+{
+    txn_batch* batch = (txn_batch*)context;
+    txn_job* job = &batch->jobs[index];
+
+    /* build and sign the transaction. */
+    job->status =
+        transaction_certificate_create(
+            batch->opts, &job->cert, &job->spec,
+            (const uint8_t*)batch->signer_id, batch->signer_private_key);
+    if (VCTOOL_STATUS_SUCCESS != job->status)
+    {
+        return;
+    }
+
+    job->cert_created = true;
+
+    /* without an output directory, the transactions are written in order. */
+    if (NULL != batch->output_dir)
+    {
+        job->status = txn_write_file(batch, job);
+    }
+}
+
+/**
+ * \brief Write a signed transaction to its own file in the output directory.
+ *
+ * The file is named for the transaction id.
+ *
+ * \param batch             The txn batch.
+ * \param job               The job to write.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static int txn_write_file(txn_batch* batch, txn_job* job)
+{
+    int retval, fd;
+    char filename[PATH_MAX];
+    size_t wrote_size;
+    const uint8_t* id = job->spec.transaction_id;
+
+    /* build the output filename. */
+    int length =
+        snprintf(
+            filename, sizeof(filename),
+            "%s/%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-"
+            "%02x%02x%02x%02x%02x%02x.txn",
+            batch->output_dir, id[0], id[1], id[2], id[3], id[4], id[5],
+            id[6], id[7], id[8], id[9], id[10], id[11], id[12], id[13],
+            id[14], id[15]);
+    if (length < 0 || (size_t)length >= sizeof(filename))
+    {
+        return VCTOOL_ERROR_COMMANDLINE_BAD_PARAMETER;
+    }
+
+    /* a transaction is public, so it is readable by everyone. */
+    retval =
+        file_open(
+            batch->opts->file, &fd, filename, O_CREAT | O_EXCL | O_WRONLY,
+            S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* write the transaction. */
+    retval =
+        file_write(
+            batch->opts->file, fd, job->cert.data, job->cert.size,
+            &wrote_size);
+    if (VCTOOL_STATUS_SUCCESS == retval && wrote_size != job->cert.size)
+    {
+        retval = VCTOOL_ERROR_FILE_IO;
+    }
+
+    file_close(batch->opts->file, fd);
+
+    return retval;
+}
@@ -0,0 +1,70 @@
+/**
+ * \file command/verify/process_verify_cert_command.c
+ *
+ * \brief Process command-line options to build a verify-cert command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/verify_cert.h>
+#include <vctool/command/root.h>
+#include <vctool/commandline.h>
+#include <vctool/status_codes.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Process the verify-cert command.
+ *
+ * \param opts          The command-line option structure.
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int process_verify_cert_command(
+    commandline_opts* opts, int argc, char* argv[])
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* allocate memory for a verify_cert_command structure. */
+    verify_cert_command* verify =
+        (verify_cert_command*)malloc(sizeof(verify_cert_command));
+    if (NULL == verify)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* initialize the structure. */
+    retval = verify_cert_command_init(verify);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto free_verify;
+    }
+
+    /* any remaining arguments are additional input certificates. */
+    verify->input_filenames = argv;
+    verify->input_filename_count = argc > 0 ? (size_t)argc : 0U;
+
+    /* set verify-cert command as the head of opts command. */
+    verify->hdr.next = opts->cmd;
+    opts->cmd = &verify->hdr;
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto done;
+
+free_verify:
+    free(verify);
+
+done:
+    return retval;
+}
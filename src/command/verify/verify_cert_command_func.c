@@ -0,0 +1,133 @@
+/**
+ * \file command/verify/verify_cert_command_func.c
+ *
+ * \brief Entry point for the verify-cert command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <time.h>
+
+#include "verify_internal.h"
+
+/**
+ * \brief Execute the verify-cert command.
+ *
+ * The certificate given with -i and every certificate given as an argument
+ * are verified on a pool of worker threads, using the signer public key
+ * certificates given with -D.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int verify_cert_command_func(commandline_opts* opts)
+{
+    int retval;
+    verify_signer_table signers;
+    verify_cert_batch batch;
+    size_t failed = 0;
+    struct timespec start, end;
+    double elapsed;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* get verify-cert and root command. */
+    verify_cert_command* verify = (verify_cert_command*)opts->cmd;
+    MODEL_ASSERT(NULL != verify);
+    root_command* root = (root_command*)verify->hdr.next;
+    MODEL_ASSERT(NULL != root);
+
+    /* we need at least one certificate. */
+    if (NULL == root->input_filename && 0 == verify->input_filename_count)
+    {
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        fprintf(
+            stderr,
+            "Expecting an input certificate (-i cert) or certificate "
+            "arguments.\n");
+        goto done;
+    }
+
+    /* read every signer certificate once. */
+    retval = verify_signer_table_init(&signers, opts, root);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* allocate a job for each certificate. */
+    memset(&batch, 0, sizeof(batch));
+    batch.opts = opts;
+    batch.signers = &signers;
+    batch.jobs =
+        (verify_cert_job*)calloc(
+            verify->input_filename_count + 1, sizeof(verify_cert_job));
+    if (NULL == batch.jobs)
+    {
+        fprintf(stderr, "Out of memory.\n");
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_signers;
+    }
+
+    /* the -i certificate comes first, followed by the arguments. */
+    if (NULL != root->input_filename)
+    {
+        batch.jobs[batch.job_count++].filename = root->input_filename;
+    }
+
+    for (size_t i = 0; i < verify->input_filename_count; ++i)
+    {
+        batch.jobs[batch.job_count++].filename = verify->input_filenames[i];
+    }
+
+    /* verify every certificate on the worker pool. */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    retval = parallel_for(batch.job_count, &verify_cert_worker, &batch);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_jobs;
+    }
+
+    /* report each certificate in command line order. */
+    for (size_t i = 0; i < batch.job_count; ++i)
+    {
+        if (VCTOOL_STATUS_SUCCESS != batch.jobs[i].status)
+        {
+            fprintf(
+                stderr, "%s: %s.\n", batch.jobs[i].filename,
+                verify_error_message(batch.jobs[i].status));
+            retval = batch.jobs[i].status;
+            ++failed;
+        }
+        else if (root->verbose)
+        {
+            printf("%s: OK.\n", batch.jobs[i].filename);
+        }
+    }
+
+    /* report the verification rate. */
+    elapsed =
+        (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    printf(
+        "Verified %zu certificate(s) with %zu signer(s) in %.3f s "
+        "(%.0f certificates/s); %zu failed.\n",
+        batch.job_count, signers.count, elapsed,
+        (elapsed > 0) ? batch.job_count / elapsed : 0.0, failed);
+
+    /* the last failure is the status of the command. */
+    goto cleanup_jobs;
+
+cleanup_jobs:
+    free(batch.jobs);
+
+cleanup_signers:
+    verify_signer_table_dispose(&signers);
+
+done:
+    return retval;
+}
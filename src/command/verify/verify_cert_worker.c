@@ -0,0 +1,36 @@
+/**
+ * \file command/verify/verify_cert_worker.c
+ *
+ * \brief Read and verify the signature of a single certificate.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "verify_internal.h"
+
+/**
+ * \brief Worker function; reads and verifies the signature of a single
+ * certificate.
+ *
+ * \param context           The verify-cert batch.
+ * \param index             The index of the job to process.
+ */
+void verify_cert_worker(void* context, size_t index)
+{
+    verify_cert_batch* batch = (verify_cert_batch*)context;
+    verify_cert_job* job = &batch->jobs[index];
+    vccrypt_buffer_t cert;
+
+    /* read the certificate. */
+    job->status = verify_read_file(&cert, batch->opts, job->filename);
+    if (VCTOOL_STATUS_SUCCESS != job->status)
+    {
+        return;
+    }
+
+    /* verify the signature with the cached signer public key. */
+    job->status =
+        verify_certificate_signer(batch->signers, cert.data, cert.size);
+
+    dispose((disposable_t*)&cert);
+}
@@ -0,0 +1,64 @@
+/**
+ * \file command/verify/verify_certificate_signer.c
+ *
+ * \brief Verify that a certificate was signed by a known signer.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "verify_internal.h"
+
+/**
+ * \brief Verify that a certificate was signed by a known signer.
+ *
+ * The signer id field of the certificate selects the signer public key. This
+ * is safe to call from a worker thread.
+ *
+ * \param table             The signer table.
+ * \param cert              The certificate to verify.
+ * \param cert_size         The size of the certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_CERTIFICATE_UNKNOWN_SIGNER if the signer is not known.
+ *      - VCTOOL_ERROR_CERTIFICATE_BAD_SIGNATURE if the signature is invalid.
+ *      - a non-zero error code on failure.
+ */
+int verify_certificate_signer(
+    const verify_signer_table* table, const void* cert, size_t cert_size)
+{
+    int retval;
+    const uint8_t* signer_id;
+    size_t signer_id_size;
+    const verify_signer* signer;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != table);
+    MODEL_ASSERT(NULL != cert);
+
+    /* find the signer id. */
+    retval =
+        certificate_find_short_field(
+            &signer_id, &signer_id_size, cert, cert_size,
+            VCCERT_FIELD_TYPE_SIGNER_ID);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+    else if (BLOCK_ID_SIZE != signer_id_size)
+    {
+        return VCTOOL_ERROR_CERTIFICATE_UNKNOWN_SIGNER;
+    }
+
+    /* look up the signer. */
+    signer = verify_signer_table_find(table, signer_id);
+    if (NULL == signer)
+    {
+        return VCTOOL_ERROR_CERTIFICATE_UNKNOWN_SIGNER;
+    }
+
+    /* verify the signature with this signer's public key. */
+    return
+        certificate_verify_signature(
+            table->opts->suite, cert, cert_size, &signer->public_key);
+}
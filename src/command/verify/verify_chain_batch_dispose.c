@@ -0,0 +1,30 @@
+/**
+ * \file command/verify/verify_chain_batch_dispose.c
+ *
+ * \brief Dispose of a verify-chain batch.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "verify_internal.h"
+
+/**
+ * \brief Dispose of a verify-chain batch, freeing its jobs.
+ *
+ * \param batch             The batch to dispose.
+ */
+void verify_chain_batch_dispose(verify_chain_batch* batch)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+
+    /* free the jobs. */
+    for (size_t i = 0; i < batch->job_count; ++i)
+    {
+        free(batch->jobs[i].filename);
+    }
+    free(batch->jobs);
+
+    /* clear the batch. */
+    memset(batch, 0, sizeof(*batch));
+}
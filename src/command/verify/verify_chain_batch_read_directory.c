@@ -0,0 +1,134 @@
+/**
+ * \file command/verify/verify_chain_batch_read_directory.c
+ *
+ * \brief Add a job for each block file in a directory.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "verify_internal.h"
+
+/**
+ * \brief Add a job for each block file in the given directory.
+ *
+ * Hidden files and non-regular files are skipped.
+ *
+ * \param batch             The batch to which these jobs are added.
+ * \param dirname           The block directory to scan.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int verify_chain_batch_read_directory(
+    verify_chain_batch* batch, const char* dirname)
+{
+    int retval, release_retval;
+    void* dir;
+    const char* name;
+    file_stat_st fst;
+    char* path;
+    size_t path_length;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(NULL != dirname);
+
+    /* open the directory. */
+    retval = file_opendir(batch->opts->file, &dir, dirname);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Error opening block directory %s.\n", dirname);
+        goto done;
+    }
+
+    /* iterate through the directory entries. */
+    for (;;)
+    {
+        retval = file_readdir(batch->opts->file, dir, &name);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(stderr, "Error reading directory %s.\n", dirname);
+            goto cleanup_dir;
+        }
+        else if (NULL == name)
+        {
+            break;
+        }
+
+        /* skip hidden files, including . and .. */
+        if ('.' == name[0])
+        {
+            continue;
+        }
+
+        /* build the path for this entry. */
+        path_length =
+            strlen(dirname)
+          + 1 /* / */
+          + strlen(name)
+          + 1;/* asciiz */
+
+        path = (char*)malloc(path_length);
+        if (NULL == path)
+        {
+            retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+            goto cleanup_dir;
+        }
+
+        snprintf(path, path_length, "%s/%s", dirname, name);
+
+        /* only regular files are considered. */
+        if (VCTOOL_STATUS_SUCCESS != file_stat(batch->opts->file, path, &fst)
+         || !S_ISREG(fst.fst_mode))
+        {
+            free(path);
+            continue;
+        }
+
+        /* grow the job array if needed. */
+        if (batch->job_count == batch->job_capacity)
+        {
+            size_t capacity =
+                batch->job_capacity ? 2 * batch->job_capacity : 1024;
+            verify_chain_job* jobs =
+                (verify_chain_job*)realloc(
+                    batch->jobs, capacity * sizeof(verify_chain_job));
+            if (NULL == jobs)
+            {
+                free(path);
+                retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+                goto cleanup_dir;
+            }
+
+            batch->jobs = jobs;
+            batch->job_capacity = capacity;
+        }
+
+        /* the job owns the path. */
+        memset(&batch->jobs[batch->job_count], 0, sizeof(verify_chain_job));
+        batch->jobs[batch->job_count].filename = path;
+        ++batch->job_count;
+    }
+
+    /* it's an error to verify an empty directory. */
+    if (0 == batch->job_count)
+    {
+        fprintf(stderr, "No block files found in %s.\n", dirname);
+        retval = VCTOOL_ERROR_FILE_NO_ENTRY;
+        goto cleanup_dir;
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+
+cleanup_dir:
+    release_retval = file_closedir(batch->opts->file, dir);
+    if (VCTOOL_STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
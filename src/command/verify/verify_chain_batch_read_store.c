@@ -0,0 +1,78 @@
+/**
+ * \file command/verify/verify_chain_batch_read_store.c
+ *
+ * \brief Add a verify-chain job for each block in a block store.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <inttypes.h>
+
+#include "verify_internal.h"
+
+/**
+ * \brief Add a job for each block in the given block store.
+ *
+ * The blocks are read in place from the store, which must stay open until the
+ * batch is disposed. Each job is named for the store and block height.
+ *
+ * \param batch             The batch to which these jobs are added.
+ * \param store             The block store.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int verify_chain_batch_read_store(
+    verify_chain_batch* batch, const block_store* store)
+{
+    size_t name_size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(NULL != store);
+    MODEL_ASSERT(0 == batch->job_count);
+
+    /* it's an error to verify an empty store. */
+    if (0 == store->count)
+    {
+        fprintf(stderr, "No blocks found in %s.\n", store->dirname);
+        return VCTOOL_ERROR_FILE_NO_ENTRY;
+    }
+
+    batch->jobs =
+        (verify_chain_job*)calloc(store->count, sizeof(verify_chain_job));
+    if (NULL == batch->jobs)
+    {
+        return VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    batch->store = store;
+    batch->job_capacity = store->count;
+
+    /* name each job for the store and height, such as blocks@42. */
+    name_size =
+        strlen(store->dirname)
+      + 1  /* @ */
+      + 20 /* height */
+      + 1; /* asciiz */
+
+    for (size_t i = 0; i < store->count; ++i)
+    {
+        verify_chain_job* job = &batch->jobs[i];
+
+        job->filename = (char*)malloc(name_size);
+        if (NULL == job->filename)
+        {
+            return VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        }
+
+        snprintf(
+            job->filename, name_size, "%s@%" PRIu64, store->dirname,
+            store->entries[i].height);
+        job->entry = &store->entries[i];
+        ++batch->job_count;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
@@ -0,0 +1,178 @@
+/**
+ * \file command/verify/verify_chain_command_func.c
+ *
+ * \brief Entry point for the verify-chain command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <inttypes.h>
+#include <time.h>
+
+#include "verify_internal.h"
+
+/**
+ * \brief Execute the verify-chain command.
+ *
+ * Every block in the input block directory or block store is read and its
+ * signature is verified on a pool of worker threads, using the signer public
+ * key certificates given with -D. The previous block linkage is then verified
+ * in a single pass in height order.
+ *
+ * \param opts          The commandline opts for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int verify_chain_command_func(commandline_opts* opts)
+{
+    int retval;
+    verify_signer_table signers;
+    verify_chain_batch batch;
+    block_store store;
+    bool store_open = false;
+    block_info* blocks;
+    size_t failed = 0;
+    size_t index = 0;
+    struct timespec start, end;
+    double elapsed;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+
+    /* get verify-chain and root command. */
+    verify_chain_command* verify = (verify_chain_command*)opts->cmd;
+    MODEL_ASSERT(NULL != verify);
+    root_command* root = (root_command*)verify->hdr.next;
+    MODEL_ASSERT(NULL != root);
+
+    /* we need a block directory. */
+    if (NULL == root->input_filename)
+    {
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        fprintf(stderr, "Expecting a block directory (-i blocks).\n");
+        goto done;
+    }
+
+    /* read every signer certificate once. */
+    retval = verify_signer_table_init(&signers, opts, root);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* add a job for each block, from a block store or a block directory. */
+    memset(&batch, 0, sizeof(batch));
+    batch.opts = opts;
+    batch.signers = &signers;
+    if (block_store_exists(opts->file, root->input_filename))
+    {
+        retval =
+            block_store_open(
+                &store, opts->file, root->input_filename, false);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            fprintf(
+                stderr, "Error opening block store %s: %s.\n",
+                root->input_filename, verify_error_message(retval));
+            goto cleanup_batch;
+        }
+
+        store_open = true;
+        retval = verify_chain_batch_read_store(&batch, &store);
+    }
+    else
+    {
+        retval =
+            verify_chain_batch_read_directory(&batch, root->input_filename);
+    }
+
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_batch;
+    }
+
+    /* verify every block signature on the worker pool. */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    retval = parallel_for(batch.job_count, &verify_chain_worker, &batch);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_batch;
+    }
+
+    /* report every block that failed. */
+    for (size_t i = 0; i < batch.job_count; ++i)
+    {
+        if (VCTOOL_STATUS_SUCCESS != batch.jobs[i].status)
+        {
+            fprintf(
+                stderr, "%s: %s.\n", batch.jobs[i].filename,
+                verify_error_message(batch.jobs[i].status));
+            retval = batch.jobs[i].status;
+            ++failed;
+        }
+    }
+
+    if (failed > 0)
+    {
+        fprintf(
+            stderr, "%zu of %zu blocks failed verification.\n", failed,
+            batch.job_count);
+        goto cleanup_batch;
+    }
+
+    /* gather the block info for the linkage pass. */
+    blocks = (block_info*)malloc(batch.job_count * sizeof(block_info));
+    if (NULL == blocks)
+    {
+        fprintf(stderr, "Out of memory.\n");
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_batch;
+    }
+
+    for (size_t i = 0; i < batch.job_count; ++i)
+    {
+        blocks[i] = batch.jobs[i].info;
+    }
+
+    /* verify the linkage in a single pass. */
+    retval = block_chain_verify_linkage(blocks, batch.job_count, &index);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        fprintf(
+            stderr, "Block at height %" PRIu64 ": %s.\n", blocks[index].height,
+            verify_error_message(retval));
+        goto cleanup_blocks;
+    }
+
+    /* report the verification rate. */
+    elapsed =
+        (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    printf(
+        "Verified %zu blocks (heights %" PRIu64 "..%" PRIu64 ") in %.3f s "
+        "(%.0f blocks/s).\n",
+        batch.job_count, blocks[0].height,
+        blocks[batch.job_count - 1].height, elapsed,
+        (elapsed > 0) ? batch.job_count / elapsed : 0.0);
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_blocks;
+
+cleanup_blocks:
+    free(blocks);
+
+cleanup_batch:
+    verify_chain_batch_dispose(&batch);
+    if (store_open)
+    {
+        block_store_close(&store);
+    }
+
+    verify_signer_table_dispose(&signers);
+
+done:
+    return retval;
+}
@@ -0,0 +1,52 @@
+/**
+ * \file command/verify/verify_chain_command_init.c
+ *
+ * \brief Initialize a verify-chain command structure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/command/verify_chain.h>
+#include <vctool/command/root.h>
+#include <vctool/status_codes.h>
+#include <vpr/parameters.h>
+
+/* forward decls. */
+static void verify_chain_command_dispose(void* disp);
+
+/**
+ * \brief Initialize a verify-chain command structure.
+ *
+ * \param verify        The verify-chain command structure to initialize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int verify_chain_command_init(verify_chain_command* verify)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != verify);
+
+    /* clear verify-chain command structure. */
+    memset(verify, 0, sizeof(verify_chain_command));
+
+    /* set disposer, func, etc. */
+    verify->hdr.hdr.dispose = &verify_chain_command_dispose;
+    verify->hdr.func = &verify_chain_command_func;
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Dispose of a verify_chain_command structure.
+ *
+ * \param disp          The verify_chain_command structure to dispose.
+ */
+static void verify_chain_command_dispose(void* UNUSED(disp))
+{
+    /* do nothing. */
+}
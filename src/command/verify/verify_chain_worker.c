@@ -0,0 +1,66 @@
+/**
+ * \file command/verify/verify_chain_worker.c
+ *
+ * \brief Read and verify the signature of a single block.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "verify_internal.h"
+
+/**
+ * \brief Worker function; reads and verifies the signature of a single block.
+ *
+ * Only the block info is kept, so that the block itself can be freed before
+ * the next block is read. A block in a block store is not copied.
+ *
+ * \param context           The verify-chain batch.
+ * \param index             The index of the job to process.
+ */
+void verify_chain_worker(void* context, size_t index)
+{
+    verify_chain_batch* batch = (verify_chain_batch*)context;
+    verify_chain_job* job = &batch->jobs[index];
+    vccrypt_buffer_t block;
+    const uint8_t* data;
+    size_t size;
+
+    /* a block in a store is read in place. */
+    if (NULL != job->entry)
+    {
+        job->status = block_store_read(&data, batch->store, job->entry);
+        if (VCTOOL_STATUS_SUCCESS != job->status)
+        {
+            return;
+        }
+
+        size = job->entry->size;
+    }
+    else
+    {
+        job->status = verify_read_file(&block, batch->opts, job->filename);
+        if (VCTOOL_STATUS_SUCCESS != job->status)
+        {
+            return;
+        }
+
+        data = (const uint8_t*)block.data;
+        size = block.size;
+    }
+
+    /* read the fields needed for the linkage pass. */
+    job->status = block_info_read(&job->info, data, size);
+    if (VCTOOL_STATUS_SUCCESS != job->status)
+    {
+        goto cleanup_block;
+    }
+
+    /* verify the block signature. */
+    job->status = verify_certificate_signer(batch->signers, data, size);
+
+cleanup_block:
+    if (NULL == job->entry)
+    {
+        dispose((disposable_t*)&block);
+    }
+}
@@ -0,0 +1,55 @@
+/**
+ * \file command/verify/verify_error_message.c
+ *
+ * \brief Describe a verification failure.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "verify_internal.h"
+
+/**
+ * \brief Get a message describing a verification failure.
+ *
+ * \param status            The status code of the failure.
+ *
+ * \returns a description of the failure.
+ */
+const char* verify_error_message(int status)
+{
+    switch (status)
+    {
+        case VCTOOL_ERROR_CERTIFICATE_BAD_SIGNATURE:
+            return "bad signature";
+
+        case VCTOOL_ERROR_CERTIFICATE_UNKNOWN_SIGNER:
+            return "unknown signer";
+
+        case VCTOOL_ERROR_CERTIFICATE_FIELD_NOT_FOUND:
+            return "missing signature";
+
+        case VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED:
+            return "malformed certificate";
+
+        case VCTOOL_ERROR_BLOCK_MISSING_FIELD:
+            return "missing block field";
+
+        case VCTOOL_ERROR_BLOCK_INVALID_FIELD_SIZE:
+            return "invalid block field size";
+
+        case VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT:
+            return "duplicate block height";
+
+        case VCTOOL_ERROR_BLOCK_HEIGHT_GAP:
+            return "previous block height is missing";
+
+        case VCTOOL_ERROR_BLOCK_PREVIOUS_MISMATCH:
+            return "previous block id does not match";
+
+        case VCTOOL_ERROR_BLOCK_STORE_BAD_INDEX:
+            return "bad block store index";
+
+        default:
+            return "error reading file";
+    }
+}
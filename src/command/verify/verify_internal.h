@@ -0,0 +1,258 @@
+/**
+ * \file command/verify/verify_internal.h
+ *
+ * \brief Internal header for the verify commands.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <cbmc/model_assert.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vccert/fields.h>
+#include <vctool/block.h>
+#include <vctool/block_store.h>
+#include <vctool/certificate.h>
+#include <vctool/command/root.h>
+#include <vctool/command/verify_cert.h>
+#include <vctool/command/verify_chain.h>
+#include <vctool/parallel.h>
+#include <vctool/status_codes.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief A signer, read from a public key certificate. */
+typedef struct verify_signer verify_signer;
+
+struct verify_signer
+{
+    uint8_t id[BLOCK_ID_SIZE];
+    const char* filename;
+    vccrypt_buffer_t public_key;
+    bool key_read;
+    int status;
+};
+
+/**
+ * \brief The signers given on the command line, sorted by id.
+ *
+ * Each signer public key certificate is read once, no matter how many
+ * certificates it signed.
+ */
+typedef struct verify_signer_table verify_signer_table;
+
+struct verify_signer_table
+{
+    commandline_opts* opts;
+    verify_signer* signers;
+    size_t count;
+};
+
+/**
+ * \brief A single block to verify, read from its own file, or from a block
+ * store if \ref entry is set.
+ */
+typedef struct verify_chain_job verify_chain_job;
+
+struct verify_chain_job
+{
+    char* filename;
+    const block_store_entry* entry;
+    block_info info;
+    int status;
+};
+
+/** \brief The shared state for verifying a chain of blocks. */
+typedef struct verify_chain_batch verify_chain_batch;
+
+struct verify_chain_batch
+{
+    commandline_opts* opts;
+    const verify_signer_table* signers;
+    const block_store* store;
+    verify_chain_job* jobs;
+    size_t job_count;
+    size_t job_capacity;
+};
+
+/** \brief A single certificate to verify. */
+typedef struct verify_cert_job verify_cert_job;
+
+struct verify_cert_job
+{
+    const char* filename;
+    int status;
+};
+
+/** \brief The shared state for verifying a set of certificates. */
+typedef struct verify_cert_batch verify_cert_batch;
+
+struct verify_cert_batch
+{
+    commandline_opts* opts;
+    const verify_signer_table* signers;
+    verify_cert_job* jobs;
+    size_t job_count;
+};
+
+/**
+ * \brief Read the contents of a file into a new buffer.
+ *
+ * This is safe to call from a worker thread.
+ *
+ * \param buffer            Buffer to be initialized with the file contents.
+ *                          Caller owns this buffer on success and must dispose
+ *                          it.
+ * \param opts              The command-line options to use.
+ * \param filename          The name of the file to read.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int verify_read_file(
+    vccrypt_buffer_t* buffer, commandline_opts* opts, const char* filename);
+
+/**
+ * \brief Initialize the signer table from the public key certificates named by
+ * the root command dictionary values.
+ *
+ * Each distinct certificate file is read once, and the files are read
+ * concurrently.
+ *
+ * \param table             The signer table to initialize.
+ * \param opts              The command-line options to use.
+ * \param root              The root command config.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int verify_signer_table_init(
+    verify_signer_table* table, commandline_opts* opts,
+    const root_command* root);
+
+/**
+ * \brief Dispose of a signer table, freeing every signer public key.
+ *
+ * \param table             The signer table to dispose.
+ */
+void verify_signer_table_dispose(verify_signer_table* table);
+
+/**
+ * \brief Worker function; reads a single signer public key certificate.
+ *
+ * \param context           The signer table.
+ * \param index             The index of the signer to read.
+ */
+void verify_signer_worker(void* context, size_t index);
+
+/**
+ * \brief Find a signer by id.
+ *
+ * \param table             The signer table to search.
+ * \param id                The signer id.
+ *
+ * \returns the signer, or NULL if this signer is not known.
+ */
+const verify_signer* verify_signer_table_find(
+    const verify_signer_table* table, const uint8_t* id);
+
+/**
+ * \brief Verify that a certificate was signed by a known signer.
+ *
+ * The signer id field of the certificate selects the signer public key. This
+ * is safe to call from a worker thread.
+ *
+ * \param table             The signer table.
+ * \param cert              The certificate to verify.
+ * \param cert_size         The size of the certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_CERTIFICATE_UNKNOWN_SIGNER if the signer is not known.
+ *      - VCTOOL_ERROR_CERTIFICATE_BAD_SIGNATURE if the signature is invalid.
+ *      - a non-zero error code on failure.
+ */
+int verify_certificate_signer(
+    const verify_signer_table* table, const void* cert, size_t cert_size);
+
+/**
+ * \brief Get a message describing a verification failure.
+ *
+ * \param status            The status code of the failure.
+ *
+ * \returns a description of the failure.
+ */
+const char* verify_error_message(int status);
+
+/**
+ * \brief Add a job for each block file in the given directory.
+ *
+ * Hidden files and non-regular files are skipped.
+ *
+ * \param batch             The batch to which these jobs are added.
+ * \param dirname           The block directory to scan.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int verify_chain_batch_read_directory(
+    verify_chain_batch* batch, const char* dirname);
+
+/**
+ * \brief Add a job for each block in the given block store.
+ *
+ * The blocks are read in place from the store, which must stay open until the
+ * batch is disposed. Each job is named for the store and block height.
+ *
+ * \param batch             The batch to which these jobs are added.
+ * \param store             The block store.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int verify_chain_batch_read_store(
+    verify_chain_batch* batch, const block_store* store);
+
+/**
+ * \brief Dispose of a verify-chain batch, freeing its jobs.
+ *
+ * \param batch             The batch to dispose.
+ */
+void verify_chain_batch_dispose(verify_chain_batch* batch);
+
+/**
+ * \brief Worker function; reads and verifies the signature of a single block.
+ *
+ * Only the block info is kept, so that the block itself can be freed before
+ * the next block is read. A block in a block store is not copied.
+ *
+ * \param context           The verify-chain batch.
+ * \param index             The index of the job to process.
+ */
+void verify_chain_worker(void* context, size_t index);
+
+/**
+ * \brief Worker function; reads and verifies the signature of a single
+ * certificate.
+ *
+ * \param context           The verify-cert batch.
+ * \param index             The index of the job to process.
+ */
+void verify_cert_worker(void* context, size_t index);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,94 @@
+/**
+ * \file command/verify/verify_read_file.c
+ *
+ * \brief Read the contents of a file into a new buffer.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "verify_internal.h"
+
+/**
+ * \brief Read the contents of a file into a new buffer.
+ *
+ * This is safe to call from a worker thread.
+ *
+ * \param buffer            Buffer to be initialized with the file contents.
+ *                          Caller owns this buffer on success and must dispose
+ *                          it.
+ * \param opts              The command-line options to use.
+ * \param filename          The name of the file to read.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int verify_read_file(
+    vccrypt_buffer_t* buffer, commandline_opts* opts, const char* filename)
+{
+    int retval, release_retval;
+    file_stat_st fst;
+    size_t read_bytes;
+    int fd;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != buffer);
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+    MODEL_ASSERT(NULL != filename);
+
+    /* get the size of the file. */
+    retval = file_stat(opts->file, filename, &fst);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* create a buffer large enough for the file. */
+    retval =
+        vccrypt_buffer_init(buffer, opts->suite->alloc_opts, fst.fst_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* open the file. */
+    retval = file_open(opts->file, &fd, filename, O_RDONLY, 0);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_buffer;
+    }
+
+    /* read the contents into the buffer. */
+    retval = file_read(opts->file, fd, buffer->data, buffer->size, &read_bytes);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_fd;
+    }
+    else if (read_bytes != buffer->size)
+    {
+        retval = VCTOOL_ERROR_FILE_IO;
+        goto cleanup_fd;
+    }
+
+    /* success; the caller owns the buffer. */
+    retval = file_close(opts->file, fd);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_buffer;
+    }
+
+    goto done;
+
+cleanup_fd:
+    release_retval = file_close(opts->file, fd);
+    if (VCTOOL_STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_buffer:
+    dispose((disposable_t*)buffer);
+
+done:
+    return retval;
+}
@@ -0,0 +1,33 @@
+/**
+ * \file command/verify/verify_signer_table_dispose.c
+ *
+ * \brief Dispose of a signer table.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "verify_internal.h"
+
+/**
+ * \brief Dispose of a signer table, freeing every signer public key.
+ *
+ * \param table             The signer table to dispose.
+ */
+void verify_signer_table_dispose(verify_signer_table* table)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != table);
+
+    /* a public key is only initialized if it was successfully read. */
+    for (size_t i = 0; i < table->count; ++i)
+    {
+        if (table->signers[i].key_read)
+        {
+            dispose((disposable_t*)&table->signers[i].public_key);
+        }
+    }
+    free(table->signers);
+
+    /* clear the table. */
+    memset(table, 0, sizeof(*table));
+}
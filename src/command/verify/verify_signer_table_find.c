@@ -0,0 +1,50 @@
+/**
+ * \file command/verify/verify_signer_table_find.c
+ *
+ * \brief Find a signer by id.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "verify_internal.h"
+
+/**
+ * \brief Find a signer by id.
+ *
+ * \param table             The signer table to search.
+ * \param id                The signer id.
+ *
+ * \returns the signer, or NULL if this signer is not known.
+ */
+const verify_signer* verify_signer_table_find(
+    const verify_signer_table* table, const uint8_t* id)
+{
+    size_t low = 0;
+    size_t high = table->count;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != table);
+    MODEL_ASSERT(NULL != id);
+
+    /* the signers are sorted by id. */
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        int cmp = memcmp(table->signers[mid].id, id, BLOCK_ID_SIZE);
+
+        if (cmp < 0)
+        {
+            low = mid + 1;
+        }
+        else if (cmp > 0)
+        {
+            high = mid;
+        }
+        else
+        {
+            return &table->signers[mid];
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,176 @@
+/**
+ * \file command/verify/verify_signer_table_init.c
+ *
+ * \brief Read the signer public key certificates named on the command line.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "verify_internal.h"
+
+RCPR_IMPORT_rbtree;
+
+/* forward decls. */
+static int verify_filename_compare(const void* lhs, const void* rhs);
+static int verify_signer_compare(const void* lhs, const void* rhs);
+
+/**
+ * \brief Initialize the signer table from the public key certificates named by
+ * the root command dictionary values.
+ *
+ * Each distinct certificate file is read once, and the files are read
+ * concurrently.
+ *
+ * \param table             The signer table to initialize.
+ * \param opts              The command-line options to use.
+ * \param root              The root command config.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int verify_signer_table_init(
+    verify_signer_table* table, commandline_opts* opts,
+    const root_command* root)
+{
+    int retval;
+    rbtree_node* kvp_nil;
+    rbtree_node* kvp_x;
+    size_t kvp_count;
+    const char** filenames;
+    size_t i;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != table);
+    MODEL_ASSERT(PROP_VALID_COMMANDLINE_OPTS(opts));
+    MODEL_ASSERT(NULL != root);
+
+    /* clear the table. */
+    memset(table, 0, sizeof(*table));
+    table->opts = opts;
+
+    /* a certificate can't be verified without a signer. */
+    kvp_count = rbtree_count((rbtree*)root->dict);
+    if (0 == kvp_count)
+    {
+        fprintf(
+            stderr, "Expecting at least one signer (-D name=signer.pub).\n");
+        retval = VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT;
+        goto done;
+    }
+
+    /* allocate memory for the filenames. */
+    filenames = (const char**)malloc(kvp_count * sizeof(*filenames));
+    if (NULL == filenames)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* collect every certificate filename. */
+    kvp_nil = rbtree_nil_node((rbtree*)root->dict);
+    kvp_x =
+        rbtree_minimum_node(
+            (rbtree*)root->dict, rbtree_root_node((rbtree*)root->dict));
+    for (
+        i = 0;
+        kvp_nil != kvp_x && i < kvp_count;
+        kvp_x = rbtree_successor_node((rbtree*)root->dict, kvp_x), ++i)
+    {
+        filenames[i] =
+            ((const root_dict_kvp*)rbtree_node_value(
+                (rbtree*)root->dict, kvp_x))->value;
+    }
+
+    /* group the filenames, so that each file is read once. */
+    qsort(filenames, kvp_count, sizeof(*filenames), &verify_filename_compare);
+
+    /* allocate memory for the signers. */
+    table->signers = (verify_signer*)calloc(kvp_count, sizeof(verify_signer));
+    if (NULL == table->signers)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_filenames;
+    }
+
+    /* create one signer for each distinct filename. */
+    for (i = 0; i < kvp_count; ++i)
+    {
+        if (0 == i || strcmp(filenames[i - 1], filenames[i]))
+        {
+            table->signers[table->count].filename = filenames[i];
+            ++table->count;
+        }
+    }
+
+    /* read the signer certificates on the worker pool. */
+    retval = parallel_for(table->count, &verify_signer_worker, table);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_table;
+    }
+
+    /* fail if any signer could not be read. */
+    for (i = 0; i < table->count; ++i)
+    {
+        if (VCTOOL_STATUS_SUCCESS != table->signers[i].status)
+        {
+            fprintf(
+                stderr, "Error reading signer %s.\n",
+                table->signers[i].filename);
+            retval = table->signers[i].status;
+        }
+    }
+
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_table;
+    }
+
+    /* sort the signers by id, so they can be found with a binary search. */
+    qsort(
+        table->signers, table->count, sizeof(verify_signer),
+        &verify_signer_compare);
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_filenames;
+
+cleanup_table:
+    verify_signer_table_dispose(table);
+
+cleanup_filenames:
+    free(filenames);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Compare two filenames.
+ *
+ * \param lhs               Pointer to the left-hand filename.
+ * \param rhs               Pointer to the right-hand filename.
+ *
+ * \returns the string comparison of the two filenames.
+ */
+static int verify_filename_compare(const void* lhs, const void* rhs)
+{
+    return strcmp(*(const char* const*)lhs, *(const char* const*)rhs);
+}
+
+/**
+ * \brief Compare two signers by id.
+ *
+ * \param lhs               The left-hand signer.
+ * \param rhs               The right-hand signer.
+ *
+ * \returns the comparison of the two signer ids.
+ */
+static int verify_signer_compare(const void* lhs, const void* rhs)
+{
+    return
+        memcmp(
+            ((const verify_signer*)lhs)->id, ((const verify_signer*)rhs)->id,
+            BLOCK_ID_SIZE);
+}
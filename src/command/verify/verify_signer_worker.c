@@ -0,0 +1,79 @@
+/**
+ * \file command/verify/verify_signer_worker.c
+ *
+ * \brief Read a single signer public key certificate.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "verify_internal.h"
+
+/**
+ * \brief Worker function; reads a single signer public key certificate.
+ *
+ * \param context           The signer table.
+ * \param index             The index of the signer to read.
+ */
+void verify_signer_worker(void* context, size_t index)
+{
+    verify_signer_table* table = (verify_signer_table*)context;
+    verify_signer* signer = &table->signers[index];
+    vccrypt_buffer_t cert;
+    const uint8_t* value;
+    size_t value_size;
+
+    /* read the public key certificate. */
+    signer->status = verify_read_file(&cert, table->opts, signer->filename);
+    if (VCTOOL_STATUS_SUCCESS != signer->status)
+    {
+        return;
+    }
+
+    /* the signer id is the artifact id of the certificate. */
+    signer->status =
+        certificate_find_short_field(
+            &value, &value_size, cert.data, cert.size,
+            VCCERT_FIELD_TYPE_ARTIFACT_ID);
+    if (VCTOOL_STATUS_SUCCESS != signer->status)
+    {
+        goto cleanup_cert;
+    }
+    else if (sizeof(signer->id) != value_size)
+    {
+        signer->status = VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED;
+        goto cleanup_cert;
+    }
+
+    memcpy(signer->id, value, value_size);
+
+    /* find the public signing key. */
+    signer->status =
+        certificate_find_short_field(
+            &value, &value_size, cert.data, cert.size,
+            VCCERT_FIELD_TYPE_PUBLIC_SIGNING_KEY);
+    if (VCTOOL_STATUS_SUCCESS != signer->status)
+    {
+        goto cleanup_cert;
+    }
+    else if (table->opts->suite->sign_opts.public_key_size != value_size)
+    {
+        signer->status = VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED;
+        goto cleanup_cert;
+    }
+
+    /* copy the public signing key. */
+    signer->status =
+        vccrypt_suite_buffer_init_for_signature_public_key(
+            table->opts->suite, &signer->public_key);
+    if (VCCRYPT_STATUS_SUCCESS != signer->status)
+    {
+        goto cleanup_cert;
+    }
+
+    memcpy(signer->public_key.data, value, value_size);
+    signer->key_read = true;
+    signer->status = VCTOOL_STATUS_SUCCESS;
+
+cleanup_cert:
+    dispose((disposable_t*)&cert);
+}
@@ -3,7 +3,7 @@
  *
  * \brief Parse the commandline, creating an options structure.
  *
- * \copyright 2020-2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2020-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include <cbmc/model_assert.h>
@@ -75,7 +75,7 @@ int commandline_opts_init(
     opts->cmd = (command*)root;
 
     /* read through command-line options. */
-    while ((ch = getopt(argc, argv, "?D:NR:hk:o:i:E:P:v")) != -1)
+    while ((ch = getopt(argc, argv, "?D:F:NR:hk:o:i:E:P:v")) != -1)
     {
         switch (ch)
         {
@@ -122,14 +122,25 @@ int commandline_opts_init(
                 root->output_filename = strdup(optarg);
                 break;
 
-            case 'E':
-                if (NULL != root->endorse_config_filename)
+            case 'F':
+                if (NULL != root->output_format)
                 {
-                    fprintf(stderr, "duplicate option -E %s\n", optarg);
+                    fprintf(stderr, "duplicate option -F %s\n", optarg);
                     retval = VCTOOL_ERROR_COMMANDLINE_DUPLICATE_OPTION;
                     goto dispose_opts;
                 }
-                root->endorse_config_filename = strdup(optarg);
+                root->output_format = strdup(optarg);
+                break;
+
+            case 'E':
+                if (VCTOOL_STATUS_SUCCESS !=
+                        root_endorse_config_add(root, optarg))
+                {
+                    fprintf(
+                        stderr, "Could not add endorse config %s.\n", optarg);
+                    retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+                    goto dispose_opts;
+                }
                 break;
 
             case 'R':
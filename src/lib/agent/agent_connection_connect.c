@@ -0,0 +1,101 @@
+/**
+ * \file agent/agent_connection_connect.c
+ *
+ * \brief Connect to an agent listening on a Unix socket.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vctool/status_codes.h>
+
+#include "agent_internal.h"
+
+/**
+ * \brief Connect to an agent listening on the given Unix socket, and perform
+ * the vcblockchain handshake with it.
+ *
+ * The agent must prove that it holds the private key matching the peer public
+ * key, and must identify itself with the peer id.
+ *
+ * \param conn              The connection to initialize.
+ * \param alloc             The allocator to use for this connection.
+ * \param suite             The crypto suite to use for this connection.
+ * \param path              The path of the agent socket.
+ * \param keys              The client keys and the agent public key.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_CONNECT_FAILED if the agent can't be reached.
+ *      - VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED if the handshake fails.
+ *      - a non-zero error code on failure.
+ */
+int agent_connection_connect(
+    agent_connection* conn, RCPR_SYM(allocator)* alloc,
+    vccrypt_suite_options_t* suite, const char* path, const agent_keys* keys)
+{
+    int retval, fd;
+    struct sockaddr_un addr;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(NULL != alloc);
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != path);
+    MODEL_ASSERT(NULL != keys);
+
+    /* the path must fit in the socket address. */
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        retval = VCTOOL_ERROR_AGENT_CONNECT_FAILED;
+        goto done;
+    }
+
+    strcpy(addr.sun_path, path);
+
+    /* create the socket. */
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        retval = VCTOOL_ERROR_AGENT_CONNECT_FAILED;
+        goto done;
+    }
+
+    /* connect to the agent. */
+    if (0 != connect(fd, (struct sockaddr*)&addr, sizeof(addr)))
+    {
+        retval = VCTOOL_ERROR_AGENT_CONNECT_FAILED;
+        goto cleanup_fd;
+    }
+
+    /* on success, the connection owns the socket. */
+    retval = agent_connection_init(conn, alloc, suite, fd);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_fd;
+    }
+
+    /* authenticate with the agent. */
+    retval = agent_connection_handshake(conn, keys);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        agent_connection_dispose(conn);
+        goto done;
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto done;
+
+cleanup_fd:
+    close(fd);
+
+done:
+    return retval;
+}
@@ -0,0 +1,39 @@
+/**
+ * \file agent/agent_connection_dispose.c
+ *
+ * \brief Dispose of an agent connection.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/agent.h>
+
+RCPR_IMPORT_psock;
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Dispose of a connection, closing its socket.
+ *
+ * \param conn              The connection to dispose.
+ */
+void agent_connection_dispose(agent_connection* conn)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+
+    /* the shared secret only exists once the handshake succeeds. */
+    if (conn->authenticated)
+    {
+        dispose((disposable_t*)&conn->shared_secret);
+    }
+
+    /* releasing the psock closes the socket. */
+    if (NULL != conn->sock)
+    {
+        resource_release(psock_resource_handle(conn->sock));
+    }
+
+    memset(conn, 0, sizeof(*conn));
+}
@@ -0,0 +1,164 @@
+/**
+ * \file agent/agent_connection_handshake.c
+ *
+ * \brief Perform the client side of the vcblockchain handshake.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vccrypt/compare.h>
+#include <vctool/status_codes.h>
+
+#include "agent_internal.h"
+
+/**
+ * \brief Perform the client side of the vcblockchain handshake.
+ *
+ * The client sends its id and a fresh key nonce and challenge nonce. The agent
+ * answers with its id, its own nonces, and a MAC over them keyed with the
+ * shared secret, which proves that it holds the private key matching the peer
+ * public key. The client then proves that it holds the shared secret by
+ * answering the agent's challenge.
+ *
+ * On success, the connection holds the shared secret and the initialization
+ * vectors for the authenticated requests and responses that follow.
+ *
+ * \param conn              The unauthenticated connection.
+ * \param keys              The client keys and the agent public key.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED if the agent rejects the
+ *        handshake or is not the expected agent.
+ *      - a non-zero error code on failure.
+ */
+int agent_connection_handshake(agent_connection* conn, const agent_keys* keys)
+{
+    int retval;
+    vccrypt_prng_context_t prng;
+    vccrypt_buffer_t client_key_nonce;
+    vccrypt_buffer_t client_challenge_nonce;
+    vccrypt_buffer_t server_challenge_nonce;
+    uint32_t offset, status;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(NULL != conn->sock);
+    MODEL_ASSERT(!conn->authenticated);
+    MODEL_ASSERT(NULL != keys);
+
+    /* create the client nonce buffers. */
+    retval =
+        vccrypt_suite_buffer_init_for_cipher_key_agreement_nonce(
+            conn->suite, &client_key_nonce);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    retval =
+        vccrypt_suite_buffer_init_for_cipher_key_agreement_nonce(
+            conn->suite, &client_challenge_nonce);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_client_key_nonce;
+    }
+
+    /* fill the nonces with random bytes. */
+    retval = vccrypt_suite_prng_init(conn->suite, &prng);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_client_challenge_nonce;
+    }
+
+    retval = vccrypt_prng_read(&prng, &client_key_nonce, client_key_nonce.size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_prng;
+    }
+
+    retval =
+        vccrypt_prng_read(
+            &prng, &client_challenge_nonce, client_challenge_nonce.size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_prng;
+    }
+
+    /* send the handshake request. */
+    retval =
+        vcblockchain_protocol_sendreq_handshake_request(
+            conn->sock, conn->suite, &keys->local_id, &client_key_nonce,
+            &client_challenge_nonce);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_prng;
+    }
+
+    /* receive the response, which also computes the shared secret. */
+    retval =
+        vcblockchain_protocol_recvresp_handshake_request(
+            conn->sock, conn->suite, &conn->peer_id,
+            &keys->local_private_key, &keys->peer_public_key,
+            &client_key_nonce, &client_challenge_nonce,
+            &server_challenge_nonce, &conn->shared_secret, &offset, &status);
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED;
+        goto cleanup_prng;
+    }
+
+    /* the agent must accept the handshake, and must be the expected agent. */
+    if (AGENT_STATUS_SUCCESS != status
+     || crypto_memcmp(&conn->peer_id, &keys->peer_id, sizeof(conn->peer_id)))
+    {
+        retval = VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED;
+        goto cleanup_shared_secret;
+    }
+
+    /* answer the agent's challenge. This sets both initialization vectors. */
+    retval =
+        vcblockchain_protocol_sendreq_handshake_ack(
+            conn->sock, conn->suite, &conn->client_iv, &conn->server_iv,
+            &conn->shared_secret, &server_challenge_nonce);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_shared_secret;
+    }
+
+    /* the agent must accept the answer. */
+    retval =
+        vcblockchain_protocol_recvresp_handshake_ack(
+            conn->sock, conn->suite, &conn->server_iv, &conn->shared_secret,
+            &offset, &status);
+    if (STATUS_SUCCESS != retval || AGENT_STATUS_SUCCESS != status)
+    {
+        retval = VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED;
+        goto cleanup_shared_secret;
+    }
+
+    /* success. The connection owns the shared secret. */
+    conn->authenticated = true;
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_server_challenge_nonce;
+
+cleanup_shared_secret:
+    dispose((disposable_t*)&conn->shared_secret);
+
+cleanup_server_challenge_nonce:
+    dispose((disposable_t*)&server_challenge_nonce);
+
+cleanup_prng:
+    dispose((disposable_t*)&prng);
+
+cleanup_client_challenge_nonce:
+    dispose((disposable_t*)&client_challenge_nonce);
+
+cleanup_client_key_nonce:
+    dispose((disposable_t*)&client_key_nonce);
+
+done:
+    return retval;
+}
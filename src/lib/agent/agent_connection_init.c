@@ -0,0 +1,53 @@
+/**
+ * \file agent/agent_connection_init.c
+ *
+ * \brief Initialize an agent connection over a connected socket.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/agent.h>
+#include <vctool/status_codes.h>
+
+RCPR_IMPORT_psock;
+
+/**
+ * \brief Initialize an unauthenticated connection over the given socket.
+ *
+ * \param conn              The connection to initialize.
+ * \param alloc             The allocator to use for this connection.
+ * \param suite             The crypto suite to use for this connection.
+ * \param fd                The connected socket; the connection owns this
+ *                          socket on success.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int agent_connection_init(
+    agent_connection* conn, RCPR_SYM(allocator)* alloc,
+    vccrypt_suite_options_t* suite, int fd)
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(NULL != alloc);
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(fd >= 0);
+
+    memset(conn, 0, sizeof(*conn));
+    conn->alloc = alloc;
+    conn->suite = suite;
+
+    /* wrap the socket; the psock owns the descriptor on success. */
+    retval = psock_create_from_descriptor(&conn->sock, alloc, fd);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
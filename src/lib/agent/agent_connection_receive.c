@@ -0,0 +1,79 @@
+/**
+ * \file agent/agent_connection_receive.c
+ *
+ * \brief Receive the next response on an agent connection.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/status_codes.h>
+
+#include "agent_internal.h"
+
+/**
+ * \brief Receive the next response from the agent.
+ *
+ * The response is read and authenticated with the agent's initialization
+ * vector and the shared secret, and only its header is decoded here. The
+ * caller decodes the rest with the vcblockchain_protocol_decode_resp_*
+ * function for the request id.
+ *
+ * \param conn              The authenticated client connection.
+ * \param response          Buffer to be initialized with the response. On
+ *                          success, the caller owns this buffer and must
+ *                          dispose it.
+ * \param request_id        Pointer to receive the request id.
+ * \param offset            Pointer to receive the request offset.
+ * \param status            Pointer to receive the response status.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_PROTOCOL if the response is malformed.
+ *      - VCTOOL_ERROR_AGENT_IO if the connection fails.
+ */
+int agent_connection_receive(
+    agent_connection* conn, vccrypt_buffer_t* response, uint32_t* request_id,
+    uint32_t* offset, uint32_t* status)
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(conn->authenticated);
+    MODEL_ASSERT(NULL != response);
+    MODEL_ASSERT(NULL != request_id);
+    MODEL_ASSERT(NULL != offset);
+    MODEL_ASSERT(NULL != status);
+
+    /* read and authenticate the next response. */
+    retval =
+        vcblockchain_protocol_recvresp(
+            conn->sock, conn->alloc, conn->suite, &conn->server_iv,
+            &conn->shared_secret, response);
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_AGENT_IO;
+        goto done;
+    }
+
+    /* decode the response header. */
+    retval =
+        vcblockchain_protocol_response_decode_header(
+            request_id, offset, status, response);
+    if (STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_AGENT_PROTOCOL;
+        goto cleanup_response;
+    }
+
+    /* success. The caller owns the response. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto done;
+
+cleanup_response:
+    dispose((disposable_t*)response);
+
+done:
+    return retval;
+}
@@ -0,0 +1,38 @@
+/**
+ * \file lib/agent/agent_internal.h
+ *
+ * \brief Internal declarations for agent connections.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <vctool/agent.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Perform the client side of the vcblockchain handshake.
+ *
+ * On success, the connection holds the shared secret and the initialization
+ * vectors for the authenticated requests and responses that follow.
+ *
+ * \param conn              The unauthenticated connection.
+ * \param keys              The client keys and the agent public key.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED if the agent rejects the
+ *        handshake or is not the expected agent.
+ *      - a non-zero error code on failure.
+ */
+int agent_connection_handshake(agent_connection* conn, const agent_keys* keys);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,26 @@
+/**
+ * \file agent/agent_keys_dispose.c
+ *
+ * \brief Dispose of a set of agent keys.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/agent.h>
+
+/**
+ * \brief Dispose of a set of agent keys.
+ *
+ * \param keys              The keys to dispose.
+ */
+void agent_keys_dispose(agent_keys* keys)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != keys);
+
+    dispose((disposable_t*)&keys->local_private_key);
+    dispose((disposable_t*)&keys->peer_public_key);
+    memset(keys, 0, sizeof(*keys));
+}
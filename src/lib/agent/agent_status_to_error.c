@@ -0,0 +1,30 @@
+/**
+ * \file agent/agent_status_to_error.c
+ *
+ * \brief Map an agent response status to a status code.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <vctool/agent.h>
+#include <vctool/status_codes.h>
+
+/**
+ * \brief Map an agent response status to a status code.
+ *
+ * The agent reports a failed request with its own error code. Only success is
+ * distinguished here; the caller reports the failed request.
+ *
+ * \param status            The agent response status.
+ *
+ * \returns the matching status code.
+ */
+int agent_status_to_error(uint32_t status)
+{
+    if (AGENT_STATUS_SUCCESS == status)
+    {
+        return VCTOOL_STATUS_SUCCESS;
+    }
+
+    return VCTOOL_ERROR_AGENT_REQUEST_FAILED;
+}
@@ -0,0 +1,268 @@
+/**
+ * \file backup/backup_file_encryption_header_read.c
+ *
+ * \brief Read a file encryption header.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcblockchain/byteswap.h>
+#include <vccrypt/compare.h>
+#include <vctool/backup.h>
+
+/* forward decls. */
+static void backup_file_enc_header_dispose(void* disp);
+
+/**
+ * \brief Read a backup file encryption header from the given file instance.
+ *
+ * \param f                 The file instance from which the header is read.
+ * \param desc              The file descriptor from which the header is read.
+ * \param suite             The crypto suite to use for this operation.
+ * \param passphrase        The passphrase to be used to decrypt this file.
+ * \param header            Pointer to the header to be read by this operation.
+ *                          On success, this header is owned by the caller and
+ *                          must be disposed when no longer needed.
+ * \param key               Pointer to an uninitialized buffer to be initialized
+ *                          with the decrypted file key on success. On success,
+ *                          this key buffer is owned by the caller and must be
+ *                          disposed when no longer needed.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BACKUP_TRUNCATED_RECORD if the header is truncated.
+ *      - VCTOOL_ERROR_BACKUP_BAD_HEADER if this is not a backup file of a
+ *        supported version.
+ *      - VCTOOL_ERROR_BACKUP_BAD_MAC if the passphrase is wrong or the header
+ *        is damaged.
+ *      - a non-zero error code on failure.
+ */
+int backup_file_encryption_header_read(
+    file* f, int desc, vccrypt_suite_options_t* suite,
+    vccrypt_buffer_t* passphrase, backup_file_enc_header* header,
+    vccrypt_buffer_t* key)
+{
+    int retval;
+    uint8_t record[BACKUP_FILE_SIZE_FILE_ENC_HEADER];
+    size_t read_size;
+    vccrypt_buffer_t salt_buffer;
+    vccrypt_buffer_t lt_key_buffer;
+    vccrypt_buffer_t mac_buffer;
+    vccrypt_key_derivation_context_t key_derivation;
+    vccrypt_block_context_t block;
+    vccrypt_mac_context_t mac;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != f);
+    MODEL_ASSERT(desc >= 0);
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != passphrase);
+    MODEL_ASSERT(NULL != header);
+    MODEL_ASSERT(NULL != key);
+
+    /* runtime parameter checks. */
+    if (NULL == f || desc < 0 || NULL == suite || NULL == passphrase
+     || NULL == header || NULL == key)
+    {
+        retval = VCTOOL_ERROR_BACKUP_BAD_PARAMETER;
+        goto done;
+    }
+
+    /* read the record. */
+    retval = file_read(f, desc, record, sizeof(record), &read_size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+    else if (read_size != sizeof(record))
+    {
+        retval = VCTOOL_ERROR_BACKUP_TRUNCATED_RECORD;
+        goto done;
+    }
+
+    /* decode the record; the fields are in the order they are written. */
+    const uint8_t* buf = record;
+    uint64_t net_value;
+    memset(header, 0, sizeof(*header));
+    header->hdr.dispose = &backup_file_enc_header_dispose;
+
+    memcpy(header->file_magic, buf, 8); buf += 8;
+
+    memcpy(&net_value, buf, sizeof(net_value)); buf += sizeof(net_value);
+    header->serialization_version = ntohll(net_value);
+
+    memcpy(&net_value, buf, sizeof(net_value)); buf += sizeof(net_value);
+    header->record_size = ntohll(net_value);
+
+    memcpy(&net_value, buf, sizeof(net_value)); buf += sizeof(net_value);
+    header->rounds = ntohll(net_value);
+
+    memcpy(header->passphrase_salt, buf, 32); buf += 32;
+    memcpy(header->enc_key, buf, 48); buf += 48;
+    memcpy(header->file_header_mac, buf, 32);
+
+    /* verify that this is a backup file that we can read. */
+    if (memcmp(header->file_magic, "ENCVCBAK", 8)
+     || BACKUP_FILE_ENC_HEADER_SERIALIZATION_VERSION
+            != header->serialization_version
+     || BACKUP_FILE_SIZE_FILE_ENC_HEADER != header->record_size
+     || header->rounds > UINT32_MAX)
+    {
+        retval = VCTOOL_ERROR_BACKUP_BAD_HEADER;
+        goto cleanup_header;
+    }
+
+    /* create a salt buffer. */
+    retval = vccrypt_buffer_init(&salt_buffer, suite->alloc_opts, 32);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_header;
+    }
+
+    memcpy(salt_buffer.data, header->passphrase_salt, 32);
+
+    /* create a long-term key buffer. */
+    retval = vccrypt_buffer_init(&lt_key_buffer, suite->alloc_opts, 32);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_salt_buffer;
+    }
+
+    /* create the file key buffer. */
+    retval = vccrypt_buffer_init(key, suite->alloc_opts, 32);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_lt_key_buffer;
+    }
+
+    /* create the mac buffer. */
+    retval =
+        vccrypt_suite_buffer_init_for_mac_authentication_code(
+            suite, &mac_buffer, true);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_key;
+    }
+
+    /* create the key derivation instance. */
+    retval = vccrypt_suite_key_derivation_init(&key_derivation, suite);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mac_buffer;
+    }
+
+    /* derive the long-term key. */
+    retval =
+        vccrypt_key_derivation_derive_key(
+            &lt_key_buffer, &key_derivation, passphrase, &salt_buffer,
+            (unsigned int)header->rounds);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_key_derivation;
+    }
+
+    /* create the block cipher instance using the lt key. */
+    retval = vccrypt_suite_block_init(suite, &block, &lt_key_buffer, false);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_key_derivation;
+    }
+
+    /* the encrypted key follows its iv. */
+    const uint8_t* iv = header->enc_key;
+    const uint8_t* inbuf = header->enc_key + 16;
+    uint8_t* kbuf = (uint8_t*)key->data;
+
+    /* use it to decrypt the short-term key (first block). */
+    retval = vccrypt_block_decrypt(&block, iv, inbuf, kbuf);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_block;
+    }
+
+    /* use it to decrypt the short-term key (second block). */
+    retval = vccrypt_block_decrypt(&block, inbuf, inbuf + 16, kbuf + 16);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_block;
+    }
+
+    /* create a mac instance. */
+    retval = vccrypt_suite_mac_short_init(suite, &mac, key);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_block;
+    }
+
+    /* mac the record. */
+    retval = vccrypt_mac_digest(&mac, record, sizeof(record) - 32);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mac;
+    }
+
+    /* finalize the mac. */
+    retval = vccrypt_mac_finalize(&mac, &mac_buffer);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mac;
+    }
+
+    /* a wrong passphrase gives a wrong key, and so a wrong mac. */
+    if (crypto_memcmp(mac_buffer.data, header->file_header_mac, 32))
+    {
+        retval = VCTOOL_ERROR_BACKUP_BAD_MAC;
+        goto cleanup_mac;
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_mac;
+
+cleanup_mac:
+    dispose((disposable_t*)&mac);
+
+cleanup_block:
+    dispose((disposable_t*)&block);
+
+cleanup_key_derivation:
+    dispose((disposable_t*)&key_derivation);
+
+cleanup_mac_buffer:
+    dispose((disposable_t*)&mac_buffer);
+
+cleanup_key:
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        dispose((disposable_t*)key);
+    }
+
+cleanup_lt_key_buffer:
+    dispose((disposable_t*)&lt_key_buffer);
+
+cleanup_salt_buffer:
+    dispose((disposable_t*)&salt_buffer);
+
+cleanup_header:
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        dispose((disposable_t*)header);
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Dispose of a backup file encryption header.
+ *
+ * \param disp              The header to dispose.
+ */
+static void backup_file_enc_header_dispose(void* disp)
+{
+    backup_file_enc_header* header = (backup_file_enc_header*)disp;
+
+    memset(header, 0, sizeof(*header));
+}
@@ -0,0 +1,110 @@
+/**
+ * \file backup/backup_record_authenticate.c
+ *
+ * \brief Authenticate a backup record.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vccrypt/compare.h>
+#include <vctool/backup.h>
+
+/**
+ * \brief Authenticate a backup record whose clear header has been decoded.
+ *
+ * The record MAC covers the record header up to the MAC and the encrypted
+ * record body, so the type and size in an authentic header can be trusted.
+ *
+ * \param suite             The crypto suite to use for this operation.
+ * \param key               The file key.
+ * \param header            The header decoded from this record by
+ *                          \ref backup_record_header_read.
+ * \param record            The record, starting at its header, which holds
+ *                          at least the record size in the header.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS if the record is authentic.
+ *      - VCTOOL_ERROR_BACKUP_BAD_MAC if the record fails authentication.
+ *      - a non-zero error code on failure.
+ */
+int backup_record_authenticate(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* key,
+    const backup_record_header* header, const void* record)
+{
+    int retval;
+    vccrypt_buffer_t mac_buffer;
+    vccrypt_mac_context_t mac;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != key);
+    MODEL_ASSERT(NULL != header);
+    MODEL_ASSERT(NULL != record);
+    MODEL_ASSERT(header->record_size >= BACKUP_FILE_SIZE_RECORD_HEADER_RAW);
+
+    const uint8_t* body =
+        (const uint8_t*)record + BACKUP_FILE_SIZE_RECORD_HEADER_RAW;
+    size_t body_size =
+        (size_t)header->record_size - BACKUP_FILE_SIZE_RECORD_HEADER_RAW;
+
+    /* create the mac buffer. */
+    retval =
+        vccrypt_suite_buffer_init_for_mac_authentication_code(
+            suite, &mac_buffer, true);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* create a mac instance. */
+    retval = vccrypt_suite_mac_short_init(suite, &mac, key);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mac_buffer;
+    }
+
+    /* mac the record header up to the mac. */
+    retval =
+        vccrypt_mac_digest(
+            &mac, record, BACKUP_FILE_SIZE_RECORD_HEADER_RAW - 32);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mac;
+    }
+
+    /* mac the encrypted body. */
+    retval = vccrypt_mac_digest(&mac, body, body_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mac;
+    }
+
+    /* finalize the mac. */
+    retval = vccrypt_mac_finalize(&mac, &mac_buffer);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mac;
+    }
+
+    /* compare in constant time. */
+    if (crypto_memcmp(mac_buffer.data, header->record_mac, 32))
+    {
+        retval = VCTOOL_ERROR_BACKUP_BAD_MAC;
+        goto cleanup_mac;
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_mac;
+
+cleanup_mac:
+    dispose((disposable_t*)&mac);
+
+cleanup_mac_buffer:
+    dispose((disposable_t*)&mac_buffer);
+
+done:
+    return retval;
+}
@@ -0,0 +1,198 @@
+/**
+ * \file backup/backup_record_block_decrypt.c
+ *
+ * \brief Authenticate and decrypt a backup block record.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcblockchain/byteswap.h>
+#include <vctool/backup.h>
+
+/* forward decls. */
+static void backup_record_block_dispose(void* disp);
+
+/**
+ * \brief Authenticate and decrypt a backup block record.
+ *
+ * The record MAC is checked before anything is decrypted.
+ *
+ * \param block             The block record to populate. On success, this
+ *                          record is owned by the caller and must be disposed
+ *                          when no longer needed.
+ * \param suite             The crypto suite to use for this operation.
+ * \param key               The file key.
+ * \param record            The record, starting at its header.
+ * \param record_size       The size of the record.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BACKUP_BAD_MAC if the record fails authentication.
+ *      - VCTOOL_ERROR_BACKUP_BAD_RECORD if the record is not a well formed
+ *        block record.
+ *      - a non-zero error code on failure.
+ */
+int backup_record_block_decrypt(
+    backup_record_block* block, vccrypt_suite_options_t* suite,
+    vccrypt_buffer_t* key, const void* record, size_t record_size)
+{
+    int retval;
+    vccrypt_block_context_t cipher;
+    uint8_t header[32];
+    uint8_t last[16];
+    uint64_t net_value;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != block);
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != key);
+    MODEL_ASSERT(NULL != record);
+
+    memset(block, 0, sizeof(*block));
+
+    /* decode the clear header. */
+    retval = backup_record_header_read(&block->hdr, record, record_size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    block->hdr.hdr.dispose = &backup_record_block_dispose;
+
+    /* the body holds the block header, the block, and at least one pad byte. */
+    const uint8_t* body =
+        (const uint8_t*)record + BACKUP_FILE_SIZE_RECORD_HEADER_RAW;
+    size_t body_size =
+        (size_t)block->hdr.record_size - BACKUP_FILE_SIZE_RECORD_HEADER_RAW;
+    if (BACKUP_RECORD_TYPE_BLOCK != block->hdr.type
+     || record_size != block->hdr.record_size
+     || body_size < sizeof(header) + 16)
+    {
+        retval = VCTOOL_ERROR_BACKUP_BAD_RECORD;
+        goto done;
+    }
+
+    /* nothing is decrypted unless the record is authentic. */
+    retval = backup_record_authenticate(suite, key, &block->hdr, record);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* create the block cipher instance using the file key. */
+    retval = vccrypt_suite_block_init(suite, &cipher, key, false);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* decrypt the block header (first two cipher blocks). */
+    retval = vccrypt_block_decrypt(&cipher, block->hdr.iv, body, header);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_cipher;
+    }
+
+    retval = vccrypt_block_decrypt(&cipher, body, body + 16, header + 16);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_cipher;
+    }
+
+    /* decode the block header. */
+    memcpy(block->block_id.data, header, 16);
+    memcpy(&net_value, header + 16, sizeof(net_value));
+    block->block_height = ntohll(net_value);
+    memcpy(&net_value, header + 24, sizeof(net_value));
+    block->block_size = ntohll(net_value);
+
+    /* the block size must account for the rest of the body. */
+    if (0 == block->block_size
+     || block->block_size > body_size - sizeof(header) - 1
+     || CRYPTO_PAD(sizeof(header) + block->block_size) != body_size)
+    {
+        retval = VCTOOL_ERROR_BACKUP_BAD_RECORD;
+        goto cleanup_cipher;
+    }
+
+    /* create the block buffer. */
+    retval =
+        vccrypt_buffer_init(
+            &block->block_data, suite->alloc_opts, block->block_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_cipher;
+    }
+
+    /* decrypt every whole cipher block of the block in place. */
+    uint8_t* out = (uint8_t*)block->block_data.data;
+    size_t last_offset = body_size - 16;
+    for (size_t offset = sizeof(header); offset < last_offset; offset += 16)
+    {
+        retval =
+            vccrypt_block_decrypt(
+                &cipher, body + offset - 16, body + offset,
+                out + offset - sizeof(header));
+        if (VCCRYPT_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_cipher;
+        }
+    }
+
+    /* the padding is always in the last cipher block. */
+    retval =
+        vccrypt_block_decrypt(
+            &cipher, body + last_offset - 16, body + last_offset, last);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_cipher;
+    }
+
+    size_t pad_size = body_size - sizeof(header) - block->block_size;
+    memcpy(out + last_offset - sizeof(header), last, 16 - pad_size);
+    for (size_t i = 16 - pad_size; i < 16; ++i)
+    {
+        if (last[i] != pad_size)
+        {
+            retval = VCTOOL_ERROR_BACKUP_BAD_RECORD;
+            goto cleanup_cipher;
+        }
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_cipher;
+
+cleanup_cipher:
+    dispose((disposable_t*)&cipher);
+
+done:
+    memset(header, 0, sizeof(header));
+    memset(last, 0, sizeof(last));
+
+    if (VCTOOL_STATUS_SUCCESS != retval && NULL != block->hdr.hdr.dispose)
+    {
+        dispose((disposable_t*)block);
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Dispose of a backup block record.
+ *
+ * \param disp              The record to dispose.
+ */
+static void backup_record_block_dispose(void* disp)
+{
+    backup_record_block* block = (backup_record_block*)disp;
+
+    if (NULL != block->block_data.data)
+    {
+        dispose((disposable_t*)&block->block_data);
+    }
+
+    memset(block, 0, sizeof(*block));
+}
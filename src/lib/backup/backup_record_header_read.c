@@ -0,0 +1,92 @@
+/**
+ * \file backup/backup_record_header_read.c
+ *
+ * \brief Decode the clear header of a backup record.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <arpa/inet.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcblockchain/byteswap.h>
+#include <vctool/backup.h>
+
+/* forward decls. */
+static void backup_record_header_dispose(void* disp);
+
+/**
+ * \brief Decode the clear header of a backup record.
+ *
+ * \param header            The header to populate.
+ * \param buf               The record, starting at its header.
+ * \param size              The number of bytes available at \p buf.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BACKUP_TRUNCATED_RECORD if the record does not fit in
+ *        the available bytes.
+ *      - VCTOOL_ERROR_BACKUP_BAD_RECORD if the header is malformed.
+ */
+int backup_record_header_read(
+    backup_record_header* header, const void* buf, size_t size)
+{
+    const uint8_t* in = (const uint8_t*)buf;
+    uint32_t net_value32;
+    uint64_t net_value64;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != header);
+    MODEL_ASSERT(NULL != buf);
+
+    /* the header must be complete. */
+    if (size < BACKUP_FILE_SIZE_RECORD_HEADER_RAW)
+    {
+        return VCTOOL_ERROR_BACKUP_TRUNCATED_RECORD;
+    }
+
+    memset(header, 0, sizeof(*header));
+    header->hdr.dispose = &backup_record_header_dispose;
+
+    /* decode the fields in the order they are written. */
+    memcpy(header->iv, in, 16); in += 16;
+
+    memcpy(&net_value32, in, sizeof(net_value32)); in += sizeof(net_value32);
+    header->type = ntohl(net_value32);
+
+    memcpy(&net_value32, in, sizeof(net_value32)); in += sizeof(net_value32);
+    header->reserved = ntohl(net_value32);
+
+    memcpy(&net_value64, in, sizeof(net_value64)); in += sizeof(net_value64);
+    header->record_size = ntohll(net_value64);
+
+    memcpy(header->record_mac, in, 32);
+
+    /* the body is at least one padded cipher block. */
+    if (0 != header->reserved
+     || header->record_size < BACKUP_FILE_SIZE_RECORD_HEADER_RAW + 16
+     || 0 != (header->record_size - BACKUP_FILE_SIZE_RECORD_HEADER_RAW) % 16)
+    {
+        return VCTOOL_ERROR_BACKUP_BAD_RECORD;
+    }
+
+    /* the whole record must be available. */
+    if (header->record_size > size)
+    {
+        return VCTOOL_ERROR_BACKUP_TRUNCATED_RECORD;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Dispose of a backup record header.
+ *
+ * \param disp              The header to dispose.
+ */
+static void backup_record_header_dispose(void* disp)
+{
+    backup_record_header* header = (backup_record_header*)disp;
+
+    memset(header, 0, sizeof(*header));
+}
@@ -0,0 +1,100 @@
+/**
+ * \file block/block_chain_verify_linkage.c
+ *
+ * \brief Verify that a set of blocks forms a single chain.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vctool/block.h>
+#include <vctool/status_codes.h>
+
+/* forward decls. */
+static int block_info_height_compare(const void* lhs, const void* rhs);
+
+/**
+ * \brief Verify that the given blocks form a single chain.
+ *
+ * The blocks are sorted by height. The heights must be consecutive, and the
+ * previous block id of each block must be the block id of the block before it.
+ * The previous block id of the lowest block is not checked, so that a range of
+ * the chain can be verified.
+ *
+ * \param blocks            The blocks to verify; these are sorted in place.
+ * \param count             The number of blocks.
+ * \param index             Pointer to receive the index of the offending block
+ *                          in the sorted array on failure.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT if two blocks share a height.
+ *      - VCTOOL_ERROR_BLOCK_HEIGHT_GAP if a height is missing.
+ *      - VCTOOL_ERROR_BLOCK_PREVIOUS_MISMATCH if a block does not link to the
+ *        block before it.
+ */
+int block_chain_verify_linkage(
+    block_info* blocks, size_t count, size_t* index)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != blocks || 0 == count);
+    MODEL_ASSERT(NULL != index);
+
+    /* blocks may be read in any order, so put them in chain order. */
+    qsort(blocks, count, sizeof(block_info), &block_info_height_compare);
+
+    /* check each block against the block before it. */
+    for (size_t i = 1; i < count; ++i)
+    {
+        *index = i;
+
+        if (blocks[i].height == blocks[i - 1].height)
+        {
+            return VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT;
+        }
+
+        if (blocks[i].height != blocks[i - 1].height + 1)
+        {
+            return VCTOOL_ERROR_BLOCK_HEIGHT_GAP;
+        }
+
+        if (memcmp(
+                blocks[i].previous_block_id, blocks[i - 1].block_id,
+                BLOCK_ID_SIZE))
+        {
+            return VCTOOL_ERROR_BLOCK_PREVIOUS_MISMATCH;
+        }
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Compare two block info records by height.
+ *
+ * \param lhs           The left-hand side of the comparison.
+ * \param rhs           The right-hand side of the comparison.
+ *
+ * \returns a negative value, zero, or a positive value if \p lhs is lower
+ * than, the same height as, or higher than \p rhs.
+ */
+static int block_info_height_compare(const void* lhs, const void* rhs)
+{
+    const block_info* l = (const block_info*)lhs;
+    const block_info* r = (const block_info*)rhs;
+
+    if (l->height < r->height)
+    {
+        return -1;
+    }
+    else if (l->height > r->height)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
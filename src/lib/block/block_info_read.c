@@ -0,0 +1,129 @@
+/**
+ * \file block/block_info_read.c
+ *
+ * \brief Read the chain fields of a block certificate.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vccert/fields.h>
+#include <vctool/block.h>
+#include <vctool/status_codes.h>
+
+/* each field header is a two byte type followed by a two byte size. */
+#define FIELD_HEADER_SIZE 4
+
+/* the fields that must be found. */
+#define FOUND_BLOCK_ID          0x01
+#define FOUND_PREVIOUS_BLOCK_ID 0x02
+#define FOUND_SIGNER_ID         0x04
+#define FOUND_HEIGHT            0x08
+#define FOUND_ALL               0x0F
+
+/**
+ * \brief Read the block id, previous block id, signer id, and height of a
+ * block certificate.
+ *
+ * The certificate fields are scanned once. The signature is not verified.
+ *
+ * \param info              The block info to populate.
+ * \param block             The block certificate.
+ * \param block_size        The size of the block certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BLOCK_MISSING_FIELD if a field is missing.
+ *      - VCTOOL_ERROR_BLOCK_INVALID_FIELD_SIZE if a field has the wrong size.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED if the block is malformed.
+ */
+int block_info_read(block_info* info, const void* block, size_t block_size)
+{
+    const uint8_t* bblock = (const uint8_t*)block;
+    size_t offset = 0;
+    int found = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != info);
+    MODEL_ASSERT(NULL != block);
+
+    while (offset < block_size)
+    {
+        /* verify that the header fits. */
+        if (block_size - offset < FIELD_HEADER_SIZE)
+        {
+            return VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED;
+        }
+
+        /* decode the field type and size from network byte order. */
+        uint16_t type =
+            (uint16_t)((bblock[offset] << 8) | bblock[offset + 1]);
+        size_t size =
+            (size_t)((bblock[offset + 2] << 8) | bblock[offset + 3]);
+        const uint8_t* value = bblock + offset + FIELD_HEADER_SIZE;
+
+        /* verify that the value fits. */
+        if (block_size - offset - FIELD_HEADER_SIZE < size)
+        {
+            return VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED;
+        }
+
+        switch (type)
+        {
+            case VCCERT_FIELD_TYPE_BLOCK_UUID:
+                if (BLOCK_ID_SIZE != size)
+                {
+                    return VCTOOL_ERROR_BLOCK_INVALID_FIELD_SIZE;
+                }
+                memcpy(info->block_id, value, size);
+                found |= FOUND_BLOCK_ID;
+                break;
+
+            case VCCERT_FIELD_TYPE_PREVIOUS_BLOCK_UUID:
+                if (BLOCK_ID_SIZE != size)
+                {
+                    return VCTOOL_ERROR_BLOCK_INVALID_FIELD_SIZE;
+                }
+                memcpy(info->previous_block_id, value, size);
+                found |= FOUND_PREVIOUS_BLOCK_ID;
+                break;
+
+            case VCCERT_FIELD_TYPE_SIGNER_ID:
+                if (BLOCK_ID_SIZE != size)
+                {
+                    return VCTOOL_ERROR_BLOCK_INVALID_FIELD_SIZE;
+                }
+                memcpy(info->signer_id, value, size);
+                found |= FOUND_SIGNER_ID;
+                break;
+
+            case VCCERT_FIELD_TYPE_BLOCK_HEIGHT:
+                if (sizeof(uint64_t) != size)
+                {
+                    return VCTOOL_ERROR_BLOCK_INVALID_FIELD_SIZE;
+                }
+                /* the height is stored in network byte order. */
+                info->height = 0;
+                for (size_t i = 0; i < size; ++i)
+                {
+                    info->height = (info->height << 8) | value[i];
+                }
+                found |= FOUND_HEIGHT;
+                break;
+
+            default:
+                break;
+        }
+
+        offset += FIELD_HEADER_SIZE + size;
+    }
+
+    /* every chain field must be present. */
+    if (FOUND_ALL != found)
+    {
+        return VCTOOL_ERROR_BLOCK_MISSING_FIELD;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
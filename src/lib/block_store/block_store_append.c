@@ -0,0 +1,268 @@
+/**
+ * \file lib/block_store/block_store_append.c
+ *
+ * \brief Append a block to a block store.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vctool/status_codes.h>
+
+#include "block_store_internal.h"
+
+/* forward decls. */
+static int block_store_start_segment(block_store* store);
+static int block_store_write_all(
+    file* f, int fd, const uint8_t* data, size_t size, off_t offset);
+
+/**
+ * \brief Append a block to a writable block store.
+ *
+ * The block height and id are read from the block.
+ *
+ * \param store             The store.
+ * \param block             The block certificate.
+ * \param block_size        The size of the block certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT if the store already holds a
+ *        block at this height.
+ *      - VCTOOL_ERROR_BLOCK_STORE_BLOCK_TOO_LARGE if the block does not fit in
+ *        a segment.
+ *      - VCTOOL_ERROR_FILE_IO, or an error code from the file interface, if
+ *        the block can't be written.
+ *      - a non-zero error code from \ref block_info_read on failure.
+ */
+int block_store_append(
+    block_store* store, const void* block, size_t block_size)
+{
+    int retval;
+    block_info info;
+    block_store_entry entry;
+    uint8_t record[BLOCK_STORE_INDEX_RECORD_SIZE];
+    size_t pos, wrote_size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != store);
+    MODEL_ASSERT(store->writable);
+    MODEL_ASSERT(NULL != block);
+
+    retval = block_info_read(&info, block, block_size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    if (block_size > UINT32_MAX || block_size > store->segment_max_size)
+    {
+        return VCTOOL_ERROR_BLOCK_STORE_BLOCK_TOO_LARGE;
+    }
+
+    /* find where the entry goes; blocks are usually appended in order. */
+    pos = store->count;
+    if (pos > 0 && store->entries[pos - 1].height >= info.height)
+    {
+        size_t low = 0, high = store->count;
+        while (low < high)
+        {
+            size_t mid = low + (high - low) / 2;
+            if (store->entries[mid].height < info.height)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+
+        if (store->entries[low].height == info.height)
+        {
+            return VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT;
+        }
+
+        pos = low;
+    }
+
+    /* make room for the entry before anything is written. */
+    if (store->count == store->capacity)
+    {
+        size_t capacity = store->capacity ? 2 * store->capacity : 1024;
+        block_store_entry* entries =
+            (block_store_entry*)realloc(
+                store->entries, capacity * sizeof(block_store_entry));
+        if (NULL == entries)
+        {
+            return VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        }
+
+        store->entries = entries;
+        store->capacity = capacity;
+    }
+
+    /* start a new segment if the block does not fit in this one. */
+    if (store->segment_fd < 0
+     || store->segment_size + block_size > store->segment_max_size)
+    {
+        retval = block_store_start_segment(store);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    /* write the block, then the index record that names it. */
+    retval =
+        block_store_write_all(
+            store->f, store->segment_fd, (const uint8_t*)block, block_size,
+            (off_t)store->segment_size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    entry.height = info.height;
+    memcpy(entry.block_id, info.block_id, BLOCK_ID_SIZE);
+    entry.segment = store->segment_count - 1;
+    entry.size = (uint32_t)block_size;
+    entry.offset = store->segment_size;
+    block_store_index_record_encode(record, &entry);
+
+    retval =
+        file_write(
+            store->f, store->index_fd, record, sizeof(record), &wrote_size);
+    if (VCTOOL_STATUS_SUCCESS != retval || sizeof(record) != wrote_size)
+    {
+        /* don't leave a partial record for the next record to follow. */
+        (void)file_ftruncate(
+            store->f, store->index_fd,
+            BLOCK_STORE_INDEX_HEADER_SIZE
+          + (off_t)store->count * BLOCK_STORE_INDEX_RECORD_SIZE);
+        return
+            (VCTOOL_STATUS_SUCCESS != retval) ? retval : VCTOOL_ERROR_FILE_IO;
+    }
+
+    /* insert the entry in height order. */
+    memmove(
+        &store->entries[pos + 1], &store->entries[pos],
+        (store->count - pos) * sizeof(block_store_entry));
+    store->entries[pos] = entry;
+    ++store->count;
+    store->by_id_valid = false;
+
+    store->segment_size += block_size;
+    store->segments[entry.segment].file_size = store->segment_size;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Create and map the next segment, and make it the segment appended to.
+ *
+ * The full segment is synced first, so that a failed sync leaves the store
+ * appending to it unchanged.
+ *
+ * \param store             The store.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int block_store_start_segment(block_store* store)
+{
+    int retval, fd;
+    char* path;
+
+    /* the full segment must be on disk before any block follows it. */
+    if (store->segment_fd >= 0
+     && VCTOOL_STATUS_SUCCESS != file_fsync(store->f, store->segment_fd))
+    {
+        return VCTOOL_ERROR_FILE_IO;
+    }
+
+    retval =
+        block_store_segment_path(&path, store->dirname, store->segment_count);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* a segment left by an interrupted append holds no indexed blocks. */
+    retval =
+        file_open(
+            store->f, &fd, path, O_RDWR | O_CREAT | O_TRUNC,
+            S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    free(path);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval = block_store_segment_map(store, fd);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        file_close(store->f, fd);
+        return retval;
+    }
+
+    /* the full segment stays mapped for reads; only its file is closed. */
+    if (store->segment_fd >= 0)
+    {
+        file_close(store->f, store->segment_fd);
+    }
+
+    store->segment_fd = fd;
+    store->segment_size = 0;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write every byte of a buffer at the given offset.
+ *
+ * \param f                 The file interface.
+ * \param fd                The file.
+ * \param data              The data to write.
+ * \param size              The size of the data.
+ * \param offset            The file offset.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int block_store_write_all(
+    file* f, int fd, const uint8_t* data, size_t size, off_t offset)
+{
+    int retval;
+    off_t newoffset;
+    size_t wrote_size;
+
+    retval = file_lseek(f, fd, offset, FILE_LSEEK_WHENCE_ABSOLUTE, &newoffset);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    while (size > 0)
+    {
+        retval = file_write(f, fd, data, size, &wrote_size);
+        if (VCTOOL_ERROR_FILE_INTERRUPT == retval)
+        {
+            continue;
+        }
+        else if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+        else if (0 == wrote_size)
+        {
+            return VCTOOL_ERROR_FILE_IO;
+        }
+
+        data += wrote_size;
+        size -= wrote_size;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
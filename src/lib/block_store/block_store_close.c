@@ -0,0 +1,75 @@
+/**
+ * \file lib/block_store/block_store_close.c
+ *
+ * \brief Close a block store.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vctool/status_codes.h>
+
+#include "block_store_internal.h"
+
+/**
+ * \brief Close a block store, syncing a writable store to disk.
+ *
+ * Blocks read from the store are not valid after it is closed.
+ *
+ * \param store             The store to close.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_IO if a writable store can't be synced.
+ */
+int block_store_close(block_store* store)
+{
+    int retval = VCTOOL_STATUS_SUCCESS;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != store);
+
+    /* the blocks are synced before the index that names them. */
+    if (store->segment_fd >= 0)
+    {
+        if (VCTOOL_STATUS_SUCCESS != file_fsync(store->f, store->segment_fd))
+        {
+            retval = VCTOOL_ERROR_FILE_IO;
+        }
+
+        file_close(store->f, store->segment_fd);
+    }
+
+    if (store->index_fd >= 0)
+    {
+        if (store->writable
+         && VCTOOL_STATUS_SUCCESS != file_fsync(store->f, store->index_fd))
+        {
+            retval = VCTOOL_ERROR_FILE_IO;
+        }
+
+        file_close(store->f, store->index_fd);
+    }
+
+    for (uint32_t i = 0; i < store->segment_count; ++i)
+    {
+        if (NULL != store->segments[i].map)
+        {
+            file_munmap(
+                store->f, store->segments[i].map,
+                store->segments[i].map_size);
+        }
+    }
+
+    free(store->segments);
+    free(store->entries);
+    free(store->by_id);
+    free(store->dirname);
+    memset(store, 0, sizeof(*store));
+    store->index_fd = -1;
+    store->segment_fd = -1;
+
+    return retval;
+}
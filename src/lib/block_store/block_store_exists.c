@@ -0,0 +1,45 @@
+/**
+ * \file lib/block_store/block_store_exists.c
+ *
+ * \brief Check whether a directory is a block store.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <vctool/status_codes.h>
+
+#include "block_store_internal.h"
+
+/**
+ * \brief Check whether a directory is a block store.
+ *
+ * \param f                 The file interface to use.
+ * \param dirname           The directory to check.
+ *
+ * \returns true if the directory holds a block store index.
+ */
+bool block_store_exists(file* f, const char* dirname)
+{
+    char* path;
+    file_stat_st fst;
+    bool exists;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != f);
+    MODEL_ASSERT(NULL != dirname);
+
+    if (VCTOOL_STATUS_SUCCESS !=
+            block_store_path(&path, dirname, BLOCK_STORE_INDEX_FILENAME))
+    {
+        return false;
+    }
+
+    exists =
+        VCTOOL_STATUS_SUCCESS == file_stat(f, path, &fst)
+     && S_ISREG(fst.fst_mode);
+    free(path);
+
+    return exists;
+}
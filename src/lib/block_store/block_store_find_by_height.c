@@ -0,0 +1,50 @@
+/**
+ * \file lib/block_store/block_store_find_by_height.c
+ *
+ * \brief Find a block store entry by height.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "block_store_internal.h"
+
+/**
+ * \brief Find a block by height.
+ *
+ * \param store             The store.
+ * \param height            The block height.
+ *
+ * \returns the entry, or NULL if there is no block at this height.
+ */
+const block_store_entry* block_store_find_by_height(
+    const block_store* store, uint64_t height)
+{
+    size_t low = 0, high;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != store);
+
+    /* binary search the entries. */
+    high = store->count;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+
+        if (store->entries[mid].height == height)
+        {
+            return &store->entries[mid];
+        }
+        else if (store->entries[mid].height < height)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return NULL;
+}
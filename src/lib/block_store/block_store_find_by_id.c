@@ -0,0 +1,91 @@
+/**
+ * \file lib/block_store/block_store_find_by_id.c
+ *
+ * \brief Find a block store entry by block id.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "block_store_internal.h"
+
+/* forward decls. */
+static int block_store_compare_id(const void* lhs, const void* rhs);
+
+/**
+ * \brief Find a block by id.
+ *
+ * \param store             The store.
+ * \param id                The block id.
+ *
+ * \returns the entry, or NULL if there is no block with this id.
+ */
+const block_store_entry* block_store_find_by_id(
+    block_store* store, const uint8_t* id)
+{
+    size_t low = 0, high;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != store);
+    MODEL_ASSERT(NULL != id);
+
+    /* rebuild the id index after an append. */
+    if (!store->by_id_valid && store->count > 0)
+    {
+        block_store_entry** by_id =
+            (block_store_entry**)realloc(
+                store->by_id, store->count * sizeof(block_store_entry*));
+        if (NULL == by_id)
+        {
+            return NULL;
+        }
+
+        for (size_t i = 0; i < store->count; ++i)
+        {
+            by_id[i] = &store->entries[i];
+        }
+
+        qsort(
+            by_id, store->count, sizeof(block_store_entry*),
+            &block_store_compare_id);
+        store->by_id = by_id;
+        store->by_id_valid = true;
+    }
+
+    /* binary search the id index. */
+    high = store->count;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        int cmp = memcmp(store->by_id[mid]->block_id, id, BLOCK_ID_SIZE);
+
+        if (0 == cmp)
+        {
+            return store->by_id[mid];
+        }
+        else if (cmp < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Compare two entry pointers by block id.
+ */
+static int block_store_compare_id(const void* lhs, const void* rhs)
+{
+    const block_store_entry* l = *(const block_store_entry* const*)lhs;
+    const block_store_entry* r = *(const block_store_entry* const*)rhs;
+
+    return memcmp(l->block_id, r->block_id, BLOCK_ID_SIZE);
+}
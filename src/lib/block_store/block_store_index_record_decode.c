@@ -0,0 +1,42 @@
+/**
+ * \file lib/block_store/block_store_index_record_encode.c
+ *
+ * \brief Decode a block store index record.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <arpa/inet.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcblockchain/byteswap.h>
+
+#include "block_store_internal.h"
+
+/**
+ * \brief Decode an index record.
+ *
+ * \param entry             The entry to populate.
+ * \param buf               The buffer, at least
+ *                          \ref BLOCK_STORE_INDEX_RECORD_SIZE bytes long.
+ */
+void block_store_index_record_decode(
+    block_store_entry* entry, const uint8_t* buf)
+{
+    uint64_t net64;
+    uint32_t net32;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != entry);
+    MODEL_ASSERT(NULL != buf);
+
+    memcpy(&net64, buf, sizeof(net64));
+    entry->height = ntohll(net64);
+    memcpy(entry->block_id, buf + 8, BLOCK_ID_SIZE);
+    memcpy(&net32, buf + 24, sizeof(net32));
+    entry->segment = ntohl(net32);
+    memcpy(&net32, buf + 28, sizeof(net32));
+    entry->size = ntohl(net32);
+    memcpy(&net64, buf + 32, sizeof(net64));
+    entry->offset = ntohll(net64);
+}
@@ -0,0 +1,42 @@
+/**
+ * \file lib/block_store/block_store_index_record_encode.c
+ *
+ * \brief Encode a block store index record.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <arpa/inet.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcblockchain/byteswap.h>
+
+#include "block_store_internal.h"
+
+/**
+ * \brief Encode an index record.
+ *
+ * \param buf               The buffer, at least
+ *                          \ref BLOCK_STORE_INDEX_RECORD_SIZE bytes long.
+ * \param entry             The entry to encode.
+ */
+void block_store_index_record_encode(
+    uint8_t* buf, const block_store_entry* entry)
+{
+    uint64_t net64;
+    uint32_t net32;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != buf);
+    MODEL_ASSERT(NULL != entry);
+
+    net64 = htonll(entry->height);
+    memcpy(buf, &net64, sizeof(net64));
+    memcpy(buf + 8, entry->block_id, BLOCK_ID_SIZE);
+    net32 = htonl(entry->segment);
+    memcpy(buf + 24, &net32, sizeof(net32));
+    net32 = htonl(entry->size);
+    memcpy(buf + 28, &net32, sizeof(net32));
+    net64 = htonll(entry->offset);
+    memcpy(buf + 32, &net64, sizeof(net64));
+}
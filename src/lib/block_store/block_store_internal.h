@@ -0,0 +1,91 @@
+/**
+ * \file lib/block_store/block_store_internal.h
+ *
+ * \brief Internal declarations for the block store.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#pragma once
+
+#include <vctool/block_store.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Build the path of a file in a block store.
+ *
+ * \param path              Pointer to receive the path, which the caller must
+ *                          free.
+ * \param dirname           The store directory.
+ * \param name              The name of the file.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY if the path can't be allocated.
+ */
+int block_store_path(char** path, const char* dirname, const char* name);
+
+/**
+ * \brief Build the path of a segment file.
+ *
+ * Segments are named for their number in hex, such as segment-00000000.
+ *
+ * \param path              Pointer to receive the path, which the caller must
+ *                          free.
+ * \param dirname           The store directory.
+ * \param segment           The segment number.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY if the path can't be allocated.
+ */
+int block_store_segment_path(
+    char** path, const char* dirname, uint32_t segment);
+
+/**
+ * \brief Map the next segment of a store.
+ *
+ * The segment of a writable store is mapped at the segment size limit, so
+ * that blocks appended to it later can be read without remapping; otherwise it
+ * is mapped at its file size.
+ *
+ * \param store             The store; its segment count is incremented on
+ *                          success.
+ * \param fd                The open segment file.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code from the file interface if the segment can't
+ *        be mapped.
+ *      - VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY if the segment array can't grow.
+ */
+int block_store_segment_map(block_store* store, int fd);
+
+/**
+ * \brief Encode an index record.
+ *
+ * \param buf               The buffer, at least
+ *                          \ref BLOCK_STORE_INDEX_RECORD_SIZE bytes long.
+ * \param entry             The entry to encode.
+ */
+void block_store_index_record_encode(
+    uint8_t* buf, const block_store_entry* entry);
+
+/**
+ * \brief Decode an index record.
+ *
+ * \param entry             The entry to populate.
+ * \param buf               The buffer, at least
+ *                          \ref BLOCK_STORE_INDEX_RECORD_SIZE bytes long.
+ */
+void block_store_index_record_decode(
+    block_store_entry* entry, const uint8_t* buf);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,412 @@
+/**
+ * \file lib/block_store/block_store_open.c
+ *
+ * \brief Open a block store.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vctool/status_codes.h>
+
+#include "block_store_internal.h"
+
+/* forward decls. */
+static int block_store_read_index(block_store* store, size_t* index_size);
+static int block_store_map_segments(block_store* store);
+static int block_store_compare_height(const void* lhs, const void* rhs);
+
+/**
+ * \brief Open a block store.
+ *
+ * Every segment is mapped, and the index is read and sorted by height. A
+ * writable store is created if it does not exist, and a partial index record
+ * or block left by an interrupted append is removed.
+ *
+ * \param store             The store to initialize.
+ * \param f                 The file interface to use for every file in the
+ *                          store, until it is closed.
+ * \param dirname           The store directory, which must exist.
+ * \param writable          True if blocks will be appended to the store.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BLOCK_STORE_BAD_INDEX if the index is not valid.
+ *      - VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT if two blocks share a height.
+ *      - VCTOOL_ERROR_FILE_NO_ENTRY if a read-only store has no index.
+ *      - a non-zero error code from the file interface if a file can't be
+ *        read or mapped.
+ */
+int block_store_open(
+    block_store* store, file* f, const char* dirname, bool writable)
+{
+    int retval;
+    char* path;
+    size_t index_size, valid;
+    bool sorted = true;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != store);
+    MODEL_ASSERT(NULL != f);
+    MODEL_ASSERT(NULL != dirname);
+
+    memset(store, 0, sizeof(*store));
+    store->f = f;
+    store->writable = writable;
+    store->index_fd = -1;
+    store->segment_fd = -1;
+    store->segment_max_size = BLOCK_STORE_SEGMENT_MAX_SIZE;
+
+    store->dirname = strdup(dirname);
+    if (NULL == store->dirname)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_store;
+    }
+
+    /* open the index, creating it if this store is writable. */
+    retval = block_store_path(&path, dirname, BLOCK_STORE_INDEX_FILENAME);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_store;
+    }
+
+    retval =
+        writable
+            ? file_open(
+                f, &store->index_fd, path, O_RDWR | O_CREAT | O_APPEND,
+                S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH)
+            : file_open(f, &store->index_fd, path, O_RDONLY, 0);
+    free(path);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        store->index_fd = -1;
+        goto cleanup_store;
+    }
+
+    /* read every index record. */
+    retval = block_store_read_index(store, &index_size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_store;
+    }
+
+    /* map every segment named by the index. */
+    retval = block_store_map_segments(store);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_store;
+    }
+
+    /* keep the blocks before the first block outside of its segment; the
+     * blocks after it were not completely written. */
+    for (valid = 0; valid < store->count; ++valid)
+    {
+        const block_store_entry* entry = &store->entries[valid];
+        if (entry->segment >= store->segment_count
+         || entry->offset > store->segments[entry->segment].file_size
+         || entry->size >
+                store->segments[entry->segment].file_size - entry->offset)
+        {
+            break;
+        }
+    }
+
+    store->count = valid;
+
+    if (writable)
+    {
+        /* remove a partial record, and the records of partial blocks. */
+        off_t end =
+            BLOCK_STORE_INDEX_HEADER_SIZE
+          + (off_t)valid * BLOCK_STORE_INDEX_RECORD_SIZE;
+        if ((off_t)index_size != end)
+        {
+            retval = file_ftruncate(f, store->index_fd, end);
+            if (VCTOOL_STATUS_SUCCESS != retval)
+            {
+                goto cleanup_store;
+            }
+        }
+
+        /* resume appending after the last block of the last segment. */
+        if (store->segment_count > 0)
+        {
+            uint32_t last = store->segment_count - 1;
+            store->segment_size = 0;
+            for (size_t i = 0; i < store->count; ++i)
+            {
+                const block_store_entry* entry = &store->entries[i];
+                if (last == entry->segment
+                 && entry->offset + entry->size > store->segment_size)
+                {
+                    store->segment_size = entry->offset + entry->size;
+                }
+            }
+
+            retval =
+                file_ftruncate(
+                    f, store->segment_fd, (off_t)store->segment_size);
+            if (VCTOOL_STATUS_SUCCESS != retval)
+            {
+                goto cleanup_store;
+            }
+
+            store->segments[last].file_size = store->segment_size;
+        }
+    }
+    else
+    {
+        /* a read-only store does not need its index file again. */
+        file_close(f, store->index_fd);
+        store->index_fd = -1;
+    }
+
+    /* sort the blocks by height; they are usually appended in order. */
+    for (size_t i = 1; i < store->count && sorted; ++i)
+    {
+        sorted = store->entries[i - 1].height < store->entries[i].height;
+    }
+
+    if (!sorted)
+    {
+        qsort(
+            store->entries, store->count, sizeof(block_store_entry),
+            &block_store_compare_height);
+    }
+
+    for (size_t i = 1; i < store->count; ++i)
+    {
+        if (store->entries[i - 1].height == store->entries[i].height)
+        {
+            retval = VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT;
+            goto cleanup_store;
+        }
+    }
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+
+cleanup_store:
+    block_store_close(store);
+
+    return retval;
+}
+
+/**
+ * \brief Read the index header and every complete index record.
+ *
+ * The index header of a new, empty index is written here.
+ *
+ * \param store             The store, with its index open.
+ * \param index_size        Pointer to receive the size of the index file.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int block_store_read_index(block_store* store, size_t* index_size)
+{
+    int retval;
+    file_stat_st fst;
+    uint8_t* data;
+    size_t offset, size;
+    off_t newoffset;
+
+    retval = file_fstat(store->f, store->index_fd, &fst);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    *index_size = (size_t)fst.fst_size;
+
+    /* a new index starts with its header. */
+    if (0 == fst.fst_size && store->writable)
+    {
+        retval =
+            file_write(
+                store->f, store->index_fd, BLOCK_STORE_INDEX_MAGIC,
+                BLOCK_STORE_INDEX_HEADER_SIZE, &size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+        else if (BLOCK_STORE_INDEX_HEADER_SIZE != size)
+        {
+            return VCTOOL_ERROR_FILE_IO;
+        }
+
+        *index_size = BLOCK_STORE_INDEX_HEADER_SIZE;
+        return VCTOOL_STATUS_SUCCESS;
+    }
+    else if (fst.fst_size < BLOCK_STORE_INDEX_HEADER_SIZE)
+    {
+        return VCTOOL_ERROR_BLOCK_STORE_BAD_INDEX;
+    }
+
+    /* read the whole index at once. */
+    data = (uint8_t*)malloc((size_t)fst.fst_size);
+    if (NULL == data)
+    {
+        return VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    retval =
+        file_lseek(
+            store->f, store->index_fd, 0, FILE_LSEEK_WHENCE_ABSOLUTE,
+            &newoffset);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_data;
+    }
+
+    for (offset = 0; offset < (size_t)fst.fst_size; offset += size)
+    {
+        retval =
+            file_read(
+                store->f, store->index_fd, data + offset,
+                (size_t)fst.fst_size - offset, &size);
+        if (VCTOOL_ERROR_FILE_INTERRUPT == retval)
+        {
+            size = 0;
+        }
+        else if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_data;
+        }
+        else if (0 == size)
+        {
+            retval = VCTOOL_ERROR_FILE_IO;
+            goto cleanup_data;
+        }
+    }
+
+    if (0 !=
+            memcmp(
+                data, BLOCK_STORE_INDEX_MAGIC, BLOCK_STORE_INDEX_HEADER_SIZE))
+    {
+        retval = VCTOOL_ERROR_BLOCK_STORE_BAD_INDEX;
+        goto cleanup_data;
+    }
+
+    /* a partial record at the end is ignored. */
+    store->count =
+        ((size_t)fst.fst_size - BLOCK_STORE_INDEX_HEADER_SIZE)
+            / BLOCK_STORE_INDEX_RECORD_SIZE;
+    if (store->count > 0)
+    {
+        store->entries =
+            (block_store_entry*)malloc(
+                store->count * sizeof(block_store_entry));
+        if (NULL == store->entries)
+        {
+            store->count = 0;
+            retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+            goto cleanup_data;
+        }
+
+        store->capacity = store->count;
+    }
+
+    for (size_t i = 0; i < store->count; ++i)
+    {
+        block_store_index_record_decode(
+            &store->entries[i],
+            data + BLOCK_STORE_INDEX_HEADER_SIZE
+                 + i * BLOCK_STORE_INDEX_RECORD_SIZE);
+    }
+
+    retval = VCTOOL_STATUS_SUCCESS;
+
+cleanup_data:
+    free(data);
+
+    return retval;
+}
+
+/**
+ * \brief Map every segment named by the index.
+ *
+ * A missing segment ends the mapped segments; the blocks in it and after it
+ * are dropped by the caller. The last segment of a writable store is kept open
+ * for appending.
+ *
+ * \param store             The store, with its index read.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int block_store_map_segments(block_store* store)
+{
+    int retval, fd;
+    char* path;
+    uint64_t needed = 0;
+
+    for (size_t i = 0; i < store->count; ++i)
+    {
+        if ((uint64_t)store->entries[i].segment + 1 > needed)
+        {
+            needed = (uint64_t)store->entries[i].segment + 1;
+        }
+    }
+
+    for (uint64_t segment = 0; segment < needed; ++segment)
+    {
+        retval =
+            block_store_segment_path(
+                &path, store->dirname, (uint32_t)segment);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        retval =
+            file_open(
+                store->f, &fd, path, store->writable ? O_RDWR : O_RDONLY, 0);
+        free(path);
+        if (VCTOOL_ERROR_FILE_NO_ENTRY == retval)
+        {
+            break;
+        }
+        else if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        retval = block_store_segment_map(store, fd);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            file_close(store->f, fd);
+            return retval;
+        }
+
+        /* keep the last segment of a writable store open. */
+        if (store->writable)
+        {
+            if (store->segment_fd >= 0)
+            {
+                file_close(store->f, store->segment_fd);
+            }
+
+            store->segment_fd = fd;
+        }
+        else
+        {
+            file_close(store->f, fd);
+        }
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Compare two entries by height.
+ */
+static int block_store_compare_height(const void* lhs, const void* rhs)
+{
+    const block_store_entry* l = (const block_store_entry*)lhs;
+    const block_store_entry* r = (const block_store_entry*)rhs;
+
+    return (l->height > r->height) - (l->height < r->height);
+}
@@ -0,0 +1,51 @@
+/**
+ * \file lib/block_store/block_store_path.c
+ *
+ * \brief Build the path of a file in a block store.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vctool/status_codes.h>
+
+#include "block_store_internal.h"
+
+/**
+ * \brief Build the path of a file in a block store.
+ *
+ * \param path              Pointer to receive the path, which the caller must
+ *                          free.
+ * \param dirname           The store directory.
+ * \param name              The name of the file.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY if the path can't be allocated.
+ */
+int block_store_path(char** path, const char* dirname, const char* name)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != path);
+    MODEL_ASSERT(NULL != dirname);
+    MODEL_ASSERT(NULL != name);
+
+    size_t path_size =
+        strlen(dirname)
+      + 1 /* / */
+      + strlen(name)
+      + 1;/* asciiz */
+
+    *path = (char*)malloc(path_size);
+    if (NULL == *path)
+    {
+        return VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    snprintf(*path, path_size, "%s/%s", dirname, name);
+
+    return VCTOOL_STATUS_SUCCESS;
+}
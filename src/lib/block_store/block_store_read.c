@@ -0,0 +1,52 @@
+/**
+ * \file lib/block_store/block_store_read.c
+ *
+ * \brief Get a block from a block store in place.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/status_codes.h>
+
+#include "block_store_internal.h"
+
+/**
+ * \brief Get a block in place.
+ *
+ * \param block             Pointer to receive the block, which is valid until
+ *                          the store is closed.
+ * \param store             The store.
+ * \param entry             The entry of the block.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_BLOCK_STORE_BAD_INDEX if the entry is not in a mapped
+ *        segment.
+ */
+int block_store_read(
+    const uint8_t** block, const block_store* store,
+    const block_store_entry* entry)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != block);
+    MODEL_ASSERT(NULL != store);
+    MODEL_ASSERT(NULL != entry);
+
+    if (entry->segment >= store->segment_count)
+    {
+        return VCTOOL_ERROR_BLOCK_STORE_BAD_INDEX;
+    }
+
+    const block_store_segment* segment = &store->segments[entry->segment];
+    if (NULL == segment->map
+     || entry->offset > segment->file_size
+     || entry->size > segment->file_size - entry->offset)
+    {
+        return VCTOOL_ERROR_BLOCK_STORE_BAD_INDEX;
+    }
+
+    *block = segment->map + entry->offset;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
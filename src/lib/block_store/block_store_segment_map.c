@@ -0,0 +1,83 @@
+/**
+ * \file lib/block_store/block_store_segment_map.c
+ *
+ * \brief Map the next segment of a block store.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <vctool/status_codes.h>
+
+#include "block_store_internal.h"
+
+/**
+ * \brief Map the next segment of a store.
+ *
+ * The segment of a writable store is mapped at the segment size limit, so
+ * that blocks appended to it later can be read without remapping; otherwise it
+ * is mapped at its file size.
+ *
+ * \param store             The store; its segment count is incremented on
+ *                          success.
+ * \param fd                The open segment file.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code from the file interface if the segment can't
+ *        be mapped.
+ *      - VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY if the segment array can't grow.
+ */
+int block_store_segment_map(block_store* store, int fd)
+{
+    int retval;
+    file_stat_st fst;
+    block_store_segment* segment;
+    const void* map;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != store);
+    MODEL_ASSERT(fd >= 0);
+
+    retval = file_fstat(store->f, fd, &fst);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* grow the segment array. */
+    block_store_segment* segments =
+        (block_store_segment*)realloc(
+            store->segments,
+            (store->segment_count + 1) * sizeof(block_store_segment));
+    if (NULL == segments)
+    {
+        return VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    store->segments = segments;
+    segment = &store->segments[store->segment_count];
+    segment->map = NULL;
+    segment->map_size =
+        (store->writable && store->segment_max_size > (uint64_t)fst.fst_size)
+            ? (size_t)store->segment_max_size
+            : (size_t)fst.fst_size;
+    segment->file_size = (uint64_t)fst.fst_size;
+
+    /* an empty segment of a read-only store is not mapped. */
+    if (segment->map_size > 0)
+    {
+        retval = file_mmap(store->f, fd, segment->map_size, &map);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        segment->map = (const uint8_t*)map;
+    }
+
+    ++store->segment_count;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
@@ -0,0 +1,42 @@
+/**
+ * \file lib/block_store/block_store_segment_path.c
+ *
+ * \brief Build the path of a block store segment file.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <vctool/status_codes.h>
+
+#include "block_store_internal.h"
+
+/**
+ * \brief Build the path of a segment file.
+ *
+ * Segments are named for their number in hex, such as segment-00000000.
+ *
+ * \param path              Pointer to receive the path, which the caller must
+ *                          free.
+ * \param dirname           The store directory.
+ * \param segment           The segment number.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY if the path can't be allocated.
+ */
+int block_store_segment_path(
+    char** path, const char* dirname, uint32_t segment)
+{
+    char name[32];
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != path);
+    MODEL_ASSERT(NULL != dirname);
+
+    snprintf(name, sizeof(name), "segment-%08" PRIx32, segment);
+
+    return block_store_path(path, dirname, name);
+}
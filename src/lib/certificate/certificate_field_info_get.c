@@ -0,0 +1,88 @@
+/**
+ * \file certificate/certificate_field_info_get.c
+ *
+ * \brief Get the name and display format of a certificate field type.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <stddef.h>
+#include <vccert/fields.h>
+#include <vctool/certificate.h>
+
+/* the known field types are numbered densely, so they are indexed by type. */
+static const certificate_field_info certificate_field_infos[] = {
+    [VCCERT_FIELD_TYPE_ARTIFACT_ID] =
+        { "artifact_id", CERTIFICATE_FIELD_FORMAT_UUID },
+    [VCCERT_FIELD_TYPE_PUBLIC_ENCRYPTION_KEY] =
+        { "public_encryption_key", CERTIFICATE_FIELD_FORMAT_HEX },
+    [VCCERT_FIELD_TYPE_PUBLIC_SIGNING_KEY] =
+        { "public_signing_key", CERTIFICATE_FIELD_FORMAT_HEX },
+    [VCCERT_FIELD_TYPE_PRIVATE_SIGNING_KEY] =
+        { "private_signing_key", CERTIFICATE_FIELD_FORMAT_HEX },
+    [VCCERT_FIELD_TYPE_PRIVATE_ENCRYPTION_KEY] =
+        { "private_encryption_key", CERTIFICATE_FIELD_FORMAT_HEX },
+    [VCCERT_FIELD_TYPE_VELO_ENDORSEMENT] =
+        { "velo_endorsement", CERTIFICATE_FIELD_FORMAT_UUID },
+    [VCCERT_FIELD_TYPE_SIGNER_ID] =
+        { "signer_id", CERTIFICATE_FIELD_FORMAT_UUID },
+    [VCCERT_FIELD_TYPE_SIGNATURE] =
+        { "signature", CERTIFICATE_FIELD_FORMAT_HEX },
+    [VCCERT_FIELD_TYPE_CERTIFICATE_VERSION] =
+        { "certificate_version", CERTIFICATE_FIELD_FORMAT_UINT },
+    [VCCERT_FIELD_TYPE_CERTIFICATE_VALID_FROM] =
+        { "certificate_valid_from", CERTIFICATE_FIELD_FORMAT_UINT },
+    [VCCERT_FIELD_TYPE_CERTIFICATE_CRYPTO_SUITE] =
+        { "certificate_crypto_suite", CERTIFICATE_FIELD_FORMAT_UINT },
+    [VCCERT_FIELD_TYPE_CERTIFICATE_TYPE] =
+        { "certificate_type", CERTIFICATE_FIELD_FORMAT_UUID },
+    [VCCERT_FIELD_TYPE_CERTIFICATE_ID] =
+        { "certificate_id", CERTIFICATE_FIELD_FORMAT_UUID },
+    [VCCERT_FIELD_TYPE_PREVIOUS_CERTIFICATE_ID] =
+        { "previous_certificate_id", CERTIFICATE_FIELD_FORMAT_UUID },
+    [VCCERT_FIELD_TYPE_TRANSACTION_TYPE] =
+        { "transaction_type", CERTIFICATE_FIELD_FORMAT_UUID },
+    [VCCERT_FIELD_TYPE_PREVIOUS_ARTIFACT_STATE] =
+        { "previous_artifact_state", CERTIFICATE_FIELD_FORMAT_UINT },
+    [VCCERT_FIELD_TYPE_NEW_ARTIFACT_STATE] =
+        { "new_artifact_state", CERTIFICATE_FIELD_FORMAT_UINT },
+    [VCCERT_FIELD_TYPE_ARTIFACT_TYPE] =
+        { "artifact_type", CERTIFICATE_FIELD_FORMAT_UUID },
+    [VCCERT_FIELD_TYPE_BLOCK_HEIGHT] =
+        { "block_height", CERTIFICATE_FIELD_FORMAT_UINT },
+    [VCCERT_FIELD_TYPE_PREVIOUS_BLOCK_UUID] =
+        { "previous_block_uuid", CERTIFICATE_FIELD_FORMAT_UUID },
+    [VCCERT_FIELD_TYPE_WRAPPED_TRANSACTION_TUPLE] =
+        { "wrapped_transaction_tuple", CERTIFICATE_FIELD_FORMAT_HEX },
+    [VCCERT_FIELD_TYPE_BLOCK_UUID] =
+        { "block_uuid", CERTIFICATE_FIELD_FORMAT_UUID },
+    [VCCERT_FIELD_TYPE_ENTITY_NAME] =
+        { "entity_name", CERTIFICATE_FIELD_FORMAT_STRING },
+    [VCCERT_FIELD_TYPE_CERTIFICATE_SUITE] =
+        { "certificate_suite", CERTIFICATE_FIELD_FORMAT_UINT },
+    [VCCERT_FIELD_TYPE_SIGNER_NAME] =
+        { "signer_name", CERTIFICATE_FIELD_FORMAT_STRING },
+    [VCCERT_FIELD_TYPE_SIGNATURE_METHOD] =
+        { "signature_method", CERTIFICATE_FIELD_FORMAT_UINT },
+};
+
+#define CERTIFICATE_FIELD_INFO_COUNT \
+    (sizeof(certificate_field_infos) / sizeof(certificate_field_infos[0]))
+
+/**
+ * \brief Get the name and display format of a certificate field type.
+ *
+ * \param field_type        The field type.
+ *
+ * \returns the field info, or NULL if this field type is not known.
+ */
+const certificate_field_info* certificate_field_info_get(uint16_t field_type)
+{
+    if (field_type >= CERTIFICATE_FIELD_INFO_COUNT
+     || NULL == certificate_field_infos[field_type].name)
+    {
+        return NULL;
+    }
+
+    return &certificate_field_infos[field_type];
+}
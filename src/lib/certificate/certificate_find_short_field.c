@@ -0,0 +1,80 @@
+/**
+ * \file certificate/certificate_find_short_field.c
+ *
+ * \brief Find a field in a certificate by scanning the field headers.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/certificate.h>
+#include <vctool/status_codes.h>
+
+/* each field header is a two byte type followed by a two byte size. */
+#define FIELD_HEADER_SIZE 4
+
+/**
+ * \brief Find the first field of the given type in a certificate without
+ * creating a parser.
+ *
+ * \param value             Pointer to receive a pointer to the field value,
+ *                          which points into \p cert.
+ * \param value_size        Pointer to receive the size of the field value.
+ * \param cert              The certificate to scan.
+ * \param cert_size         The size of the certificate.
+ * \param field_type        The field type to find.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_NOT_FOUND if there is no such field.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED if the certificate is
+ *        malformed.
+ */
+int certificate_find_short_field(
+    const uint8_t** value, size_t* value_size, const void* cert,
+    size_t cert_size, uint16_t field_type)
+{
+    const uint8_t* bcert = (const uint8_t*)cert;
+    size_t offset = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != value);
+    MODEL_ASSERT(NULL != value_size);
+    MODEL_ASSERT(NULL != cert);
+
+    /* walk the field headers. */
+    while (offset < cert_size)
+    {
+        /* verify that the header fits. */
+        if (cert_size - offset < FIELD_HEADER_SIZE)
+        {
+            return VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED;
+        }
+
+        /* decode the field type and size from network byte order. */
+        uint16_t type = (uint16_t)((bcert[offset] << 8) | bcert[offset + 1]);
+        size_t size = (size_t)((bcert[offset + 2] << 8) | bcert[offset + 3]);
+        offset += FIELD_HEADER_SIZE;
+
+        /* verify that the value fits. */
+        if (cert_size - offset < size)
+        {
+            return VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED;
+        }
+
+        /* is this the field we're looking for? */
+        if (type == field_type)
+        {
+            *value = bcert + offset;
+            *value_size = size;
+
+            return VCTOOL_STATUS_SUCCESS;
+        }
+
+        /* skip to the next field. */
+        offset += size;
+    }
+
+    return VCTOOL_ERROR_CERTIFICATE_FIELD_NOT_FOUND;
+}
@@ -0,0 +1,88 @@
+/**
+ * \file certificate/certificate_find_signature.c
+ *
+ * \brief Find the signature of a signed certificate.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vccert/fields.h>
+#include <vctool/certificate.h>
+#include <vctool/status_codes.h>
+
+/* each field header is a two byte type followed by a two byte size. */
+#define FIELD_HEADER_SIZE 4
+
+/**
+ * \brief Find the signature of a signed certificate.
+ *
+ * The signature must be the last field of the certificate. Everything before
+ * its field header is covered by the signature.
+ *
+ * \param signed_size       Pointer to receive the size of the signed data.
+ * \param signature         Pointer to receive a pointer to the signature,
+ *                          which points into \p cert.
+ * \param signature_size    Pointer to receive the size of the signature.
+ * \param cert              The certificate to scan.
+ * \param cert_size         The size of the certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_NOT_FOUND if the last field is not a
+ *        signature.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED if the certificate is
+ *        malformed.
+ */
+int certificate_find_signature(
+    size_t* signed_size, const uint8_t** signature, size_t* signature_size,
+    const void* cert, size_t cert_size)
+{
+    const uint8_t* bcert = (const uint8_t*)cert;
+    size_t offset = 0;
+    size_t last = cert_size;
+    uint16_t last_type = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != signed_size);
+    MODEL_ASSERT(NULL != signature);
+    MODEL_ASSERT(NULL != signature_size);
+    MODEL_ASSERT(NULL != cert);
+
+    /* walk the field headers to find the last field. */
+    while (offset < cert_size)
+    {
+        /* verify that the header fits. */
+        if (cert_size - offset < FIELD_HEADER_SIZE)
+        {
+            return VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED;
+        }
+
+        /* decode the field type and size from network byte order. */
+        uint16_t type = (uint16_t)((bcert[offset] << 8) | bcert[offset + 1]);
+        size_t size = (size_t)((bcert[offset + 2] << 8) | bcert[offset + 3]);
+
+        /* verify that the value fits. */
+        if (cert_size - offset - FIELD_HEADER_SIZE < size)
+        {
+            return VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED;
+        }
+
+        last = offset;
+        last_type = type;
+        offset += FIELD_HEADER_SIZE + size;
+    }
+
+    /* the last field must be the signature. */
+    if (last == cert_size || VCCERT_FIELD_TYPE_SIGNATURE != last_type)
+    {
+        return VCTOOL_ERROR_CERTIFICATE_FIELD_NOT_FOUND;
+    }
+
+    *signed_size = last;
+    *signature = bcert + last + FIELD_HEADER_SIZE;
+    *signature_size = cert_size - last - FIELD_HEADER_SIZE;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
@@ -0,0 +1,71 @@
+/**
+ * \file certificate/certificate_next_field.c
+ *
+ * \brief Read a certificate field and advance to the next field.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/certificate.h>
+#include <vctool/status_codes.h>
+
+/* each field header is a two byte type followed by a two byte size. */
+#define FIELD_HEADER_SIZE 4
+
+/**
+ * \brief Read the certificate field at the given offset, and advance the
+ * offset to the next field.
+ *
+ * \param field_type        Pointer to receive the field type.
+ * \param value             Pointer to receive a pointer to the field value,
+ *                          which points into \p cert.
+ * \param value_size        Pointer to receive the size of the field value.
+ * \param offset            The offset of the field to read, which is updated
+ *                          to the offset of the next field on success.
+ * \param cert              The certificate to scan.
+ * \param cert_size         The size of the certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED if the certificate is
+ *        malformed.
+ */
+int certificate_next_field(
+    uint16_t* field_type, const uint8_t** value, size_t* value_size,
+    size_t* offset, const void* cert, size_t cert_size)
+{
+    const uint8_t* bcert = (const uint8_t*)cert;
+    size_t pos = *offset;
+    size_t size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != field_type);
+    MODEL_ASSERT(NULL != value);
+    MODEL_ASSERT(NULL != value_size);
+    MODEL_ASSERT(NULL != offset);
+    MODEL_ASSERT(NULL != cert);
+
+    /* verify that the header fits. */
+    if (pos > cert_size || cert_size - pos < FIELD_HEADER_SIZE)
+    {
+        return VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED;
+    }
+
+    /* decode the field type and size from network byte order. */
+    size = (size_t)((bcert[pos + 2] << 8) | bcert[pos + 3]);
+
+    /* verify that the value fits. */
+    if (cert_size - pos - FIELD_HEADER_SIZE < size)
+    {
+        return VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED;
+    }
+
+    *field_type = (uint16_t)((bcert[pos] << 8) | bcert[pos + 1]);
+    *value = bcert + pos + FIELD_HEADER_SIZE;
+    *value_size = size;
+    *offset = pos + FIELD_HEADER_SIZE + size;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
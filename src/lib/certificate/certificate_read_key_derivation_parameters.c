@@ -0,0 +1,98 @@
+/**
+ * \file certificate/certificate_read_key_derivation_parameters.c
+ *
+ * \brief Read the key derivation parameters from an encrypted certificate.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <arpa/inet.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vccrypt/compare.h>
+#include <vctool/certificate.h>
+#include <vctool/commandline.h>
+
+/**
+ * \brief Read the salt and number of key derivation rounds from an encrypted
+ * certificate.
+ *
+ * \param suite             The crypto suite used to encrypt the certificate.
+ * \param salt              Pointer to a vccrypt buffer to be initialized with
+ *                          the salt. On success, the caller owns this buffer
+ *                          and must dispose it.
+ * \param rounds            Pointer to receive the number of key derivation
+ *                          rounds.
+ * \param encrypted_cert    The encrypted certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int certificate_read_key_derivation_parameters(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* salt,
+    unsigned int* rounds, const vccrypt_buffer_t* encrypted_cert)
+{
+    int retval;
+    uint32_t net_rounds;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != salt);
+    MODEL_ASSERT(NULL != rounds);
+    MODEL_ASSERT(NULL != encrypted_cert);
+
+    /* create the buffer for holding the salt. */
+    /* TODO - replace with suite method. */
+    retval =
+        vccrypt_buffer_init(
+            salt, suite->alloc_opts, suite->stream_cipher_opts.key_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* compute the size of the header holding these parameters. */
+    size_t header_size =
+          ENCRYPTED_CERT_MAGIC_SIZE             /* "ENC" */
+        + sizeof(uint32_t)                      /* number of rounds in key. */
+        + salt->size;                           /* the salt. */
+
+    /* verify that the cert is at least this size. */
+    if (encrypted_cert->size < header_size)
+    {
+        retval = VCTOOL_ERROR_CERTIFICATE_NOT_MINIMUM_SIZE;
+        goto cleanup_salt;
+    }
+
+    /* get a byte pointer to the certificate buffer. */
+    const uint8_t* bcert = (const uint8_t*)encrypted_cert->data;
+
+    /* verify that the first three bytes are the magic. */
+    if (
+        crypto_memcmp(
+            bcert, ENCRYPTED_CERT_MAGIC_STRING, ENCRYPTED_CERT_MAGIC_SIZE))
+    {
+        retval = VCTOOL_ERROR_CERTIFICATE_VERIFICATION;
+        goto cleanup_salt;
+    }
+    bcert += ENCRYPTED_CERT_MAGIC_SIZE;
+
+    /* get the number of rounds. */
+    memcpy(&net_rounds, bcert, sizeof(net_rounds));
+    *rounds = ntohl(net_rounds);
+    bcert += sizeof(net_rounds);
+
+    /* copy the salt to the salt buffer. */
+    memcpy(salt->data, bcert, salt->size);
+
+    /* success. The caller owns the salt buffer on success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto done;
+
+cleanup_salt:
+    dispose((disposable_t*)salt);
+
+done:
+    return retval;
+}
@@ -0,0 +1,78 @@
+/**
+ * \file certificate/certificate_stream_next.c
+ *
+ * \brief Find the next certificate in a stream of signed certificates.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vccert/fields.h>
+#include <vctool/certificate.h>
+#include <vctool/status_codes.h>
+
+/**
+ * \brief Find the next signed certificate in a stream of concatenated signed
+ * certificates.
+ *
+ * Each certificate ends with its signature field. The last certificate has
+ * been read when \p offset reaches \p stream_size.
+ *
+ * \param cert              Pointer to receive a pointer to the certificate,
+ *                          which points into \p stream.
+ * \param cert_size         Pointer to receive the size of the certificate.
+ * \param offset            The offset of the certificate to read, which is
+ *                          updated to the offset of the next certificate on
+ *                          success.
+ * \param stream            The concatenated certificates.
+ * \param stream_size       The size of the stream.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_NOT_FOUND if the stream ends before a
+ *        signature field.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED if a certificate is
+ *        malformed.
+ */
+int certificate_stream_next(
+    const uint8_t** cert, size_t* cert_size, size_t* offset,
+    const void* stream, size_t stream_size)
+{
+    int retval;
+    uint16_t field_type;
+    const uint8_t* value;
+    size_t value_size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != cert);
+    MODEL_ASSERT(NULL != cert_size);
+    MODEL_ASSERT(NULL != offset);
+    MODEL_ASSERT(NULL != stream);
+
+    size_t start = *offset;
+    size_t end = start;
+
+    /* walk the fields up to and including the signature. */
+    while (end < stream_size)
+    {
+        retval =
+            certificate_next_field(
+                &field_type, &value, &value_size, &end, stream, stream_size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        if (VCCERT_FIELD_TYPE_SIGNATURE == field_type)
+        {
+            *cert = (const uint8_t*)stream + start;
+            *cert_size = end - start;
+            *offset = end;
+
+            return VCTOOL_STATUS_SUCCESS;
+        }
+    }
+
+    return VCTOOL_ERROR_CERTIFICATE_FIELD_NOT_FOUND;
+}
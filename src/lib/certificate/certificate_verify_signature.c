@@ -0,0 +1,103 @@
+/**
+ * \file certificate/certificate_verify_signature.c
+ *
+ * \brief Verify the signature of a signed certificate.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/certificate.h>
+#include <vctool/status_codes.h>
+
+/**
+ * \brief Verify the signature of a signed certificate with the given public
+ * signing key.
+ *
+ * This creates its own signature algorithm instance, so it is safe to call from
+ * a worker thread.
+ *
+ * \param suite             The crypto suite to use for this operation.
+ * \param cert              The certificate to verify.
+ * \param cert_size         The size of the certificate.
+ * \param public_key        The public signing key of the signer.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_CERTIFICATE_BAD_SIGNATURE if the signature is invalid.
+ *      - a non-zero error code on failure.
+ */
+int certificate_verify_signature(
+    vccrypt_suite_options_t* suite, const void* cert, size_t cert_size,
+    const vccrypt_buffer_t* public_key)
+{
+    int retval;
+    size_t signed_size;
+    const uint8_t* signature;
+    size_t signature_size;
+    vccrypt_buffer_t signature_buffer;
+    vccrypt_digital_signature_context_t sign;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != cert);
+    MODEL_ASSERT(NULL != public_key);
+
+    /* find the signature. */
+    retval =
+        certificate_find_signature(
+            &signed_size, &signature, &signature_size, cert, cert_size);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* the signature must be the size used by this suite. */
+    if (signature_size != suite->sign_opts.signature_size)
+    {
+        retval = VCTOOL_ERROR_CERTIFICATE_BAD_SIGNATURE;
+        goto done;
+    }
+
+    /* create a buffer for the signature. */
+    retval =
+        vccrypt_suite_buffer_init_for_signature(suite, &signature_buffer);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    memcpy(signature_buffer.data, signature, signature_size);
+
+    /* create the signing algorithm instance. */
+    retval = vccrypt_suite_digital_signature_init(suite, &sign);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_signature_buffer;
+    }
+
+    /* verify the signature over everything before the signature field. */
+    retval =
+        vccrypt_digital_signature_verify(
+            &sign, &signature_buffer, public_key, (const uint8_t*)cert,
+            signed_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        retval = VCTOOL_ERROR_CERTIFICATE_BAD_SIGNATURE;
+        goto cleanup_sign;
+    }
+
+    /* success. */
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_sign;
+
+cleanup_sign:
+    dispose((disposable_t*)&sign);
+
+cleanup_signature_buffer:
+    dispose((disposable_t*)&signature_buffer);
+
+done:
+    return retval;
+}
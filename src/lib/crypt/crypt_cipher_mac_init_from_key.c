@@ -0,0 +1,63 @@
+/**
+ * \file crypt/crypt_cipher_mac_init_from_key.c
+ *
+ * \brief Create a stream cipher and mac from a derived key.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/crypt.h>
+
+/**
+ * \brief Initialize a cipher and mac instance from a suite and a previously
+ * derived key.
+ *
+ * \param cipher            The stream cipher instance to initialize.
+ * \param mac               The mac instance to initialize.
+ * \param suite             The crypto suite to use to initialize these
+ *                          instances.
+ * \param derived_key       The derived key to use for these instances.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int crypt_cipher_mac_init_from_key(
+    vccrypt_stream_context_t* cipher, vccrypt_mac_context_t* mac,
+    vccrypt_suite_options_t* suite, const vccrypt_buffer_t* derived_key)
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != cipher);
+    MODEL_ASSERT(NULL != mac);
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != derived_key);
+
+    /* create the mac instance. */
+    retval = vccrypt_suite_mac_init(suite, mac, derived_key);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* create the stream cipher instance. */
+    retval = vccrypt_suite_stream_init(suite, cipher, derived_key);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mac;
+    }
+
+    /* success. */
+    retval = VCCRYPT_STATUS_SUCCESS;
+
+    /* don't clean up cipher or mac, as the caller owns them on succes. */
+    goto done;
+
+cleanup_mac:
+    dispose((disposable_t*)mac);
+
+done:
+    return retval;
+}
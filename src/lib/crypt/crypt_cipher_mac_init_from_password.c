@@ -33,7 +33,6 @@ int crypt_cipher_mac_init_from_password(
 {
     int retval;
     vccrypt_buffer_t derived_key;
-    vccrypt_key_derivation_context_t key_derivation;
 
     /* parameter sanity checks. */
     MODEL_ASSERT(NULL != cipher);
@@ -42,58 +41,25 @@ int crypt_cipher_mac_init_from_password(
     MODEL_ASSERT(NULL != password);
     MODEL_ASSERT(NULL != salt);
 
-    /* create a buffer for holding the derived key. */
-    /* TODO - replace with suite method. */
+    /* derive the key. */
     retval =
-        vccrypt_buffer_init(
-            &derived_key, suite->alloc_opts,
-            suite->stream_cipher_opts.key_size);
+        crypt_derive_key_from_password(
+            &derived_key, suite, password, salt, rounds);
     if (VCCRYPT_STATUS_SUCCESS != retval)
     {
         goto done;
     }
 
-    /* create key derivation instance. */
-    retval = vccrypt_suite_key_derivation_init(&key_derivation, suite);
+    /* create the mac and cipher instances, owned by the caller on success. */
+    retval = crypt_cipher_mac_init_from_key(cipher, mac, suite, &derived_key);
     if (VCCRYPT_STATUS_SUCCESS != retval)
     {
         goto cleanup_derived_key;
     }
 
-    /* derive the key. */
-    retval =
-        vccrypt_key_derivation_derive_key(
-            &derived_key, &key_derivation, password, salt, rounds);
-    if (VCCRYPT_STATUS_SUCCESS != retval)
-    {
-        goto cleanup_key_derivation;
-    }
-
-    /* create the mac instance. */
-    retval = vccrypt_suite_mac_init(suite, mac, &derived_key);
-    if (VCCRYPT_STATUS_SUCCESS != retval)
-    {
-        goto cleanup_key_derivation;
-    }
-
-    /* create the stream cipher instance. */
-    retval = vccrypt_suite_stream_init(suite, cipher, &derived_key);
-    if (VCCRYPT_STATUS_SUCCESS != retval)
-    {
-        goto cleanup_mac;
-    }
-
     /* success. */
     retval = VCCRYPT_STATUS_SUCCESS;
-
-    /* don't clean up cipher or mac, as the caller owns them on succes. */
-    goto cleanup_key_derivation;
-
-cleanup_mac:
-    dispose((disposable_t*)mac);
-
-cleanup_key_derivation:
-    dispose((disposable_t*)&key_derivation);
+    /* fall-through. */
 
 cleanup_derived_key:
     dispose((disposable_t*)&derived_key);
@@ -0,0 +1,83 @@
+/**
+ * \file crypt/crypt_derive_key_from_password.c
+ *
+ * \brief Derive a symmetric key from a password.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/crypt.h>
+
+/**
+ * \brief Derive a symmetric key from a password, salt, and number of key
+ * derivation rounds.
+ *
+ * \param derived_key       The buffer to be initialized with the derived key.
+ *                          On success, the caller owns this buffer and must
+ *                          dispose it.
+ * \param suite             The crypto suite to use to derive this key.
+ * \param password          The password to use for deriving the private key.
+ * \param salt              The salt to use for deriving the private key.
+ * \param rounds            The number of rounds to use to derive the private
+ *                          key.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int crypt_derive_key_from_password(
+    vccrypt_buffer_t* derived_key, vccrypt_suite_options_t* suite,
+    const vccrypt_buffer_t* password, const vccrypt_buffer_t* salt,
+    unsigned int rounds)
+{
+    int retval;
+    vccrypt_key_derivation_context_t key_derivation;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != derived_key);
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != password);
+    MODEL_ASSERT(NULL != salt);
+
+    /* create a buffer for holding the derived key. */
+    /* TODO - replace with suite method. */
+    retval =
+        vccrypt_buffer_init(
+            derived_key, suite->alloc_opts,
+            suite->stream_cipher_opts.key_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* create key derivation instance. */
+    retval = vccrypt_suite_key_derivation_init(&key_derivation, suite);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_derived_key;
+    }
+
+    /* derive the key. */
+    retval =
+        vccrypt_key_derivation_derive_key(
+            derived_key, &key_derivation, password, salt, rounds);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_key_derivation;
+    }
+
+    /* success. The caller owns the derived key on success. */
+    dispose((disposable_t*)&key_derivation);
+    retval = VCCRYPT_STATUS_SUCCESS;
+    goto done;
+
+cleanup_key_derivation:
+    dispose((disposable_t*)&key_derivation);
+
+cleanup_derived_key:
+    dispose((disposable_t*)derived_key);
+
+done:
+    return retval;
+}
@@ -11,6 +11,7 @@
 #include <string.h>
 #include <rcpr/compare.h>
 #include <vctool/endorse.h>
+#include <vctool/status_codes.h>
 #include <vpr/parameters.h>
 
 RCPR_IMPORT_allocator_as(rcpr);
@@ -26,6 +27,14 @@ RCPR_IMPORT_resource;
     context->set_error(context, (s)); \
     return NULL
 
+/**
+ * \brief Helper macro for passing an out of memory condition to the caller and
+ * breaking out of the parse.
+ */
+#define CONFIG_OUT_OF_MEMORY(s) \
+    context->out_of_memory = true; \
+    CONFIG_ERROR(s)
+
 /**
  * \brief Helper macro for breaking out of the parse if a NULL pointer is
  * returned by the helper method.
@@ -37,8 +46,14 @@ RCPR_IMPORT_resource;
         (lhs) = x; \
     } while (false)
 
+/**
+ * \brief The parser reads tokens through the endorse_lex dispatcher, which
+ * selects either the flex scanner or the mapped source scanner.
+ */
+#define yylex endorse_lex
+
 /* forward decls */
-int yylex();
+int endorse_lex(YYSTYPE*, yyscan_t);
 int yyerror(
     yyscan_t scanner, endorse_config_context* context, const char*);
 static endorse_config* new_endorse_config(endorse_config_context* context);
@@ -69,6 +84,10 @@ static rbtree* new_roles(endorse_config_context*);
 static endorse_verb* new_verb(
     endorse_config_context*, const char*, const vpr_uuid*);
 static status verb_resource_release(resource* r);
+static status merge_declared_entity(
+    endorse_config_context*, endorse_config*, endorse_entity*);
+static status merge_referenced_entity(
+    endorse_config_context*, endorse_config*, endorse_entity*);
 static endorse_config* merge_verb_entity(
     endorse_config_context*, endorse_config*, endorse_entity*);
 static status merge_verbs(
@@ -130,7 +149,6 @@ static status role_verb_resource_release(resource* r);
 %destructor { resource_release(rbtree_resource_handle($$)); } <entities>
 %destructor { resource_release(&$$->hdr); } <entity>
 %destructor { memset($$, 0, sizeof(*$$)); free($$); } <id>
-%destructor { free($$); } <string>
 %destructor { resource_release(rbtree_resource_handle($$)); } <verbs>
 %destructor { resource_release(rbtree_resource_handle($$)); } <roles>
 %destructor { resource_release(rbtree_resource_handle($$)); } <role_verbs>
@@ -222,6 +240,7 @@ static endorse_config* new_endorse_config(endorse_config_context* context)
         rcpr_allocator_allocate(context->alloc, (void**)&cfg, sizeof(*cfg));
     if (STATUS_SUCCESS != retval)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory in new_endorse_config().";
         goto error_exit;
     }
@@ -236,6 +255,7 @@ static endorse_config* new_endorse_config(endorse_config_context* context)
     cfg->entities = new_entities(context);
     if (NULL == cfg->entities)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory creating entities tree.";
         goto cleanup_cfg;
     }
@@ -306,6 +326,13 @@ static rcpr_comparison_result endorse_entities_compare(
     const char* l = (const char*)lhs;
     const char* r = (const char*)rhs;
 
+    /* an identifier interned in one context is one symbol, but merged
+     * configs come from other contexts, so equal strings are still equal. */
+    if (l == r)
+    {
+        return RCPR_COMPARE_EQ;
+    }
+
     int result = strcmp(l, r);
     if (result < 0)
     {
@@ -341,6 +368,13 @@ static rcpr_comparison_result endorse_verbs_compare(
     const char* l = (const char*)lhs;
     const char* r = (const char*)rhs;
 
+    /* an identifier interned in one context is one symbol, but merged
+     * configs come from other contexts, so equal strings are still equal. */
+    if (l == r)
+    {
+        return RCPR_COMPARE_EQ;
+    }
+
     int result = strcmp(l, r);
     if (result < 0)
     {
@@ -428,7 +462,7 @@ static rbtree* new_entities(endorse_config_context* context)
             &endorse_entities_key, NULL);
     if (STATUS_SUCCESS != retval)
     {
-        CONFIG_ERROR("Out of memory creating entities tree.");
+        CONFIG_OUT_OF_MEMORY("Out of memory creating entities tree.");
     }
 
     return entities;
@@ -449,7 +483,7 @@ static rbtree* new_role_verbs(endorse_config_context* context)
             &endorse_role_verbs_key, NULL);
     if (STATUS_SUCCESS != retval)
     {
-        CONFIG_ERROR("Out of memory creating role_verbs tree.");
+        CONFIG_OUT_OF_MEMORY("Out of memory creating role_verbs tree.");
     }
 
     return role_verbs;
@@ -464,6 +498,13 @@ static rcpr_comparison_result endorse_role_verbs_compare(
     const char* l = (const char*)lhs;
     const char* r = (const char*)rhs;
 
+    /* an identifier interned in one context is one symbol, but merged
+     * configs come from other contexts, so equal strings are still equal. */
+    if (l == r)
+    {
+        return RCPR_COMPARE_EQ;
+    }
+
     int result = strcmp(l, r);
     if (result < 0)
     {
@@ -505,7 +546,7 @@ static rbtree* new_roles(endorse_config_context* context)
             &endorse_roles_key, NULL);
     if (STATUS_SUCCESS != retval)
     {
-        CONFIG_ERROR("Out of memory creating roles tree.");
+        CONFIG_OUT_OF_MEMORY("Out of memory creating roles tree.");
     }
 
     return roles;
@@ -520,6 +561,13 @@ static rcpr_comparison_result endorse_roles_compare(
     const char* l = (const char*)lhs;
     const char* r = (const char*)rhs;
 
+    /* an identifier interned in one context is one symbol, but merged
+     * configs come from other contexts, so equal strings are still equal. */
+    if (l == r)
+    {
+        return RCPR_COMPARE_EQ;
+    }
+
     int result = strcmp(l, r);
     if (result < 0)
     {
@@ -561,7 +609,7 @@ static rbtree* new_verbs(endorse_config_context* context)
             &endorse_verbs_key, NULL);
     if (STATUS_SUCCESS != retval)
     {
-        CONFIG_ERROR("Out of memory creating verbs tree.");
+        CONFIG_OUT_OF_MEMORY("Out of memory creating verbs tree.");
     }
 
     return verbs;
@@ -584,6 +632,7 @@ static rbtree* add_entity(
     verbs = new_verbs(context);
     if (NULL == verbs)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory creating entity verb tree in add_entity";
         goto error_exit;
     }
@@ -592,6 +641,7 @@ static rbtree* add_entity(
     roles = new_roles(context);
     if (NULL == roles)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory creating roles tree in add_entity";
         goto cleanup_verbs;
     }
@@ -600,6 +650,7 @@ static rbtree* add_entity(
     entity = new_entity(context, id, verbs, roles, is_decl);
     if (NULL == entity)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory creating entity in add_entity.";
         goto cleanup_roles;
     }
@@ -614,6 +665,7 @@ static rbtree* add_entity(
     retval = rbtree_insert(entities, &entity->hdr);
     if (STATUS_SUCCESS != retval)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory inserting entity in add_entity.";
         goto cleanup_entity;
     }
@@ -672,6 +724,7 @@ static endorse_entity* new_entity(
             context->alloc, (void**)&entity, sizeof(*entity));
     if (STATUS_SUCCESS != retval)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory creating entity in new_entity.";
         goto error_exit;
     }
@@ -680,7 +733,7 @@ static endorse_entity* new_entity(
     memset(entity, 0, sizeof(*entity));
     resource_init(&entity->hdr, &entity_resource_release);
     entity->alloc = context->alloc;
-    entity->id = strdup(id);
+    entity->id = id;
     entity->reference_count = 1;
     entity->id_declared = is_decl;
     entity->verbs = verbs;
@@ -692,6 +745,7 @@ static endorse_entity* new_entity(
         entity->verbs = new_verbs(context);
         if (NULL == entity->verbs)
         {
+            context->out_of_memory = true;
             error_message = "Out of memory creating verbs in new_entity.";
             goto cleanup_entity;
         }
@@ -703,6 +757,7 @@ static endorse_entity* new_entity(
         entity->roles = new_roles(context);
         if (NULL == entity->roles)
         {
+            context->out_of_memory = true;
             error_message = "Out of memory creating roles in new_entity.";
             goto cleanup_entity;
         }
@@ -730,6 +785,7 @@ static status entity_resource_release(resource* r)
     status reclaim_retval = STATUS_SUCCESS;
     status verbs_release_retval = STATUS_SUCCESS;
     status roles_release_retval = STATUS_SUCCESS;
+    status verb_table_reclaim_retval = STATUS_SUCCESS;
     endorse_entity* entity = (endorse_entity*)r;
 
     /* decrement reference count. */
@@ -744,9 +800,6 @@ static status entity_resource_release(resource* r)
     /* cache allocator. */
     rcpr_allocator* alloc = entity->alloc;
 
-    /* free the id string. */
-    free((void*)entity->id);
-
     /* release the verbs rbtree if set. */
     if (NULL != entity->verbs)
     {
@@ -761,6 +814,13 @@ static status entity_resource_release(resource* r)
             resource_release(rbtree_resource_handle(entity->roles));
     }
 
+    /* reclaim the verb table if set. */
+    if (NULL != entity->verb_table)
+    {
+        verb_table_reclaim_retval =
+            rcpr_allocator_reclaim(alloc, entity->verb_table);
+    }
+
     /* clear memory. */
     memset(entity, 0, sizeof(*entity));
 
@@ -776,6 +836,10 @@ static status entity_resource_release(resource* r)
     {
         return roles_release_retval;
     }
+    else if (STATUS_SUCCESS != verb_table_reclaim_retval)
+    {
+        return verb_table_reclaim_retval;
+    }
     else
     {
         return reclaim_retval;
@@ -808,6 +872,7 @@ static rbtree* add_verb(
     verb = new_verb(context, verb_name, verb_id);
     if (NULL == verb)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory creating verb in add_verb.";
         goto error_exit;
     }
@@ -816,6 +881,7 @@ static rbtree* add_verb(
     retval = rbtree_insert(verbs, &verb->hdr);
     if (STATUS_SUCCESS != retval)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory inserting verb in add_verb.";
         goto cleanup_verb;
     }
@@ -848,6 +914,7 @@ static endorse_verb* new_verb(
             context->alloc, (void**)&verb, sizeof(*verb));
     if (STATUS_SUCCESS != retval)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory creating verb in new_verb.";
         goto error_exit;
     }
@@ -856,7 +923,7 @@ static endorse_verb* new_verb(
     memset(verb, 0, sizeof(*verb));
     resource_init(&verb->hdr, &verb_resource_release);
     verb->alloc = context->alloc;
-    verb->verb = strdup(verb_name);
+    verb->verb = verb_name;
     memcpy(&verb->verb_id, verb_id, sizeof(verb->verb_id));
     verb->reference_count = 1;
 
@@ -884,9 +951,6 @@ static status verb_resource_release(resource* r)
     /* cache allocator. */
     rcpr_allocator* alloc = verb->alloc;
 
-    /* free the verb name string. */
-    free((void*)verb->verb);
-
     /* clear memory. */
     memset(verb, 0, sizeof(*verb));
 
@@ -1096,6 +1160,7 @@ static rbtree* add_role(
     role = new_role(context, role_name, extends_role_name, role_verbs);
     if (NULL == role)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory creating role in add_role.";
         goto error_exit;
     }
@@ -1104,6 +1169,7 @@ static rbtree* add_role(
     retval = rbtree_insert(roles, &role->hdr);
     if (STATUS_SUCCESS != retval)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory inserting role in add_role.";
         goto cleanup_role;
     }
@@ -1144,6 +1210,7 @@ static endorse_role* new_role(
             context->alloc, (void**)&role, sizeof(*role));
     if (STATUS_SUCCESS != retval)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory creating role in new_role.";
         goto error_exit;
     }
@@ -1152,19 +1219,16 @@ static endorse_role* new_role(
     memset(role, 0, sizeof(*role));
     resource_init(&role->hdr, &role_resource_release);
     role->alloc = context->alloc;
-    role->name = strdup(role_name);
+    role->name = role_name;
     role->reference_count = 1;
 
-    /* if the extends role name is defined, duplicate it. */
-    if (NULL != extends_role_name)
-    {
-        role->extends_role_name = strdup(extends_role_name);
-    }
+    role->extends_role_name = extends_role_name;
 
     /* create new role verbs tree. */
     role->verbs = new_role_verbs(context);
     if (NULL == role->verbs)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory creating role verbs tree in new_role.";
         goto cleanup_role;
     }
@@ -1228,6 +1292,7 @@ static status role_resource_release(resource* r)
     endorse_role* role = (endorse_role*)r;
     status role_verbs_release_retval = STATUS_SUCCESS;
     status role_extends_release_retval = STATUS_SUCCESS;
+    status role_verb_set_release_retval = STATUS_SUCCESS;
     status role_reclaim_retval = STATUS_SUCCESS;
 
     /* decrement reference count. */
@@ -1242,15 +1307,6 @@ static status role_resource_release(resource* r)
     /* cache allocator. */
     rcpr_allocator* alloc = role->alloc;
 
-    /* free the role name string. */
-    free((void*)role->name);
-
-    /* if the extends role name is set, free it. */
-    if (NULL != role->extends_role_name)
-    {
-        free((void*)role->extends_role_name);
-    }
-
     /* release the role verbs tree if set. */
     if (NULL != role->verbs)
     {
@@ -1265,6 +1321,12 @@ static status role_resource_release(resource* r)
             resource_release(&role->extends_role->hdr);
     }
 
+    /* release the verb set if set. */
+    if (NULL != role->verb_set)
+    {
+        role_verb_set_release_retval = resource_release(&role->verb_set->hdr);
+    }
+
     /* clear memory. */
     memset(role, 0, sizeof(*role));
 
@@ -1280,6 +1342,10 @@ static status role_resource_release(resource* r)
     {
         return role_extends_release_retval;
     }
+    else if (STATUS_SUCCESS != role_verb_set_release_retval)
+    {
+        return role_verb_set_release_retval;
+    }
     else
     {
         return role_reclaim_retval;
@@ -1312,6 +1378,7 @@ static rbtree* add_role_verb(
     role_verb = new_role_verb(context, verb_name, NULL);
     if (NULL == role_verb)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory creating role in add_role_verb.";
         goto error_exit;
     }
@@ -1320,6 +1387,7 @@ static rbtree* add_role_verb(
     retval = rbtree_insert(role_verbs, &role_verb->hdr);
     if (STATUS_SUCCESS != retval)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory inserting role_verb in add_role_verb.";
         goto cleanup_role_verb;
     }
@@ -1354,6 +1422,7 @@ static endorse_role_verb* new_role_verb(
             context->alloc, (void**)&role_verb, sizeof(*role_verb));
     if (STATUS_SUCCESS != retval)
     {
+        context->out_of_memory = true;
         error_message = "Out of memory creating role verb in new_role_verb.";
         goto error_exit;
     }
@@ -1362,7 +1431,7 @@ static endorse_role_verb* new_role_verb(
     memset(role_verb, 0, sizeof(*role_verb));
     resource_init(&role_verb->hdr, &role_verb_resource_release);
     role_verb->alloc = context->alloc;
-    role_verb->verb_name = strdup(verb_name);
+    role_verb->verb_name = verb_name;
     role_verb->verb = verb;
     role_verb->reference_count = 1;
 
@@ -1400,9 +1469,6 @@ static status role_verb_resource_release(resource* r)
     /* cache allocator. */
     rcpr_allocator* alloc = role_verb->alloc;
 
-    /* free the verb name string. */
-    free((void*)role_verb->verb_name);
-
     /* release the verb resource if set. */
     if (NULL != role_verb->verb)
     {
@@ -1426,6 +1492,178 @@ static status role_verb_resource_release(resource* r)
     }
 }
 
+/**
+ * \brief Merge a separately parsed config into the root config.
+ */
+status endorse_merge(
+    endorse_config_context* context, endorse_config* root,
+    endorse_config* other)
+{
+    status retval;
+    rbtree_node* node;
+    endorse_entity* entity;
+    resource* entity_resource;
+
+    while (rbtree_count(other->entities) > 0)
+    {
+        node = rbtree_root_node(other->entities);
+        entity = (endorse_entity*)rbtree_node_value(other->entities, node);
+
+        /* take this entity from the other config. */
+        retval = rbtree_delete(&entity_resource, other->entities, entity->id);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        /* merge it into the root config, which takes ownership. */
+        if (entity->id_declared)
+        {
+            retval = merge_declared_entity(context, root, entity);
+        }
+        else
+        {
+            retval = merge_referenced_entity(context, root, entity);
+        }
+
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    /* success. */
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Merge a declared entity from another config into the config.
+ */
+static status merge_declared_entity(
+    endorse_config_context* context, endorse_config* cfg,
+    endorse_entity* entity)
+{
+    status retval, release_retval;
+    resource* canonical_resource;
+    endorse_entity* canonical;
+    rbtree* declarations;
+
+    /* a declaration replaces an earlier reference to the same entity. */
+    retval = rbtree_find(&canonical_resource, cfg->entities, entity->id);
+    canonical =
+        (STATUS_SUCCESS == retval) ? (endorse_entity*)canonical_resource : NULL;
+    if (NULL != canonical && !canonical->id_declared)
+    {
+        retval = rbtree_delete(&canonical_resource, cfg->entities, entity->id);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_entity;
+        }
+
+        retval = rbtree_insert(cfg->entities, &entity->hdr);
+        if (STATUS_SUCCESS != retval)
+        {
+            release_retval = resource_release(canonical_resource);
+            if (STATUS_SUCCESS != release_retval)
+            {
+                retval = release_retval;
+            }
+
+            goto cleanup_entity;
+        }
+
+        /* fold the earlier reference into the declaration. */
+        return merge_referenced_entity(context, cfg, canonical);
+    }
+
+    /* otherwise, merge it as the parser would, reporting any duplicate. */
+    declarations = new_entities(context);
+    if (NULL == declarations)
+    {
+        retval = VCTOOL_ERROR_ENDORSE_MERGE_FAILED;
+        goto cleanup_entity;
+    }
+
+    /* the declarations tree now owns the entity. */
+    retval = rbtree_insert(declarations, &entity->hdr);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_declarations_and_entity;
+    }
+
+    retval = STATUS_SUCCESS;
+    if (NULL == merge_entities(context, cfg, declarations))
+    {
+        retval = VCTOOL_ERROR_ENDORSE_MERGE_FAILED;
+    }
+
+    /* release the declarations tree, and the entity if it was not merged. */
+    release_retval = resource_release(rbtree_resource_handle(declarations));
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+
+cleanup_declarations_and_entity:
+    release_retval = resource_release(rbtree_resource_handle(declarations));
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_entity:
+    release_retval = resource_release(&entity->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Merge an entity reference from another config into the config.
+ */
+static status merge_referenced_entity(
+    endorse_config_context* context, endorse_config* cfg,
+    endorse_entity* entity)
+{
+    status retval, release_retval;
+    resource* canonical_resource;
+
+    /* a new reference is moved into the config for semantic analysis. */
+    retval = rbtree_find(&canonical_resource, cfg->entities, entity->id);
+    if (STATUS_SUCCESS != retval)
+    {
+        if (NULL == merge_verb_entity(context, cfg, entity))
+        {
+            retval = VCTOOL_ERROR_ENDORSE_MERGE_FAILED;
+            goto cleanup_entity;
+        }
+
+        return STATUS_SUCCESS;
+    }
+
+    /* otherwise, merge its verbs and roles into the canonical entity. */
+    retval = STATUS_SUCCESS;
+    if (NULL == merge_verb_entity(context, cfg, entity)
+     || NULL == merge_role_entity(context, cfg, entity))
+    {
+        retval = VCTOOL_ERROR_ENDORSE_MERGE_FAILED;
+    }
+
+cleanup_entity:
+    release_retval = resource_release(&entity->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
+
 /**
  * \brief Set the error for the config structure.
  */
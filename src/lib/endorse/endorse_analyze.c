@@ -3,22 +3,26 @@
  *
  * \brief Analyze the AST from an endorse config file.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <vctool/endorse.h>
 
+RCPR_IMPORT_allocator_as(rcpr);
 RCPR_IMPORT_rbtree;
 RCPR_IMPORT_resource;
 
 /* forward decls. */
+static status endorse_analyze_entity_verb_table(
+    endorse_config_context* context, endorse_entity* entity);
 static status endorse_analyze_entity_roles(
     endorse_config_context* context, endorse_entity* entity);
 static status endorse_analyze_entity_role_verbs(
     endorse_config_context* context, endorse_entity* entity,
     endorse_role* role);
-static status endorse_analyze_entity_copy_extended_role_verbs(
+static status endorse_analyze_entity_role_verb_set(
     endorse_config_context* context, endorse_entity* entity,
     endorse_role* role);
 
@@ -72,6 +76,14 @@ status endorse_analyze(endorse_config_context* context, endorse_config* root)
             fail = true;
         }
 
+        /* assign a dense index to each verb. */
+        retval = endorse_analyze_entity_verb_table(context, entity);
+        if (STATUS_SUCCESS != retval)
+        {
+            fail = true;
+            continue;
+        }
+
         /* iterate through the roles. */
         retval = endorse_analyze_entity_roles(context, entity);
         if (STATUS_SUCCESS != retval)
@@ -91,9 +103,89 @@ status endorse_analyze(endorse_config_context* context, endorse_config* root)
     }
 }
 
+/**
+ * \brief Assign a dense index to each verb of the given entity, in verb name
+ * order, and build the table mapping each index back to its verb.
+ *
+ * \param context       The endorse config context for this operation.
+ * \param entity        The entity to analyze.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+static status endorse_analyze_entity_verb_table(
+    endorse_config_context* context, endorse_entity* entity)
+{
+    status retval;
+    rbtree_node* node = NULL;
+    rbtree_node* nil = NULL;
+    size_t index = 0;
+    char buffer[1024];
+
+    /* the verb table is only built once. */
+    if (NULL != entity->verb_table)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    /* allocate the verb table; always allocate at least one entry. */
+    entity->verb_table_size = rbtree_count(entity->verbs);
+    retval =
+        rcpr_allocator_allocate(
+            entity->alloc, (void**)&entity->verb_table,
+            (entity->verb_table_size + 1) * sizeof(endorse_verb*));
+    if (STATUS_SUCCESS != retval)
+    {
+        snprintf(
+            buffer, sizeof(buffer),
+            "Entity `%s' out of memory creating verb table.\n", entity->id);
+        context->out_of_memory = true;
+        context->set_error(context, buffer);
+        entity->verb_table = NULL;
+        entity->verb_table_size = 0;
+        return -1;
+    }
+
+    /* get the nil node. */
+    nil = rbtree_nil_node(entity->verbs);
+
+    /* get the root node. */
+    node = rbtree_root_node(entity->verbs);
+    if (nil == node)
+    {
+        /* no verbs. */
+        return STATUS_SUCCESS;
+    }
+
+    /* iterate through all verbs. */
+    for (
+        node = rbtree_minimum_node(entity->verbs, node);
+        node != nil;
+        node = rbtree_successor_node(entity->verbs, node))
+    {
+        /* get the value of this node. */
+        endorse_verb* verb =
+            (endorse_verb*)rbtree_node_value(entity->verbs, node);
+
+        /* assign the next index to this verb. */
+        verb->index = index;
+        entity->verb_table[index] = verb;
+        ++index;
+    }
+
+    return STATUS_SUCCESS;
+}
+
 /**
  * \brief Analyze all defined roles for a given entity.
  *
+ * Roles are resolved in topological order. Starting from each unresolved role,
+ * the chain of extended roles is followed up to the first resolved role, and
+ * the roles on this chain are then resolved from the top down. Each role is
+ * visited exactly once. A role that is reached again while its own chain is
+ * being followed is part of a circular inheritance loop.
+ *
  * \param context       The endorse config context for this operation.
  * \param entity        The entity to analyze.
  *
@@ -108,90 +200,116 @@ static status endorse_analyze_entity_roles(
     rbtree_node* node = NULL;
     rbtree_node* nil = NULL;
     bool fail = false;
-    bool incomplete_types_found = false;
     char buffer[1024];
-    int resolved_count = 0;
-    endorse_role* last_incomplete_type = NULL;
+    endorse_role** chain = NULL;
+    size_t depth;
 
     /* get the nil node. */
     nil = rbtree_nil_node(entity->roles);
 
-    /* outer loop -- keep iterating while incomplete types are found. */
-    do
+    /* get the root node. */
+    node = rbtree_root_node(entity->roles);
+    if (nil == node)
     {
-        /* start by resetting the incomplete_types_found flag and the resolved
-         * count.*/
-        incomplete_types_found = false;
-        resolved_count = 0;
-
-        /* get the root node. */
-        node = rbtree_root_node(entity->roles);
-        if (nil == node)
+        /* no roles. */
+        return STATUS_SUCCESS;
+    }
+
+    /* a chain can be no longer than the number of roles. */
+    retval =
+        rcpr_allocator_allocate(
+            entity->alloc, (void**)&chain,
+            rbtree_count(entity->roles) * sizeof(endorse_role*));
+    if (STATUS_SUCCESS != retval)
+    {
+        snprintf(
+            buffer, sizeof(buffer),
+            "Entity `%s' out of memory resolving roles.\n", entity->id);
+        context->out_of_memory = true;
+        context->set_error(context, buffer);
+        return -1;
+    }
+
+    /* iterate through all roles. */
+    for (
+        node = rbtree_minimum_node(entity->roles, node);
+        node != nil;
+        node = rbtree_successor_node(entity->roles, node))
+    {
+        /* get the value of this node. */
+        endorse_role* role =
+            (endorse_role*)rbtree_node_value(entity->roles, node);
+
+        /* if the role type is complete, we can skip it. */
+        if (role->type_complete)
         {
-            /* no roles. */
-            return STATUS_SUCCESS;
+            continue;
         }
 
-        /* iterate through all roles. */
-        for (
-            node = rbtree_minimum_node(entity->roles, node);
-            node != nil;
-            node = rbtree_successor_node(entity->roles, node))
+        /* follow the extends chain up to the first resolved role. */
+        depth = 0;
+        while (NULL != role)
         {
-            /* get the value of this node. */
-            endorse_role* role =
-                (endorse_role*)rbtree_node_value(entity->roles, node);
+            resource* extends_resource = NULL;
+            endorse_role* extends_role;
+
+            /* push this role onto the chain. */
+            role->type_pending = true;
+            chain[depth++] = role;
+
+            /* if this role does not extend another role, stop here. */
+            if (NULL == role->extends_role_name)
+            {
+                break;
+            }
 
-            /* if the role type is complete, we can skip it. */
-            if (role->type_complete)
+            /* look up the extended role. */
+            retval =
+                rbtree_find(
+                    &extends_resource, entity->roles, role->extends_role_name);
+            if (STATUS_SUCCESS != retval)
             {
-                goto next_role;
+                snprintf(
+                    buffer, sizeof(buffer),
+                    "Entity `%s' role `%s' extends undefined role `%s'.\n",
+                    entity->id, role->name, role->extends_role_name);
+                context->set_error(context, buffer);
+                fail = true;
+
+                /* we will continue as if the extends clause was not
+                 * defined. */
+                break;
             }
 
-            /* if we haven't looked up the extends role, look it up. */
-            if (NULL != role->extends_role_name && NULL == role->extends_role)
+            /* if the extended role is on this chain, we found a loop. */
+            extends_role = (endorse_role*)extends_resource;
+            if (extends_role->type_pending)
             {
-                resource* extends_resource = NULL;
-
-                /* look up this role. */
-                retval =
-                    rbtree_find(
-                        &extends_resource, entity->roles,
-                        role->extends_role_name);
-                if (STATUS_SUCCESS != retval)
-                {
-                    snprintf(
-                        buffer, sizeof(buffer),
-                        "Entity `%s' role `%s' extends undefined role `%s'.\n",
-                        entity->id, role->name, role->extends_role_name);
-                    context->set_error(context, buffer);
-                    fail = true;
-
-                    /* we will continue as if the extends clause was not
-                     * defined. */
-                }
-                else
-                {
-                    /* set the extends role. */
-                    role->extends_role = (endorse_role*)extends_resource;
-
-                    /* if the extends role is incomplete, then we can't yet
-                     * continue.
-                     */
-                    if (!role->extends_role->type_complete)
-                    {
-                        incomplete_types_found = true;
-                        role->extends_role = NULL;
-                        last_incomplete_type = role;
-                        goto next_role;
-                    }
-
-                    /* otherwise, increment the reference count on the extends
-                     * role. */
-                    ++(role->extends_role->reference_count);
-                }
+                snprintf(
+                    buffer, sizeof(buffer),
+                    "Entity `%s' role `%s' extends a circular inheritance "
+                    "loop.\n",
+                    entity->id, role->name);
+                context->set_error(context, buffer);
+                fail = true;
+
+                /* break the loop here, so the AST remains acyclic. */
+                break;
             }
 
+            /* set the extends role and increment its reference count. */
+            role->extends_role = extends_role;
+            ++(role->extends_role->reference_count);
+
+            /* continue up the chain if the extended role is unresolved. */
+            role = extends_role->type_complete ? NULL : extends_role;
+        }
+
+        /* resolve the chain from the top down. */
+        while (depth > 0)
+        {
+            role = chain[--depth];
+
             /* iterate through the verbs. */
             retval = endorse_analyze_entity_role_verbs(context, entity, role);
             if (STATUS_SUCCESS != retval)
@@ -199,36 +317,26 @@ static status endorse_analyze_entity_roles(
                 fail = true;
             }
 
-            /* copy the verbs from the extends role, if set. */
+            /* build the verb set, sharing the extended set if possible. */
             retval =
-                endorse_analyze_entity_copy_extended_role_verbs(
-                    context, entity, role);
+                endorse_analyze_entity_role_verb_set(context, entity, role);
             if (STATUS_SUCCESS != retval)
             {
                 fail = true;
             }
 
-            /* this type is now complete; mark it so and increment resolved
-             * count. */
+            /* this type is now complete. */
+            role->type_pending = false;
             role->type_complete = true;
-            ++resolved_count;
-
-        next_role:
-        }
-
-        /* check for a circular reference. */
-        if (incomplete_types_found && 0 == resolved_count)
-        {
-            snprintf(
-                buffer, sizeof(buffer),
-                "Entity `%s' role `%s' extends a circular inheritance loop.\n",
-                entity->id, last_incomplete_type->name);
-            context->set_error(context, buffer);
-            fail = true;
-            break;
         }
+    }
 
-    } while (incomplete_types_found);
+    /* clean up the chain. */
+    retval = rcpr_allocator_reclaim(entity->alloc, chain);
+    if (STATUS_SUCCESS != retval)
+    {
+        fail = true;
+    }
 
     /* if we encountered a failure, return a non-zero error code. */
     if (fail)
@@ -315,7 +423,11 @@ static status endorse_analyze_entity_role_verbs(
 }
 
 /**
- * \brief Copy the verbs from the extended role to this role.
+ * \brief Build the verb set for a role from its declared verbs and the verb set
+ * of its extended role.
+ *
+ * Verb sets are immutable once built. If a role declares no verbs beyond those
+ * that it inherits, then it shares the verb set of its extended role.
  *
  * \param context       The endorse config context for this operation.
  * \param entity        The entity to analyze.
@@ -325,69 +437,101 @@ static status endorse_analyze_entity_role_verbs(
  *      - STATUS_SUCCESS on success.
  *      - a non-zero error code on failure.
  */
-static status endorse_analyze_entity_copy_extended_role_verbs(
+static status endorse_analyze_entity_role_verb_set(
     endorse_config_context* context, endorse_entity* entity,
     endorse_role* role)
 {
-    status retval = STATUS_SUCCESS;
+    status retval;
     rbtree_node* node = NULL;
     rbtree_node* nil = NULL;
-    bool fail = false;
+    const endorse_verb_set* inherited = NULL;
+    bool adds_verbs = false;
     char buffer[1024];
 
-    /* if the role does not extend another role, then we're done. */
-    if (NULL == role->extends_role)
+    /* get the inherited verb set, if any. */
+    if (NULL != role->extends_role)
     {
-        return STATUS_SUCCESS;
+        inherited = role->extends_role->verb_set;
     }
 
     /* get the nil node. */
-    nil = rbtree_nil_node(role->extends_role->verbs);
+    nil = rbtree_nil_node(role->verbs);
 
-    /* get the root node. */
-    node = rbtree_root_node(role->extends_role->verbs);
-    if (nil == node)
+    /* determine whether this role adds any verbs to the inherited set. */
+    node = rbtree_root_node(role->verbs);
+    if (nil != node)
     {
-        /* no verbs. */
-        return STATUS_SUCCESS;
+        for (
+            node = rbtree_minimum_node(role->verbs, node);
+            node != nil;
+            node = rbtree_successor_node(role->verbs, node))
+        {
+            endorse_role_verb* role_verb =
+                (endorse_role_verb*)rbtree_node_value(role->verbs, node);
+
+            if (NULL != role_verb->verb
+             && (NULL == inherited
+                || !endorse_verb_set_contains(
+                        inherited, role_verb->verb->index)))
+            {
+                adds_verbs = true;
+                break;
+            }
+        }
     }
 
-    /* iterate through all verbs. */
-    for (
-        node = rbtree_minimum_node(role->extends_role->verbs, node);
-        node != nil;
-        node = rbtree_successor_node(role->extends_role->verbs, node))
+    /* if this role adds nothing, share the inherited set. */
+    if (!adds_verbs && NULL != inherited)
     {
-        /* get the value of this node. */
-        endorse_role_verb* role_verb =
-            (endorse_role_verb*)
-                rbtree_node_value(role->extends_role->verbs, node);
-
-        /* copy this verb to the role. */
-        retval = rbtree_insert(role->verbs, &role_verb->hdr);
-        if (STATUS_SUCCESS != retval)
-        {
-            snprintf(
-                buffer, sizeof(buffer),
-                "Entity `%s' role `%s' verb copy failed..\n",
-                entity->id, role->name);
-            context->set_error(context, buffer);
-            fail = true;
-        }
-        else
-        {
-            /* increment the reference count. */
-            ++role_verb->reference_count;
-        }
+        role->verb_set = (endorse_verb_set*)inherited;
+        ++(role->verb_set->reference_count);
+        return STATUS_SUCCESS;
     }
 
-    /* did semantic analysis fail? */
-    if (fail)
+    /* otherwise, create a new set. */
+    retval =
+        endorse_verb_set_create(
+            &role->verb_set, entity->alloc, entity->verb_table_size);
+    if (STATUS_SUCCESS != retval)
     {
+        snprintf(
+            buffer, sizeof(buffer),
+            "Entity `%s' role `%s' out of memory creating verb set.\n",
+            entity->id, role->name);
+        context->out_of_memory = true;
+        context->set_error(context, buffer);
+        role->verb_set = NULL;
         return -1;
     }
-    else
+
+    /* start with the inherited verbs. */
+    if (NULL != inherited)
     {
-        return STATUS_SUCCESS;
+        memcpy(
+            role->verb_set->words, inherited->words,
+            inherited->word_count * sizeof(uint64_t));
     }
+
+    /* add the declared verbs. */
+    node = rbtree_root_node(role->verbs);
+    if (nil != node)
+    {
+        for (
+            node = rbtree_minimum_node(role->verbs, node);
+            node != nil;
+            node = rbtree_successor_node(role->verbs, node))
+        {
+            endorse_role_verb* role_verb =
+                (endorse_role_verb*)rbtree_node_value(role->verbs, node);
+
+            if (NULL != role_verb->verb)
+            {
+                size_t index = role_verb->verb->index;
+                role->verb_set->words[index / 64] |=
+                    UINT64_C(1) << (index % 64);
+            }
+        }
+    }
+
+    return STATUS_SUCCESS;
 }
@@ -0,0 +1,49 @@
+/**
+ * \file endorse/endorse_arena_create.c
+ *
+ * \brief Create an arena allocator for an endorse config parse.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <vctool/endorse.h>
+#include <vctool/status_codes.h>
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Create an arena allocator for parsing and analyzing an endorse config.
+ *
+ * \param arena                 Pointer to receive the arena allocator on
+ *                              success.
+ * \param parent                The allocator from which the arena is
+ *                              allocated.
+ * \param source_size           The size of the endorse config source.
+ * \param bytes_per_source_byte The arena bytes to reserve per byte of source.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_arena_create(
+    RCPR_SYM(allocator)** arena, RCPR_SYM(allocator)* parent,
+    size_t source_size, size_t bytes_per_source_byte)
+{
+    size_t size;
+
+    /* guard against overflow for very large sources. */
+    if (0 != bytes_per_source_byte
+     && source_size > SIZE_MAX / bytes_per_source_byte)
+    {
+        return VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* size the arena from the source. */
+    size = source_size * bytes_per_source_byte;
+    if (size < ENDORSE_ARENA_MIN_SIZE)
+    {
+        size = ENDORSE_ARENA_MIN_SIZE;
+    }
+
+    return rcpr_bump_allocator_create(arena, parent, size);
+}
@@ -0,0 +1,454 @@
+/**
+ * \file lib/endorse/endorse_compile.c
+ *
+ * \brief Compile an analyzed endorse config AST into a flat image.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vctool/status_codes.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_rbtree;
+RCPR_IMPORT_resource;
+RCPR_IMPORT_uuid;
+
+/* forward decls. */
+static status endorse_compile_count(
+    endorse_compiled_header* header, size_t* string_count,
+    const endorse_config* root);
+static void endorse_compile_collect_strings(
+    endorse_compiled_string* strings, const endorse_config* root);
+static size_t endorse_compile_intern_strings(
+    endorse_compiled_string* strings, size_t string_count);
+static uint32_t endorse_compile_string_offset(
+    const endorse_compiled_string* strings, size_t string_count,
+    const char* str);
+static status endorse_compile_fill_tables(
+    uint8_t* image, const endorse_compiled_string* strings,
+    size_t string_count, const endorse_config* root);
+
+/**
+ * \brief Compile an analyzed endorse config AST into a flat image.
+ *
+ * \param compiled      Pointer to receive the compiled config on success.
+ * \param alloc         The allocator to use for this operation.
+ * \param root          The analyzed AST root to compile.
+ * \param source_digest The SHA-512 digest of the sources from which this AST
+ *                      was parsed, which is recorded in the image.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_compile(
+    endorse_compiled** compiled, RCPR_SYM(allocator)* alloc,
+    const endorse_config* root, const uint8_t* source_digest)
+{
+    status retval, release_retval;
+    endorse_compiled_header counts;
+    endorse_compiled_string* strings;
+    size_t string_count;
+    size_t string_table_size;
+    uint8_t* image;
+    size_t image_size;
+
+    /* count the entities, verbs, roles, role verbs, bitsets, and strings. */
+    memset(&counts, 0, sizeof(counts));
+    retval = endorse_compile_count(&counts, &string_count, root);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* allocate the string array; always allocate at least one entry. */
+    retval =
+        rcpr_allocator_allocate(
+            alloc, (void**)&strings,
+            (string_count + 1) * sizeof(endorse_compiled_string));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* collect, sort, and intern every string. */
+    endorse_compile_collect_strings(strings, root);
+    qsort(
+        strings, string_count, sizeof(endorse_compiled_string),
+        &endorse_compiled_string_compare);
+    string_table_size = endorse_compile_intern_strings(strings, string_count);
+    if (string_table_size > UINT32_MAX)
+    {
+        retval = VCTOOL_ERROR_ENDORSE_COMPILED_INVALID;
+        goto cleanup_strings;
+    }
+
+    /* compute the image size. */
+    counts.string_table_size = (uint32_t)string_table_size;
+    image_size =
+        sizeof(endorse_compiled_header)
+      + counts.bits_word_count * sizeof(uint64_t)
+      + counts.entity_count * sizeof(endorse_compiled_entity)
+      + counts.verb_count * sizeof(endorse_compiled_verb)
+      + counts.role_count * sizeof(endorse_compiled_role)
+      + counts.string_table_size;
+
+    /* allocate the image. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&image, image_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_strings;
+    }
+
+    /* clear memory. */
+    memset(image, 0, image_size);
+
+    /* write the header. */
+    counts.magic = ENDORSE_COMPILED_MAGIC;
+    counts.version = ENDORSE_COMPILED_VERSION;
+    memcpy(
+        counts.source_digest, source_digest, ENDORSE_COMPILED_DIGEST_SIZE);
+    memcpy(image, &counts, sizeof(counts));
+
+    /* write the unique strings to the string table. */
+    char* string_table = (char*)(image + image_size - string_table_size);
+    for (size_t i = 0; i < string_count; ++i)
+    {
+        if (0 == i || strings[i].offset != strings[i - 1].offset)
+        {
+            strcpy(string_table + strings[i].offset, strings[i].str);
+        }
+    }
+
+    /* write the bitset, entity, verb, and role tables. */
+    retval = endorse_compile_fill_tables(image, strings, string_count, root);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_image;
+    }
+
+    /* wrap the image. On success, the compiled config owns the image. */
+    retval = endorse_compiled_create(compiled, alloc, image, image_size, NULL);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_image;
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_strings;
+
+cleanup_image:
+    release_retval = rcpr_allocator_reclaim(alloc, image);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_strings:
+    release_retval = rcpr_allocator_reclaim(alloc, strings);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Count the entities, verbs, roles, role bitset words, and strings in
+ * the AST.
+ */
+static status endorse_compile_count(
+    endorse_compiled_header* header, size_t* string_count,
+    const endorse_config* root)
+{
+    size_t entity_count = 0, verb_count = 0, role_count = 0;
+    size_t bits_word_count = 0;
+    rbtree_node* nil;
+    rbtree_node* node;
+    rbtree_node* role_nil;
+    rbtree_node* role_node;
+    endorse_entity* entity;
+    endorse_role* role;
+
+    nil = rbtree_nil_node(root->entities);
+    node = rbtree_root_node(root->entities);
+    if (nil != node)
+    {
+        node = rbtree_minimum_node(root->entities, node);
+    }
+
+    /* iterate through all entities. */
+    while (nil != node)
+    {
+        entity = (endorse_entity*)rbtree_node_value(root->entities, node);
+
+        ++entity_count;
+        verb_count += rbtree_count(entity->verbs);
+        role_count += rbtree_count(entity->roles);
+
+        /* each role holds a bitset over the verbs of this entity. */
+        bits_word_count +=
+            rbtree_count(entity->roles)
+          * ((rbtree_count(entity->verbs) + 63) / 64);
+
+        /* only an analyzed AST can be compiled. */
+        role_nil = rbtree_nil_node(entity->roles);
+        role_node = rbtree_root_node(entity->roles);
+        if (role_nil != role_node)
+        {
+            role_node = rbtree_minimum_node(entity->roles, role_node);
+        }
+
+        while (role_nil != role_node)
+        {
+            role = (endorse_role*)rbtree_node_value(entity->roles, role_node);
+            if (NULL == role->verb_set)
+            {
+                return VCTOOL_ERROR_ENDORSE_COMPILED_INVALID;
+            }
+
+            role_node = rbtree_successor_node(entity->roles, role_node);
+        }
+
+        node = rbtree_successor_node(root->entities, node);
+    }
+
+    /* every count must fit in the image header. */
+    if (entity_count > UINT32_MAX || verb_count > UINT32_MAX
+     || role_count > UINT32_MAX || bits_word_count > UINT32_MAX)
+    {
+        return VCTOOL_ERROR_ENDORSE_COMPILED_INVALID;
+    }
+
+    header->entity_count = (uint32_t)entity_count;
+    header->verb_count = (uint32_t)verb_count;
+    header->role_count = (uint32_t)role_count;
+    header->bits_word_count = (uint32_t)bits_word_count;
+    *string_count = entity_count + verb_count + role_count;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Collect every entity, verb, and role name in the AST.
+ */
+static void endorse_compile_collect_strings(
+    endorse_compiled_string* strings, const endorse_config* root)
+{
+    size_t index = 0;
+    rbtree_node* nil;
+    rbtree_node* node;
+    rbtree_node* child_nil;
+    rbtree_node* child;
+    endorse_entity* entity;
+    endorse_verb* verb;
+    endorse_role* role;
+
+    nil = rbtree_nil_node(root->entities);
+    node = rbtree_root_node(root->entities);
+    if (nil != node)
+    {
+        node = rbtree_minimum_node(root->entities, node);
+    }
+
+    /* iterate through all entities. */
+    while (nil != node)
+    {
+        entity = (endorse_entity*)rbtree_node_value(root->entities, node);
+        strings[index++].str = entity->id;
+
+        /* collect verb names. */
+        child_nil = rbtree_nil_node(entity->verbs);
+        child = rbtree_root_node(entity->verbs);
+        if (child_nil != child)
+        {
+            child = rbtree_minimum_node(entity->verbs, child);
+        }
+
+        while (child_nil != child)
+        {
+            verb = (endorse_verb*)rbtree_node_value(entity->verbs, child);
+            strings[index++].str = verb->verb;
+            child = rbtree_successor_node(entity->verbs, child);
+        }
+
+        /* collect role names. */
+        child_nil = rbtree_nil_node(entity->roles);
+        child = rbtree_root_node(entity->roles);
+        if (child_nil != child)
+        {
+            child = rbtree_minimum_node(entity->roles, child);
+        }
+
+        while (child_nil != child)
+        {
+            role = (endorse_role*)rbtree_node_value(entity->roles, child);
+            strings[index++].str = role->name;
+            child = rbtree_successor_node(entity->roles, child);
+        }
+
+        node = rbtree_successor_node(root->entities, node);
+    }
+}
+
+/**
+ * \brief Assign string table offsets to a sorted string array, sharing one
+ * offset between equal strings.
+ *
+ * \returns the size of the string table.
+ */
+static size_t endorse_compile_intern_strings(
+    endorse_compiled_string* strings, size_t string_count)
+{
+    size_t offset = 0;
+
+    for (size_t i = 0; i < string_count; ++i)
+    {
+        if (i > 0
+         && (strings[i].str == strings[i - 1].str
+          || !strcmp(strings[i].str, strings[i - 1].str)))
+        {
+            strings[i].offset = strings[i - 1].offset;
+        }
+        else
+        {
+            strings[i].offset = (uint32_t)offset;
+            offset += strlen(strings[i].str) + 1;
+        }
+    }
+
+    /* an empty string table still holds a terminator. */
+    if (0 == offset)
+    {
+        offset = 1;
+    }
+
+    return offset;
+}
+
+/**
+ * \brief Look up the interned offset of a string.
+ */
+static uint32_t endorse_compile_string_offset(
+    const endorse_compiled_string* strings, size_t string_count,
+    const char* str)
+{
+    endorse_compiled_string key = { .str = str, .offset = 0 };
+    const endorse_compiled_string* found;
+
+    found =
+        (const endorse_compiled_string*)bsearch(
+            &key, strings, string_count, sizeof(endorse_compiled_string),
+            &endorse_compiled_string_compare);
+
+    /* every name in the AST was collected. */
+    MODEL_ASSERT(NULL != found);
+
+    return found->offset;
+}
+
+/**
+ * \brief Write the bitset, entity, verb, and role tables.
+ */
+static status endorse_compile_fill_tables(
+    uint8_t* image, const endorse_compiled_string* strings,
+    size_t string_count, const endorse_config* root)
+{
+    const endorse_compiled_header* header =
+        (const endorse_compiled_header*)image;
+    uint64_t* bits = (uint64_t*)(image + sizeof(*header));
+    endorse_compiled_entity* entities =
+        (endorse_compiled_entity*)(bits + header->bits_word_count);
+    endorse_compiled_verb* verbs =
+        (endorse_compiled_verb*)(entities + header->entity_count);
+    endorse_compiled_role* roles =
+        (endorse_compiled_role*)(verbs + header->verb_count);
+    uint32_t entity_index = 0, verb_index = 0, role_index = 0;
+    uint32_t bits_index = 0;
+    rbtree_node* nil;
+    rbtree_node* node;
+    rbtree_node* child_nil;
+    rbtree_node* child;
+    endorse_entity* entity;
+    endorse_verb* verb;
+    endorse_role* role;
+
+    nil = rbtree_nil_node(root->entities);
+    node = rbtree_root_node(root->entities);
+    if (nil != node)
+    {
+        node = rbtree_minimum_node(root->entities, node);
+    }
+
+    /* iterate through all entities; rbtree order is sorted by name. */
+    while (nil != node)
+    {
+        entity = (endorse_entity*)rbtree_node_value(root->entities, node);
+
+        endorse_compiled_entity* out_entity = &entities[entity_index++];
+        out_entity->name =
+            endorse_compile_string_offset(strings, string_count, entity->id);
+        out_entity->verb_offset = verb_index;
+        out_entity->verb_count = (uint32_t)rbtree_count(entity->verbs);
+        out_entity->role_offset = role_index;
+        out_entity->role_count = (uint32_t)rbtree_count(entity->roles);
+
+        /* write the verbs for this entity. */
+        child_nil = rbtree_nil_node(entity->verbs);
+        child = rbtree_root_node(entity->verbs);
+        if (child_nil != child)
+        {
+            child = rbtree_minimum_node(entity->verbs, child);
+        }
+
+        while (child_nil != child)
+        {
+            verb = (endorse_verb*)rbtree_node_value(entity->verbs, child);
+
+            endorse_compiled_verb* out_verb = &verbs[verb_index++];
+            out_verb->name =
+                endorse_compile_string_offset(strings, string_count, verb->verb);
+            memcpy(&out_verb->verb_id, &verb->verb_id, sizeof(rcpr_uuid));
+
+            child = rbtree_successor_node(entity->verbs, child);
+        }
+
+        /* write the roles for this entity. */
+        child_nil = rbtree_nil_node(entity->roles);
+        child = rbtree_root_node(entity->roles);
+        if (child_nil != child)
+        {
+            child = rbtree_minimum_node(entity->roles, child);
+        }
+
+        while (child_nil != child)
+        {
+            role = (endorse_role*)rbtree_node_value(entity->roles, child);
+
+            endorse_compiled_role* out_role = &roles[role_index++];
+            out_role->name =
+                endorse_compile_string_offset(strings, string_count, role->name);
+
+            /* write the verb bitset for this role. */
+            out_role->bits_offset = bits_index;
+            memcpy(
+                bits + bits_index, role->verb_set->words,
+                role->verb_set->word_count * sizeof(uint64_t));
+            bits_index += (uint32_t)role->verb_set->word_count;
+
+            child = rbtree_successor_node(entity->roles, child);
+        }
+
+        node = rbtree_successor_node(root->entities, node);
+    }
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,188 @@
+/**
+ * \file lib/endorse/endorse_compiled_create.c
+ *
+ * \brief Create a compiled endorse config from an image.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <string.h>
+#include <vctool/status_codes.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+RCPR_IMPORT_uuid;
+
+/**
+ * \brief Create a compiled endorse config from an image, validating the image.
+ *
+ * On success, the compiled config takes ownership of the image. On failure, the
+ * caller retains ownership of the image.
+ *
+ * \param compiled      Pointer to receive the compiled config on success.
+ * \param alloc         The allocator to use.
+ * \param image         The compiled image.
+ * \param image_size    The size of the compiled image.
+ * \param f             The file interface with which the image was memory
+ *                      mapped, or NULL if it was allocated using \p alloc.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_COMPILED_INVALID if the image is invalid.
+ *      - a non-zero error code on failure.
+ */
+status endorse_compiled_create(
+    endorse_compiled** compiled, RCPR_SYM(allocator)* alloc, void* image,
+    size_t image_size, file* f)
+{
+    status retval;
+    endorse_compiled* tmp;
+    const endorse_compiled_header* header;
+    const uint8_t* base = (const uint8_t*)image;
+
+    /* the image must be large enough to hold the header. */
+    if (image_size < sizeof(*header))
+    {
+        retval = VCTOOL_ERROR_ENDORSE_COMPILED_INVALID;
+        goto done;
+    }
+
+    /* verify the magic number and version. */
+    header = (const endorse_compiled_header*)image;
+    if (ENDORSE_COMPILED_MAGIC != header->magic
+     || ENDORSE_COMPILED_VERSION != header->version)
+    {
+        retval = VCTOOL_ERROR_ENDORSE_COMPILED_INVALID;
+        goto done;
+    }
+
+    /* compute the table offsets. These can't overflow for 32-bit counts. */
+    uint64_t bits_offset = sizeof(*header);
+    uint64_t entities_offset =
+        bits_offset + (uint64_t)header->bits_word_count * sizeof(uint64_t);
+    uint64_t verbs_offset =
+        entities_offset
+      + (uint64_t)header->entity_count * sizeof(endorse_compiled_entity);
+    uint64_t roles_offset =
+        verbs_offset
+      + (uint64_t)header->verb_count * sizeof(endorse_compiled_verb);
+    uint64_t strings_offset =
+        roles_offset
+      + (uint64_t)header->role_count * sizeof(endorse_compiled_role);
+    uint64_t expected_size = strings_offset + header->string_table_size;
+
+    /* the image size must match the header exactly. */
+    if (expected_size != image_size)
+    {
+        retval = VCTOOL_ERROR_ENDORSE_COMPILED_INVALID;
+        goto done;
+    }
+
+    /* the string table must be terminated, so every offset is a string. */
+    const char* strings = (const char*)(base + strings_offset);
+    if (0 == header->string_table_size
+     || 0 != strings[header->string_table_size - 1])
+    {
+        retval = VCTOOL_ERROR_ENDORSE_COMPILED_INVALID;
+        goto done;
+    }
+
+    /* verify that every entity refers to valid strings and ranges. */
+    const endorse_compiled_entity* entities =
+        (const endorse_compiled_entity*)(base + entities_offset);
+    for (uint32_t i = 0; i < header->entity_count; ++i)
+    {
+        if (entities[i].name >= header->string_table_size
+         || (uint64_t)entities[i].verb_offset + entities[i].verb_count
+                > header->verb_count
+         || (uint64_t)entities[i].role_offset + entities[i].role_count
+                > header->role_count)
+        {
+            retval = VCTOOL_ERROR_ENDORSE_COMPILED_INVALID;
+            goto done;
+        }
+    }
+
+    /* verify that every verb refers to a valid string. */
+    const endorse_compiled_verb* verbs =
+        (const endorse_compiled_verb*)(base + verbs_offset);
+    for (uint32_t i = 0; i < header->verb_count; ++i)
+    {
+        if (verbs[i].name >= header->string_table_size)
+        {
+            retval = VCTOOL_ERROR_ENDORSE_COMPILED_INVALID;
+            goto done;
+        }
+    }
+
+    /* verify that every role refers to a valid string. */
+    const endorse_compiled_role* roles =
+        (const endorse_compiled_role*)(base + roles_offset);
+    for (uint32_t i = 0; i < header->role_count; ++i)
+    {
+        if (roles[i].name >= header->string_table_size)
+        {
+            retval = VCTOOL_ERROR_ENDORSE_COMPILED_INVALID;
+            goto done;
+        }
+    }
+
+    /* verify that every role bitset is in range and only holds entity verbs. */
+    const uint64_t* bits = (const uint64_t*)(base + bits_offset);
+    for (uint32_t i = 0; i < header->entity_count; ++i)
+    {
+        size_t word_count = endorse_compiled_entity_word_count(&entities[i]);
+        uint32_t tail = entities[i].verb_count % 64;
+
+        for (uint32_t j = 0; j < entities[i].role_count; ++j)
+        {
+            const endorse_compiled_role* role =
+                &roles[entities[i].role_offset + j];
+
+            if ((uint64_t)role->bits_offset + word_count
+                    > header->bits_word_count
+             || (0 != tail
+              && 0 != (bits[role->bits_offset + word_count - 1] >> tail)))
+            {
+                retval = VCTOOL_ERROR_ENDORSE_COMPILED_INVALID;
+                goto done;
+            }
+        }
+    }
+
+    /* allocate memory for the compiled config. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &endorse_compiled_resource_release);
+
+    /* set values. */
+    tmp->alloc = alloc;
+    tmp->image = image;
+    tmp->image_size = image_size;
+    tmp->mapped = (NULL != f);
+    tmp->f = f;
+    tmp->header = header;
+    tmp->entities = entities;
+    tmp->verbs = verbs;
+    tmp->roles = roles;
+    tmp->bits = bits;
+    tmp->strings = strings;
+
+    /* success. */
+    *compiled = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+done:
+    return retval;
+}
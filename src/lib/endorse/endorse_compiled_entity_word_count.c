@@ -0,0 +1,23 @@
+/**
+ * \file lib/endorse/endorse_compiled_entity_word_count.c
+ *
+ * \brief Return the number of verb bitset words for a compiled entity.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Return the number of bitset words needed to hold the verbs of an
+ * entity.
+ *
+ * \param entity        The compiled entity.
+ *
+ * \returns the number of 64-bit words in a verb bitset for this entity.
+ */
+size_t endorse_compiled_entity_word_count(
+    const endorse_compiled_entity* entity)
+{
+    return ((size_t)entity->verb_count + 63) / 64;
+}
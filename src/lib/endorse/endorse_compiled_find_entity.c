@@ -0,0 +1,49 @@
+/**
+ * \file lib/endorse/endorse_compiled_find_entity.c
+ *
+ * \brief Find an entity in a compiled endorse config.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <string.h>
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Find an entity in a compiled endorse config.
+ *
+ * \param compiled      The compiled config to search.
+ * \param name          The entity name.
+ *
+ * \returns the entity, or NULL if it is not found.
+ */
+const endorse_compiled_entity* endorse_compiled_find_entity(
+    const endorse_compiled* compiled, const char* name)
+{
+    size_t low = 0;
+    size_t high = compiled->header->entity_count;
+
+    /* the entity table is sorted by name. */
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        const endorse_compiled_entity* entity = &compiled->entities[mid];
+        int result = strcmp(name, compiled->strings + entity->name);
+
+        if (result < 0)
+        {
+            high = mid;
+        }
+        else if (result > 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            return entity;
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,51 @@
+/**
+ * \file lib/endorse/endorse_compiled_find_verb.c
+ *
+ * \brief Find a verb of an entity in a compiled endorse config.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <string.h>
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Find a verb of an entity in a compiled endorse config.
+ *
+ * \param compiled      The compiled config to search.
+ * \param entity        The entity to search.
+ * \param name          The verb name.
+ *
+ * \returns the verb, or NULL if it is not found.
+ */
+const endorse_compiled_verb* endorse_compiled_find_verb(
+    const endorse_compiled* compiled, const endorse_compiled_entity* entity,
+    const char* name)
+{
+    const endorse_compiled_verb* verbs = compiled->verbs + entity->verb_offset;
+    size_t low = 0;
+    size_t high = entity->verb_count;
+
+    /* the verbs of this entity are sorted by name. */
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        int result = strcmp(name, compiled->strings + verbs[mid].name);
+
+        if (result < 0)
+        {
+            high = mid;
+        }
+        else if (result > 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            return &verbs[mid];
+        }
+    }
+
+    return NULL;
+}
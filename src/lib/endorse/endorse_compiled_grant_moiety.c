@@ -0,0 +1,64 @@
+/**
+ * \file lib/endorse/endorse_compiled_grant_moiety.c
+ *
+ * \brief Grant the verbs of a role or verb in a verb bitset.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <vctool/status_codes.h>
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Grant the verbs of a role or verb of an entity by setting them in a
+ * verb bitset.
+ *
+ * Bit i of the bitset is the i-th verb of the entity. A role is granted with a
+ * bitwise OR of its resolved verbs, so granting several roles that share verbs
+ * sets each verb only once.
+ *
+ * \param grants        The verb bitset for this entity, which must hold
+ *                      endorse_compiled_entity_word_count() words.
+ * \param compiled      The compiled config to search.
+ * \param entity        The entity to search.
+ * \param moiety        The role or verb name.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_UNKNOWN_ROLE_OR_VERB if the moiety is not found.
+ */
+status endorse_compiled_grant_moiety(
+    uint64_t* grants, const endorse_compiled* compiled,
+    const endorse_compiled_entity* entity, const char* moiety)
+{
+    const endorse_compiled_role* role;
+    const endorse_compiled_verb* verb;
+    size_t word_count = endorse_compiled_entity_word_count(entity);
+
+    /* a role grants the union of its resolved verbs. */
+    role = endorse_compiled_find_role(compiled, entity, moiety);
+    if (NULL != role)
+    {
+        const uint64_t* bits = compiled->bits + role->bits_offset;
+        for (size_t i = 0; i < word_count; ++i)
+        {
+            grants[i] |= bits[i];
+        }
+
+        return STATUS_SUCCESS;
+    }
+
+    /* a verb grants only itself. */
+    verb = endorse_compiled_find_verb(compiled, entity, moiety);
+    if (NULL != verb)
+    {
+        size_t index = (size_t)(verb - (compiled->verbs + entity->verb_offset));
+        grants[index / 64] |= UINT64_C(1) << (index % 64);
+
+        return STATUS_SUCCESS;
+    }
+
+    /* the moiety is unknown. */
+    return VCTOOL_ERROR_ENDORSE_UNKNOWN_ROLE_OR_VERB;
+}
@@ -0,0 +1,119 @@
+/**
+ * \file lib/endorse/endorse_compiled_load.c
+ *
+ * \brief Map a compiled endorse config image from a cache file.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vccrypt/compare.h>
+#include <vctool/status_codes.h>
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Map a compiled endorse config image from the given cache file.
+ *
+ * The cache file must be owned by the effective user, and must not be writable
+ * by its group or by others. The image is validated, and is rejected if it was
+ * not compiled from sources with the given digest.
+ *
+ * \param compiled      Pointer to receive the compiled config on success.
+ * \param alloc         The allocator to use for this operation.
+ * \param f             The file interface to use.
+ * \param filename      The cache filename.
+ * \param source_digest The SHA-512 digest of the current endorse config
+ *                      sources.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_COMPILED_UNTRUSTED if the cache file could have
+ *        been written by another user.
+ *      - VCTOOL_ERROR_ENDORSE_COMPILED_STALE if the cache was compiled from
+ *        different sources.
+ *      - a non-zero error code on failure.
+ */
+status endorse_compiled_load(
+    endorse_compiled** compiled, RCPR_SYM(allocator)* alloc, file* f,
+    const char* filename, const uint8_t* source_digest)
+{
+    status retval;
+    int desc;
+    file_stat_st fst;
+    const void* image;
+    size_t image_size;
+    const endorse_compiled_header* header;
+
+    /* open the cache file. */
+    retval = file_open(f, &desc, filename, O_RDONLY, 0);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* get the owner, mode, and size of the cache file. */
+    retval = file_fstat(f, desc, &fst);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_desc;
+    }
+
+    /* only trust a cache that no other user could have written. */
+    if (fst.fst_uid != geteuid()
+     || 0 != (fst.fst_mode & (S_IWGRP | S_IWOTH)))
+    {
+        retval = VCTOOL_ERROR_ENDORSE_COMPILED_UNTRUSTED;
+        goto cleanup_desc;
+    }
+
+    /* the cache file must at least hold a header. */
+    image_size = (size_t)fst.fst_size;
+    if (image_size < sizeof(*header))
+    {
+        retval = VCTOOL_ERROR_ENDORSE_COMPILED_INVALID;
+        goto cleanup_desc;
+    }
+
+    /* map the cache file. */
+    retval = file_mmap(f, desc, image_size, &image);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_desc;
+    }
+
+    /* the cache is stale if the sources have changed. */
+    header = (const endorse_compiled_header*)image;
+    if (crypto_memcmp(
+            header->source_digest, source_digest,
+            ENDORSE_COMPILED_DIGEST_SIZE))
+    {
+        retval = VCTOOL_ERROR_ENDORSE_COMPILED_STALE;
+        goto cleanup_image;
+    }
+
+    /* validate and wrap the image. */
+    retval =
+        endorse_compiled_create(
+            compiled, alloc, (void*)image, image_size, f);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_image;
+    }
+
+    /* success. The compiled config now owns the mapping. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_desc;
+
+cleanup_image:
+    file_munmap(f, image, image_size);
+
+cleanup_desc:
+    /* the mapping outlives the descriptor. */
+    file_close(f, desc);
+
+done:
+    return retval;
+}
@@ -0,0 +1,61 @@
+/**
+ * \file lib/endorse/endorse_compiled_resource_release.c
+ *
+ * \brief Release a compiled endorse config.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <string.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Release a compiled endorse config.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_compiled_resource_release(RCPR_SYM(resource)* r)
+{
+    status image_retval = STATUS_SUCCESS;
+    status reclaim_retval;
+    endorse_compiled* compiled = (endorse_compiled*)r;
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = compiled->alloc;
+
+    /* release the image. */
+    if (compiled->mapped)
+    {
+        image_retval =
+            file_munmap(
+                compiled->f, compiled->image, compiled->image_size);
+    }
+    else
+    {
+        image_retval = rcpr_allocator_reclaim(alloc, compiled->image);
+    }
+
+    /* clear memory. */
+    memset(compiled, 0, sizeof(*compiled));
+
+    /* reclaim the compiled config. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, compiled);
+
+    /* decode return status. */
+    if (STATUS_SUCCESS != image_retval)
+    {
+        return image_retval;
+    }
+    else
+    {
+        return reclaim_retval;
+    }
+}
@@ -0,0 +1,35 @@
+/**
+ * \file lib/endorse/endorse_compiled_string_compare.c
+ *
+ * \brief Compare two compiled strings by value.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <string.h>
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Compare two compiled strings by value, for use with qsort and
+ * bsearch.
+ *
+ * \param lhs           The left-hand side of the comparison.
+ * \param rhs           The right-hand side of the comparison.
+ *
+ * \returns less than, equal to, or greater than zero if \p lhs is less than,
+ * equal to, or greater than \p rhs.
+ */
+int endorse_compiled_string_compare(const void* lhs, const void* rhs)
+{
+    const endorse_compiled_string* l = (const endorse_compiled_string*)lhs;
+    const endorse_compiled_string* r = (const endorse_compiled_string*)rhs;
+
+    /* interned names are equal if they are the same pointer. */
+    if (l->str == r->str)
+    {
+        return 0;
+    }
+
+    return strcmp(l->str, r->str);
+}
@@ -0,0 +1,131 @@
+/**
+ * \file lib/endorse/endorse_compiled_write.c
+ *
+ * \brief Write a compiled endorse config image to a cache file.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vctool/status_codes.h>
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Write a compiled endorse config image to the given cache file.
+ *
+ * The image is written to a temporary file which is then renamed over the
+ * cache file, so concurrent readers never see a partial image. The cache file
+ * is only writable by its owner.
+ *
+ * \param f             The file interface to use.
+ * \param compiled      The compiled config to write.
+ * \param filename      The cache filename.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_compiled_write(
+    file* f, const endorse_compiled* compiled, const char* filename)
+{
+    status retval, release_retval;
+    int desc;
+    char* tmpname;
+    size_t tmpname_size;
+    size_t offset, wrote_size;
+    const uint8_t* data = (const uint8_t*)compiled->image;
+
+    /* compute the temporary filename length. */
+    tmpname_size =
+        strlen(filename)
+      + 1  /* . */
+      + 20 /* the process id. */
+      + 4  /* .tmp */
+      + 1; /* asciiz */
+
+    /* allocate memory for the temporary filename. */
+    tmpname = (char*)malloc(tmpname_size);
+    if (NULL == tmpname)
+    {
+        retval = VCTOOL_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* the temporary file is unique to this process. */
+    snprintf(tmpname, tmpname_size, "%s.%ld.tmp", filename, (long)getpid());
+
+    /* a temporary file left by an interrupted run is replaced. */
+    (void)file_unlink(f, tmpname);
+
+    /* create the temporary file alongside the cache file. */
+    retval =
+        file_open(
+            f, &desc, tmpname, O_CREAT | O_EXCL | O_WRONLY,
+            S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_tmpname;
+    }
+
+    /* write the image. */
+    for (offset = 0; offset < compiled->image_size; offset += wrote_size)
+    {
+        retval =
+            file_write(
+                f, desc, data + offset, compiled->image_size - offset,
+                &wrote_size);
+        if (VCTOOL_ERROR_FILE_INTERRUPT == retval)
+        {
+            wrote_size = 0;
+        }
+        else if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_desc;
+        }
+        else if (0 == wrote_size)
+        {
+            retval = VCTOOL_ERROR_FILE_IO;
+            goto cleanup_desc;
+        }
+    }
+
+    /* close the file. */
+    retval = file_close(f, desc);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_tmpfile;
+    }
+
+    /* replace the cache file. */
+    retval = file_rename(f, tmpname, filename);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_tmpfile;
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_tmpname;
+
+cleanup_desc:
+    release_retval = file_close(f, desc);
+    if (VCTOOL_STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_tmpfile:
+    (void)file_unlink(f, tmpname);
+
+cleanup_tmpname:
+    free(tmpname);
+
+done:
+    return retval;
+}
@@ -3,7 +3,7 @@
  *
  * \brief Create an endorse config context for parsing.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include <string.h>
@@ -38,7 +38,7 @@ status endorse_config_create_ex(
     endorse_config_set_error_fn set_error,
     endorse_config_val_callback_fn val_callback, void* user_context)
 {
-    status retval;
+    status retval, release_retval;
     endorse_config_context* tmp;
 
     /* allocate memory for the context. */
@@ -60,11 +60,25 @@ status endorse_config_create_ex(
     tmp->val_callback = val_callback;
     tmp->user_context = user_context;
 
+    /* create the symbol table for identifiers. */
+    retval = endorse_symbol_table_create(&tmp->symbols, alloc);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_context;
+    }
+
     /* Set the context on success. */
     *context = tmp;
     retval = STATUS_SUCCESS;
     goto done;
 
+cleanup_context:
+    release_retval = resource_release(&tmp->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
 done:
     return retval;
 }
@@ -80,12 +94,29 @@ done:
  */
 static status endorse_config_context_resource_release(resource* r)
 {
+    status symbols_retval = STATUS_SUCCESS;
+    status reclaim_retval;
     endorse_config_context* context = (endorse_config_context*)r;
 
     /* cache allocator. */
     rcpr_allocator* alloc = context->alloc;
 
+    /* release the symbol table, if set. */
+    if (NULL != context->symbols)
+    {
+        symbols_retval = resource_release(&context->symbols->hdr);
+    }
+
     /* reclaim memory. */
-    return
-        rcpr_allocator_reclaim(alloc, context);
+    reclaim_retval = rcpr_allocator_reclaim(alloc, context);
+
+    /* decode return status. */
+    if (STATUS_SUCCESS != symbols_retval)
+    {
+        return symbols_retval;
+    }
+    else
+    {
+        return reclaim_retval;
+    }
 }
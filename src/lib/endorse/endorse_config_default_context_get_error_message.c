@@ -3,7 +3,7 @@
  *
  * \brief Get the Nth error message from the default endorse config.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include <vctool/status_codes.h>
@@ -44,13 +44,19 @@ status endorse_config_default_context_get_error_message(
     }
 
     /* iterate through each error in the list. */
-    while (index-- && NULL != node)
+    while (index > 0 && NULL != node)
     {
         retval = slist_node_next(&node, node);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+
+        --index;
     }
 
     /* was the Nth entry found? */
-    if (0 == index)
+    if (0 == index && NULL != node)
     {
         /* get the error message node. */
         retval = slist_node_child(&r, node);
@@ -3,7 +3,7 @@
  *
  * \brief Create an error message node.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include <string.h>
@@ -47,15 +47,18 @@ status endorse_config_error_message_node_create(
 
     /* set values. */
     tmp->alloc = alloc;
-    tmp->msg = strdup(msg);
 
-    /* verify that the message was copied. */
-    if (NULL == tmp->msg)
+    /* copy the message using the same allocator. */
+    size_t msg_size = strlen(msg) + 1;
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp->msg, msg_size);
+    if (STATUS_SUCCESS != retval)
     {
-        retval = ERROR_GENERAL_OUT_OF_MEMORY;
+        tmp->msg = NULL;
         goto cleanup_tmp;
     }
 
+    memcpy(tmp->msg, msg, msg_size);
+
     /* success. */
     retval = STATUS_SUCCESS;
     *node = tmp;
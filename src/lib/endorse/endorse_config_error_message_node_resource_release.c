@@ -3,7 +3,7 @@
  *
  * \brief Release an error message node.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include <string.h>
@@ -31,13 +31,23 @@ status endorse_config_error_message_node_resource_release(
     /* cache allocator. */
     rcpr_allocator* alloc = node->alloc;
 
-    /* clean up error message, if set. */
+    /* reclaim the error message, if set. */
+    status msg_retval = STATUS_SUCCESS;
     if (NULL != node->msg)
     {
-        free(node->msg);
+        msg_retval = rcpr_allocator_reclaim(alloc, node->msg);
     }
 
     /* reclaim memory. */
-    return
-        rcpr_allocator_reclaim(alloc, node);
+    status node_retval = rcpr_allocator_reclaim(alloc, node);
+
+    /* decode return status. */
+    if (STATUS_SUCCESS != msg_retval)
+    {
+        return msg_retval;
+    }
+    else
+    {
+        return node_retval;
+    }
 }
@@ -0,0 +1,36 @@
+/**
+ * \file lib/endorse/endorse_hash.c
+ *
+ * \brief Compute the 64-bit FNV-1a hash of a buffer.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+#define ENDORSE_FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define ENDORSE_FNV_PRIME 0x100000001b3ULL
+
+/**
+ * \brief Compute the 64-bit FNV-1a hash of a buffer.
+ *
+ * This is the one hash used by the endorse hash tables.
+ *
+ * \param data          The data to hash.
+ * \param size          The size of the data.
+ *
+ * \returns the 64-bit FNV-1a hash of the data.
+ */
+uint64_t endorse_hash(const void* data, size_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint64_t hash = ENDORSE_FNV_OFFSET_BASIS;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= ENDORSE_FNV_PRIME;
+    }
+
+    return hash;
+}
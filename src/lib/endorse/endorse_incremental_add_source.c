@@ -0,0 +1,231 @@
+/**
+ * \file lib/endorse/endorse_incremental_add_source.c
+ *
+ * \brief Split a source into blocks for the next incremental commit.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <ctype.h>
+#include <string.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/* forward decls. */
+static void endorse_incremental_classify_header(
+    endorse_block* block, const char* header, size_t size);
+static size_t endorse_incremental_read_word(
+    const char** word, const char* str, size_t size, size_t* offset);
+static status endorse_incremental_append_block(
+    endorse_incremental* inc, const endorse_block* block);
+
+/**
+ * \brief Add a source to the next update of an incremental endorse config.
+ *
+ * Each block runs from its header to the brace that closes it, so the source
+ * is split with a single scan that only counts braces; the blocks themselves
+ * are left for the parser.
+ *
+ * \param inc           The incremental config.
+ * \param source        The source to add. It need not be ASCIIZ.
+ * \param size          The size of the source.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_incremental_add_source(
+    endorse_incremental* inc, const void* source, size_t size)
+{
+    status retval;
+    const char* str = (const char*)source;
+    size_t offset = 0;
+    size_t lbrace, end, depth;
+    endorse_block block;
+
+    for (;;)
+    {
+        /* skip whitespace between blocks. */
+        while (offset < size && isspace((unsigned char)str[offset]))
+        {
+            ++offset;
+        }
+
+        if (offset == size)
+        {
+            break;
+        }
+
+        /* the header runs up to the opening brace. */
+        lbrace = offset;
+        while (lbrace < size && '{' != str[lbrace] && '}' != str[lbrace])
+        {
+            ++lbrace;
+        }
+
+        memset(&block, 0, sizeof(block));
+        block.kind = ENDORSE_BLOCK_UNKNOWN;
+
+        /* find the brace that closes this block. */
+        if (lbrace < size && '{' == str[lbrace])
+        {
+            endorse_incremental_classify_header(
+                &block, str + offset, lbrace - offset);
+
+            depth = 0;
+            for (end = lbrace; end < size; ++end)
+            {
+                if ('{' == str[end])
+                {
+                    ++depth;
+                }
+                else if ('}' == str[end] && 0 == --depth)
+                {
+                    ++end;
+                    break;
+                }
+            }
+
+            /* an unterminated block is left for the parser to report. */
+            if (depth > 0)
+            {
+                block.kind = ENDORSE_BLOCK_UNKNOWN;
+            }
+        }
+        else
+        {
+            /* a stray brace or trailing text ends an unknown block. */
+            end = (lbrace < size) ? lbrace + 1 : size;
+        }
+
+        block.text = str + offset;
+        block.size = end - offset;
+        block.hash = endorse_hash(block.text, block.size);
+
+        retval = endorse_incremental_append_block(inc, &block);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        offset = end;
+    }
+
+    /* success. */
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Classify a block by its header, which must be `entities`,
+ * `verbs for X`, or `roles for X`.
+ */
+static void endorse_incremental_classify_header(
+    endorse_block* block, const char* header, size_t size)
+{
+    const char* words[4];
+    size_t sizes[4];
+    size_t count = 0;
+    size_t offset = 0;
+
+    /* split the header into at most four words. */
+    while (count < 4)
+    {
+        sizes[count] =
+            endorse_incremental_read_word(&words[count], header, size, &offset);
+        if (0 == sizes[count])
+        {
+            break;
+        }
+
+        ++count;
+    }
+
+    if (1 == count && 8 == sizes[0] && !memcmp(words[0], "entities", 8))
+    {
+        block->kind = ENDORSE_BLOCK_ENTITIES;
+    }
+    else if (
+        3 == count && 3 == sizes[1] && !memcmp(words[1], "for", 3)
+     && (isalpha((unsigned char)words[2][0]) || '_' == words[2][0]))
+    {
+        if (5 == sizes[0] && !memcmp(words[0], "verbs", 5))
+        {
+            block->kind = ENDORSE_BLOCK_VERBS;
+        }
+        else if (5 == sizes[0] && !memcmp(words[0], "roles", 5))
+        {
+            block->kind = ENDORSE_BLOCK_ROLES;
+        }
+
+        block->name = words[2];
+        block->name_size = sizes[2];
+    }
+}
+
+/**
+ * \brief Read the next whitespace delimited word of a block header.
+ */
+static size_t endorse_incremental_read_word(
+    const char** word, const char* str, size_t size, size_t* offset)
+{
+    size_t start;
+
+    while (*offset < size && isspace((unsigned char)str[*offset]))
+    {
+        ++*offset;
+    }
+
+    start = *offset;
+    while (*offset < size && !isspace((unsigned char)str[*offset]))
+    {
+        ++*offset;
+    }
+
+    *word = str + start;
+    return *offset - start;
+}
+
+/**
+ * \brief Append a block to the pending blocks, growing the array as needed.
+ */
+static status endorse_incremental_append_block(
+    endorse_incremental* inc, const endorse_block* block)
+{
+    status retval;
+    void* tmp;
+    size_t capacity;
+
+    if (inc->pending_count == inc->pending_capacity)
+    {
+        capacity =
+            (0 == inc->pending_capacity) ? 16 : 2 * inc->pending_capacity;
+
+        if (NULL == inc->pending)
+        {
+            retval =
+                rcpr_allocator_allocate(
+                    inc->alloc, &tmp, capacity * sizeof(endorse_block));
+        }
+        else
+        {
+            tmp = inc->pending;
+            retval =
+                rcpr_allocator_reallocate(
+                    inc->alloc, &tmp, capacity * sizeof(endorse_block));
+        }
+
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        inc->pending = (endorse_block*)tmp;
+        inc->pending_capacity = capacity;
+    }
+
+    inc->pending[inc->pending_count++] = *block;
+
+    return STATUS_SUCCESS;
+}
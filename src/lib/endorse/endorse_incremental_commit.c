@@ -0,0 +1,843 @@
+/**
+ * \file lib/endorse/endorse_incremental_commit.c
+ *
+ * \brief Update an incremental endorse config from its pending blocks.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <vctool/status_codes.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_rbtree;
+RCPR_IMPORT_resource;
+RCPR_IMPORT_slist;
+
+/* forward decls. */
+static uint64_t endorse_incremental_mix(uint64_t hash, uint64_t value);
+static int endorse_incremental_name_compare(
+    const char* name, size_t name_size, const char* str);
+static int endorse_incremental_block_order_compare(
+    const void* lhs, const void* rhs);
+static int endorse_incremental_hash_compare(const void* lhs, const void* rhs);
+static endorse_incremental_unit* endorse_incremental_find_unit(
+    endorse_incremental_unit* units, size_t count, const char* name,
+    size_t name_size);
+static void endorse_incremental_clear_errors(endorse_incremental* inc);
+static status endorse_incremental_add_error(
+    endorse_incremental* inc, const char* msg);
+static status endorse_incremental_collect_errors(
+    endorse_incremental* inc, endorse_config_context* context);
+static status endorse_incremental_parse(
+    endorse_incremental* inc, endorse_config_context** context,
+    const char* text, size_t size);
+static status endorse_incremental_parse_declarations(
+    endorse_incremental* inc, endorse_config_context** context);
+static status endorse_incremental_build_unit(
+    endorse_incremental* inc, endorse_incremental_unit* unit,
+    const char* name, size_t name_size, bool declared,
+    const endorse_block* const* order, size_t order_count);
+static status endorse_incremental_release_units(
+    endorse_incremental_unit* units, size_t count, bool fresh_only);
+
+/** \brief The header of a synthesized entity declaration. */
+#define DECLARATION_PREFIX "entities { "
+
+/** \brief The footer of a synthesized entity declaration. */
+#define DECLARATION_SUFFIX " }\n"
+
+/**
+ * \brief Update an incremental endorse config from the sources added since
+ * the last commit.
+ *
+ * The blocks for each entity are hashed together into a signature. An entity
+ * whose signature matches the last good update keeps its analyzed context;
+ * every other entity is parsed and analyzed from its own blocks alone.
+ *
+ * \param inc           The incremental config.
+ * \param stats         Pointer to receive the statistics for this update.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_INVALID_CONFIG if the sources have errors.
+ *      - a non-zero error code on failure.
+ */
+status endorse_incremental_commit(
+    endorse_incremental* inc, endorse_incremental_stats* stats)
+{
+    status retval, release_retval;
+    bool fail = false;
+    uint64_t declarations_signature = 0;
+    endorse_config_context* declarations = NULL;
+    endorse_config_context* context;
+    const endorse_block** order = NULL;
+    size_t order_count = 0;
+    uint64_t* block_hashes = NULL;
+    endorse_incremental_unit* units = NULL;
+    size_t unit_count = 0;
+    const endorse_config* declared_root;
+    rbtree_node* nil;
+    rbtree_node* node;
+    endorse_entity* declared;
+    endorse_incremental_unit* old;
+    size_t error_count;
+    const char* name;
+    size_t name_size, group_end;
+    int cmp;
+
+    /* start this update with no errors. */
+    endorse_incremental_clear_errors(inc);
+    memset(stats, 0, sizeof(*stats));
+    stats->block_count = inc->pending_count;
+
+    /* allocate the block order and block hash arrays. */
+    retval =
+        rcpr_allocator_allocate(
+            inc->alloc, (void**)&order,
+            (inc->pending_count + 1) * sizeof(const endorse_block*));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_pending;
+    }
+
+    retval =
+        rcpr_allocator_allocate(
+            inc->alloc, (void**)&block_hashes,
+            (inc->pending_count + 1) * sizeof(uint64_t));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_order;
+    }
+
+    /* walk the blocks, counting those not in the last good update. */
+    for (size_t i = 0; i < inc->pending_count; ++i)
+    {
+        const endorse_block* block = &inc->pending[i];
+
+        block_hashes[i] = block->hash;
+        if (NULL == inc->block_hashes
+         || NULL == bsearch(
+                        &block->hash, inc->block_hashes,
+                        inc->block_hash_count, sizeof(uint64_t),
+                        &endorse_incremental_hash_compare))
+        {
+            ++stats->blocks_changed;
+        }
+
+        switch (block->kind)
+        {
+            case ENDORSE_BLOCK_ENTITIES:
+                declarations_signature =
+                    endorse_incremental_mix(
+                        declarations_signature, block->hash);
+                break;
+
+            case ENDORSE_BLOCK_VERBS:
+            case ENDORSE_BLOCK_ROLES:
+                order[order_count++] = block;
+                break;
+
+            default:
+                /* an unknown block is parsed only for its errors. */
+                error_count = inc->error_count;
+                retval =
+                    endorse_incremental_parse(
+                        inc, &context, block->text, block->size);
+                if (STATUS_SUCCESS != retval)
+                {
+                    goto cleanup_block_hashes;
+                }
+
+                if (NULL != context)
+                {
+                    retval = resource_release(&context->hdr);
+                    if (STATUS_SUCCESS != retval)
+                    {
+                        goto cleanup_block_hashes;
+                    }
+                }
+
+                if (error_count == inc->error_count)
+                {
+                    retval =
+                        endorse_incremental_add_error(
+                            inc, "Unexpected text outside of a block.");
+                    if (STATUS_SUCCESS != retval)
+                    {
+                        goto cleanup_block_hashes;
+                    }
+                }
+
+                fail = true;
+                break;
+        }
+    }
+
+    /* the declarations are only parsed again if an entities block changed. */
+    if (NULL == inc->declarations
+     || declarations_signature != inc->declarations_signature)
+    {
+        retval = endorse_incremental_parse_declarations(inc, &declarations);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_block_hashes;
+        }
+
+        if (NULL == declarations)
+        {
+            fail = true;
+        }
+    }
+
+    if (fail)
+    {
+        retval = VCTOOL_ERROR_ENDORSE_INVALID_CONFIG;
+        goto cleanup_declarations;
+    }
+
+    /* group the verbs and roles blocks by entity, keeping source order. */
+    qsort(
+        order, order_count, sizeof(const endorse_block*),
+        &endorse_incremental_block_order_compare);
+
+    /* there is at most one unit per declaration or block. */
+    declared_root =
+        endorse_config_default_context_get_endorse_config_root(
+            (NULL != declarations) ? declarations : inc->declarations);
+    retval =
+        rcpr_allocator_allocate(
+            inc->alloc, (void**)&units,
+            (rbtree_count(declared_root->entities) + order_count + 1)
+                * sizeof(endorse_incremental_unit));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_declarations;
+    }
+
+    /* walk the declarations and block groups together, in name order. */
+    nil = rbtree_nil_node(declared_root->entities);
+    node = rbtree_root_node(declared_root->entities);
+    if (nil != node)
+    {
+        node = rbtree_minimum_node(declared_root->entities, node);
+    }
+
+    for (size_t i = 0; i < order_count || nil != node; )
+    {
+        declared =
+            (nil != node)
+                ? (endorse_entity*)rbtree_node_value(
+                    declared_root->entities, node)
+                : NULL;
+
+        /* pick the next name, from a declaration, a block group, or both. */
+        if (i < order_count)
+        {
+            name = order[i]->name;
+            name_size = order[i]->name_size;
+            cmp =
+                (NULL == declared)
+                    ? -1
+                    : endorse_incremental_name_compare(
+                        name, name_size, declared->id);
+        }
+        else
+        {
+            cmp = 1;
+        }
+
+        if (cmp > 0)
+        {
+            name = declared->id;
+            name_size = strlen(declared->id);
+        }
+
+        /* find the end of the block group for this name. */
+        group_end = i;
+        if (cmp <= 0)
+        {
+            while (
+                group_end < order_count
+             && name_size == order[group_end]->name_size
+             && !memcmp(name, order[group_end]->name, name_size))
+            {
+                ++group_end;
+            }
+        }
+
+        /* the signature covers the declaration and every block, in order. */
+        uint64_t signature = endorse_incremental_mix(0, (cmp >= 0));
+        for (size_t j = i; j < group_end; ++j)
+        {
+            signature =
+                endorse_incremental_mix(signature, order[j]->hash);
+        }
+
+        /* reuse the analyzed entity if nothing about it changed. */
+        old =
+            endorse_incremental_find_unit(
+                inc->units, inc->unit_count, name, name_size);
+        if (NULL != old && old->signature == signature)
+        {
+            units[unit_count] = *old;
+            units[unit_count].fresh = false;
+            ++unit_count;
+        }
+        else
+        {
+            retval =
+                endorse_incremental_build_unit(
+                    inc, &units[unit_count], name, name_size, (cmp >= 0),
+                    order + i, group_end - i);
+            if (STATUS_SUCCESS == retval)
+            {
+                units[unit_count].signature = signature;
+                ++unit_count;
+            }
+            else if (VCTOOL_ERROR_ENDORSE_INVALID_CONFIG == retval)
+            {
+                fail = true;
+            }
+            else
+            {
+                goto cleanup_units;
+            }
+
+            ++stats->entities_analyzed;
+        }
+
+        /* advance past this name. */
+        i = group_end;
+        if (cmp >= 0)
+        {
+            node = rbtree_successor_node(declared_root->entities, node);
+        }
+    }
+
+    stats->entity_count = unit_count;
+
+    if (fail)
+    {
+        retval = VCTOOL_ERROR_ENDORSE_INVALID_CONFIG;
+        goto cleanup_units;
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+
+    /* release the old units that were replaced or removed. */
+    for (size_t i = 0; i < inc->unit_count; ++i)
+    {
+        endorse_incremental_unit* kept =
+            endorse_incremental_find_unit(
+                units, unit_count, inc->units[i].name,
+                strlen(inc->units[i].name));
+
+        if (NULL == kept || kept->fresh)
+        {
+            release_retval = resource_release(&inc->units[i].context->hdr);
+            if (STATUS_SUCCESS != release_retval)
+            {
+                retval = release_retval;
+            }
+        }
+    }
+
+    /* install the new units. */
+    if (NULL != inc->units)
+    {
+        rcpr_allocator_reclaim(inc->alloc, inc->units);
+    }
+
+    inc->units = units;
+    inc->unit_count = unit_count;
+    units = NULL;
+
+    /* install the new declarations. */
+    if (NULL != declarations)
+    {
+        if (NULL != inc->declarations)
+        {
+            release_retval = resource_release(&inc->declarations->hdr);
+            if (STATUS_SUCCESS != release_retval)
+            {
+                retval = release_retval;
+            }
+        }
+
+        inc->declarations = declarations;
+        inc->declarations_signature = declarations_signature;
+        declarations = NULL;
+    }
+
+    /* save the block hashes of this update. */
+    qsort(
+        block_hashes, inc->pending_count, sizeof(uint64_t),
+        &endorse_incremental_hash_compare);
+    if (NULL != inc->block_hashes)
+    {
+        rcpr_allocator_reclaim(inc->alloc, inc->block_hashes);
+    }
+
+    inc->block_hashes = block_hashes;
+    inc->block_hash_count = inc->pending_count;
+    block_hashes = NULL;
+
+    inc->valid = true;
+    goto cleanup_declarations;
+
+cleanup_units:
+    release_retval =
+        endorse_incremental_release_units(units, unit_count, true);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    rcpr_allocator_reclaim(inc->alloc, units);
+
+cleanup_declarations:
+    if (NULL != declarations)
+    {
+        release_retval = resource_release(&declarations->hdr);
+        if (STATUS_SUCCESS != release_retval)
+        {
+            retval = release_retval;
+        }
+    }
+
+cleanup_block_hashes:
+    if (NULL != block_hashes)
+    {
+        rcpr_allocator_reclaim(inc->alloc, block_hashes);
+    }
+
+cleanup_order:
+    rcpr_allocator_reclaim(inc->alloc, order);
+
+cleanup_pending:
+    /* the sources of these blocks are only valid until this commit. */
+    inc->pending_count = 0;
+
+    return retval;
+}
+
+/**
+ * \brief Mix a value into a running signature.
+ */
+static uint64_t endorse_incremental_mix(uint64_t hash, uint64_t value)
+{
+    uint64_t words[2] = { hash, value };
+
+    return endorse_hash(words, sizeof(words));
+}
+
+/**
+ * \brief Compare a name slice to an ASCIIZ string, as strcmp would.
+ */
+static int endorse_incremental_name_compare(
+    const char* name, size_t name_size, const char* str)
+{
+    int result = strncmp(name, str, name_size);
+    if (0 != result)
+    {
+        return result;
+    }
+
+    return (0 == str[name_size]) ? 0 : -1;
+}
+
+/**
+ * \brief Order pending blocks by entity name, and then by source order.
+ */
+static int endorse_incremental_block_order_compare(
+    const void* lhs, const void* rhs)
+{
+    const endorse_block* lb = *(const endorse_block* const*)lhs;
+    const endorse_block* rb = *(const endorse_block* const*)rhs;
+    size_t size =
+        (lb->name_size < rb->name_size) ? lb->name_size : rb->name_size;
+
+    int result = memcmp(lb->name, rb->name, size);
+    if (0 != result)
+    {
+        return result;
+    }
+
+    if (lb->name_size != rb->name_size)
+    {
+        return (lb->name_size < rb->name_size) ? -1 : 1;
+    }
+
+    /* blocks are in one array, so their addresses are in source order. */
+    return (lb < rb) ? -1 : (lb > rb);
+}
+
+/**
+ * \brief Compare two block hashes, for use with qsort and bsearch.
+ */
+static int endorse_incremental_hash_compare(const void* lhs, const void* rhs)
+{
+    uint64_t l = *(const uint64_t*)lhs;
+    uint64_t r = *(const uint64_t*)rhs;
+
+    return (l < r) ? -1 : (l > r);
+}
+
+/**
+ * \brief Find the unit for an entity in an array of units sorted by name.
+ */
+static endorse_incremental_unit* endorse_incremental_find_unit(
+    endorse_incremental_unit* units, size_t count, const char* name,
+    size_t name_size)
+{
+    size_t lo = 0;
+    size_t hi = count;
+
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp =
+            endorse_incremental_name_compare(
+                name, name_size, units[mid].name);
+
+        if (0 == cmp)
+        {
+            return &units[mid];
+        }
+        else if (cmp < 0)
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Clear the error messages from the last commit.
+ */
+static void endorse_incremental_clear_errors(endorse_incremental* inc)
+{
+    for (size_t i = 0; i < inc->error_count; ++i)
+    {
+        rcpr_allocator_reclaim(inc->alloc, inc->errors[i]);
+    }
+
+    inc->error_count = 0;
+}
+
+/**
+ * \brief Append a copy of an error message to this commit.
+ */
+static status endorse_incremental_add_error(
+    endorse_incremental* inc, const char* msg)
+{
+    status retval;
+    void* tmp;
+    char* copy;
+    size_t size = strlen(msg) + 1;
+
+    /* grow the error array. */
+    if (NULL == inc->errors)
+    {
+        retval =
+            rcpr_allocator_allocate(
+                inc->alloc, &tmp, (inc->error_count + 1) * sizeof(char*));
+    }
+    else
+    {
+        tmp = inc->errors;
+        retval =
+            rcpr_allocator_reallocate(
+                inc->alloc, &tmp, (inc->error_count + 1) * sizeof(char*));
+    }
+
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    inc->errors = (char**)tmp;
+
+    /* copy the message. */
+    retval = rcpr_allocator_allocate(inc->alloc, (void**)&copy, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memcpy(copy, msg, size);
+    inc->errors[inc->error_count++] = copy;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Copy every error message from a default context to this commit.
+ */
+static status endorse_incremental_collect_errors(
+    endorse_incremental* inc, endorse_config_context* context)
+{
+    status retval;
+    slist_node* node;
+    resource* r;
+    endorse_config_default_user_context* user =
+        (endorse_config_default_user_context*)context->user_context;
+
+    retval = slist_head(&node, user->error_list);
+    while (STATUS_SUCCESS == retval && NULL != node)
+    {
+        retval = slist_node_child(&r, node);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        retval =
+            endorse_incremental_add_error(
+                inc, ((endorse_config_error_message_node*)r)->msg);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        retval = slist_node_next(&node, node);
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Parse text in a new default context.
+ *
+ * On success, \p context is set to the new context if the text parsed without
+ * errors, and to NULL otherwise, once the errors are collected.
+ */
+static status endorse_incremental_parse(
+    endorse_incremental* inc, endorse_config_context** context,
+    const char* text, size_t size)
+{
+    status retval, release_retval;
+    endorse_config_context* tmp;
+
+    retval = endorse_config_create_default(&tmp, inc->alloc);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* a parse failure is reported through the error list. */
+    retval = endorse_parse_mapped(tmp, text, size);
+    if (STATUS_SUCCESS == retval
+     && 0 == endorse_config_default_context_get_error_message_count(tmp))
+    {
+        *context = tmp;
+        return STATUS_SUCCESS;
+    }
+
+    retval = endorse_incremental_collect_errors(inc, tmp);
+    if (STATUS_SUCCESS == retval && 0 == inc->error_count)
+    {
+        retval =
+            endorse_incremental_add_error(inc, "Error parsing endorse config.");
+    }
+
+    release_retval = resource_release(&tmp->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    *context = NULL;
+    return retval;
+}
+
+/**
+ * \brief Parse every entities block together, so that duplicate declarations
+ * are reported just as they are in a full parse.
+ */
+static status endorse_incremental_parse_declarations(
+    endorse_incremental* inc, endorse_config_context** context)
+{
+    status retval;
+    char* text;
+    char* out;
+    size_t size = 0;
+
+    for (size_t i = 0; i < inc->pending_count; ++i)
+    {
+        if (ENDORSE_BLOCK_ENTITIES == inc->pending[i].kind)
+        {
+            size += inc->pending[i].size + 1;
+        }
+    }
+
+    retval = rcpr_allocator_allocate(inc->alloc, (void**)&text, size + 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    out = text;
+    for (size_t i = 0; i < inc->pending_count; ++i)
+    {
+        if (ENDORSE_BLOCK_ENTITIES == inc->pending[i].kind)
+        {
+            memcpy(out, inc->pending[i].text, inc->pending[i].size);
+            out += inc->pending[i].size;
+            *out++ = '\n';
+        }
+    }
+
+    retval = endorse_incremental_parse(inc, context, text, size);
+
+    rcpr_allocator_reclaim(inc->alloc, text);
+
+    return retval;
+}
+
+/**
+ * \brief Parse and analyze a single entity from its declaration and blocks.
+ *
+ * \returns STATUS_SUCCESS on success, VCTOOL_ERROR_ENDORSE_INVALID_CONFIG if
+ * the entity has errors, or a non-zero error code on failure.
+ */
+static status endorse_incremental_build_unit(
+    endorse_incremental* inc, endorse_incremental_unit* unit,
+    const char* name, size_t name_size, bool declared,
+    const endorse_block* const* order, size_t order_count)
+{
+    status retval, release_retval;
+    endorse_config_context* context;
+    endorse_config* root;
+    char* text;
+    char* out;
+    size_t size = 0;
+
+    /* the entity's own text is its declaration followed by its blocks. */
+    if (declared)
+    {
+        size +=
+            strlen(DECLARATION_PREFIX) + name_size + strlen(DECLARATION_SUFFIX);
+    }
+
+    for (size_t i = 0; i < order_count; ++i)
+    {
+        size += order[i]->size + 1;
+    }
+
+    retval = rcpr_allocator_allocate(inc->alloc, (void**)&text, size + 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    out = text;
+    if (declared)
+    {
+        memcpy(out, DECLARATION_PREFIX, strlen(DECLARATION_PREFIX));
+        out += strlen(DECLARATION_PREFIX);
+        memcpy(out, name, name_size);
+        out += name_size;
+        memcpy(out, DECLARATION_SUFFIX, strlen(DECLARATION_SUFFIX));
+        out += strlen(DECLARATION_SUFFIX);
+    }
+
+    for (size_t i = 0; i < order_count; ++i)
+    {
+        memcpy(out, order[i]->text, order[i]->size);
+        out += order[i]->size;
+        *out++ = '\n';
+    }
+
+    /* identifiers are interned, so the text isn't needed after the parse. */
+    retval = endorse_incremental_parse(inc, &context, text, size);
+    rcpr_allocator_reclaim(inc->alloc, text);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+    else if (NULL == context)
+    {
+        return VCTOOL_ERROR_ENDORSE_INVALID_CONFIG;
+    }
+
+    /* analyze this entity on its own. */
+    root =
+        (endorse_config*)
+        endorse_config_default_context_get_endorse_config_root(context);
+    if (STATUS_SUCCESS != endorse_analyze(context, root)
+     || 1 != rbtree_count(root->entities))
+    {
+        size_t error_count = inc->error_count;
+
+        retval = endorse_incremental_collect_errors(inc, context);
+        if (STATUS_SUCCESS == retval && error_count == inc->error_count)
+        {
+            retval =
+                endorse_incremental_add_error(
+                    inc, "Error analyzing endorse config.");
+        }
+
+        if (STATUS_SUCCESS == retval)
+        {
+            retval = VCTOOL_ERROR_ENDORSE_INVALID_CONFIG;
+        }
+
+        goto cleanup_context;
+    }
+
+    /* success. */
+    unit->entity =
+        (endorse_entity*)
+        rbtree_node_value(
+            root->entities, rbtree_root_node(root->entities));
+    unit->name = unit->entity->id;
+    unit->fresh = true;
+    unit->context = context;
+    return STATUS_SUCCESS;
+
+cleanup_context:
+    release_retval = resource_release(&context->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Release the context of each unit, or only of the fresh units.
+ */
+static status endorse_incremental_release_units(
+    endorse_incremental_unit* units, size_t count, bool fresh_only)
+{
+    status retval = STATUS_SUCCESS;
+    status release_retval;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (fresh_only && !units[i].fresh)
+        {
+            continue;
+        }
+
+        release_retval = resource_release(&units[i].context->hdr);
+        if (STATUS_SUCCESS != release_retval)
+        {
+            retval = release_retval;
+        }
+    }
+
+    return retval;
+}
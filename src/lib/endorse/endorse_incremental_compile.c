@@ -0,0 +1,99 @@
+/**
+ * \file lib/endorse/endorse_incremental_compile.c
+ *
+ * \brief Compile the analyzed config of an incremental endorse config.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <vctool/status_codes.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_rbtree;
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Compile the analyzed config from the last successful incremental
+ * commit into a flat image.
+ *
+ * The analyzed entities are shared by reference into an otherwise empty
+ * config, which is compiled and then released. The entities themselves are
+ * left untouched for the next commit.
+ *
+ * \param compiled      Pointer to receive the compiled config on success.
+ * \param alloc         The allocator to use for this operation.
+ * \param inc           The incremental config.
+ * \param source_digest The SHA-512 digest of the sources from which this
+ *                      config was parsed, which is recorded in the image.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_INVALID_CONFIG if no commit has succeeded.
+ *      - a non-zero error code on failure.
+ */
+status endorse_incremental_compile(
+    endorse_compiled** compiled, RCPR_SYM(allocator)* alloc,
+    const endorse_incremental* inc, const uint8_t* source_digest)
+{
+    status retval, release_retval;
+    endorse_config_context* context;
+    endorse_config* root;
+
+    /* there is nothing to compile until a commit succeeds. */
+    if (!inc->valid)
+    {
+        retval = VCTOOL_ERROR_ENDORSE_INVALID_CONFIG;
+        goto done;
+    }
+
+    /* create an empty config to hold the shared entities. */
+    retval = endorse_config_create_default(&context, alloc);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    retval = endorse_parse_mapped(context, "", 0);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_context;
+    }
+
+    root =
+        (endorse_config*)
+        endorse_config_default_context_get_endorse_config_root(context);
+
+    /* share each analyzed entity; releasing the config drops the reference. */
+    for (size_t i = 0; i < inc->unit_count; ++i)
+    {
+        endorse_entity* entity = inc->units[i].entity;
+
+        ++entity->reference_count;
+        retval = rbtree_insert(root->entities, &entity->hdr);
+        if (STATUS_SUCCESS != retval)
+        {
+            --entity->reference_count;
+            goto cleanup_context;
+        }
+    }
+
+    /* compile the shared config. */
+    retval = endorse_compile(compiled, alloc, root, source_digest);
+    goto cleanup_context;
+
+cleanup_context:
+    release_retval = resource_release(&context->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        if (STATUS_SUCCESS == retval)
+        {
+            resource_release(&(*compiled)->hdr);
+        }
+
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,55 @@
+/**
+ * \file lib/endorse/endorse_incremental_create.c
+ *
+ * \brief Create an incremental endorse config.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <string.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create an incremental endorse config.
+ *
+ * \param inc           Pointer to receive the incremental config on success.
+ * \param alloc         The allocator to use for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_incremental_create(
+    endorse_incremental** inc, RCPR_SYM(allocator)* alloc)
+{
+    status retval;
+    endorse_incremental* tmp;
+
+    /* allocate memory for the incremental config. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &endorse_incremental_resource_release);
+
+    /* set values. There is no analyzed config until the first commit. */
+    tmp->alloc = alloc;
+
+    /* success. */
+    *inc = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+done:
+    return retval;
+}
@@ -0,0 +1,29 @@
+/**
+ * \file lib/endorse/endorse_incremental_get_error_message.c
+ *
+ * \brief Get the Nth error message from the last incremental commit.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Get the Nth error message from the last incremental commit.
+ *
+ * \param inc           The incremental config.
+ * \param index         The error message index.
+ *
+ * \returns the error message, which is owned by the incremental config, or
+ * NULL if \p index is out of bounds.
+ */
+const char* endorse_incremental_get_error_message(
+    const endorse_incremental* inc, size_t index)
+{
+    if (index >= inc->error_count)
+    {
+        return NULL;
+    }
+
+    return inc->errors[index];
+}
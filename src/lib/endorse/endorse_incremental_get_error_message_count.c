@@ -0,0 +1,22 @@
+/**
+ * \file lib/endorse/endorse_incremental_get_error_message_count.c
+ *
+ * \brief Get the number of error messages from the last incremental commit.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Get the number of error messages from the last incremental commit.
+ *
+ * \param inc           The incremental config.
+ *
+ * \returns The number of error messages.
+ */
+size_t endorse_incremental_get_error_message_count(
+    const endorse_incremental* inc)
+{
+    return inc->error_count;
+}
@@ -0,0 +1,22 @@
+/**
+ * \file lib/endorse/endorse_incremental_resource_handle.c
+ *
+ * \brief Get the resource handle of an incremental endorse config.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Get the resource handle of an incremental endorse config.
+ *
+ * \param inc           The incremental config.
+ *
+ * \returns the resource handle, which releases the incremental config.
+ */
+RCPR_SYM(resource)* endorse_incremental_resource_handle(
+    endorse_incremental* inc)
+{
+    return &inc->hdr;
+}
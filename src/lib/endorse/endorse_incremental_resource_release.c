@@ -0,0 +1,87 @@
+/**
+ * \file lib/endorse/endorse_incremental_resource_release.c
+ *
+ * \brief Release an incremental endorse config.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <string.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Release an incremental endorse config, along with the context of
+ * each of its entities.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_incremental_resource_release(RCPR_SYM(resource)* r)
+{
+    status retval = STATUS_SUCCESS;
+    status release_retval;
+    endorse_incremental* inc = (endorse_incremental*)r;
+    rcpr_allocator* alloc = inc->alloc;
+
+    /* release the context of each entity. */
+    for (size_t i = 0; i < inc->unit_count; ++i)
+    {
+        release_retval = resource_release(&inc->units[i].context->hdr);
+        if (STATUS_SUCCESS != release_retval)
+        {
+            retval = release_retval;
+        }
+    }
+
+    /* release the declarations. */
+    if (NULL != inc->declarations)
+    {
+        release_retval = resource_release(&inc->declarations->hdr);
+        if (STATUS_SUCCESS != release_retval)
+        {
+            retval = release_retval;
+        }
+    }
+
+    /* reclaim the error messages. */
+    for (size_t i = 0; i < inc->error_count; ++i)
+    {
+        release_retval = rcpr_allocator_reclaim(alloc, inc->errors[i]);
+        if (STATUS_SUCCESS != release_retval)
+        {
+            retval = release_retval;
+        }
+    }
+
+    /* reclaim the arrays. */
+    void* arrays[] = {
+        inc->pending, inc->units, inc->block_hashes, inc->errors };
+    for (size_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); ++i)
+    {
+        if (NULL != arrays[i])
+        {
+            release_retval = rcpr_allocator_reclaim(alloc, arrays[i]);
+            if (STATUS_SUCCESS != release_retval)
+            {
+                retval = release_retval;
+            }
+        }
+    }
+
+    /* clear and reclaim the incremental config. */
+    memset(inc, 0, sizeof(*inc));
+    release_retval = rcpr_allocator_reclaim(alloc, inc);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
@@ -3,7 +3,7 @@
  *
  * \brief Internal declarations and definitions for endorse parser.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #pragma once
@@ -46,6 +46,129 @@ struct endorse_config_error_message_node
     char* msg;
 };
 
+/** \brief A slot in the symbol table. A slot with a NULL symbol is empty. */
+typedef struct endorse_symbol_table_entry endorse_symbol_table_entry;
+
+struct endorse_symbol_table_entry
+{
+    const char* symbol;
+    uint64_t hash;
+};
+
+/**
+ * \brief An open addressing hash set of interned identifiers.
+ *
+ * Each distinct identifier is stored once, so two interned identifiers are
+ * equal if and only if they are the same pointer.
+ */
+struct endorse_symbol_table
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    endorse_symbol_table_entry* slots;
+    size_t capacity;
+    size_t count;
+};
+
+/**
+ * \brief The scanner passed to the parser.
+ *
+ * When \p flex is set, tokens are read by the flex scanner. Otherwise, tokens
+ * are sliced directly out of the mapped source, which is never copied; only
+ * identifiers are copied, once, when they are interned.
+ */
+typedef struct endorse_scanner endorse_scanner;
+
+struct endorse_scanner
+{
+    yyscan_t flex;
+    endorse_config_context* context;
+    const char* base;
+    size_t size;
+    size_t offset;
+};
+
+/**
+ * \brief A string to be interned in a compiled endorse config.
+ */
+typedef struct endorse_compiled_string endorse_compiled_string;
+
+struct endorse_compiled_string
+{
+    const char* str;
+    uint32_t offset;
+};
+
+/**
+ * \brief The kind of a top-level endorse config block.
+ */
+typedef enum endorse_block_kind
+{
+    ENDORSE_BLOCK_ENTITIES,
+    ENDORSE_BLOCK_VERBS,
+    ENDORSE_BLOCK_ROLES,
+    ENDORSE_BLOCK_UNKNOWN
+} endorse_block_kind;
+
+/**
+ * \brief A top-level block of endorse config source.
+ *
+ * The text and entity name are slices of a source added to an incremental
+ * config. A block that can't be attributed to an entity is unknown, and is
+ * only parsed to report its errors.
+ */
+typedef struct endorse_block endorse_block;
+
+struct endorse_block
+{
+    endorse_block_kind kind;
+    const char* name;
+    size_t name_size;
+    const char* text;
+    size_t size;
+    uint64_t hash;
+};
+
+/**
+ * \brief A single analyzed entity of an incremental config, parsed from its
+ * declaration and its own blocks in a context of its own.
+ */
+typedef struct endorse_incremental_unit endorse_incremental_unit;
+
+struct endorse_incremental_unit
+{
+    const char* name;
+    uint64_t signature;
+    bool fresh;
+    endorse_config_context* context;
+    endorse_entity* entity;
+};
+
+/**
+ * \brief An incremental endorse config.
+ *
+ * The units are sorted by entity name. The declarations context holds the
+ * last good parse of every `entities` block, and the block hashes of the last
+ * good update are kept sorted to count the blocks that changed.
+ */
+struct endorse_incremental
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    endorse_block* pending;
+    size_t pending_count;
+    size_t pending_capacity;
+    endorse_incremental_unit* units;
+    size_t unit_count;
+    endorse_config_context* declarations;
+    uint64_t declarations_signature;
+    uint64_t* block_hashes;
+    size_t block_hash_count;
+    char** errors;
+    size_t error_count;
+    bool valid;
+};
+
 /**
  * \brief Set an error message in the default config.
  *
@@ -116,6 +239,161 @@ status endorse_config_error_message_node_create(
 status endorse_config_error_message_node_resource_release(
     RCPR_SYM(resource)* r);
 
+/**
+ * \brief Create a compiled endorse config from an image, validating the image.
+ *
+ * On success, the compiled config takes ownership of the image. On failure, the
+ * caller retains ownership of the image.
+ *
+ * \param compiled      Pointer to receive the compiled config on success.
+ * \param alloc         The allocator to use.
+ * \param image         The compiled image.
+ * \param image_size    The size of the compiled image.
+ * \param f             The file interface with which the image was memory
+ *                      mapped, or NULL if it was allocated using \p alloc.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_ENDORSE_COMPILED_INVALID if the image is invalid.
+ *      - a non-zero error code on failure.
+ */
+status endorse_compiled_create(
+    endorse_compiled** compiled, RCPR_SYM(allocator)* alloc, void* image,
+    size_t image_size, file* f);
+
+/**
+ * \brief Release a compiled endorse config.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_compiled_resource_release(RCPR_SYM(resource)* r);
+
+/**
+ * \brief Find a role of an entity in a compiled endorse config.
+ *
+ * \param compiled      The compiled config to search.
+ * \param entity        The entity to search.
+ * \param name          The role name.
+ *
+ * \returns the role, or NULL if it is not found.
+ */
+const endorse_compiled_role* endorse_compiled_find_role(
+    const endorse_compiled* compiled, const endorse_compiled_entity* entity,
+    const char* name);
+
+/**
+ * \brief Find a verb of an entity in a compiled endorse config.
+ *
+ * \param compiled      The compiled config to search.
+ * \param entity        The entity to search.
+ * \param name          The verb name.
+ *
+ * \returns the verb, or NULL if it is not found.
+ */
+const endorse_compiled_verb* endorse_compiled_find_verb(
+    const endorse_compiled* compiled, const endorse_compiled_entity* entity,
+    const char* name);
+
+/**
+ * \brief Release a verb set.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_verb_set_resource_release(RCPR_SYM(resource)* r);
+
+/**
+ * \brief Create an empty symbol table.
+ *
+ * \param table         Pointer to receive the symbol table on success.
+ * \param alloc         The allocator to use for the table and its symbols.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_symbol_table_create(
+    endorse_symbol_table** table, RCPR_SYM(allocator)* alloc);
+
+/**
+ * \brief Release a symbol table and every symbol interned in it.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_symbol_table_resource_release(RCPR_SYM(resource)* r);
+
+/**
+ * \brief Intern a string in the symbol table.
+ *
+ * \param symbol        Pointer to receive the interned symbol. It is owned by
+ *                      the symbol table.
+ * \param table         The symbol table.
+ * \param str           The string to intern. It need not be ASCIIZ.
+ * \param length        The length of the string.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_symbol_table_intern(
+    const char** symbol, endorse_symbol_table* table, const char* str,
+    size_t length);
+
+/**
+ * \brief Read the next token for the parser.
+ *
+ * \param lval          The semantic value for this token.
+ * \param scanner       The endorse_scanner for this parse.
+ *
+ * \returns the next token, or zero at the end of input.
+ */
+int endorse_lex(YYSTYPE* lval, yyscan_t scanner);
+
+/**
+ * \brief Read the next token directly from mapped endorse config source.
+ *
+ * \param lval          The semantic value for this token.
+ * \param scanner       The mapped scanner.
+ *
+ * \returns the next token, or zero at the end of input.
+ */
+int endorse_lex_mapped(YYSTYPE* lval, endorse_scanner* scanner);
+
+/**
+ * \brief Compare two compiled strings by value, for use with qsort and
+ * bsearch.
+ *
+ * \param lhs           The left-hand side of the comparison.
+ * \param rhs           The right-hand side of the comparison.
+ *
+ * \returns less than, equal to, or greater than zero if \p lhs is less than,
+ * equal to, or greater than \p rhs.
+ */
+int endorse_compiled_string_compare(const void* lhs, const void* rhs);
+
+/**
+ * \brief Release an incremental endorse config, along with the context of
+ * each of its entities.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_incremental_resource_release(RCPR_SYM(resource)* r);
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
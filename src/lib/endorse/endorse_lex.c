@@ -0,0 +1,35 @@
+/**
+ * \file lib/endorse/endorse_lex.c
+ *
+ * \brief Read the next token for the endorse config parser.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <vctool/endorse.h>
+
+#include "endorse_internal.h"
+#include "endorse.tab.h"
+#include "endorse.yy.h"
+
+/**
+ * \brief Read the next token for the parser.
+ *
+ * \param lval          The semantic value for this token.
+ * \param scanner       The endorse_scanner for this parse.
+ *
+ * \returns the next token, or zero at the end of input.
+ */
+int endorse_lex(YYSTYPE* lval, yyscan_t scanner)
+{
+    endorse_scanner* s = (endorse_scanner*)scanner;
+
+    /* use the flex scanner if this parse has one. */
+    if (NULL != s->flex)
+    {
+        return yylex(lval, s->flex);
+    }
+
+    /* otherwise, slice tokens out of the mapped source. */
+    return endorse_lex_mapped(lval, s);
+}
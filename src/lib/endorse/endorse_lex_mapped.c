@@ -0,0 +1,203 @@
+/**
+ * \file lib/endorse/endorse_lex_mapped.c
+ *
+ * \brief Read the next token directly from mapped endorse config source.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vctool/endorse.h>
+#include <vpr/uuid.h>
+
+#include "endorse_internal.h"
+#include "endorse.tab.h"
+
+/** \brief The length of a textual UUID. */
+#define ENDORSE_UUID_LENGTH 36
+
+/**
+ * \brief Return true if the given slice starts with a textual UUID.
+ */
+static bool is_uuid(const char* str, size_t size)
+{
+    if (size < ENDORSE_UUID_LENGTH)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < ENDORSE_UUID_LENGTH; ++i)
+    {
+        if (8 == i || 13 == i || 18 == i || 23 == i)
+        {
+            if ('-' != str[i])
+            {
+                return false;
+            }
+        }
+        else if (!isxdigit((unsigned char)str[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * \brief Return true if the given character can start an identifier.
+ */
+static bool is_identifier_start(char ch)
+{
+    return isalpha((unsigned char)ch) || '_' == ch;
+}
+
+/**
+ * \brief Return the keyword token for the given identifier slice, or zero if it
+ * is not a keyword.
+ */
+static int keyword(const char* str, size_t length)
+{
+    static const struct { const char* word; size_t length; int token; }
+    keywords[] = {
+        { "entities", 8, ENTITIES },
+        { "extends", 7, EXTENDS },
+        { "for", 3, FOR },
+        { "roles", 5, ROLES },
+        { "verbs", 5, VERBS },
+    };
+
+    for (size_t i = 0; i < sizeof(keywords) / sizeof(keywords[0]); ++i)
+    {
+        if (keywords[i].length == length
+         && !memcmp(keywords[i].word, str, length))
+        {
+            return keywords[i].token;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Read the next token directly from mapped endorse config source.
+ *
+ * Tokens are slices of the source. The source is never copied or modified;
+ * identifiers are copied exactly once, when they are interned. The longest
+ * match rules of the flex scanner are preserved.
+ *
+ * \param lval          The semantic value for this token.
+ * \param scanner       The mapped scanner.
+ *
+ * \returns the next token, or zero at the end of input.
+ */
+int endorse_lex_mapped(YYSTYPE* lval, endorse_scanner* scanner)
+{
+    const char* base = scanner->base;
+    size_t size = scanner->size;
+    size_t offset = scanner->offset;
+    size_t length;
+    int token;
+    char uuid[ENDORSE_UUID_LENGTH + 1];
+
+    /* skip whitespace. */
+    while (offset < size && isspace((unsigned char)base[offset]))
+    {
+        ++offset;
+    }
+
+    /* end of input. */
+    if (offset >= size)
+    {
+        scanner->offset = size;
+        return 0;
+    }
+
+    const char* start = base + offset;
+    size_t remaining = size - offset;
+
+    /* single character tokens. */
+    switch (*start)
+    {
+        case '{':
+            scanner->offset = offset + 1;
+            return LBRACE;
+
+        case '}':
+            scanner->offset = offset + 1;
+            return RBRACE;
+
+        case ',':
+            scanner->offset = offset + 1;
+            return COMMA;
+    }
+
+    /* a UUID is always longer than an identifier prefix it overlaps. */
+    if (is_uuid(start, remaining))
+    {
+        scanner->offset = offset + ENDORSE_UUID_LENGTH;
+
+        memcpy(uuid, start, ENDORSE_UUID_LENGTH);
+        uuid[ENDORSE_UUID_LENGTH] = 0;
+
+        lval->id = malloc(sizeof(*lval->id));
+        if (NULL == lval->id)
+        {
+            return UUID_INVALID;
+        }
+
+        memset(lval->id, 0, sizeof(*lval->id));
+        if (STATUS_SUCCESS != vpr_uuid_from_string(lval->id, uuid))
+        {
+            return UUID_INVALID;
+        }
+
+        return UUID;
+    }
+
+    /* identifiers and keywords. */
+    if (is_identifier_start(*start))
+    {
+        length = 1;
+        while (length < remaining
+            && (is_identifier_start(start[length])
+             || isdigit((unsigned char)start[length])))
+        {
+            ++length;
+        }
+
+        scanner->offset = offset + length;
+
+        token = keyword(start, length);
+        if (0 != token)
+        {
+            return token;
+        }
+
+        if (STATUS_SUCCESS !=
+                endorse_symbol_table_intern(
+                    &lval->string, scanner->context->symbols, start, length))
+        {
+            scanner->context->out_of_memory = true;
+            scanner->context->set_error(
+                scanner->context, "Out of memory interning identifier.");
+            lval->string = NULL;
+            return INVALID;
+        }
+
+        return IDENTIFIER;
+    }
+
+    /* any other character is an invalid token. */
+    scanner->offset = offset + 1;
+    if (STATUS_SUCCESS !=
+            endorse_symbol_table_intern(
+                &lval->string, scanner->context->symbols, start, 1))
+    {
+        lval->string = NULL;
+    }
+
+    return INVALID;
+}
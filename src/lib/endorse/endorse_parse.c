@@ -3,13 +3,15 @@
  *
  * \brief Parse endorse config data from the given input buffer.
  *
- * \copyright 2022 Velo Payments.  See License.txt for license terms.
+ * \copyright 2022-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <vctool/endorse.h>
 #include <vctool/status_codes.h>
 
+#include "endorse_internal.h"
 #include "endorse.tab.h"
 #include "endorse.yy.h"
 
@@ -29,9 +31,10 @@ status endorse_parse(
     status retval;
     YY_BUFFER_STATE state;
     yyscan_t scanner;
+    endorse_scanner wrapper;
 
-    /* initialize the scanner. */
-    retval = yylex_init(&scanner);
+    /* initialize the scanner, giving it the context for interning. */
+    retval = yylex_init_extra(context, &scanner);
     if (STATUS_SUCCESS != retval)
     {
         fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
@@ -47,8 +50,13 @@ status endorse_parse(
         goto cleanup_scanner;
     }
 
+    /* the parser reads tokens from the flex scanner. */
+    memset(&wrapper, 0, sizeof(wrapper));
+    wrapper.flex = scanner;
+    wrapper.context = context;
+
     /* parse the buffer. */
-    retval = yyparse(scanner, context);
+    retval = yyparse(&wrapper, context);
     if (STATUS_SUCCESS != retval)
     {
         fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
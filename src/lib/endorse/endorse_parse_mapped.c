@@ -0,0 +1,55 @@
+/**
+ * \file endorse/endorse_parse_mapped.c
+ *
+ * \brief Parse endorse config data directly from mapped source.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <vctool/endorse.h>
+#include <vctool/status_codes.h>
+
+#include "endorse_internal.h"
+#include "endorse.tab.h"
+
+/**
+ * \brief Parse endorse config source directly from memory, such as a memory
+ * mapped config file.
+ *
+ * \param context       The endorse config context for this parse.
+ * \param source        The source to parse. It need not be ASCIIZ, and it is
+ *                      neither copied nor modified.
+ * \param size          The size of the source.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_parse_mapped(
+    endorse_config_context* context, const void* source, size_t size)
+{
+    status retval;
+    endorse_scanner scanner;
+
+    /* the parser slices tokens directly out of the source. */
+    memset(&scanner, 0, sizeof(scanner));
+    scanner.context = context;
+    scanner.base = (const char*)source;
+    scanner.size = size;
+
+    /* parse the source. */
+    retval = yyparse(&scanner, context);
+    if (STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
+        goto done;
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+
+done:
+    return retval;
+}
@@ -0,0 +1,78 @@
+/**
+ * \file lib/endorse/endorse_symbol_table_create.c
+ *
+ * \brief Create an empty symbol table.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <string.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/** \brief The initial number of slots in a symbol table. */
+#define SYMBOL_TABLE_INITIAL_CAPACITY 64
+
+/**
+ * \brief Create an empty symbol table.
+ *
+ * \param table         Pointer to receive the symbol table on success.
+ * \param alloc         The allocator to use for the table and its symbols.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_symbol_table_create(
+    endorse_symbol_table** table, RCPR_SYM(allocator)* alloc)
+{
+    status retval, release_retval;
+    endorse_symbol_table* tmp;
+
+    /* allocate memory for the symbol table. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &endorse_symbol_table_resource_release);
+
+    /* set values. */
+    tmp->alloc = alloc;
+    tmp->capacity = SYMBOL_TABLE_INITIAL_CAPACITY;
+
+    /* allocate the slots. */
+    retval =
+        rcpr_allocator_allocate(
+            alloc, (void**)&tmp->slots, tmp->capacity * sizeof(*tmp->slots));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_table;
+    }
+
+    /* all slots start empty. */
+    memset(tmp->slots, 0, tmp->capacity * sizeof(*tmp->slots));
+
+    /* success. */
+    *table = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_table:
+    release_retval = resource_release(&tmp->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
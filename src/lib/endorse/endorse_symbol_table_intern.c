@@ -0,0 +1,139 @@
+/**
+ * \file lib/endorse/endorse_symbol_table_intern.c
+ *
+ * \brief Intern a string in the symbol table.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <string.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Intern a string in the symbol table.
+ *
+ * \param symbol        Pointer to receive the interned symbol. It is owned by
+ *                      the symbol table.
+ * \param table         The symbol table.
+ * \param str           The string to intern. It need not be ASCIIZ.
+ * \param length        The length of the string.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_symbol_table_intern(
+    const char** symbol, endorse_symbol_table* table, const char* str,
+    size_t length)
+{
+    status retval;
+    uint64_t hash;
+    endorse_symbol_table_entry* slot;
+    size_t mask;
+    char* copy;
+
+    /* compute the FNV-1a hash of the string. */
+    hash = endorse_hash(str, length);
+
+    /* probe for this string or an empty slot. */
+    mask = table->capacity - 1;
+    for (size_t i = hash & mask; ; i = (i + 1) & mask)
+    {
+        slot = &table->slots[i];
+
+        if (NULL == slot->symbol)
+        {
+            break;
+        }
+
+        if (slot->hash == hash
+         && !strncmp(slot->symbol, str, length)
+         && '\0' == slot->symbol[length])
+        {
+            *symbol = slot->symbol;
+            return STATUS_SUCCESS;
+        }
+    }
+
+    /* grow the table if adding this symbol would make it more than half full. */
+    if (2 * (table->count + 1) > table->capacity)
+    {
+        endorse_symbol_table_entry* old_slots = table->slots;
+        size_t old_capacity = table->capacity;
+        endorse_symbol_table_entry* new_slots;
+        size_t new_capacity = 2 * old_capacity;
+
+        /* allocate the new slots. */
+        retval =
+            rcpr_allocator_allocate(
+                table->alloc, (void**)&new_slots,
+                new_capacity * sizeof(*new_slots));
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+
+        /* rehash every symbol into the new table. */
+        memset(new_slots, 0, new_capacity * sizeof(*new_slots));
+        mask = new_capacity - 1;
+        for (size_t i = 0; i < old_capacity; ++i)
+        {
+            if (NULL != old_slots[i].symbol)
+            {
+                size_t j = old_slots[i].hash & mask;
+                while (NULL != new_slots[j].symbol)
+                {
+                    j = (j + 1) & mask;
+                }
+
+                new_slots[j] = old_slots[i];
+            }
+        }
+
+        /* swap in the new table. */
+        table->slots = new_slots;
+        table->capacity = new_capacity;
+
+        /* reclaim the old slots. */
+        retval = rcpr_allocator_reclaim(table->alloc, old_slots);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+
+        /* find the empty slot for this symbol in the new table. */
+        size_t i = hash & mask;
+        while (NULL != table->slots[i].symbol)
+        {
+            i = (i + 1) & mask;
+        }
+
+        slot = &table->slots[i];
+    }
+
+    /* copy the string. */
+    retval = rcpr_allocator_allocate(table->alloc, (void**)&copy, length + 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    memcpy(copy, str, length);
+    copy[length] = '\0';
+
+    /* add the symbol. */
+    slot->symbol = copy;
+    slot->hash = hash;
+    ++table->count;
+
+    /* success. */
+    *symbol = copy;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+done:
+    return retval;
+}
@@ -0,0 +1,69 @@
+/**
+ * \file lib/endorse/endorse_symbol_table_resource_release.c
+ *
+ * \brief Release a symbol table.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <string.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Release a symbol table and every symbol interned in it.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_symbol_table_resource_release(RCPR_SYM(resource)* r)
+{
+    status retval = STATUS_SUCCESS;
+    status reclaim_retval;
+    endorse_symbol_table* table = (endorse_symbol_table*)r;
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = table->alloc;
+
+    /* reclaim every symbol and the slots, if set. */
+    if (NULL != table->slots)
+    {
+        for (size_t i = 0; i < table->capacity; ++i)
+        {
+            if (NULL != table->slots[i].symbol)
+            {
+                reclaim_retval =
+                    rcpr_allocator_reclaim(
+                        alloc, (void*)table->slots[i].symbol);
+                if (STATUS_SUCCESS != reclaim_retval)
+                {
+                    retval = reclaim_retval;
+                }
+            }
+        }
+
+        reclaim_retval = rcpr_allocator_reclaim(alloc, table->slots);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+    }
+
+    /* clear memory. */
+    memset(table, 0, sizeof(*table));
+
+    /* reclaim the symbol table. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, table);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+    return retval;
+}
@@ -0,0 +1,27 @@
+/**
+ * \file lib/endorse/endorse_verb_set_contains.c
+ *
+ * \brief Return true if the given verb index is in the verb set.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Return true if the given verb index is in the verb set.
+ *
+ * \param set           The verb set.
+ * \param index         The dense verb index.
+ *
+ * \returns true if this verb is in the set and false otherwise.
+ */
+bool endorse_verb_set_contains(const endorse_verb_set* set, size_t index)
+{
+    if (index >= set->verb_count)
+    {
+        return false;
+    }
+
+    return 0 != (set->words[index / 64] & (UINT64_C(1) << (index % 64)));
+}
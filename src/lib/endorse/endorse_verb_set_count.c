@@ -0,0 +1,28 @@
+/**
+ * \file lib/endorse/endorse_verb_set_count.c
+ *
+ * \brief Return the number of verbs in the verb set.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include "endorse_internal.h"
+
+/**
+ * \brief Return the number of verbs in the verb set.
+ *
+ * \param set           The verb set.
+ *
+ * \returns the number of verbs in this set.
+ */
+size_t endorse_verb_set_count(const endorse_verb_set* set)
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < set->word_count; ++i)
+    {
+        count += (size_t)__builtin_popcountll(set->words[i]);
+    }
+
+    return count;
+}
@@ -0,0 +1,62 @@
+/**
+ * \file lib/endorse/endorse_verb_set_create.c
+ *
+ * \brief Create an empty verb set.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <string.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create an empty verb set.
+ *
+ * \param set           Pointer to receive the verb set on success.
+ * \param alloc         The allocator to use for this operation.
+ * \param verb_count    The number of verbs that this set can hold.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_verb_set_create(
+    endorse_verb_set** set, RCPR_SYM(allocator)* alloc, size_t verb_count)
+{
+    status retval;
+    endorse_verb_set* tmp;
+    size_t word_count = (verb_count + 63) / 64;
+    size_t size = sizeof(*tmp) + word_count * sizeof(uint64_t);
+
+    /* allocate the set and its words in a single block. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, size);
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &endorse_verb_set_resource_release);
+
+    /* set values. */
+    tmp->alloc = alloc;
+    tmp->reference_count = 1;
+    tmp->verb_count = verb_count;
+    tmp->word_count = word_count;
+    tmp->words = (uint64_t*)(tmp + 1);
+
+    /* success. */
+    *set = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+done:
+    return retval;
+}
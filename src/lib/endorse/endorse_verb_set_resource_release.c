@@ -0,0 +1,47 @@
+/**
+ * \file lib/endorse/endorse_verb_set_resource_release.c
+ *
+ * \brief Release a verb set.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <string.h>
+
+#include "endorse_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Release a verb set.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status endorse_verb_set_resource_release(RCPR_SYM(resource)* r)
+{
+    endorse_verb_set* set = (endorse_verb_set*)r;
+
+    /* decrement reference count. */
+    --set->reference_count;
+
+    /* if there are still references, don't release this resource. */
+    if (set->reference_count > 0)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = set->alloc;
+
+    /* clear memory. */
+    memset(set, 0, sizeof(*set) + set->word_count * sizeof(uint64_t));
+
+    /* reclaim the set. */
+    return
+        rcpr_allocator_reclaim(alloc, set);
+}
@@ -0,0 +1,31 @@
+/**
+ * \file file/file_closedir.c
+ *
+ * \brief Implementation of file_closedir.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/file.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Close a directory handle.
+ *
+ * \param f         The file interface.
+ * \param dir       The directory handle to close.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the directory handle is invalid.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_closedir(file* f, void* dir)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(NULL != dir);
+
+    return f->file_closedir_method(f, dir);
+}
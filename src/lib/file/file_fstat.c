@@ -0,0 +1,35 @@
+/**
+ * \file file/file_fstat.c
+ *
+ * \brief Implementation of file_fstat.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/file.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Get file stats for an open file descriptor.
+ *
+ * \param f         The file interface to use to gather stats.
+ * \param d         The descriptor of the file to stat.
+ * \param filestat  Structure to populate with stat information.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the file descriptor is invalid.
+ *      - VCTOOL_ERROR_FILE_KERNEL_MEMORY if the kernel ran out of memory.
+ *      - VCTOOL_ERROR_FILE_OVERFLOW if some value caused overflow.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN some unknown error occurred.
+ */
+int file_fstat(file* f, int d, file_stat_st* filestat)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(d >= 0);
+    MODEL_ASSERT(NULL != filestat);
+
+    return f->file_fstat_method(f, d, filestat);
+}
@@ -0,0 +1,41 @@
+/**
+ * \file file/file_ftruncate.c
+ *
+ * \brief Implementation of file_ftruncate.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/file.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Truncate or extend a file to the given size.
+ *
+ * \param f         The file interface.
+ * \param d         The descriptor of the file, open for writing.
+ * \param length    The new size of the file; an extended file reads as zeroes.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if the file can't be written.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the file descriptor is invalid.
+ *      - VCTOOL_ERROR_FILE_INTERRUPT if this operation was interrupted by a
+ *        signal handler.
+ *      - VCTOOL_ERROR_FILE_INVALID if the length is negative, or the
+ *        descriptor is not open for writing.
+ *      - VCTOOL_ERROR_FILE_IO if an I/O error occurred.
+ *      - VCTOOL_ERROR_FILE_OVERFLOW if the length is larger than the maximum
+ *        file size.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_ftruncate(file* f, int d, off_t length)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(d >= 0);
+    MODEL_ASSERT(length >= 0);
+
+    return f->file_ftruncate_method(f, d, length);
+}
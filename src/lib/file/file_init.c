@@ -3,14 +3,18 @@
  *
  * \brief Implementation of file_init.
  *
- * \copyright 2020 Velo Payments.  See License.txt for license terms.
+ * \copyright 2020-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #include <cbmc/model_assert.h>
+#include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <stdio.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <vctool/file.h>
 #include <vpr/parameters.h>
@@ -22,8 +26,19 @@ static int file_os_open(file*, int*, const char*, int, mode_t);
 static int file_os_close(file*, int);
 static int file_os_read(file*, int, void*, size_t, size_t*);
 static int file_os_write(file*, int, const void*, size_t, size_t*);
+static int file_os_writev(file*, int, const struct iovec*, int, size_t*);
 static int file_os_lseek(file*, int, off_t, file_lseek_whence, off_t*);
 static int file_os_fsync(file*, int);
+static int file_os_fstat(file*, int, file_stat_st*);
+static int file_os_mmap(file*, int, size_t, const void**);
+static int file_os_munmap(file*, const void*, size_t);
+static int file_os_ftruncate(file*, int, off_t);
+static int file_os_mkdir(file*, const char*, mode_t);
+static int file_os_rename(file*, const char*, const char*);
+static int file_os_unlink(file*, const char*);
+static int file_os_opendir(file*, void**, const char*);
+static int file_os_readdir(file*, void*, const char**);
+static int file_os_closedir(file*, void*);
 
 /**
  * \brief Initialize a file interface backed by the operating system.
@@ -50,8 +65,19 @@ int file_init(file* f)
     f->file_close_method = &file_os_close;
     f->file_read_method = &file_os_read;
     f->file_write_method = &file_os_write;
+    f->file_writev_method = &file_os_writev;
     f->file_lseek_method = &file_os_lseek;
     f->file_fsync_method = &file_os_fsync;
+    f->file_fstat_method = &file_os_fstat;
+    f->file_mmap_method = &file_os_mmap;
+    f->file_munmap_method = &file_os_munmap;
+    f->file_ftruncate_method = &file_os_ftruncate;
+    f->file_mkdir_method = &file_os_mkdir;
+    f->file_rename_method = &file_os_rename;
+    f->file_unlink_method = &file_os_unlink;
+    f->file_opendir_method = &file_os_opendir;
+    f->file_readdir_method = &file_os_readdir;
+    f->file_closedir_method = &file_os_closedir;
 
     /* the file instance should now be valid. */
     MODEL_ASSERT(PROP_FILE_VALID(f));
@@ -429,6 +455,86 @@ static int file_os_write(
     return VCTOOL_STATUS_SUCCESS;
 }
 
+/**
+ * \brief Write a vector of buffers to a file descriptor in a single call.
+ *
+ * \param f         The file interface.
+ * \param d         The descriptor to which data is written.
+ * \param iov       The buffers to write, in order.
+ * \param iovcnt    The number of buffers.
+ * \param wbytes    Pointer to the size_t variable to hold the number of bytes
+ *                  written.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_WOULD_BLOCK if the operation would cause the process
+ *        to block and no blocking has been set.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the file descriptor is bad.
+ *      - VCTOOL_ERROR_FILE_QUOTA if this operation violates a user quota on
+ *        disk space.
+ *      - VCTOOL_ERROR_FILE_FAULT if this operation causes a memory fault.
+ *      - VCTOOL_ERROR_FILE_OVERFLOW if an attempt is made to write to a file
+ *        that exceeds disk or user limits.
+ *      - VCTOOL_ERROR_FILE_INTERRUPT if this operation is interrupted by a
+ *        signal handler.
+ *      - VCTOOL_ERROR_FILE_INVALID_FLAGS if this operation violates flags set
+ *        for this descriptor.
+ *      - VCTOOL_ERROR_FILE_IO if a low-level I/O error occurs.
+ *      - VCTOOL_ERROR_FILE_NO_SPACE if there is no space left on this device.
+ *      - VCTOOL_ERROR_FILE_ACCESS if an access / permission issue occurs.
+ *      - VCTOOL_ERROR_FILE_BROKEN_PIPE if the remote end of this descriptor is
+ *        disconnected.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurs.
+ */
+static int file_os_writev(
+    file* UNUSED(f), int d, const struct iovec* iov, int iovcnt,
+    size_t* wbytes)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(d >= 0);
+    MODEL_ASSERT(NULL != iov);
+    MODEL_ASSERT(NULL != wbytes);
+
+    /* attempt to write all buffers to this fd. */
+    ssize_t retval = writev(d, iov, iovcnt);
+    if (retval < 0)
+    {
+        switch (errno)
+        {
+            case EWOULDBLOCK:
+                return VCTOOL_ERROR_FILE_WOULD_BLOCK;
+            case EBADF:
+                return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+            case EDQUOT:
+                return VCTOOL_ERROR_FILE_QUOTA;
+            case EFAULT:
+                return VCTOOL_ERROR_FILE_FAULT;
+            case EFBIG:
+                return VCTOOL_ERROR_FILE_OVERFLOW;
+            case EINTR:
+                return VCTOOL_ERROR_FILE_INTERRUPT;
+            case EINVAL:
+                return VCTOOL_ERROR_FILE_INVALID_FLAGS;
+            case EIO:
+                return VCTOOL_ERROR_FILE_IO;
+            case ENOSPC:
+                return VCTOOL_ERROR_FILE_NO_SPACE;
+            case EPERM:
+                return VCTOOL_ERROR_FILE_ACCESS;
+            case EPIPE:
+                return VCTOOL_ERROR_FILE_BROKEN_PIPE;
+            default:
+                return VCTOOL_ERROR_FILE_UNKNOWN;
+        }
+    }
+
+    /* save the number of bytes written. */
+    *wbytes = retval;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
 /**
  * \brief Reposition the read/write offset for a file descriptor.
  *
@@ -590,3 +696,506 @@ static int file_os_fsync(file* UNUSED(f), int d)
     /* success. */
     return VCTOOL_STATUS_SUCCESS;
 }
+
+/**
+ * \brief OS fstat implementation.
+ *
+ * \param f         The file instance for this implementation.
+ * \param d         The descriptor of the file to stat.
+ * \param filestat  Structure to populate with stat information.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the file descriptor is invalid.
+ *      - VCTOOL_ERROR_FILE_KERNEL_MEMORY if the kernel ran out of memory.
+ *      - VCTOOL_ERROR_FILE_OVERFLOW if some value caused overflow.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN some unknown error occurred.
+ */
+static int file_os_fstat(file* UNUSED(f), int d, file_stat_st* filestat)
+{
+    struct stat s;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(d >= 0);
+    MODEL_ASSERT(NULL != filestat);
+
+    /* attempt to call fstat on the given descriptor. */
+    if (fstat(d, &s) < 0)
+    {
+        switch (errno)
+        {
+            case EBADF:
+                return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+            case ENOMEM:
+                return VCTOOL_ERROR_FILE_KERNEL_MEMORY;
+            case EOVERFLOW:
+                return VCTOOL_ERROR_FILE_OVERFLOW;
+            default:
+                return VCTOOL_ERROR_FILE_UNKNOWN;
+        }
+    }
+
+    /* on success, populate the file stat struct based on the stat struct. */
+    filestat->fst_mode = s.st_mode;
+    filestat->fst_uid = s.st_uid;
+    filestat->fst_gid = s.st_gid;
+    filestat->fst_size = s.st_size;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Map the start of a file read-only into memory.
+ *
+ * \param f         The file interface.
+ * \param d         The descriptor of the file to map, open for reading.
+ * \param size      The number of bytes to map; must be greater than zero.
+ * \param data      Pointer to receive the mapping.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if the descriptor is not open for reading.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the file descriptor is invalid.
+ *      - VCTOOL_ERROR_FILE_INVALID if the size is zero or too large.
+ *      - VCTOOL_ERROR_FILE_KERNEL_MEMORY if the mapping could not be created.
+ *      - VCTOOL_ERROR_FILE_NOT_SUPPORTED if the file can't be mapped.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+static int file_os_mmap(
+    file* UNUSED(f), int d, size_t size, const void** data)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(d >= 0);
+    MODEL_ASSERT(NULL != data);
+
+    /* attempt to map the file. */
+    void* map = mmap(NULL, size, PROT_READ, MAP_SHARED, d, 0);
+    if (MAP_FAILED == map)
+    {
+        switch (errno)
+        {
+            case EACCES:
+                return VCTOOL_ERROR_FILE_ACCESS;
+            case EBADF:
+                return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+            case EOVERFLOW: /* fall-through */
+            case EINVAL:
+                return VCTOOL_ERROR_FILE_INVALID;
+            case EAGAIN: /* fall-through */
+            case ENFILE: /* fall-through */
+            case ENOMEM:
+                return VCTOOL_ERROR_FILE_KERNEL_MEMORY;
+            case ENODEV:
+                return VCTOOL_ERROR_FILE_NOT_SUPPORTED;
+            default:
+                return VCTOOL_ERROR_FILE_UNKNOWN;
+        }
+    }
+
+    /* success. */
+    *data = map;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Release a mapping created with \ref file_os_mmap.
+ *
+ * \param f         The file interface.
+ * \param data      The mapping to release.
+ * \param size      The size of the mapping.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_INVALID if this is not a mapping of this size.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+static int file_os_munmap(file* UNUSED(f), const void* data, size_t size)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(NULL != data);
+
+    /* attempt to release the mapping. */
+    if (0 != munmap((void*)data, size))
+    {
+        switch (errno)
+        {
+            case EINVAL:
+                return VCTOOL_ERROR_FILE_INVALID;
+            default:
+                return VCTOOL_ERROR_FILE_UNKNOWN;
+        }
+    }
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Truncate or extend a file to the given size.
+ *
+ * \param f         The file interface.
+ * \param d         The descriptor of the file, open for writing.
+ * \param length    The new size of the file; an extended file reads as zeroes.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if the file can't be written.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the file descriptor is invalid.
+ *      - VCTOOL_ERROR_FILE_INTERRUPT if this operation was interrupted by a
+ *        signal handler.
+ *      - VCTOOL_ERROR_FILE_INVALID if the length is negative, or the
+ *        descriptor is not open for writing.
+ *      - VCTOOL_ERROR_FILE_IO if an I/O error occurred.
+ *      - VCTOOL_ERROR_FILE_OVERFLOW if the length is larger than the maximum
+ *        file size.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+static int file_os_ftruncate(file* UNUSED(f), int d, off_t length)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(d >= 0);
+    MODEL_ASSERT(length >= 0);
+
+    /* attempt to truncate the file. */
+    if (0 != ftruncate(d, length))
+    {
+        switch (errno)
+        {
+            case EPERM: /* fall-through */
+            case EACCES:
+                return VCTOOL_ERROR_FILE_ACCESS;
+            case EBADF:
+                return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+            case EINTR:
+                return VCTOOL_ERROR_FILE_INTERRUPT;
+            case EINVAL:
+                return VCTOOL_ERROR_FILE_INVALID;
+            case EIO:
+                return VCTOOL_ERROR_FILE_IO;
+            case EFBIG:
+                return VCTOOL_ERROR_FILE_OVERFLOW;
+            default:
+                return VCTOOL_ERROR_FILE_UNKNOWN;
+        }
+    }
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Create a directory.
+ *
+ * \param f         The file interface.
+ * \param path      Path to the directory to create.
+ * \param mode      Mode of the new directory.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if the parent directory can't be written.
+ *      - VCTOOL_ERROR_FILE_EXISTS if the path already exists.
+ *      - VCTOOL_ERROR_FILE_LOOP if too many symlinks were encountered.
+ *      - VCTOOL_ERROR_FILE_NAME_TOO_LONG if the path name is too long.
+ *      - VCTOOL_ERROR_FILE_NO_ENTRY if a component of the path does not exist.
+ *      - VCTOOL_ERROR_FILE_NO_SPACE if there is no space left on this device.
+ *      - VCTOOL_ERROR_FILE_NOT_DIRECTORY if a component of the path is not a
+ *        directory.
+ *      - VCTOOL_ERROR_FILE_QUOTA if a quota issue occurred.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+static int file_os_mkdir(file* UNUSED(f), const char* path, mode_t mode)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(NULL != path);
+
+    /* attempt to create the directory. */
+    if (0 != mkdir(path, mode))
+    {
+        switch (errno)
+        {
+            case EPERM: /* fall-through */
+            case EACCES:
+                return VCTOOL_ERROR_FILE_ACCESS;
+            case EEXIST:
+                return VCTOOL_ERROR_FILE_EXISTS;
+            case ELOOP:
+                return VCTOOL_ERROR_FILE_LOOP;
+            case ENAMETOOLONG:
+                return VCTOOL_ERROR_FILE_NAME_TOO_LONG;
+            case ENOENT:
+                return VCTOOL_ERROR_FILE_NO_ENTRY;
+            case ENOSPC:
+                return VCTOOL_ERROR_FILE_NO_SPACE;
+            case ENOTDIR:
+                return VCTOOL_ERROR_FILE_NOT_DIRECTORY;
+            case EDQUOT:
+                return VCTOOL_ERROR_FILE_QUOTA;
+            default:
+                return VCTOOL_ERROR_FILE_UNKNOWN;
+        }
+    }
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Rename a file, replacing any file at the new path.
+ *
+ * \param f         The file interface.
+ * \param oldpath   The current path of the file.
+ * \param newpath   The new path of the file.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if either directory can't be written.
+ *      - VCTOOL_ERROR_FILE_EXISTS if the new path is a non-empty directory.
+ *      - VCTOOL_ERROR_FILE_IS_DIRECTORY if the new path is a directory and the
+ *        old path is not.
+ *      - VCTOOL_ERROR_FILE_LOOP if too many symlinks were encountered.
+ *      - VCTOOL_ERROR_FILE_NAME_TOO_LONG if a path name is too long.
+ *      - VCTOOL_ERROR_FILE_NO_ENTRY if the old path does not exist.
+ *      - VCTOOL_ERROR_FILE_NO_SPACE if there is no space left on this device.
+ *      - VCTOOL_ERROR_FILE_NOT_DIRECTORY if a component of a path is not a
+ *        directory.
+ *      - VCTOOL_ERROR_FILE_NOT_SUPPORTED if the paths are on different
+ *        filesystems, or the filesystem is read-only.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+static int file_os_rename(
+    file* UNUSED(f), const char* oldpath, const char* newpath)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(NULL != oldpath);
+    MODEL_ASSERT(NULL != newpath);
+
+    /* attempt to rename the file. */
+    if (0 != rename(oldpath, newpath))
+    {
+        switch (errno)
+        {
+            case EPERM: /* fall-through */
+            case EACCES:
+                return VCTOOL_ERROR_FILE_ACCESS;
+            case ENOTEMPTY: /* fall-through */
+            case EEXIST:
+                return VCTOOL_ERROR_FILE_EXISTS;
+            case EISDIR:
+                return VCTOOL_ERROR_FILE_IS_DIRECTORY;
+            case ELOOP:
+                return VCTOOL_ERROR_FILE_LOOP;
+            case ENAMETOOLONG:
+                return VCTOOL_ERROR_FILE_NAME_TOO_LONG;
+            case ENOENT:
+                return VCTOOL_ERROR_FILE_NO_ENTRY;
+            case EDQUOT: /* fall-through */
+            case ENOSPC:
+                return VCTOOL_ERROR_FILE_NO_SPACE;
+            case ENOTDIR:
+                return VCTOOL_ERROR_FILE_NOT_DIRECTORY;
+            case EROFS: /* fall-through */
+            case EXDEV:
+                return VCTOOL_ERROR_FILE_NOT_SUPPORTED;
+            default:
+                return VCTOOL_ERROR_FILE_UNKNOWN;
+        }
+    }
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Remove a file.
+ *
+ * \param f         The file interface.
+ * \param path      Path to the file to remove.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if the directory can't be written.
+ *      - VCTOOL_ERROR_FILE_IO if an I/O error occurred.
+ *      - VCTOOL_ERROR_FILE_IS_DIRECTORY if the path is a directory.
+ *      - VCTOOL_ERROR_FILE_LOOP if too many symlinks were encountered.
+ *      - VCTOOL_ERROR_FILE_NAME_TOO_LONG if the path name is too long.
+ *      - VCTOOL_ERROR_FILE_NO_ENTRY if the file does not exist.
+ *      - VCTOOL_ERROR_FILE_NOT_DIRECTORY if a component of the path is not a
+ *        directory.
+ *      - VCTOOL_ERROR_FILE_NOT_SUPPORTED if the filesystem is read-only.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+static int file_os_unlink(file* UNUSED(f), const char* path)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(NULL != path);
+
+    /* attempt to remove the file. */
+    if (0 != unlink(path))
+    {
+        switch (errno)
+        {
+            case EPERM: /* fall-through */
+            case EACCES:
+                return VCTOOL_ERROR_FILE_ACCESS;
+            case EIO:
+                return VCTOOL_ERROR_FILE_IO;
+            case EISDIR:
+                return VCTOOL_ERROR_FILE_IS_DIRECTORY;
+            case ELOOP:
+                return VCTOOL_ERROR_FILE_LOOP;
+            case ENAMETOOLONG:
+                return VCTOOL_ERROR_FILE_NAME_TOO_LONG;
+            case ENOENT:
+                return VCTOOL_ERROR_FILE_NO_ENTRY;
+            case ENOTDIR:
+                return VCTOOL_ERROR_FILE_NOT_DIRECTORY;
+            case EROFS:
+                return VCTOOL_ERROR_FILE_NOT_SUPPORTED;
+            default:
+                return VCTOOL_ERROR_FILE_UNKNOWN;
+        }
+    }
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Open a directory to read its entries.
+ *
+ * \param f         The file interface.
+ * \param dir       Pointer to receive the directory handle, which must be
+ *                  closed with \ref file_closedir.
+ * \param path      Path to the directory.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if the directory can't be read.
+ *      - VCTOOL_ERROR_FILE_KERNEL_MEMORY if the kernel ran out of memory.
+ *      - VCTOOL_ERROR_FILE_NO_ENTRY if the directory does not exist.
+ *      - VCTOOL_ERROR_FILE_NOT_DIRECTORY if the path is not a directory.
+ *      - VCTOOL_ERROR_FILE_TOO_MANY_FILES if too many files are open for this
+ *        process or the whole system.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+static int file_os_opendir(file* UNUSED(f), void** dir, const char* path)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(NULL != dir);
+    MODEL_ASSERT(NULL != path);
+
+    /* attempt to open the directory. */
+    DIR* d = opendir(path);
+    if (NULL == d)
+    {
+        switch (errno)
+        {
+            case EACCES:
+                return VCTOOL_ERROR_FILE_ACCESS;
+            case ENOMEM:
+                return VCTOOL_ERROR_FILE_KERNEL_MEMORY;
+            case ENOENT:
+                return VCTOOL_ERROR_FILE_NO_ENTRY;
+            case ENOTDIR:
+                return VCTOOL_ERROR_FILE_NOT_DIRECTORY;
+            case EMFILE: /* fall-through */
+            case ENFILE:
+                return VCTOOL_ERROR_FILE_TOO_MANY_FILES;
+            default:
+                return VCTOOL_ERROR_FILE_UNKNOWN;
+        }
+    }
+
+    /* success. */
+    *dir = d;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Read the next entry of a directory.
+ *
+ * Entries are returned in no particular order, and include . and ..
+ *
+ * \param f         The file interface.
+ * \param dir       The directory handle.
+ * \param name      Pointer to receive the name of the next entry, which is
+ *                  valid until the next read or close of this handle, or NULL
+ *                  after the last entry.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the directory handle is invalid.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+static int file_os_readdir(file* UNUSED(f), void* dir, const char** name)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(NULL != dir);
+    MODEL_ASSERT(NULL != name);
+
+    /* the end of the directory is not an error. */
+    errno = 0;
+    struct dirent* entry = readdir((DIR*)dir);
+    if (NULL == entry)
+    {
+        switch (errno)
+        {
+            case 0:
+                *name = NULL;
+                return VCTOOL_STATUS_SUCCESS;
+            case EBADF:
+                return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+            default:
+                return VCTOOL_ERROR_FILE_UNKNOWN;
+        }
+    }
+
+    /* success. */
+    *name = entry->d_name;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Close a directory handle.
+ *
+ * \param f         The file interface.
+ * \param dir       The directory handle to close.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the directory handle is invalid.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+static int file_os_closedir(file* UNUSED(f), void* dir)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(NULL != dir);
+
+    /* attempt to close the directory. */
+    if (0 != closedir((DIR*)dir))
+    {
+        switch (errno)
+        {
+            case EBADF:
+                return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+            default:
+                return VCTOOL_ERROR_FILE_UNKNOWN;
+        }
+    }
+
+    /* success. */
+    return VCTOOL_STATUS_SUCCESS;
+}
@@ -0,0 +1,92 @@
+/**
+ * \file file/file_map_contents.c
+ *
+ * \brief Implementation of file_map_contents.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/file.h>
+#include <fcntl.h>
+
+/**
+ * \brief Map the contents of a file read-only into memory.
+ *
+ * The file is opened, mapped at its current size, and closed again. An empty
+ * file is not mapped; \p data is set to NULL and \p size to zero. Otherwise,
+ * the mapping must be released with \ref file_munmap.
+ *
+ * \param f         The file interface.
+ * \param path      Path to the file to map.
+ * \param data      Pointer to receive the mapping.
+ * \param size      Pointer to receive the size of the mapping.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code from \ref file_open, \ref file_fstat, or
+ *        \ref file_mmap on failure.
+ */
+int file_map_contents(
+    file* f, const char* path, const void** data, size_t* size)
+{
+    int retval, release_retval, d;
+    file_stat_st fst;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(NULL != path);
+    MODEL_ASSERT(NULL != data);
+    MODEL_ASSERT(NULL != size);
+
+    /* open the file. */
+    retval = file_open(f, &d, path, O_RDONLY, 0);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* get the current size of the file. */
+    retval = file_fstat(f, d, &fst);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_file;
+    }
+
+    /* an empty file cannot be mapped. */
+    if (0 == fst.fst_size)
+    {
+        *data = NULL;
+        *size = 0;
+        retval = VCTOOL_STATUS_SUCCESS;
+        goto cleanup_file;
+    }
+
+    /* map the file; the mapping outlives the descriptor. */
+    retval = file_mmap(f, d, (size_t)fst.fst_size, data);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_file;
+    }
+
+    *size = (size_t)fst.fst_size;
+    retval = VCTOOL_STATUS_SUCCESS;
+    goto cleanup_file;
+
+cleanup_file:
+    release_retval = file_close(f, d);
+    if (VCTOOL_STATUS_SUCCESS != release_retval)
+    {
+        if (VCTOOL_STATUS_SUCCESS == retval && NULL != *data)
+        {
+            file_munmap(f, *data, *size);
+            *data = NULL;
+            *size = 0;
+        }
+
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,40 @@
+/**
+ * \file file/file_mkdir.c
+ *
+ * \brief Implementation of file_mkdir.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/file.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Create a directory.
+ *
+ * \param f         The file interface.
+ * \param path      Path to the directory to create.
+ * \param mode      Mode of the new directory.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if the parent directory can't be written.
+ *      - VCTOOL_ERROR_FILE_EXISTS if the path already exists.
+ *      - VCTOOL_ERROR_FILE_LOOP if too many symlinks were encountered.
+ *      - VCTOOL_ERROR_FILE_NAME_TOO_LONG if the path name is too long.
+ *      - VCTOOL_ERROR_FILE_NO_ENTRY if a component of the path does not exist.
+ *      - VCTOOL_ERROR_FILE_NO_SPACE if there is no space left on this device.
+ *      - VCTOOL_ERROR_FILE_NOT_DIRECTORY if a component of the path is not a
+ *        directory.
+ *      - VCTOOL_ERROR_FILE_QUOTA if a quota issue occurred.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_mkdir(file* f, const char* path, mode_t mode)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(NULL != path);
+
+    return f->file_mkdir_method(f, path, mode);
+}
@@ -0,0 +1,50 @@
+/**
+ * \file file/file_mmap.c
+ *
+ * \brief Implementation of file_mmap.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/file.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Map the start of a file read-only into memory.
+ *
+ * The mapping is shared, so data written to the file through its descriptor
+ * after it is mapped can be read through the mapping. Bytes of the mapping past
+ * the end of the file must not be read until the file has grown to cover them.
+ * The mapping outlives the descriptor, and must be released with
+ * \ref file_munmap.
+ *
+ * \param f         The file interface.
+ * \param d         The descriptor of the file to map, open for reading.
+ * \param size      The number of bytes to map; must be greater than zero.
+ * \param data      Pointer to receive the mapping.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if the descriptor is not open for reading.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the file descriptor is invalid.
+ *      - VCTOOL_ERROR_FILE_INVALID if the size is zero or too large.
+ *      - VCTOOL_ERROR_FILE_KERNEL_MEMORY if the mapping could not be created.
+ *      - VCTOOL_ERROR_FILE_NOT_SUPPORTED if the file can't be mapped.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_mmap(file* f, int d, size_t size, const void** data)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(d >= 0);
+    MODEL_ASSERT(NULL != data);
+
+    /* an empty mapping is invalid. */
+    if (0 == size)
+    {
+        return VCTOOL_ERROR_FILE_INVALID;
+    }
+
+    return f->file_mmap_method(f, d, size, data);
+}
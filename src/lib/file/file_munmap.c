@@ -0,0 +1,32 @@
+/**
+ * \file file/file_munmap.c
+ *
+ * \brief Implementation of file_munmap.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/file.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Release a mapping created with \ref file_mmap.
+ *
+ * \param f         The file interface.
+ * \param data      The mapping to release.
+ * \param size      The size of the mapping.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_INVALID if this is not a mapping of this size.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_munmap(file* f, const void* data, size_t size)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(NULL != data);
+
+    return f->file_munmap_method(f, data, size);
+}
@@ -0,0 +1,39 @@
+/**
+ * \file file/file_opendir.c
+ *
+ * \brief Implementation of file_opendir.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/file.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Open a directory to read its entries.
+ *
+ * \param f         The file interface.
+ * \param dir       Pointer to receive the directory handle, which must be
+ *                  closed with \ref file_closedir.
+ * \param path      Path to the directory.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if the directory can't be read.
+ *      - VCTOOL_ERROR_FILE_KERNEL_MEMORY if the kernel ran out of memory.
+ *      - VCTOOL_ERROR_FILE_NO_ENTRY if the directory does not exist.
+ *      - VCTOOL_ERROR_FILE_NOT_DIRECTORY if the path is not a directory.
+ *      - VCTOOL_ERROR_FILE_TOO_MANY_FILES if too many files are open for this
+ *        process or the whole system.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_opendir(file* f, void** dir, const char* path)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(NULL != dir);
+    MODEL_ASSERT(NULL != path);
+
+    return f->file_opendir_method(f, dir, path);
+}
@@ -0,0 +1,37 @@
+/**
+ * \file file/file_readdir.c
+ *
+ * \brief Implementation of file_readdir.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/file.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Read the next entry of a directory.
+ *
+ * Entries are returned in no particular order, and include . and ..
+ *
+ * \param f         The file interface.
+ * \param dir       The directory handle.
+ * \param name      Pointer to receive the name of the next entry, which is
+ *                  valid until the next read or close of this handle, or NULL
+ *                  after the last entry.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_BAD_DESCRIPTOR if the directory handle is invalid.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_readdir(file* f, void* dir, const char** name)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(NULL != dir);
+    MODEL_ASSERT(NULL != name);
+
+    return f->file_readdir_method(f, dir, name);
+}
@@ -0,0 +1,44 @@
+/**
+ * \file file/file_rename.c
+ *
+ * \brief Implementation of file_rename.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/file.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Rename a file, replacing any file at the new path.
+ *
+ * \param f         The file interface.
+ * \param oldpath   The current path of the file.
+ * \param newpath   The new path of the file.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if either directory can't be written.
+ *      - VCTOOL_ERROR_FILE_EXISTS if the new path is a non-empty directory.
+ *      - VCTOOL_ERROR_FILE_IS_DIRECTORY if the new path is a directory and the
+ *        old path is not.
+ *      - VCTOOL_ERROR_FILE_LOOP if too many symlinks were encountered.
+ *      - VCTOOL_ERROR_FILE_NAME_TOO_LONG if a path name is too long.
+ *      - VCTOOL_ERROR_FILE_NO_ENTRY if the old path does not exist.
+ *      - VCTOOL_ERROR_FILE_NO_SPACE if there is no space left on this device.
+ *      - VCTOOL_ERROR_FILE_NOT_DIRECTORY if a component of a path is not a
+ *        directory.
+ *      - VCTOOL_ERROR_FILE_NOT_SUPPORTED if the paths are on different
+ *        filesystems, or the filesystem is read-only.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_rename(file* f, const char* oldpath, const char* newpath)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(NULL != oldpath);
+    MODEL_ASSERT(NULL != newpath);
+
+    return f->file_rename_method(f, oldpath, newpath);
+}
@@ -0,0 +1,39 @@
+/**
+ * \file file/file_unlink.c
+ *
+ * \brief Implementation of file_unlink.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vctool/file.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Remove a file.
+ *
+ * \param f         The file interface.
+ * \param path      Path to the file to remove.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_FILE_ACCESS if the directory can't be written.
+ *      - VCTOOL_ERROR_FILE_IO if an I/O error occurred.
+ *      - VCTOOL_ERROR_FILE_IS_DIRECTORY if the path is a directory.
+ *      - VCTOOL_ERROR_FILE_LOOP if too many symlinks were encountered.
+ *      - VCTOOL_ERROR_FILE_NAME_TOO_LONG if the path name is too long.
+ *      - VCTOOL_ERROR_FILE_NO_ENTRY if the file does not exist.
+ *      - VCTOOL_ERROR_FILE_NOT_DIRECTORY if a component of the path is not a
+ *        directory.
+ *      - VCTOOL_ERROR_FILE_NOT_SUPPORTED if the filesystem is read-only.
+ *      - VCTOOL_ERROR_FILE_UNKNOWN if an unknown error occurred.
+ */
+int file_unlink(file* f, const char* path)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(PROP_FILE_VALID(f));
+    MODEL_ASSERT(NULL != path);
+
+    return f->file_unlink_method(f, path);
+}
@@ -0,0 +1,102 @@
+/**
+ * \file parallel/parallel_for.c
+ *
+ * \brief Run independent jobs on a pool of worker threads.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <pthread.h>
+#include <vctool/parallel.h>
+#include <vctool/status_codes.h>
+
+/** \brief The shared state for a parallel_for invocation. */
+typedef struct parallel_for_state
+{
+    size_t job_count;
+    size_t next_job;
+    parallel_job_fn func;
+    void* context;
+} parallel_for_state;
+
+/* forward decls. */
+static void* parallel_for_worker(void* context);
+
+/**
+ * \brief Run the given job function once for each index in [0, job_count) on a
+ * pool of worker threads, and wait for all jobs to complete.
+ *
+ * \param job_count     The number of jobs to run.
+ * \param func          The job function.
+ * \param context       The user context for the job function.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+int parallel_for(size_t job_count, parallel_job_fn func, void* context)
+{
+    pthread_t threads[PARALLEL_MAX_WORKERS];
+    parallel_for_state state;
+    size_t started;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != func);
+
+    /* initialize the shared state. */
+    state.job_count = job_count;
+    state.next_job = 0;
+    state.func = func;
+    state.context = context;
+
+    /* start the helper workers; the calling thread is also a worker. */
+    size_t workers = parallel_worker_count(job_count);
+    for (started = 0; started + 1 < workers; ++started)
+    {
+        if (0 != pthread_create(
+                    &threads[started], NULL, &parallel_for_worker, &state))
+        {
+            break;
+        }
+    }
+
+    /* run jobs on this thread. */
+    parallel_for_worker(&state);
+
+    /* wait for the helper workers to finish. */
+    for (size_t i = 0; i < started; ++i)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Claim and run jobs until none are left.
+ *
+ * \param context       The parallel_for state.
+ *
+ * \returns NULL.
+ */
+static void* parallel_for_worker(void* context)
+{
+    parallel_for_state* state = (parallel_for_state*)context;
+
+    for (;;)
+    {
+        /* claim the next job. */
+        size_t index =
+            __atomic_fetch_add(&state->next_job, 1, __ATOMIC_RELAXED);
+        if (index >= state->job_count)
+        {
+            break;
+        }
+
+        /* run it. */
+        state->func(state->context, index);
+    }
+
+    return NULL;
+}
@@ -0,0 +1,41 @@
+/**
+ * \file parallel/parallel_worker_count.c
+ *
+ * \brief Compute the number of workers to use for a set of jobs.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <unistd.h>
+#include <vctool/parallel.h>
+
+/**
+ * \brief Return the number of workers to use for the given number of jobs.
+ *
+ * This is one worker per online processor, but never more than the number of
+ * jobs, never more than \ref PARALLEL_MAX_WORKERS, and at least one if there is
+ * at least one job.
+ *
+ * \param job_count     The number of jobs to run.
+ *
+ * \returns the number of workers to use.
+ */
+size_t parallel_worker_count(size_t job_count)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t workers = cpus > 0 ? (size_t)cpus : 1;
+
+    /* cap the number of workers. */
+    if (workers > PARALLEL_MAX_WORKERS)
+    {
+        workers = PARALLEL_MAX_WORKERS;
+    }
+
+    /* there is no point in having more workers than jobs. */
+    if (workers > job_count)
+    {
+        workers = job_count;
+    }
+
+    return workers;
+}
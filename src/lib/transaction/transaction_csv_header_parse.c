@@ -0,0 +1,78 @@
+/**
+ * \file transaction/transaction_csv_header_parse.c
+ *
+ * \brief Parse the header row of a CSV manifest.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/status_codes.h>
+#include <vctool/transaction.h>
+
+/**
+ * \brief Parse the header row of a CSV manifest.
+ *
+ * Each column is named for the transaction field it holds.
+ *
+ * \param header            The CSV header to populate.
+ * \param line              The header row, without its line ending.
+ * \param size              The size of the header row.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_UNKNOWN_FIELD if a column is not known.
+ *      - VCTOOL_ERROR_TRANSACTION_DUPLICATE_FIELD if a column is repeated.
+ *      - VCTOOL_ERROR_TRANSACTION_SYNTAX if the row is malformed.
+ */
+int transaction_csv_header_parse(
+    transaction_csv_header* header, const char* line, size_t size)
+{
+    int retval;
+    size_t offset = 0;
+    const char* column;
+    size_t column_size;
+    transaction_field field;
+    unsigned int seen = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != header);
+    MODEL_ASSERT(NULL != line);
+
+    memset(header, 0, sizeof(*header));
+
+    while (offset <= size)
+    {
+        retval =
+            transaction_csv_next_column(
+                &column, &column_size, &offset, line, size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        /* each column names a distinct field. */
+        retval = transaction_field_lookup(&field, column, column_size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        if (seen & TRANSACTION_FIELD_BIT(field))
+        {
+            return VCTOOL_ERROR_TRANSACTION_DUPLICATE_FIELD;
+        }
+
+        seen |= TRANSACTION_FIELD_BIT(field);
+        header->columns[header->column_count++] = field;
+    }
+
+    /* rows can't set a required field that has no column. */
+    if (TRANSACTION_REQUIRED_FIELDS != (seen & TRANSACTION_REQUIRED_FIELDS))
+    {
+        return VCTOOL_ERROR_TRANSACTION_MISSING_FIELD;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
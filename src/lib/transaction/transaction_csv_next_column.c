@@ -0,0 +1,87 @@
+/**
+ * \file transaction/transaction_csv_next_column.c
+ *
+ * \brief Split the next column from a CSV row.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/status_codes.h>
+#include <vctool/transaction.h>
+
+/**
+ * \brief Split the next column from a CSV row.
+ *
+ * Surrounding whitespace is trimmed, and a quoted column has its quotes
+ * removed. Quoted columns can't hold quotes or commas.
+ *
+ * \param column            Pointer to receive the start of the column.
+ * \param column_size       Pointer to receive the size of the column.
+ * \param offset            The offset of the column in the row; on success,
+ *                          this is updated to the offset of the next column,
+ *                          or to one past the end of the row after the last
+ *                          column.
+ * \param line              The row.
+ * \param size              The size of the row.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_SYNTAX if a quoted column is malformed.
+ */
+int transaction_csv_next_column(
+    const char** column, size_t* column_size, size_t* offset,
+    const char* line, size_t size)
+{
+    size_t start, end;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != column);
+    MODEL_ASSERT(NULL != column_size);
+    MODEL_ASSERT(NULL != offset);
+    MODEL_ASSERT(NULL != line);
+
+    /* find the end of this column. */
+    start = *offset;
+    const char* comma = (const char*)memchr(line + start, ',', size - start);
+    end = (NULL != comma) ? (size_t)(comma - line) : size;
+
+    /* the next column follows the comma. */
+    *offset = end + 1;
+
+    /* trim surrounding whitespace, including a carriage return. */
+    while (start < end && (' ' == line[start] || '\t' == line[start]))
+    {
+        ++start;
+    }
+
+    while (end > start
+        && (' ' == line[end - 1] || '\t' == line[end - 1]
+         || '\r' == line[end - 1]))
+    {
+        --end;
+    }
+
+    /* remove the quotes from a quoted column. */
+    if (start < end && '"' == line[start])
+    {
+        if (end - start < 2 || '"' != line[end - 1])
+        {
+            return VCTOOL_ERROR_TRANSACTION_SYNTAX;
+        }
+
+        ++start;
+        --end;
+
+        if (NULL != memchr(line + start, '"', end - start))
+        {
+            return VCTOOL_ERROR_TRANSACTION_SYNTAX;
+        }
+    }
+
+    *column = line + start;
+    *column_size = end - start;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
@@ -0,0 +1,54 @@
+/**
+ * \file transaction/transaction_field_lookup.c
+ *
+ * \brief Look up a transaction field by its manifest name.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/status_codes.h>
+#include <vctool/transaction.h>
+
+/* the manifest name of each transaction field, in field order. */
+static const char* const transaction_field_names[TRANSACTION_FIELD_COUNT] = {
+    [TRANSACTION_FIELD_TRANSACTION_ID] = "transaction_id",
+    [TRANSACTION_FIELD_PREVIOUS_TRANSACTION_ID] = "previous_transaction_id",
+    [TRANSACTION_FIELD_TRANSACTION_TYPE] = "transaction_type",
+    [TRANSACTION_FIELD_ARTIFACT_ID] = "artifact_id",
+    [TRANSACTION_FIELD_PREVIOUS_STATE] = "previous_state",
+    [TRANSACTION_FIELD_NEW_STATE] = "new_state",
+    [TRANSACTION_FIELD_VALID_FROM] = "valid_from",
+};
+
+/**
+ * \brief Look up a transaction field by its manifest name.
+ *
+ * \param field             Pointer to receive the field.
+ * \param name              The field name; this need not be ASCIIZ.
+ * \param size              The size of the field name.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_UNKNOWN_FIELD if the name is not known.
+ */
+int transaction_field_lookup(
+    transaction_field* field, const char* name, size_t size)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != field);
+    MODEL_ASSERT(NULL != name);
+
+    for (int i = 0; i < TRANSACTION_FIELD_COUNT; ++i)
+    {
+        if (strlen(transaction_field_names[i]) == size
+         && !memcmp(transaction_field_names[i], name, size))
+        {
+            *field = (transaction_field)i;
+            return VCTOOL_STATUS_SUCCESS;
+        }
+    }
+
+    return VCTOOL_ERROR_TRANSACTION_UNKNOWN_FIELD;
+}
@@ -0,0 +1,102 @@
+/**
+ * \file transaction/transaction_info_read.c
+ *
+ * \brief Read the ids of a transaction certificate.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vccert/fields.h>
+#include <vctool/certificate.h>
+#include <vctool/status_codes.h>
+#include <vctool/transaction.h>
+
+/* the fields that must be found. */
+#define FOUND_TRANSACTION_ID            0x01
+#define FOUND_PREVIOUS_TRANSACTION_ID   0x02
+#define FOUND_ARTIFACT_ID               0x04
+#define FOUND_ALL                       0x07
+
+/**
+ * \brief Read the transaction id, previous transaction id, and artifact id of
+ * a transaction certificate.
+ *
+ * The certificate fields are scanned once. The signature is not verified. The
+ * previous transaction id of the first transaction of an artifact is zero.
+ *
+ * \param info              The transaction info to populate.
+ * \param cert              The transaction certificate.
+ * \param cert_size         The size of the transaction certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_MISSING_FIELD if a field is missing.
+ *      - VCTOOL_ERROR_TRANSACTION_BAD_VALUE if a field has the wrong size.
+ *      - VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED if the certificate is
+ *        malformed.
+ */
+int transaction_info_read(
+    transaction_info* info, const void* cert, size_t cert_size)
+{
+    int retval;
+    size_t offset = 0;
+    int found = 0;
+    uint16_t type;
+    const uint8_t* value;
+    size_t size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != info);
+    MODEL_ASSERT(NULL != cert);
+
+    while (offset < cert_size)
+    {
+        retval =
+            certificate_next_field(
+                &type, &value, &size, &offset, cert, cert_size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        uint8_t* id;
+        int bit;
+        switch (type)
+        {
+            case VCCERT_FIELD_TYPE_CERTIFICATE_ID:
+                id = info->transaction_id;
+                bit = FOUND_TRANSACTION_ID;
+                break;
+
+            case VCCERT_FIELD_TYPE_PREVIOUS_CERTIFICATE_ID:
+                id = info->previous_transaction_id;
+                bit = FOUND_PREVIOUS_TRANSACTION_ID;
+                break;
+
+            case VCCERT_FIELD_TYPE_ARTIFACT_ID:
+                id = info->artifact_id;
+                bit = FOUND_ARTIFACT_ID;
+                break;
+
+            default:
+                continue;
+        }
+
+        if (TRANSACTION_ID_SIZE != size)
+        {
+            return VCTOOL_ERROR_TRANSACTION_BAD_VALUE;
+        }
+
+        memcpy(id, value, size);
+        found |= bit;
+    }
+
+    if (FOUND_ALL != found)
+    {
+        return VCTOOL_ERROR_TRANSACTION_MISSING_FIELD;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
@@ -0,0 +1,92 @@
+/**
+ * \file transaction/transaction_spec_parse_csv.c
+ *
+ * \brief Parse a CSV manifest row.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/status_codes.h>
+#include <vctool/transaction.h>
+
+/**
+ * \brief Parse a CSV manifest row.
+ *
+ * An empty column leaves its field unset.
+ *
+ * \param spec              The transaction spec to populate.
+ * \param header            The CSV header of this manifest.
+ * \param line              The manifest row, without its line ending.
+ * \param size              The size of the manifest row.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_SYNTAX if the row is malformed or does not
+ *        match the header.
+ *      - VCTOOL_ERROR_TRANSACTION_MISSING_FIELD if a required field is missing.
+ *      - VCTOOL_ERROR_TRANSACTION_BAD_VALUE if a value is invalid.
+ */
+int transaction_spec_parse_csv(
+    transaction_spec* spec, const transaction_csv_header* header,
+    const char* line, size_t size)
+{
+    int retval;
+    size_t offset = 0;
+    const char* column;
+    size_t column_size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != spec);
+    MODEL_ASSERT(NULL != header);
+    MODEL_ASSERT(NULL != line);
+
+    memset(spec, 0, sizeof(*spec));
+
+    for (size_t i = 0; i < header->column_count; ++i)
+    {
+        /* the row must have a column for each header column. */
+        if (offset > size)
+        {
+            return VCTOOL_ERROR_TRANSACTION_SYNTAX;
+        }
+
+        retval =
+            transaction_csv_next_column(
+                &column, &column_size, &offset, line, size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        /* an empty column leaves the field unset. */
+        if (0 == column_size)
+        {
+            continue;
+        }
+
+        retval =
+            transaction_spec_set_field(
+                spec, header->columns[i], column, column_size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    /* the row can't have more columns than the header. */
+    if (offset <= size)
+    {
+        return VCTOOL_ERROR_TRANSACTION_SYNTAX;
+    }
+
+    /* every required field must be set. */
+    if (TRANSACTION_REQUIRED_FIELDS !=
+            (spec->fields & TRANSACTION_REQUIRED_FIELDS))
+    {
+        return VCTOOL_ERROR_TRANSACTION_MISSING_FIELD;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
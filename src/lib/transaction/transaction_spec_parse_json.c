@@ -0,0 +1,244 @@
+/**
+ * \file transaction/transaction_spec_parse_json.c
+ *
+ * \brief Parse a JSON Lines manifest entry.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/status_codes.h>
+#include <vctool/transaction.h>
+
+/* forward decls. */
+static size_t skip_whitespace(const char* line, size_t size, size_t offset);
+static int read_string(
+    const char** str, size_t* str_size, size_t* offset, const char* line,
+    size_t size);
+static size_t read_number(const char* line, size_t size, size_t offset);
+
+/**
+ * \brief Parse a JSON Lines manifest entry.
+ *
+ * The entry is a single flat JSON object whose values are strings or
+ * non-negative integers, such as
+ * {"artifact_id": "...", "transaction_type": "...", "previous_state": 0,
+ * "new_state": 1}.
+ *
+ * \param spec              The transaction spec to populate.
+ * \param line              The manifest line, without its line ending.
+ * \param size              The size of the manifest line.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_SYNTAX if the line is malformed.
+ *      - VCTOOL_ERROR_TRANSACTION_MISSING_FIELD if a required field is missing.
+ *      - a non-zero error code from \ref transaction_field_lookup or
+ *        \ref transaction_spec_set_field on failure.
+ */
+int transaction_spec_parse_json(
+    transaction_spec* spec, const char* line, size_t size)
+{
+    int retval;
+    size_t offset;
+    const char* key;
+    size_t key_size;
+    const char* value;
+    size_t value_size;
+    transaction_field field;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != spec);
+    MODEL_ASSERT(NULL != line);
+
+    memset(spec, 0, sizeof(*spec));
+
+    /* the entry is a single object. */
+    offset = skip_whitespace(line, size, 0);
+    if (offset >= size || '{' != line[offset])
+    {
+        return VCTOOL_ERROR_TRANSACTION_SYNTAX;
+    }
+
+    /* an empty object is still missing its required fields. */
+    offset = skip_whitespace(line, size, offset + 1);
+    if (offset < size && '}' == line[offset])
+    {
+        ++offset;
+        goto check_end;
+    }
+
+    for (;;)
+    {
+        /* read the key. */
+        retval = read_string(&key, &key_size, &offset, line, size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        /* the key is followed by a colon. */
+        offset = skip_whitespace(line, size, offset);
+        if (offset >= size || ':' != line[offset])
+        {
+            return VCTOOL_ERROR_TRANSACTION_SYNTAX;
+        }
+
+        /* the value is either a string or a number. */
+        offset = skip_whitespace(line, size, offset + 1);
+        if (offset < size && '"' == line[offset])
+        {
+            retval = read_string(&value, &value_size, &offset, line, size);
+            if (VCTOOL_STATUS_SUCCESS != retval)
+            {
+                return retval;
+            }
+        }
+        else
+        {
+            value = line + offset;
+            offset = read_number(line, size, offset);
+            value_size = (size_t)(line + offset - value);
+            if (0 == value_size)
+            {
+                return VCTOOL_ERROR_TRANSACTION_SYNTAX;
+            }
+        }
+
+        /* set the field. */
+        retval = transaction_field_lookup(&field, key, key_size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        retval = transaction_spec_set_field(spec, field, value, value_size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        /* the value is followed by another member or the end of the object. */
+        offset = skip_whitespace(line, size, offset);
+        if (offset >= size)
+        {
+            return VCTOOL_ERROR_TRANSACTION_SYNTAX;
+        }
+        else if ('}' == line[offset])
+        {
+            ++offset;
+            break;
+        }
+        else if (',' != line[offset])
+        {
+            return VCTOOL_ERROR_TRANSACTION_SYNTAX;
+        }
+
+        offset = skip_whitespace(line, size, offset + 1);
+    }
+
+check_end:
+    /* nothing but whitespace can follow the object. */
+    if (skip_whitespace(line, size, offset) != size)
+    {
+        return VCTOOL_ERROR_TRANSACTION_SYNTAX;
+    }
+
+    /* every required field must be set. */
+    if (TRANSACTION_REQUIRED_FIELDS !=
+            (spec->fields & TRANSACTION_REQUIRED_FIELDS))
+    {
+        return VCTOOL_ERROR_TRANSACTION_MISSING_FIELD;
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Skip whitespace.
+ *
+ * \param line              The line.
+ * \param size              The size of the line.
+ * \param offset            The offset at which to start.
+ *
+ * \returns the offset of the next non-whitespace character, or the size of the
+ * line.
+ */
+static size_t skip_whitespace(const char* line, size_t size, size_t offset)
+{
+    while (offset < size
+        && (' ' == line[offset] || '\t' == line[offset]
+         || '\r' == line[offset] || '\n' == line[offset]))
+    {
+        ++offset;
+    }
+
+    return offset;
+}
+
+/**
+ * \brief Read a string.
+ *
+ * The manifest only holds names, UUIDs, and numbers, so escape sequences are
+ * rejected rather than decoded.
+ *
+ * \param str               Pointer to receive the start of the string.
+ * \param str_size          Pointer to receive the size of the string.
+ * \param offset            The offset of the opening quote; on success, this
+ *                          is updated to the offset after the closing quote.
+ * \param line              The line.
+ * \param size              The size of the line.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_SYNTAX if the string is malformed.
+ */
+static int read_string(
+    const char** str, size_t* str_size, size_t* offset, const char* line,
+    size_t size)
+{
+    size_t i = *offset;
+
+    if (i >= size || '"' != line[i])
+    {
+        return VCTOOL_ERROR_TRANSACTION_SYNTAX;
+    }
+
+    for (size_t start = ++i; i < size; ++i)
+    {
+        if ('"' == line[i])
+        {
+            *str = line + start;
+            *str_size = i - start;
+            *offset = i + 1;
+            return VCTOOL_STATUS_SUCCESS;
+        }
+        else if ('\\' == line[i])
+        {
+            return VCTOOL_ERROR_TRANSACTION_SYNTAX;
+        }
+    }
+
+    /* the string is not terminated. */
+    return VCTOOL_ERROR_TRANSACTION_SYNTAX;
+}
+
+/**
+ * \brief Read a number.
+ *
+ * \param line              The line.
+ * \param size              The size of the line.
+ * \param offset            The offset of the first digit.
+ *
+ * \returns the offset after the last digit.
+ */
+static size_t read_number(const char* line, size_t size, size_t offset)
+{
+    while (offset < size && line[offset] >= '0' && line[offset] <= '9')
+    {
+        ++offset;
+    }
+
+    return offset;
+}
@@ -0,0 +1,187 @@
+/**
+ * \file transaction/transaction_spec_set_field.c
+ *
+ * \brief Set a field of a transaction spec from its manifest value.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vctool/status_codes.h>
+#include <vctool/transaction.h>
+#include <vpr/uuid.h>
+
+/* the size of a UUID string, such as 00000000-0000-0000-0000-000000000000. */
+#define TRANSACTION_UUID_STRING_SIZE 36
+
+/* forward decls. */
+static int transaction_parse_uuid(
+    uint8_t* id, const char* value, size_t size);
+static int transaction_parse_uint(
+    uint64_t* number, uint64_t max, const char* value, size_t size);
+
+/**
+ * \brief Set a field of a transaction spec from its manifest value.
+ *
+ * Id fields are UUID strings, and every other field is a decimal number.
+ *
+ * \param spec              The transaction spec to update.
+ * \param field             The field to set.
+ * \param value             The field value; this need not be ASCIIZ.
+ * \param size              The size of the field value.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_DUPLICATE_FIELD if the field is already set.
+ *      - VCTOOL_ERROR_TRANSACTION_BAD_VALUE if the value is invalid.
+ */
+int transaction_spec_set_field(
+    transaction_spec* spec, transaction_field field, const char* value,
+    size_t size)
+{
+    int retval;
+    uint64_t number;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != spec);
+    MODEL_ASSERT(field < TRANSACTION_FIELD_COUNT);
+    MODEL_ASSERT(NULL != value);
+
+    /* each field can only be set once. */
+    if (spec->fields & TRANSACTION_FIELD_BIT(field))
+    {
+        return VCTOOL_ERROR_TRANSACTION_DUPLICATE_FIELD;
+    }
+
+    switch (field)
+    {
+        case TRANSACTION_FIELD_TRANSACTION_ID:
+            retval = transaction_parse_uuid(spec->transaction_id, value, size);
+            break;
+
+        case TRANSACTION_FIELD_PREVIOUS_TRANSACTION_ID:
+            retval =
+                transaction_parse_uuid(
+                    spec->previous_transaction_id, value, size);
+            break;
+
+        case TRANSACTION_FIELD_TRANSACTION_TYPE:
+            retval =
+                transaction_parse_uuid(spec->transaction_type, value, size);
+            break;
+
+        case TRANSACTION_FIELD_ARTIFACT_ID:
+            retval = transaction_parse_uuid(spec->artifact_id, value, size);
+            break;
+
+        case TRANSACTION_FIELD_PREVIOUS_STATE:
+            retval = transaction_parse_uint(&number, UINT32_MAX, value, size);
+            spec->previous_state = (uint32_t)number;
+            break;
+
+        case TRANSACTION_FIELD_NEW_STATE:
+            retval = transaction_parse_uint(&number, UINT32_MAX, value, size);
+            spec->new_state = (uint32_t)number;
+            break;
+
+        case TRANSACTION_FIELD_VALID_FROM:
+            retval =
+                transaction_parse_uint(
+                    &spec->valid_from, UINT64_MAX, value, size);
+            break;
+
+        default:
+            retval = VCTOOL_ERROR_TRANSACTION_UNKNOWN_FIELD;
+            break;
+    }
+
+    if (VCTOOL_STATUS_SUCCESS == retval)
+    {
+        spec->fields |= TRANSACTION_FIELD_BIT(field);
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Parse a UUID string.
+ *
+ * \param id                The 16 byte id to populate.
+ * \param value             The UUID string; this need not be ASCIIZ.
+ * \param size              The size of the UUID string.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_BAD_VALUE if the value is not a UUID.
+ */
+static int transaction_parse_uuid(
+    uint8_t* id, const char* value, size_t size)
+{
+    char str[TRANSACTION_UUID_STRING_SIZE + 1];
+    vpr_uuid uuid;
+
+    /* only the canonical form is accepted. */
+    if (TRANSACTION_UUID_STRING_SIZE != size)
+    {
+        return VCTOOL_ERROR_TRANSACTION_BAD_VALUE;
+    }
+
+    /* the UUID parser needs an ASCIIZ string. */
+    memcpy(str, value, size);
+    str[size] = 0;
+
+    if (VCTOOL_STATUS_SUCCESS != vpr_uuid_from_string(&uuid, str))
+    {
+        return VCTOOL_ERROR_TRANSACTION_BAD_VALUE;
+    }
+
+    memcpy(id, uuid.data, TRANSACTION_ID_SIZE);
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Parse a decimal number.
+ *
+ * \param number            Pointer to receive the number.
+ * \param max               The largest allowed value.
+ * \param value             The decimal string; this need not be ASCIIZ.
+ * \param size              The size of the decimal string.
+ *
+ * \returns a status code indicating success or failure.
+ *      - VCTOOL_STATUS_SUCCESS on success.
+ *      - VCTOOL_ERROR_TRANSACTION_BAD_VALUE if the value is not a number or is
+ *        out of range.
+ */
+static int transaction_parse_uint(
+    uint64_t* number, uint64_t max, const char* value, size_t size)
+{
+    uint64_t result = 0;
+
+    if (0 == size)
+    {
+        return VCTOOL_ERROR_TRANSACTION_BAD_VALUE;
+    }
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (value[i] < '0' || value[i] > '9')
+        {
+            return VCTOOL_ERROR_TRANSACTION_BAD_VALUE;
+        }
+
+        /* reject values that would exceed the maximum. */
+        uint64_t digit = (uint64_t)(value[i] - '0');
+        if (result > (max - digit) / 10)
+        {
+            return VCTOOL_ERROR_TRANSACTION_BAD_VALUE;
+        }
+
+        result = result * 10 + digit;
+    }
+
+    *number = result;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
@@ -0,0 +1,283 @@
+/**
+ * \file test/agent/test_agent_connection.cpp
+ *
+ * \brief Unit tests for the agent connection handshake and requests.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cstring>
+#include <minunit/minunit.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vccrypt/suite.h>
+#include <vctool/agent.h>
+#include <vctool/status_codes.h>
+#include <vpr/allocator/malloc_allocator.h>
+
+#include "../../src/command/mock_agent/mock_agent_internal.h"
+#include "../../src/lib/agent/agent_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/* start of the agent_connection test suite. */
+TEST_SUITE(agent_connection);
+
+/**
+ * \brief Generate a key agreement keypair.
+ */
+static bool make_keypair(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* priv,
+    vccrypt_buffer_t* pub)
+{
+    vccrypt_key_agreement_context_t agreement;
+    bool result = false;
+
+    if (VCCRYPT_STATUS_SUCCESS !=
+            vccrypt_suite_cipher_key_agreement_init(suite, &agreement))
+    {
+        return false;
+    }
+
+    if (VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_buffer_init_for_cipher_key_agreement_private_key(
+                suite, priv)
+     && VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_buffer_init_for_cipher_key_agreement_public_key(
+                suite, pub))
+    {
+        result =
+            VCCRYPT_STATUS_SUCCESS ==
+                vccrypt_key_agreement_keypair_create(&agreement, priv, pub);
+    }
+
+    dispose((disposable_t*)&agreement);
+
+    return result;
+}
+
+/**
+ * \brief A client and an agent, each with their own keys and the other's
+ * public key.
+ */
+struct agent_pair
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    rcpr_allocator* alloc;
+    vccrypt_buffer_t client_pub;
+    vccrypt_buffer_t agent_pub;
+    agent_keys client_keys;
+    agent_keys server_keys;
+};
+
+/**
+ * \brief Create the keys for a client and an agent.
+ */
+static bool agent_pair_init(agent_pair* pair)
+{
+    memset(pair, 0, sizeof(*pair));
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&pair->alloc_opts);
+
+    if (VCCRYPT_STATUS_SUCCESS !=
+            vccrypt_suite_options_init(
+                &pair->suite, &pair->alloc_opts, VCCRYPT_SUITE_VELO_V1)
+     || STATUS_SUCCESS != rcpr_malloc_allocator_create(&pair->alloc)
+     || !make_keypair(
+            &pair->suite, &pair->client_keys.local_private_key,
+            &pair->client_pub)
+     || !make_keypair(
+            &pair->suite, &pair->server_keys.local_private_key,
+            &pair->agent_pub))
+    {
+        return false;
+    }
+
+    /* each side expects the other's id and public key. */
+    memset(&pair->client_keys.local_id, 0x11, sizeof(rcpr_uuid));
+    memset(&pair->server_keys.local_id, 0x22, sizeof(rcpr_uuid));
+    pair->client_keys.peer_id = pair->server_keys.local_id;
+    pair->server_keys.peer_id = pair->client_keys.local_id;
+
+    return
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_buffer_init(
+                &pair->client_keys.peer_public_key, &pair->alloc_opts,
+                pair->agent_pub.size)
+     && VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_buffer_copy(
+                &pair->client_keys.peer_public_key, &pair->agent_pub)
+     && VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_buffer_init(
+                &pair->server_keys.peer_public_key, &pair->alloc_opts,
+                pair->client_pub.size)
+     && VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_buffer_copy(
+                &pair->server_keys.peer_public_key, &pair->client_pub);
+}
+
+/**
+ * \brief Dispose of the keys for a client and an agent.
+ */
+static void agent_pair_dispose(agent_pair* pair)
+{
+    agent_keys_dispose(&pair->client_keys);
+    agent_keys_dispose(&pair->server_keys);
+    dispose((disposable_t*)&pair->client_pub);
+    dispose((disposable_t*)&pair->agent_pub);
+    resource_release(rcpr_allocator_resource_handle(pair->alloc));
+    dispose((disposable_t*)&pair->suite);
+    dispose((disposable_t*)&pair->alloc_opts);
+}
+
+/**
+ * \brief Start an empty mock agent on one end of a socket pair in a child
+ * process, and connect a client to the other end.
+ *
+ * \returns the child process id, or -1 on failure.
+ */
+static pid_t start_mock_agent(agent_pair* pair, agent_connection* client)
+{
+    int fds[2];
+
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, fds))
+    {
+        return -1;
+    }
+
+    pid_t pid = fork();
+    if (0 == pid)
+    {
+        agent_connection conn;
+        mock_agent agent;
+
+        close(fds[0]);
+        memset(&agent, 0, sizeof(agent));
+
+        int retval =
+            agent_connection_init(&conn, pair->alloc, &pair->suite, fds[1]);
+        if (VCTOOL_STATUS_SUCCESS == retval)
+        {
+            retval = mock_agent_handshake(&conn, &pair->server_keys);
+            if (VCTOOL_STATUS_SUCCESS == retval)
+            {
+                retval = mock_agent_serve(&agent, &conn);
+            }
+
+            agent_connection_dispose(&conn);
+        }
+
+        _exit(VCTOOL_STATUS_SUCCESS == retval ? 0 : 1);
+    }
+
+    close(fds[1]);
+    if (pid < 0
+     || VCTOOL_STATUS_SUCCESS !=
+            agent_connection_init(client, pair->alloc, &pair->suite, fds[0]))
+    {
+        close(fds[0]);
+        return -1;
+    }
+
+    return pid;
+}
+
+/**
+ * \brief Wait for the mock agent, and return whether it succeeded.
+ */
+static bool mock_agent_succeeded(pid_t pid)
+{
+    int wstatus;
+
+    return
+        pid == waitpid(pid, &wstatus, 0)
+     && WIFEXITED(wstatus) && 0 == WEXITSTATUS(wstatus);
+}
+
+/* A client and agent with each other's keys authenticate, and a request is
+ * answered with its request id and offset. */
+TEST(handshake_and_request)
+{
+    agent_pair pair;
+    agent_connection client;
+    vccrypt_buffer_t response;
+    uint32_t request_id, offset, status;
+
+    TEST_ASSERT(agent_pair_init(&pair));
+    pid_t pid = start_mock_agent(&pair, &client);
+    TEST_ASSERT(pid > 0);
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            agent_connection_handshake(&client, &pair.client_keys));
+    TEST_EXPECT(client.authenticated);
+
+    /* the empty mock agent has no latest block. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            vcblockchain_protocol_sendreq_latest_block_id_get(
+                client.sock, client.suite, &client.client_iv,
+                &client.shared_secret, 7));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            agent_connection_receive(
+                &client, &response, &request_id, &offset, &status));
+    TEST_EXPECT(PROTOCOL_REQ_ID_LATEST_BLOCK_ID_GET == request_id);
+    TEST_EXPECT(7U == offset);
+    TEST_EXPECT(MOCK_AGENT_STATUS_NOT_FOUND == status);
+    TEST_EXPECT(
+        VCTOOL_ERROR_AGENT_REQUEST_FAILED == agent_status_to_error(status));
+    dispose((disposable_t*)&response);
+
+    /* closing the connection ends the session cleanly. */
+    agent_connection_dispose(&client);
+    TEST_EXPECT(mock_agent_succeeded(pid));
+
+    agent_pair_dispose(&pair);
+}
+
+/* A client refuses an agent that is not the expected agent. */
+TEST(unexpected_agent_rejected)
+{
+    agent_pair pair;
+    agent_connection client;
+
+    TEST_ASSERT(agent_pair_init(&pair));
+    memset(&pair.client_keys.peer_id, 0x33, sizeof(rcpr_uuid));
+    pid_t pid = start_mock_agent(&pair, &client);
+    TEST_ASSERT(pid > 0);
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED ==
+            agent_connection_handshake(&client, &pair.client_keys));
+    TEST_EXPECT(!client.authenticated);
+
+    agent_connection_dispose(&client);
+    TEST_EXPECT(!mock_agent_succeeded(pid));
+
+    agent_pair_dispose(&pair);
+}
+
+/* An agent refuses a client that is not the expected client. */
+TEST(unexpected_client_rejected)
+{
+    agent_pair pair;
+    agent_connection client;
+
+    TEST_ASSERT(agent_pair_init(&pair));
+    memset(&pair.server_keys.peer_id, 0x33, sizeof(rcpr_uuid));
+    pid_t pid = start_mock_agent(&pair, &client);
+    TEST_ASSERT(pid > 0);
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_AGENT_HANDSHAKE_FAILED ==
+            agent_connection_handshake(&client, &pair.client_keys));
+
+    agent_connection_dispose(&client);
+    TEST_EXPECT(!mock_agent_succeeded(pid));
+
+    agent_pair_dispose(&pair);
+}
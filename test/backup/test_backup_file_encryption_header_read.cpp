@@ -0,0 +1,276 @@
+/**
+ * \file test/backup/test_backup_file_encryption_header_read.cpp
+ *
+ * \brief Unit tests for backup_file_encryption_header_read.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <minunit/minunit.h>
+#include <string.h>
+#include <vccrypt/suite.h>
+#include <vctool/backup.h>
+#include <vector>
+#include <vpr/allocator/malloc_allocator.h>
+
+#include "../file/mock_file.h"
+
+using namespace std;
+
+/* start of the test suite. */
+TEST_SUITE(backup_file_encryption_header_read);
+
+/** \brief The number of key derivation rounds used by these tests. */
+#define TEST_ROUNDS 16
+
+/**
+ * \brief Initialize a mock file interface that keeps a single file in memory.
+ *
+ * Writes append to the file, and reads start from the beginning.
+ */
+static int memory_file_init(file* f, vector<uint8_t>& contents, size_t& pos)
+{
+    return
+        file_mock_init(
+            f,
+            /* stat. */
+            [&](file*, const char*, file_stat_st*) -> int {
+                return VCTOOL_ERROR_FILE_NO_ENTRY;
+            },
+            /* open. */
+            [&](file*, int*, const char*, int, mode_t) -> int {
+                return VCTOOL_ERROR_FILE_NO_ENTRY;
+            },
+            /* close. */
+            [&](file*, int) -> int {
+                return VCTOOL_STATUS_SUCCESS;
+            },
+            /* read. */
+            [&](file*, int, void* buf, size_t size, size_t* read) -> int {
+                *read = min(size, contents.size() - pos);
+                memcpy(buf, contents.data() + pos, *read);
+                pos += *read;
+
+                return VCTOOL_STATUS_SUCCESS;
+            },
+            /* write. */
+            [&](
+                file*, int, const void* buf, size_t size,
+                size_t* written) -> int {
+                    const uint8_t* bbuf = (const uint8_t*)buf;
+                    contents.insert(contents.end(), bbuf, bbuf + size);
+                    *written = size;
+
+                    return VCTOOL_STATUS_SUCCESS;
+            },
+            /* lseek. */
+            [&](file*, int, off_t, file_lseek_whence, off_t*) -> int {
+                return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+            },
+            /* fsync. */
+            [&](file*, int) -> int {
+                return VCTOOL_STATUS_SUCCESS;
+            });
+}
+
+/**
+ * \brief Initialize a passphrase buffer from a string.
+ */
+static int passphrase_init(
+    vccrypt_buffer_t* passphrase, allocator_options_t* alloc_opts,
+    const char* str)
+{
+    int retval = vccrypt_buffer_init(passphrase, alloc_opts, strlen(str));
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memcpy(passphrase->data, str, strlen(str));
+
+    return VCCRYPT_STATUS_SUCCESS;
+}
+
+/* Verify that parameters are null checked. */
+TEST(parameter_checks)
+{
+    file f;
+    vccrypt_suite_options_t suite;
+    vccrypt_buffer_t passphrase;
+    backup_file_enc_header header;
+    vccrypt_buffer_t key;
+    int EXPECTED_DESC = 17;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_PARAMETER ==
+            backup_file_encryption_header_read(
+                nullptr, EXPECTED_DESC, &suite, &passphrase, &header, &key));
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_PARAMETER ==
+            backup_file_encryption_header_read(
+                &f, -1, &suite, &passphrase, &header, &key));
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_PARAMETER ==
+            backup_file_encryption_header_read(
+                &f, EXPECTED_DESC, nullptr, &passphrase, &header, &key));
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_PARAMETER ==
+            backup_file_encryption_header_read(
+                &f, EXPECTED_DESC, &suite, nullptr, &header, &key));
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_PARAMETER ==
+            backup_file_encryption_header_read(
+                &f, EXPECTED_DESC, &suite, &passphrase, nullptr, &key));
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_PARAMETER ==
+            backup_file_encryption_header_read(
+                &f, EXPECTED_DESC, &suite, &passphrase, &header, nullptr));
+}
+
+/* Verify that a header that was written can be read with its passphrase. */
+TEST(round_trip)
+{
+    file f;
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccrypt_buffer_t passphrase;
+    backup_file_enc_header header;
+    vccrypt_buffer_t key;
+    vector<uint8_t> contents;
+    size_t pos = 0;
+    int EXPECTED_DESC = 17;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS == memory_file_init(&f, contents, pos));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            passphrase_init(&passphrase, &alloc_opts, "correct horse"));
+
+    /* write the header. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            backup_file_encryption_header_write(
+                &f, EXPECTED_DESC, &suite, &passphrase, TEST_ROUNDS));
+    TEST_ASSERT(BACKUP_FILE_SIZE_FILE_ENC_HEADER == contents.size());
+
+    /* read it back. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            backup_file_encryption_header_read(
+                &f, EXPECTED_DESC, &suite, &passphrase, &header, &key));
+
+    /* the header fields are decoded. */
+    TEST_EXPECT(!memcmp(header.file_magic, "ENCVCBAK", 8));
+    TEST_EXPECT(
+        BACKUP_FILE_ENC_HEADER_SERIALIZATION_VERSION
+            == header.serialization_version);
+    TEST_EXPECT(BACKUP_FILE_SIZE_FILE_ENC_HEADER == header.record_size);
+    TEST_EXPECT(TEST_ROUNDS == header.rounds);
+    TEST_EXPECT(32 == key.size);
+
+    dispose(vccrypt_buffer_disposable_handle(&key));
+    dispose((disposable_t*)&header);
+    dispose(vccrypt_buffer_disposable_handle(&passphrase));
+    dispose((disposable_t*)&f);
+    dispose((disposable_t*)&suite);
+    dispose((disposable_t*)&alloc_opts);
+}
+
+/* Verify that the header can't be read with the wrong passphrase. */
+TEST(wrong_passphrase)
+{
+    file f;
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccrypt_buffer_t passphrase;
+    vccrypt_buffer_t wrong_passphrase;
+    backup_file_enc_header header;
+    vccrypt_buffer_t key;
+    vector<uint8_t> contents;
+    size_t pos = 0;
+    int EXPECTED_DESC = 17;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS == memory_file_init(&f, contents, pos));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            passphrase_init(&passphrase, &alloc_opts, "correct horse"));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            passphrase_init(
+                &wrong_passphrase, &alloc_opts, "battery staple"));
+
+    /* write the header. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            backup_file_encryption_header_write(
+                &f, EXPECTED_DESC, &suite, &passphrase, TEST_ROUNDS));
+
+    /* the wrong passphrase fails authentication. */
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_MAC ==
+            backup_file_encryption_header_read(
+                &f, EXPECTED_DESC, &suite, &wrong_passphrase, &header,
+                &key));
+
+    dispose(vccrypt_buffer_disposable_handle(&wrong_passphrase));
+    dispose(vccrypt_buffer_disposable_handle(&passphrase));
+    dispose((disposable_t*)&f);
+    dispose((disposable_t*)&suite);
+    dispose((disposable_t*)&alloc_opts);
+}
+
+/* Verify that a truncated header is rejected. */
+TEST(truncated)
+{
+    file f;
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccrypt_buffer_t passphrase;
+    backup_file_enc_header header;
+    vccrypt_buffer_t key;
+    vector<uint8_t> contents;
+    size_t pos = 0;
+    int EXPECTED_DESC = 17;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS == memory_file_init(&f, contents, pos));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            passphrase_init(&passphrase, &alloc_opts, "correct horse"));
+
+    /* write the header, then drop its last byte. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            backup_file_encryption_header_write(
+                &f, EXPECTED_DESC, &suite, &passphrase, TEST_ROUNDS));
+    contents.pop_back();
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_TRUNCATED_RECORD ==
+            backup_file_encryption_header_read(
+                &f, EXPECTED_DESC, &suite, &passphrase, &header, &key));
+
+    dispose(vccrypt_buffer_disposable_handle(&passphrase));
+    dispose((disposable_t*)&f);
+    dispose((disposable_t*)&suite);
+    dispose((disposable_t*)&alloc_opts);
+}
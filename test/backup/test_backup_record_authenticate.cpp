@@ -0,0 +1,148 @@
+/**
+ * \file test/backup/test_backup_record_authenticate.cpp
+ *
+ * \brief Unit tests for backup_record_authenticate.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <arpa/inet.h>
+#include <minunit/minunit.h>
+#include <string.h>
+#include <vcblockchain/byteswap.h>
+#include <vccrypt/suite.h>
+#include <vctool/backup.h>
+#include <vector>
+#include <vpr/allocator/malloc_allocator.h>
+
+using namespace std;
+
+/* start of the test suite. */
+TEST_SUITE(backup_record_authenticate);
+
+/** \brief The size of the body of the test record. */
+#define TEST_BODY_SIZE 48
+
+/**
+ * \brief Encode a record header and a body, and MAC them with the key.
+ */
+static bool make_record(
+    vector<uint8_t>* record, vccrypt_suite_options_t* suite,
+    vccrypt_buffer_t* key, uint32_t type)
+{
+    vccrypt_buffer_t mac_buffer;
+    vccrypt_mac_context_t mac;
+    uint32_t net_type = htonl(type);
+    uint64_t net_record_size =
+        htonll(BACKUP_FILE_SIZE_RECORD_HEADER_RAW + TEST_BODY_SIZE);
+    bool result = false;
+
+    record->assign(BACKUP_FILE_SIZE_RECORD_HEADER_RAW + TEST_BODY_SIZE, 0);
+    uint8_t* buf = record->data();
+    memset(buf, 0xa5, 16);
+    memcpy(buf + 16, &net_type, 4);
+    memcpy(buf + 24, &net_record_size, 8);
+    for (size_t i = 0; i < TEST_BODY_SIZE; ++i)
+    {
+        buf[BACKUP_FILE_SIZE_RECORD_HEADER_RAW + i] = (uint8_t)i;
+    }
+
+    if (VCCRYPT_STATUS_SUCCESS !=
+            vccrypt_suite_buffer_init_for_mac_authentication_code(
+                suite, &mac_buffer, true))
+    {
+        return false;
+    }
+
+    if (VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_mac_short_init(suite, &mac, key))
+    {
+        result =
+            VCCRYPT_STATUS_SUCCESS ==
+                vccrypt_mac_digest(
+                    &mac, buf, BACKUP_FILE_SIZE_RECORD_HEADER_RAW - 32)
+         && VCCRYPT_STATUS_SUCCESS ==
+                vccrypt_mac_digest(
+                    &mac, buf + BACKUP_FILE_SIZE_RECORD_HEADER_RAW,
+                    TEST_BODY_SIZE)
+         && VCCRYPT_STATUS_SUCCESS == vccrypt_mac_finalize(&mac, &mac_buffer);
+
+        dispose((disposable_t*)&mac);
+    }
+
+    memcpy(buf + 32, mac_buffer.data, 32);
+    dispose((disposable_t*)&mac_buffer);
+
+    return result;
+}
+
+/**
+ * \brief Decode and authenticate a record.
+ */
+static int authenticate(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* key,
+    const vector<uint8_t>& record)
+{
+    backup_record_header header;
+
+    int retval =
+        backup_record_header_read(&header, record.data(), record.size());
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval = backup_record_authenticate(suite, key, &header, record.data());
+    dispose((disposable_t*)&header);
+
+    return retval;
+}
+
+/* Verify that an authentic record passes, and that a change to its type, its
+ * body, or its key fails. */
+TEST(authenticate_record)
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccrypt_buffer_t key, other_key;
+    vector<uint8_t> record;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS == vccrypt_buffer_init(&key, &alloc_opts, 32));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_buffer_init(&other_key, &alloc_opts, 32));
+    memset(key.data, 0x42, key.size);
+    memset(other_key.data, 0x43, other_key.size);
+
+    TEST_ASSERT(
+        make_record(&record, &suite, &key, BACKUP_RECORD_TYPE_ACCOUNTING));
+    TEST_EXPECT(
+        VCTOOL_STATUS_SUCCESS == authenticate(&suite, &key, record));
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_MAC
+            == authenticate(&suite, &other_key, record));
+
+    /* a block record relabelled as another record type. */
+    TEST_ASSERT(make_record(&record, &suite, &key, BACKUP_RECORD_TYPE_BLOCK));
+    record[19] = BACKUP_RECORD_TYPE_ROOT;
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_MAC == authenticate(&suite, &key, record));
+
+    /* a changed body. */
+    TEST_ASSERT(make_record(&record, &suite, &key, BACKUP_RECORD_TYPE_ROOT));
+    record.back() ^= 0x01;
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_MAC == authenticate(&suite, &key, record));
+
+    dispose((disposable_t*)&other_key);
+    dispose((disposable_t*)&key);
+    dispose((disposable_t*)&suite);
+    dispose((disposable_t*)&alloc_opts);
+}
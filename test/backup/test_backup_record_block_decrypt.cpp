@@ -0,0 +1,357 @@
+/**
+ * \file test/backup/test_backup_record_block_decrypt.cpp
+ *
+ * \brief Unit tests for backup_record_block_decrypt.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <arpa/inet.h>
+#include <minunit/minunit.h>
+#include <string.h>
+#include <vcblockchain/byteswap.h>
+#include <vccrypt/suite.h>
+#include <vctool/backup.h>
+#include <vector>
+#include <vpr/allocator/malloc_allocator.h>
+
+using namespace std;
+
+/* start of the test suite. */
+TEST_SUITE(backup_record_block_decrypt);
+
+/** \brief The block id used by these tests. */
+static const uint8_t TEST_BLOCK_ID[16] = {
+    0x2e, 0x1b, 0x6b, 0x7d, 0x4c, 0x1a, 0x4d, 0x3e,
+    0x9a, 0x51, 0x0c, 0x85, 0x63, 0x20, 0xf1, 0x77 };
+
+/** \brief The block height used by these tests. */
+#define TEST_BLOCK_HEIGHT 12345
+
+/**
+ * \brief Encode and encrypt a block record, as the backup command writes it.
+ *
+ * \param record        The vector to receive the record.
+ * \param suite         The crypto suite to use.
+ * \param key           The file key.
+ * \param block         The block to encode.
+ * \param declared_size The block size to write in the block header.
+ * \param pad_value     The value of each pad byte.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int encode_block_record(
+    vector<uint8_t>& record, vccrypt_suite_options_t* suite,
+    vccrypt_buffer_t* key, const vector<uint8_t>& block,
+    uint64_t declared_size, uint8_t pad_value)
+{
+    int retval;
+    vccrypt_block_context_t cipher;
+    vccrypt_mac_context_t mac;
+    vccrypt_buffer_t mac_buffer;
+
+    /* build the plaintext body: block header, block, and padding. */
+    size_t body_size = CRYPTO_PAD(32 + block.size());
+    vector<uint8_t> plain(body_size, pad_value);
+    uint64_t net_height = htonll(TEST_BLOCK_HEIGHT);
+    uint64_t net_size = htonll(declared_size);
+    memcpy(plain.data(), TEST_BLOCK_ID, 16);
+    memcpy(plain.data() + 16, &net_height, 8);
+    memcpy(plain.data() + 24, &net_size, 8);
+    memcpy(plain.data() + 32, block.data(), block.size());
+
+    /* build the clear header. */
+    uint64_t record_size = BACKUP_FILE_SIZE_RECORD_HEADER_RAW + body_size;
+    uint32_t net_type = htonl(BACKUP_RECORD_TYPE_BLOCK);
+    uint64_t net_record_size = htonll(record_size);
+    record.assign(record_size, 0);
+    for (int i = 0; i < 16; ++i)
+    {
+        record[i] = (uint8_t)(0x40 + i);
+    }
+    memcpy(record.data() + 16, &net_type, 4);
+    memcpy(record.data() + 24, &net_record_size, 8);
+
+    /* encrypt the body in CBC mode, starting from the record IV. */
+    retval = vccrypt_suite_block_init(suite, &cipher, key, true);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    uint8_t* body = record.data() + BACKUP_FILE_SIZE_RECORD_HEADER_RAW;
+    const uint8_t* iv = record.data();
+    for (size_t offset = 0; offset < body_size; offset += 16)
+    {
+        retval =
+            vccrypt_block_encrypt(
+                &cipher, iv, plain.data() + offset, body + offset);
+        if (VCCRYPT_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_cipher;
+        }
+
+        iv = body + offset;
+    }
+
+    /* mac the header up to the mac, and the encrypted body. */
+    retval =
+        vccrypt_suite_buffer_init_for_mac_authentication_code(
+            suite, &mac_buffer, true);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_cipher;
+    }
+
+    retval = vccrypt_suite_mac_short_init(suite, &mac, key);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mac_buffer;
+    }
+
+    retval =
+        vccrypt_mac_digest(
+            &mac, record.data(), BACKUP_FILE_SIZE_RECORD_HEADER_RAW - 32);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mac;
+    }
+
+    retval = vccrypt_mac_digest(&mac, body, body_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mac;
+    }
+
+    retval = vccrypt_mac_finalize(&mac, &mac_buffer);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mac;
+    }
+
+    memcpy(record.data() + 32, mac_buffer.data, 32);
+
+cleanup_mac:
+    dispose((disposable_t*)&mac);
+
+cleanup_mac_buffer:
+    dispose(vccrypt_buffer_disposable_handle(&mac_buffer));
+
+cleanup_cipher:
+    dispose((disposable_t*)&cipher);
+
+    return retval;
+}
+
+/**
+ * \brief Test fixture state.
+ */
+struct decrypt_fixture
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccrypt_buffer_t key;
+    vector<uint8_t> block;
+};
+
+/**
+ * \brief Initialize the crypto suite, a file key, and a test block.
+ */
+static int fixture_init(decrypt_fixture* fixture, size_t block_size)
+{
+    int retval;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&fixture->alloc_opts);
+
+    retval =
+        vccrypt_suite_options_init(
+            &fixture->suite, &fixture->alloc_opts, VCCRYPT_SUITE_VELO_V1);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        dispose((disposable_t*)&fixture->alloc_opts);
+        return retval;
+    }
+
+    retval = vccrypt_buffer_init(&fixture->key, &fixture->alloc_opts, 32);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        dispose((disposable_t*)&fixture->suite);
+        dispose((disposable_t*)&fixture->alloc_opts);
+        return retval;
+    }
+
+    for (size_t i = 0; i < fixture->key.size; ++i)
+    {
+        ((uint8_t*)fixture->key.data)[i] = (uint8_t)(0x90 + i);
+    }
+
+    fixture->block.resize(block_size);
+    for (size_t i = 0; i < block_size; ++i)
+    {
+        fixture->block[i] = (uint8_t)(i * 7);
+    }
+
+    return VCCRYPT_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Dispose of the fixture.
+ */
+static void fixture_dispose(decrypt_fixture* fixture)
+{
+    dispose(vccrypt_buffer_disposable_handle(&fixture->key));
+    dispose((disposable_t*)&fixture->suite);
+    dispose((disposable_t*)&fixture->alloc_opts);
+}
+
+/* Verify that a well formed record decrypts to the original block. */
+TEST(happy_path)
+{
+    /* try a block that ends mid cipher block and one that fills it. */
+    for (size_t block_size : { 100, 96 })
+    {
+        decrypt_fixture fixture;
+        vector<uint8_t> record;
+        backup_record_block block;
+
+        TEST_ASSERT(
+            VCCRYPT_STATUS_SUCCESS == fixture_init(&fixture, block_size));
+        size_t pad_size = CRYPTO_PAD(32 + block_size) - 32 - block_size;
+        TEST_ASSERT(
+            VCCRYPT_STATUS_SUCCESS ==
+                encode_block_record(
+                    record, &fixture.suite, &fixture.key, fixture.block,
+                    block_size, (uint8_t)pad_size));
+
+        TEST_ASSERT(
+            VCTOOL_STATUS_SUCCESS ==
+                backup_record_block_decrypt(
+                    &block, &fixture.suite, &fixture.key, record.data(),
+                    record.size()));
+        TEST_EXPECT(BACKUP_RECORD_TYPE_BLOCK == block.hdr.type);
+        TEST_EXPECT(record.size() == block.hdr.record_size);
+        TEST_EXPECT(!memcmp(block.block_id.data, TEST_BLOCK_ID, 16));
+        TEST_EXPECT(TEST_BLOCK_HEIGHT == block.block_height);
+        TEST_EXPECT(block_size == block.block_size);
+        TEST_ASSERT(block_size == block.block_data.size);
+        TEST_EXPECT(
+            !memcmp(
+                block.block_data.data, fixture.block.data(), block_size));
+
+        dispose((disposable_t*)&block);
+        fixture_dispose(&fixture);
+    }
+}
+
+/* Verify that a record with a damaged MAC or body is not decrypted. */
+TEST(tampered_mac)
+{
+    decrypt_fixture fixture;
+    vector<uint8_t> record;
+    backup_record_block block;
+
+    TEST_ASSERT(VCCRYPT_STATUS_SUCCESS == fixture_init(&fixture, 100));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            encode_block_record(
+                record, &fixture.suite, &fixture.key, fixture.block, 100, 12));
+
+    /* flip a bit in the mac. */
+    vector<uint8_t> bad_mac(record);
+    bad_mac[32] ^= 0x01;
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_MAC ==
+            backup_record_block_decrypt(
+                &block, &fixture.suite, &fixture.key, bad_mac.data(),
+                bad_mac.size()));
+
+    /* flip a bit in the encrypted body. */
+    vector<uint8_t> bad_body(record);
+    bad_body[BACKUP_FILE_SIZE_RECORD_HEADER_RAW + 40] ^= 0x01;
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_MAC ==
+            backup_record_block_decrypt(
+                &block, &fixture.suite, &fixture.key, bad_body.data(),
+                bad_body.size()));
+
+    /* flip a bit in the record IV. */
+    vector<uint8_t> bad_iv(record);
+    bad_iv[0] ^= 0x01;
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_MAC ==
+            backup_record_block_decrypt(
+                &block, &fixture.suite, &fixture.key, bad_iv.data(),
+                bad_iv.size()));
+
+    fixture_dispose(&fixture);
+}
+
+/* Verify that an authentic record with bad padding is rejected. */
+TEST(bad_padding)
+{
+    decrypt_fixture fixture;
+    vector<uint8_t> record;
+    backup_record_block block;
+
+    /* 32 + 100 bytes are padded with 12 bytes of 12. */
+    TEST_ASSERT(VCCRYPT_STATUS_SUCCESS == fixture_init(&fixture, 100));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            encode_block_record(
+                record, &fixture.suite, &fixture.key, fixture.block, 100, 11));
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_RECORD ==
+            backup_record_block_decrypt(
+                &block, &fixture.suite, &fixture.key, record.data(),
+                record.size()));
+
+    fixture_dispose(&fixture);
+}
+
+/* Verify that a block size that does not match the record is rejected. */
+TEST(size_mismatch)
+{
+    decrypt_fixture fixture;
+    vector<uint8_t> record;
+    backup_record_block block;
+
+    TEST_ASSERT(VCCRYPT_STATUS_SUCCESS == fixture_init(&fixture, 100));
+
+    /* the block header claims a larger block than the body holds. */
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            encode_block_record(
+                record, &fixture.suite, &fixture.key, fixture.block, 120, 12));
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_RECORD ==
+            backup_record_block_decrypt(
+                &block, &fixture.suite, &fixture.key, record.data(),
+                record.size()));
+
+    /* the block header claims a block that would need less padding. */
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            encode_block_record(
+                record, &fixture.suite, &fixture.key, fixture.block, 80, 12));
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_RECORD ==
+            backup_record_block_decrypt(
+                &block, &fixture.suite, &fixture.key, record.data(),
+                record.size()));
+
+    /* the record is larger than its header says. */
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            encode_block_record(
+                record, &fixture.suite, &fixture.key, fixture.block, 100, 12));
+    record.resize(record.size() + 16);
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_RECORD ==
+            backup_record_block_decrypt(
+                &block, &fixture.suite, &fixture.key, record.data(),
+                record.size()));
+
+    fixture_dispose(&fixture);
+}
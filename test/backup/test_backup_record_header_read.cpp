@@ -0,0 +1,107 @@
+/**
+ * \file test/backup/test_backup_record_header_read.cpp
+ *
+ * \brief Unit tests for backup_record_header_read.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <arpa/inet.h>
+#include <minunit/minunit.h>
+#include <string.h>
+#include <vcblockchain/byteswap.h>
+#include <vctool/backup.h>
+
+/* start of the test suite. */
+TEST_SUITE(backup_record_header_read);
+
+/**
+ * \brief Encode a record header.
+ */
+static void encode_header(
+    uint8_t* buf, uint32_t type, uint32_t reserved, uint64_t record_size)
+{
+    uint32_t net_type = htonl(type);
+    uint32_t net_reserved = htonl(reserved);
+    uint64_t net_record_size = htonll(record_size);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        buf[i] = (uint8_t)(0xa0 + i);
+    }
+
+    memcpy(buf + 16, &net_type, 4);
+    memcpy(buf + 20, &net_reserved, 4);
+    memcpy(buf + 24, &net_record_size, 8);
+
+    for (int i = 0; i < 32; ++i)
+    {
+        buf[32 + i] = (uint8_t)i;
+    }
+}
+
+/* Verify that every field is decoded. */
+TEST(happy_path)
+{
+    uint8_t buf[BACKUP_FILE_SIZE_RECORD_HEADER_RAW + 48];
+    backup_record_header header;
+
+    encode_header(buf, BACKUP_RECORD_TYPE_BLOCK, 0, sizeof(buf));
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            backup_record_header_read(&header, buf, sizeof(buf)));
+    TEST_EXPECT(!memcmp(header.iv, buf, 16));
+    TEST_EXPECT(BACKUP_RECORD_TYPE_BLOCK == header.type);
+    TEST_EXPECT(0 == header.reserved);
+    TEST_EXPECT(sizeof(buf) == header.record_size);
+    TEST_EXPECT(!memcmp(header.record_mac, buf + 32, 32));
+
+    dispose((disposable_t*)&header);
+}
+
+/* Verify that a record that runs past the available bytes is truncated. */
+TEST(truncated)
+{
+    uint8_t buf[BACKUP_FILE_SIZE_RECORD_HEADER_RAW + 48];
+    backup_record_header header;
+
+    encode_header(buf, BACKUP_RECORD_TYPE_BLOCK, 0, sizeof(buf));
+
+    /* a partial header. */
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_TRUNCATED_RECORD ==
+            backup_record_header_read(
+                &header, buf, BACKUP_FILE_SIZE_RECORD_HEADER_RAW - 1));
+
+    /* a partial body. */
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_TRUNCATED_RECORD ==
+            backup_record_header_read(&header, buf, sizeof(buf) - 16));
+}
+
+/* Verify that malformed headers are rejected. */
+TEST(malformed)
+{
+    uint8_t buf[BACKUP_FILE_SIZE_RECORD_HEADER_RAW + 48];
+    backup_record_header header;
+
+    /* the reserved field must be zero. */
+    encode_header(buf, BACKUP_RECORD_TYPE_BLOCK, 1, sizeof(buf));
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_RECORD ==
+            backup_record_header_read(&header, buf, sizeof(buf)));
+
+    /* the body can't be empty. */
+    encode_header(
+        buf, BACKUP_RECORD_TYPE_BLOCK, 0, BACKUP_FILE_SIZE_RECORD_HEADER_RAW);
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_RECORD ==
+            backup_record_header_read(&header, buf, sizeof(buf)));
+
+    /* the body must be whole cipher blocks. */
+    encode_header(buf, BACKUP_RECORD_TYPE_BLOCK, 0, sizeof(buf) - 1);
+    TEST_EXPECT(
+        VCTOOL_ERROR_BACKUP_BAD_RECORD ==
+            backup_record_header_read(&header, buf, sizeof(buf)));
+}
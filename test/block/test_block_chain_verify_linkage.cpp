@@ -0,0 +1,84 @@
+/**
+ * \file test/block/test_block_chain_verify_linkage.cpp
+ *
+ * \brief Unit tests for block_chain_verify_linkage.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cstring>
+#include <minunit/minunit.h>
+#include <vctool/block.h>
+#include <vctool/status_codes.h>
+
+/* start of the block_chain_verify_linkage test suite. */
+TEST_SUITE(block_chain_verify_linkage);
+
+/**
+ * \brief Create a block at the given height that links to the block below it.
+ *
+ * Each block id is filled with its height, so linkage can be checked.
+ */
+static block_info make_block(uint64_t height)
+{
+    block_info info;
+
+    memset(info.block_id, (int)height, BLOCK_ID_SIZE);
+    memset(info.previous_block_id, (int)height - 1, BLOCK_ID_SIZE);
+    memset(info.signer_id, 0xFF, BLOCK_ID_SIZE);
+    info.height = height;
+
+    return info;
+}
+
+/* Blocks in any order that form a chain are accepted and sorted. */
+TEST(unordered_chain)
+{
+    block_info blocks[] = { make_block(3), make_block(1), make_block(2) };
+    size_t index = 0;
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == block_chain_verify_linkage(blocks, 3, &index));
+    TEST_EXPECT(1U == blocks[0].height);
+    TEST_EXPECT(2U == blocks[1].height);
+    TEST_EXPECT(3U == blocks[2].height);
+}
+
+/* A missing height is reported. */
+TEST(height_gap)
+{
+    block_info blocks[] = { make_block(1), make_block(3) };
+    size_t index = 0;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_BLOCK_HEIGHT_GAP
+            == block_chain_verify_linkage(blocks, 2, &index));
+    TEST_EXPECT(1U == index);
+}
+
+/* Two blocks with the same height are reported. */
+TEST(duplicate_height)
+{
+    block_info blocks[] = { make_block(1), make_block(2), make_block(2) };
+    size_t index = 0;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT
+            == block_chain_verify_linkage(blocks, 3, &index));
+    TEST_EXPECT(2U == index);
+}
+
+/* A block that does not link to the block before it is reported. */
+TEST(previous_mismatch)
+{
+    block_info blocks[] = { make_block(1), make_block(2) };
+    size_t index = 0;
+
+    blocks[1].previous_block_id[0] = 0x77;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_BLOCK_PREVIOUS_MISMATCH
+            == block_chain_verify_linkage(blocks, 2, &index));
+    TEST_EXPECT(1U == index);
+}
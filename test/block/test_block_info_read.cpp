@@ -0,0 +1,78 @@
+/**
+ * \file test/block/test_block_info_read.cpp
+ *
+ * \brief Unit tests for block_info_read.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cstring>
+#include <minunit/minunit.h>
+#include <vctool/block.h>
+#include <vctool/status_codes.h>
+
+/* start of the block_info_read test suite. */
+TEST_SUITE(block_info_read);
+
+/* A block with every chain field is read. */
+TEST(read_block)
+{
+    const uint8_t block[] = {
+        /* block uuid. */
+        0x00, 0x16, 0x00, 0x10,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        /* previous block uuid. */
+        0x00, 0x14, 0x00, 0x10,
+        0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+        0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+        /* block height. */
+        0x00, 0x13, 0x00, 0x08,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03,
+        /* signer id. */
+        0x00, 0x07, 0x00, 0x10,
+        0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+        0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+        /* signature. */
+        0x00, 0x08, 0x00, 0x02, 0xAA, 0xBB };
+    block_info info;
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS == block_info_read(&info, block, sizeof(block)));
+    TEST_EXPECT(0x010203U == info.height);
+    TEST_EXPECT(0 == memcmp(info.block_id, block + 4, BLOCK_ID_SIZE));
+    TEST_EXPECT(
+        0 == memcmp(info.previous_block_id, block + 24, BLOCK_ID_SIZE));
+    TEST_EXPECT(0 == memcmp(info.signer_id, block + 56, BLOCK_ID_SIZE));
+}
+
+/* A block without a height is rejected. */
+TEST(missing_height)
+{
+    const uint8_t block[] = {
+        0x00, 0x16, 0x00, 0x10,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x00, 0x14, 0x00, 0x10,
+        0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+        0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+        0x00, 0x07, 0x00, 0x10,
+        0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+        0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03 };
+    block_info info;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_BLOCK_MISSING_FIELD
+            == block_info_read(&info, block, sizeof(block)));
+}
+
+/* A block uuid of the wrong size is rejected. */
+TEST(invalid_block_id_size)
+{
+    const uint8_t block[] = { 0x00, 0x16, 0x00, 0x02, 0x01, 0x01 };
+    block_info info;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_BLOCK_INVALID_FIELD_SIZE
+            == block_info_read(&info, block, sizeof(block)));
+}
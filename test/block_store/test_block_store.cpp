@@ -0,0 +1,309 @@
+/**
+ * \file test/block_store/test_block_store.cpp
+ *
+ * \brief Unit tests for the block store.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <minunit/minunit.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vctool/block_store.h>
+#include <vctool/status_codes.h>
+#include <vector>
+
+using namespace std;
+
+/* start of the block_store test suite. */
+TEST_SUITE(block_store);
+
+/**
+ * \brief Build a block with the given height; its id is derived from the
+ * height.
+ */
+static vector<uint8_t> make_block(uint64_t height)
+{
+    vector<uint8_t> block;
+    const uint8_t header[][4] = {
+        { 0x00, 0x16, 0x00, 0x10 }, { 0x00, 0x14, 0x00, 0x10 },
+        { 0x00, 0x13, 0x00, 0x08 }, { 0x00, 0x07, 0x00, 0x10 } };
+
+    /* block uuid. */
+    block.insert(block.end(), header[0], header[0] + 4);
+    block.insert(block.end(), 15, 0x01);
+    block.push_back((uint8_t)height);
+
+    /* previous block uuid. */
+    block.insert(block.end(), header[1], header[1] + 4);
+    block.insert(block.end(), 15, 0x01);
+    block.push_back((uint8_t)(height - 1));
+
+    /* block height. */
+    block.insert(block.end(), header[2], header[2] + 4);
+    for (int i = 7; i >= 0; --i)
+    {
+        block.push_back((uint8_t)(height >> (8 * i)));
+    }
+
+    /* signer id. */
+    block.insert(block.end(), header[3], header[3] + 4);
+    block.insert(block.end(), 16, 0x03);
+
+    /* signature. */
+    const uint8_t signature[] = { 0x00, 0x08, 0x00, 0x02, 0xAA, 0xBB };
+    block.insert(block.end(), signature, signature + sizeof(signature));
+
+    return block;
+}
+
+/**
+ * \brief Get the OS file interface shared by these tests.
+ */
+static file* os_file()
+{
+    static file f;
+    static bool initialized = false;
+
+    if (!initialized)
+    {
+        file_init(&f);
+        initialized = true;
+    }
+
+    return &f;
+}
+
+/**
+ * \brief Create an empty temporary directory.
+ */
+static string make_dir()
+{
+    char dirname[] = "/tmp/block_store_XXXXXX";
+
+    return string(mkdtemp(dirname));
+}
+
+/**
+ * \brief Remove a temporary store directory.
+ */
+static void remove_dir(const string& dirname)
+{
+    string command = "rm -rf " + dirname;
+
+    (void)system(command.c_str());
+}
+
+/**
+ * \brief Check that the store holds the block at the given height.
+ */
+static bool holds_block(block_store* store, uint64_t height)
+{
+    vector<uint8_t> expected = make_block(height);
+    const block_store_entry* entry =
+        block_store_find_by_height(store, height);
+    const uint8_t* block;
+
+    if (NULL == entry || expected.size() != entry->size)
+    {
+        return false;
+    }
+
+    if (entry != block_store_find_by_id(store, expected.data() + 4))
+    {
+        return false;
+    }
+
+    return
+        VCTOOL_STATUS_SUCCESS == block_store_read(&block, store, entry)
+     && 0 == memcmp(block, expected.data(), expected.size());
+}
+
+/* Blocks appended out of order are found by height and id after reopening. */
+TEST(append_and_reopen)
+{
+    string dirname = make_dir();
+    block_store store;
+    const uint64_t heights[] = { 2, 0, 1, 5 };
+
+    TEST_ASSERT(!block_store_exists(os_file(), dirname.c_str()));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == block_store_open(&store, os_file(), dirname.c_str(), true));
+    TEST_EXPECT(block_store_exists(os_file(), dirname.c_str()));
+
+    for (uint64_t height : heights)
+    {
+        vector<uint8_t> block = make_block(height);
+        TEST_ASSERT(
+            VCTOOL_STATUS_SUCCESS
+                == block_store_append(&store, block.data(), block.size()));
+    }
+
+    /* appended blocks can be read before the store is closed. */
+    TEST_EXPECT(holds_block(&store, 1));
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == block_store_close(&store));
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == block_store_open(&store, os_file(), dirname.c_str(), false));
+    TEST_EXPECT(4U == store.count);
+    TEST_EXPECT(0U == store.entries[0].height);
+    TEST_EXPECT(5U == store.entries[3].height);
+    for (uint64_t height : heights)
+    {
+        TEST_EXPECT(holds_block(&store, height));
+    }
+    TEST_EXPECT(NULL == block_store_find_by_height(&store, 3));
+    block_store_close(&store);
+
+    remove_dir(dirname);
+}
+
+/* A second block at the same height is rejected. */
+TEST(duplicate_height)
+{
+    string dirname = make_dir();
+    block_store store;
+    vector<uint8_t> block = make_block(7);
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == block_store_open(&store, os_file(), dirname.c_str(), true));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == block_store_append(&store, block.data(), block.size()));
+    TEST_EXPECT(
+        VCTOOL_ERROR_BLOCK_DUPLICATE_HEIGHT
+            == block_store_append(&store, block.data(), block.size()));
+    TEST_EXPECT(1U == store.count);
+    block_store_close(&store);
+
+    remove_dir(dirname);
+}
+
+/* Blocks spill into new segments when a segment is full. */
+TEST(segment_rollover)
+{
+    string dirname = make_dir();
+    block_store store;
+    const size_t block_size = make_block(0).size();
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == block_store_open(&store, os_file(), dirname.c_str(), true));
+    store.segment_max_size = 3 * block_size;
+    for (uint64_t height = 0; height < 10; ++height)
+    {
+        vector<uint8_t> block = make_block(height);
+        TEST_ASSERT(
+            VCTOOL_STATUS_SUCCESS
+                == block_store_append(&store, block.data(), block.size()));
+    }
+    TEST_EXPECT(4U == store.segment_count);
+    block_store_close(&store);
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == block_store_open(&store, os_file(), dirname.c_str(), false));
+    TEST_EXPECT(10U == store.count);
+    TEST_EXPECT(4U == store.segment_count);
+    for (uint64_t height = 0; height < 10; ++height)
+    {
+        TEST_EXPECT(holds_block(&store, height));
+    }
+    block_store_close(&store);
+
+    remove_dir(dirname);
+}
+
+/* A partial index record left by an interrupted append is discarded. */
+TEST(partial_record)
+{
+    string dirname = make_dir();
+    string index = dirname + "/" BLOCK_STORE_INDEX_FILENAME;
+    block_store store;
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == block_store_open(&store, os_file(), dirname.c_str(), true));
+    for (uint64_t height = 0; height < 2; ++height)
+    {
+        vector<uint8_t> block = make_block(height);
+        TEST_ASSERT(
+            VCTOOL_STATUS_SUCCESS
+                == block_store_append(&store, block.data(), block.size()));
+    }
+    block_store_close(&store);
+
+    /* a record naming a block that was never written, then half a record. */
+    int fd = open(index.c_str(), O_WRONLY | O_APPEND);
+    TEST_ASSERT(fd >= 0);
+    uint8_t record[BLOCK_STORE_INDEX_RECORD_SIZE + 10];
+    memset(record, 0, sizeof(record));
+    record[7] = 9;
+    record[31] = 100;
+    record[39] = 200;
+    TEST_ASSERT((ssize_t)sizeof(record) == write(fd, record, sizeof(record)));
+    close(fd);
+
+    /* the read-only view ignores the bad tail. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == block_store_open(&store, os_file(), dirname.c_str(), false));
+    TEST_EXPECT(2U == store.count);
+    block_store_close(&store);
+
+    /* the writable view removes it, and appends after the good records. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == block_store_open(&store, os_file(), dirname.c_str(), true));
+    TEST_EXPECT(2U == store.count);
+    vector<uint8_t> block = make_block(2);
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == block_store_append(&store, block.data(), block.size()));
+    block_store_close(&store);
+
+    struct stat st;
+    TEST_ASSERT(0 == stat(index.c_str(), &st));
+    TEST_EXPECT(
+        BLOCK_STORE_INDEX_HEADER_SIZE + 3 * BLOCK_STORE_INDEX_RECORD_SIZE
+            == st.st_size);
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == block_store_open(&store, os_file(), dirname.c_str(), false));
+    TEST_EXPECT(3U == store.count);
+    for (uint64_t height = 0; height < 3; ++height)
+    {
+        TEST_EXPECT(holds_block(&store, height));
+    }
+    block_store_close(&store);
+
+    remove_dir(dirname);
+}
+
+/* An index without the block store magic is rejected. */
+TEST(bad_magic)
+{
+    string dirname = make_dir();
+    string index = dirname + "/" BLOCK_STORE_INDEX_FILENAME;
+    block_store store;
+
+    FILE* out = fopen(index.c_str(), "w");
+    TEST_ASSERT(NULL != out);
+    fputs("NOTANIDX", out);
+    fclose(out);
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_BLOCK_STORE_BAD_INDEX
+            == block_store_open(&store, os_file(), dirname.c_str(), false));
+
+    remove_dir(dirname);
+}
@@ -0,0 +1,265 @@
+/**
+ * \file test/certificate/test_certificate_decrypt_with_key.cpp
+ *
+ * \brief Unit tests for certificate_decrypt_with_key.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <minunit/minunit.h>
+#include <string.h>
+#include <vccrypt/suite.h>
+#include <vctool/certificate.h>
+#include <vctool/crypt.h>
+#include <vctool/status_codes.h>
+#include <vpr/allocator/malloc_allocator.h>
+
+/* start of the certificate_decrypt_with_key test suite. */
+TEST_SUITE(certificate_decrypt_with_key);
+
+/** \brief The number of key derivation rounds used by these tests. */
+#define TEST_ROUNDS 10
+
+/**
+ * Initialize a buffer with the given string.
+ */
+static int string_buffer_init(
+    vccrypt_buffer_t* buffer, allocator_options_t* alloc_opts,
+    const char* str)
+{
+    int retval;
+
+    retval = vccrypt_buffer_init(buffer, alloc_opts, strlen(str));
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memcpy(buffer->data, str, buffer->size);
+
+    return VCCRYPT_STATUS_SUCCESS;
+}
+
+/**
+ * Initialize a buffer with a simple byte pattern.
+ */
+static int pattern_buffer_init(
+    vccrypt_buffer_t* buffer, allocator_options_t* alloc_opts, size_t size)
+{
+    int retval;
+
+    retval = vccrypt_buffer_init(buffer, alloc_opts, size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        ((uint8_t*)buffer->data)[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    return VCCRYPT_STATUS_SUCCESS;
+}
+
+/**
+ * Decrypting with a key derived from the certificate's own salt and rounds
+ * gives back the original certificate, just as certificate_decrypt does.
+ */
+TEST(round_trip)
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccrypt_buffer_t password;
+    vccrypt_buffer_t cert;
+    vccrypt_buffer_t salt;
+    vccrypt_buffer_t derived_key;
+    vccrypt_buffer_t* encrypted_cert;
+    vccrypt_buffer_t* split_cert;
+    vccrypt_buffer_t* decrypted_cert;
+    unsigned int rounds = 0;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            string_buffer_init(&password, &alloc_opts, "passphrase"));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            pattern_buffer_init(&cert, &alloc_opts, 100));
+
+    /* encrypt the certificate. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_encrypt(
+                &suite, &encrypted_cert, &cert, &password, TEST_ROUNDS));
+
+    /* read the key derivation parameters. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_read_key_derivation_parameters(
+                &suite, &salt, &rounds, encrypted_cert));
+    TEST_EXPECT(TEST_ROUNDS == rounds);
+    TEST_EXPECT(suite.stream_cipher_opts.key_size == salt.size);
+
+    /* derive the key, and decrypt with it. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            crypt_derive_key_from_password(
+                &derived_key, &suite, &password, &salt, rounds));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_decrypt_with_key(
+                &suite, &split_cert, encrypted_cert, &derived_key));
+
+    /* the split path gives back the original certificate. */
+    TEST_ASSERT(cert.size == split_cert->size);
+    TEST_EXPECT(!memcmp(cert.data, split_cert->data, cert.size));
+
+    /* so does decrypting with the password. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_decrypt(
+                &suite, &decrypted_cert, encrypted_cert, &password));
+    TEST_ASSERT(cert.size == decrypted_cert->size);
+    TEST_EXPECT(!memcmp(cert.data, decrypted_cert->data, cert.size));
+
+    /* clean up. */
+    dispose((disposable_t*)decrypted_cert);
+    free(decrypted_cert);
+    dispose((disposable_t*)split_cert);
+    free(split_cert);
+    dispose((disposable_t*)&derived_key);
+    dispose((disposable_t*)&salt);
+    dispose((disposable_t*)encrypted_cert);
+    free(encrypted_cert);
+    dispose((disposable_t*)&cert);
+    dispose((disposable_t*)&password);
+    dispose((disposable_t*)&suite);
+    dispose((disposable_t*)&alloc_opts);
+}
+
+/**
+ * Decrypting with a key derived from the wrong password fails the MAC check.
+ */
+TEST(wrong_key)
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccrypt_buffer_t password;
+    vccrypt_buffer_t wrong_password;
+    vccrypt_buffer_t cert;
+    vccrypt_buffer_t salt;
+    vccrypt_buffer_t derived_key;
+    vccrypt_buffer_t* encrypted_cert;
+    vccrypt_buffer_t* decrypted_cert = nullptr;
+    unsigned int rounds = 0;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            string_buffer_init(&password, &alloc_opts, "passphrase"));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            string_buffer_init(&wrong_password, &alloc_opts, "passphrasf"));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            pattern_buffer_init(&cert, &alloc_opts, 100));
+
+    /* encrypt the certificate. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_encrypt(
+                &suite, &encrypted_cert, &cert, &password, TEST_ROUNDS));
+
+    /* derive a key from the wrong password. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_read_key_derivation_parameters(
+                &suite, &salt, &rounds, encrypted_cert));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            crypt_derive_key_from_password(
+                &derived_key, &suite, &wrong_password, &salt, rounds));
+
+    /* decryption fails. */
+    TEST_EXPECT(
+        VCTOOL_ERROR_CERTIFICATE_VERIFICATION ==
+            certificate_decrypt_with_key(
+                &suite, &decrypted_cert, encrypted_cert, &derived_key));
+    TEST_EXPECT(nullptr == decrypted_cert);
+
+    /* clean up. */
+    dispose((disposable_t*)&derived_key);
+    dispose((disposable_t*)&salt);
+    dispose((disposable_t*)encrypted_cert);
+    free(encrypted_cert);
+    dispose((disposable_t*)&cert);
+    dispose((disposable_t*)&wrong_password);
+    dispose((disposable_t*)&password);
+    dispose((disposable_t*)&suite);
+    dispose((disposable_t*)&alloc_opts);
+}
+
+/**
+ * A truncated encrypted certificate is rejected before any key is derived.
+ */
+TEST(truncated_parameters)
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccrypt_buffer_t password;
+    vccrypt_buffer_t cert;
+    vccrypt_buffer_t salt;
+    vccrypt_buffer_t truncated;
+    vccrypt_buffer_t* encrypted_cert;
+    unsigned int rounds = 0;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            string_buffer_init(&password, &alloc_opts, "passphrase"));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            pattern_buffer_init(&cert, &alloc_opts, 100));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_encrypt(
+                &suite, &encrypted_cert, &cert, &password, TEST_ROUNDS));
+
+    /* keep only the magic, the rounds, and part of the salt. */
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_buffer_init(
+                &truncated, &alloc_opts,
+                ENCRYPTED_CERT_MAGIC_SIZE + sizeof(uint32_t) + 4));
+    memcpy(truncated.data, encrypted_cert->data, truncated.size);
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_CERTIFICATE_NOT_MINIMUM_SIZE ==
+            certificate_read_key_derivation_parameters(
+                &suite, &salt, &rounds, &truncated));
+
+    /* clean up. */
+    dispose((disposable_t*)&truncated);
+    dispose((disposable_t*)encrypted_cert);
+    free(encrypted_cert);
+    dispose((disposable_t*)&cert);
+    dispose((disposable_t*)&password);
+    dispose((disposable_t*)&suite);
+    dispose((disposable_t*)&alloc_opts);
+}
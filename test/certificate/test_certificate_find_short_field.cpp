@@ -0,0 +1,63 @@
+/**
+ * \file test/certificate/test_certificate_find_short_field.cpp
+ *
+ * \brief Unit tests for certificate_find_short_field.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <minunit/minunit.h>
+#include <vctool/certificate.h>
+#include <vctool/status_codes.h>
+
+/* start of the certificate_find_short_field test suite. */
+TEST_SUITE(certificate_find_short_field);
+
+/* A field after another field is found. */
+TEST(find_second_field)
+{
+    const uint8_t cert[] = {
+        0x00, 0x01, 0x00, 0x02, 0xAA, 0xBB,
+        0x00, 0x20, 0x00, 0x03, 0x01, 0x02, 0x03 };
+    const uint8_t* value = nullptr;
+    size_t value_size = 0;
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == certificate_find_short_field(
+                    &value, &value_size, cert, sizeof(cert), 0x0020));
+    TEST_EXPECT(3U == value_size);
+    TEST_EXPECT(cert + 10 == value);
+}
+
+/* A missing field is reported as not found. */
+TEST(missing_field)
+{
+    const uint8_t cert[] = { 0x00, 0x01, 0x00, 0x01, 0xAA };
+    const uint8_t* value = nullptr;
+    size_t value_size = 0;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_CERTIFICATE_FIELD_NOT_FOUND
+            == certificate_find_short_field(
+                    &value, &value_size, cert, sizeof(cert), 0x0020));
+}
+
+/* A field whose size runs past the end of the certificate is rejected. */
+TEST(truncated_field)
+{
+    const uint8_t cert[] = { 0x00, 0x01, 0x00, 0x08, 0xAA, 0xBB };
+    const uint8_t truncated_header[] = { 0x00, 0x01, 0x00 };
+    const uint8_t* value = nullptr;
+    size_t value_size = 0;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED
+            == certificate_find_short_field(
+                    &value, &value_size, cert, sizeof(cert), 0x0001));
+    TEST_EXPECT(
+        VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED
+            == certificate_find_short_field(
+                    &value, &value_size, truncated_header,
+                    sizeof(truncated_header), 0x0001));
+}
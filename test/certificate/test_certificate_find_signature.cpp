@@ -0,0 +1,68 @@
+/**
+ * \file test/certificate/test_certificate_find_signature.cpp
+ *
+ * \brief Unit tests for certificate_find_signature.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <minunit/minunit.h>
+#include <vctool/certificate.h>
+#include <vctool/status_codes.h>
+
+/* start of the certificate_find_signature test suite. */
+TEST_SUITE(certificate_find_signature);
+
+/* The signature is the last field, and covers everything before its header. */
+TEST(find_signature)
+{
+    const uint8_t cert[] = {
+        0x00, 0x01, 0x00, 0x02, 0xAA, 0xBB,
+        0x00, 0x08, 0x00, 0x03, 0x01, 0x02, 0x03 };
+    size_t signed_size = 0;
+    const uint8_t* signature = nullptr;
+    size_t signature_size = 0;
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == certificate_find_signature(
+                    &signed_size, &signature, &signature_size, cert,
+                    sizeof(cert)));
+    TEST_EXPECT(6U == signed_size);
+    TEST_EXPECT(cert + 10 == signature);
+    TEST_EXPECT(3U == signature_size);
+}
+
+/* A signature that is not the last field is not accepted. */
+TEST(signature_not_last)
+{
+    const uint8_t cert[] = {
+        0x00, 0x08, 0x00, 0x01, 0xAA,
+        0x00, 0x01, 0x00, 0x01, 0xBB };
+    size_t signed_size = 0;
+    const uint8_t* signature = nullptr;
+    size_t signature_size = 0;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_CERTIFICATE_FIELD_NOT_FOUND
+            == certificate_find_signature(
+                    &signed_size, &signature, &signature_size, cert,
+                    sizeof(cert)));
+}
+
+/* A truncated signature field is rejected. */
+TEST(truncated_signature)
+{
+    const uint8_t cert[] = {
+        0x00, 0x01, 0x00, 0x01, 0xAA,
+        0x00, 0x08, 0x00, 0x04, 0x01, 0x02 };
+    size_t signed_size = 0;
+    const uint8_t* signature = nullptr;
+    size_t signature_size = 0;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED
+            == certificate_find_signature(
+                    &signed_size, &signature, &signature_size, cert,
+                    sizeof(cert)));
+}
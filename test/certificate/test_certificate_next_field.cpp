@@ -0,0 +1,90 @@
+/**
+ * \file test/certificate/test_certificate_next_field.cpp
+ *
+ * \brief Unit tests for certificate_next_field and certificate_field_info_get.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <minunit/minunit.h>
+#include <string.h>
+#include <vctool/certificate.h>
+#include <vctool/status_codes.h>
+
+/* start of the certificate_next_field test suite. */
+TEST_SUITE(certificate_next_field);
+
+/* Every field is read in order, and the offset ends at the certificate size. */
+TEST(read_all_fields)
+{
+    const uint8_t cert[] = {
+        0x00, 0x01, 0x00, 0x02, 0xAA, 0xBB,
+        0x04, 0x12, 0x00, 0x00,
+        0x00, 0x20, 0x00, 0x01, 0x01 };
+    size_t offset = 0;
+    uint16_t field_type = 0;
+    const uint8_t* value = nullptr;
+    size_t value_size = 0;
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == certificate_next_field(
+                    &field_type, &value, &value_size, &offset, cert,
+                    sizeof(cert)));
+    TEST_EXPECT(0x0001 == field_type);
+    TEST_EXPECT(cert + 4 == value);
+    TEST_EXPECT(2U == value_size);
+    TEST_EXPECT(6U == offset);
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == certificate_next_field(
+                    &field_type, &value, &value_size, &offset, cert,
+                    sizeof(cert)));
+    TEST_EXPECT(0x0412 == field_type);
+    TEST_EXPECT(0U == value_size);
+    TEST_EXPECT(10U == offset);
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == certificate_next_field(
+                    &field_type, &value, &value_size, &offset, cert,
+                    sizeof(cert)));
+    TEST_EXPECT(0x0020 == field_type);
+    TEST_EXPECT(sizeof(cert) == offset);
+}
+
+/* A field whose size runs past the end of the certificate is rejected. */
+TEST(truncated_field)
+{
+    const uint8_t cert[] = { 0x00, 0x01, 0x00, 0x08, 0xAA, 0xBB };
+    size_t offset = 0;
+    uint16_t field_type = 0;
+    const uint8_t* value = nullptr;
+    size_t value_size = 0;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED
+            == certificate_next_field(
+                    &field_type, &value, &value_size, &offset, cert,
+                    sizeof(cert)));
+    TEST_EXPECT(0U == offset);
+}
+
+/* Known field types have a name and format; unknown types do not. */
+TEST(field_info)
+{
+    const certificate_field_info* info;
+
+    info = certificate_field_info_get(0x0001);
+    TEST_ASSERT(nullptr != info);
+    TEST_EXPECT(!strcmp("artifact_id", info->name));
+    TEST_EXPECT(CERTIFICATE_FIELD_FORMAT_UUID == info->format);
+
+    info = certificate_field_info_get(0x0013);
+    TEST_ASSERT(nullptr != info);
+    TEST_EXPECT(CERTIFICATE_FIELD_FORMAT_UINT == info->format);
+
+    TEST_EXPECT(nullptr == certificate_field_info_get(0x0000));
+    TEST_EXPECT(nullptr == certificate_field_info_get(0x0412));
+}
@@ -0,0 +1,81 @@
+/**
+ * \file test/certificate/test_certificate_stream_next.cpp
+ *
+ * \brief Unit tests for certificate_stream_next.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <minunit/minunit.h>
+#include <vctool/certificate.h>
+#include <vctool/status_codes.h>
+
+/* start of the certificate_stream_next test suite. */
+TEST_SUITE(certificate_stream_next);
+
+/* Each certificate ends with its signature field. */
+TEST(split_two_certificates)
+{
+    const uint8_t stream[] = {
+        0x00, 0x01, 0x00, 0x02, 0xAA, 0xBB,
+        0x00, 0x08, 0x00, 0x01, 0x01,
+        0x00, 0x01, 0x00, 0x01, 0xCC,
+        0x00, 0x05, 0x00, 0x00,
+        0x00, 0x08, 0x00, 0x02, 0x02, 0x03 };
+    const uint8_t* cert = nullptr;
+    size_t cert_size = 0;
+    size_t offset = 0;
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == certificate_stream_next(
+                    &cert, &cert_size, &offset, stream, sizeof(stream)));
+    TEST_EXPECT(stream == cert);
+    TEST_EXPECT(11U == cert_size);
+    TEST_EXPECT(11U == offset);
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == certificate_stream_next(
+                    &cert, &cert_size, &offset, stream, sizeof(stream)));
+    TEST_EXPECT(stream + 11 == cert);
+    TEST_EXPECT(15U == cert_size);
+    TEST_EXPECT(sizeof(stream) == offset);
+}
+
+/* A stream that ends before a signature is rejected. */
+TEST(missing_signature)
+{
+    const uint8_t stream[] = {
+        0x00, 0x01, 0x00, 0x01, 0xAA,
+        0x00, 0x08, 0x00, 0x01, 0x01,
+        0x00, 0x01, 0x00, 0x01, 0xBB };
+    const uint8_t* cert = nullptr;
+    size_t cert_size = 0;
+    size_t offset = 0;
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == certificate_stream_next(
+                    &cert, &cert_size, &offset, stream, sizeof(stream)));
+    TEST_EXPECT(
+        VCTOOL_ERROR_CERTIFICATE_FIELD_NOT_FOUND
+            == certificate_stream_next(
+                    &cert, &cert_size, &offset, stream, sizeof(stream)));
+    TEST_EXPECT(10U == offset);
+}
+
+/* A truncated field is rejected. */
+TEST(truncated_field)
+{
+    const uint8_t stream[] = {
+        0x00, 0x01, 0x00, 0x04, 0xAA, 0xBB };
+    const uint8_t* cert = nullptr;
+    size_t cert_size = 0;
+    size_t offset = 0;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED
+            == certificate_stream_next(
+                    &cert, &cert_size, &offset, stream, sizeof(stream)));
+}
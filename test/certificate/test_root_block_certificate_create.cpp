@@ -0,0 +1,221 @@
+/**
+ * \file test/certificate/test_root_block_certificate_create.cpp
+ *
+ * \brief Unit tests for root_block_certificate_create.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <minunit/minunit.h>
+#include <string.h>
+#include <vccert/builder.h>
+#include <vccrypt/suite.h>
+#include <vctool/certificate.h>
+#include <vctool/commandline.h>
+#include <vctool/status_codes.h>
+#include <vpr/allocator/malloc_allocator.h>
+
+/* start of the root_block_certificate_create test suite. */
+TEST_SUITE(root_block_certificate_create);
+
+static const uint8_t BLOCK_ID[16] = {
+    0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+    0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20 };
+
+static const uint8_t SIGNER_ID[16] = {
+    0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30 };
+
+/** \brief The timestamp used by these tests. */
+#define TEST_VALID_FROM 1672531200ULL
+
+/**
+ * Create a signing keypair with the given suite.
+ */
+static int signing_keypair_create(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* privkey,
+    vccrypt_buffer_t* pubkey)
+{
+    int retval;
+    vccrypt_digital_signature_context_t sign;
+
+    retval = vccrypt_suite_digital_signature_init(suite, &sign);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval =
+        vccrypt_suite_buffer_init_for_signature_private_key(suite, privkey);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_sign;
+    }
+
+    retval =
+        vccrypt_suite_buffer_init_for_signature_public_key(suite, pubkey);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_privkey;
+    }
+
+    retval = vccrypt_digital_signature_keypair_create(&sign, privkey, pubkey);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_pubkey;
+    }
+
+    /* success. */
+    retval = VCCRYPT_STATUS_SUCCESS;
+    goto cleanup_sign;
+
+cleanup_pubkey:
+    dispose(vccrypt_buffer_disposable_handle(pubkey));
+
+cleanup_privkey:
+    dispose(vccrypt_buffer_disposable_handle(privkey));
+
+cleanup_sign:
+    dispose((disposable_t*)&sign);
+
+    return retval;
+}
+
+/**
+ * Two root blocks created with the same block id, timestamp, and key are
+ * byte-identical, and their signature verifies.
+ */
+TEST(deterministic)
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccert_builder_options_t builder_opts;
+    commandline_opts opts;
+    vccrypt_buffer_t privkey;
+    vccrypt_buffer_t pubkey;
+    vccrypt_buffer_t first;
+    vccrypt_buffer_t second;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCCERT_STATUS_SUCCESS ==
+            vccert_builder_options_init(&builder_opts, &alloc_opts, &suite));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            signing_keypair_create(&suite, &privkey, &pubkey));
+
+    /* only the suite and builder options are used. */
+    memset(&opts, 0, sizeof(opts));
+    opts.suite = &suite;
+    opts.builder_opts = &builder_opts;
+
+    /* create the same root block twice. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            root_block_certificate_create(
+                &opts, &first, BLOCK_ID, TEST_VALID_FROM, SIGNER_ID,
+                &privkey));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            root_block_certificate_create(
+                &opts, &second, BLOCK_ID, TEST_VALID_FROM, SIGNER_ID,
+                &privkey));
+
+    /* the two root blocks are byte-identical. */
+    TEST_ASSERT(first.size == second.size);
+    TEST_EXPECT(!memcmp(first.data, second.data, first.size));
+
+    /* the signature verifies with the signer's public key. */
+    TEST_EXPECT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_verify_signature(
+                &suite, first.data, first.size, &pubkey));
+
+    /* a corrupted root block does not verify. */
+    ((uint8_t*)second.data)[second.size / 2] ^= 0x01;
+    TEST_EXPECT(
+        VCTOOL_STATUS_SUCCESS !=
+            certificate_verify_signature(
+                &suite, second.data, second.size, &pubkey));
+
+    /* clean up. */
+    dispose(vccrypt_buffer_disposable_handle(&second));
+    dispose(vccrypt_buffer_disposable_handle(&first));
+    dispose(vccrypt_buffer_disposable_handle(&pubkey));
+    dispose(vccrypt_buffer_disposable_handle(&privkey));
+    dispose((disposable_t*)&builder_opts);
+    dispose((disposable_t*)&suite);
+    dispose((disposable_t*)&alloc_opts);
+}
+
+/**
+ * A different timestamp gives a different root block.
+ */
+TEST(timestamp_changes_output)
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccert_builder_options_t builder_opts;
+    commandline_opts opts;
+    vccrypt_buffer_t privkey;
+    vccrypt_buffer_t pubkey;
+    vccrypt_buffer_t first;
+    vccrypt_buffer_t second;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCCERT_STATUS_SUCCESS ==
+            vccert_builder_options_init(&builder_opts, &alloc_opts, &suite));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            signing_keypair_create(&suite, &privkey, &pubkey));
+
+    /* only the suite and builder options are used. */
+    memset(&opts, 0, sizeof(opts));
+    opts.suite = &suite;
+    opts.builder_opts = &builder_opts;
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            root_block_certificate_create(
+                &opts, &first, BLOCK_ID, TEST_VALID_FROM, SIGNER_ID,
+                &privkey));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            root_block_certificate_create(
+                &opts, &second, BLOCK_ID, TEST_VALID_FROM + 1, SIGNER_ID,
+                &privkey));
+
+    /* the sizes match, but the contents don't. */
+    TEST_ASSERT(first.size == second.size);
+    TEST_EXPECT(0 != memcmp(first.data, second.data, first.size));
+
+    /* both verify. */
+    TEST_EXPECT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_verify_signature(
+                &suite, first.data, first.size, &pubkey));
+    TEST_EXPECT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_verify_signature(
+                &suite, second.data, second.size, &pubkey));
+
+    /* clean up. */
+    dispose(vccrypt_buffer_disposable_handle(&second));
+    dispose(vccrypt_buffer_disposable_handle(&first));
+    dispose(vccrypt_buffer_disposable_handle(&pubkey));
+    dispose(vccrypt_buffer_disposable_handle(&privkey));
+    dispose((disposable_t*)&builder_opts);
+    dispose((disposable_t*)&suite);
+    dispose((disposable_t*)&alloc_opts);
+}
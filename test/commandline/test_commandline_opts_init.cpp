@@ -1571,6 +1571,200 @@ TEST(D_argument_missing_key)
     dispose((disposable_t*)&alloc_opts);
 }
 
+/* If a -F is passed as an argument, the output format is set. */
+TEST(F_argument)
+{
+    allocator_options_t alloc_opts;
+    rcpr_allocator* alloc;
+    vccrypt_suite_options_t suite;
+    file f;
+    vccert_builder_options_t builder_opts;
+    string exe_name = "vctool";
+    string format_argument = "-F";
+    string format = "jsonl";
+    string help_argument = "help";
+    char* argv[] = {
+        (char*)exe_name.c_str(), (char*)format_argument.c_str(),
+        (char*)format.c_str(), (char*)help_argument.c_str() };
+    int argc = sizeof(argv) / sizeof(char*);
+    commandline_opts opts;
+
+    /* register the mock crypto suite. */
+    vccrypt_suite_register_mock();
+
+    /* create malloc allocator. */
+    malloc_allocator_options_init(&alloc_opts);
+
+    /* create RCPR allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the mock file. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_mock_init(
+                &f,
+                /* stat. */
+                [&](file*, const char*, file_stat_st*) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* open. */
+                [&](file*, int*, const char*, int, mode_t) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* close. */
+                [&](file*, int) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* read. */
+                [&](file*, int, void*, size_t, size_t*) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* write. */
+                [&](
+                    file*, int, const void*, size_t, size_t*) -> int {
+                        return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* lseek. */
+                [&](file*, int, off_t, file_lseek_whence, off_t*) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                [&](file*, int) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                }));
+
+    /* create a mock crypto suite. */
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+        vccrypt_mock_suite_options_init(
+            &suite, &alloc_opts));
+
+    /* create a builder options instance. */
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccert_builder_options_init(
+                &builder_opts, &alloc_opts, &suite));
+
+    /* calling commandline_opts_init should succeed. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            commandline_opts_init(
+                &opts, alloc, &f, &suite, &builder_opts, argc, argv));
+
+    /* the help command is set. */
+    TEST_ASSERT(NULL != opts.cmd);
+
+    /* get the root command. */
+    command* cmd = opts.cmd;
+    while (cmd->next != NULL) cmd = cmd->next;
+    root_command* root = (root_command*)cmd;
+
+    /* the root command output format is set. */
+    TEST_ASSERT(NULL != root->output_format);
+    TEST_EXPECT(format == root->output_format);
+
+    /* clean up. */
+    dispose((disposable_t*)&opts);
+    dispose((disposable_t*)&builder_opts);
+    dispose((disposable_t*)&suite);
+    dispose((disposable_t*)&f);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+    dispose((disposable_t*)&alloc_opts);
+}
+
+/* Passing the -F argument multiple times causes a failure. */
+TEST(F_argument_multiple)
+{
+    allocator_options_t alloc_opts;
+    rcpr_allocator* alloc;
+    vccrypt_suite_options_t suite;
+    file f;
+    vccert_builder_options_t builder_opts;
+    string exe_name = "vctool";
+    string format_argument = "-F";
+    string format = "jsonl";
+    string format_argument2 = "-F";
+    string format2 = "csv";
+    string help_argument = "help";
+    char* argv[] = {
+        (char*)exe_name.c_str(), (char*)format_argument.c_str(),
+        (char*)format.c_str(), (char*)format_argument2.c_str(),
+        (char*)format2.c_str(), (char*)help_argument.c_str() };
+    int argc = sizeof(argv) / sizeof(char*);
+    commandline_opts opts;
+
+    /* register the mock crypto suite. */
+    vccrypt_suite_register_mock();
+
+    /* create malloc allocator. */
+    malloc_allocator_options_init(&alloc_opts);
+
+    /* create RCPR allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the mock file. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_mock_init(
+                &f,
+                /* stat. */
+                [&](file*, const char*, file_stat_st*) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* open. */
+                [&](file*, int*, const char*, int, mode_t) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* close. */
+                [&](file*, int) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* read. */
+                [&](file*, int, void*, size_t, size_t*) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* write. */
+                [&](
+                    file*, int, const void*, size_t, size_t*) -> int {
+                        return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* lseek. */
+                [&](file*, int, off_t, file_lseek_whence, off_t*) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                [&](file*, int) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                }));
+
+    /* create a mock crypto suite. */
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+        vccrypt_mock_suite_options_init(
+            &suite, &alloc_opts));
+
+    /* create a builder options instance. */
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccert_builder_options_init(
+                &builder_opts, &alloc_opts, &suite));
+
+    /* calling commandline_opts_init should fail. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS !=
+            commandline_opts_init(
+                &opts, alloc, &f, &suite, &builder_opts, argc, argv));
+
+    /* clean up. */
+    dispose((disposable_t*)&builder_opts);
+    dispose((disposable_t*)&suite);
+    dispose((disposable_t*)&f);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+    dispose((disposable_t*)&alloc_opts);
+}
+
 /* If a -i is passed as an argument, the input filename flag is set. */
 TEST(i_argument)
 {
@@ -1853,8 +2047,8 @@ TEST(E_argument)
     root_command* root = (root_command*)cmd;
 
     /* the root command endorse config filename is set. */
-    TEST_ASSERT(NULL != root->endorse_config_filename);
-    TEST_EXPECT(endorse_filename == root->endorse_config_filename);
+    TEST_ASSERT(1U == root->endorse_config_filename_count);
+    TEST_EXPECT(endorse_filename == root->endorse_config_filenames[0]);
 
     /* clean up. */
     dispose((disposable_t*)&opts);
@@ -1867,7 +2061,7 @@ TEST(E_argument)
     dispose((disposable_t*)&alloc_opts);
 }
 
-/* Passing the -E argument multiple times causes a failure. */
+/* Passing the -E argument multiple times adds each endorse config file. */
 TEST(E_argument_multiple)
 {
     allocator_options_t alloc_opts;
@@ -1943,13 +2137,24 @@ TEST(E_argument_multiple)
             vccert_builder_options_init(
                 &builder_opts, &alloc_opts, &suite));
 
-    /* calling commandline_opts_init should fail. */
+    /* calling commandline_opts_init should succeed. */
     TEST_ASSERT(
-        VCTOOL_STATUS_SUCCESS !=
+        VCTOOL_STATUS_SUCCESS ==
             commandline_opts_init(
                 &opts, alloc, &f, &suite, &builder_opts, argc, argv));
 
+    /* get the root command. */
+    command* cmd = opts.cmd;
+    while (cmd->next != NULL) cmd = cmd->next;
+    root_command* root = (root_command*)cmd;
+
+    /* both endorse config filenames are set, in order. */
+    TEST_ASSERT(2U == root->endorse_config_filename_count);
+    TEST_EXPECT(endorse_filename == root->endorse_config_filenames[0]);
+    TEST_EXPECT(endorse_filename2 == root->endorse_config_filenames[1]);
+
     /* clean up. */
+    dispose((disposable_t*)&opts);
     dispose((disposable_t*)&builder_opts);
     dispose((disposable_t*)&suite);
     dispose((disposable_t*)&f);
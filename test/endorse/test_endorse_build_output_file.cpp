@@ -0,0 +1,368 @@
+/**
+ * \file test/endorse/test_endorse_build_output_file.cpp
+ *
+ * \brief Unit tests for endorse_build_output_file.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <fcntl.h>
+#include <minunit/minunit.h>
+#include <string.h>
+#include <string>
+#include <vccert/builder.h>
+#include <vccert/fields.h>
+#include <vccrypt/suite.h>
+#include <vector>
+#include <vpr/allocator/malloc_allocator.h>
+
+#include "../../src/command/endorse/endorse_internal.h"
+#include "../file/mock_file.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+RCPR_IMPORT_uuid;
+
+/* start of the endorse_build_output_file test suite. */
+TEST_SUITE(endorse_build_output_file);
+
+static const uint8_t PUB_ID[16] = {
+    0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+    0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f, 0x40 };
+
+static const uint8_t PUB_KEY[32] = {
+    0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+    0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x50,
+    0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58,
+    0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f, 0x60 };
+
+/** \brief The descriptor returned by the mock open. */
+#define TEST_DESC 17
+
+/**
+ * Add the fields of the public input certificate to a builder.
+ */
+static int add_public_fields(vccert_builder_context_t* builder)
+{
+    int retval;
+
+    retval =
+        vccert_builder_add_short_uint32(
+            builder, VCCERT_FIELD_TYPE_CERTIFICATE_VERSION, 0x00010000UL);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval =
+        vccert_builder_add_short_UUID(
+            builder, VCCERT_FIELD_TYPE_ARTIFACT_ID, PUB_ID);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    return
+        vccert_builder_add_short_buffer(
+            builder, VCCERT_FIELD_TYPE_PUBLIC_SIGNING_KEY, PUB_KEY,
+            sizeof(PUB_KEY));
+}
+
+/**
+ * Create the public input certificate.
+ */
+static int input_cert_create(
+    vccrypt_buffer_t* input_cert, vccert_builder_options_t* builder_opts,
+    allocator_options_t* alloc_opts)
+{
+    int retval;
+    vccert_builder_context_t builder;
+    const uint8_t* data;
+    size_t size;
+
+    retval = vccert_builder_init(builder_opts, &builder, 1024);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval = add_public_fields(&builder);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    data = vccert_builder_emit(&builder, &size);
+    retval = vccrypt_buffer_init(input_cert, alloc_opts, size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    memcpy(input_cert->data, data, size);
+
+cleanup_builder:
+    dispose((disposable_t*)&builder);
+
+    return retval;
+}
+
+/**
+ * Build the endorsed certificate the way the endorse command did with
+ * vccert_builder, before it encoded the certificate directly.
+ */
+static int builder_output_create(
+    vector<uint8_t>& output, vccert_builder_options_t* builder_opts,
+    const endorse_working_set* set, const rcpr_uuid* endorser_id,
+    const vccrypt_buffer_t* endorser_private_key)
+{
+    int retval;
+    vccert_builder_context_t builder;
+    uint8_t endorsement_data[3 * 16];
+    const uint8_t* data;
+    size_t size;
+
+    retval = vccert_builder_init(builder_opts, &builder, 4096);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* the public certificate fields come first. */
+    retval = add_public_fields(&builder);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    /* each endorsement is the subject, the verb, and the object. */
+    for (size_t i = 0; i < set->count; ++i)
+    {
+        memcpy(endorsement_data, PUB_ID, 16);
+        memcpy(endorsement_data + 16, &set->keys[i].verb, 16);
+        memcpy(endorsement_data + 32, &set->keys[i].object, 16);
+
+        retval =
+            vccert_builder_add_short_buffer(
+                &builder, VCCERT_FIELD_TYPE_VELO_ENDORSEMENT, endorsement_data,
+                sizeof(endorsement_data));
+        if (VCCERT_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_builder;
+        }
+    }
+
+    /* sign the certificate. */
+    retval =
+        vccert_builder_sign(
+            &builder, endorser_id->data, endorser_private_key);
+    if (VCCERT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_builder;
+    }
+
+    data = vccert_builder_emit(&builder, &size);
+    output.assign(data, data + size);
+
+cleanup_builder:
+    dispose((disposable_t*)&builder);
+
+    return retval;
+}
+
+/**
+ * Create a signing keypair with the given suite.
+ */
+static int signing_keypair_create(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* privkey,
+    vccrypt_buffer_t* pubkey)
+{
+    int retval;
+    vccrypt_digital_signature_context_t sign;
+
+    retval = vccrypt_suite_digital_signature_init(suite, &sign);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval =
+        vccrypt_suite_buffer_init_for_signature_private_key(suite, privkey);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_sign;
+    }
+
+    retval =
+        vccrypt_suite_buffer_init_for_signature_public_key(suite, pubkey);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_privkey;
+    }
+
+    retval = vccrypt_digital_signature_keypair_create(&sign, privkey, pubkey);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_pubkey;
+    }
+
+    /* success. */
+    retval = VCCRYPT_STATUS_SUCCESS;
+    goto cleanup_sign;
+
+cleanup_pubkey:
+    dispose(vccrypt_buffer_disposable_handle(pubkey));
+
+cleanup_privkey:
+    dispose(vccrypt_buffer_disposable_handle(privkey));
+
+cleanup_sign:
+    dispose((disposable_t*)&sign);
+
+    return retval;
+}
+
+/**
+ * The directly encoded certificate matches the vccert_builder certificate
+ * byte for byte, and its signature verifies.
+ */
+TEST(matches_builder_output)
+{
+    allocator_options_t alloc_opts;
+    rcpr_allocator* alloc;
+    vccrypt_suite_options_t suite;
+    vccert_builder_options_t builder_opts;
+    commandline_opts opts;
+    file f;
+    vccrypt_buffer_t privkey;
+    vccrypt_buffer_t pubkey;
+    vccrypt_buffer_t input_cert;
+    endorse_working_set* set;
+    rcpr_uuid endorser_id;
+    rcpr_uuid object;
+    rcpr_uuid verb;
+    vector<uint8_t> contents;
+    vector<uint8_t> expected;
+    string opened_name;
+    int opened_flags = 0;
+    bool closed = false;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCCERT_STATUS_SUCCESS ==
+            vccert_builder_options_init(&builder_opts, &alloc_opts, &suite));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            signing_keypair_create(&suite, &privkey, &pubkey));
+    TEST_ASSERT(
+        VCCERT_STATUS_SUCCESS ==
+            input_cert_create(&input_cert, &builder_opts, &alloc_opts));
+
+    /* the output file is kept in memory. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_mock_init(
+                &f,
+                /* stat. */
+                [&](file*, const char*, file_stat_st*) -> int {
+                    return VCTOOL_ERROR_FILE_NO_ENTRY;
+                },
+                /* open. */
+                [&](file*, int* d, const char* name, int flags, mode_t) -> int {
+                    opened_name = name;
+                    opened_flags = flags;
+                    *d = TEST_DESC;
+                    return VCTOOL_STATUS_SUCCESS;
+                },
+                /* close. */
+                [&](file*, int d) -> int {
+                    closed = (TEST_DESC == d);
+                    return VCTOOL_STATUS_SUCCESS;
+                },
+                /* read. */
+                [&](file*, int, void*, size_t, size_t*) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* write. */
+                [&](
+                    file*, int, const void* buf, size_t size,
+                    size_t* written) -> int {
+                        const uint8_t* bbuf = (const uint8_t*)buf;
+                        contents.insert(contents.end(), bbuf, bbuf + size);
+                        *written = size;
+
+                        return VCTOOL_STATUS_SUCCESS;
+                },
+                /* lseek. */
+                [&](file*, int, off_t, file_lseek_whence, off_t*) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* fsync. */
+                [&](file*, int) -> int {
+                    return VCTOOL_STATUS_SUCCESS;
+                }));
+
+    /* only the file, suite, and builder options are used. */
+    memset(&opts, 0, sizeof(opts));
+    opts.file = &f;
+    opts.suite = &suite;
+    opts.builder_opts = &builder_opts;
+
+    /* build a sorted working set with a few capabilities. */
+    memset(&endorser_id, 0x77, sizeof(endorser_id));
+    TEST_ASSERT(STATUS_SUCCESS == endorse_working_set_create(&set, alloc));
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        memset(&object, 0x10 + i, sizeof(object));
+        memset(&verb, 0x20 + i, sizeof(verb));
+        TEST_ASSERT(
+            STATUS_SUCCESS ==
+                endorse_working_set_add_verb_capability(set, &object, &verb));
+    }
+    TEST_ASSERT(STATUS_SUCCESS == endorse_working_set_finalize(set));
+
+    /* build the output file. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_build_output_file(
+                "endorsed.cert", &opts, &endorser_id, &privkey, set,
+                &input_cert));
+    TEST_EXPECT("endorsed.cert" == opened_name);
+    TEST_EXPECT(O_EXCL == (opened_flags & O_EXCL));
+    TEST_EXPECT(closed);
+
+    /* it matches the vccert_builder certificate. */
+    TEST_ASSERT(
+        VCCERT_STATUS_SUCCESS ==
+            builder_output_create(
+                expected, &builder_opts, set, &endorser_id, &privkey));
+    TEST_ASSERT(expected.size() == contents.size());
+    TEST_EXPECT(!memcmp(expected.data(), contents.data(), contents.size()));
+
+    /* the signature verifies with the endorser's public key. */
+    TEST_EXPECT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_verify_signature(
+                &suite, contents.data(), contents.size(), &pubkey));
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&set->hdr));
+    dispose(vccrypt_buffer_disposable_handle(&input_cert));
+    dispose(vccrypt_buffer_disposable_handle(&pubkey));
+    dispose(vccrypt_buffer_disposable_handle(&privkey));
+    dispose((disposable_t*)&f);
+    dispose((disposable_t*)&builder_opts);
+    dispose((disposable_t*)&suite);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+    dispose((disposable_t*)&alloc_opts);
+}
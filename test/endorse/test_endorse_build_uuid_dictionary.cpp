@@ -0,0 +1,193 @@
+/**
+ * \file test/endorse/test_endorse_build_uuid_dictionary.cpp
+ *
+ * \brief Unit tests for endorse_build_uuid_dictionary.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <map>
+#include <minunit/minunit.h>
+#include <mutex>
+#include <string.h>
+#include <string>
+#include <vccert/fields.h>
+#include <vccrypt/suite.h>
+#include <vector>
+#include <vpr/allocator/malloc_allocator.h>
+
+#include "../../src/command/endorse/endorse_internal.h"
+#include "../file/mock_file.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+RCPR_IMPORT_uuid;
+
+/* start of the endorse_build_uuid_dictionary test suite. */
+TEST_SUITE(endorse_build_uuid_dictionary);
+
+/**
+ * Make a pubkey certificate holding only the given artifact id.
+ */
+static vector<uint8_t> pubkey_cert(uint8_t value)
+{
+    vector<uint8_t> cert;
+
+    cert.push_back((uint8_t)(VCCERT_FIELD_TYPE_ARTIFACT_ID >> 8));
+    cert.push_back((uint8_t)(VCCERT_FIELD_TYPE_ARTIFACT_ID & 0xFF));
+    cert.push_back(0x00);
+    cert.push_back((uint8_t)sizeof(rcpr_uuid));
+    cert.insert(cert.end(), sizeof(rcpr_uuid), value);
+
+    return cert;
+}
+
+/**
+ * Test that keys which share a pubkey file all resolve, and that the shared
+ * file is only read once.
+ */
+TEST(shared_pubkey_file)
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    rcpr_allocator* alloc;
+    root_command root;
+    commandline_opts opts;
+    file f;
+    endorse_uuid_dictionary* dict;
+    const rcpr_uuid* id;
+    mutex lock;
+    map<string, vector<uint8_t>> files;
+    map<string, int> open_count;
+    map<int, string> descriptors;
+    int next_desc = 10;
+
+    files["shared.pub"] = pubkey_cert(0x11);
+    files["other.pub"] = pubkey_cert(0x22);
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+
+    /* the pubkey files are kept in memory; files are read concurrently. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_mock_init(
+                &f,
+                /* stat. */
+                [&](file*, const char* name, file_stat_st* fst) -> int {
+                    lock_guard<mutex> guard(lock);
+                    auto it = files.find(name);
+                    if (files.end() == it)
+                    {
+                        return VCTOOL_ERROR_FILE_NO_ENTRY;
+                    }
+
+                    memset(fst, 0, sizeof(*fst));
+                    fst->fst_size = it->second.size();
+                    return VCTOOL_STATUS_SUCCESS;
+                },
+                /* open. */
+                [&](file*, int* d, const char* name, int, mode_t) -> int {
+                    lock_guard<mutex> guard(lock);
+                    if (files.end() == files.find(name))
+                    {
+                        return VCTOOL_ERROR_FILE_NO_ENTRY;
+                    }
+
+                    ++open_count[name];
+                    *d = next_desc++;
+                    descriptors[*d] = name;
+                    return VCTOOL_STATUS_SUCCESS;
+                },
+                /* close. */
+                [&](file*, int d) -> int {
+                    lock_guard<mutex> guard(lock);
+                    descriptors.erase(d);
+                    return VCTOOL_STATUS_SUCCESS;
+                },
+                /* read. */
+                [&](file*, int d, void* buf, size_t max, size_t* size) -> int {
+                    lock_guard<mutex> guard(lock);
+                    auto it = descriptors.find(d);
+                    if (descriptors.end() == it)
+                    {
+                        return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                    }
+
+                    const vector<uint8_t>& contents = files[it->second];
+                    *size = (max < contents.size()) ? max : contents.size();
+                    memcpy(buf, contents.data(), *size);
+                    return VCTOOL_STATUS_SUCCESS;
+                },
+                /* write. */
+                [&](file*, int, const void*, size_t, size_t*) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* lseek. */
+                [&](file*, int, off_t, file_lseek_whence, off_t*) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* fsync. */
+                [&](file*, int) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                }));
+
+    /* three keys share one pubkey file, and one key has its own. */
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_command_init(&root, alloc));
+    const char* kvps[] = {
+        "alice=shared.pub", "bob=shared.pub", "carol=shared.pub",
+        "dave=other.pub" };
+    for (const char* kvp : kvps)
+    {
+        TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_dict_add(&root, kvp));
+    }
+
+    /* only the file and suite are used from the options. */
+    memset(&opts, 0, sizeof(opts));
+    opts.file = &f;
+    opts.suite = &suite;
+
+    /* build the dictionary. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_build_uuid_dictionary(&dict, alloc, &opts, &root));
+
+    /* each pubkey file was opened once, and every file was closed. */
+    TEST_EXPECT(2U == open_count.size());
+    TEST_EXPECT(1 == open_count["shared.pub"]);
+    TEST_EXPECT(1 == open_count["other.pub"]);
+    TEST_EXPECT(descriptors.empty());
+
+    /* every key resolves to the id in its pubkey file. */
+    const char* shared_keys[] = { "alice", "bob", "carol" };
+    for (const char* key : shared_keys)
+    {
+        id = endorse_uuid_dictionary_find(dict, key);
+        TEST_ASSERT(nullptr != id);
+        TEST_EXPECT(!memcmp(id, files["shared.pub"].data() + 4, sizeof(*id)));
+    }
+
+    id = endorse_uuid_dictionary_find(dict, "dave");
+    TEST_ASSERT(nullptr != id);
+    TEST_EXPECT(!memcmp(id, files["other.pub"].data() + 4, sizeof(*id)));
+
+    /* a key that was not given does not resolve. */
+    TEST_EXPECT(nullptr == endorse_uuid_dictionary_find(dict, "eve"));
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&dict->hdr));
+    dispose((disposable_t*)&root);
+    dispose((disposable_t*)&f);
+    dispose((disposable_t*)&suite);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+    dispose((disposable_t*)&alloc_opts);
+}
@@ -0,0 +1,381 @@
+/**
+ * \file test/endorse/test_endorse_check.cpp
+ *
+ * \brief Unit tests for the endorse-check command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <fcntl.h>
+#include <map>
+#include <minunit/minunit.h>
+#include <mutex>
+#include <string.h>
+#include <string>
+#include <vctool/command/endorse_check.h>
+#include <vctool/command/root.h>
+#include <vctool/status_codes.h>
+
+#include "../file/mock_file.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/* start of the endorse_check test suite. */
+TEST_SUITE(endorse_check);
+
+/**
+ * \brief The result of running endorse-check against in-memory files.
+ */
+struct check_result
+{
+    int status;
+    int write_count;
+    bool descriptors_closed;
+};
+
+/**
+ * Run endorse-check on the given in-memory config files, counting every
+ * attempt to write to the file system.
+ */
+static check_result run_check(const map<string, string>& files)
+{
+    check_result result = { -1, 0, false };
+    rcpr_allocator* alloc;
+    root_command root;
+    endorse_check_command check;
+    commandline_opts opts;
+    file f;
+    mutex lock;
+    map<int, pair<string, off_t>> descriptors;
+    int next_desc = 10;
+
+    if (STATUS_SUCCESS != rcpr_malloc_allocator_create(&alloc))
+    {
+        return result;
+    }
+
+    /* the config files are kept in memory; anything that writes is counted. */
+    if (VCTOOL_STATUS_SUCCESS !=
+            file_mock_init(
+                &f,
+                /* stat. */
+                [&](file*, const char* name, file_stat_st* fst) -> int {
+                    lock_guard<mutex> guard(lock);
+                    auto it = files.find(name);
+                    if (files.end() == it)
+                    {
+                        return VCTOOL_ERROR_FILE_NO_ENTRY;
+                    }
+
+                    memset(fst, 0, sizeof(*fst));
+                    fst->fst_size = it->second.size();
+                    return VCTOOL_STATUS_SUCCESS;
+                },
+                /* open. */
+                [&](file*, int* d, const char* name, int flags, mode_t) -> int {
+                    lock_guard<mutex> guard(lock);
+                    if (O_RDONLY != (flags & O_ACCMODE))
+                    {
+                        ++result.write_count;
+                        return VCTOOL_ERROR_FILE_ACCESS;
+                    }
+
+                    if (files.end() == files.find(name))
+                    {
+                        return VCTOOL_ERROR_FILE_NO_ENTRY;
+                    }
+
+                    *d = next_desc++;
+                    descriptors[*d] = make_pair(string(name), (off_t)0);
+                    return VCTOOL_STATUS_SUCCESS;
+                },
+                /* close. */
+                [&](file*, int d) -> int {
+                    lock_guard<mutex> guard(lock);
+                    return
+                        (1U == descriptors.erase(d))
+                            ? VCTOOL_STATUS_SUCCESS
+                            : VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* read. */
+                [&](file*, int d, void* buf, size_t max, size_t* size) -> int {
+                    lock_guard<mutex> guard(lock);
+                    auto it = descriptors.find(d);
+                    if (descriptors.end() == it)
+                    {
+                        return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                    }
+
+                    const string& contents = files.at(it->second.first);
+                    size_t offset = (size_t)it->second.second;
+                    size_t left = contents.size() - offset;
+                    *size = (max < left) ? max : left;
+                    memcpy(buf, contents.data() + offset, *size);
+                    it->second.second += *size;
+                    return VCTOOL_STATUS_SUCCESS;
+                },
+                /* write. */
+                [&](file*, int, const void*, size_t, size_t*) -> int {
+                    lock_guard<mutex> guard(lock);
+                    ++result.write_count;
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* lseek. */
+                [&](file*, int d, off_t offset, file_lseek_whence whence,
+                    off_t* newoffset) -> int {
+                    lock_guard<mutex> guard(lock);
+                    auto it = descriptors.find(d);
+                    if (descriptors.end() == it
+                     || FILE_LSEEK_WHENCE_ABSOLUTE != whence)
+                    {
+                        return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                    }
+
+                    it->second.second = offset;
+                    *newoffset = offset;
+                    return VCTOOL_STATUS_SUCCESS;
+                },
+                /* fsync. */
+                [&](file*, int) -> int {
+                    lock_guard<mutex> guard(lock);
+                    ++result.write_count;
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* ftruncate. */
+                [&](file*, int, off_t) -> int {
+                    lock_guard<mutex> guard(lock);
+                    ++result.write_count;
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* mkdir. */
+                [&](file*, const char*, mode_t) -> int {
+                    lock_guard<mutex> guard(lock);
+                    ++result.write_count;
+                    return VCTOOL_ERROR_FILE_ACCESS;
+                },
+                /* rename. */
+                [&](file*, const char*, const char*) -> int {
+                    lock_guard<mutex> guard(lock);
+                    ++result.write_count;
+                    return VCTOOL_ERROR_FILE_ACCESS;
+                },
+                /* unlink. */
+                [&](file*, const char*) -> int {
+                    lock_guard<mutex> guard(lock);
+                    ++result.write_count;
+                    return VCTOOL_ERROR_FILE_ACCESS;
+                }))
+    {
+        goto cleanup_allocator;
+    }
+
+    /* check every config file given with -E. */
+    if (VCTOOL_STATUS_SUCCESS != root_command_init(&root, alloc))
+    {
+        goto cleanup_file;
+    }
+
+    for (const auto& entry : files)
+    {
+        if (VCTOOL_STATUS_SUCCESS !=
+                root_endorse_config_add(&root, entry.first.c_str()))
+        {
+            goto cleanup_root;
+        }
+    }
+
+    if (VCTOOL_STATUS_SUCCESS != endorse_check_command_init(&check))
+    {
+        goto cleanup_root;
+    }
+
+    /* only the file interface and command are used from the options. */
+    memset(&opts, 0, sizeof(opts));
+    opts.file = &f;
+    opts.cmd = &check.hdr;
+    check.hdr.next = &root.hdr;
+
+    result.status = endorse_check_command_func(&opts);
+    result.descriptors_closed = descriptors.empty();
+
+    dispose((disposable_t*)&check);
+
+cleanup_root:
+    dispose((disposable_t*)&root);
+
+cleanup_file:
+    dispose((disposable_t*)&f);
+
+cleanup_allocator:
+    resource_release(rcpr_allocator_resource_handle(alloc));
+
+    return result;
+}
+
+/** \brief A config that parses and passes analysis. */
+static const char VALID_CONFIG[] =
+    "entities { agentd, authd }\n"
+    "verbs for agentd {\n"
+    "    block_read 01234567-89ab-cdef-0123-456789abcdef\n"
+    "    block_write 11234567-89ab-cdef-0123-456789abcdef\n"
+    "}\n"
+    "roles for agentd {\n"
+    "    reader { block_read }\n"
+    "    writer extends reader { block_write }\n"
+    "}\n";
+
+/**
+ * Test that a valid config passes, and that nothing is written.
+ */
+TEST(valid_config)
+{
+    map<string, string> files;
+
+    files["agentd.cfg"] = VALID_CONFIG;
+
+    check_result result = run_check(files);
+
+    TEST_EXPECT(VCTOOL_STATUS_SUCCESS == result.status);
+    TEST_EXPECT(0 == result.write_count);
+    TEST_EXPECT(result.descriptors_closed);
+}
+
+/**
+ * Test that a config which fails analysis is reported, and that nothing is
+ * written.
+ */
+TEST(invalid_config)
+{
+    map<string, string> files;
+
+    /* the role grants a verb that was never declared. */
+    files["agentd.cfg"] =
+        "entities { agentd }\n"
+        "verbs for agentd {\n"
+        "    block_read 01234567-89ab-cdef-0123-456789abcdef\n"
+        "}\n"
+        "roles for agentd { reader { block_write } }\n";
+
+    check_result result = run_check(files);
+
+    TEST_EXPECT(VCTOOL_ERROR_ENDORSE_INVALID_CONFIG == result.status);
+    TEST_EXPECT(0 == result.write_count);
+    TEST_EXPECT(result.descriptors_closed);
+}
+
+/**
+ * Test that a config with a syntax error is reported, and that nothing is
+ * written.
+ */
+TEST(syntax_error)
+{
+    map<string, string> files;
+
+    files["agentd.cfg"] = "entities { agentd ";
+
+    check_result result = run_check(files);
+
+    TEST_EXPECT(VCTOOL_ERROR_ENDORSE_INVALID_CONFIG == result.status);
+    TEST_EXPECT(0 == result.write_count);
+    TEST_EXPECT(result.descriptors_closed);
+}
+
+/**
+ * Test that each config is checked on its own, so that one invalid config
+ * fails the command even if the others are valid.
+ */
+TEST(one_invalid_config)
+{
+    map<string, string> files;
+
+    files["a.cfg"] = VALID_CONFIG;
+    files["b.cfg"] = "roles for nobody { reader { block_read } }\n";
+    files["c.cfg"] = VALID_CONFIG;
+
+    check_result result = run_check(files);
+
+    TEST_EXPECT(VCTOOL_ERROR_ENDORSE_INVALID_CONFIG == result.status);
+    TEST_EXPECT(0 == result.write_count);
+    TEST_EXPECT(result.descriptors_closed);
+}
+
+/**
+ * Test that a missing config file is an error, and that nothing is written.
+ */
+TEST(missing_config)
+{
+    rcpr_allocator* alloc;
+    root_command root;
+    endorse_check_command check;
+    commandline_opts opts;
+    file f;
+    int write_count = 0;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* there are no files, and nothing may be written. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_mock_init(
+                &f,
+                /* stat. */
+                [&](file*, const char*, file_stat_st*) -> int {
+                    return VCTOOL_ERROR_FILE_NO_ENTRY;
+                },
+                /* open. */
+                [&](file*, int*, const char*, int flags, mode_t) -> int {
+                    if (O_RDONLY != (flags & O_ACCMODE))
+                    {
+                        ++write_count;
+                    }
+
+                    return VCTOOL_ERROR_FILE_NO_ENTRY;
+                },
+                /* close. */
+                [&](file*, int) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* read. */
+                [&](file*, int, void*, size_t, size_t*) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* write. */
+                [&](file*, int, const void*, size_t, size_t*) -> int {
+                    ++write_count;
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* lseek. */
+                [&](file*, int, off_t, file_lseek_whence, off_t*) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* fsync. */
+                [&](file*, int) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                }));
+
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_command_init(&root, alloc));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS == root_endorse_config_add(&root, "none.cfg"));
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == endorse_check_command_init(&check));
+
+    memset(&opts, 0, sizeof(opts));
+    opts.file = &f;
+    opts.cmd = &check.hdr;
+    check.hdr.next = &root.hdr;
+
+    /* the missing file is reported as such. */
+    TEST_EXPECT(
+        VCTOOL_ERROR_FILE_NO_ENTRY == endorse_check_command_func(&opts));
+    TEST_EXPECT(0 == write_count);
+
+    /* clean up. */
+    dispose((disposable_t*)&check);
+    dispose((disposable_t*)&root);
+    dispose((disposable_t*)&f);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,580 @@
+/**
+ * \file test/endorse/test_endorse_compiled.cpp
+ *
+ * \brief Unit tests for the compiled endorse config.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <minunit/minunit.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vctool/endorse.h>
+#include <vctool/status_codes.h>
+#include <vector>
+#include <vpr/allocator/malloc_allocator.h>
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+RCPR_IMPORT_uuid;
+
+/* start of the endorse_compiled test suite. */
+TEST_SUITE(endorse_compiled);
+
+static const char ROLE_EXTENDS_INPUT[] =
+    R"MULTI(
+    entities {
+        agentd
+    }
+    verbs for agentd {
+        latest_block_id_get     c5b0eb04-6b24-48be-b7d9-bf9083a4be5d
+        next_block_id_get       6a399f0d-ddb3-45dc-b2e3-0227a962b237
+        prev_block_id_get       73cfae64-80e8-412d-b005-344d537766a6
+        block_get               f382e365-1224-43b4-924a-1de4d9f4cf25
+        transaction_get         7df210d6-f00b-47c4-a608-6f3f1df7511a
+        transaction_submit      ef560d24-eea6-4847-9009-464b127f249b
+        artifact_get            fc0e22ea-1e77-4ea4-a2ae-08be5ff73ccc
+        assert_latest_block_id  447617b4-a847-437c-b62b-5bc6a94206fa
+        sentinel_extend_api     c41b053c-6b4a-40a1-981b-882bdeffe978
+    }
+    roles for agentd {
+        reader {
+            latest_block_id_get
+            block_get
+        }
+        writer extends reader {
+            transaction_submit
+        }
+    })MULTI";
+
+/**
+ * The source digest recorded by these tests.
+ */
+static const uint8_t TEST_DIGEST[ENDORSE_COMPILED_DIGEST_SIZE] = {
+    0x5a, 0x0b, 0x8e, 0x31, 0x27, 0xc4, 0x90, 0x6d,
+    0xe2, 0x13, 0x7f, 0x48, 0xa9, 0x56, 0x0c, 0xd1 };
+
+/**
+ * Parse, analyze, and compile the given input.
+ */
+static status compile_input(
+    endorse_compiled** compiled, rcpr_allocator* alloc,
+    const vccrypt_buffer_t* input)
+{
+    status retval, release_retval;
+    endorse_config_context* ctx;
+
+    /* create a default config context. */
+    retval = endorse_config_create_default(&ctx, alloc);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* parse, analyze, and compile the input. */
+    retval = endorse_parse(ctx, input);
+    if (STATUS_SUCCESS == retval)
+    {
+        endorse_config* root = (endorse_config*)
+            endorse_config_default_context_get_endorse_config_root(ctx);
+
+        retval = endorse_analyze(ctx, root);
+        if (STATUS_SUCCESS == retval)
+        {
+            retval =
+                endorse_compile(compiled, alloc, root, TEST_DIGEST);
+        }
+    }
+
+    /* the compiled config does not depend on the AST. */
+    release_retval = resource_release(&ctx->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
+
+/**
+ * Grant a single role or verb of an entity, and collect the verbs it grants.
+ */
+static status granted_verbs(
+    vector<const endorse_compiled_verb*>& verbs,
+    const endorse_compiled* compiled, const endorse_compiled_entity* entity,
+    const char* moiety)
+{
+    vector<uint64_t> grants(endorse_compiled_entity_word_count(entity), 0);
+
+    status retval =
+        endorse_compiled_grant_moiety(grants.data(), compiled, entity, moiety);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    verbs.clear();
+    for (uint32_t i = 0; i < entity->verb_count; ++i)
+    {
+        if (grants[i / 64] & (UINT64_C(1) << (i % 64)))
+        {
+            verbs.push_back(&compiled->verbs[entity->verb_offset + i]);
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * Compiling a config resolves roles into verb bitsets.
+ */
+TEST(compile_resolves_roles)
+{
+    rcpr_allocator* alloc;
+    allocator_options_t vpr_alloc;
+    vccrypt_buffer_t input;
+    endorse_compiled* compiled;
+    vector<const endorse_compiled_verb*> verbs;
+    rcpr_uuid block_get;
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the VPR malloc allocator. */
+    malloc_allocator_options_init(&vpr_alloc);
+
+    /* create a buffer with our string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            vccrypt_buffer_init(
+                &input, &vpr_alloc, strlen(ROLE_EXTENDS_INPUT) + 1));
+    memset(input.data, 0, input.size);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            vccrypt_buffer_read_data(&input, ROLE_EXTENDS_INPUT, input.size));
+
+    /* compile the config. */
+    TEST_ASSERT(STATUS_SUCCESS == compile_input(&compiled, alloc, &input));
+
+    /* verify the table sizes. */
+    TEST_EXPECT(1U == compiled->header->entity_count);
+    TEST_EXPECT(9U == compiled->header->verb_count);
+    TEST_EXPECT(2U == compiled->header->role_count);
+
+    /* we can find agentd, but not an undefined entity. */
+    const endorse_compiled_entity* agentd =
+        endorse_compiled_find_entity(compiled, "agentd");
+    TEST_ASSERT(nullptr != agentd);
+    TEST_EXPECT(!strcmp("agentd", compiled->strings + agentd->name));
+    TEST_EXPECT(nullptr == endorse_compiled_find_entity(compiled, "foo"));
+
+    /* the reader role grants two verbs. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            granted_verbs(verbs, compiled, agentd, "reader"));
+    TEST_EXPECT(2U == verbs.size());
+
+    /* the writer role grants its verb and those of the reader role. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            granted_verbs(verbs, compiled, agentd, "writer"));
+    TEST_EXPECT(3U == verbs.size());
+
+    /* a verb grants exactly its own UUID. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            rcpr_uuid_parse_string(
+                &block_get, "f382e365-1224-43b4-924a-1de4d9f4cf25"));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            granted_verbs(verbs, compiled, agentd, "block_get"));
+    TEST_ASSERT(1U == verbs.size());
+    TEST_EXPECT(!memcmp(&block_get, &verbs[0]->verb_id, sizeof(block_get)));
+
+    /* an unknown moiety is an error. */
+    TEST_EXPECT(
+        VCTOOL_ERROR_ENDORSE_UNKNOWN_ROLE_OR_VERB ==
+            granted_verbs(verbs, compiled, agentd, "admin"));
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&compiled->hdr));
+    dispose(vccrypt_buffer_disposable_handle(&input));
+    dispose(allocator_options_disposable_handle(&vpr_alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * A compiled config can be written to a cache file and mapped later, but only
+ * for the sources from which it was compiled, and only if no other user could
+ * have written the cache file.
+ */
+TEST(cache_round_trip)
+{
+    rcpr_allocator* alloc;
+    allocator_options_t vpr_alloc;
+    vccrypt_buffer_t input;
+    endorse_compiled* compiled;
+    endorse_compiled* loaded;
+    vector<const endorse_compiled_verb*> verbs;
+    file f;
+    uint8_t other_digest[ENDORSE_COMPILED_DIGEST_SIZE];
+    char filename[] = "/tmp/endorse_compiled_XXXXXX";
+
+    /* create a cache filename. */
+    int fd = mkstemp(filename);
+    TEST_ASSERT(fd >= 0);
+    close(fd);
+
+    /* create the OS file interface. */
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == file_init(&f));
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the VPR malloc allocator. */
+    malloc_allocator_options_init(&vpr_alloc);
+
+    /* create a buffer with our string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            vccrypt_buffer_init(
+                &input, &vpr_alloc, strlen(ROLE_EXTENDS_INPUT) + 1));
+    memset(input.data, 0, input.size);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            vccrypt_buffer_read_data(&input, ROLE_EXTENDS_INPUT, input.size));
+
+    /* compile the config and write the cache. */
+    TEST_ASSERT(STATUS_SUCCESS == compile_input(&compiled, alloc, &input));
+    TEST_ASSERT(
+        STATUS_SUCCESS == endorse_compiled_write(&f, compiled, filename));
+
+    /* the cache can be mapped for the same sources. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_compiled_load(&loaded, alloc, &f, filename, TEST_DIGEST));
+    TEST_EXPECT(loaded->mapped);
+    TEST_EXPECT(compiled->image_size == loaded->image_size);
+    TEST_EXPECT(!memcmp(compiled->image, loaded->image, loaded->image_size));
+
+    /* the mapped config resolves roles. */
+    const endorse_compiled_entity* agentd =
+        endorse_compiled_find_entity(loaded, "agentd");
+    TEST_ASSERT(nullptr != agentd);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            granted_verbs(verbs, loaded, agentd, "writer"));
+    TEST_EXPECT(3U == verbs.size());
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&loaded->hdr));
+
+    /* the cache is stale once the sources change. */
+    memcpy(other_digest, TEST_DIGEST, sizeof(other_digest));
+    other_digest[sizeof(other_digest) - 1] ^= 0x01;
+    TEST_EXPECT(
+        VCTOOL_ERROR_ENDORSE_COMPILED_STALE ==
+            endorse_compiled_load(
+                &loaded, alloc, &f, filename, other_digest));
+
+    /* a cache that other users can write is not trusted. */
+    TEST_ASSERT(0 == chmod(filename, 0664));
+    TEST_EXPECT(
+        VCTOOL_ERROR_ENDORSE_COMPILED_UNTRUSTED ==
+            endorse_compiled_load(&loaded, alloc, &f, filename, TEST_DIGEST));
+    TEST_ASSERT(0 == chmod(filename, 0606));
+    TEST_EXPECT(
+        VCTOOL_ERROR_ENDORSE_COMPILED_UNTRUSTED ==
+            endorse_compiled_load(&loaded, alloc, &f, filename, TEST_DIGEST));
+    TEST_ASSERT(0 == chmod(filename, 0644));
+
+    /* a truncated cache is invalid. */
+    TEST_ASSERT(0 == truncate(filename, compiled->image_size - 1));
+    TEST_EXPECT(
+        VCTOOL_ERROR_ENDORSE_COMPILED_INVALID ==
+            endorse_compiled_load(&loaded, alloc, &f, filename, TEST_DIGEST));
+
+    /* clean up. */
+    unlink(filename);
+    dispose((disposable_t*)&f);
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&compiled->hdr));
+    dispose(vccrypt_buffer_disposable_handle(&input));
+    dispose(allocator_options_disposable_handle(&vpr_alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * A config can be parsed and analyzed in an arena, and the arena frees the
+ * context and AST without releasing them.
+ */
+TEST(compile_in_arena)
+{
+    rcpr_allocator* alloc;
+    rcpr_allocator* arena;
+    allocator_options_t vpr_alloc;
+    vccrypt_buffer_t input;
+    endorse_config_context* ctx;
+    endorse_compiled* compiled;
+    vector<const endorse_compiled_verb*> verbs;
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the VPR malloc allocator. */
+    malloc_allocator_options_init(&vpr_alloc);
+
+    /* create a buffer with our string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            vccrypt_buffer_init(
+                &input, &vpr_alloc, strlen(ROLE_EXTENDS_INPUT) + 1));
+    memset(input.data, 0, input.size);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            vccrypt_buffer_read_data(&input, ROLE_EXTENDS_INPUT, input.size));
+
+    /* create an arena for this source. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_arena_create(
+                &arena, alloc, input.size,
+                ENDORSE_ARENA_INITIAL_BYTES_PER_SOURCE_BYTE));
+
+    /* parse and analyze in the arena, but compile with the malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_config_create_default(&ctx, arena));
+    TEST_ASSERT(STATUS_SUCCESS == endorse_parse(ctx, &input));
+    endorse_config* root = (endorse_config*)
+        endorse_config_default_context_get_endorse_config_root(ctx);
+    TEST_ASSERT(STATUS_SUCCESS == endorse_analyze(ctx, root));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_compile(&compiled, alloc, root, TEST_DIGEST));
+
+    /* releasing the arena frees the context and AST. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(arena)));
+
+    /* the compiled config outlives the arena. */
+    const endorse_compiled_entity* agentd =
+        endorse_compiled_find_entity(compiled, "agentd");
+    TEST_ASSERT(nullptr != agentd);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            granted_verbs(verbs, compiled, agentd, "writer"));
+    TEST_EXPECT(3U == verbs.size());
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&compiled->hdr));
+    dispose(vccrypt_buffer_disposable_handle(&input));
+    dispose(allocator_options_disposable_handle(&vpr_alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * A config that does not fit in its arena records that it ran out of memory,
+ * and parses in a larger arena.
+ */
+TEST(compile_in_exhausted_arena)
+{
+    rcpr_allocator* alloc;
+    rcpr_allocator* arena;
+    endorse_config_context* ctx;
+    string source;
+    char line[80];
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* build a config with more verbs than an arena the size of it can hold. */
+    source = "entities { agentd }\nverbs for agentd {\n";
+    for (int i = 0; i < 4000; ++i)
+    {
+        snprintf(
+            line, sizeof(line), "v%d 00000000-0000-0000-0000-%012d\n", i, i);
+        source += line;
+    }
+    source += "}\n";
+
+    /* an arena of one byte per source byte is exhausted. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_arena_create(&arena, alloc, source.size(), 1));
+    TEST_ASSERT(STATUS_SUCCESS == endorse_config_create_default(&ctx, arena));
+    endorse_parse_mapped(ctx, source.data(), source.size());
+    TEST_EXPECT(ctx->out_of_memory);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(arena)));
+
+    /* the largest arena holds it. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_arena_create(
+                &arena, alloc, source.size(),
+                ENDORSE_ARENA_MAX_BYTES_PER_SOURCE_BYTE));
+    TEST_ASSERT(STATUS_SUCCESS == endorse_config_create_default(&ctx, arena));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_parse_mapped(ctx, source.data(), source.size()));
+    TEST_EXPECT(!ctx->out_of_memory);
+    endorse_config* root = (endorse_config*)
+        endorse_config_default_context_get_endorse_config_root(ctx);
+    TEST_ASSERT(nullptr != root);
+    TEST_EXPECT(STATUS_SUCCESS == endorse_analyze(ctx, root));
+    TEST_EXPECT(!ctx->out_of_memory);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(arena)));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * Parsing directly from source that is not ASCIIZ produces the same compiled
+ * config as the flex scanner.
+ */
+TEST(compile_mapped)
+{
+    rcpr_allocator* alloc;
+    allocator_options_t vpr_alloc;
+    vccrypt_buffer_t input;
+    endorse_config_context* ctx;
+    endorse_compiled* compiled;
+    endorse_compiled* mapped;
+    size_t source_size = strlen(ROLE_EXTENDS_INPUT);
+    char* source;
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the VPR malloc allocator. */
+    malloc_allocator_options_init(&vpr_alloc);
+
+    /* create a buffer with our string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            vccrypt_buffer_init(&input, &vpr_alloc, source_size + 1));
+    memset(input.data, 0, input.size);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            vccrypt_buffer_read_data(&input, ROLE_EXTENDS_INPUT, input.size));
+
+    /* compile the config using the flex scanner. */
+    TEST_ASSERT(STATUS_SUCCESS == compile_input(&compiled, alloc, &input));
+
+    /* copy the source without its terminator. */
+    source = (char*)malloc(source_size);
+    TEST_ASSERT(nullptr != source);
+    memcpy(source, ROLE_EXTENDS_INPUT, source_size);
+
+    /* parse, analyze, and compile the source in place. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_config_create_default(&ctx, alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS == endorse_parse_mapped(ctx, source, source_size));
+    endorse_config* root = (endorse_config*)
+        endorse_config_default_context_get_endorse_config_root(ctx);
+    TEST_ASSERT(nullptr != root);
+    TEST_ASSERT(STATUS_SUCCESS == endorse_analyze(ctx, root));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_compile(&mapped, alloc, root, TEST_DIGEST));
+
+    /* the compiled images are identical. */
+    TEST_ASSERT(compiled->image_size == mapped->image_size);
+    TEST_EXPECT(!memcmp(compiled->image, mapped->image, mapped->image_size));
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&ctx->hdr));
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&mapped->hdr));
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&compiled->hdr));
+    free(source);
+    dispose(vccrypt_buffer_disposable_handle(&input));
+    dispose(allocator_options_disposable_handle(&vpr_alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * Granting roles and verbs ORs their verbs into a verb bitset for the entity.
+ */
+TEST(grant_moiety)
+{
+    rcpr_allocator* alloc;
+    allocator_options_t vpr_alloc;
+    vccrypt_buffer_t input;
+    endorse_compiled* compiled;
+    uint64_t grants[1] = { 0 };
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the VPR malloc allocator. */
+    malloc_allocator_options_init(&vpr_alloc);
+
+    /* create a buffer with our string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            vccrypt_buffer_init(
+                &input, &vpr_alloc, strlen(ROLE_EXTENDS_INPUT) + 1));
+    memset(input.data, 0, input.size);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            vccrypt_buffer_read_data(&input, ROLE_EXTENDS_INPUT, input.size));
+
+    /* compile the config. */
+    TEST_ASSERT(STATUS_SUCCESS == compile_input(&compiled, alloc, &input));
+
+    /* the nine verbs of agentd fit in a single word. */
+    const endorse_compiled_entity* agentd =
+        endorse_compiled_find_entity(compiled, "agentd");
+    TEST_ASSERT(nullptr != agentd);
+    TEST_ASSERT(1U == endorse_compiled_entity_word_count(agentd));
+
+    /* writer grants block_get, latest_block_id_get, and transaction_submit. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_compiled_grant_moiety(grants, compiled, agentd, "writer"));
+    TEST_EXPECT(0x10CU == grants[0]);
+
+    /* reader adds nothing new, since writer extends reader. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_compiled_grant_moiety(grants, compiled, agentd, "reader"));
+    TEST_EXPECT(0x10CU == grants[0]);
+
+    /* a verb grants only itself; artifact_get is the first verb by name. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_compiled_grant_moiety(
+                grants, compiled, agentd, "artifact_get"));
+    TEST_EXPECT(0x10DU == grants[0]);
+
+    /* an unknown moiety grants nothing. */
+    TEST_EXPECT(
+        VCTOOL_ERROR_ENDORSE_UNKNOWN_ROLE_OR_VERB ==
+            endorse_compiled_grant_moiety(grants, compiled, agentd, "admin"));
+    TEST_EXPECT(0x10DU == grants[0]);
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&compiled->hdr));
+    dispose(vccrypt_buffer_disposable_handle(&input));
+    dispose(allocator_options_disposable_handle(&vpr_alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
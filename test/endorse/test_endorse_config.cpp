@@ -9,6 +9,7 @@
 #include <minunit/minunit.h>
 #include <string.h>
 #include <vctool/endorse.h>
+#include <vctool/status_codes.h>
 #include <vpr/allocator/malloc_allocator.h>
 
 extern "C" {
@@ -1438,6 +1439,9 @@ TEST(semantic_analyzer_populates_verb_references)
     /* the semantic analyzer added the real verb reference. */
     TEST_EXPECT(
         latest_block_id_get == rv_latest_block_id_get->verb);
+    /* the verb name and role verb name share one interned symbol. */
+    TEST_EXPECT(
+        latest_block_id_get->verb == rv_latest_block_id_get->verb_name);
 
     /* clean up. */
     TEST_ASSERT(STATUS_SUCCESS == resource_release(&ctx->hdr));
@@ -1677,14 +1681,145 @@ TEST(role_extends_semantic_analysis)
     TEST_EXPECT(1 == writer->reference_count);
     /* the name is "writer". */
     TEST_EXPECT(!strcmp(writer->name, "writer"));
-    /* THREE verbs are defined for writer. */
-    TEST_EXPECT(3 == rbtree_count(writer->verbs));
+    /* one verb is declared for writer. */
+    TEST_EXPECT(1 == rbtree_count(writer->verbs));
     /* the writer role extends the reader role. */
     TEST_ASSERT(NULL != writer->extends_role_name);
     TEST_EXPECT(0 == strcmp(writer->extends_role_name, "reader"));
     /* the extended role is the reader role. */
     TEST_EXPECT(reader == writer->extends_role);
 
+    /* the reader role's verb set holds its two verbs. */
+    TEST_ASSERT(nullptr != reader->verb_set);
+    TEST_EXPECT(2U == endorse_verb_set_count(reader->verb_set));
+    /* the writer role's verb set holds THREE verbs. */
+    TEST_ASSERT(nullptr != writer->verb_set);
+    TEST_EXPECT(3U == endorse_verb_set_count(writer->verb_set));
+    TEST_EXPECT(writer->verb_set != reader->verb_set);
+
+    /* every verb in the reader set is in the writer set. */
+    for (size_t i = 0; i < agentd->verb_table_size; ++i)
+    {
+        if (endorse_verb_set_contains(reader->verb_set, i))
+        {
+            TEST_EXPECT(endorse_verb_set_contains(writer->verb_set, i));
+        }
+    }
+
+    /* the verb table maps each dense index back to its verb. */
+    TEST_ASSERT(9U == agentd->verb_table_size);
+    TEST_ASSERT(STATUS_SUCCESS == rbtree_find(&val, agentd->verbs, "block_get"));
+    endorse_verb* block_get = (endorse_verb*)val;
+    TEST_EXPECT(block_get == agentd->verb_table[block_get->index]);
+    TEST_EXPECT(endorse_verb_set_contains(reader->verb_set, block_get->index));
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&ctx->hdr));
+    dispose(vccrypt_buffer_disposable_handle(&input));
+    dispose(allocator_options_disposable_handle(&vpr_alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * Role chains are resolved regardless of declaration order, and a role that
+ * adds no verbs shares the verb set of the role it extends.
+ */
+TEST(role_extends_chain_shares_verb_set)
+{
+    endorse_config_context* ctx;
+    rcpr_allocator* alloc;
+    allocator_options_t vpr_alloc;
+    vccrypt_buffer_t input;
+    resource* val;
+    const char INPUT[] =
+        R"MULTI(
+        entities {
+            agentd
+        }
+        verbs for agentd {
+            latest_block_id_get     c5b0eb04-6b24-48be-b7d9-bf9083a4be5d
+            block_get               f382e365-1224-43b4-924a-1de4d9f4cf25
+            transaction_submit      ef560d24-eea6-4847-9009-464b127f249b
+        }
+        roles for agentd {
+            a extends b {
+            }
+            b extends c {
+                transaction_submit
+            }
+            c extends d {
+            }
+            d {
+                latest_block_id_get
+                block_get
+            }
+        })MULTI";
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the VPR malloc allocator. */
+    malloc_allocator_options_init(&vpr_alloc);
+
+    /* create a default config context. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_config_create_default(&ctx, alloc));
+
+    /* create a buffer with our string. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            vccrypt_buffer_init(&input, &vpr_alloc, strlen(INPUT) + 1));
+    memset(input.data, 0, input.size);
+    TEST_ASSERT(
+        STATUS_SUCCESS == vccrypt_buffer_read_data(&input, INPUT, input.size));
+
+    /* parse the data. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_parse(ctx, &input));
+
+    /* verify user config. */
+    endorse_config* root = (endorse_config*)
+        endorse_config_default_context_get_endorse_config_root(ctx);
+    TEST_ASSERT(nullptr != root);
+
+    /* perform the semantic analysis on this config context. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_analyze(ctx, root));
+
+    /* find agentd. */
+    TEST_ASSERT(STATUS_SUCCESS == rbtree_find(&val, root->entities, "agentd"));
+    endorse_entity* agentd = (endorse_entity*)val;
+
+    /* find each role. */
+    TEST_ASSERT(STATUS_SUCCESS == rbtree_find(&val, agentd->roles, "a"));
+    endorse_role* a = (endorse_role*)val;
+    TEST_ASSERT(STATUS_SUCCESS == rbtree_find(&val, agentd->roles, "b"));
+    endorse_role* b = (endorse_role*)val;
+    TEST_ASSERT(STATUS_SUCCESS == rbtree_find(&val, agentd->roles, "c"));
+    endorse_role* c = (endorse_role*)val;
+    TEST_ASSERT(STATUS_SUCCESS == rbtree_find(&val, agentd->roles, "d"));
+    endorse_role* d = (endorse_role*)val;
+
+    /* every role is complete. */
+    TEST_EXPECT(a->type_complete);
+    TEST_EXPECT(b->type_complete);
+    TEST_EXPECT(c->type_complete);
+    TEST_EXPECT(d->type_complete);
+
+    /* the chain is linked. */
+    TEST_EXPECT(b == a->extends_role);
+    TEST_EXPECT(c == b->extends_role);
+    TEST_EXPECT(d == c->extends_role);
+    TEST_EXPECT(nullptr == d->extends_role);
+
+    /* roles that add no verbs share the extended verb set. */
+    TEST_EXPECT(b->verb_set == a->verb_set);
+    TEST_EXPECT(d->verb_set == c->verb_set);
+    TEST_EXPECT(c->verb_set != b->verb_set);
+
+    /* verb sets accumulate up the chain. */
+    TEST_EXPECT(2U == endorse_verb_set_count(d->verb_set));
+    TEST_EXPECT(3U == endorse_verb_set_count(b->verb_set));
+
     /* clean up. */
     TEST_ASSERT(STATUS_SUCCESS == resource_release(&ctx->hdr));
     dispose(vccrypt_buffer_disposable_handle(&input));
@@ -2021,3 +2156,195 @@ TEST(role_extends_analysis_circular_n3)
         STATUS_SUCCESS ==
             resource_release(rcpr_allocator_resource_handle(alloc)));
 }
+
+/**
+ * Test that a config split across files can be merged, even if the entity is
+ * declared after the verbs and roles that refer to it.
+ */
+TEST(merge_split_config)
+{
+    endorse_config_context* ctx0;
+    endorse_config_context* ctx1;
+    rcpr_allocator* alloc;
+    resource* val;
+    const char INPUT0[] =
+        R"MULTI(
+        verbs for agentd {
+            latest_block_id_get     c5b0eb04-6b24-48be-b7d9-bf9083a4be5d
+        }
+        roles for agentd {
+            reader {
+                latest_block_id_get
+            }
+        })MULTI";
+    const char INPUT1[] =
+        R"MULTI(
+        entities {
+            agentd
+        }
+        verbs for agentd {
+            block_get               f382e365-1224-43b4-924a-1de4d9f4cf25
+        })MULTI";
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a config context for each file. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_config_create_default(&ctx0, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == endorse_config_create_default(&ctx1, alloc));
+
+    /* parse each file. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == endorse_parse_mapped(ctx0, INPUT0, strlen(INPUT0)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == endorse_parse_mapped(ctx1, INPUT1, strlen(INPUT1)));
+
+    /* get the root configs. */
+    endorse_config* root = (endorse_config*)
+        endorse_config_default_context_get_endorse_config_root(ctx0);
+    endorse_config* other = (endorse_config*)
+        endorse_config_default_context_get_endorse_config_root(ctx1);
+    TEST_ASSERT(nullptr != root);
+    TEST_ASSERT(nullptr != other);
+
+    /* merge the second file into the first. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_merge(ctx0, root, other));
+
+    /* there are no errors. */
+    TEST_ASSERT(
+        0U == endorse_config_default_context_get_error_message_count(ctx0));
+
+    /* the other config is now empty. */
+    TEST_EXPECT(0 == rbtree_count(other->entities));
+
+    /* the merged config passes semantic analysis. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_analyze(ctx0, root));
+
+    /* agentd is declared and holds the verbs from both files. */
+    TEST_ASSERT(1 == rbtree_count(root->entities));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            rbtree_find(&val, root->entities, "agentd"));
+    endorse_entity* agentd = (endorse_entity*)val;
+    TEST_EXPECT(agentd->id_declared);
+    TEST_EXPECT(2 == rbtree_count(agentd->verbs));
+    TEST_EXPECT(1 == rbtree_count(agentd->roles));
+
+    /* clean up; the root context holds entities from the other. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&ctx0->hdr));
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&ctx1->hdr));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * Test that a verb defined in two files is reported as a duplicate.
+ */
+TEST(merge_duplicate_verb)
+{
+    endorse_config_context* ctx0;
+    endorse_config_context* ctx1;
+    rcpr_allocator* alloc;
+    const char INPUT0[] =
+        R"MULTI(
+        entities {
+            agentd
+        }
+        verbs for agentd {
+            block_get               f382e365-1224-43b4-924a-1de4d9f4cf25
+        })MULTI";
+    const char INPUT1[] =
+        R"MULTI(
+        verbs for agentd {
+            block_get               f382e365-1224-43b4-924a-1de4d9f4cf25
+        })MULTI";
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a config context for each file. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_config_create_default(&ctx0, alloc));
+    TEST_ASSERT(STATUS_SUCCESS == endorse_config_create_default(&ctx1, alloc));
+
+    /* parse each file. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == endorse_parse_mapped(ctx0, INPUT0, strlen(INPUT0)));
+    TEST_ASSERT(
+        STATUS_SUCCESS == endorse_parse_mapped(ctx1, INPUT1, strlen(INPUT1)));
+
+    /* get the root configs. */
+    endorse_config* root = (endorse_config*)
+        endorse_config_default_context_get_endorse_config_root(ctx0);
+    endorse_config* other = (endorse_config*)
+        endorse_config_default_context_get_endorse_config_root(ctx1);
+    TEST_ASSERT(nullptr != root);
+    TEST_ASSERT(nullptr != other);
+
+    /* the merge fails. */
+    TEST_ASSERT(STATUS_SUCCESS != endorse_merge(ctx0, root, other));
+
+    /* the duplicate verb was reported. */
+    TEST_ASSERT(
+        0U != endorse_config_default_context_get_error_message_count(ctx0));
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&ctx0->hdr));
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&ctx1->hdr));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * Test that each error message can be read by its index.
+ */
+TEST(get_error_message_by_index)
+{
+    endorse_config_context* ctx;
+    rcpr_allocator* alloc;
+    const char* msg;
+    const char INPUT[] =
+        R"MULTI(
+        verbs for agentd {
+            block_get           f382e365-1224-43b4-924a-1de4d9f4cf25
+        })MULTI";
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a default config context. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_config_create_default(&ctx, alloc));
+
+    /* parse the data. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == endorse_parse_mapped(ctx, INPUT, strlen(INPUT)));
+
+    /* get the endorse config root. */
+    const endorse_config* root =
+        endorse_config_default_context_get_endorse_config_root(ctx);
+    TEST_ASSERT(nullptr != root);
+
+    /* agentd was never declared. */
+    TEST_ASSERT(
+        STATUS_SUCCESS != endorse_analyze(ctx, (endorse_config*)root));
+    TEST_ASSERT(
+        1U == endorse_config_default_context_get_error_message_count(ctx));
+
+    /* the first message can be read. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_config_default_context_get_error_message(&msg, ctx, 0));
+    TEST_EXPECT(nullptr != strstr(msg, "agentd"));
+
+    /* the message after the last one is out of bounds. */
+    TEST_EXPECT(
+        VCTOOL_ERROR_ENDORSE_ERROR_MESSAGE_INDEX_OUT_OF_BOUNDS ==
+            endorse_config_default_context_get_error_message(&msg, ctx, 1));
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&ctx->hdr));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,410 @@
+/**
+ * \file test/endorse/test_endorse_incremental.cpp
+ *
+ * \brief Unit tests for the incremental endorse config.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <minunit/minunit.h>
+#include <string.h>
+#include <vector>
+#include <vctool/endorse.h>
+#include <vctool/status_codes.h>
+
+#include "../../src/command/endorse/endorse_internal.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+RCPR_IMPORT_uuid;
+
+/* start of the endorse_incremental test suite. */
+TEST_SUITE(endorse_incremental);
+
+static const char INPUT[] =
+    R"MULTI(
+    entities {
+        agentd
+        authd
+    }
+    verbs for agentd {
+        latest_block_id_get     c5b0eb04-6b24-48be-b7d9-bf9083a4be5d
+    }
+    verbs for authd {
+        login                   f382e365-1224-43b4-924a-1de4d9f4cf25
+    }
+    roles for agentd {
+        reader {
+            latest_block_id_get
+        }
+    })MULTI";
+
+static const char INPUT_CHANGED[] =
+    R"MULTI(
+    entities {
+        agentd
+        authd
+    }
+    verbs for agentd {
+        latest_block_id_get     c5b0eb04-6b24-48be-b7d9-bf9083a4be5d
+    }
+    verbs for authd {
+        login                   f382e365-1224-43b4-924a-1de4d9f4cf25
+        logout                  3e2f2d0b-2bde-4b8f-8d29-4a7f3c1d58f0
+    }
+    roles for agentd {
+        reader {
+            latest_block_id_get
+        }
+    })MULTI";
+
+static const char INPUT_INVALID[] =
+    R"MULTI(
+    entities {
+        agentd
+        authd
+    }
+    verbs for agentd {
+        latest_block_id_get     c5b0eb04-6b24-48be-b7d9-bf9083a4be5d
+    }
+    verbs for authd {
+        login                   f382e365-1224-43b4-924a-1de4d9f4cf25
+    }
+    roles for agentd {
+        reader {
+            block_get
+        }
+    })MULTI";
+
+static const char INPUT_REMOVED_ENTITY[] =
+    R"MULTI(
+    entities {
+        agentd
+    }
+    verbs for agentd {
+        latest_block_id_get     c5b0eb04-6b24-48be-b7d9-bf9083a4be5d
+        block_get               f382e365-1224-43b4-924a-1de4d9f4cf25
+    }
+    roles for agentd {
+        reader {
+            latest_block_id_get
+        }
+        writer extends reader {
+            block_get
+        }
+    })MULTI";
+
+static const char INPUT_RENAMED_ROLE[] =
+    R"MULTI(
+    entities {
+        agentd
+    }
+    verbs for agentd {
+        latest_block_id_get     c5b0eb04-6b24-48be-b7d9-bf9083a4be5d
+        block_get               f382e365-1224-43b4-924a-1de4d9f4cf25
+    }
+    roles for agentd {
+        observer {
+            latest_block_id_get
+        }
+        writer extends observer {
+            block_get
+        }
+    })MULTI";
+
+/**
+ * Grant a single role or verb of an entity, and collect the verbs it grants.
+ */
+static status granted_verbs(
+    vector<const endorse_compiled_verb*>& verbs,
+    const endorse_compiled* compiled, const endorse_compiled_entity* entity,
+    const char* moiety)
+{
+    vector<uint64_t> grants(endorse_compiled_entity_word_count(entity), 0);
+
+    status retval =
+        endorse_compiled_grant_moiety(grants.data(), compiled, entity, moiety);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    verbs.clear();
+    for (uint32_t i = 0; i < entity->verb_count; ++i)
+    {
+        if (grants[i / 64] & (UINT64_C(1) << (i % 64)))
+        {
+            verbs.push_back(&compiled->verbs[entity->verb_offset + i]);
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * Commit the given source to the incremental config, and return true if the
+ * incrementally compiled config is identical to a full compile of the source.
+ */
+static bool commit_matches_full_compile(
+    endorse_incremental* inc, rcpr_allocator* alloc, const char* source)
+{
+    endorse_incremental_stats stats;
+    endorse_compiled* incremental;
+    endorse_compiled* full;
+    endorse_config_source source_file;
+    const uint8_t digest[ENDORSE_COMPILED_DIGEST_SIZE] = { 0 };
+    bool matches;
+
+    if (STATUS_SUCCESS !=
+            endorse_incremental_add_source(inc, source, strlen(source))
+     || STATUS_SUCCESS != endorse_incremental_commit(inc, &stats)
+     || STATUS_SUCCESS !=
+            endorse_incremental_compile(&incremental, alloc, inc, digest))
+    {
+        return false;
+    }
+
+    /* compile the same source from scratch, as the endorse command does. */
+    source_file.filename = "endorse.cfg";
+    source_file.data = source;
+    source_file.size = strlen(source);
+    if (STATUS_SUCCESS !=
+            endorse_compile_source(
+                &full, alloc, ENDORSE_ARENA_INITIAL_BYTES_PER_SOURCE_BYTE,
+                &source_file, 1, digest))
+    {
+        resource_release(&incremental->hdr);
+        return false;
+    }
+
+    /* the compiled images must be byte-for-byte identical. */
+    matches =
+        incremental->image_size == full->image_size
+     && !memcmp(incremental->image, full->image, full->image_size);
+
+    resource_release(&full->hdr);
+    resource_release(&incremental->hdr);
+
+    return matches;
+}
+
+/**
+ * Test that the first commit analyzes every entity, and that committing the
+ * same source again analyzes none.
+ */
+TEST(commit_unchanged)
+{
+    endorse_incremental* inc;
+    endorse_incremental_stats stats;
+    rcpr_allocator* alloc;
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the incremental config. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_incremental_create(&inc, alloc));
+
+    /* the first commit analyzes every entity. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_incremental_add_source(inc, INPUT, strlen(INPUT)));
+    TEST_ASSERT(STATUS_SUCCESS == endorse_incremental_commit(inc, &stats));
+    TEST_EXPECT(4 == stats.block_count);
+    TEST_EXPECT(4 == stats.blocks_changed);
+    TEST_EXPECT(2 == stats.entity_count);
+    TEST_EXPECT(2 == stats.entities_analyzed);
+    TEST_EXPECT(0 == endorse_incremental_get_error_message_count(inc));
+
+    /* committing the same source analyzes nothing. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_incremental_add_source(inc, INPUT, strlen(INPUT)));
+    TEST_ASSERT(STATUS_SUCCESS == endorse_incremental_commit(inc, &stats));
+    TEST_EXPECT(4 == stats.block_count);
+    TEST_EXPECT(0 == stats.blocks_changed);
+    TEST_EXPECT(2 == stats.entity_count);
+    TEST_EXPECT(0 == stats.entities_analyzed);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(endorse_incremental_resource_handle(inc)));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * Test that changing one entity's block only analyzes that entity.
+ */
+TEST(commit_changed_entity)
+{
+    endorse_incremental* inc;
+    endorse_incremental_stats stats;
+    endorse_compiled* compiled;
+    rcpr_allocator* alloc;
+    const uint8_t digest[ENDORSE_COMPILED_DIGEST_SIZE] = { 0 };
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the incremental config. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_incremental_create(&inc, alloc));
+
+    /* commit the original config. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_incremental_add_source(inc, INPUT, strlen(INPUT)));
+    TEST_ASSERT(STATUS_SUCCESS == endorse_incremental_commit(inc, &stats));
+
+    /* add a verb to authd. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_incremental_add_source(
+                inc, INPUT_CHANGED, strlen(INPUT_CHANGED)));
+    TEST_ASSERT(STATUS_SUCCESS == endorse_incremental_commit(inc, &stats));
+    TEST_EXPECT(1 == stats.blocks_changed);
+    TEST_EXPECT(2 == stats.entity_count);
+    TEST_EXPECT(1 == stats.entities_analyzed);
+
+    /* the compiled config holds both entities. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_incremental_compile(
+                &compiled, alloc, inc, digest));
+    TEST_EXPECT(nullptr != endorse_compiled_find_entity(compiled, "agentd"));
+    TEST_EXPECT(nullptr != endorse_compiled_find_entity(compiled, "authd"));
+    TEST_EXPECT(nullptr == endorse_compiled_find_entity(compiled, "foo"));
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&compiled->hdr));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(endorse_incremental_resource_handle(inc)));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * Test that a config with errors reports them and keeps the last good config.
+ */
+TEST(commit_invalid_keeps_last_good)
+{
+    endorse_incremental* inc;
+    endorse_incremental_stats stats;
+    endorse_compiled* compiled;
+    rcpr_allocator* alloc;
+    const uint8_t digest[ENDORSE_COMPILED_DIGEST_SIZE] = { 0 };
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the incremental config. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_incremental_create(&inc, alloc));
+
+    /* there is nothing to compile before the first good commit. */
+    TEST_EXPECT(
+        VCTOOL_ERROR_ENDORSE_INVALID_CONFIG ==
+            endorse_incremental_compile(
+                &compiled, alloc, inc, digest));
+
+    /* commit the original config. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_incremental_add_source(inc, INPUT, strlen(INPUT)));
+    TEST_ASSERT(STATUS_SUCCESS == endorse_incremental_commit(inc, &stats));
+
+    /* the role references an undeclared verb. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_incremental_add_source(
+                inc, INPUT_INVALID, strlen(INPUT_INVALID)));
+    TEST_ASSERT(
+        VCTOOL_ERROR_ENDORSE_INVALID_CONFIG ==
+            endorse_incremental_commit(inc, &stats));
+    TEST_ASSERT(0 < endorse_incremental_get_error_message_count(inc));
+    TEST_EXPECT(nullptr != endorse_incremental_get_error_message(inc, 0));
+    TEST_EXPECT(
+        nullptr ==
+            endorse_incremental_get_error_message(
+                inc, endorse_incremental_get_error_message_count(inc)));
+
+    /* the last good config can still be compiled. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_incremental_compile(
+                &compiled, alloc, inc, digest));
+    TEST_EXPECT(nullptr != endorse_compiled_find_entity(compiled, "agentd"));
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&compiled->hdr));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(endorse_incremental_resource_handle(inc)));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * Test that after a sequence of edits, each incremental compile is identical to
+ * a full compile of the same source.
+ */
+TEST(incremental_matches_full_compile)
+{
+    endorse_incremental* inc;
+    endorse_compiled* compiled;
+    rcpr_allocator* alloc;
+    const endorse_compiled_entity* agentd;
+    vector<const endorse_compiled_verb*> verbs;
+    const uint8_t digest[ENDORSE_COMPILED_DIGEST_SIZE] = { 0 };
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the incremental config. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_incremental_create(&inc, alloc));
+
+    /* the original config. */
+    TEST_EXPECT(commit_matches_full_compile(inc, alloc, INPUT));
+
+    /* add a verb to authd. */
+    TEST_EXPECT(commit_matches_full_compile(inc, alloc, INPUT_CHANGED));
+
+    /* remove authd, and add a verb and an extending role to agentd. */
+    TEST_EXPECT(commit_matches_full_compile(inc, alloc, INPUT_REMOVED_ENTITY));
+
+    /* rename the extended role. */
+    TEST_EXPECT(commit_matches_full_compile(inc, alloc, INPUT_RENAMED_ROLE));
+
+    /* the last compile reflects every edit. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_incremental_compile(&compiled, alloc, inc, digest));
+    TEST_EXPECT(nullptr == endorse_compiled_find_entity(compiled, "authd"));
+    agentd = endorse_compiled_find_entity(compiled, "agentd");
+    TEST_ASSERT(nullptr != agentd);
+    TEST_EXPECT(
+        STATUS_SUCCESS !=
+            granted_verbs(verbs, compiled, agentd, "reader"));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            granted_verbs(verbs, compiled, agentd, "observer"));
+    TEST_EXPECT(1U == verbs.size());
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            granted_verbs(verbs, compiled, agentd, "writer"));
+    TEST_EXPECT(2U == verbs.size());
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&compiled->hdr));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(endorse_incremental_resource_handle(inc)));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
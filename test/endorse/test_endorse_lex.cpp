@@ -0,0 +1,358 @@
+/**
+ * \file test/endorse/test_endorse_lex.cpp
+ *
+ * \brief Unit tests comparing the flex and mapped endorse scanners.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <minunit/minunit.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vctool/endorse.h>
+#include <vctool/status_codes.h>
+#include <vector>
+
+#include "../../src/lib/endorse/endorse_internal.h"
+
+extern "C" {
+#include "endorse.tab.h"
+#include "endorse.yy.h"
+}
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/* start of the endorse_lex test suite. */
+TEST_SUITE(endorse_lex);
+
+/** \brief Stop scanning after this many tokens, in case a scanner loops. */
+#define MAX_TOKENS 1000
+
+/**
+ * \brief A token and its semantic value.
+ */
+struct lexed_token
+{
+    int token;
+    string text;
+    vector<uint8_t> id;
+
+    bool operator==(const lexed_token& other) const
+    {
+        return
+            token == other.token && text == other.text && id == other.id;
+    }
+};
+
+/**
+ * Save a token and its semantic value, freeing any UUID.
+ */
+static lexed_token save_token(int token, YYSTYPE* lval)
+{
+    lexed_token t;
+
+    t.token = token;
+    switch (token)
+    {
+        case IDENTIFIER:
+        case INVALID:
+            if (NULL != lval->string)
+            {
+                t.text = lval->string;
+            }
+            break;
+
+        case UUID:
+        case UUID_INVALID:
+            if (NULL != lval->id)
+            {
+                const uint8_t* bytes = (const uint8_t*)lval->id;
+                t.id.assign(bytes, bytes + sizeof(*lval->id));
+                free(lval->id);
+            }
+            break;
+    }
+
+    return t;
+}
+
+/**
+ * Read every token of the input with the flex scanner.
+ */
+static vector<lexed_token> flex_tokens(
+    endorse_config_context* ctx, const string& input)
+{
+    vector<lexed_token> tokens;
+    yyscan_t scanner;
+    YY_BUFFER_STATE state;
+    YYSTYPE lval;
+    int token;
+
+    if (0 != yylex_init_extra(ctx, &scanner))
+    {
+        return tokens;
+    }
+
+    state = yy_scan_bytes(input.data(), (int)input.size(), scanner);
+    while (tokens.size() < MAX_TOKENS)
+    {
+        memset(&lval, 0, sizeof(lval));
+        token = yylex(&lval, scanner);
+        if (0 == token)
+        {
+            break;
+        }
+
+        tokens.push_back(save_token(token, &lval));
+    }
+
+    yy_delete_buffer(state, scanner);
+    yylex_destroy(scanner);
+
+    return tokens;
+}
+
+/**
+ * Read every token of the input with the mapped scanner.
+ */
+static vector<lexed_token> mapped_tokens(
+    endorse_config_context* ctx, const string& input)
+{
+    vector<lexed_token> tokens;
+    endorse_scanner scanner;
+    YYSTYPE lval;
+    int token;
+
+    /* the mapped scanner never reads past the end of its slice. */
+    char* source = (char*)malloc(input.size() + 1);
+    memcpy(source, input.data(), input.size());
+
+    memset(&scanner, 0, sizeof(scanner));
+    scanner.context = ctx;
+    scanner.base = source;
+    scanner.size = input.size();
+
+    while (tokens.size() < MAX_TOKENS)
+    {
+        memset(&lval, 0, sizeof(lval));
+        token = endorse_lex_mapped(&lval, &scanner);
+        if (0 == token)
+        {
+            break;
+        }
+
+        tokens.push_back(save_token(token, &lval));
+    }
+
+    free(source);
+
+    return tokens;
+}
+
+/**
+ * Scan the input with both scanners, returning the flex tokens if both
+ * scanners produce the same token stream, and an empty stream otherwise.
+ */
+static vector<lexed_token> same_tokens(const string& input)
+{
+    rcpr_allocator* alloc;
+    endorse_config_context* ctx;
+    vector<lexed_token> flex;
+    vector<lexed_token> mapped;
+
+    if (STATUS_SUCCESS != rcpr_malloc_allocator_create(&alloc))
+    {
+        return flex;
+    }
+
+    if (STATUS_SUCCESS != endorse_config_create_default(&ctx, alloc))
+    {
+        goto cleanup_allocator;
+    }
+
+    flex = flex_tokens(ctx, input);
+    mapped = mapped_tokens(ctx, input);
+    if (!(flex == mapped) || ctx->out_of_memory)
+    {
+        flex.clear();
+    }
+
+    resource_release(&ctx->hdr);
+
+cleanup_allocator:
+    resource_release(rcpr_allocator_resource_handle(alloc));
+
+    return flex;
+}
+
+/**
+ * Count the tokens of the given kind.
+ */
+static size_t count_tokens(const vector<lexed_token>& tokens, int token)
+{
+    size_t count = 0;
+
+    for (const auto& t : tokens)
+    {
+        if (token == t.token)
+        {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Test that both scanners read punctuation, keywords, and identifiers the
+ * same way.
+ */
+TEST(keywords_and_identifiers)
+{
+    auto tokens =
+        same_tokens(
+            "entities { agentd, authd }\n"
+            "verbs for agentd {\n"
+            "    block_read 01234567-89ab-cdef-0123-456789abcdef\n"
+            "}\n"
+            "roles for agentd { reader extends writer { block_read } }\n");
+
+    TEST_ASSERT(!tokens.empty());
+    TEST_EXPECT(ENTITIES == tokens[0].token);
+    TEST_EXPECT(LBRACE == tokens[1].token);
+    TEST_EXPECT(IDENTIFIER == tokens[2].token);
+    TEST_EXPECT("agentd" == tokens[2].text);
+    TEST_EXPECT(COMMA == tokens[3].token);
+    TEST_EXPECT(1U == count_tokens(tokens, UUID));
+    TEST_EXPECT(1U == count_tokens(tokens, EXTENDS));
+}
+
+/**
+ * Test that both scanners read identifiers that start with a keyword as
+ * identifiers, and a keyword followed by punctuation as a keyword.
+ */
+TEST(keyword_prefixes)
+{
+    auto tokens =
+        same_tokens(
+            "entitiesx verbs_ for2 rolesroles extendsextends _roles "
+            "entities{verbs,roles}for ENTITIES");
+
+    TEST_ASSERT(14U == tokens.size());
+    TEST_EXPECT(IDENTIFIER == tokens[0].token);
+    TEST_EXPECT("entitiesx" == tokens[0].text);
+    TEST_EXPECT(IDENTIFIER == tokens[1].token);
+    TEST_EXPECT("verbs_" == tokens[1].text);
+    TEST_EXPECT(IDENTIFIER == tokens[2].token);
+    TEST_EXPECT("for2" == tokens[2].text);
+    TEST_EXPECT(IDENTIFIER == tokens[3].token);
+    TEST_EXPECT(IDENTIFIER == tokens[4].token);
+    TEST_EXPECT(IDENTIFIER == tokens[5].token);
+    TEST_EXPECT(ENTITIES == tokens[6].token);
+    TEST_EXPECT(LBRACE == tokens[7].token);
+    TEST_EXPECT(VERBS == tokens[8].token);
+    TEST_EXPECT(COMMA == tokens[9].token);
+    TEST_EXPECT(ROLES == tokens[10].token);
+    TEST_EXPECT(RBRACE == tokens[11].token);
+    TEST_EXPECT(FOR == tokens[12].token);
+    TEST_EXPECT(IDENTIFIER == tokens[13].token);
+}
+
+/**
+ * Test that both scanners read invalid characters one at a time.
+ */
+TEST(invalid_tokens)
+{
+    auto tokens = same_tokens("agentd = 42; caf\xc3\xa9 $x");
+
+    TEST_ASSERT(!tokens.empty());
+    TEST_EXPECT(IDENTIFIER == tokens[0].token);
+    TEST_EXPECT(INVALID == tokens[1].token);
+    TEST_EXPECT("=" == tokens[1].text);
+    TEST_EXPECT(INVALID == tokens[2].token);
+    TEST_EXPECT("4" == tokens[2].text);
+    TEST_EXPECT(IDENTIFIER == tokens.back().token);
+    TEST_EXPECT("x" == tokens.back().text);
+}
+
+/**
+ * Test that both scanners agree on UUIDs, malformed UUIDs, and UUIDs that run
+ * into the next token.
+ *
+ * Both scanners return UUID_INVALID only if a string in UUID form fails to
+ * convert, so malformed UUIDs are split into smaller tokens instead.
+ */
+TEST(uuids)
+{
+    auto tokens =
+        same_tokens(
+            "01234567-89ab-cdef-0123-456789abcdef "
+            "abcdef01-2345-6789-abcd-ef0123456789x "
+            "01234567-89ab-cdef-0123-456789abcdef0 "
+            "0123456g-89ab-cdef-0123-456789abcdef "
+            "01234567_89ab_cdef_0123_456789abcdef "
+            "01234567-89AB-CDEF-0123-456789ABCDEF "
+            "01234567-89ab-cdef-0123-456789abcde}");
+
+    TEST_ASSERT(!tokens.empty());
+    TEST_EXPECT(UUID == tokens[0].token);
+    TEST_EXPECT(UUID == tokens[1].token);
+    TEST_EXPECT(IDENTIFIER == tokens[2].token);
+    TEST_EXPECT("x" == tokens[2].text);
+    TEST_EXPECT(UUID == tokens[3].token);
+    TEST_EXPECT(INVALID == tokens[4].token);
+    TEST_EXPECT("0" == tokens[4].text);
+    TEST_EXPECT(
+        4U == count_tokens(tokens, UUID) + count_tokens(tokens, UUID_INVALID));
+    TEST_EXPECT(RBRACE == tokens.back().token);
+}
+
+/**
+ * Test that both scanners agree on comments, which the endorse grammar does
+ * not have, so both read them as invalid characters and identifiers.
+ */
+TEST(comments)
+{
+    auto tokens =
+        same_tokens(
+            "# a comment\n"
+            "entities { agentd } // trailing comment\n"
+            "/* block\n   comment */ verbs");
+
+    TEST_ASSERT(!tokens.empty());
+    TEST_EXPECT(INVALID == tokens[0].token);
+    TEST_EXPECT("#" == tokens[0].text);
+    TEST_EXPECT(IDENTIFIER == tokens[1].token);
+    TEST_EXPECT("a" == tokens[1].text);
+    TEST_EXPECT(1U == count_tokens(tokens, ENTITIES));
+    TEST_EXPECT(VERBS == tokens.back().token);
+}
+
+/**
+ * Test that both scanners agree on input that ends in the middle of a token,
+ * and on input that is empty or only whitespace.
+ */
+TEST(input_ends_mid_token)
+{
+    TEST_EXPECT(same_tokens("").empty());
+    TEST_EXPECT(same_tokens(" \t\r\n\v\f").empty());
+
+    auto keyword = same_tokens("entities { agentd } verb");
+    TEST_ASSERT(5U == keyword.size());
+    TEST_EXPECT(IDENTIFIER == keyword.back().token);
+    TEST_EXPECT("verb" == keyword.back().text);
+
+    auto identifier = same_tokens("entities { agen");
+    TEST_ASSERT(3U == identifier.size());
+    TEST_EXPECT("agen" == identifier.back().text);
+
+    auto uuid = same_tokens("verbs for a { read 01234567-89ab-cdef-01");
+    TEST_ASSERT(!uuid.empty());
+    TEST_EXPECT(0U == count_tokens(uuid, UUID));
+    TEST_EXPECT(INVALID == uuid.back().token);
+    TEST_EXPECT("1" == uuid.back().text);
+}
@@ -0,0 +1,261 @@
+/**
+ * \file test/endorse/test_endorse_uuid_dictionary.cpp
+ *
+ * \brief Unit tests for the endorse uuid dictionary.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <minunit/minunit.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "../../src/command/endorse/endorse_internal.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+RCPR_IMPORT_uuid;
+
+/* start of the endorse_uuid_dictionary test suite. */
+TEST_SUITE(endorse_uuid_dictionary);
+
+/**
+ * Make a UUID whose bytes all hold the given value.
+ */
+static rcpr_uuid make_uuid(uint8_t value)
+{
+    rcpr_uuid id;
+
+    memset(&id, value, sizeof(id));
+
+    return id;
+}
+
+/**
+ * Test that keys which land in the same slot are found by probing, and that a
+ * missing key in the same probe sequence is not found.
+ */
+TEST(colliding_keys)
+{
+    rcpr_allocator* alloc;
+    endorse_uuid_dictionary* dict;
+    vector<string> keys;
+    string missing;
+    uint64_t bucket;
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a dictionary small enough that it won't grow. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == endorse_uuid_dictionary_create(&dict, alloc, 4));
+    TEST_ASSERT(16 == dict->capacity);
+
+    /* find keys that all start probing at the same slot. */
+    bucket = endorse_uuid_dictionary_hash("entity0") & (dict->capacity - 1);
+    for (int i = 0; keys.size() < 5 || missing.empty(); ++i)
+    {
+        string key = "entity" + to_string(i);
+        if (bucket == (endorse_uuid_dictionary_hash(key.c_str())
+                            & (dict->capacity - 1)))
+        {
+            if (keys.size() < 5)
+            {
+                keys.push_back(key);
+            }
+            else
+            {
+                missing = key;
+            }
+        }
+    }
+
+    /* add the colliding keys. */
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        rcpr_uuid value = make_uuid((uint8_t)i);
+        TEST_ASSERT(
+            STATUS_SUCCESS ==
+                endorse_uuid_dictionary_add(dict, keys[i].c_str(), &value));
+    }
+
+    TEST_EXPECT(keys.size() == dict->count);
+    TEST_EXPECT(16 == dict->capacity);
+
+    /* every colliding key is found with its own value. */
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        rcpr_uuid expected = make_uuid((uint8_t)i);
+        const rcpr_uuid* value =
+            endorse_uuid_dictionary_find(dict, keys[i].c_str());
+        TEST_ASSERT(nullptr != value);
+        TEST_EXPECT(!memcmp(value, &expected, sizeof(expected)));
+    }
+
+    /* a missing key in the same probe sequence is not found. */
+    TEST_EXPECT(nullptr == endorse_uuid_dictionary_find(dict, missing.c_str()));
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&dict->hdr));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * Test that the dictionary grows and rehashes its entries, and that every
+ * entry can still be found afterward.
+ */
+TEST(grow_and_rehash)
+{
+    rcpr_allocator* alloc;
+    endorse_uuid_dictionary* dict;
+    vector<string> keys;
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a dictionary that expects no entries. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == endorse_uuid_dictionary_create(&dict, alloc, 0));
+    TEST_ASSERT(16 == dict->capacity);
+
+    /* the keys must outlive the dictionary, so build them all first. */
+    for (int i = 0; i < 200; ++i)
+    {
+        keys.push_back("entity" + to_string(i));
+    }
+
+    /* add enough entries to grow the table several times. */
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        rcpr_uuid value = make_uuid((uint8_t)i);
+        TEST_ASSERT(
+            STATUS_SUCCESS ==
+                endorse_uuid_dictionary_add(dict, keys[i].c_str(), &value));
+
+        /* the table stays at most half full. */
+        TEST_EXPECT(2 * dict->count <= dict->capacity);
+    }
+
+    TEST_EXPECT(keys.size() == dict->count);
+    TEST_EXPECT(512 == dict->capacity);
+
+    /* every entry survives the rehash. */
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        rcpr_uuid expected = make_uuid((uint8_t)i);
+        const rcpr_uuid* value =
+            endorse_uuid_dictionary_find(dict, keys[i].c_str());
+        TEST_ASSERT(nullptr != value);
+        TEST_EXPECT(!memcmp(value, &expected, sizeof(expected)));
+    }
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&dict->hdr));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * Test that lookups miss in an empty dictionary and for keys that were never
+ * added, and that adding a key again replaces its value.
+ */
+TEST(misses_and_replacement)
+{
+    rcpr_allocator* alloc;
+    endorse_uuid_dictionary* dict;
+    rcpr_uuid first = make_uuid(0x11);
+    rcpr_uuid second = make_uuid(0x22);
+    const rcpr_uuid* value;
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a dictionary. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == endorse_uuid_dictionary_create(&dict, alloc, 2));
+
+    /* an empty dictionary finds nothing. */
+    TEST_EXPECT(nullptr == endorse_uuid_dictionary_find(dict, "agentd"));
+    TEST_EXPECT(nullptr == endorse_uuid_dictionary_find(dict, ""));
+
+    /* a missing key is not found. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == endorse_uuid_dictionary_add(dict, "agentd", &first));
+    TEST_EXPECT(nullptr == endorse_uuid_dictionary_find(dict, "authd"));
+    TEST_EXPECT(nullptr == endorse_uuid_dictionary_find(dict, "agent"));
+    TEST_EXPECT(nullptr == endorse_uuid_dictionary_find(dict, "agentd2"));
+
+    /* adding the same key replaces its value. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_uuid_dictionary_add(dict, "agentd", &second));
+    TEST_EXPECT(1 == dict->count);
+    value = endorse_uuid_dictionary_find(dict, "agentd");
+    TEST_ASSERT(nullptr != value);
+    TEST_EXPECT(!memcmp(value, &second, sizeof(second)));
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&dict->hdr));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * Test that replacing the value of an existing key in a half full table does
+ * not grow the table.
+ */
+TEST(replacement_does_not_grow)
+{
+    rcpr_allocator* alloc;
+    endorse_uuid_dictionary* dict;
+    vector<string> keys;
+    rcpr_uuid replacement = make_uuid(0x77);
+    const rcpr_uuid* value;
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a dictionary. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == endorse_uuid_dictionary_create(&dict, alloc, 4));
+    TEST_ASSERT(16 == dict->capacity);
+
+    /* fill the table until one more entry would grow it. */
+    for (int i = 0; i < 8; ++i)
+    {
+        keys.push_back("entity" + to_string(i));
+    }
+
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        rcpr_uuid value = make_uuid((uint8_t)i);
+        TEST_ASSERT(
+            STATUS_SUCCESS ==
+                endorse_uuid_dictionary_add(dict, keys[i].c_str(), &value));
+    }
+
+    TEST_ASSERT(16 == dict->capacity);
+
+    /* replacing a value leaves the table as it was. */
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            endorse_uuid_dictionary_add(dict, keys[3].c_str(), &replacement));
+    TEST_EXPECT(16 == dict->capacity);
+    TEST_EXPECT(8 == dict->count);
+    value = endorse_uuid_dictionary_find(dict, keys[3].c_str());
+    TEST_ASSERT(nullptr != value);
+    TEST_EXPECT(!memcmp(value, &replacement, sizeof(replacement)));
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&dict->hdr));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,224 @@
+/**
+ * \file test/endorse/test_endorse_working_set.cpp
+ *
+ * \brief Unit tests for the endorse working set.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <minunit/minunit.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "../../src/command/endorse/endorse_internal.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+RCPR_IMPORT_uuid;
+
+/* start of the endorse_working_set test suite. */
+TEST_SUITE(endorse_working_set);
+
+/**
+ * Fill a UUID with bytes from a simple linear congruential generator, so that
+ * every byte position varies.
+ */
+static void fill_uuid(rcpr_uuid* id, uint32_t* seed)
+{
+    for (size_t i = 0; i < sizeof(*id); ++i)
+    {
+        *seed = *seed * 1103515245U + 12345U;
+        ((uint8_t*)id)[i] = (uint8_t)(*seed >> 16);
+    }
+}
+
+/**
+ * Add the given number of capabilities to the working set, every fourth of
+ * which repeats an earlier one. The keys are also appended to \p expected.
+ */
+static status add_capabilities(
+    endorse_working_set* set, vector<endorse_working_set_key>& expected,
+    size_t count)
+{
+    status retval;
+    endorse_working_set_key key;
+    uint32_t seed = 0x5eed;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        memset(&key, 0, sizeof(key));
+        if (i > 0 && 0 == i % 4)
+        {
+            /* repeat an earlier capability. */
+            key = expected[(i * 7) % expected.size()];
+        }
+        else
+        {
+            fill_uuid(&key.object, &seed);
+            fill_uuid(&key.verb, &seed);
+        }
+
+        retval =
+            endorse_working_set_add_verb_capability(
+                set, &key.object, &key.verb);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        expected.push_back(key);
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * Sort and deduplicate the expected keys the way the qsort path does.
+ */
+static void sort_unique(vector<endorse_working_set_key>& keys)
+{
+    size_t out = 0;
+
+    qsort(
+        keys.data(), keys.size(), sizeof(endorse_working_set_key),
+        &endorse_working_set_compare);
+
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        if (0 == out
+         || 0 != endorse_working_set_compare(&keys[out - 1], &keys[i]))
+        {
+            keys[out++] = keys[i];
+        }
+    }
+
+    keys.resize(out);
+}
+
+/**
+ * Return true if the working set holds exactly the given keys, in order.
+ */
+static bool working_set_equals(
+    const endorse_working_set* set,
+    const vector<endorse_working_set_key>& keys)
+{
+    return
+        set->count == keys.size()
+     && !memcmp(
+            set->keys, keys.data(),
+            keys.size() * sizeof(endorse_working_set_key));
+}
+
+/**
+ * Test that the radix sort orders keys, including duplicates, the same way as
+ * qsort with the working set comparison.
+ */
+TEST(radix_sort_matches_qsort)
+{
+    vector<endorse_working_set_key> keys;
+    vector<endorse_working_set_key> expected;
+    vector<endorse_working_set_key> scratch;
+    endorse_working_set_key key;
+    uint32_t seed = 0xfeed;
+
+    /* build keys where some bytes vary and some repeat. */
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        memset(&key, 0, sizeof(key));
+        fill_uuid(&key.object, &seed);
+        key.object.data[0] = (uint8_t)(i % 3);
+        key.verb.data[15] = (uint8_t)(i % 5);
+        keys.push_back(key);
+
+        /* add some exact duplicates. */
+        if (0 == i % 10)
+        {
+            keys.push_back(key);
+        }
+    }
+
+    expected = keys;
+    qsort(
+        expected.data(), expected.size(), sizeof(endorse_working_set_key),
+        &endorse_working_set_compare);
+
+    scratch.resize(keys.size());
+    endorse_working_set_radix_sort(keys.data(), scratch.data(), keys.size());
+
+    TEST_ASSERT(expected.size() == keys.size());
+    TEST_EXPECT(
+        !memcmp(
+            keys.data(), expected.data(),
+            keys.size() * sizeof(endorse_working_set_key)));
+}
+
+/**
+ * Test that finalizing a working set above the radix threshold sorts it and
+ * removes duplicates, just as the qsort path would.
+ */
+TEST(finalize_above_radix_threshold)
+{
+    rcpr_allocator* alloc;
+    endorse_working_set* set;
+    vector<endorse_working_set_key> expected;
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a working set with duplicates above the radix threshold. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_working_set_create(&set, alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            add_capabilities(
+                set, expected, 4 * ENDORSE_WORKING_SET_RADIX_THRESHOLD));
+    TEST_ASSERT(set->count >= ENDORSE_WORKING_SET_RADIX_THRESHOLD);
+
+    /* finalize the set, and compare it against qsort and dedup. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_working_set_finalize(set));
+    sort_unique(expected);
+    TEST_EXPECT(expected.size() < 4 * ENDORSE_WORKING_SET_RADIX_THRESHOLD);
+    TEST_EXPECT(working_set_equals(set, expected));
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&set->hdr));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * Test that finalizing a working set below the radix threshold sorts it and
+ * removes duplicates.
+ */
+TEST(finalize_below_radix_threshold)
+{
+    rcpr_allocator* alloc;
+    endorse_working_set* set;
+    vector<endorse_working_set_key> expected;
+
+    /* create the RCPR malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a working set with duplicates below the radix threshold. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_working_set_create(&set, alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            add_capabilities(
+                set, expected, ENDORSE_WORKING_SET_RADIX_THRESHOLD / 4));
+    TEST_ASSERT(set->count < ENDORSE_WORKING_SET_RADIX_THRESHOLD);
+
+    /* finalize the set, and compare it against qsort and dedup. */
+    TEST_ASSERT(STATUS_SUCCESS == endorse_working_set_finalize(set));
+    sort_unique(expected);
+    TEST_EXPECT(expected.size() < ENDORSE_WORKING_SET_RADIX_THRESHOLD / 4);
+    TEST_EXPECT(working_set_equals(set, expected));
+
+    /* clean up. */
+    TEST_ASSERT(STATUS_SUCCESS == resource_release(&set->hdr));
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -3,9 +3,10 @@
  *
  * \brief Implementation of mock for file I/O.
  *
- * \copyright 2020 Velo Payments.  See License.txt for license terms.
+ * \copyright 2020-2023 Velo Payments.  See License.txt for license terms.
  */
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "mock_file.h"
@@ -19,8 +20,19 @@ static int mock_file_open(file*, int*, const char*, int, mode_t);
 static int mock_file_close(file*, int);
 static int mock_file_read(file*, int, void*, size_t, size_t*);
 static int mock_file_write(file*, int, const void*, size_t, size_t*);
+static int mock_file_writev(file*, int, const struct iovec*, int, size_t*);
 static int mock_file_lseek(file*, int, off_t, file_lseek_whence, off_t*);
 static int mock_file_fsync(file*, int);
+static int mock_file_fstat(file*, int, file_stat_st*);
+static int mock_file_mmap(file*, int, size_t, const void**);
+static int mock_file_munmap(file*, const void*, size_t);
+static int mock_file_ftruncate(file*, int, off_t);
+static int mock_file_mkdir(file*, const char*, mode_t);
+static int mock_file_rename(file*, const char*, const char*);
+static int mock_file_unlink(file*, const char*);
+static int mock_file_opendir(file*, void**, const char*);
+static int mock_file_readdir(file*, void*, const char**);
+static int mock_file_closedir(file*, void*);
 
 /**
  * \brief Stub for stat.
@@ -85,9 +97,79 @@ const function<int (file*, int)> stubfsync =
         return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
     };
 
+/**
+ * \brief Stub for ftruncate.
+ */
+const function<int (file*, int, off_t)> stubftruncate =
+    [](file*, int, off_t)
+    {
+        return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+    };
+
+/**
+ * \brief Stub for mkdir.
+ */
+const function<int (file*, const char*, mode_t)> stubmkdir =
+    [](file*, const char*, mode_t)
+    {
+        return VCTOOL_ERROR_FILE_UNKNOWN;
+    };
+
+/**
+ * \brief Stub for rename.
+ */
+const function<int (file*, const char*, const char*)> stubrename =
+    [](file*, const char*, const char*)
+    {
+        return VCTOOL_ERROR_FILE_UNKNOWN;
+    };
+
+/**
+ * \brief Stub for unlink.
+ */
+const function<int (file*, const char*)> stubunlink =
+    [](file*, const char*)
+    {
+        return VCTOOL_ERROR_FILE_UNKNOWN;
+    };
+
+/**
+ * \brief Stub for opendir.
+ */
+const function<int (file*, void**, const char*)> stubopendir =
+    [](file*, void**, const char*)
+    {
+        return VCTOOL_ERROR_FILE_UNKNOWN;
+    };
+
+/**
+ * \brief Stub for readdir.
+ */
+const function<int (file*, void*, const char**)> stubreaddir =
+    [](file*, void*, const char**)
+    {
+        return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+    };
+
+/**
+ * \brief Stub for closedir.
+ */
+const function<int (file*, void*)> stubclosedir =
+    [](file*, void*)
+    {
+        return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+    };
+
 /**
  * \brief Initialize a mock file interface.
  *
+ * The directory and metadata mocks are optional, and default to stubs. The
+ * remaining methods are built on these mocks. Writev writes each buffer
+ * with the mock write. Fstat runs the mock stat on the path the descriptor was
+ * opened with. Mmap reads the file from offset zero into a heap buffer with the
+ * mock lseek and read, zero filling past the end of the file, and munmap frees
+ * this buffer.
+ *
  * \param f             The file interface to initialize.
  * \param mockstat      The mock stat function.
  * \param mockopen      The mock open function.
@@ -96,6 +178,13 @@ const function<int (file*, int)> stubfsync =
  * \param mockwrite     The mock write function.
  * \param mocklseek     The mock lseek function.
  * \param mockfsync     The mock fsync function.
+ * \param mockftruncate The mock ftruncate function.
+ * \param mockmkdir     The mock mkdir function.
+ * \param mockrename    The mock rename function.
+ * \param mockunlink    The mock unlink function.
+ * \param mockopendir   The mock opendir function.
+ * \param mockreaddir   The mock readdir function.
+ * \param mockclosedir  The mock closedir function.
  *
  * \returns a status code indicating success or failure.
  *      - VCTOOL_STATUS_SUCCESS on success.
@@ -109,7 +198,14 @@ int file_mock_init(
     std::function<int (file*, int, void*, size_t, size_t*)> mockread,
     std::function<int (file*, int, const void*, size_t, size_t*)> mockwrite,
     std::function<int (file*, int, off_t, file_lseek_whence, off_t*)> mocklseek,
-    std::function<int (file*, int)> mockfsync)
+    std::function<int (file*, int)> mockfsync,
+    std::function<int (file*, int, off_t)> mockftruncate,
+    std::function<int (file*, const char*, mode_t)> mockmkdir,
+    std::function<int (file*, const char*, const char*)> mockrename,
+    std::function<int (file*, const char*)> mockunlink,
+    std::function<int (file*, void**, const char*)> mockopendir,
+    std::function<int (file*, void*, const char**)> mockreaddir,
+    std::function<int (file*, void*)> mockclosedir)
 {
     mock_file* ctx = new mock_file;
 
@@ -120,6 +216,13 @@ int file_mock_init(
     ctx->mockwrite = mockwrite;
     ctx->mocklseek = mocklseek;
     ctx->mockfsync = mockfsync;
+    ctx->mockftruncate = mockftruncate;
+    ctx->mockmkdir = mockmkdir;
+    ctx->mockrename = mockrename;
+    ctx->mockunlink = mockunlink;
+    ctx->mockopendir = mockopendir;
+    ctx->mockreaddir = mockreaddir;
+    ctx->mockclosedir = mockclosedir;
 
     memset(f, 0, sizeof(file));
 
@@ -129,8 +232,19 @@ int file_mock_init(
     f->file_close_method = &mock_file_close;
     f->file_read_method = &mock_file_read;
     f->file_write_method = &mock_file_write;
+    f->file_writev_method = &mock_file_writev;
     f->file_lseek_method = &mock_file_lseek;
     f->file_fsync_method = &mock_file_fsync;
+    f->file_fstat_method = &mock_file_fstat;
+    f->file_mmap_method = &mock_file_mmap;
+    f->file_munmap_method = &mock_file_munmap;
+    f->file_ftruncate_method = &mock_file_ftruncate;
+    f->file_mkdir_method = &mock_file_mkdir;
+    f->file_rename_method = &mock_file_rename;
+    f->file_unlink_method = &mock_file_unlink;
+    f->file_opendir_method = &mock_file_opendir;
+    f->file_readdir_method = &mock_file_readdir;
+    f->file_closedir_method = &mock_file_closedir;
     f->context = (void*)ctx;
 
     return VCTOOL_STATUS_SUCCESS;
@@ -165,7 +279,13 @@ static int mock_file_open(
 {
     mock_file* ctx = (mock_file*)f->context;
 
-    return ctx->mockopen(f, d, path, flags, mode);
+    int retval = ctx->mockopen(f, d, path, flags, mode);
+    if (VCTOOL_STATUS_SUCCESS == retval)
+    {
+        ctx->paths[*d] = path;
+    }
+
+    return retval;
 }
 
 /**
@@ -175,6 +295,8 @@ static int mock_file_close(file* f , int d)
 {
     mock_file* ctx = (mock_file*)f->context;
 
+    ctx->paths.erase(d);
+
     return ctx->mockclose(f, d);
 }
 
@@ -199,6 +321,37 @@ static int mock_file_write(
     return ctx->mockwrite(f, d, buf, sz, psz);
 }
 
+/**
+ * \brief Run the mock for this file writev, as one mock write per buffer.
+ */
+static int mock_file_writev(
+    file* f, int d, const struct iovec* iov, int iovcnt, size_t* psz)
+{
+    mock_file* ctx = (mock_file*)f->context;
+    size_t sz;
+    int retval;
+
+    *psz = 0;
+    for (int i = 0; i < iovcnt; ++i)
+    {
+        retval = ctx->mockwrite(f, d, iov[i].iov_base, iov[i].iov_len, &sz);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        *psz += sz;
+
+        /* stop on a short write, like writev. */
+        if (sz != iov[i].iov_len)
+        {
+            break;
+        }
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
 /**
  * \brief Run the mock for this file lseek.
  */
@@ -219,3 +372,147 @@ static int mock_file_fsync(file* f, int d)
 
     return ctx->mockfsync(f, d);
 }
+
+/**
+ * \brief Run the mock stat for the path of this descriptor.
+ */
+static int mock_file_fstat(file* f, int d, file_stat_st* fst)
+{
+    mock_file* ctx = (mock_file*)f->context;
+
+    auto path = ctx->paths.find(d);
+    if (ctx->paths.end() == path)
+    {
+        return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+    }
+
+    return ctx->mockstat(f, path->second.c_str(), fst);
+}
+
+/**
+ * \brief Emulate mmap by reading the file into a heap buffer.
+ */
+static int mock_file_mmap(file* f, int d, size_t size, const void** data)
+{
+    mock_file* ctx = (mock_file*)f->context;
+    off_t newoffset;
+    size_t offset = 0, read_size;
+    int retval;
+
+    /* read from the start of the file. */
+    retval =
+        ctx->mocklseek(f, d, 0, FILE_LSEEK_WHENCE_ABSOLUTE, &newoffset);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* past the end of the file, the mapping is zero filled. */
+    uint8_t* buf = (uint8_t*)calloc(1, size);
+    if (NULL == buf)
+    {
+        return VCTOOL_ERROR_FILE_KERNEL_MEMORY;
+    }
+
+    while (offset < size)
+    {
+        retval =
+            ctx->mockread(f, d, buf + offset, size - offset, &read_size);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            free(buf);
+            return retval;
+        }
+        else if (0 == read_size)
+        {
+            break;
+        }
+
+        offset += read_size;
+    }
+
+    *data = buf;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Free a buffer created by the emulated mmap.
+ */
+static int mock_file_munmap(file*, const void* data, size_t)
+{
+    free((void*)data);
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Run the mock for this file ftruncate.
+ */
+static int mock_file_ftruncate(file* f, int d, off_t length)
+{
+    mock_file* ctx = (mock_file*)f->context;
+
+    return ctx->mockftruncate(f, d, length);
+}
+
+/**
+ * \brief Run the mock for this file mkdir.
+ */
+static int mock_file_mkdir(file* f, const char* path, mode_t mode)
+{
+    mock_file* ctx = (mock_file*)f->context;
+
+    return ctx->mockmkdir(f, path, mode);
+}
+
+/**
+ * \brief Run the mock for this file rename.
+ */
+static int mock_file_rename(
+    file* f, const char* oldpath, const char* newpath)
+{
+    mock_file* ctx = (mock_file*)f->context;
+
+    return ctx->mockrename(f, oldpath, newpath);
+}
+
+/**
+ * \brief Run the mock for this file unlink.
+ */
+static int mock_file_unlink(file* f, const char* path)
+{
+    mock_file* ctx = (mock_file*)f->context;
+
+    return ctx->mockunlink(f, path);
+}
+
+/**
+ * \brief Run the mock for this file opendir.
+ */
+static int mock_file_opendir(file* f, void** dir, const char* path)
+{
+    mock_file* ctx = (mock_file*)f->context;
+
+    return ctx->mockopendir(f, dir, path);
+}
+
+/**
+ * \brief Run the mock for this file readdir.
+ */
+static int mock_file_readdir(file* f, void* dir, const char** name)
+{
+    mock_file* ctx = (mock_file*)f->context;
+
+    return ctx->mockreaddir(f, dir, name);
+}
+
+/**
+ * \brief Run the mock for this file closedir.
+ */
+static int mock_file_closedir(file* f, void* dir)
+{
+    mock_file* ctx = (mock_file*)f->context;
+
+    return ctx->mockclosedir(f, dir);
+}
@@ -3,7 +3,7 @@
  *
  * \brief Mock for file I/O.
  *
- * \copyright 2020 Velo Payments.  See License.txt for license terms.
+ * \copyright 2020-2023 Velo Payments.  See License.txt for license terms.
  */
 
 #ifndef  VCTOOL_TEST_FILE_MOCK_HEADER_GUARD
@@ -17,6 +17,8 @@
 #endif
 
 #include <functional>
+#include <map>
+#include <string>
 
 struct mock_file
 {
@@ -27,6 +29,16 @@ struct mock_file
     std::function<int (file*, int, const void*, size_t, size_t*)> mockwrite;
     std::function<int (file*, int, off_t, file_lseek_whence, off_t*)> mocklseek;
     std::function<int (file*, int)> mockfsync;
+    std::function<int (file*, int, off_t)> mockftruncate;
+    std::function<int (file*, const char*, mode_t)> mockmkdir;
+    std::function<int (file*, const char*, const char*)> mockrename;
+    std::function<int (file*, const char*)> mockunlink;
+    std::function<int (file*, void**, const char*)> mockopendir;
+    std::function<int (file*, void*, const char**)> mockreaddir;
+    std::function<int (file*, void*)> mockclosedir;
+
+    /** \brief The path of each descriptor opened through the mock. */
+    std::map<int, std::string> paths;
 };
 
 extern const
@@ -43,10 +55,31 @@ extern const
 std::function<int (file*, int, off_t, file_lseek_whence, off_t*)> stublseek;
 extern const
 std::function<int (file*, int)> stubfsync;
+extern const
+std::function<int (file*, int, off_t)> stubftruncate;
+extern const
+std::function<int (file*, const char*, mode_t)> stubmkdir;
+extern const
+std::function<int (file*, const char*, const char*)> stubrename;
+extern const
+std::function<int (file*, const char*)> stubunlink;
+extern const
+std::function<int (file*, void**, const char*)> stubopendir;
+extern const
+std::function<int (file*, void*, const char**)> stubreaddir;
+extern const
+std::function<int (file*, void*)> stubclosedir;
 
 /**
  * \brief Initialize a mock file interface.
  *
+ * The directory and metadata mocks are optional, and default to stubs. The
+ * remaining methods are built on these mocks. Writev writes each buffer
+ * with the mock write. Fstat runs the mock stat on the path the descriptor was
+ * opened with. Mmap reads the file from offset zero into a heap buffer with the
+ * mock lseek and read, zero filling past the end of the file, and munmap frees
+ * this buffer.
+ *
  * \param f             The file interface to initialize.
  * \param mockstat      The mock stat function.
  * \param mockopen      The mock open function.
@@ -55,6 +88,13 @@ std::function<int (file*, int)> stubfsync;
  * \param mockwrite     The mock write function.
  * \param mocklseek     The mock lseek function.
  * \param mockfsync     The mock fsync function.
+ * \param mockftruncate The mock ftruncate function.
+ * \param mockmkdir     The mock mkdir function.
+ * \param mockrename    The mock rename function.
+ * \param mockunlink    The mock unlink function.
+ * \param mockopendir   The mock opendir function.
+ * \param mockreaddir   The mock readdir function.
+ * \param mockclosedir  The mock closedir function.
  *
  * \returns a status code indicating success or failure.
  *      - VCTOOL_STATUS_SUCCESS on success.
@@ -68,6 +108,14 @@ int file_mock_init(
     std::function<int (file*, int, void*, size_t, size_t*)> mockread,
     std::function<int (file*, int, const void*, size_t, size_t*)> mockwrite,
     std::function<int (file*, int, off_t, file_lseek_whence, off_t*)> mocklseek,
-    std::function<int (file*, int)> mockfsync);
+    std::function<int (file*, int)> mockfsync,
+    std::function<int (file*, int, off_t)> mockftruncate = stubftruncate,
+    std::function<int (file*, const char*, mode_t)> mockmkdir = stubmkdir,
+    std::function<int (file*, const char*, const char*)> mockrename =
+        stubrename,
+    std::function<int (file*, const char*)> mockunlink = stubunlink,
+    std::function<int (file*, void**, const char*)> mockopendir = stubopendir,
+    std::function<int (file*, void*, const char**)> mockreaddir = stubreaddir,
+    std::function<int (file*, void*)> mockclosedir = stubclosedir);
 
 #endif /*VCTOOL_TEST_FILE_MOCK_HEADER_GUARD*/
@@ -3,11 +3,14 @@
  *
  * \brief Unit tests for file.
  *
- * \copyright 2020 Velo Payments.  See License.txt for license terms.
+ * \copyright 2020-2023 Velo Payments.  See License.txt for license terms.
  */
 
+#include <algorithm>
+#include <fcntl.h>
 #include <minunit/minunit.h>
 #include <string.h>
+#include <string>
 #include <vctool/file.h>
 
 #include "mock_file.h"
@@ -30,8 +33,19 @@ TEST(file_init_basics)
     TEST_EXPECT(nullptr == f.file_close_method);
     TEST_EXPECT(nullptr == f.file_read_method);
     TEST_EXPECT(nullptr == f.file_write_method);
+    TEST_EXPECT(nullptr == f.file_writev_method);
     TEST_EXPECT(nullptr == f.file_lseek_method);
     TEST_EXPECT(nullptr == f.file_fsync_method);
+    TEST_EXPECT(nullptr == f.file_fstat_method);
+    TEST_EXPECT(nullptr == f.file_mmap_method);
+    TEST_EXPECT(nullptr == f.file_munmap_method);
+    TEST_EXPECT(nullptr == f.file_ftruncate_method);
+    TEST_EXPECT(nullptr == f.file_mkdir_method);
+    TEST_EXPECT(nullptr == f.file_rename_method);
+    TEST_EXPECT(nullptr == f.file_unlink_method);
+    TEST_EXPECT(nullptr == f.file_opendir_method);
+    TEST_EXPECT(nullptr == f.file_readdir_method);
+    TEST_EXPECT(nullptr == f.file_closedir_method);
     TEST_EXPECT(nullptr == f.context);
 
     /* initialize should succeed. */
@@ -44,8 +58,19 @@ TEST(file_init_basics)
     TEST_EXPECT(nullptr != f.file_close_method);
     TEST_EXPECT(nullptr != f.file_read_method);
     TEST_EXPECT(nullptr != f.file_write_method);
+    TEST_EXPECT(nullptr != f.file_writev_method);
     TEST_EXPECT(nullptr != f.file_lseek_method);
     TEST_EXPECT(nullptr != f.file_fsync_method);
+    TEST_EXPECT(nullptr != f.file_fstat_method);
+    TEST_EXPECT(nullptr != f.file_mmap_method);
+    TEST_EXPECT(nullptr != f.file_munmap_method);
+    TEST_EXPECT(nullptr != f.file_ftruncate_method);
+    TEST_EXPECT(nullptr != f.file_mkdir_method);
+    TEST_EXPECT(nullptr != f.file_rename_method);
+    TEST_EXPECT(nullptr != f.file_unlink_method);
+    TEST_EXPECT(nullptr != f.file_opendir_method);
+    TEST_EXPECT(nullptr != f.file_readdir_method);
+    TEST_EXPECT(nullptr != f.file_closedir_method);
     TEST_EXPECT(nullptr == f.context);
 
     /* dispose the file interface. */
@@ -71,8 +96,19 @@ TEST(file_mock_init)
     TEST_EXPECT(nullptr == f.file_close_method);
     TEST_EXPECT(nullptr == f.file_read_method);
     TEST_EXPECT(nullptr == f.file_write_method);
+    TEST_EXPECT(nullptr == f.file_writev_method);
     TEST_EXPECT(nullptr == f.file_lseek_method);
     TEST_EXPECT(nullptr == f.file_fsync_method);
+    TEST_EXPECT(nullptr == f.file_fstat_method);
+    TEST_EXPECT(nullptr == f.file_mmap_method);
+    TEST_EXPECT(nullptr == f.file_munmap_method);
+    TEST_EXPECT(nullptr == f.file_ftruncate_method);
+    TEST_EXPECT(nullptr == f.file_mkdir_method);
+    TEST_EXPECT(nullptr == f.file_rename_method);
+    TEST_EXPECT(nullptr == f.file_unlink_method);
+    TEST_EXPECT(nullptr == f.file_opendir_method);
+    TEST_EXPECT(nullptr == f.file_readdir_method);
+    TEST_EXPECT(nullptr == f.file_closedir_method);
     TEST_EXPECT(nullptr == f.context);
 
     /* initialize should succeed. */
@@ -89,8 +125,19 @@ TEST(file_mock_init)
     TEST_EXPECT(nullptr != f.file_close_method);
     TEST_EXPECT(nullptr != f.file_read_method);
     TEST_EXPECT(nullptr != f.file_write_method);
+    TEST_EXPECT(nullptr != f.file_writev_method);
     TEST_EXPECT(nullptr != f.file_lseek_method);
     TEST_EXPECT(nullptr != f.file_fsync_method);
+    TEST_EXPECT(nullptr != f.file_fstat_method);
+    TEST_EXPECT(nullptr != f.file_mmap_method);
+    TEST_EXPECT(nullptr != f.file_munmap_method);
+    TEST_EXPECT(nullptr != f.file_ftruncate_method);
+    TEST_EXPECT(nullptr != f.file_mkdir_method);
+    TEST_EXPECT(nullptr != f.file_rename_method);
+    TEST_EXPECT(nullptr != f.file_unlink_method);
+    TEST_EXPECT(nullptr != f.file_opendir_method);
+    TEST_EXPECT(nullptr != f.file_readdir_method);
+    TEST_EXPECT(nullptr != f.file_closedir_method);
     TEST_EXPECT(nullptr != f.context);
 
     /* calling file_stat returns VCTOOL_ERROR_FILE_UNKNOWN. */
@@ -356,6 +403,51 @@ TEST(file_write)
     dispose((disposable_t*)&f);
 }
 
+/* file_writev writes each buffer in order through the mock write. */
+TEST(file_writev)
+{
+    file f;
+    int EXPECTED_DESCRIPTOR = 993;
+    char buffer0[] = "abc";
+    char buffer1[] = "defgh";
+    struct iovec iov[2] = {
+        { buffer0, 3 },
+        { buffer1, 5 } };
+    size_t wbytes = 0;
+    std::string got;
+    int write_count = 0;
+
+    /* mock write. */
+    auto writemock = [&](
+        file*, int d, const void* buf, size_t max, size_t* wbytes)
+    {
+        TEST_EXPECT(EXPECTED_DESCRIPTOR == d);
+        got.append((const char*)buf, max);
+        *wbytes = max;
+        ++write_count;
+
+        return VCTOOL_STATUS_SUCCESS;
+    };
+
+    /* initialize should succeed. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_mock_init(
+                &f, stubstat, stubopen, stubclose, stubread, writemock,
+                stublseek, stubfsync));
+
+    /* both buffers are written in order. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_writev(&f, EXPECTED_DESCRIPTOR, iov, 2, &wbytes));
+    TEST_EXPECT(8U == wbytes);
+    TEST_EXPECT(2 == write_count);
+    TEST_EXPECT(got == "abcdefgh");
+
+    /* dispose the file interface. */
+    dispose((disposable_t*)&f);
+}
+
 /* file_lseek passes all parameters and returns the value of its impl. */
 TEST(file_lseek)
 {
@@ -447,3 +539,297 @@ TEST(file_fsync)
     /* dispose the file interface. */
     dispose((disposable_t*)&f);
 }
+
+/* file_fstat runs the mock stat on the path of an open descriptor. */
+TEST(file_fstat)
+{
+    file f;
+    int EXPECTED_DESCRIPTOR = 993;
+    const char* EXPECTED_PATH = "./test.txt";
+    int d = -1;
+    file_stat_st fst;
+    std::string got_path;
+
+    /* mock stat. */
+    auto statmock = [&](file*, const char* path, file_stat_st* filestat)
+    {
+        got_path = path;
+        filestat->fst_size = 12;
+
+        return VCTOOL_STATUS_SUCCESS;
+    };
+
+    /* mock open. */
+    auto openmock = [&](file*, int* d, const char*, int, mode_t)
+    {
+        *d = EXPECTED_DESCRIPTOR;
+
+        return VCTOOL_STATUS_SUCCESS;
+    };
+
+    /* mock close. */
+    auto closemock = [&](file*, int)
+    {
+        return VCTOOL_STATUS_SUCCESS;
+    };
+
+    /* initialize should succeed. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_mock_init(
+                &f, statmock, openmock, closemock, stubread, stubwrite,
+                stublseek, stubfsync));
+
+    /* an unknown descriptor is bad. */
+    TEST_EXPECT(
+        VCTOOL_ERROR_FILE_BAD_DESCRIPTOR ==
+            file_fstat(&f, EXPECTED_DESCRIPTOR, &fst));
+
+    /* once opened, the descriptor is stat'd by path. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_open(&f, &d, EXPECTED_PATH, O_RDONLY, 0));
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == file_fstat(&f, d, &fst));
+    TEST_EXPECT(got_path == EXPECTED_PATH);
+    TEST_EXPECT(12 == fst.fst_size);
+
+    /* after close, the descriptor is bad again. */
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == file_close(&f, d));
+    TEST_EXPECT(VCTOOL_ERROR_FILE_BAD_DESCRIPTOR == file_fstat(&f, d, &fst));
+
+    /* dispose the file interface. */
+    dispose((disposable_t*)&f);
+}
+
+/* file_map_contents maps a whole file, and doesn't map an empty one. */
+TEST(file_map_contents)
+{
+    file f;
+    std::string contents = "the contents of the file";
+    size_t offset = 0;
+    int open_count = 0, close_count = 0;
+    const void* data;
+    size_t size;
+
+    /* mock stat. */
+    auto statmock = [&](file*, const char*, file_stat_st* filestat)
+    {
+        memset(filestat, 0, sizeof(*filestat));
+        filestat->fst_mode = S_IFREG | S_IRUSR;
+        filestat->fst_size = contents.size();
+
+        return VCTOOL_STATUS_SUCCESS;
+    };
+
+    /* mock open. */
+    auto openmock = [&](file*, int* d, const char*, int flags, mode_t)
+    {
+        TEST_EXPECT(O_RDONLY == flags);
+        *d = 10 + open_count++;
+
+        return VCTOOL_STATUS_SUCCESS;
+    };
+
+    /* mock close. */
+    auto closemock = [&](file*, int)
+    {
+        ++close_count;
+
+        return VCTOOL_STATUS_SUCCESS;
+    };
+
+    /* mock read, in small pieces. */
+    auto readmock = [&](file*, int, void* buf, size_t max, size_t* rbytes)
+    {
+        *rbytes = std::min(std::min(max, (size_t)5), contents.size() - offset);
+        memcpy(buf, contents.data() + offset, *rbytes);
+        offset += *rbytes;
+
+        return VCTOOL_STATUS_SUCCESS;
+    };
+
+    /* mock lseek. */
+    auto lseekmock = [&](
+        file*, int, off_t pos, file_lseek_whence whence, off_t* newoffset)
+    {
+        TEST_EXPECT(FILE_LSEEK_WHENCE_ABSOLUTE == whence);
+        offset = pos;
+        *newoffset = pos;
+
+        return VCTOOL_STATUS_SUCCESS;
+    };
+
+    /* initialize should succeed. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_mock_init(
+                &f, statmock, openmock, closemock, readmock, stubwrite,
+                lseekmock, stubfsync));
+
+    /* the whole file is mapped, and the descriptor is closed. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_map_contents(&f, "test.txt", &data, &size));
+    TEST_ASSERT(nullptr != data);
+    TEST_ASSERT(contents.size() == size);
+    TEST_EXPECT(0 == memcmp(data, contents.data(), size));
+    TEST_EXPECT(1 == close_count);
+    TEST_EXPECT(VCTOOL_STATUS_SUCCESS == file_munmap(&f, data, size));
+
+    /* an empty file is not mapped. */
+    contents.clear();
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_map_contents(&f, "test.txt", &data, &size));
+    TEST_EXPECT(nullptr == data);
+    TEST_EXPECT(0U == size);
+    TEST_EXPECT(2 == close_count);
+
+    /* dispose the file interface. */
+    dispose((disposable_t*)&f);
+}
+
+/* the metadata methods pass all parameters and return the value of the mock. */
+TEST(file_metadata)
+{
+    file f;
+    int EXPECTED_DESCRIPTOR = 993;
+    int EXPECTED_RETURN_CODE = 27;
+    std::string got;
+
+    auto ftruncatemock = [&](file*, int d, off_t length)
+    {
+        got = "ftruncate " + std::to_string(d) + " " + std::to_string(length);
+        return EXPECTED_RETURN_CODE;
+    };
+
+    auto mkdirmock = [&](file*, const char* path, mode_t mode)
+    {
+        got = std::string("mkdir ") + path + " " + std::to_string(mode);
+        return EXPECTED_RETURN_CODE;
+    };
+
+    auto renamemock = [&](file*, const char* oldpath, const char* newpath)
+    {
+        got = std::string("rename ") + oldpath + " " + newpath;
+        return EXPECTED_RETURN_CODE;
+    };
+
+    auto unlinkmock = [&](file*, const char* path)
+    {
+        got = std::string("unlink ") + path;
+        return EXPECTED_RETURN_CODE;
+    };
+
+    /* initialize should succeed. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_mock_init(
+                &f, stubstat, stubopen, stubclose, stubread, stubwrite,
+                stublseek, stubfsync, ftruncatemock, mkdirmock, renamemock,
+                unlinkmock));
+
+    TEST_EXPECT(
+        EXPECTED_RETURN_CODE == file_ftruncate(&f, EXPECTED_DESCRIPTOR, 40));
+    TEST_EXPECT(got == "ftruncate 993 40");
+    TEST_EXPECT(EXPECTED_RETURN_CODE == file_mkdir(&f, "dir", 0700));
+    TEST_EXPECT(got == "mkdir dir 448");
+    TEST_EXPECT(EXPECTED_RETURN_CODE == file_rename(&f, "a", "b"));
+    TEST_EXPECT(got == "rename a b");
+    TEST_EXPECT(EXPECTED_RETURN_CODE == file_unlink(&f, "a"));
+    TEST_EXPECT(got == "unlink a");
+
+    /* dispose the file interface. */
+    dispose((disposable_t*)&f);
+}
+
+/* the directory methods pass the handle from opendir to readdir and close. */
+TEST(file_directory)
+{
+    file f;
+    int handle;
+    void* dir = nullptr;
+    const char* name;
+    const char* names[] = { "a", "b" };
+    size_t next = 0;
+    bool closed = false;
+
+    auto opendirmock = [&](file*, void** dir, const char* path)
+    {
+        TEST_EXPECT(std::string("blocks") == path);
+        *dir = &handle;
+        return VCTOOL_STATUS_SUCCESS;
+    };
+
+    auto readdirmock = [&](file*, void* dir, const char** name)
+    {
+        TEST_EXPECT(&handle == dir);
+        *name = (next < 2) ? names[next++] : nullptr;
+        return VCTOOL_STATUS_SUCCESS;
+    };
+
+    auto closedirmock = [&](file*, void* dir)
+    {
+        TEST_EXPECT(&handle == dir);
+        closed = true;
+        return VCTOOL_STATUS_SUCCESS;
+    };
+
+    /* initialize should succeed. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_mock_init(
+                &f, stubstat, stubopen, stubclose, stubread, stubwrite,
+                stublseek, stubfsync, stubftruncate, stubmkdir, stubrename,
+                stubunlink, opendirmock, readdirmock, closedirmock));
+
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == file_opendir(&f, &dir, "blocks"));
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == file_readdir(&f, dir, &name));
+    TEST_EXPECT(std::string("a") == name);
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == file_readdir(&f, dir, &name));
+    TEST_EXPECT(std::string("b") == name);
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == file_readdir(&f, dir, &name));
+    TEST_EXPECT(nullptr == name);
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == file_closedir(&f, dir));
+    TEST_EXPECT(closed);
+
+    /* dispose the file interface. */
+    dispose((disposable_t*)&f);
+}
+
+/* the OS directory methods list a real directory. */
+TEST(file_os_directory)
+{
+    file f;
+    void* dir;
+    const char* name;
+    bool found_self = false;
+    bool found_parent = false;
+
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == file_init(&f));
+
+    /* a missing directory is reported. */
+    TEST_EXPECT(
+        VCTOOL_ERROR_FILE_NO_ENTRY ==
+            file_opendir(&f, &dir, "/nonexistent/directory"));
+
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == file_opendir(&f, &dir, "."));
+    for (;;)
+    {
+        TEST_ASSERT(VCTOOL_STATUS_SUCCESS == file_readdir(&f, dir, &name));
+        if (nullptr == name)
+        {
+            break;
+        }
+
+        found_self = found_self || !strcmp(name, ".");
+        found_parent = found_parent || !strcmp(name, "..");
+    }
+
+    TEST_EXPECT(found_self);
+    TEST_EXPECT(found_parent);
+    TEST_EXPECT(VCTOOL_STATUS_SUCCESS == file_closedir(&f, dir));
+
+    /* dispose the file interface. */
+    dispose((disposable_t*)&f);
+}
@@ -0,0 +1,600 @@
+/**
+ * \file test/history/test_history_walk.cpp
+ *
+ * \brief Unit tests for history_walk against the mock agent.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cstring>
+#include <limits.h>
+#include <minunit/minunit.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vccrypt/suite.h>
+#include <vctool/agent.h>
+#include <vctool/status_codes.h>
+#include <vector>
+#include <vpr/allocator/malloc_allocator.h>
+
+#include "../../src/command/history/history_internal.h"
+#include "../../src/command/mock_agent/mock_agent_internal.h"
+#include "../../src/lib/agent/agent_internal.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/* start of the history_walk test suite. */
+TEST_SUITE(history_walk);
+
+/**
+ * \brief Generate a key agreement keypair.
+ */
+static bool make_keypair(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* priv,
+    vccrypt_buffer_t* pub)
+{
+    vccrypt_key_agreement_context_t agreement;
+    bool result = false;
+
+    if (VCCRYPT_STATUS_SUCCESS !=
+            vccrypt_suite_cipher_key_agreement_init(suite, &agreement))
+    {
+        return false;
+    }
+
+    if (VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_buffer_init_for_cipher_key_agreement_private_key(
+                suite, priv)
+     && VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_buffer_init_for_cipher_key_agreement_public_key(
+                suite, pub))
+    {
+        result =
+            VCCRYPT_STATUS_SUCCESS ==
+                vccrypt_key_agreement_keypair_create(&agreement, priv, pub);
+    }
+
+    dispose((disposable_t*)&agreement);
+
+    return result;
+}
+
+/**
+ * \brief A client and an agent, each with their own keys and the other's
+ * public key, and the files they share.
+ */
+struct agent_pair
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    rcpr_allocator* alloc;
+    vccrypt_buffer_t client_pub;
+    vccrypt_buffer_t agent_pub;
+    agent_keys client_keys;
+    agent_keys server_keys;
+    file f;
+    commandline_opts opts;
+};
+
+/**
+ * \brief Create the keys for a client and an agent.
+ */
+static bool agent_pair_init(agent_pair* pair)
+{
+    memset(pair, 0, sizeof(*pair));
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&pair->alloc_opts);
+
+    if (VCCRYPT_STATUS_SUCCESS !=
+            vccrypt_suite_options_init(
+                &pair->suite, &pair->alloc_opts, VCCRYPT_SUITE_VELO_V1)
+     || STATUS_SUCCESS != rcpr_malloc_allocator_create(&pair->alloc)
+     || VCTOOL_STATUS_SUCCESS != file_init(&pair->f)
+     || !make_keypair(
+            &pair->suite, &pair->client_keys.local_private_key,
+            &pair->client_pub)
+     || !make_keypair(
+            &pair->suite, &pair->server_keys.local_private_key,
+            &pair->agent_pub))
+    {
+        return false;
+    }
+
+    /* only the file interface and suite are used from the options. */
+    pair->opts.file = &pair->f;
+    pair->opts.suite = &pair->suite;
+
+    /* each side expects the other's id and public key. */
+    memset(&pair->client_keys.local_id, 0x11, sizeof(rcpr_uuid));
+    memset(&pair->server_keys.local_id, 0x22, sizeof(rcpr_uuid));
+    pair->client_keys.peer_id = pair->server_keys.local_id;
+    pair->server_keys.peer_id = pair->client_keys.local_id;
+
+    return
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_buffer_init(
+                &pair->client_keys.peer_public_key, &pair->alloc_opts,
+                pair->agent_pub.size)
+     && VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_buffer_copy(
+                &pair->client_keys.peer_public_key, &pair->agent_pub)
+     && VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_buffer_init(
+                &pair->server_keys.peer_public_key, &pair->alloc_opts,
+                pair->client_pub.size)
+     && VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_buffer_copy(
+                &pair->server_keys.peer_public_key, &pair->client_pub);
+}
+
+/**
+ * \brief Dispose of the keys for a client and an agent.
+ */
+static void agent_pair_dispose(agent_pair* pair)
+{
+    agent_keys_dispose(&pair->client_keys);
+    agent_keys_dispose(&pair->server_keys);
+    dispose((disposable_t*)&pair->client_pub);
+    dispose((disposable_t*)&pair->agent_pub);
+    dispose((disposable_t*)&pair->f);
+    resource_release(rcpr_allocator_resource_handle(pair->alloc));
+    dispose((disposable_t*)&pair->suite);
+    dispose((disposable_t*)&pair->alloc_opts);
+}
+
+/**
+ * \brief Make a transaction id from an artifact number and a sequence number.
+ */
+static vector<uint8_t> make_id(uint8_t artifact, uint8_t seq)
+{
+    vector<uint8_t> id(TRANSACTION_ID_SIZE, 0x5A);
+
+    id[0] = artifact;
+    id[1] = seq;
+
+    return id;
+}
+
+/**
+ * \brief Append a field to a certificate.
+ */
+static void add_field(
+    vector<uint8_t>* cert, uint16_t type, const uint8_t* value, uint16_t size)
+{
+    cert->push_back((uint8_t)(type >> 8));
+    cert->push_back((uint8_t)(type & 0xFF));
+    cert->push_back((uint8_t)(size >> 8));
+    cert->push_back((uint8_t)(size & 0xFF));
+    cert->insert(cert->end(), value, value + size);
+}
+
+/**
+ * \brief Make a transaction of an artifact with the given ids.
+ */
+static vector<uint8_t> make_txn(
+    const vector<uint8_t>& artifact_id, const vector<uint8_t>& txn_id,
+    const vector<uint8_t>& prev_id)
+{
+    const uint8_t signature[] = { 0xAA, 0xBB };
+    vector<uint8_t> cert;
+
+    add_field(&cert, 0x0001, artifact_id.data(), TRANSACTION_ID_SIZE);
+    add_field(&cert, 0x000D, txn_id.data(), TRANSACTION_ID_SIZE);
+    add_field(&cert, 0x000E, prev_id.data(), TRANSACTION_ID_SIZE);
+    add_field(&cert, 0x0008, signature, sizeof(signature));
+
+    return cert;
+}
+
+/**
+ * \brief The transactions served by the mock agent: artifact A, whose history
+ * is queried, interleaved with artifact B.
+ */
+struct history_fixture
+{
+    string dir;
+    string txns_path;
+    string cache_dir;
+    vector<uint8_t> artifact_a;
+    vector<uint8_t> artifact_b;
+    vector<vector<uint8_t>> ids_a;
+    vector<vector<uint8_t>> certs_a;
+    vector<uint8_t> stream;
+};
+
+/**
+ * \brief Append a transaction of each artifact to the history.
+ */
+static void fixture_add(history_fixture* fix)
+{
+    vector<uint8_t> zero(TRANSACTION_ID_SIZE, 0);
+    uint8_t seq = (uint8_t)fix->ids_a.size();
+
+    vector<uint8_t> id = make_id(0xA0, seq);
+    vector<uint8_t> cert =
+        make_txn(fix->artifact_a, id, seq ? fix->ids_a.back() : zero);
+    fix->ids_a.push_back(id);
+    fix->certs_a.push_back(cert);
+    fix->stream.insert(fix->stream.end(), cert.begin(), cert.end());
+
+    vector<uint8_t> other =
+        make_txn(
+            fix->artifact_b, make_id(0xB0, seq),
+            seq ? make_id(0xB0, (uint8_t)(seq - 1)) : zero);
+    fix->stream.insert(fix->stream.end(), other.begin(), other.end());
+}
+
+/**
+ * \brief Write the transactions served by the mock agent.
+ */
+static bool fixture_write(history_fixture* fix)
+{
+    FILE* out = fopen(fix->txns_path.c_str(), "wb");
+    if (NULL == out)
+    {
+        return false;
+    }
+
+    bool result =
+        fix->stream.size()
+            == fwrite(fix->stream.data(), 1, fix->stream.size(), out);
+
+    return 0 == fclose(out) && result;
+}
+
+/**
+ * \brief Create a temporary directory with an empty cache and the given number
+ * of transactions of each artifact.
+ */
+static bool fixture_init(history_fixture* fix, size_t count)
+{
+    char dirname[] = "/tmp/history_XXXXXX";
+
+    if (NULL == mkdtemp(dirname))
+    {
+        return false;
+    }
+
+    fix->dir = dirname;
+    fix->txns_path = fix->dir + "/txns.cert";
+    fix->cache_dir = fix->dir + "/cache";
+    fix->artifact_a.assign(TRANSACTION_ID_SIZE, 0xAA);
+    fix->artifact_b.assign(TRANSACTION_ID_SIZE, 0xBB);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        fixture_add(fix);
+    }
+
+    return
+        0 == mkdir(fix->cache_dir.c_str(), 0700) && fixture_write(fix);
+}
+
+/**
+ * \brief Remove the temporary directory.
+ */
+static void fixture_dispose(history_fixture* fix)
+{
+    string command = "rm -rf " + fix->dir;
+
+    (void)system(command.c_str());
+}
+
+/**
+ * \brief Get the cache path of a transaction.
+ */
+static string cache_path(
+    const history_fixture* fix, const vector<uint8_t>& id)
+{
+    char path[PATH_MAX];
+
+    if (VCTOOL_STATUS_SUCCESS !=
+            history_cache_path(
+                path, sizeof(path), fix->cache_dir.c_str(), id.data(), false))
+    {
+        return string();
+    }
+
+    return path;
+}
+
+/**
+ * \brief Read a whole file, returning an empty vector if it can't be read.
+ */
+static vector<uint8_t> read_file(const string& path)
+{
+    vector<uint8_t> contents;
+    uint8_t buffer[256];
+    size_t size;
+
+    FILE* in = fopen(path.c_str(), "rb");
+    if (NULL == in)
+    {
+        return contents;
+    }
+
+    while (0 < (size = fread(buffer, 1, sizeof(buffer), in)))
+    {
+        contents.insert(contents.end(), buffer, buffer + size);
+    }
+
+    fclose(in);
+
+    return contents;
+}
+
+/**
+ * \brief Write a whole file, replacing it if it exists.
+ */
+static bool write_file(const string& path, const vector<uint8_t>& contents)
+{
+    FILE* out = fopen(path.c_str(), "wb");
+    if (NULL == out)
+    {
+        return false;
+    }
+
+    bool result =
+        contents.size() == fwrite(contents.data(), 1, contents.size(), out);
+
+    return 0 == fclose(out) && result;
+}
+
+/**
+ * \brief The outcome of a history query.
+ */
+struct walk_result
+{
+    int status;
+    vector<vector<uint8_t>> ids;
+    size_t fetched;
+    size_t cached;
+    bool agent_succeeded;
+};
+
+/**
+ * \brief Query the history of artifact A from a mock agent serving the
+ * fixture transactions, in a child process on one end of a socket pair.
+ */
+static walk_result walk(agent_pair* pair, const history_fixture* fix)
+{
+    walk_result result;
+    agent_connection conn;
+    history_state state;
+    int fds[2], wstatus;
+
+    result.status = VCTOOL_ERROR_AGENT_IO;
+    result.fetched = result.cached = 0;
+    result.agent_succeeded = false;
+
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, fds))
+    {
+        return result;
+    }
+
+    pid_t pid = fork();
+    if (0 == pid)
+    {
+        mock_agent agent;
+
+        close(fds[0]);
+        memset(&agent, 0, sizeof(agent));
+
+        int retval =
+            mock_agent_load_transactions(
+                &agent, &pair->opts, fix->txns_path.c_str());
+        if (VCTOOL_STATUS_SUCCESS == retval)
+        {
+            retval =
+                agent_connection_init(
+                    &conn, pair->alloc, &pair->suite, fds[1]);
+        }
+
+        if (VCTOOL_STATUS_SUCCESS == retval)
+        {
+            retval = mock_agent_handshake(&conn, &pair->server_keys);
+            if (VCTOOL_STATUS_SUCCESS == retval)
+            {
+                retval = mock_agent_serve(&agent, &conn);
+            }
+
+            agent_connection_dispose(&conn);
+        }
+
+        mock_agent_dispose(&agent);
+        _exit(VCTOOL_STATUS_SUCCESS == retval ? 0 : 1);
+    }
+
+    close(fds[1]);
+    if (pid < 0)
+    {
+        close(fds[0]);
+        return result;
+    }
+
+    result.status =
+        agent_connection_init(&conn, pair->alloc, &pair->suite, fds[0]);
+    if (VCTOOL_STATUS_SUCCESS != result.status)
+    {
+        close(fds[0]);
+    }
+    else
+    {
+        result.status = agent_connection_handshake(&conn, &pair->client_keys);
+        if (VCTOOL_STATUS_SUCCESS == result.status)
+        {
+            memset(&state, 0, sizeof(state));
+            state.opts = &pair->opts;
+            state.conn = &conn;
+            state.cache_dir = fix->cache_dir.c_str();
+            memcpy(
+                state.artifact_id, fix->artifact_a.data(),
+                TRANSACTION_ID_SIZE);
+
+            result.status = history_walk(&state);
+            for (size_t i = 0; i < state.count; ++i)
+            {
+                const uint8_t* id = state.ids + i * TRANSACTION_ID_SIZE;
+                result.ids.push_back(
+                    vector<uint8_t>(id, id + TRANSACTION_ID_SIZE));
+            }
+
+            result.fetched = state.fetched;
+            result.cached = state.cached;
+            free(state.ids);
+        }
+
+        agent_connection_dispose(&conn);
+    }
+
+    result.agent_succeeded =
+        pid == waitpid(pid, &wstatus, 0)
+     && WIFEXITED(wstatus) && 0 == WEXITSTATUS(wstatus);
+
+    return result;
+}
+
+/**
+ * \brief Check that a walk found the whole history of artifact A, newest
+ * first.
+ */
+static bool found_history(
+    const walk_result& result, const history_fixture* fix)
+{
+    if (result.ids.size() != fix->ids_a.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < result.ids.size(); ++i)
+    {
+        if (result.ids[i] != fix->ids_a[fix->ids_a.size() - 1 - i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* A cold walk fetches every transaction and caches it; a warm walk reads
+ * every transaction from the cache. */
+TEST(cold_then_warm)
+{
+    agent_pair pair;
+    history_fixture fix;
+
+    TEST_ASSERT(agent_pair_init(&pair));
+    TEST_ASSERT(fixture_init(&fix, 6));
+
+    walk_result cold = walk(&pair, &fix);
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == cold.status);
+    TEST_EXPECT(cold.agent_succeeded);
+    TEST_EXPECT(found_history(cold, &fix));
+    TEST_EXPECT(6U == cold.fetched);
+    TEST_EXPECT(0U == cold.cached);
+
+    /* every fetched transaction is in the cache. */
+    for (size_t i = 0; i < fix.ids_a.size(); ++i)
+    {
+        TEST_EXPECT(
+            fix.certs_a[i] == read_file(cache_path(&fix, fix.ids_a[i])));
+    }
+
+    walk_result warm = walk(&pair, &fix);
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == warm.status);
+    TEST_EXPECT(warm.agent_succeeded);
+    TEST_EXPECT(found_history(warm, &fix));
+    TEST_EXPECT(0U == warm.fetched);
+    TEST_EXPECT(warm.ids.size() == warm.cached);
+
+    fixture_dispose(&fix);
+    agent_pair_dispose(&pair);
+}
+
+/* Only the transactions missing from the cache are fetched: the ones added
+ * since the last walk, and one removed from the cache. */
+TEST(cache_hit_and_miss)
+{
+    agent_pair pair;
+    history_fixture fix;
+
+    TEST_ASSERT(agent_pair_init(&pair));
+    TEST_ASSERT(fixture_init(&fix, 4));
+
+    walk_result first = walk(&pair, &fix);
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == first.status);
+    TEST_EXPECT(4U == first.fetched);
+
+    /* two transactions are added, and one cached transaction is lost. */
+    fixture_add(&fix);
+    fixture_add(&fix);
+    TEST_ASSERT(fixture_write(&fix));
+    TEST_ASSERT(0 == unlink(cache_path(&fix, fix.ids_a[1]).c_str()));
+
+    walk_result second = walk(&pair, &fix);
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == second.status);
+    TEST_EXPECT(second.agent_succeeded);
+    TEST_EXPECT(found_history(second, &fix));
+    TEST_EXPECT(3U == second.fetched);
+    TEST_EXPECT(3U == second.cached);
+    TEST_EXPECT(fix.certs_a[1] == read_file(cache_path(&fix, fix.ids_a[1])));
+
+    fixture_dispose(&fix);
+    agent_pair_dispose(&pair);
+}
+
+/* A damaged cache entry, or one holding another transaction or a transaction
+ * of another artifact, is a miss, and is replaced by the fetched
+ * transaction. */
+TEST(damaged_or_misplaced_entry)
+{
+    agent_pair pair;
+    history_fixture fix;
+
+    TEST_ASSERT(agent_pair_init(&pair));
+    TEST_ASSERT(fixture_init(&fix, 5));
+
+    walk_result first = walk(&pair, &fix);
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == first.status);
+    TEST_EXPECT(5U == first.fetched);
+
+    /* a transaction cut off in its transaction id. */
+    vector<uint8_t> damaged(
+        fix.certs_a[0].begin(), fix.certs_a[0].begin() + 30);
+    TEST_ASSERT(write_file(cache_path(&fix, fix.ids_a[0]), damaged));
+
+    /* the next transaction, stored under the id of this one. */
+    TEST_ASSERT(write_file(cache_path(&fix, fix.ids_a[2]), fix.certs_a[3]));
+
+    /* a transaction with this id, but of another artifact. */
+    TEST_ASSERT(
+        write_file(
+            cache_path(&fix, fix.ids_a[4]),
+            make_txn(fix.artifact_b, fix.ids_a[4], fix.ids_a[3])));
+
+    walk_result second = walk(&pair, &fix);
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == second.status);
+    TEST_EXPECT(second.agent_succeeded);
+    TEST_EXPECT(found_history(second, &fix));
+    TEST_EXPECT(3U == second.fetched);
+    TEST_EXPECT(2U == second.cached);
+
+    /* every entry holds its own transaction again. */
+    for (size_t i = 0; i < fix.ids_a.size(); ++i)
+    {
+        TEST_EXPECT(
+            fix.certs_a[i] == read_file(cache_path(&fix, fix.ids_a[i])));
+    }
+
+    fixture_dispose(&fix);
+    agent_pair_dispose(&pair);
+}
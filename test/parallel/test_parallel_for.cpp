@@ -0,0 +1,59 @@
+/**
+ * \file test/parallel/test_parallel_for.cpp
+ *
+ * \brief Unit tests for parallel_for.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <minunit/minunit.h>
+#include <vctool/parallel.h>
+#include <vctool/status_codes.h>
+#include <vector>
+
+using namespace std;
+
+/* start of the parallel_for test suite. */
+TEST_SUITE(parallel_for);
+
+/**
+ * \brief Count the number of times each job is run.
+ */
+static void count_job(void* context, size_t index)
+{
+    auto counts = (vector<unsigned int>*)context;
+
+    __atomic_fetch_add(&(*counts)[index], 1U, __ATOMIC_RELAXED);
+}
+
+/* The worker count is bounded by the number of jobs. */
+TEST(parallel_worker_count_bounds)
+{
+    TEST_EXPECT(0U == parallel_worker_count(0));
+    TEST_EXPECT(1U == parallel_worker_count(1));
+    TEST_EXPECT(parallel_worker_count(1000) >= 1U);
+    TEST_EXPECT(parallel_worker_count(1000) <= PARALLEL_MAX_WORKERS);
+}
+
+/* Running zero jobs succeeds and does nothing. */
+TEST(no_jobs)
+{
+    vector<unsigned int> counts;
+
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == parallel_for(0, &count_job, &counts));
+}
+
+/* Every job is run exactly once. */
+TEST(every_job_run_once)
+{
+    const size_t JOB_COUNT = 10000;
+    vector<unsigned int> counts(JOB_COUNT, 0U);
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS == parallel_for(JOB_COUNT, &count_job, &counts));
+
+    for (size_t i = 0; i < JOB_COUNT; ++i)
+    {
+        TEST_EXPECT(1U == counts[i]);
+    }
+}
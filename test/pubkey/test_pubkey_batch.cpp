@@ -0,0 +1,331 @@
+/**
+ * \file test/pubkey/test_pubkey_batch.cpp
+ *
+ * \brief Unit tests for the pubkey batch.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <atomic>
+#include <minunit/minunit.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <vccrypt/suite.h>
+#include <vpr/allocator/malloc_allocator.h>
+
+#include "../../src/command/pubkey/pubkey_internal.h"
+#include "../file/mock_file.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_rbtree;
+RCPR_IMPORT_resource;
+
+/* start of the pubkey_batch test suite. */
+TEST_SUITE(pubkey_batch);
+
+/** \brief The number of key derivation rounds used by these tests. */
+#define TEST_ROUNDS 10
+
+/**
+ * Initialize a buffer with the given string.
+ */
+static int string_buffer_init(
+    vccrypt_buffer_t* buffer, allocator_options_t* alloc_opts,
+    const char* str)
+{
+    int retval;
+
+    retval = vccrypt_buffer_init(buffer, alloc_opts, strlen(str));
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memcpy(buffer->data, str, buffer->size);
+
+    return VCCRYPT_STATUS_SUCCESS;
+}
+
+/**
+ * Give the batch a passphrase, as if it had already been read.
+ */
+static int batch_password_set(
+    pubkey_batch* batch, allocator_options_t* alloc_opts, const char* str)
+{
+    int retval;
+
+    retval = string_buffer_init(&batch->password, alloc_opts, str);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    batch->password_read = true;
+    batch->password_status = VCTOOL_STATUS_SUCCESS;
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * The first certificate with a given salt and rounds derives a key; any other
+ * certificate with the same salt and rounds finds it in the cache.
+ */
+TEST(key_cache_hit_and_miss)
+{
+    allocator_options_t alloc_opts;
+    rcpr_allocator* alloc;
+    vccrypt_suite_options_t suite;
+    commandline_opts opts;
+    root_command root;
+    pubkey_batch batch;
+    vccrypt_buffer_t password;
+    vccrypt_buffer_t cert;
+    vccrypt_buffer_t copy;
+    vccrypt_buffer_t salt;
+    vccrypt_buffer_t expected_key;
+    vccrypt_buffer_t* first_encrypted;
+    vccrypt_buffer_t* second_encrypted;
+    vccrypt_buffer_t* decrypted;
+    const vccrypt_buffer_t* first_key;
+    const vccrypt_buffer_t* hit_key;
+    const vccrypt_buffer_t* second_key;
+    unsigned int rounds;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            string_buffer_init(&password, &alloc_opts, "passphrase"));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            string_buffer_init(&cert, &alloc_opts, "not really a keypair"));
+
+    /* encrypt the same certificate twice, giving two different salts. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_encrypt(
+                &suite, &first_encrypted, &cert, &password, TEST_ROUNDS));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_encrypt(
+                &suite, &second_encrypted, &cert, &password, TEST_ROUNDS));
+
+    /* a separate copy of the first encrypted certificate has the same salt. */
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_buffer_init(&copy, &alloc_opts, first_encrypted->size));
+    memcpy(copy.data, first_encrypted->data, copy.size);
+
+    /* only the suite is used from the options, and the allocator from root. */
+    memset(&opts, 0, sizeof(opts));
+    opts.suite = &suite;
+    memset(&root, 0, sizeof(root));
+    root.alloc = alloc;
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS == pubkey_batch_init(&batch, &opts, &root));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            batch_password_set(&batch, &alloc_opts, "passphrase"));
+    TEST_EXPECT(0 == rbtree_count(batch.key_cache));
+
+    /* a miss derives the key and caches it. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            pubkey_batch_get_derived_key(&first_key, &batch, first_encrypted));
+    TEST_EXPECT(1 == rbtree_count(batch.key_cache));
+
+    /* this is the key derived directly from the password. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_read_key_derivation_parameters(
+                &suite, &salt, &rounds, first_encrypted));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            crypt_derive_key_from_password(
+                &expected_key, &suite, &password, &salt, rounds));
+    TEST_ASSERT(expected_key.size == first_key->size);
+    TEST_EXPECT(
+        !memcmp(expected_key.data, first_key->data, expected_key.size));
+
+    /* the same salt, in a different buffer, hits the cache. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            pubkey_batch_get_derived_key(&hit_key, &batch, &copy));
+    TEST_EXPECT(first_key == hit_key);
+    TEST_EXPECT(1 == rbtree_count(batch.key_cache));
+
+    /* a different salt misses the cache. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            pubkey_batch_get_derived_key(
+                &second_key, &batch, second_encrypted));
+    TEST_EXPECT(first_key != second_key);
+    TEST_EXPECT(2 == rbtree_count(batch.key_cache));
+
+    /* both cached keys decrypt their certificates. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_decrypt_with_key(
+                &suite, &decrypted, first_encrypted, first_key));
+    TEST_EXPECT(
+        cert.size == decrypted->size
+     && !memcmp(cert.data, decrypted->data, cert.size));
+    dispose((disposable_t*)decrypted);
+    free(decrypted);
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            certificate_decrypt_with_key(
+                &suite, &decrypted, second_encrypted, second_key));
+    TEST_EXPECT(
+        cert.size == decrypted->size
+     && !memcmp(cert.data, decrypted->data, cert.size));
+    dispose((disposable_t*)decrypted);
+    free(decrypted);
+
+    /* clean up. */
+    pubkey_batch_dispose(&batch);
+    dispose((disposable_t*)&expected_key);
+    dispose((disposable_t*)&salt);
+    dispose((disposable_t*)&copy);
+    dispose((disposable_t*)second_encrypted);
+    free(second_encrypted);
+    dispose((disposable_t*)first_encrypted);
+    free(first_encrypted);
+    dispose((disposable_t*)&cert);
+    dispose((disposable_t*)&password);
+    dispose((disposable_t*)&suite);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+    dispose((disposable_t*)&alloc_opts);
+}
+
+/**
+ * A keypair with group, other, or special permission bits, or without user
+ * read permission, is rejected with an error before it is opened.
+ */
+TEST(bad_permissions)
+{
+    allocator_options_t alloc_opts;
+    rcpr_allocator* alloc;
+    vccrypt_suite_options_t suite;
+    commandline_opts opts;
+    root_command root;
+    pubkey_batch batch;
+    file f;
+    mode_t key_mode = 0;
+    atomic<int> open_count(0);
+    const mode_t bad_modes[] = {
+        0640, 0604, 0700 | S_ISUID, 0600 | S_ISGID, 0600 | S_ISVTX, 0200 };
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+
+    /* the keypair files exist with the given mode; nothing else does. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_mock_init(
+                &f,
+                /* stat. */
+                [&](file*, const char* name, file_stat_st* fst) -> int {
+                    if (string(name).find(".pub") != string::npos)
+                    {
+                        return VCTOOL_ERROR_FILE_NO_ENTRY;
+                    }
+
+                    memset(fst, 0, sizeof(*fst));
+                    fst->fst_mode = S_IFREG | key_mode;
+                    fst->fst_size = 64;
+                    return VCTOOL_STATUS_SUCCESS;
+                },
+                /* open. */
+                [&](file*, int*, const char*, int, mode_t) -> int {
+                    ++open_count;
+                    return VCTOOL_ERROR_FILE_NO_ENTRY;
+                },
+                /* close. */
+                [&](file*, int) -> int {
+                    return VCTOOL_STATUS_SUCCESS;
+                },
+                /* read. */
+                [&](file*, int, void*, size_t, size_t*) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* write. */
+                [&](file*, int, const void*, size_t, size_t*) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* lseek. */
+                [&](file*, int, off_t, file_lseek_whence, off_t*) -> int {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                },
+                /* fsync. */
+                [&](file*, int) -> int {
+                    return VCTOOL_STATUS_SUCCESS;
+                }));
+
+    /* only the file and suite are used from the options. */
+    memset(&opts, 0, sizeof(opts));
+    opts.file = &f;
+    opts.suite = &suite;
+    memset(&root, 0, sizeof(root));
+    root.alloc = alloc;
+
+    /* a single job reports the permission error itself. */
+    for (mode_t mode : bad_modes)
+    {
+        key_mode = mode;
+
+        TEST_ASSERT(
+            VCTOOL_STATUS_SUCCESS == pubkey_batch_init(&batch, &opts, &root));
+        TEST_ASSERT(
+            VCTOOL_STATUS_SUCCESS ==
+                pubkey_batch_add_job(&batch, "key.cert", "key.cert.pub"));
+        TEST_EXPECT(
+            VCTOOL_ERROR_COMMANDLINE_BAD_FILE_PERMISSIONS ==
+                pubkey_batch_run(&batch));
+        pubkey_batch_dispose(&batch);
+    }
+
+    /* a batch with bad keypairs fails as a whole. */
+    key_mode = 0644;
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS == pubkey_batch_init(&batch, &opts, &root));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            pubkey_batch_add_job(&batch, "a.cert", "a.cert.pub"));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            pubkey_batch_add_job(&batch, "b.cert", "b.cert.pub"));
+    TEST_EXPECT(VCTOOL_ERROR_PUBKEY_BATCH_FAILED == pubkey_batch_run(&batch));
+    TEST_EXPECT(
+        VCTOOL_ERROR_COMMANDLINE_BAD_FILE_PERMISSIONS == batch.jobs[0].status);
+    TEST_EXPECT(
+        VCTOOL_ERROR_COMMANDLINE_BAD_FILE_PERMISSIONS == batch.jobs[1].status);
+    pubkey_batch_dispose(&batch);
+
+    /* no keypair was ever opened. */
+    TEST_EXPECT(0 == open_count);
+
+    /* clean up. */
+    dispose((disposable_t*)&f);
+    dispose((disposable_t*)&suite);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+    dispose((disposable_t*)&alloc_opts);
+}
@@ -0,0 +1,588 @@
+/**
+ * \file test/submit/test_submit_run.cpp
+ *
+ * \brief Unit tests for submit_run against the mock agent.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cstring>
+#include <minunit/minunit.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include <vccrypt/suite.h>
+#include <vctool/agent.h>
+#include <vctool/status_codes.h>
+#include <vector>
+#include <vpr/allocator/malloc_allocator.h>
+
+#include "../../src/command/mock_agent/mock_agent_internal.h"
+#include "../../src/command/submit/submit_internal.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/* start of the submit_run test suite. */
+TEST_SUITE(submit_run);
+
+/**
+ * \brief Generate a key agreement keypair.
+ */
+static bool make_keypair(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* priv,
+    vccrypt_buffer_t* pub)
+{
+    vccrypt_key_agreement_context_t agreement;
+    bool result = false;
+
+    if (VCCRYPT_STATUS_SUCCESS !=
+            vccrypt_suite_cipher_key_agreement_init(suite, &agreement))
+    {
+        return false;
+    }
+
+    if (VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_buffer_init_for_cipher_key_agreement_private_key(
+                suite, priv)
+     && VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_buffer_init_for_cipher_key_agreement_public_key(
+                suite, pub))
+    {
+        result =
+            VCCRYPT_STATUS_SUCCESS ==
+                vccrypt_key_agreement_keypair_create(&agreement, priv, pub);
+    }
+
+    dispose((disposable_t*)&agreement);
+
+    return result;
+}
+
+/**
+ * \brief A client and an agent, each with their own keys and the other's
+ * public key.
+ */
+struct agent_pair
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    rcpr_allocator* alloc;
+    vccrypt_buffer_t client_pub;
+    vccrypt_buffer_t agent_pub;
+    agent_keys client_keys;
+    agent_keys server_keys;
+};
+
+/**
+ * \brief Create the keys for a client and an agent.
+ */
+static bool agent_pair_init(agent_pair* pair)
+{
+    memset(pair, 0, sizeof(*pair));
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&pair->alloc_opts);
+
+    if (VCCRYPT_STATUS_SUCCESS !=
+            vccrypt_suite_options_init(
+                &pair->suite, &pair->alloc_opts, VCCRYPT_SUITE_VELO_V1)
+     || STATUS_SUCCESS != rcpr_malloc_allocator_create(&pair->alloc)
+     || !make_keypair(
+            &pair->suite, &pair->client_keys.local_private_key,
+            &pair->client_pub)
+     || !make_keypair(
+            &pair->suite, &pair->server_keys.local_private_key,
+            &pair->agent_pub))
+    {
+        return false;
+    }
+
+    /* each side expects the other's id and public key. */
+    memset(&pair->client_keys.local_id, 0x11, sizeof(rcpr_uuid));
+    memset(&pair->server_keys.local_id, 0x22, sizeof(rcpr_uuid));
+    pair->client_keys.peer_id = pair->server_keys.local_id;
+    pair->server_keys.peer_id = pair->client_keys.local_id;
+
+    return
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_buffer_init(
+                &pair->client_keys.peer_public_key, &pair->alloc_opts,
+                pair->agent_pub.size)
+     && VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_buffer_copy(
+                &pair->client_keys.peer_public_key, &pair->agent_pub)
+     && VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_buffer_init(
+                &pair->server_keys.peer_public_key, &pair->alloc_opts,
+                pair->client_pub.size)
+     && VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_buffer_copy(
+                &pair->server_keys.peer_public_key, &pair->client_pub);
+}
+
+/**
+ * \brief Dispose of the keys for a client and an agent.
+ */
+static void agent_pair_dispose(agent_pair* pair)
+{
+    agent_keys_dispose(&pair->client_keys);
+    agent_keys_dispose(&pair->server_keys);
+    dispose((disposable_t*)&pair->client_pub);
+    dispose((disposable_t*)&pair->agent_pub);
+    resource_release(rcpr_allocator_resource_handle(pair->alloc));
+    dispose((disposable_t*)&pair->suite);
+    dispose((disposable_t*)&pair->alloc_opts);
+}
+
+/**
+ * \brief The counters of a mock agent, written back by its process.
+ */
+struct agent_counts
+{
+    uint64_t transaction_count;
+    uint64_t submit_count;
+    uint64_t drop_count;
+};
+
+/**
+ * \brief A mock agent listening on a Unix socket in a child process.
+ */
+struct agent_server
+{
+    char dir[32];
+    char path[64];
+    pid_t pid;
+    int counts_fd;
+};
+
+/**
+ * \brief Serve the given number of connections one at a time with one mock
+ * agent, then write its counters and exit.
+ *
+ * The listening socket is closed as soon as the last connection is accepted,
+ * so that any later connection is refused.
+ */
+static void mock_agent_process(
+    agent_pair* pair, int listen_fd, uint64_t drop_every, size_t connections,
+    int counts_fd)
+{
+    mock_agent agent;
+    agent_connection conn;
+    agent_counts counts;
+    int status = 0;
+
+    /* never outlive a failed test. */
+    alarm(10);
+
+    memset(&agent, 0, sizeof(agent));
+    agent.drop_every = drop_every;
+
+    for (size_t served = 0; served < connections; ++served)
+    {
+        int client_fd = accept(listen_fd, NULL, NULL);
+        if (client_fd < 0)
+        {
+            status = 1;
+            break;
+        }
+
+        if (served + 1 == connections)
+        {
+            close(listen_fd);
+        }
+
+        if (VCTOOL_STATUS_SUCCESS !=
+                agent_connection_init(
+                    &conn, pair->alloc, &pair->suite, client_fd))
+        {
+            close(client_fd);
+            continue;
+        }
+
+        /* a connection reset by the client just ends its session. */
+        if (VCTOOL_STATUS_SUCCESS ==
+                mock_agent_handshake(&conn, &pair->server_keys))
+        {
+            mock_agent_serve(&agent, &conn);
+        }
+
+        agent_connection_dispose(&conn);
+    }
+
+    counts.transaction_count = agent.transaction_count;
+    counts.submit_count = agent.submit_count;
+    counts.drop_count = agent.drop_count;
+    if ((ssize_t)sizeof(counts) != write(counts_fd, &counts, sizeof(counts)))
+    {
+        status = 1;
+    }
+
+    mock_agent_dispose(&agent);
+    _exit(status);
+}
+
+/**
+ * \brief Start a mock agent on a new Unix socket in a child process.
+ *
+ * \returns true on success.
+ */
+static bool agent_server_start(
+    agent_pair* pair, agent_server* server, uint64_t drop_every,
+    size_t connections)
+{
+    struct sockaddr_un addr;
+    int listen_fd, fds[2];
+
+    memset(server, 0, sizeof(*server));
+    server->pid = -1;
+    strcpy(server->dir, "/tmp/vctool-submit-XXXXXX");
+    if (NULL == mkdtemp(server->dir))
+    {
+        return false;
+    }
+
+    snprintf(
+        server->path, sizeof(server->path), "%s/agent.sock", server->dir);
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, server->path);
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0)
+    {
+        return false;
+    }
+
+    if (0 != bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr))
+     || 0 != listen(listen_fd, 8)
+     || 0 != pipe(fds))
+    {
+        close(listen_fd);
+        return false;
+    }
+
+    server->pid = fork();
+    if (0 == server->pid)
+    {
+        close(fds[0]);
+        mock_agent_process(pair, listen_fd, drop_every, connections, fds[1]);
+    }
+
+    /* only the mock agent listens. */
+    close(listen_fd);
+    close(fds[1]);
+    server->counts_fd = fds[0];
+
+    return server->pid > 0;
+}
+
+/**
+ * \brief Wait for the mock agent to serve all of its connections, and read
+ * its counters.
+ *
+ * \returns true if the mock agent succeeded.
+ */
+static bool agent_server_stop(agent_server* server, agent_counts* counts)
+{
+    int wstatus;
+
+    memset(counts, 0, sizeof(*counts));
+    bool result =
+        (ssize_t)sizeof(*counts)
+            == read(server->counts_fd, counts, sizeof(*counts));
+    close(server->counts_fd);
+
+    result =
+        server->pid == waitpid(server->pid, &wstatus, 0)
+     && WIFEXITED(wstatus) && 0 == WEXITSTATUS(wstatus) && result;
+
+    unlink(server->path);
+    rmdir(server->dir);
+
+    return result;
+}
+
+/**
+ * \brief Signed transactions to submit, and the certificates they point into.
+ */
+struct txn_set
+{
+    vector<vector<uint8_t>> certs;
+    vector<submit_txn> txns;
+};
+
+/**
+ * \brief Append a field to a certificate.
+ */
+static void add_field(
+    vector<uint8_t>* cert, uint16_t type, const uint8_t* value, uint16_t size)
+{
+    cert->push_back((uint8_t)(type >> 8));
+    cert->push_back((uint8_t)(type & 0xFF));
+    cert->push_back((uint8_t)(size >> 8));
+    cert->push_back((uint8_t)(size & 0xFF));
+    cert->insert(cert->end(), value, value + size);
+}
+
+/**
+ * \brief Make the given number of transactions, each with its own id, spread
+ * over four artifacts.
+ */
+static void make_txns(txn_set* set, size_t count)
+{
+    const uint8_t signature[] = { 0xAA, 0xBB };
+    uint8_t artifact_id[16], txn_id[16], prev_id[16];
+
+    set->certs.resize(count);
+    set->txns.resize(count);
+    memset(prev_id, 0, sizeof(prev_id));
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        memset(artifact_id, 0x30 + (int)(i % 4), sizeof(artifact_id));
+        memset(txn_id, 0x5A, sizeof(txn_id));
+        txn_id[0] = (uint8_t)(i >> 8);
+        txn_id[1] = (uint8_t)(i & 0xFF);
+
+        vector<uint8_t>& cert = set->certs[i];
+        add_field(&cert, 0x0001, artifact_id, sizeof(artifact_id));
+        add_field(&cert, 0x000D, txn_id, sizeof(txn_id));
+        add_field(&cert, 0x000E, prev_id, sizeof(prev_id));
+        add_field(&cert, 0x0008, signature, sizeof(signature));
+
+        submit_txn& txn = set->txns[i];
+        txn.cert = cert.data();
+        txn.size = cert.size();
+        memcpy(&txn.txn_id, txn_id, sizeof(txn.txn_id));
+        memcpy(&txn.artifact_id, artifact_id, sizeof(txn.artifact_id));
+    }
+}
+
+/**
+ * \brief The outcome of a submission.
+ */
+struct submit_result
+{
+    int status;
+    size_t limit;
+    size_t accepted;
+    size_t request_count;
+    size_t latency_count;
+    size_t reconnect_count;
+    size_t resent_rejected;
+    double elapsed_ms;
+};
+
+/**
+ * \brief Connect to the mock agent, and submit every transaction.
+ */
+static submit_result run_submit(
+    agent_pair* pair, const agent_server* server, const txn_set* set,
+    size_t window, unsigned int max_retries)
+{
+    submit_result result;
+    agent_connection conn;
+    submit_state state;
+    struct timespec start, end;
+
+    memset(&result, 0, sizeof(result));
+
+    /* a write to a dropped connection must fail instead of ending the test. */
+    signal(SIGPIPE, SIG_IGN);
+
+    result.status =
+        agent_connection_connect(
+            &conn, pair->alloc, &pair->suite, server->path,
+            &pair->client_keys);
+    if (VCTOOL_STATUS_SUCCESS != result.status)
+    {
+        return result;
+    }
+
+    result.status =
+        submit_state_init(
+            &state, &conn, &pair->client_keys, server->path,
+            set->txns.data(), set->txns.size(), window, max_retries);
+    if (VCTOOL_STATUS_SUCCESS != result.status)
+    {
+        agent_connection_dispose(&conn);
+        return result;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    result.status = submit_run(&state);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    result.elapsed_ms =
+        (end.tv_sec - start.tv_sec) * 1e3
+      + (end.tv_nsec - start.tv_nsec) / 1e6;
+    result.limit = state.limit;
+    result.accepted = state.accepted;
+    result.request_count = state.request_count;
+    result.latency_count = state.latency_count;
+    result.reconnect_count = state.reconnect_count;
+    result.resent_rejected = state.resent_rejected;
+
+    submit_state_dispose(&state);
+    agent_connection_dispose(&conn);
+
+    return result;
+}
+
+/* Without losses, the number of requests in flight grows to the window, and
+ * every transaction is accepted with a single request. */
+TEST(window_grows)
+{
+    agent_pair pair;
+    agent_server server;
+    agent_counts counts;
+    txn_set set;
+
+    make_txns(&set, 40);
+    TEST_ASSERT(agent_pair_init(&pair));
+    TEST_ASSERT(agent_server_start(&pair, &server, 0, 1));
+
+    submit_result result = run_submit(&pair, &server, &set, 8, 4);
+
+    TEST_ASSERT(agent_server_stop(&server, &counts));
+    TEST_EXPECT(VCTOOL_STATUS_SUCCESS == result.status);
+    TEST_EXPECT(8U == result.limit);
+    TEST_EXPECT(40U == result.accepted);
+    TEST_EXPECT(40U == result.request_count);
+    TEST_EXPECT(40U == result.latency_count);
+    TEST_EXPECT(0U == result.reconnect_count);
+    TEST_EXPECT(0U == result.resent_rejected);
+    TEST_EXPECT(40U == counts.transaction_count);
+    TEST_EXPECT(0U == counts.drop_count);
+
+    agent_pair_dispose(&pair);
+}
+
+/* When the answer to the last submission is lost, the client reconnects,
+ * halves its limit, and resends the submission, which the agent rejects as a
+ * duplicate. */
+TEST(drop_last_submission)
+{
+    agent_pair pair;
+    agent_server server;
+    agent_counts counts;
+    txn_set set;
+
+    make_txns(&set, 20);
+    TEST_ASSERT(agent_pair_init(&pair));
+    TEST_ASSERT(agent_server_start(&pair, &server, 20, 2));
+
+    submit_result result = run_submit(&pair, &server, &set, 4, 4);
+
+    TEST_ASSERT(agent_server_stop(&server, &counts));
+    TEST_EXPECT(VCTOOL_STATUS_SUCCESS == result.status);
+    TEST_EXPECT(2U == result.limit);
+    TEST_EXPECT(1U == result.reconnect_count);
+    TEST_EXPECT(1U == result.resent_rejected);
+    TEST_EXPECT(19U == result.accepted);
+    TEST_EXPECT(21U == result.request_count);
+    TEST_EXPECT(20U == counts.transaction_count);
+    TEST_EXPECT(1U == counts.drop_count);
+
+    agent_pair_dispose(&pair);
+}
+
+/* When the connection is dropped with a window of requests in flight, every
+ * request in flight is resent on a new connection. The requests the agent had
+ * accepted are rejected as duplicates, and the others are accepted, so every
+ * transaction is accepted exactly once. */
+TEST(drop_mid_window)
+{
+    agent_pair pair;
+    agent_server server;
+    agent_counts counts;
+    txn_set set;
+
+    make_txns(&set, 40);
+    TEST_ASSERT(agent_pair_init(&pair));
+    TEST_ASSERT(agent_server_start(&pair, &server, 7, 6));
+
+    submit_result result = run_submit(&pair, &server, &set, 8, 4);
+
+    TEST_ASSERT(agent_server_stop(&server, &counts));
+    TEST_EXPECT(VCTOOL_STATUS_SUCCESS == result.status);
+    TEST_EXPECT(40U == counts.transaction_count);
+    TEST_EXPECT(5U == counts.drop_count);
+    TEST_EXPECT(5U == result.reconnect_count);
+
+    /* every lost answer is resent and rejected. */
+    TEST_EXPECT(result.resent_rejected >= 5U);
+    TEST_EXPECT(40U == result.accepted + result.resent_rejected);
+
+    /* some resent requests were accepted: the ones sent after a dropped
+     * submission, which the agent never read. */
+    TEST_EXPECT(result.request_count > 40U + result.resent_rejected);
+
+    agent_pair_dispose(&pair);
+}
+
+/* A transaction the agent rejects ends the submission, after the
+ * transactions before it are accepted. */
+TEST(rejection)
+{
+    agent_pair pair;
+    agent_server server;
+    agent_counts counts;
+    txn_set set;
+
+    make_txns(&set, 20);
+
+    /* the request names a different artifact than the transaction. */
+    memset(&set.txns[12].artifact_id, 0x7F, sizeof(rcpr_uuid));
+
+    TEST_ASSERT(agent_pair_init(&pair));
+    TEST_ASSERT(agent_server_start(&pair, &server, 0, 1));
+
+    submit_result result = run_submit(&pair, &server, &set, 4, 4);
+
+    TEST_ASSERT(agent_server_stop(&server, &counts));
+    TEST_EXPECT(VCTOOL_ERROR_AGENT_REQUEST_FAILED == result.status);
+    TEST_EXPECT(12U == result.accepted);
+    TEST_EXPECT(0U == result.reconnect_count);
+    TEST_EXPECT(0U == result.resent_rejected);
+    TEST_EXPECT(counts.transaction_count >= 12U);
+
+    agent_pair_dispose(&pair);
+}
+
+/* When the agent goes away, each reconnect waits twice as long as the last,
+ * and the submission fails once every retry is used. */
+TEST(reconnect_backoff)
+{
+    agent_pair pair;
+    agent_server server;
+    agent_counts counts;
+    txn_set set;
+
+    make_txns(&set, 10);
+    TEST_ASSERT(agent_pair_init(&pair));
+
+    /* the only connection is dropped on the third submission, and every
+     * later connection is refused. */
+    TEST_ASSERT(agent_server_start(&pair, &server, 3, 1));
+
+    submit_result result = run_submit(&pair, &server, &set, 1, 4);
+
+    TEST_ASSERT(agent_server_stop(&server, &counts));
+    TEST_EXPECT(VCTOOL_ERROR_AGENT_CONNECT_FAILED == result.status);
+    TEST_EXPECT(2U == result.accepted);
+    TEST_EXPECT(0U == result.reconnect_count);
+    TEST_EXPECT(1U == counts.drop_count);
+
+    /* the four retries waited 1 + 2 + 4 + 8 ms. */
+    TEST_EXPECT(result.elapsed_ms >= 15.0);
+
+    agent_pair_dispose(&pair);
+}
@@ -0,0 +1,89 @@
+/**
+ * \file test/transaction/test_transaction_info_read.cpp
+ *
+ * \brief Unit tests for transaction_info_read.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cstring>
+#include <minunit/minunit.h>
+#include <vctool/status_codes.h>
+#include <vctool/transaction.h>
+
+/* start of the transaction_info_read test suite. */
+TEST_SUITE(transaction_info_read);
+
+/* A transaction with every id field is read. */
+TEST(read_transaction)
+{
+    const uint8_t cert[] = {
+        /* artifact id. */
+        0x00, 0x01, 0x00, 0x10,
+        0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+        0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+        /* transaction id. */
+        0x00, 0x0D, 0x00, 0x10,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        /* previous transaction id. */
+        0x00, 0x0E, 0x00, 0x10,
+        0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+        0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+        /* signature. */
+        0x00, 0x08, 0x00, 0x02, 0xAA, 0xBB };
+    transaction_info info;
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS
+            == transaction_info_read(&info, cert, sizeof(cert)));
+    TEST_EXPECT(
+        0 == memcmp(info.artifact_id, cert + 4, TRANSACTION_ID_SIZE));
+    TEST_EXPECT(
+        0 == memcmp(info.transaction_id, cert + 24, TRANSACTION_ID_SIZE));
+    TEST_EXPECT(
+        0 == memcmp(
+                info.previous_transaction_id, cert + 44,
+                TRANSACTION_ID_SIZE));
+}
+
+/* A transaction without a previous transaction id is rejected. */
+TEST(missing_previous_transaction_id)
+{
+    const uint8_t cert[] = {
+        0x00, 0x01, 0x00, 0x10,
+        0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+        0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+        0x00, 0x0D, 0x00, 0x10,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01 };
+    transaction_info info;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_MISSING_FIELD
+            == transaction_info_read(&info, cert, sizeof(cert)));
+}
+
+/* An id of the wrong size is rejected. */
+TEST(bad_id_size)
+{
+    const uint8_t cert[] = {
+        0x00, 0x0D, 0x00, 0x02, 0x01, 0x01 };
+    transaction_info info;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_BAD_VALUE
+            == transaction_info_read(&info, cert, sizeof(cert)));
+}
+
+/* A truncated field is rejected. */
+TEST(truncated_field)
+{
+    const uint8_t cert[] = {
+        0x00, 0x0D, 0x00, 0x10, 0x01, 0x01 };
+    transaction_info info;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_CERTIFICATE_FIELD_TRUNCATED
+            == transaction_info_read(&info, cert, sizeof(cert)));
+}
@@ -0,0 +1,125 @@
+/**
+ * \file test/transaction/test_transaction_spec_parse_csv.cpp
+ *
+ * \brief Unit tests for transaction_csv_header_parse and
+ * transaction_spec_parse_csv.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cstring>
+#include <minunit/minunit.h>
+#include <vctool/status_codes.h>
+#include <vctool/transaction.h>
+
+/* start of the transaction_spec_parse_csv test suite. */
+TEST_SUITE(transaction_spec_parse_csv);
+
+static const char* HEADER =
+    "artifact_id, transaction_type, previous_state, new_state, valid_from";
+
+static int parse_header(transaction_csv_header* header, const char* line)
+{
+    return transaction_csv_header_parse(header, line, strlen(line));
+}
+
+static int parse(
+    transaction_spec* spec, const transaction_csv_header* header,
+    const char* line)
+{
+    return transaction_spec_parse_csv(spec, header, line, strlen(line));
+}
+
+/* The header maps each column to a field. */
+TEST(header)
+{
+    transaction_csv_header header;
+
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == parse_header(&header, HEADER));
+    TEST_ASSERT(5U == header.column_count);
+    TEST_EXPECT(TRANSACTION_FIELD_ARTIFACT_ID == header.columns[0]);
+    TEST_EXPECT(TRANSACTION_FIELD_TRANSACTION_TYPE == header.columns[1]);
+    TEST_EXPECT(TRANSACTION_FIELD_PREVIOUS_STATE == header.columns[2]);
+    TEST_EXPECT(TRANSACTION_FIELD_NEW_STATE == header.columns[3]);
+    TEST_EXPECT(TRANSACTION_FIELD_VALID_FROM == header.columns[4]);
+}
+
+/* A bad header is rejected. */
+TEST(bad_header)
+{
+    transaction_csv_header header;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_UNKNOWN_FIELD ==
+            parse_header(&header, "artifact_id,state"));
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_DUPLICATE_FIELD ==
+            parse_header(&header, "new_state,new_state"));
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_MISSING_FIELD ==
+            parse_header(&header, "artifact_id,transaction_type,new_state"));
+}
+
+/* A row is parsed; quotes and a carriage return are stripped. */
+TEST(row)
+{
+    transaction_csv_header header;
+    transaction_spec spec;
+
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == parse_header(&header, HEADER));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            parse(
+                &spec, &header,
+                "\"11111111-2222-3333-4444-555555555555\","
+                "00000000-0000-0000-0000-000000000003, 7, 8, 1700000000\r"));
+    TEST_EXPECT(0x11 == spec.artifact_id[0]);
+    TEST_EXPECT(0x03 == spec.transaction_type[15]);
+    TEST_EXPECT(7U == spec.previous_state);
+    TEST_EXPECT(8U == spec.new_state);
+    TEST_EXPECT(1700000000U == spec.valid_from);
+}
+
+/* An empty optional column leaves its field unset. */
+TEST(empty_column)
+{
+    transaction_csv_header header;
+    transaction_spec spec;
+
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == parse_header(&header, HEADER));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            parse(
+                &spec, &header,
+                "11111111-2222-3333-4444-555555555555,"
+                "00000000-0000-0000-0000-000000000003,7,8,"));
+    TEST_EXPECT(TRANSACTION_REQUIRED_FIELDS == spec.fields);
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_MISSING_FIELD ==
+            parse(
+                &spec, &header,
+                "11111111-2222-3333-4444-555555555555,"
+                "00000000-0000-0000-0000-000000000003,,8,"));
+}
+
+/* A row must have exactly one column per header column. */
+TEST(column_count)
+{
+    transaction_csv_header header;
+    transaction_spec spec;
+
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == parse_header(&header, HEADER));
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_SYNTAX ==
+            parse(
+                &spec, &header,
+                "11111111-2222-3333-4444-555555555555,"
+                "00000000-0000-0000-0000-000000000003,7,8"));
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_SYNTAX ==
+            parse(
+                &spec, &header,
+                "11111111-2222-3333-4444-555555555555,"
+                "00000000-0000-0000-0000-000000000003,7,8,9,10"));
+}
@@ -0,0 +1,130 @@
+/**
+ * \file test/transaction/test_transaction_spec_parse_json.cpp
+ *
+ * \brief Unit tests for transaction_spec_parse_json.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <cstring>
+#include <minunit/minunit.h>
+#include <vctool/status_codes.h>
+#include <vctool/transaction.h>
+
+/* start of the transaction_spec_parse_json test suite. */
+TEST_SUITE(transaction_spec_parse_json);
+
+static int parse(transaction_spec* spec, const char* line)
+{
+    return transaction_spec_parse_json(spec, line, strlen(line));
+}
+
+/* An entry with every field is parsed. */
+TEST(all_fields)
+{
+    const uint8_t artifact_id[16] = {
+        0x11, 0x11, 0x11, 0x11, 0x22, 0x22, 0x33, 0x33,
+        0x44, 0x44, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55 };
+    transaction_spec spec;
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            parse(
+                &spec,
+                "{\"transaction_id\": \"00000000-0000-0000-0000-000000000001\","
+                " \"previous_transaction_id\":"
+                " \"00000000-0000-0000-0000-000000000002\","
+                " \"transaction_type\": "
+                "\"00000000-0000-0000-0000-000000000003\","
+                " \"artifact_id\": \"11111111-2222-3333-4444-555555555555\","
+                " \"previous_state\": 4294967295, \"new_state\": 1,"
+                " \"valid_from\": 1700000000}"));
+    TEST_EXPECT(0x01 == spec.transaction_id[15]);
+    TEST_EXPECT(0x02 == spec.previous_transaction_id[15]);
+    TEST_EXPECT(0x03 == spec.transaction_type[15]);
+    TEST_EXPECT(0 == memcmp(artifact_id, spec.artifact_id, 16));
+    TEST_EXPECT(0xFFFFFFFFU == spec.previous_state);
+    TEST_EXPECT(1U == spec.new_state);
+    TEST_EXPECT(1700000000U == spec.valid_from);
+    TEST_EXPECT(
+        spec.fields == TRANSACTION_FIELD_BIT(TRANSACTION_FIELD_COUNT) - 1);
+}
+
+/* Optional fields can be left out. */
+TEST(optional_fields)
+{
+    transaction_spec spec;
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            parse(
+                &spec,
+                "{\"transaction_type\":\"00000000-0000-0000-0000-000000000003\""
+                ",\"artifact_id\":\"11111111-2222-3333-4444-555555555555\","
+                "\"previous_state\":0,\"new_state\":1}"));
+    TEST_EXPECT(TRANSACTION_REQUIRED_FIELDS == spec.fields);
+    TEST_EXPECT(0 == spec.valid_from);
+}
+
+/* A missing required field is reported. */
+TEST(missing_field)
+{
+    transaction_spec spec;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_MISSING_FIELD ==
+            parse(
+                &spec,
+                "{\"transaction_type\":\"00000000-0000-0000-0000-000000000003\""
+                ",\"previous_state\":0,\"new_state\":1}"));
+    TEST_EXPECT(VCTOOL_ERROR_TRANSACTION_MISSING_FIELD == parse(&spec, "{}"));
+}
+
+/* Unknown and repeated fields are rejected. */
+TEST(bad_fields)
+{
+    transaction_spec spec;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_UNKNOWN_FIELD ==
+            parse(&spec, "{\"artifact\": 1}"));
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_DUPLICATE_FIELD ==
+            parse(&spec, "{\"new_state\": 1, \"new_state\": 2}"));
+}
+
+/* Values must be UUIDs or numbers in range. */
+TEST(bad_values)
+{
+    transaction_spec spec;
+
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_BAD_VALUE ==
+            parse(&spec, "{\"artifact_id\": \"not-a-uuid\"}"));
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_BAD_VALUE ==
+            parse(&spec, "{\"new_state\": 4294967296}"));
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_BAD_VALUE ==
+            parse(&spec, "{\"new_state\": \"one\"}"));
+}
+
+/* Malformed objects are rejected. */
+TEST(syntax)
+{
+    transaction_spec spec;
+
+    TEST_EXPECT(VCTOOL_ERROR_TRANSACTION_SYNTAX == parse(&spec, ""));
+    TEST_EXPECT(VCTOOL_ERROR_TRANSACTION_SYNTAX == parse(&spec, "[]"));
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_SYNTAX == parse(&spec, "{\"new_state\": 1"));
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_SYNTAX ==
+            parse(&spec, "{\"new_state\": 1} x"));
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_SYNTAX ==
+            parse(&spec, "{\"new_state\": -1}"));
+    TEST_EXPECT(
+        VCTOOL_ERROR_TRANSACTION_SYNTAX ==
+            parse(&spec, "{\"new_\\u0073tate\": 1}"));
+}
@@ -0,0 +1,541 @@
+/**
+ * \file test/txn/test_txn_batch.cpp
+ *
+ * \brief Unit tests for signing a transaction manifest with the txn command.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <fcntl.h>
+#include <map>
+#include <minunit/minunit.h>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vccert/builder.h>
+#include <vccrypt/suite.h>
+#include <vector>
+#include <vpr/allocator/malloc_allocator.h>
+
+#include "../../src/command/txn/txn_internal.h"
+#include "../file/mock_file.h"
+
+using namespace std;
+
+RCPR_IMPORT_uuid;
+
+/* start of the txn_batch test suite. */
+TEST_SUITE(txn_batch);
+
+/** \brief A small manifest, with a comment and a blank line. */
+static const char MANIFEST[] =
+    "# two artifacts, one of which changes twice.\n"
+    "{\"transaction_id\": \"00000000-0000-0000-0000-000000000001\","
+    " \"transaction_type\": \"00000000-0000-0000-0000-0000000000aa\","
+    " \"artifact_id\": \"11111111-2222-3333-4444-555555555551\","
+    " \"previous_state\": 0, \"new_state\": 1, \"valid_from\": 1700000000}\n"
+    "\n"
+    "{\"transaction_id\": \"00000000-0000-0000-0000-000000000002\","
+    " \"transaction_type\": \"00000000-0000-0000-0000-0000000000aa\","
+    " \"artifact_id\": \"11111111-2222-3333-4444-555555555552\","
+    " \"previous_state\": 0, \"new_state\": 1, \"valid_from\": 1700000001}\n"
+    "{\"transaction_id\": \"00000000-0000-0000-0000-000000000003\","
+    " \"previous_transaction_id\": \"00000000-0000-0000-0000-000000000001\","
+    " \"transaction_type\": \"00000000-0000-0000-0000-0000000000aa\","
+    " \"artifact_id\": \"11111111-2222-3333-4444-555555555551\","
+    " \"previous_state\": 1, \"new_state\": 2, \"valid_from\": 1700000002}\n";
+
+/** \brief The line number of each manifest entry. */
+static const size_t MANIFEST_LINES[] = { 2, 4, 5 };
+
+/** \brief The number of manifest entries. */
+#define MANIFEST_COUNT (sizeof(MANIFEST_LINES) / sizeof(MANIFEST_LINES[0]))
+
+static const uint8_t SIGNER_ID[16] = {
+    0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30 };
+
+/**
+ * Create a signing keypair with the given suite.
+ */
+static int signing_keypair_create(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* privkey,
+    vccrypt_buffer_t* pubkey)
+{
+    int retval;
+    vccrypt_digital_signature_context_t sign;
+
+    retval = vccrypt_suite_digital_signature_init(suite, &sign);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval =
+        vccrypt_suite_buffer_init_for_signature_private_key(suite, privkey);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_sign;
+    }
+
+    retval =
+        vccrypt_suite_buffer_init_for_signature_public_key(suite, pubkey);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_privkey;
+    }
+
+    retval = vccrypt_digital_signature_keypair_create(&sign, privkey, pubkey);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_pubkey;
+    }
+
+    /* success. */
+    retval = VCCRYPT_STATUS_SUCCESS;
+    goto cleanup_sign;
+
+cleanup_pubkey:
+    dispose(vccrypt_buffer_disposable_handle(pubkey));
+
+cleanup_privkey:
+    dispose(vccrypt_buffer_disposable_handle(privkey));
+
+cleanup_sign:
+    dispose((disposable_t*)&sign);
+
+    return retval;
+}
+
+/**
+ * Initialize a mock file interface that keeps every file in memory. The given
+ * directory exists, and new files can be created with O_EXCL.
+ */
+static int memory_file_init(
+    file* f, map<string, vector<uint8_t>>& files,
+    map<int, string>& descriptors, mutex& lock, const string& dir)
+{
+    return
+        file_mock_init(
+            f,
+            /* stat. */
+            [&](file*, const char* name, file_stat_st* fst) -> int {
+                lock_guard<mutex> guard(lock);
+                memset(fst, 0, sizeof(*fst));
+                if (dir == name)
+                {
+                    fst->fst_mode = S_IFDIR | S_IRWXU;
+                    return VCTOOL_STATUS_SUCCESS;
+                }
+
+                auto it = files.find(name);
+                if (files.end() == it)
+                {
+                    return VCTOOL_ERROR_FILE_NO_ENTRY;
+                }
+
+                fst->fst_mode = S_IFREG | S_IRUSR | S_IWUSR;
+                fst->fst_size = it->second.size();
+                return VCTOOL_STATUS_SUCCESS;
+            },
+            /* open. */
+            [&](file*, int* d, const char* name, int flags, mode_t) -> int {
+                lock_guard<mutex> guard(lock);
+                if ((flags & O_EXCL) && files.end() != files.find(name))
+                {
+                    return VCTOOL_ERROR_FILE_EXISTS;
+                }
+
+                files[name];
+                *d = 10 + (int)descriptors.size();
+                while (descriptors.end() != descriptors.find(*d))
+                {
+                    ++*d;
+                }
+
+                descriptors[*d] = name;
+                return VCTOOL_STATUS_SUCCESS;
+            },
+            /* close. */
+            [&](file*, int d) -> int {
+                lock_guard<mutex> guard(lock);
+                return
+                    (1U == descriptors.erase(d))
+                        ? VCTOOL_STATUS_SUCCESS
+                        : VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+            },
+            /* read. */
+            [&](file*, int, void*, size_t, size_t*) -> int {
+                return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+            },
+            /* write. */
+            [&](file*, int d, const void* buf, size_t max,
+                size_t* size) -> int {
+                lock_guard<mutex> guard(lock);
+                auto it = descriptors.find(d);
+                if (descriptors.end() == it)
+                {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                }
+
+                const uint8_t* bytes = (const uint8_t*)buf;
+                vector<uint8_t>& contents = files[it->second];
+                contents.insert(contents.end(), bytes, bytes + max);
+                *size = max;
+                return VCTOOL_STATUS_SUCCESS;
+            },
+            /* lseek. */
+            [&](file*, int, off_t, file_lseek_whence, off_t*) -> int {
+                return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+            },
+            /* fsync. */
+            [&](file*, int) -> int {
+                return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+            });
+}
+
+/**
+ * Sign every entry of a manifest the way the txn command signs a chunk, and
+ * append the transactions to the given descriptor unless the batch has an
+ * output directory. The line number of each entry is saved.
+ */
+static int sign_manifest(
+    txn_batch* batch, const char* text, int fd, vector<size_t>& lines)
+{
+    int retval;
+    txn_manifest manifest;
+    vccrypt_prng_context_t prng;
+    vccrypt_buffer_t ids;
+    bool eof = false;
+
+    /* read the manifest from memory, as a JSON Lines manifest. */
+    memset(&manifest, 0, sizeof(manifest));
+    manifest.filename = "manifest.jsonl";
+    manifest.format = TXN_MANIFEST_FORMAT_JSONL;
+    manifest.in = fmemopen((void*)text, strlen(text), "r");
+    if (NULL == manifest.in)
+    {
+        return VCTOOL_ERROR_FILE_NO_ENTRY;
+    }
+
+    retval = vccrypt_suite_prng_init(batch->opts->suite, &prng);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_manifest;
+    }
+
+    retval =
+        vccrypt_buffer_init(
+            &ids, batch->opts->suite->alloc_opts,
+            TXN_CHUNK_SIZE * TRANSACTION_ID_SIZE);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_prng;
+    }
+
+    /* a small manifest fits in a single chunk. */
+    while (batch->job_count < TXN_CHUNK_SIZE)
+    {
+        txn_job* job = &batch->jobs[batch->job_count];
+        retval = txn_manifest_read(&manifest, &job->spec, &eof);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_batch;
+        }
+        else if (eof)
+        {
+            break;
+        }
+
+        job->line_number = manifest.line_number;
+        lines.push_back(job->line_number);
+        ++batch->job_count;
+    }
+
+    /* build and sign the chunk on the worker pool. */
+    retval = txn_batch_assign_defaults(batch, &prng, &ids, 1700000000);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_batch;
+    }
+
+    retval = parallel_for(batch->job_count, &txn_worker, batch);
+    if (VCTOOL_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_batch;
+    }
+
+    for (size_t i = 0; i < batch->job_count; ++i)
+    {
+        if (VCTOOL_STATUS_SUCCESS != batch->jobs[i].status)
+        {
+            retval = batch->jobs[i].status;
+            goto cleanup_batch;
+        }
+    }
+
+    /* append the chunk to the output file. */
+    if (NULL == batch->output_dir)
+    {
+        retval = txn_batch_write(batch, fd);
+    }
+
+cleanup_batch:
+    txn_batch_clear(batch);
+    dispose(vccrypt_buffer_disposable_handle(&ids));
+
+cleanup_prng:
+    dispose((disposable_t*)&prng);
+
+cleanup_manifest:
+    fclose(manifest.in);
+
+    return retval;
+}
+
+/**
+ * Sign each manifest entry on its own, in manifest order.
+ */
+static int expected_transactions(
+    vector<vector<uint8_t>>& txns, commandline_opts* opts,
+    const vccrypt_buffer_t* privkey)
+{
+    int retval;
+    const char* line = MANIFEST;
+    transaction_spec spec;
+    vccrypt_buffer_t cert;
+
+    for (const char* end = strchr(line, '\n'); NULL != end;
+         line = end + 1, end = strchr(line, '\n'))
+    {
+        /* only entries are signed. */
+        if ('{' != *line)
+        {
+            continue;
+        }
+
+        retval = transaction_spec_parse_json(&spec, line, end - line);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        retval =
+            transaction_certificate_create(
+                opts, &cert, &spec, SIGNER_ID, privkey);
+        if (VCTOOL_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        const uint8_t* bytes = (const uint8_t*)cert.data;
+        txns.push_back(vector<uint8_t>(bytes, bytes + cert.size));
+        dispose(vccrypt_buffer_disposable_handle(&cert));
+    }
+
+    return VCTOOL_STATUS_SUCCESS;
+}
+
+/**
+ * Test that the transactions of a manifest are written in manifest order, that
+ * each one is signed by the signer, and that signing the manifest again gives
+ * the same output.
+ */
+TEST(manifest_order_and_determinism)
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccert_builder_options_t builder_opts;
+    vccrypt_buffer_t privkey;
+    vccrypt_buffer_t pubkey;
+    commandline_opts opts;
+    file f;
+    txn_batch batch;
+    transaction_info info;
+    mutex lock;
+    map<string, vector<uint8_t>> files;
+    map<int, string> descriptors;
+    vector<vector<uint8_t>> expected;
+    vector<size_t> lines;
+    int fd;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCCERT_STATUS_SUCCESS ==
+            vccert_builder_options_init(&builder_opts, &alloc_opts, &suite));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            signing_keypair_create(&suite, &privkey, &pubkey));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            memory_file_init(&f, files, descriptors, lock, "out"));
+
+    /* only the file, suite, and builder options are used. */
+    memset(&opts, 0, sizeof(opts));
+    opts.file = &f;
+    opts.suite = &suite;
+    opts.builder_opts = &builder_opts;
+
+    memset(&batch, 0, sizeof(batch));
+    batch.opts = &opts;
+    batch.signer_id = (const rcpr_uuid*)SIGNER_ID;
+    batch.signer_private_key = &privkey;
+    batch.jobs = (txn_job*)calloc(TXN_CHUNK_SIZE, sizeof(txn_job));
+    TEST_ASSERT(nullptr != batch.jobs);
+
+    /* sign the manifest into two output files. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_open(&f, &fd, "first.txn", O_CREAT | O_EXCL | O_WRONLY, 0));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS == sign_manifest(&batch, MANIFEST, fd, lines));
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == file_close(&f, fd));
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            file_open(&f, &fd, "second.txn", O_CREAT | O_EXCL | O_WRONLY, 0));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS == sign_manifest(&batch, MANIFEST, fd, lines));
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == file_close(&f, fd));
+
+    /* every entry was read, with its line number. */
+    TEST_ASSERT(2 * MANIFEST_COUNT == lines.size());
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        TEST_EXPECT(MANIFEST_LINES[i % MANIFEST_COUNT] == lines[i]);
+    }
+
+    /* the output is each transaction, signed on its own, in manifest order. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            expected_transactions(expected, &opts, &privkey));
+    TEST_ASSERT(MANIFEST_COUNT == expected.size());
+
+    vector<uint8_t> concatenated;
+    for (const auto& txn : expected)
+    {
+        concatenated.insert(concatenated.end(), txn.begin(), txn.end());
+    }
+
+    TEST_EXPECT(concatenated == files["first.txn"]);
+
+    /* signing the same manifest again gives the same output. */
+    TEST_EXPECT(files["first.txn"] == files["second.txn"]);
+
+    /* each transaction verifies, and has the ids of its manifest entry. */
+    const uint8_t* txn = files["first.txn"].data();
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        TEST_EXPECT(
+            VCTOOL_STATUS_SUCCESS ==
+                certificate_verify_signature(
+                    &suite, txn, expected[i].size(), &pubkey));
+        TEST_ASSERT(
+            VCTOOL_STATUS_SUCCESS ==
+                transaction_info_read(&info, txn, expected[i].size()));
+        TEST_EXPECT(i + 1 == info.transaction_id[TRANSACTION_ID_SIZE - 1]);
+        txn += expected[i].size();
+    }
+
+    TEST_EXPECT(descriptors.empty());
+
+    /* clean up. */
+    free(batch.jobs);
+    dispose((disposable_t*)&f);
+    dispose(vccrypt_buffer_disposable_handle(&pubkey));
+    dispose(vccrypt_buffer_disposable_handle(&privkey));
+    dispose((disposable_t*)&builder_opts);
+    dispose((disposable_t*)&suite);
+    dispose((disposable_t*)&alloc_opts);
+}
+
+/**
+ * Test that with an output directory, each transaction is written to a file
+ * named for its transaction id.
+ */
+TEST(output_directory)
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccert_builder_options_t builder_opts;
+    vccrypt_buffer_t privkey;
+    vccrypt_buffer_t pubkey;
+    commandline_opts opts;
+    file f;
+    txn_batch batch;
+    mutex lock;
+    map<string, vector<uint8_t>> files;
+    map<int, string> descriptors;
+    vector<vector<uint8_t>> expected;
+    vector<size_t> lines;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCCERT_STATUS_SUCCESS ==
+            vccert_builder_options_init(&builder_opts, &alloc_opts, &suite));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            signing_keypair_create(&suite, &privkey, &pubkey));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            memory_file_init(&f, files, descriptors, lock, "out"));
+
+    memset(&opts, 0, sizeof(opts));
+    opts.file = &f;
+    opts.suite = &suite;
+    opts.builder_opts = &builder_opts;
+
+    memset(&batch, 0, sizeof(batch));
+    batch.opts = &opts;
+    batch.signer_id = (const rcpr_uuid*)SIGNER_ID;
+    batch.signer_private_key = &privkey;
+    batch.output_dir = "out";
+    batch.jobs = (txn_job*)calloc(TXN_CHUNK_SIZE, sizeof(txn_job));
+    TEST_ASSERT(nullptr != batch.jobs);
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS == sign_manifest(&batch, MANIFEST, -1, lines));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            expected_transactions(expected, &opts, &privkey));
+
+    /* one file per transaction, named for its transaction id. */
+    const char* names[] = {
+        "out/00000000-0000-0000-0000-000000000001.txn",
+        "out/00000000-0000-0000-0000-000000000002.txn",
+        "out/00000000-0000-0000-0000-000000000003.txn" };
+    TEST_ASSERT(MANIFEST_COUNT == files.size());
+    for (size_t i = 0; i < MANIFEST_COUNT; ++i)
+    {
+        TEST_EXPECT(expected[i] == files[names[i]]);
+    }
+
+    TEST_EXPECT(descriptors.empty());
+
+    /* a transaction is not written over an existing file. */
+    lines.clear();
+    TEST_EXPECT(
+        VCTOOL_ERROR_FILE_EXISTS == sign_manifest(&batch, MANIFEST, -1, lines));
+    TEST_EXPECT(expected[0] == files[names[0]]);
+    TEST_EXPECT(descriptors.empty());
+
+    /* clean up. */
+    free(batch.jobs);
+    dispose((disposable_t*)&f);
+    dispose(vccrypt_buffer_disposable_handle(&pubkey));
+    dispose(vccrypt_buffer_disposable_handle(&privkey));
+    dispose((disposable_t*)&builder_opts);
+    dispose((disposable_t*)&suite);
+    dispose((disposable_t*)&alloc_opts);
+}
@@ -0,0 +1,596 @@
+/**
+ * \file test/verify/test_verify_signer_table.cpp
+ *
+ * \brief Unit tests for the verify signer table and verify-cert.
+ *
+ * \copyright 2023 Velo Payments.  See License.txt for license terms.
+ */
+
+#include <map>
+#include <minunit/minunit.h>
+#include <mutex>
+#include <string.h>
+#include <string>
+#include <vccert/builder.h>
+#include <vccrypt/suite.h>
+#include <vector>
+#include <vpr/allocator/malloc_allocator.h>
+
+#include "../../src/command/verify/verify_internal.h"
+#include "../file/mock_file.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/* start of the verify_signer_table test suite. */
+TEST_SUITE(verify_signer_table);
+
+/** \brief The timestamp used by these tests. */
+#define TEST_VALID_FROM 1672531200ULL
+
+static const uint8_t BLOCK_ID[16] = {
+    0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+    0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20 };
+
+/**
+ * Make a signer id with every byte set to the given value.
+ */
+static vector<uint8_t> signer_id(uint8_t value)
+{
+    return vector<uint8_t>(BLOCK_ID_SIZE, value);
+}
+
+/**
+ * Append a short field to a certificate.
+ */
+static void append_field(
+    vector<uint8_t>& cert, uint16_t type, const void* value, size_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)value;
+
+    cert.push_back((uint8_t)(type >> 8));
+    cert.push_back((uint8_t)(type & 0xFF));
+    cert.push_back((uint8_t)(size >> 8));
+    cert.push_back((uint8_t)(size & 0xFF));
+    cert.insert(cert.end(), bytes, bytes + size);
+}
+
+/**
+ * Make a signer public key certificate holding only the signer id and public
+ * signing key.
+ */
+static vector<uint8_t> signer_cert(
+    const vector<uint8_t>& id, const vccrypt_buffer_t* pubkey)
+{
+    vector<uint8_t> cert;
+
+    append_field(cert, VCCERT_FIELD_TYPE_ARTIFACT_ID, id.data(), id.size());
+    append_field(
+        cert, VCCERT_FIELD_TYPE_PUBLIC_SIGNING_KEY, pubkey->data,
+        pubkey->size);
+
+    return cert;
+}
+
+/**
+ * Create a signing keypair with the given suite.
+ */
+static int signing_keypair_create(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* privkey,
+    vccrypt_buffer_t* pubkey)
+{
+    int retval;
+    vccrypt_digital_signature_context_t sign;
+
+    retval = vccrypt_suite_digital_signature_init(suite, &sign);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval =
+        vccrypt_suite_buffer_init_for_signature_private_key(suite, privkey);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_sign;
+    }
+
+    retval =
+        vccrypt_suite_buffer_init_for_signature_public_key(suite, pubkey);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_privkey;
+    }
+
+    retval = vccrypt_digital_signature_keypair_create(&sign, privkey, pubkey);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_pubkey;
+    }
+
+    /* success. */
+    retval = VCCRYPT_STATUS_SUCCESS;
+    goto cleanup_sign;
+
+cleanup_pubkey:
+    dispose(vccrypt_buffer_disposable_handle(pubkey));
+
+cleanup_privkey:
+    dispose(vccrypt_buffer_disposable_handle(privkey));
+
+cleanup_sign:
+    dispose((disposable_t*)&sign);
+
+    return retval;
+}
+
+/**
+ * Initialize a mock file interface that serves the given in-memory files, and
+ * counts the number of times each file is opened.
+ */
+static int memory_file_init(
+    file* f, map<string, vector<uint8_t>>& files, map<string, int>& open_count,
+    map<int, string>& descriptors, mutex& lock)
+{
+    return
+        file_mock_init(
+            f,
+            /* stat. */
+            [&](file*, const char* name, file_stat_st* fst) -> int {
+                lock_guard<mutex> guard(lock);
+                auto it = files.find(name);
+                if (files.end() == it)
+                {
+                    return VCTOOL_ERROR_FILE_NO_ENTRY;
+                }
+
+                memset(fst, 0, sizeof(*fst));
+                fst->fst_size = it->second.size();
+                return VCTOOL_STATUS_SUCCESS;
+            },
+            /* open. */
+            [&](file*, int* d, const char* name, int, mode_t) -> int {
+                lock_guard<mutex> guard(lock);
+                if (files.end() == files.find(name))
+                {
+                    return VCTOOL_ERROR_FILE_NO_ENTRY;
+                }
+
+                ++open_count[name];
+                *d = 10 + (int)descriptors.size();
+                while (descriptors.end() != descriptors.find(*d))
+                {
+                    ++*d;
+                }
+
+                descriptors[*d] = name;
+                return VCTOOL_STATUS_SUCCESS;
+            },
+            /* close. */
+            [&](file*, int d) -> int {
+                lock_guard<mutex> guard(lock);
+                return
+                    (1U == descriptors.erase(d))
+                        ? VCTOOL_STATUS_SUCCESS
+                        : VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+            },
+            /* read. */
+            [&](file*, int d, void* buf, size_t max, size_t* size) -> int {
+                lock_guard<mutex> guard(lock);
+                auto it = descriptors.find(d);
+                if (descriptors.end() == it)
+                {
+                    return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+                }
+
+                const vector<uint8_t>& contents = files[it->second];
+                *size = (max < contents.size()) ? max : contents.size();
+                memcpy(buf, contents.data(), *size);
+                return VCTOOL_STATUS_SUCCESS;
+            },
+            /* write. */
+            [&](file*, int, const void*, size_t, size_t*) -> int {
+                return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+            },
+            /* lseek. */
+            [&](file*, int, off_t, file_lseek_whence, off_t*) -> int {
+                return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+            },
+            /* fsync. */
+            [&](file*, int) -> int {
+                return VCTOOL_ERROR_FILE_BAD_DESCRIPTOR;
+            });
+}
+
+/**
+ * Test that the signer table reads each distinct file once, sorts the signers
+ * by id, and finds each signer by id.
+ */
+TEST(sort_and_find)
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    rcpr_allocator* alloc;
+    root_command root;
+    commandline_opts opts;
+    file f;
+    vccrypt_buffer_t privkey;
+    vccrypt_buffer_t pubkey;
+    verify_signer_table table;
+    const verify_signer* signer;
+    mutex lock;
+    map<string, vector<uint8_t>> files;
+    map<string, int> open_count;
+    map<int, string> descriptors;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            signing_keypair_create(&suite, &privkey, &pubkey));
+
+    /* the files are named in a different order than their ids. */
+    files["a.pub"] = signer_cert(signer_id(0x30), &pubkey);
+    files["b.pub"] = signer_cert(signer_id(0x10), &pubkey);
+    files["c.pub"] = signer_cert(signer_id(0x20), &pubkey);
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            memory_file_init(&f, files, open_count, descriptors, lock));
+
+    /* two keys share b.pub. */
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_command_init(&root, alloc));
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_dict_add(&root, "zed=a.pub"));
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_dict_add(&root, "amy=b.pub"));
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_dict_add(&root, "bob=b.pub"));
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_dict_add(&root, "cal=c.pub"));
+
+    /* only the file and suite are used from the options. */
+    memset(&opts, 0, sizeof(opts));
+    opts.file = &f;
+    opts.suite = &suite;
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            verify_signer_table_init(&table, &opts, &root));
+
+    /* each distinct file is one signer, read once. */
+    TEST_ASSERT(3U == table.count);
+    TEST_EXPECT(1 == open_count["a.pub"]);
+    TEST_EXPECT(1 == open_count["b.pub"]);
+    TEST_EXPECT(1 == open_count["c.pub"]);
+    TEST_EXPECT(descriptors.empty());
+
+    /* the signers are sorted by id. */
+    TEST_EXPECT(0x10 == table.signers[0].id[0]);
+    TEST_EXPECT(0x20 == table.signers[1].id[0]);
+    TEST_EXPECT(0x30 == table.signers[2].id[0]);
+
+    /* every signer is found by its id. */
+    signer = verify_signer_table_find(&table, signer_id(0x10).data());
+    TEST_ASSERT(nullptr != signer);
+    TEST_EXPECT(!strcmp("b.pub", signer->filename));
+    TEST_EXPECT(signer->key_read);
+    TEST_ASSERT(pubkey.size == signer->public_key.size);
+    TEST_EXPECT(!memcmp(pubkey.data, signer->public_key.data, pubkey.size));
+
+    signer = verify_signer_table_find(&table, signer_id(0x20).data());
+    TEST_ASSERT(nullptr != signer);
+    TEST_EXPECT(!strcmp("c.pub", signer->filename));
+
+    signer = verify_signer_table_find(&table, signer_id(0x30).data());
+    TEST_ASSERT(nullptr != signer);
+    TEST_EXPECT(!strcmp("a.pub", signer->filename));
+
+    /* ids before, between, and after the known ids are not found. */
+    TEST_EXPECT(
+        nullptr == verify_signer_table_find(&table, signer_id(0x00).data()));
+    TEST_EXPECT(
+        nullptr == verify_signer_table_find(&table, signer_id(0x18).data()));
+    TEST_EXPECT(
+        nullptr == verify_signer_table_find(&table, signer_id(0xff).data()));
+
+    /* clean up. */
+    verify_signer_table_dispose(&table);
+    TEST_EXPECT(0U == table.count);
+    dispose((disposable_t*)&root);
+    dispose((disposable_t*)&f);
+    dispose(vccrypt_buffer_disposable_handle(&pubkey));
+    dispose(vccrypt_buffer_disposable_handle(&privkey));
+    dispose((disposable_t*)&suite);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+    dispose((disposable_t*)&alloc_opts);
+}
+
+/**
+ * Test that two files with the same signer id are both read, and that the id
+ * is found.
+ */
+TEST(duplicate_ids)
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    rcpr_allocator* alloc;
+    root_command root;
+    commandline_opts opts;
+    file f;
+    vccrypt_buffer_t privkey;
+    vccrypt_buffer_t pubkey;
+    verify_signer_table table;
+    const verify_signer* signer;
+    mutex lock;
+    map<string, vector<uint8_t>> files;
+    map<string, int> open_count;
+    map<int, string> descriptors;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            signing_keypair_create(&suite, &privkey, &pubkey));
+
+    /* a copy of a signer certificate under another name. */
+    files["one.pub"] = signer_cert(signer_id(0x42), &pubkey);
+    files["copy.pub"] = files["one.pub"];
+    files["two.pub"] = signer_cert(signer_id(0x07), &pubkey);
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            memory_file_init(&f, files, open_count, descriptors, lock));
+
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_command_init(&root, alloc));
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_dict_add(&root, "a=one.pub"));
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_dict_add(&root, "b=copy.pub"));
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_dict_add(&root, "c=two.pub"));
+
+    memset(&opts, 0, sizeof(opts));
+    opts.file = &f;
+    opts.suite = &suite;
+
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            verify_signer_table_init(&table, &opts, &root));
+
+    /* both copies are read, and sort next to each other. */
+    TEST_ASSERT(3U == table.count);
+    TEST_EXPECT(0x07 == table.signers[0].id[0]);
+    TEST_EXPECT(0x42 == table.signers[1].id[0]);
+    TEST_EXPECT(0x42 == table.signers[2].id[0]);
+
+    /* the duplicated id resolves to one of its copies. */
+    signer = verify_signer_table_find(&table, signer_id(0x42).data());
+    TEST_ASSERT(nullptr != signer);
+    TEST_EXPECT(!memcmp(signer_id(0x42).data(), signer->id, BLOCK_ID_SIZE));
+    TEST_EXPECT(signer->key_read);
+
+    signer = verify_signer_table_find(&table, signer_id(0x07).data());
+    TEST_ASSERT(nullptr != signer);
+    TEST_EXPECT(!strcmp("two.pub", signer->filename));
+
+    /* clean up. */
+    verify_signer_table_dispose(&table);
+    dispose((disposable_t*)&root);
+    dispose((disposable_t*)&f);
+    dispose(vccrypt_buffer_disposable_handle(&pubkey));
+    dispose(vccrypt_buffer_disposable_handle(&privkey));
+    dispose((disposable_t*)&suite);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+    dispose((disposable_t*)&alloc_opts);
+}
+
+/**
+ * Test that the signer table fails if a signer file is missing, or if there
+ * are no signers at all.
+ */
+TEST(missing_signer)
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    rcpr_allocator* alloc;
+    root_command root;
+    commandline_opts opts;
+    file f;
+    vccrypt_buffer_t privkey;
+    vccrypt_buffer_t pubkey;
+    verify_signer_table table;
+    mutex lock;
+    map<string, vector<uint8_t>> files;
+    map<string, int> open_count;
+    map<int, string> descriptors;
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            signing_keypair_create(&suite, &privkey, &pubkey));
+
+    files["one.pub"] = signer_cert(signer_id(0x01), &pubkey);
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            memory_file_init(&f, files, open_count, descriptors, lock));
+
+    memset(&opts, 0, sizeof(opts));
+    opts.file = &f;
+    opts.suite = &suite;
+
+    /* with no signers, there is nothing to verify against. */
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_command_init(&root, alloc));
+    TEST_EXPECT(
+        VCTOOL_ERROR_COMMANDLINE_MISSING_ARGUMENT ==
+            verify_signer_table_init(&table, &opts, &root));
+
+    /* a missing signer file fails the table, and every file is closed. */
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_dict_add(&root, "a=one.pub"));
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_dict_add(&root, "b=none.pub"));
+    TEST_EXPECT(
+        VCTOOL_ERROR_FILE_NO_ENTRY ==
+            verify_signer_table_init(&table, &opts, &root));
+    TEST_EXPECT(0U == table.count);
+    TEST_EXPECT(nullptr == table.signers);
+    TEST_EXPECT(descriptors.empty());
+
+    /* clean up. */
+    dispose((disposable_t*)&root);
+    dispose((disposable_t*)&f);
+    dispose(vccrypt_buffer_disposable_handle(&pubkey));
+    dispose(vccrypt_buffer_disposable_handle(&privkey));
+    dispose((disposable_t*)&suite);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+    dispose((disposable_t*)&alloc_opts);
+}
+
+/**
+ * Test that verify-cert accepts a good certificate and rejects a tampered
+ * one in the same batch, each with its own status.
+ */
+TEST(verify_cert_batch)
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccert_builder_options_t builder_opts;
+    rcpr_allocator* alloc;
+    root_command root;
+    verify_cert_command verify;
+    commandline_opts opts;
+    file f;
+    vccrypt_buffer_t privkey;
+    vccrypt_buffer_t pubkey;
+    vccrypt_buffer_t cert;
+    verify_signer_table table;
+    verify_cert_batch batch;
+    verify_cert_job jobs[3];
+    mutex lock;
+    map<string, vector<uint8_t>> files;
+    map<string, int> open_count;
+    map<int, string> descriptors;
+    vector<uint8_t> id = signer_id(0x5a);
+
+    vccrypt_suite_register_velo_v1();
+    malloc_allocator_options_init(&alloc_opts);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            vccrypt_suite_options_init(
+                &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1));
+    TEST_ASSERT(
+        VCCERT_STATUS_SUCCESS ==
+            vccert_builder_options_init(&builder_opts, &alloc_opts, &suite));
+    TEST_ASSERT(
+        VCCRYPT_STATUS_SUCCESS ==
+            signing_keypair_create(&suite, &privkey, &pubkey));
+
+    memset(&opts, 0, sizeof(opts));
+    opts.file = &f;
+    opts.suite = &suite;
+    opts.builder_opts = &builder_opts;
+
+    /* sign a certificate, and keep a copy with a flipped signature bit. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            root_block_certificate_create(
+                &opts, &cert, BLOCK_ID, TEST_VALID_FROM, id.data(),
+                &privkey));
+    const uint8_t* bytes = (const uint8_t*)cert.data;
+    files["good.cert"].assign(bytes, bytes + cert.size);
+    files["tampered.cert"] = files["good.cert"];
+    files["tampered.cert"].back() ^= 0x01;
+    dispose(vccrypt_buffer_disposable_handle(&cert));
+
+    /* a certificate signed by a signer that was not given. */
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            root_block_certificate_create(
+                &opts, &cert, BLOCK_ID, TEST_VALID_FROM,
+                signer_id(0x5b).data(), &privkey));
+    bytes = (const uint8_t*)cert.data;
+    files["unknown.cert"].assign(bytes, bytes + cert.size);
+    dispose(vccrypt_buffer_disposable_handle(&cert));
+
+    files["signer.pub"] = signer_cert(id, &pubkey);
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            memory_file_init(&f, files, open_count, descriptors, lock));
+
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == root_command_init(&root, alloc));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS == root_dict_add(&root, "signer=signer.pub"));
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            verify_signer_table_init(&table, &opts, &root));
+
+    /* verify the batch on the worker pool. */
+    memset(jobs, 0, sizeof(jobs));
+    jobs[0].filename = "good.cert";
+    jobs[1].filename = "tampered.cert";
+    jobs[2].filename = "unknown.cert";
+    memset(&batch, 0, sizeof(batch));
+    batch.opts = &opts;
+    batch.signers = &table;
+    batch.jobs = jobs;
+    batch.job_count = 3;
+    TEST_ASSERT(
+        VCTOOL_STATUS_SUCCESS ==
+            parallel_for(batch.job_count, &verify_cert_worker, &batch));
+
+    /* each certificate has its own status. */
+    TEST_EXPECT(VCTOOL_STATUS_SUCCESS == jobs[0].status);
+    TEST_EXPECT(VCTOOL_ERROR_CERTIFICATE_BAD_SIGNATURE == jobs[1].status);
+    TEST_EXPECT(VCTOOL_ERROR_CERTIFICATE_UNKNOWN_SIGNER == jobs[2].status);
+    verify_signer_table_dispose(&table);
+
+    /* the command succeeds on the good certificate alone. */
+    char* good_only[] = { (char*)"good.cert" };
+    TEST_ASSERT(VCTOOL_STATUS_SUCCESS == verify_cert_command_init(&verify));
+    verify.input_filenames = good_only;
+    verify.input_filename_count = 1;
+    verify.hdr.next = &root.hdr;
+    opts.cmd = &verify.hdr;
+    TEST_EXPECT(VCTOOL_STATUS_SUCCESS == verify_cert_command_func(&opts));
+
+    /* the command fails if either certificate is tampered. */
+    char* good_and_tampered[] = {
+        (char*)"good.cert", (char*)"tampered.cert" };
+    verify.input_filenames = good_and_tampered;
+    verify.input_filename_count = 2;
+    TEST_EXPECT(
+        VCTOOL_ERROR_CERTIFICATE_BAD_SIGNATURE ==
+            verify_cert_command_func(&opts));
+
+    /* the signer file is read once per signer table. */
+    TEST_EXPECT(3 == open_count["signer.pub"]);
+    TEST_EXPECT(descriptors.empty());
+
+    /* clean up. */
+    dispose((disposable_t*)&verify);
+    dispose((disposable_t*)&root);
+    dispose((disposable_t*)&f);
+    dispose(vccrypt_buffer_disposable_handle(&pubkey));
+    dispose(vccrypt_buffer_disposable_handle(&privkey));
+    dispose((disposable_t*)&builder_opts);
+    dispose((disposable_t*)&suite);
+    TEST_ASSERT(
+        STATUS_SUCCESS ==
+            resource_release(rcpr_allocator_resource_handle(alloc)));
+    dispose((disposable_t*)&alloc_opts);
+}